@@ -22,7 +22,7 @@
 
 
 #include "CK2Army.h"
-#include "..\log.h"
+#include "../Log.h"
 
 
 
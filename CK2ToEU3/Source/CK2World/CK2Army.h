@@ -25,7 +25,7 @@
 #define CK2ARMY_H_
 
 
-#include "..\Parsers\Object.h"
+#include "../Parsers/Object.h"
 #include <string>
 using namespace std;
 
@@ -24,10 +24,10 @@
 #include "CK2Building.h"
 #include "CK2Barony.h"
 #include "CK2Title.h"
-#include "CK2World\Character\CK2Character.h"
-#include "..\Parsers\Object.h"
-#include "..\Log.h"
-#include "..\Configuration.h"
+#include "CK2World/Character/CK2Character.h"
+#include "../Parsers/Object.h"
+#include "../Log.h"
+#include "../Configuration.h"
 
 
 
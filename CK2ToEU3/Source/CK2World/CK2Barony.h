@@ -26,8 +26,8 @@
 
 
 
-#include "..\Mappers.h"
-#include "Parsers\IObject.h"
+#include "../Mappers.h"
+#include "Parsers/IObject.h"
 #include <string>
 using namespace std;
 
@@ -26,7 +26,7 @@
 
 
 
-#include "..\Mappers.h"
+#include "../Mappers.h"
 #include <string>
 #include <vector>
 #include <map>
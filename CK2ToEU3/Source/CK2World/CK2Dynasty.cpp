@@ -22,8 +22,8 @@
 
 
 #include "CK2Dynasty.h"
-#include "CK2World\Character\CK2Character.h"
-#include "..\Parsers\Object.h"
+#include "CK2World/Character/CK2Character.h"
+#include "../Parsers/Object.h"
 
 
 
@@ -22,14 +22,14 @@
 
 
 #include "CK2Province.h"
-#include "..\Parsers\Object.h"
+#include "../Parsers/Object.h"
 #include "CK2Building.h"
 #include "CK2Barony.h"
 #include "CK2Title.h"
-#include "CK2World\Character\CK2Character.h"
+#include "CK2World/Character/CK2Character.h"
 #include "CK2Religion.h"
 #include "CK2Version.h"
-#include "..\Log.h"
+#include "../Log.h"
 
 
 
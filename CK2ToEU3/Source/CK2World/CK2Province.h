@@ -25,8 +25,8 @@
 #define CK2PROVINCE_H_
 
 
-#include "..\Mappers.h"
-#include "Parsers\IObject.h"
+#include "../Mappers.h"
+#include "Parsers/IObject.h"
 #include <vector>
 #include <map>
 #include <memory>
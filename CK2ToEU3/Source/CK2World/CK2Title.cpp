@@ -22,19 +22,19 @@
 
 
 #include "CK2Title.h"
-#include "..\Parsers\Object.h"
+#include "../Parsers/Object.h"
 #include "CK2World.h"
-#include "CK2World\Character\CK2Character.h"
+#include "CK2World/Character/CK2Character.h"
 #include "CK2Title.h"
 #include "CK2Dynasty.h"
 #include "CK2History.h"
 #include "CK2Barony.h"
-#include "..\Log.h"
+#include "../Log.h"
 #include <algorithm>
 #include <boost/algorithm/string/predicate.hpp>
 #include <boost/range/adaptor/reversed.hpp>
-#include "..\Configuration.h"
-#include "..\EU3World\Country\EU3Country.h"
+#include "../Configuration.h"
+#include "../EU3World/Country/EU3Country.h"
 
 
 CK2Title::CK2Title(string _titleString, int* _color)
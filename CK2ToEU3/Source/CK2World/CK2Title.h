@@ -24,8 +24,8 @@
 #ifndef CK2TITLE_H_
 #define CK2TITLE_H_
 
-#include "Parsers\IObject.h"
-#include "..\mappers.h"
+#include "Parsers/IObject.h"
+#include "../Mappers.h"
 #include <vector>
 #include <map>
 #include <memory>
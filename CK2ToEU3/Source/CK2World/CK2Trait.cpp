@@ -22,7 +22,7 @@
 
 
 #include "CK2Trait.h"
-#include "..\Parsers\Object.h"
+#include "../Parsers/Object.h"
 
 
 static inline int GetOrZero(Object* obj, string name)
@@ -22,7 +22,7 @@
 
 
 #include "CK2Version.h"
-#include "..\Parsers\Object.h"
+#include "../Parsers/Object.h"
 
 
 CK2Version::CK2Version(string versionString)
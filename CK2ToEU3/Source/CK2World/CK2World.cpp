@@ -20,19 +20,19 @@
  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 #include <iostream>
-#include <boost\bind.hpp>
-#include <boost\foreach.hpp>
+#include <boost/bind.hpp>
+#include <boost/foreach.hpp>
 #include "CK2World.h"
-#include "..\Log.h"
-#include "..\Configuration.h"
-#include "..\Parsers\Object.h"
-#include "Common\Date.h"
+#include "../Log.h"
+#include "../Configuration.h"
+#include "../Parsers/Object.h"
+#include "Common/Date.h"
 #include "CK2Building.h"
 #include "CK2Version.h"
 #include "CK2Title.h"
 #include "CK2Province.h"
 #include "CK2Barony.h"
-#include "CK2World\Character\CK2Character.h"
+#include "CK2World/Character/CK2Character.h"
 #include "CK2Dynasty.h"
 #include "CK2Trait.h"
 #include "CK2Techs.h"
@@ -27,12 +27,12 @@
 
 #include <vector>
 #include <map>
-#include <boost\function.hpp>
-#include "Parsers\IObject.h"
-#include "CK2World\Opinion\CK2Opinion.h"
-#include "Common\Date.h"
-#include "..\LogBase.h"
-#include "..\Mappers.h"
+#include <boost/function.hpp>
+#include "Parsers/IObject.h"
+#include "CK2World/Opinion/CK2Opinion.h"
+#include "Common/Date.h"
+#include "../LogBase.h"
+#include "../Mappers.h"
 using namespace std;
 
 typedef map<string, CK2Title*> title_map_t;
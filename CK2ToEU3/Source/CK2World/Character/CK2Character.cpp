@@ -23,21 +23,22 @@
 
 #include "CK2Character.h"
 #include <algorithm>
-#include "boost\foreach.hpp"
-#include "log.h"
+#include <cmath>
+#include "boost/foreach.hpp"
+#include "Log.h"
 #include "Configuration.h"
-#include "Parsers\Object.h"
-#include "CK2World\CK2Dynasty.h"
-#include "CK2World\CK2Trait.h"
-#include "CK2World\CK2World.h"
-#include "CK2World\CK2Barony.h"
-#include "CK2World\CK2Province.h"
-#include "CK2World\CK2Title.h"
-#include "CK2World\CK2Techs.h"
-#include "CK2World\CK2War.h"
-#include "CK2World\CK2Religion.h"
-#include "CK2World\CK2Army.h"
-#include "CK2World\CK2Version.h"
+#include "Parsers/Object.h"
+#include "CK2World/CK2Dynasty.h"
+#include "CK2World/CK2Trait.h"
+#include "CK2World/CK2World.h"
+#include "CK2World/CK2Barony.h"
+#include "CK2World/CK2Province.h"
+#include "CK2World/CK2Title.h"
+#include "CK2World/CK2Techs.h"
+#include "CK2World/CK2War.h"
+#include "CK2World/CK2Religion.h"
+#include "CK2World/CK2Army.h"
+#include "CK2World/CK2Version.h"
 
 
 
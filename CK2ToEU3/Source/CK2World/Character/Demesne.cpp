@@ -19,8 +19,8 @@
  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
-#include "boost\foreach.hpp"
-#include "CK2World\Character\Demesne.h"
+#include "boost/foreach.hpp"
+#include "CK2World/Character/Demesne.h"
 
 namespace ck2
 {
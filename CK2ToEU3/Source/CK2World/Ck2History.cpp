@@ -22,7 +22,7 @@
 
 
 #include "CK2History.h"
-#include "..\Parsers\Object.h"
+#include "../Parsers/Object.h"
 
 #include <iostream>
 
@@ -44,42 +44,52 @@
 
 
 #include "Date.h"
-#include <cstdlib>
+#include <cctype>
 #include <sstream>
 #include <vector>
-#include "Parsers\Object.h"
+#include "Parsers/Object.h"
 using namespace std;
 
 namespace common
 {
 
-date::date(string _init)
+// Reads a number from the start of text the way atoi does, without copying text into a string first
+static int parseNumber(boost::string_ref text)
 {
-	if (_init.length() < 1)
-		return;
+	size_t position = 0;
+	while ((position < text.size()) && isspace(static_cast<unsigned char>(text[position])))
+		position++;
 
-	if (_init[0] == '\"')
-		_init = _init.substr(1, _init.length() - 2);
-	int first_dot = _init.find_first_of('.');
-	int last_dot = _init.find_last_of('.');
-	year	= atoi( _init.substr(0, first_dot).c_str() );
-	month	= atoi( _init.substr(first_dot + 1, last_dot - first_dot).c_str() );
-	day		= atoi( _init.substr(last_dot + 1, 2).c_str() );
-}
+	bool negative = false;
+	if ((position < text.size()) && ((text[position] == '-') || (text[position] == '+')))
+	{
+		negative = (text[position] == '-');
+		position++;
+	}
 
-date::date(const date& _init)
-{
-	year = _init.year;
-	month = _init.month;
-	day = _init.day;
+	int number = 0;
+	while ((position < text.size()) && (text[position] >= '0') && (text[position] <= '9'))
+	{
+		number = number * 10 + (text[position] - '0');
+		position++;
+	}
+	return negative ? -number : number;
 }
 
-date& date::operator=(const date& _rhs)
+date::date(boost::string_ref _init)
 {
-	year = _rhs.year;
-	month = _rhs.month;
-	day = _rhs.day;
-	return *this;
+	packed = pack(1, 1, 1);
+	if (_init.length() < 1)
+		return;
+
+	if (_init[0] == '\"')
+		_init = _init.substr(1, _init.length() - 2);
+	size_t first_dot = _init.find_first_of('.');
+	size_t last_dot = _init.find_last_of('.');
+	int year		= parseNumber( _init.substr(0, first_dot) );
+	int month	= parseNumber( _init.substr(first_dot + 1, last_dot - first_dot) );
+	int day		= parseNumber( _init.substr(last_dot + 1, 2) );
+	packed = pack(year, month, day);
 }
 
 date::date(const Object* _init)
@@ -88,143 +98,41 @@ date::date(const Object* _init)
 	if (dateSubObj.size() > 0)
 	{
 		// date specified by year=, month=, day=
-		year = atoi(_init->getLeaf("year").c_str());
-		month = atoi(_init->getLeaf("month").c_str());
-		day = atoi(_init->getLeaf("day").c_str());
+		packed = pack(atoi(dateSubObj[0]->getLeaf().c_str()), atoi(_init->getLeaf("month").c_str()), atoi(_init->getLeaf("day").c_str()));
 	}
 	else
 	{
 		// date specified by year.month.day
-		// build another date object via date(string&) and copy it to this one
-		(*this) = date(_init->getLeaf());
+		packed = date(_init->getLeaf()).packed;
 	}
 }
 
-bool date::operator==(const date& _rhs) const
+void date::addYears(int years)
 {
-	return ((year == _rhs.year)
-		 && (month == _rhs.month)
-		 && (day == _rhs.day));
+	packed = pack(getYear() + years, getMonth(), getDay());
 }
 
-bool date::operator!=(const date& _rhs) const
+void date::addMonths(int months)
 {
-	return !(*this == _rhs);
-}
-
-bool date::operator<(const date& _rhs) const
-{
-	return ((year < _rhs.year)
-		|| ((year == _rhs.year) && (month < _rhs.month))
-		|| ((year == _rhs.year) && (month == _rhs.month) && (day < _rhs.day)));
-}
-
-bool date::operator>(const date& _rhs) const
-{
-	return ((year > _rhs.year)
-		|| ((year == _rhs.year) && (month > _rhs.month))
-		|| ((year == _rhs.year) && (month == _rhs.month) && (day > _rhs.day)));
-}
-
-bool date::operator<=(const date& _rhs) const
-{
-	return ((*this == _rhs) || (*this < _rhs));
-}
-
-bool date::operator>=(const date& _rhs) const
-{
-	return ((*this == _rhs) || (*this > _rhs));
-}
-
-float date::diffInYears(const date& _rhs) const
-{
-	float years = float(year - _rhs.year);
-
-	int lhsDays;
-	switch (month)
+	int year = getYear();
+	int month = getMonth() + months;
+	while (month > 12)
 	{
-		case 1:
-			lhsDays = day;
-			break;
-		case 2:
-			lhsDays = day + 31;
-			break;
-		case 3:
-			lhsDays = day + 59;
-			break;
-		case 4:
-			lhsDays = day + 90;
-			break;
-		case 5:
-			lhsDays = day + 120;
-			break;
-		case 6:
-			lhsDays = day + 151;
-			break;
-		case 7:
-			lhsDays = day + 181;
-			break;
-		case 8:
-			lhsDays = day + 212;
-			break;
-		case 9:
-			lhsDays = day + 243;
-			break;
-		case 10:
-			lhsDays = day + 273;
-			break;
-		case 11:
-			lhsDays = day + 304;
-			break;
-		case 12:
-			lhsDays = day + 334;
-			break;
+		month -= 12;
+		year++;
 	}
-
-	int rhsDays;
-	switch (month)
+	while (month < 1)
 	{
-		case 1:
-			rhsDays = day;
-			break;
-		case 2:
-			rhsDays = day + 31;
-			break;
-		case 3:
-			rhsDays = day + 59;
-			break;
-		case 4:
-			rhsDays = day + 90;
-			break;
-		case 5:
-			rhsDays = day + 120;
-			break;
-		case 6:
-			rhsDays = day + 151;
-			break;
-		case 7:
-			rhsDays = day + 181;
-			break;
-		case 8:
-			rhsDays = day + 212;
-			break;
-		case 9:
-			rhsDays = day + 243;
-			break;
-		case 10:
-			rhsDays = day + 273;
-			break;
-		case 11:
-			rhsDays = day + 304;
-			break;
-		case 12:
-			rhsDays = day + 334;
-			break;
+		month += 12;
+		year--;
 	}
+	packed = pack(year, month, getDay());
+}
 
-	years += (lhsDays - rhsDays) / 365;
-
-	return years;
+float date::diffInYears(const date& _rhs) const
+{
+	// only whole years count, as the part-year difference was always truncated away
+	return float(getYear() - _rhs.getYear());
 }
 
 bool date::isSet() const
@@ -236,7 +144,7 @@ bool date::isSet() const
 string date::toString() const
 {
     stringstream builder;
-    builder << year << DATE_SEPARATOR << month << DATE_SEPARATOR << day;
+    builder << getYear() << DATE_SEPARATOR << getMonth() << DATE_SEPARATOR << getDay();
 	return builder.str();
 }
 
@@ -46,7 +46,9 @@
 #ifndef DATE_H_
 #define DATE_H_
 
+#include <cstdint>
 #include <string>
+#include <boost/utility/string_ref.hpp>
 using namespace std;
 
 class Object;
@@ -54,30 +56,48 @@ class Object;
 namespace common
 {
 
+// A date packed into 32 bits, with the year in the high half and the month and day in a byte each below it, so
+// that comparing two dates is comparing two integers. Fixed dates can be built at compile time with the
+// (year, month, day) constructor rather than parsed from a string each time they are used.
 struct date
 {
-	date() : year(1), month(1), day(1) {};
-	date(string _init);
-	date(const date& _init);
+	constexpr date() : packed(pack(1, 1, 1)) {};
+	constexpr date(int year, int month, int day) : packed(pack(year, month, day)) {};
+	date(boost::string_ref _init);
+	date(const string& _init) : date(boost::string_ref(_init)) {};
+	date(const char* _init) : date(boost::string_ref(_init)) {};
 	date(const Object* _init);
 
-	date& operator=(const date& _rhs);
-	bool operator==(const date& _rhs) const;
-	bool operator!=(const date& _rhs) const;
-	bool operator<(const date& _rhs) const;
-	bool operator>(const date& _rhs) const;
-	bool operator<=(const date& _rhs) const;
-	bool operator>=(const date& _rhs) const;
+	bool operator==(const date& _rhs) const	{ return packed == _rhs.packed; }
+	bool operator!=(const date& _rhs) const	{ return packed != _rhs.packed; }
+	bool operator<(const date& _rhs) const		{ return packed < _rhs.packed; }
+	bool operator>(const date& _rhs) const		{ return packed > _rhs.packed; }
+	bool operator<=(const date& _rhs) const	{ return packed <= _rhs.packed; }
+	bool operator>=(const date& _rhs) const	{ return packed >= _rhs.packed; }
+
+	int getYear() const	{ return static_cast<int>(packed >> 16) - yearBias; }
+	int getMonth() const	{ return (packed >> 8) & 0xFF; }
+	int getDay() const	{ return packed & 0xFF; }
+
+	void addYears(int years);
+	void addMonths(int months);
 
 	float diffInYears(const date& _rhs) const;
 
 	bool isSet() const;
 	string toString() const;
 
-	int year;
-	int month;
-	int day;
 	static constexpr char DATE_SEPARATOR[] = ".";
+
+private:
+	static const int yearBias = 32768;
+
+	static constexpr uint32_t pack(int year, int month, int day)
+	{
+		return (static_cast<uint32_t>(year + yearBias) << 16) | ((static_cast<uint32_t>(month) & 0xFF) << 8) | (static_cast<uint32_t>(day) & 0xFF);
+	}
+
+	uint32_t packed;
 };
 
 } // namespace common
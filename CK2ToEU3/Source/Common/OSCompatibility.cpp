@@ -0,0 +1,69 @@
+/*Copyright (c) 2016 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+#include "OSCompatibility.h"
+#include <boost/filesystem.hpp>
+
+namespace common
+{
+
+void GetAllFilesInFolder(const std::string& path, std::set<std::string>& fileNames)
+{
+	boost::system::error_code error;
+	boost::filesystem::directory_iterator entry(path, error);
+	for (; !error && (entry != boost::filesystem::directory_iterator()); entry.increment(error))
+	{
+		if (!boost::filesystem::is_directory(entry->status()))
+		{
+			fileNames.insert(entry->path().filename().string());
+		}
+	}
+}
+
+bool TryCopyFile(const std::string& sourcePath, const std::string& destPath)
+{
+	boost::system::error_code error;
+	boost::filesystem::copy_file(sourcePath, destPath, boost::filesystem::copy_option::overwrite_if_exists, error);
+	return !error;
+}
+
+bool TryCopyFolder(const std::string& sourceFolder, const std::string& destFolder)
+{
+	const boost::filesystem::path source(sourceFolder);
+	boost::system::error_code error;
+	boost::filesystem::create_directories(destFolder, error);
+	boost::filesystem::recursive_directory_iterator entry(source, error);
+	for (; !error && (entry != boost::filesystem::recursive_directory_iterator()); entry.increment(error))
+	{
+		const boost::filesystem::path destination = destFolder / boost::filesystem::relative(entry->path(), source, error);
+		if (boost::filesystem::is_directory(entry->status()))
+		{
+			boost::filesystem::create_directories(destination, error);
+		}
+		else
+		{
+			boost::filesystem::copy_file(entry->path(), destination, boost::filesystem::copy_option::overwrite_if_exists, error);
+		}
+	}
+	return !error;
+}
+
+} // namespace common
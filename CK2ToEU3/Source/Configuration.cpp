@@ -44,7 +44,7 @@
 
 
 #include "Configuration.h"
-#include "Parsers\Parser.h"
+#include "Parsers/Parser.h"
 #include "Log.h"
 #include <vector>
 using namespace std;
@@ -48,7 +48,7 @@
 
 
 #include <string>
-#include "Parsers\IObject.h"
+#include "Parsers/IObject.h"
 using namespace std;
 
 
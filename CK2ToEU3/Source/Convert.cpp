@@ -26,21 +26,23 @@
 #include <memory>
 #include <string>
 #include <sys/stat.h>
-#include <io.h>
 #include <functional>
-#include <ShlObj.h>
+#include <set>
+#include <boost/filesystem.hpp>
 #include "Log.h"
+#include "Common/OSCompatibility.h"
 #include "Configuration.h"
 #include "Parsers/Parser.h"
 #include "Parsers/Object.h"
 #include "Parsers/LandedTitleMigrationsParser.h"
-#include "EU3World\EU3World.h"
-#include "EU3World\Country\EU3Country.h"
-#include "EU3World\EU3Tech.h"
-#include "CK2World\CK2World.h"
-#include "CK2World\Opinion\Repository.h"
-#include "CK2World\CK2Religion.h"
+#include "EU3World/EU3World.h"
+#include "EU3World/Country/EU3Country.h"
+#include "EU3World/EU3Tech.h"
+#include "CK2World/CK2World.h"
+#include "CK2World/Opinion/Repository.h"
+#include "CK2World/CK2Religion.h"
 #include "Mappers.h"
+#include "../../common_items/Profiler.h"
 using namespace std;
 
 void inform(std::string msg)
@@ -52,27 +54,22 @@ void inform(std::string msg)
 bool doParseDirectoryContents(const std::string& directory, std::function<void(Object* obj)> predicate)
 {
 	Object*				obj;
-	struct _finddata_t	data;
-	intptr_t			fileListing;
-	if ( (fileListing = _findfirst( (directory + "*").c_str(), &data)) == -1L)
+	if (!boost::filesystem::is_directory(directory))
 	{
 		return false;
 	}
-	do
+	set<string> filenames;
+	common::GetAllFilesInFolder(directory, filenames);
+	for (auto filename: filenames)
 	{
-		if (strcmp(data.name, ".") == 0 || strcmp(data.name, "..") == 0 )
-		{
-			continue;
-		}
-		obj = doParseFile((directory + data.name).c_str());
+		obj = doParseFile((directory + filename).c_str());
 		if (obj == NULL)
 		{
-			inform("Error: Could not open " + directory + data.name);
+			inform("Error: Could not open " + directory + filename);
 			exit(-1);
 		}
 		predicate(obj);
-	} while(_findnext(fileListing, &data) == 0);
-	_findclose(fileListing);
+	}
 
 	return true;
 }
@@ -90,9 +87,11 @@ int main(int argc, char * argv[])
 {
 	Object*	obj;				// generic object
 
+	ProfilePhase phase("Reading configuration");	// times each stage of the conversion
+
 	//Get CK2 install location
 	string CK2Loc = Configuration::getCK2Path();
-	if (CK2Loc[CK2Loc.length() - 1] == '\\')
+	if (CK2Loc[CK2Loc.length() - 1] == '/')
 	{
 		CK2Loc = CK2Loc.substr(0, CK2Loc.length() - 1);
 	}
@@ -105,7 +104,7 @@ int main(int argc, char * argv[])
 
 	//Verify EU3 install location
 	string EU3Loc = Configuration::getEU3Path();
-	if (EU3Loc[EU3Loc.length() - 1] == '\\')
+	if (EU3Loc[EU3Loc.length() - 1] == '/')
 	{
 		EU3Loc = EU3Loc.substr(0, EU3Loc.length() - 1);
 	}
@@ -136,16 +135,19 @@ int main(int argc, char * argv[])
 		if (argc >= 2)
 		{
 			modFolderName = inputFilename.substr(0, inputFilename.find_last_of('.'));
-			modFolderName = modFolderName.substr(modFolderName.find_last_of('\\') + 1, modFolderName.length());
+			modFolderName = modFolderName.substr(modFolderName.find_last_of("/\\") + 1, modFolderName.length());
 		}
 		else
 		{
 			modFolderName = "output";
 		}
 		Configuration::setModPath(modFolderName);
-		string copyCommand = "xcopy mod \"" + modFolderName + "\" /E /C /I /Y";
-		system(copyCommand.c_str());
+		if (!common::TryCopyFolder("mod", modFolderName))
+		{
+			inform("Error: Could not copy the converter mod to " + modFolderName);
+		}
 	}
+	phase.next("Reading CK2 data");
 	inform("Getting CK2 data.");
 
 	inform("\tGetting opinion modifiers");
@@ -154,16 +156,16 @@ int main(int argc, char * argv[])
 
 	if (Configuration::getCK2Mod() != "")
 	{
-		obj = doParseFile((Configuration::getCK2ModPath() + "\\" + Configuration::getCK2Mod() + "/common/opinion_modifiers.txt").c_str()); // for pre-1.06 installs
+		obj = doParseFile((Configuration::getCK2ModPath() + "/" + Configuration::getCK2Mod() + "/common/opinion_modifiers.txt").c_str()); // for pre-1.06 installs
 		if (obj != NULL)
 		{
 			srcOpinionRepository->initOpinions(obj);
 		}
-		doParseDirectoryContents((Configuration::getCK2ModPath() + "\\" + Configuration::getCK2Mod() + "\\common\\opinion_modifiers\\"), [&](Object* eachobj) { srcOpinionRepository->initOpinions(eachobj); });
+		doParseDirectoryContents((Configuration::getCK2ModPath() + "/" + Configuration::getCK2Mod() + "/common/opinion_modifiers/"), [&](Object* eachobj) { srcOpinionRepository->initOpinions(eachobj); });
 	}
 	obj = doParseFile((Configuration::getCK2Path() + "/common/opinion_modifiers.txt").c_str()); // for pre-1.06 installs
 	srcOpinionRepository->initOpinions(obj);
-	if (!doParseDirectoryContents((CK2Loc + "\\common\\opinion_modifiers\\"), [&](Object* eachobj) { srcOpinionRepository->initOpinions(eachobj); }))
+	if (!doParseDirectoryContents((CK2Loc + "/common/opinion_modifiers/"), [&](Object* eachobj) { srcOpinionRepository->initOpinions(eachobj); }))
 	{
 		inform("\t\tError: Could not open opinion_modifiers directory (ok for pre-1.06).");
 		if (obj == NULL)
@@ -179,13 +181,13 @@ int main(int argc, char * argv[])
 	inform("\tGetting building types.");
 	if (Configuration::getCK2Mod() != "")
 	{
-		obj = doParseFile((Configuration::getCK2ModPath() + "\\" + Configuration::getCK2Mod() + "/common/buildings.txt").c_str()); // for pre-1.06 installs
+		obj = doParseFile((Configuration::getCK2ModPath() + "/" + Configuration::getCK2Mod() + "/common/buildings.txt").c_str()); // for pre-1.06 installs
 		srcWorld->addBuildingTypes(obj);
-		doParseDirectoryContents((Configuration::getCK2ModPath() + "\\" + Configuration::getCK2Mod() + "\\common\\buildings\\"), [&](Object* eachobj) { srcWorld->addBuildingTypes(eachobj); });
+		doParseDirectoryContents((Configuration::getCK2ModPath() + "/" + Configuration::getCK2Mod() + "/common/buildings/"), [&](Object* eachobj) { srcWorld->addBuildingTypes(eachobj); });
 	}
 	obj = doParseFile((Configuration::getCK2Path() + "/common/buildings.txt").c_str()); // for pre-1.06 installs
 	srcWorld->addBuildingTypes(obj);
-	if (!doParseDirectoryContents((CK2Loc + "\\common\\buildings\\"), [&](Object* eachobj) { srcWorld->addBuildingTypes(eachobj); }))
+	if (!doParseDirectoryContents((CK2Loc + "/common/buildings/"), [&](Object* eachobj) { srcWorld->addBuildingTypes(eachobj); }))
 	{
 		inform("\t\tError: Could not open buildings directory (ok for pre-1.06).\n");
 
@@ -199,13 +201,13 @@ int main(int argc, char * argv[])
 	inform("\tGetting CK2 religions");
 	if (Configuration::getCK2Mod() != "")
 	{
-		obj = doParseFile((Configuration::getCK2ModPath() + "\\" + Configuration::getCK2Mod() + "/common/religion.txt").c_str()); // for pre-1.06 installs
+		obj = doParseFile((Configuration::getCK2ModPath() + "/" + Configuration::getCK2Mod() + "/common/religion.txt").c_str()); // for pre-1.06 installs
 		CK2Religion::parseReligions(obj);
-		doParseDirectoryContents((Configuration::getCK2ModPath() + "\\" + Configuration::getCK2Mod() + "\\common\\religions\\"), [&](Object* eachobj) { CK2Religion::parseReligions(eachobj); });
+		doParseDirectoryContents((Configuration::getCK2ModPath() + "/" + Configuration::getCK2Mod() + "/common/religions/"), [&](Object* eachobj) { CK2Religion::parseReligions(eachobj); });
 	}
 	obj = doParseFile((Configuration::getCK2Path() + "/common/religion.txt").c_str()); // for pre-1.06 installs
 	CK2Religion::parseReligions(obj);
-	if (!doParseDirectoryContents((CK2Loc + "\\common\\religions\\"), [&](Object* eachobj) { CK2Religion::parseReligions(eachobj); }))
+	if (!doParseDirectoryContents((CK2Loc + "/common/religions/"), [&](Object* eachobj) { CK2Religion::parseReligions(eachobj); }))
 	{
 		inform("\t\tError: Could not open religions directory (ok for pre-1.06).");
 
@@ -220,13 +222,13 @@ int main(int argc, char * argv[])
 	auto CK2CultureGroupMap = std::make_shared<cultureGroupMapping>();
 	if (Configuration::getCK2Mod() != "")
 	{
-		obj = doParseFile((Configuration::getCK2ModPath() + "\\" + Configuration::getCK2Mod() + "/common/cultures.txt").c_str()); // for pre-1.06 installs
+		obj = doParseFile((Configuration::getCK2ModPath() + "/" + Configuration::getCK2Mod() + "/common/cultures.txt").c_str()); // for pre-1.06 installs
 		addCultureGroupMappings(obj, *CK2CultureGroupMap);
-		doParseDirectoryContents((Configuration::getCK2ModPath() + "\\" + Configuration::getCK2Mod() + "\\common\\cultures\\"), [&](Object* eachobj) { addCultureGroupMappings(eachobj, *CK2CultureGroupMap); });
+		doParseDirectoryContents((Configuration::getCK2ModPath() + "/" + Configuration::getCK2Mod() + "/common/cultures/"), [&](Object* eachobj) { addCultureGroupMappings(eachobj, *CK2CultureGroupMap); });
 	}
 	obj = doParseFile((Configuration::getCK2Path() + "/common/cultures.txt").c_str()); // for pre-1.06 installs
 	addCultureGroupMappings(obj, *CK2CultureGroupMap);
-	if (!doParseDirectoryContents((CK2Loc + "\\common\\cultures\\"), [&](Object* eachobj) { addCultureGroupMappings(eachobj, *CK2CultureGroupMap); }))
+	if (!doParseDirectoryContents((CK2Loc + "/common/cultures/"), [&](Object* eachobj) { addCultureGroupMappings(eachobj, *CK2CultureGroupMap); }))
 	{
 		inform("\t\tError: Could not open cultures directory (ok for pre-1.06).");
 		if (obj == NULL)
@@ -240,16 +242,15 @@ int main(int argc, char * argv[])
 	bool modHasFiles = false;
 	if (Configuration::getCK2Mod() != "")
 	{
-		obj = doParseFile((Configuration::getCK2ModPath() + "\\" + Configuration::getCK2Mod() + "/common/landed_titles.txt").c_str()); // for pre-1.06 installs
+		obj = doParseFile((Configuration::getCK2ModPath() + "/" + Configuration::getCK2Mod() + "/common/landed_titles.txt").c_str()); // for pre-1.06 installs
 		if (obj != NULL)
 		{
 			srcWorld->addPotentialTitles(obj);
 			modHasFiles = true;
 		}
-		DWORD dwAttrib = GetFileAttributes((Configuration::getCK2ModPath() + "\\" + Configuration::getCK2Mod() + "\\common\\landed_titles\\").c_str());
-		if (dwAttrib != INVALID_FILE_ATTRIBUTES && (dwAttrib & FILE_ATTRIBUTE_DIRECTORY))
+		if (boost::filesystem::is_directory(Configuration::getCK2ModPath() + "/" + Configuration::getCK2Mod() + "/common/landed_titles/"))
 		{
-			doParseDirectoryContents((Configuration::getCK2ModPath() + "\\" + Configuration::getCK2Mod() + "\\common\\landed_titles\\"), [&](Object* eachobj) { srcWorld->addPotentialTitles(eachobj); });
+			doParseDirectoryContents((Configuration::getCK2ModPath() + "/" + Configuration::getCK2Mod() + "/common/landed_titles/"), [&](Object* eachobj) { srcWorld->addPotentialTitles(eachobj); });
 			modHasFiles = true;
 		}
 	}
@@ -257,7 +258,7 @@ int main(int argc, char * argv[])
 	{
 		obj = doParseFile((Configuration::getCK2Path() + "/common/landed_titles.txt").c_str()); // for pre-1.06 installs
 		srcWorld->addPotentialTitles(obj);
-		if (!doParseDirectoryContents((CK2Loc + "\\common\\landed_titles\\"), [&](Object* eachobj) { srcWorld->addPotentialTitles(eachobj); }))
+		if (!doParseDirectoryContents((CK2Loc + "/common/landed_titles/"), [&](Object* eachobj) { srcWorld->addPotentialTitles(eachobj); }))
 		{
 			inform("\t\tError: Could not open landed_titles directory (ok for pre-1.06).");
 			if (obj == NULL)
@@ -273,16 +274,16 @@ int main(int argc, char * argv[])
 	inform("\tGetting traits");
 	if (Configuration::getCK2Mod() != "")
 	{
-		obj = doParseFile((Configuration::getCK2ModPath() + "\\" + Configuration::getCK2Mod() + "/common/traits.txt").c_str()); // for pre-1.06 installs
+		obj = doParseFile((Configuration::getCK2ModPath() + "/" + Configuration::getCK2Mod() + "/common/traits.txt").c_str()); // for pre-1.06 installs
 		if (obj != NULL)
 		{
 			srcWorld->addTraits(obj);
 		}
-		doParseDirectoryContents((Configuration::getCK2ModPath() + "\\" + Configuration::getCK2Mod() + "\\common\\traits\\"), [&](Object* eachobj) { srcWorld->addTraits(eachobj); });
+		doParseDirectoryContents((Configuration::getCK2ModPath() + "/" + Configuration::getCK2Mod() + "/common/traits/"), [&](Object* eachobj) { srcWorld->addTraits(eachobj); });
 	}
 	obj = doParseFile((Configuration::getCK2Path() + "/common/traits.txt").c_str()); // for pre-1.06 installs
 	srcWorld->addTraits(obj);
-	if (!doParseDirectoryContents((CK2Loc + "\\common\\traits\\"), [&](Object* eachobj) { srcWorld->addTraits(eachobj); }))
+	if (!doParseDirectoryContents((CK2Loc + "/common/traits/"), [&](Object* eachobj) { srcWorld->addTraits(eachobj); }))
 	{
 		log("\t\tError: Could not open traits directory (ok for pre-1.06).\n");
 		printf("\t\tError: Could not open traits directory (ok for pre-1.06).\n");
@@ -297,16 +298,16 @@ int main(int argc, char * argv[])
 	inform("\tAdding dynasties from CK2 Install");
 	if (Configuration::getCK2Mod() != "")
 	{
-		obj = doParseFile((Configuration::getCK2ModPath() + "\\" + Configuration::getCK2Mod() + "/common/dynasties.txt").c_str()); // for pre-1.06 installs
+		obj = doParseFile((Configuration::getCK2ModPath() + "/" + Configuration::getCK2Mod() + "/common/dynasties.txt").c_str()); // for pre-1.06 installs
 		if (obj != NULL)
 		{
 			srcWorld->addDynasties(obj);
 		}
-		doParseDirectoryContents((Configuration::getCK2ModPath() + "\\" + Configuration::getCK2Mod() + "\\common\\dynasties\\"), [&](Object* eachobj) { srcWorld->addDynasties(eachobj); });
+		doParseDirectoryContents((Configuration::getCK2ModPath() + "/" + Configuration::getCK2Mod() + "/common/dynasties/"), [&](Object* eachobj) { srcWorld->addDynasties(eachobj); });
 	}
 	obj = doParseFile((Configuration::getCK2Path() + "/common/dynasties.txt").c_str()); // for pre-1.06 installs
 	srcWorld->addDynasties(obj);
-	if (!doParseDirectoryContents((CK2Loc + "\\common\\dynasties\\"), [&](Object* eachobj) { srcWorld->addDynasties(eachobj); }))
+	if (!doParseDirectoryContents((CK2Loc + "/common/dynasties/"), [&](Object* eachobj) { srcWorld->addDynasties(eachobj); }))
 	{
 		log("\t\tError: Could not open dynasties directory (ok for pre-1.06).\n");
 		printf("\t\tError: Could not open dynasties directory (ok for pre-1.06).\n");
@@ -317,6 +318,7 @@ int main(int argc, char * argv[])
 		}
 	}
 
+	phase.next("Parsing CK2 save");
 	log("Parsing CK2 save.\n");
 	printf("Parsing CK2 save.\n");
 	obj = doParseFile(inputFilename.c_str());
@@ -327,6 +329,7 @@ int main(int argc, char * argv[])
 		exit(-1);
 	}
 
+	phase.next("Importing CK2 save");
 	log("Importing parsed data.\n");
 	printf("Importing parsed data.\n");
 	srcWorld->init(obj, CK2CultureGroupMap);
@@ -337,6 +340,7 @@ int main(int argc, char * argv[])
 
 
 	// Parse province mappings
+	phase.next("Reading mappings and EU3 data");
 	log("Parsing province mappings.\n");
 	printf("Parsing province mappings.\n");
 	const char* mappingFile = "province_mappings.txt";
@@ -435,11 +439,11 @@ int main(int argc, char * argv[])
 	string cultureFile;
 	if (Configuration::getUseConverterMod() == "yes")
 	{
-		cultureFile = Configuration::getModPath() + "\\converter\\common\\cultures.txt";
+		cultureFile = Configuration::getModPath() + "/Converter/common/cultures.txt";
 	}
 	else
 	{
-		cultureFile = Configuration::getEU3Path() + "\\common\\cultures.txt";
+		cultureFile = Configuration::getEU3Path() + "/common/cultures.txt";
 	}
 	obj = doParseFile(cultureFile.c_str());
 	if (obj == NULL)
@@ -457,11 +461,11 @@ int main(int argc, char * argv[])
 	string religionFile;
 	if (Configuration::getUseConverterMod() == "yes")
 	{
-		religionFile = Configuration::getModPath() + "\\converter\\common\\religion.txt";
+		religionFile = Configuration::getModPath() + "/Converter/common/religion.txt";
 	}
 	else
 	{
-		religionFile = Configuration::getEU3Path() + "\\common\\religion.txt";
+		religionFile = Configuration::getEU3Path() + "/common/religion.txt";
 	}
 	obj = doParseFile(religionFile.c_str());
 	if (obj == NULL)
@@ -531,11 +535,11 @@ int main(int argc, char * argv[])
 	// Get continents
 	log("Parsing continents.\n");
 	printf("Parsing continents.\n");
-	obj = doParseFile((Configuration::getEU3Path() + "\\map\\continent.txt").c_str());
+	obj = doParseFile((Configuration::getEU3Path() + "/map/continent.txt").c_str());
 	if (obj == NULL)
 	{
-		log("Error: Could not open %s\n", (Configuration::getEU3Path() + "\\map\\continent.txt").c_str());
-		printf("Error: Could not open %s\n", (Configuration::getEU3Path() + "\\map\\continent.txt").c_str());
+		log("Error: Could not open %s\n", (Configuration::getEU3Path() + "/map/continent.txt").c_str());
+		printf("Error: Could not open %s\n", (Configuration::getEU3Path() + "/map/continent.txt").c_str());
 		exit(-1);
 	}
 	if (obj->getLeaves().size() < 1)
@@ -555,11 +559,11 @@ int main(int argc, char * argv[])
 	// Get trade good data
 	log("Importing trade good data.\n");
 	printf("Importing trade good data.\n");
-	obj = doParseFile((Configuration::getEU3Path() + "\\common\\Prices.txt").c_str());
+	obj = doParseFile((Configuration::getEU3Path() + "/common/Prices.txt").c_str());
 	if (obj == NULL)
 	{
-		log("Error: Could not open %s\n", (Configuration::getEU3Path() + "\\common\\Prices.txt").c_str());
-		printf("Error: Could not open %s\n", (Configuration::getEU3Path() + "\\common\\Prices.txt").c_str());
+		log("Error: Could not open %s\n", (Configuration::getEU3Path() + "/common/Prices.txt").c_str());
+		printf("Error: Could not open %s\n", (Configuration::getEU3Path() + "/common/Prices.txt").c_str());
 		exit(-1);
 	}
 	if (obj->getLeaves().size() < 1)
@@ -572,6 +576,7 @@ int main(int argc, char * argv[])
 
 
 	// Convert
+	phase.next("Converting");
 	log("Converting countries.\n");
 	printf("Converting countries.\n");
 	destWorld.convertCountries(srcWorld->getAllTitles(), religionMap, cultureMap, inverseProvinceMap);
@@ -582,7 +587,7 @@ int main(int argc, char * argv[])
 
 	log("Converting provinces.\n");
 	printf("Converting provinces.\n");
-	Object* positionsObj = doParseFile((Configuration::getEU3Path() + "\\map\\positions.txt").c_str());
+	Object* positionsObj = doParseFile((Configuration::getEU3Path() + "/map/positions.txt").c_str());
 	auto provinces = srcWorld->getProvinces();
 	destWorld.convertProvinces(provinceMap, provinces, cultureMap, religionMap, continentMap, adjacencyMap, tradeGoodMap, EU3ReligionGroupMap, positionsObj);
 
@@ -638,16 +643,17 @@ int main(int argc, char * argv[])
 	destWorld.convertArmies(inverseProvinceMap);
 
 	// Output results
+	phase.next("Outputting save");
 	printf("Outputting save.\n");
 	log("Outputting save.\n");
 	string outputFilename = "";
 	if (Configuration::getUseConverterMod() == "yes")
 	{
-		outputFilename = modFolderName + "\\Converter\\save games\\";
+		outputFilename = modFolderName + "/Converter/save games/";
 		if (argc >= 2)
 		{
 			string filename = inputFilename.substr(0, inputFilename.find_last_of('.'));
-			filename = filename.substr(filename.find_last_of('\\') + 1, filename.length());
+			filename = filename.substr(filename.find_last_of("/\\") + 1, filename.length());
 			outputFilename += filename + ".eu3";
 		}
 		else
@@ -660,7 +666,7 @@ int main(int argc, char * argv[])
 		if (argc >= 2)
 		{
 			string filename = inputFilename.substr(0, inputFilename.find_last_of('.'));
-			filename = filename.substr(filename.find_last_of('\\') + 1, filename.length());
+			filename = filename.substr(filename.find_last_of("/\\") + 1, filename.length());
 			outputFilename += filename + ".eu3";
 		}
 		else
@@ -677,7 +683,12 @@ int main(int argc, char * argv[])
 	}
 	destWorld.output(output);
 	fclose(output);
+	phase.end();
 
+	if (!Profiler::getInstance().writeReport("CK2ToEU3"))
+	{
+		log("Warning: could not write the profiling report.\n");
+	}
 
 	log("Complete.\n");
 	printf("Complete.\n");
@@ -23,29 +23,31 @@
 
 #include "EU3Country.h"
 #include "Log.h"
-#include "Parsers\Parser.h"
-#include "Parsers\Object.h"
+#include "Parsers/Parser.h"
+#include "Parsers/Object.h"
 #include "Configuration.h"
-#include "Common\Date.h"
-#include "CK2World\CK2Province.h"
-#include "CK2World\CK2Title.h"
-#include "CK2World\CK2History.h"
-#include "CK2World\Character\CK2Character.h"
-#include "CK2World\CK2Barony.h"
-#include "CK2World\CK2Techs.h"
-#include "CK2World\CK2Religion.h"
-#include "CK2World\CK2Army.h"
-#include "CK2World\CK2Version.h"
-#include "EU3World\EU3Ruler.h"
-#include "EU3World\EU3Advisor.h"
-#include "EU3World\EU3History.h"
-#include "EU3World\EU3Province.h"
-#include "EU3World\EU3World.h"
-#include "EU3World\EU3Tech.h"
-#include "EU3World\EU3Diplomacy.h"
-#include "EU3World\EU3Army.h"
-#include "EU3World\EU3Navy.h"
+#include "Common/Date.h"
+#include "CK2World/CK2Province.h"
+#include "CK2World/CK2Title.h"
+#include "CK2World/CK2History.h"
+#include "CK2World/Character/CK2Character.h"
+#include "CK2World/CK2Barony.h"
+#include "CK2World/CK2Techs.h"
+#include "CK2World/CK2Religion.h"
+#include "CK2World/CK2Army.h"
+#include "CK2World/CK2Version.h"
+#include "EU3World/EU3Ruler.h"
+#include "EU3World/EU3Advisor.h"
+#include "EU3World/EU3History.h"
+#include "EU3World/EU3Province.h"
+#include "EU3World/EU3World.h"
+#include "EU3World/EU3Tech.h"
+#include "EU3World/EU3Diplomacy.h"
+#include "EU3World/EU3Army.h"
+#include "EU3World/EU3Navy.h"
 #include "VassalizingCoreGettingVassalConverter.h"
+#include <climits>
+#include <cmath>
 #include <fstream>
 using namespace std;
 
@@ -1700,7 +1702,7 @@ vector<EU3Country*> EU3Country::convertVassals(int initialScore, EU3Diplomacy* d
 			newAgreement->type			= "vassal";
 			newAgreement->country1	= this;
 			newAgreement->country2	= vassals[i];
-			newAgreement->startDate	= common::date("1.1.1");
+			newAgreement->startDate	= common::date(1, 1, 1);
 			diplomacy->addAgreement(newAgreement);
 			agreements.push_back(newAgreement);
 			vassals[i]->addAgreement(newAgreement);
@@ -1714,7 +1716,7 @@ vector<EU3Country*> EU3Country::convertVassals(int initialScore, EU3Diplomacy* d
 			newAgreement->type			= "sphere";
 			newAgreement->country1	= this;
 			newAgreement->country2	= vassals[i];
-			newAgreement->startDate	= common::date("1.1.1");
+			newAgreement->startDate	= common::date(1, 1, 1);
 			diplomacy->addAgreement(newAgreement);
 			agreements.push_back(newAgreement);
 			vassals[i]->addAgreement(newAgreement);
@@ -1722,7 +1724,7 @@ vector<EU3Country*> EU3Country::convertVassals(int initialScore, EU3Diplomacy* d
 			newAgreement->type			= "alliance";
 			newAgreement->country1	= this;
 			newAgreement->country2	= vassals[i];
-			newAgreement->startDate	= common::date("1.1.1");
+			newAgreement->startDate	= common::date(1, 1, 1);
 			diplomacy->addAgreement(newAgreement);
 			agreements.push_back(newAgreement);
 			vassals[i]->addAgreement(newAgreement);
@@ -1735,7 +1737,7 @@ vector<EU3Country*> EU3Country::convertVassals(int initialScore, EU3Diplomacy* d
 			newAgreement->type			= "guarantee";
 			newAgreement->country1	= this;
 			newAgreement->country2	= vassals[i];
-			newAgreement->startDate	= common::date("1.1.1");
+			newAgreement->startDate	= common::date(1, 1, 1);
 			diplomacy->addAgreement(newAgreement);
 			agreements.push_back(newAgreement);
 			vassals[i]->addAgreement(newAgreement);
@@ -1743,7 +1745,7 @@ vector<EU3Country*> EU3Country::convertVassals(int initialScore, EU3Diplomacy* d
 			newAgreement->type			= "guarantee";
 			newAgreement->country1	= vassals[i];
 			newAgreement->country2	= this;
-			newAgreement->startDate	= common::date("1.1.1");
+			newAgreement->startDate	= common::date(1, 1, 1);
 			diplomacy->addAgreement(newAgreement);
 			agreements.push_back(newAgreement);
 			vassals[i]->addAgreement(newAgreement);
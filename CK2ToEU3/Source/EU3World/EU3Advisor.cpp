@@ -23,13 +23,13 @@
 
 #include "EU3Advisor.h"
 #include "EU3Province.h"
-#include "Country\EU3Country.h"
-#include "CK2World\Character\CK2Character.h"
-#include "..\CK2World\CK2Dynasty.h"
-#include "..\CK2World\CK2Province.h"
-#include "..\Configuration.h"
-#include "..\Log.h"
-#include "..\Parsers\Object.h"
+#include "Country/EU3Country.h"
+#include "CK2World/Character/CK2Character.h"
+#include "../CK2World/CK2Dynasty.h"
+#include "../CK2World/CK2Province.h"
+#include "../Configuration.h"
+#include "../Log.h"
+#include "../Parsers/Object.h"
 #include <fstream>
 
 
@@ -234,7 +234,7 @@ EU3Advisor::EU3Advisor(CK2Character* src, const inverseProvinceMapping& inverseP
 	}
 
 	startDate = src->getBirthDate();
-	startDate.year += 16;
+	startDate.addYears(16);
 }
 
 
@@ -257,7 +257,7 @@ void EU3Advisor::outputInProvince(FILE* output)
 	{
 		fprintf(output,"\t\t\t\thome=\"%s\"\n", home->getTag().c_str());
 	}
-	fprintf(output,"\t\t\t\tdate=\"%d.%d.%d\"\n", startDate.year, startDate.month, startDate.day);
+	fprintf(output,"\t\t\t\tdate=\"%d.%d.%d\"\n", startDate.getYear(), startDate.getMonth(), startDate.getDay());
 	fprintf(output,"\t\t\t\thire_date=\"1.1.1\"\n");
 	fprintf(output,"\t\t\t\tmove=0\n");
 	fprintf(output,"\t\t\t\tid=\n");
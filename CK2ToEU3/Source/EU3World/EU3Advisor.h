@@ -26,8 +26,8 @@
 
 
 #include <string>
-#include "Common\Date.h"
-#include "..\Mappers.h"
+#include "Common/Date.h"
+#include "../Mappers.h"
 using namespace std;
 
 
@@ -23,9 +23,9 @@
 
 #include "EU3Army.h"
 #include "EU3Province.h"
-#include "..\CK2World\CK2Army.h"
-#include "..\Configuration.h"
-#include "..\Log.h"
+#include "../CK2World/CK2Army.h"
+#include "../Configuration.h"
+#include "../Log.h"
 #include <fstream>
 
 
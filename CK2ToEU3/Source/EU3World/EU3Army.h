@@ -25,7 +25,7 @@
 #define EU3ARMY_H_
 
 
-#include "..\Mappers.h"
+#include "../Mappers.h"
 #include <fstream>
 #include <map>
 #include <vector>
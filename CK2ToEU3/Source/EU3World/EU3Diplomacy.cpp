@@ -22,9 +22,9 @@
 
 
 #include "EU3Diplomacy.h"
-#include "..\Log.h"
-#include "..\Parsers\Object.h"
-#include "Country\EU3Country.h"
+#include "../Log.h"
+#include "../Parsers/Object.h"
+#include "Country/EU3Country.h"
 
 
 
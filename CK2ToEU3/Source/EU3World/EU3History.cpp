@@ -22,8 +22,8 @@
 
 
 #include "EU3History.h"
-#include "CK2World\Character\CK2Character.h"
-#include "..\CK2World\CK2History.h"
+#include "CK2World/Character/CK2Character.h"
+#include "../CK2World/CK2History.h"
 #include "EU3Ruler.h"
 #include "EU3Advisor.h"
 
@@ -97,7 +97,7 @@ EU3History::EU3History(CK2History* src)
 
 void EU3History::output(FILE* output)
 {
-	fprintf(output, "\t\t%d.%d.%d=\n", when.year, when.month, when.day);
+	fprintf(output, "\t\t%d.%d.%d=\n", when.getYear(), when.getMonth(), when.getDay());
 	fprintf(output, "\t\t{\n");
 	if (monarch != NULL)
 	{
@@ -107,7 +107,7 @@ void EU3History::output(FILE* output)
 	{
 		regent->outputAsRegent(output);
 		fprintf(output, "\t\t}\n");
-		fprintf(output, "\t\t%d.%d.%d=\n", when.year, when.month, when.day);
+		fprintf(output, "\t\t%d.%d.%d=\n", when.getYear(), when.getMonth(), when.getDay());
 		fprintf(output, "\t\t{\n");
 	}
 	if (heir != NULL)
@@ -25,8 +25,8 @@
 #define EU3HISTORY_H_
 
 
-#include "Common\Date.h"
-#include "..\Mappers.h"
+#include "Common/Date.h"
+#include "../Mappers.h"
 #include <fstream>
 
 
@@ -22,11 +22,12 @@
 
 
 #include "EU3Navy.h"
+#include <cmath>
 #include "EU3Province.h"
 #include "EU3Army.h"
-#include "..\Configuration.h"
-#include "..\CK2World\CK2Army.h"
-#include "..\Log.h"
+#include "../Configuration.h"
+#include "../CK2World/CK2Army.h"
+#include "../Log.h"
 
 
 EU3Ship::EU3Ship(const string _type, const double _strength)
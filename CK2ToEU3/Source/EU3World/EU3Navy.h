@@ -25,7 +25,7 @@
 #define EU3NAVY_H_
 
 
-#include "..\Mappers.h"
+#include "../Mappers.h"
 #include <string>
 using namespace std;
 
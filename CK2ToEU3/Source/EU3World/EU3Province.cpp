@@ -22,16 +22,16 @@
 
 
 #include "EU3Province.h"
-#include "Country\EU3Country.h"
+#include "Country/EU3Country.h"
 #include "EU3History.h"
 #include "EU3Advisor.h"
-#include "..\Log.h"
-#include "..\Parsers\Object.h"
-#include "..\CK2World\CK2Barony.h"
-#include "..\CK2World\CK2Title.h"
-#include "..\CK2World\Ck2Province.h"
-#include "CK2World\Character\CK2Character.h"
-#include "..\CK2World\CK2Religion.h"
+#include "../Log.h"
+#include "../Parsers/Object.h"
+#include "../CK2World/CK2Barony.h"
+#include "../CK2World/CK2Title.h"
+#include "../CK2World/CK2Province.h"
+#include "CK2World/Character/CK2Character.h"
+#include "../CK2World/CK2Religion.h"
 #include <algorithm>
 
 
@@ -28,8 +28,8 @@
 #include <string>
 #include <vector>
 #include <map>
-#include "Common\Date.h"
-#include "..\Mappers.h"
+#include "Common/Date.h"
+#include "../Mappers.h"
 using namespace std;
 
 
@@ -22,11 +22,11 @@
 
 
 #include "EU3Ruler.h"
-#include "CK2World\Character\CK2Character.h"
-#include "..\CK2World\CK2Dynasty.h"
-#include "..\Configuration.h"
-#include "..\Log.h"
-#include "..\Parsers\Object.h"
+#include "CK2World/Character/CK2Character.h"
+#include "../CK2World/CK2Dynasty.h"
+#include "../Configuration.h"
+#include "../Log.h"
+#include "../Parsers/Object.h"
 #include <fstream>
 
 
@@ -321,8 +321,8 @@ void EU3Ruler::outputAsHeir(FILE* output)
 	{
 		fprintf(output,"\t\t\t\tdynasty=\"%s\"\n", dynasty.c_str());
 	}
-	fprintf(output,"\t\t\t\tbirth_date=\"%d.%d.%d\"\n", birthDate.year, birthDate.month, birthDate.day);
-	fprintf(output,"\t\t\t\tdeath_date=\"%d.%d.%d\"\n", deathDate.year, deathDate.month, deathDate.day);
+	fprintf(output,"\t\t\t\tbirth_date=\"%d.%d.%d\"\n", birthDate.getYear(), birthDate.getMonth(), birthDate.getDay());
+	fprintf(output,"\t\t\t\tdeath_date=\"%d.%d.%d\"\n", deathDate.getYear(), deathDate.getMonth(), deathDate.getDay());
 	fprintf(output,"\t\t\t\tclaim=%d\n", claim);
 	if (monarchName != "")
 	{
@@ -27,7 +27,7 @@
 
 #include <string>
 #include <vector>
-#include "Common\Date.h"
+#include "Common/Date.h"
 using namespace std;
 
 
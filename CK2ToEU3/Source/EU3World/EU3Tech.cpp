@@ -22,7 +22,7 @@
 
 
 #include "EU3Tech.h"
-#include "..\log.h"
+#include "../Log.h"
 
 
 enum techCategory
@@ -101,7 +101,7 @@ EU3Tech::EU3Tech(common::date startDate, Object* mainObj, Object* governmentObj,
 
 		double	level			= groupsItr->second.first;
 		int		nextLevel	= groupsItr->second.first + 1;
-		common::date		currentDate("1399.2.1");
+		common::date		currentDate(1399, 2, 1);
 		int		yearCurrentTech	= governmentYears[nextLevel - 1];
 		int		yearNextTech		= governmentYears[nextLevel];
 		while (currentDate < startDate)
@@ -114,18 +114,13 @@ EU3Tech::EU3Tech(common::date startDate, Object* mainObj, Object* governmentObj,
 				yearNextTech		= governmentYears[nextLevel];
 			}
 
-			currentDate.month++;
-			if (currentDate.month > 12)
-			{
-				currentDate.year++;
-				currentDate.month -= 12;
-			}
+			currentDate.addMonths(1);
 		}
 		startingLevels[GOVERNMENT] = level;
 
 		level					= groupsItr->second.first;
 		nextLevel			= groupsItr->second.first + 1;
-		currentDate			= common::date("1399.2.1");
+		currentDate			= common::date(1399, 2, 1);
 		yearCurrentTech	= productionYears[nextLevel - 1];
 		yearNextTech		= productionYears[nextLevel];
 		while (currentDate < startDate)
@@ -138,18 +133,13 @@ EU3Tech::EU3Tech(common::date startDate, Object* mainObj, Object* governmentObj,
 				yearNextTech		= productionYears[nextLevel];
 			}
 
-			currentDate.month++;
-			if (currentDate.month > 12)
-			{
-				currentDate.year++;
-				currentDate.month -= 12;
-			}
+			currentDate.addMonths(1);
 		}
 		startingLevels[PRODUCTION] = level;
 
 		level					= groupsItr->second.first;
 		nextLevel			= groupsItr->second.first + 1;
-		currentDate			= common::date("1399.2.1");
+		currentDate			= common::date(1399, 2, 1);
 		yearCurrentTech	= tradeYears[nextLevel - 1];
 		yearNextTech		= tradeYears[nextLevel];
 		while (currentDate < startDate)
@@ -162,18 +152,13 @@ EU3Tech::EU3Tech(common::date startDate, Object* mainObj, Object* governmentObj,
 				yearNextTech		= tradeYears[nextLevel];
 			}
 
-			currentDate.month++;
-			if (currentDate.month > 12)
-			{
-				currentDate.year++;
-				currentDate.month -= 12;
-			}
+			currentDate.addMonths(1);
 		}
 		startingLevels[TRADE] = level;
 
 		level					= groupsItr->second.first;
 		nextLevel			= groupsItr->second.first + 1;
-		currentDate			= common::date("1399.2.1");
+		currentDate			= common::date(1399, 2, 1);
 		yearCurrentTech	= navalYears[nextLevel - 1];
 		yearNextTech		= navalYears[nextLevel];
 		while (currentDate < startDate)
@@ -186,18 +171,13 @@ EU3Tech::EU3Tech(common::date startDate, Object* mainObj, Object* governmentObj,
 				yearNextTech		= navalYears[nextLevel];
 			}
 
-			currentDate.month++;
-			if (currentDate.month > 12)
-			{
-				currentDate.year++;
-				currentDate.month -= 12;
-			}
+			currentDate.addMonths(1);
 		}
 		startingLevels[NAVAL] = level;
 
 		level					= groupsItr->second.first;
 		nextLevel			= groupsItr->second.first + 1;
-		currentDate			= common::date("1399.2.1");
+		currentDate			= common::date(1399, 2, 1);
 		yearCurrentTech	= landYears[nextLevel - 1];
 		yearNextTech		= landYears[nextLevel];
 		while (currentDate < startDate)
@@ -210,12 +190,7 @@ EU3Tech::EU3Tech(common::date startDate, Object* mainObj, Object* governmentObj,
 				yearNextTech		= landYears[nextLevel];
 			}
 
-			currentDate.month++;
-			if (currentDate.month > 12)
-			{
-				currentDate.year++;
-				currentDate.month -= 12;
-			}
+			currentDate.addMonths(1);
 		}
 		startingLevels[LAND] = level;
 
@@ -296,13 +271,13 @@ double EU3Tech::getLandTech(string techGroup) const
 
 double EU3Tech::getGovernmentBaseCost(common::date startDate, int level) const
 {
-	int startDiff = governmentYears[level] - startDate.year;
+	int startDiff = governmentYears[level] - startDate.getYear();
 	if (startDiff < 0)
 	{
 		startDiff = 0;
 	}
 
-	double earlyPenalty = 0.2 * (governmentYears[level] - startDate.year);
+	double earlyPenalty = 0.2 * (governmentYears[level] - startDate.getYear());
 	if (earlyPenalty < 0)
 	{
 		earlyPenalty = 0.0f;
@@ -317,13 +292,13 @@ double EU3Tech::getGovernmentBaseCost(common::date startDate, int level) const
 
 double EU3Tech::getProductionBaseCost(common::date startDate, int level) const
 {
-	int startDiff = productionYears[level] - startDate.year;
+	int startDiff = productionYears[level] - startDate.getYear();
 	if (startDiff < 0)
 	{
 		startDiff = 0;
 	}
 
-	double earlyPenalty = 0.2 * (governmentYears[level] - startDate.year);
+	double earlyPenalty = 0.2 * (governmentYears[level] - startDate.getYear());
 	if (earlyPenalty < 0)
 	{
 		earlyPenalty = 0.0f;
@@ -338,13 +313,13 @@ double EU3Tech::getProductionBaseCost(common::date startDate, int level) const
 
 double EU3Tech::getTradeBaseCost(common::date startDate, int level) const
 {
-	int startDiff = tradeYears[level] - startDate.year;
+	int startDiff = tradeYears[level] - startDate.getYear();
 	if (startDiff < 0)
 	{
 		startDiff = 0;
 	}
 
-	double earlyPenalty = 0.2 * (governmentYears[level] - startDate.year);
+	double earlyPenalty = 0.2 * (governmentYears[level] - startDate.getYear());
 	if (earlyPenalty < 0)
 	{
 		earlyPenalty = 0.0f;
@@ -359,13 +334,13 @@ double EU3Tech::getTradeBaseCost(common::date startDate, int level) const
 
 double EU3Tech::getNavalBaseCost(common::date startDate, int level) const
 {
-	int startDiff = navalYears[level] - startDate.year;
+	int startDiff = navalYears[level] - startDate.getYear();
 	if (startDiff < 0)
 	{
 		startDiff = 0;
 	}
 
-	double earlyPenalty = 0.2 * (governmentYears[level] - startDate.year);
+	double earlyPenalty = 0.2 * (governmentYears[level] - startDate.getYear());
 	if (earlyPenalty < 0)
 	{
 		earlyPenalty = 0.0f;
@@ -380,13 +355,13 @@ double EU3Tech::getNavalBaseCost(common::date startDate, int level) const
 
 double EU3Tech::getLandBaseCost(common::date startDate, int level) const
 {
-	int startDiff = landYears[level] - startDate.year;
+	int startDiff = landYears[level] - startDate.getYear();
 	if (startDiff < 0)
 	{
 		startDiff = 0;
 	}
 
-	double earlyPenalty = 0.2 * (governmentYears[level] - startDate.year);
+	double earlyPenalty = 0.2 * (governmentYears[level] - startDate.getYear());
 	if (earlyPenalty < 0)
 	{
 		earlyPenalty = 0.0f;
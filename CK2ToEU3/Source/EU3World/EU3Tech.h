@@ -26,8 +26,8 @@
 
 
 
-#include "..\Parsers\Object.h"
-#include "Common\Date.h"
+#include "../Parsers/Object.h"
+#include "Common/Date.h"
 
 
 
@@ -25,26 +25,26 @@
 #include <string>
 #include <queue>
 #include <algorithm>
-#include <io.h>
 #include <set>
 #include <vector>
 #include <boost/algorithm/string.hpp>
 #include <boost/filesystem.hpp>
 #include <boost/lexical_cast.hpp>
-#include "..\Log.h"
-#include "..\temp.h"
-#include "..\Configuration.h"
-#include "..\Parsers\Parser.h"
-#include "..\Parsers\Object.h"
-#include "..\CK2World\CK2Barony.h"
-#include "..\CK2World\CK2Title.h"
-#include "..\CK2World\CK2Province.h"
-#include "..\CK2World\CK2World.h"
-#include "..\CK2World\CK2Religion.h"
-#include "..\ModWorld\ModCultureRule.h"
-#include "CK2World\Character\CK2Character.h"
+#include "../Log.h"
+#include "../Common/OSCompatibility.h"
+#include "../Temp.h"
+#include "../Configuration.h"
+#include "../Parsers/Parser.h"
+#include "../Parsers/Object.h"
+#include "../CK2World/CK2Barony.h"
+#include "../CK2World/CK2Title.h"
+#include "../CK2World/CK2Province.h"
+#include "../CK2World/CK2World.h"
+#include "../CK2World/CK2Religion.h"
+#include "../ModWorld/ModCultureRule.h"
+#include "CK2World/Character/CK2Character.h"
 #include "EU3Province.h"
-#include "Country\EU3Country.h"
+#include "Country/EU3Country.h"
 #include "EU3Ruler.h"
 #include "EU3Advisor.h"
 #include "EU3Diplomacy.h"
@@ -451,26 +451,21 @@ void EU3World::addHistoricalCountries()
 {
 	string EU3Loc = Configuration::getEU3Path();
 
-	struct _finddata_t	countryDirData;
-	intptr_t					fileListing;
-	if ( (fileListing = _findfirst( (EU3Loc + "\\history\\countries\\*").c_str(), &countryDirData)) == -1L)
+	if (!boost::filesystem::is_directory(EU3Loc + "/history/countries"))
 	{
 		log("Error: Could not open country history directory.\n");
 		return;
 	}
-	do
+	set<string> countryFilenames;
+	common::GetAllFilesInFolder(EU3Loc + "/history/countries", countryFilenames);
+	for (auto countryFilename: countryFilenames)
 	{
-		if (strcmp(countryDirData.name, ".") == 0 || strcmp(countryDirData.name, "..") == 0 )
-		{
-				continue;
-		}
-
 		string filename;
-		filename	=  EU3Loc + "\\history\\countries\\";
-		filename	+= countryDirData.name;
+		filename	=  EU3Loc + "/history/countries/";
+		filename	+= countryFilename;
 
 		string tag;
-		tag = string(countryDirData.name).substr(0, 3);
+		tag = countryFilename.substr(0, 3);
 		transform(tag.begin(), tag.end(), tag.begin(), ::toupper);
 
 		if (tag == "REB")
@@ -480,32 +475,25 @@ void EU3World::addHistoricalCountries()
 
 		EU3Country* newCountry = new EU3Country(this, tag, filename, startDate, techData);
 		countries.insert(make_pair(tag, newCountry));
-
-	} while(_findnext(fileListing, &countryDirData) == 0);
-	_findclose(fileListing);
+	}
 
 	if (Configuration::getUseConverterMod() == "yes")
 	{
-		struct _finddata_t	countryDirData;
-		intptr_t					fileListing;
-		if ( (fileListing = _findfirst( (Configuration::getModPath() + "\\converter\\history\\countries\\*").c_str(), &countryDirData)) == -1L)
+		if (!boost::filesystem::is_directory(Configuration::getModPath() + "/Converter/history/countries"))
 		{
 			log("Error: Could not open country history directory.\n");
 			return;
 		}
-		do
+		set<string> modCountryFilenames;
+		common::GetAllFilesInFolder(Configuration::getModPath() + "/Converter/history/countries", modCountryFilenames);
+		for (auto countryFilename: modCountryFilenames)
 		{
-			if (strcmp(countryDirData.name, ".") == 0 || strcmp(countryDirData.name, "..") == 0 )
-			{
-					continue;
-			}
-
 			string filename;
-			filename	=  Configuration::getModPath() + "\\converter\\history\\countries\\";
-			filename	+= countryDirData.name;
+			filename	=  Configuration::getModPath() + "/Converter/history/countries/";
+			filename	+= countryFilename;
 
 			string tag;
-			tag = string(countryDirData.name).substr(0, 3);
+			tag = countryFilename.substr(0, 3);
 			transform(tag.begin(), tag.end(), tag.begin(), ::toupper);
 
 			if (tag == "REB")
@@ -515,35 +503,44 @@ void EU3World::addHistoricalCountries()
 
 			EU3Country* newCountry = new EU3Country(this, tag, filename, startDate, techData);
 			countries.insert(make_pair(tag, newCountry));
-
-		} while(_findnext(fileListing, &countryDirData) == 0);
-		_findclose(fileListing);
+		}
 	}
 }
 
 
 void EU3World::setupProvinces(provinceMapping& provinceMap)
 {
+	// list the province history files once, by the province number that starts their names
+	set<string> provinceFilenames;
+	common::GetAllFilesInFolder(Configuration::getEU3Path() + "/history/provinces", provinceFilenames);
+	map<int, string> provinceFiles;
+	for (auto provinceFilename: provinceFilenames)
+	{
+		if ((provinceFilename.find('-') == string::npos) || (provinceFilename.size() < 4) || (provinceFilename.substr(provinceFilename.size() - 4) != ".txt"))
+		{
+			continue;
+		}
+		int provinceNum = atoi(provinceFilename.c_str());
+		if ((provinceNum > 0) || (provinceFilename[0] == '0'))
+		{
+			provinceFiles.insert(make_pair(provinceNum, provinceFilename));
+		}
+	}
+
 	for (provinceMapping::iterator i = provinceMap.begin(); i != provinceMap.end(); i++)
 	{
 		//parse relevant file
 		Object* obj;
-		char num[5];
-		_itoa_s(i->first, num, 5, 10);
-
-		string filename = Configuration::getEU3Path() + "\\history\\provinces\\" + num + "*-*.txt";
-		struct _finddata_t	fileData;
-		intptr_t					fileListing;
-		if ( (fileListing = _findfirst(filename.c_str(), &fileData)) != -1L)
+		map<int, string>::iterator provinceFile = provinceFiles.find(i->first);
+		if (provinceFile != provinceFiles.end())
 		{
-			obj = doParseFile( (Configuration::getEU3Path() + "\\history\\provinces\\" + fileData.name).c_str() );
+			obj = doParseFile( (Configuration::getEU3Path() + "/history/provinces/" + provinceFile->second).c_str() );
 			if (obj == NULL)
 			{
-				log("Error: Could not open %s\n", (Configuration::getEU3Path() + "\\history\\provinces\\" + fileData.name).c_str());
-				printf("Error: Could not open %s\n", (Configuration::getEU3Path() + "\\history\\provinces\\" + fileData.name).c_str());
+				log("Error: Could not open %s\n", (Configuration::getEU3Path() + "/history/provinces/" + provinceFile->second).c_str());
+				printf("Error: Could not open %s\n", (Configuration::getEU3Path() + "/history/provinces/" + provinceFile->second).c_str());
 				exit(-1);
 			}
-			_findclose(fileListing);
 		}
 		else
 		{
@@ -587,10 +584,10 @@ void EU3World::convertCountries(map<string, CK2Title*> CK2Titles, const religion
 void EU3World::getCultureRules()
 {
 	// get mod culture rules
-    Object* obj = doParseFile( (Configuration::getModPath() + "\\config\\culture_rules.txt").c_str() );
+    Object* obj = doParseFile( (Configuration::getModPath() + "/config/culture_rules.txt").c_str() );
 	if (obj == NULL)
 	{
-		log( ("Error: Could not open" + Configuration::getModPath() + "\\config\\culture_rules.txt\n").c_str() );
+		log( ("Error: Could not open" + Configuration::getModPath() + "/config/culture_rules.txt\n").c_str() );
 		printf("Error: Could not open culture_rules.txt\n");
 		exit(-1);
 	}
@@ -1023,22 +1020,15 @@ void EU3World::convertAdvisors(inverseProvinceMapping& inverseProvinceMap, provi
 	// ROTW Advisors
 	string EU3Loc = Configuration::getEU3Path();
 
-	struct _finddata_t	advisorDirData;
-	intptr_t					fileListing;
-	if ( (fileListing = _findfirst( (EU3Loc + "\\history\\advisors\\*").c_str(), &advisorDirData)) == -1L)
+	if (!boost::filesystem::is_directory(EU3Loc + "/history/advisors"))
 	{
 		log("\tError: Could not open advisors history directory.\n");
 		return;
 	}
-	do
+	set<string> advisorFilenames;
+	common::GetAllFilesInFolder(EU3Loc + "/history/advisors", advisorFilenames);
+	for (auto filename: advisorFilenames)
 	{
-		if (strcmp(advisorDirData.name, ".") == 0 || strcmp(advisorDirData.name, "..") == 0 )
-		{
-				continue;
-		}
-
-		string filename;
-		filename = advisorDirData.name;
 
 		Object* obj;
 		obj = doParseFile((Configuration::getEU3Path() + "/history/advisors/" + filename).c_str());
@@ -1063,9 +1053,7 @@ void EU3World::convertAdvisors(inverseProvinceMapping& inverseProvinceMap, provi
 				}
 			}
 		}
-
-	} while(_findnext(fileListing, &advisorDirData) == 0);
-	_findclose(fileListing);
+	}
 }
 
 
@@ -1149,10 +1137,10 @@ void EU3World::convertTech(const CK2World& srcWorld)
 	}
 	else // (Configuration::getTechGroupMethod() == "culturalTech")
 	{
-		double catholicTech	=	1.0		+ ( ((double)(startDate.year - 1066) / (1453 - 1066)) * (3.5 - 1.0));
-		double greekTech		=	(6.5/3)	+ ( ((double)(startDate.year - 1066) / (1453 - 1066)) * (3.5 - (6.5/3)) );
-		double muslimTech		=	(6.2/3)	+ ( ((double)(startDate.year - 1066) / (1453 - 1066)) * (3.0 - (6.2/3)) );
-		double otherTech		=	0.0		+ ( ((double)(startDate.year - 1066) / (1453 - 1066)) * (2.5 - 0.0) );
+		double catholicTech	=	1.0		+ ( ((double)(startDate.getYear() - 1066) / (1453 - 1066)) * (3.5 - 1.0));
+		double greekTech		=	(6.5/3)	+ ( ((double)(startDate.getYear() - 1066) / (1453 - 1066)) * (3.5 - (6.5/3)) );
+		double muslimTech		=	(6.2/3)	+ ( ((double)(startDate.getYear() - 1066) / (1453 - 1066)) * (3.0 - (6.2/3)) );
+		double otherTech		=	0.0		+ ( ((double)(startDate.getYear() - 1066) / (1453 - 1066)) * (2.5 - 0.0) );
 		log("\tCatholicTech: %f\n", catholicTech);
 		log("\tgreekTech: %f\n", greekTech);
 		log("\tmuslimTech: %f\n", muslimTech);
@@ -1600,7 +1588,7 @@ void EU3World::convertDiplomacy(CK2Version& version)
 					{
 						auto agr = std::make_shared<EU3Agreement>();
 						agr->type = "open_market";
-						agr->startDate = common::date("1.1.1");
+						agr->startDate = common::date(1, 1, 1);
 						agr->country1 = itr->second;
 						agr->country2 = jtr->second;
 						diplomacy->addAgreement(agr);
@@ -1620,7 +1608,7 @@ void EU3World::convertDiplomacy(CK2Version& version)
 					{
 						auto agr = make_shared<EU3Agreement>();
 						agr->type = "open_market";
-						agr->startDate = common::date("1.1.1");
+						agr->startDate = common::date(1, 1, 1);
 						agr->country1 = jtr->second;
 						agr->country2 = itr->second;
 						diplomacy->addAgreement(agr);
@@ -1648,7 +1636,7 @@ void EU3World::convertDiplomacy(CK2Version& version)
 			{
 				auto agr = make_shared<EU3Agreement>();
 				agr->type = "union";
-				agr->startDate = common::date("1.1.1");
+				agr->startDate = common::date(1, 1, 1);
 				if (rhsDominant)
 				{
 					agr->country1 = jtr->second;
@@ -1669,7 +1657,7 @@ void EU3World::convertDiplomacy(CK2Version& version)
 			{
 				auto agr = make_shared<EU3Agreement>();
 				agr->type = "royal_marriage";
-				agr->startDate = common::date("1.1.1");
+				agr->startDate = common::date(1, 1, 1);
 				agr->country1 = itr->second;
 				agr->country2 = jtr->second;
 				diplomacy->addAgreement(agr);
@@ -1682,7 +1670,7 @@ void EU3World::convertDiplomacy(CK2Version& version)
 			{
 				auto agr = make_shared<EU3Agreement>();
 				agr->type = "alliance";
-				agr->startDate = common::date("1.1.1");
+				agr->startDate = common::date(1, 1, 1);
 				agr->country1 = itr->second;
 				agr->country2 = jtr->second;
 				diplomacy->addAgreement(agr);
@@ -2481,11 +2469,11 @@ void EU3World::addModCountries(const vector<EU3Country*>& modCountries, set<stri
     getCultureRules();
 
 	// parse overrides file
-	Object* obj = doParseFile( (Configuration::getModPath() + "\\config\\overrides.txt").c_str() );
+	Object* obj = doParseFile( (Configuration::getModPath() + "/config/overrides.txt").c_str() );
 	if (obj == NULL)
 	{
-		log("Error: Could not open %s\n",(Configuration::getModPath() + "\\config\\overrides.txt").c_str()) ;
-		printf("Error: Could not open %s\n",(Configuration::getModPath() + "\\config\\overrides.txt").c_str()) ;
+		log("Error: Could not open %s\n",(Configuration::getModPath() + "/config/overrides.txt").c_str()) ;
+		printf("Error: Could not open %s\n",(Configuration::getModPath() + "/config/overrides.txt").c_str()) ;
 		exit(-1);
 	}
 
@@ -2508,40 +2496,33 @@ void EU3World::addModCountries(const vector<EU3Country*>& modCountries, set<stri
 
 	// get CK2 localisations
 	map<string, string>	localisations;
-	struct _finddata_t	data;
-	intptr_t					fileListing;
-	if ( (fileListing = _findfirst( (Configuration::getCK2Path() + "\\localisation\\*").c_str(), &data)) != -1L)
+	set<string> localisationFilenames;
+	common::GetAllFilesInFolder(Configuration::getCK2Path() + "/localisation", localisationFilenames);
+	for (auto localisationFilename: localisationFilenames)
 	{
-		do
+		FILE* localisationsFile;
+		fopen_s( &localisationsFile, (Configuration::getCK2Path() + "/localisation/" + localisationFilename).c_str(), "rb");
+		if (localisationsFile == NULL)
 		{
-			if (strcmp(data.name, ".") == 0 || strcmp(data.name, "..") == 0 )
+			continue;
+		}
+		while (!feof(localisationsFile))
+		{
+			char line[4096];
+			fgets(line, sizeof(line), localisationsFile);
+			if ((line[0] == '#') || (line[0] == '\0'))
 			{
 				continue;
 			}
-			FILE* localisationsFile;
-			fopen_s( &localisationsFile, (Configuration::getCK2Path() + "\\localisation\\" + data.name).c_str(), "rb");
-			if (localisationsFile == NULL)
+			string fullLine = line;
+			int pos = fullLine.find_first_of(';');
+			if (pos == string::npos)
 			{
 				continue;
 			}
-			while (!feof(localisationsFile))
-			{
-				char line[4096];
-				fgets(line, sizeof(line), localisationsFile);
-				if ((line[0] == '#') || (line[0] == '\0'))
-				{
-					continue;
-				}
-				string fullLine = line;
-				int pos = fullLine.find_first_of(';');
-				if (pos == string::npos)
-				{
-					continue;
-				}
-				localisations.insert( make_pair(fullLine.substr(0, pos), fullLine.substr(pos, fullLine.size())) );
-			}
-		} while(_findnext(fileListing, &data) == 0);
-		_findclose(fileListing);
+			localisations.insert( make_pair(fullLine.substr(0, pos), fullLine.substr(pos, fullLine.size())) );
+		}
+		fclose(localisationsFile);
 	}
 
 	// sort titles by rank
@@ -2576,10 +2557,10 @@ void EU3World::addModCountries(const vector<EU3Country*>& modCountries, set<stri
 	}
 
 	FILE* EU3Localisations;
-	fopen_s(&EU3Localisations, (Configuration::getModPath() + "\\Converter\\localisation\\converter.csv").c_str(), "a");
+	fopen_s(&EU3Localisations, (Configuration::getModPath() + "/Converter/localisation/converter.csv").c_str(), "a");
 	if (EU3Localisations == NULL)
 	{
-		log("\tError: Could not open %s\\Converter\\localisation\\converter.csv\n", Configuration::getModPath().c_str());
+		log("\tError: Could not open %s/Converter/localisation/converter.csv\n", Configuration::getModPath().c_str());
 	}
 
 	FILE* resultsFile;
@@ -2591,7 +2572,7 @@ void EU3World::addModCountries(const vector<EU3Country*>& modCountries, set<stri
 
 	// assign tags
 	FILE* countriesList;
-	fopen_s(&countriesList, (Configuration::getModPath() + "\\converter\\common\\countries.txt").c_str(), "a");
+	fopen_s(&countriesList, (Configuration::getModPath() + "/Converter/common/countries.txt").c_str(), "a");
 	fprintf(countriesList, "\n");
 	char first	= 'A';
 	char second	= 'A';
@@ -2730,7 +2711,7 @@ void EU3World::addModCountries(const vector<EU3Country*>& modCountries, set<stri
 
 		// determine filename
 		string filename = Configuration::getEU3Path();
-		filename += "\\common\\countries\\";
+		filename += "/common/countries/";
 		filename	+= titleString.substr(2, titleString.size());
 		filename += ".txt";
 		int number = 0;
@@ -2738,12 +2719,12 @@ void EU3World::addModCountries(const vector<EU3Country*>& modCountries, set<stri
 		{
 			number++;
 			filename	=  Configuration::getEU3Path();
-			filename	+= "\\common\\countries\\";
+			filename	+= "/common/countries/";
 			filename += titleString.substr(2, titleString.size());
 			filename	+= boost::lexical_cast<string>(number);
 			filename	+= ".txt";
 		}
-		filename	=  Configuration::getModPath() + "\\converter\\common\\countries\\";
+		filename	=  Configuration::getModPath() + "/Converter/common/countries/";
 		filename += titleString.substr(2, titleString.size());
 		if (number > 0)
 		{
@@ -2757,7 +2738,7 @@ void EU3World::addModCountries(const vector<EU3Country*>& modCountries, set<stri
 		outputCountryFile(countryFile, *countryItr);
 		fclose(countryFile);
 
-		string shortFilename = "countries\\";
+		string shortFilename = "countries/";
 		shortFilename += titleString.substr(2, titleString.size());
 		if (number > 0)
 		{
@@ -2767,23 +2748,19 @@ void EU3World::addModCountries(const vector<EU3Country*>& modCountries, set<stri
 		fprintf(countriesList, "%s\t= \"%s\"\n", tag.c_str(), shortFilename.c_str());
 
 		//copy flag
-		string srcFlag	=  "\"";
-		srcFlag			+= Configuration::getCK2Path();
-		srcFlag			+= "\\gfx\\flags\\";
+		string srcFlag	=  Configuration::getCK2Path();
+		srcFlag			+= "/gfx/flags/";
 		srcFlag			+= titleString;
-		srcFlag			+= ".tga\"";
+		srcFlag			+= ".tga";
 
-		string dstFlag	=  "\"";
-		dstFlag			+= Configuration::getModPath() + "\\Converter\\gfx\\flags\\";
+		string dstFlag	=  Configuration::getModPath() + "/Converter/gfx/flags/";
 		dstFlag			+= tag;
-		dstFlag			+= ".tga\"";
-
-		string command	=  "copy ";
-		command			+= srcFlag;
-		command			+= " ";
-		command			+= dstFlag;
+		dstFlag			+= ".tga";
 
-		system(command.c_str());
+		if (!common::TryCopyFile(srcFlag, dstFlag))
+		{
+			log("\tWarning: Could not copy %s to %s\n", srcFlag.c_str(), dstFlag.c_str());
+		}
 
 		// record in newCountries.txt
 		fprintf(resultsFile, "# Country mapping: CK2=%s -> EU3=%s\n", titleString.c_str(), tag.c_str());
@@ -29,9 +29,9 @@
 #include <memory>
 #include <tuple>
 #include <set>
-#include "..\Mappers.h"
-#include "Common\Date.h"
-#include "..\ModWorld\ModCultureRule.h"
+#include "../Mappers.h"
+#include "Common/Date.h"
+#include "../ModWorld/ModCultureRule.h"
 
 
 
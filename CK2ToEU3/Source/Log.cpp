@@ -24,7 +24,11 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 #include <fstream>
 #include <iostream>
 
+#ifdef _WIN32
 #include <Windows.h>
+#endif
+
+#include "Common/OSCompatibility.h"
 
 Log::Log(LogLevel level)
 {
@@ -56,6 +60,7 @@ void Log::WriteToConsole(LogLevel level, const std::string& logMessage)
 		return;
 	}
 
+#ifdef _WIN32
 	HANDLE console = GetStdHandle(STD_OUTPUT_HANDLE);	// a handle to the console window
 	if (console != INVALID_HANDLE_VALUE)
 	{
@@ -92,6 +97,7 @@ void Log::WriteToConsole(LogLevel level, const std::string& logMessage)
 			return;
 		}
 	}
+#endif
 
 	std::cout << logMessage;
 }
@@ -103,7 +109,7 @@ void Log::WriteToFile(LogLevel level, const std::string& logMessage)
 	time_t rawtime;	// the raw time data
 	time(&rawtime);
 	tm timeInfo;		// the processed time data
-	errno_t error = localtime_s(&timeInfo, &rawtime);	// wheter or not there was an error
+	int error = localtime_s(&timeInfo, &rawtime);	// wheter or not there was an error
 	if (error == 0)
 	{
 		char timeBuffer[64];	// the formatted time
@@ -20,8 +20,8 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 #ifndef LOG_BASE_H
 #define LOG_BASE_H
 #include <sstream>
-#include <boost\make_shared.hpp>
-#include <boost\shared_ptr.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/shared_ptr.hpp>
 
 enum LogLevel
 {
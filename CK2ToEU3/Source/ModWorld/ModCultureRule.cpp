@@ -3,8 +3,8 @@
 #include <algorithm>
 #include <string>
 #include <sstream>
-#include "..\Log.h"
-#include "..\Parsers\Object.h"
+#include "../Log.h"
+#include "../Parsers/Object.h"
 
 using namespace boost;
 
@@ -46,9 +46,11 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 #include "Parser.h"
 #include <fstream>
+#include <iterator>
 #include <boost/spirit/include/support_istream_iterator.hpp>
 #include <boost/spirit/include/qi.hpp>
-#include "..\Log.h"
+#include "../Log.h"
+#include "../../../common_items/ZipArchive.h"
 
 using namespace boost::spirit;
 
@@ -272,7 +274,7 @@ string bufferOneObject(istream& read)
 }
 
 
-bool readFile(ifstream& read)
+bool readFile(istream& read)
 {
 	clearStack();
 	read.unsetf(std::ios::skipws);
@@ -411,23 +413,83 @@ void setAssign()
 }
 
 
+// Lets the parser read a decompressed save straight from memory
+class MemoryBuffer : public std::streambuf
+{
+public:
+	MemoryBuffer(vector<char>& contents)
+	{
+		setg(contents.data(), contents.data(), contents.data() + contents.size());
+	}
+};
+
+
+// Reads a compressed save, which holds the whole save in one entry, alongside a copy of its header fields (meta).
+// Returns false if the archive could not be read.
+bool readZipFile(ifstream& read, const char* filename)
+{
+	vector<char> archiveData((istreambuf_iterator<char>(read)), istreambuf_iterator<char>());	// the compressed save
+	ZipArchive archive(archiveData.data(), archiveData.size());
+	if (!archive.isValid())
+	{
+		LOG(LogLevel::Error) << "Could not read the compressed file " << filename << ": " << archive.getError() << "\n";
+		return false;
+	}
+
+	for (auto& name: archive.getEntryNames())
+	{
+		if (name == "meta")
+		{
+			continue;
+		}
+
+		vector<char> contents;	// the decompressed save
+		if (!archive.extract(name, contents))
+		{
+			LOG(LogLevel::Error) << "Could not decompress " << filename << ": " << archive.getError() << "\n";
+			return false;
+		}
+		MemoryBuffer buffer(contents);
+		istream stream(&buffer);
+		readFile(stream);
+		return true;
+	}
+
+	LOG(LogLevel::Error) << "The compressed file " << filename << " does not contain a save\n";
+	return false;
+}
+
+
 Object* doParseFile(const char* filename)
 {
 	ifstream	read;				// ifstream for reading files
 
 	/* - when using parser debugging, also ensure that the parser object is non-static!
 	debugme = false;
-	if (string(filename) == "D:\\Victoria 2\\technologies\\commerce_tech.txt")
+	if (string(filename) == "D:/Victoria 2/technologies/commerce_tech.txt")
 		debugme = true;
 	*/
 
 	initParser();
 	Object* obj = getTopLevel();	// the top level object
-	read.open(filename);
+	read.open(filename, ios::binary);
 	if (!read.is_open())
 	{
 		return NULL;
 	}
+
+	char signature[4] = { 0 };	// the start of the file, to identify compressed saves
+	read.read(signature, 4);
+	read.clear();
+	read.seekg(0);
+	if (ZipArchive::isZipArchive(signature, signature + 4))
+	{
+		return (readZipFile(read, filename) ? obj : NULL);
+	}
+
+	// everything else is read as text
+	read.close();
+	read.open(filename);
 	readFile(read);
 	read.close();
 	read.clear();
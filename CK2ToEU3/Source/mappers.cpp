@@ -21,17 +21,18 @@
 
 
 
-#include "mappers.h"
+#include "Mappers.h"
 #include "Log.h"
 #include "Configuration.h"
-#include "Parsers\Object.h"
-#include "CK2World\CK2Version.h"
-#include "CK2World\CK2Title.h"
-#include "CK2World\CK2Province.h"
-#include "CK2World\CK2Barony.h"
-#include "CK2World\CK2Religion.h"
-#include "CK2World\Character\CK2Character.h"
-#include "EU3World\Country\EU3Country.h"
+#include "Common/OSCompatibility.h"
+#include "Parsers/Object.h"
+#include "CK2World/CK2Version.h"
+#include "CK2World/CK2Title.h"
+#include "CK2World/CK2Province.h"
+#include "CK2World/CK2Barony.h"
+#include "CK2World/CK2Religion.h"
+#include "CK2World/Character/CK2Character.h"
+#include "EU3World/Country/EU3Country.h"
 #include <cstdio>
 #include <sstream>
 
@@ -137,7 +138,7 @@ continentMapping initContinentMap(Object* obj)
 adjacencyMapping initAdjacencyMap()
 {
 	FILE* adjacenciesBin;
-	fopen_s( &adjacenciesBin, (Configuration::getEU3Path() + "\\map\\cache\\adjacencies.bin").c_str(), "rb");
+	fopen_s( &adjacenciesBin, (Configuration::getEU3Path() + "/map/cache/adjacencies.bin").c_str(), "rb");
 	if (adjacenciesBin == NULL)
 	{
 		log("Error: Could not open adjacencies.bin\n");
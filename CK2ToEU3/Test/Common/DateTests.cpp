@@ -40,5 +40,35 @@ TEST_F(DateShould, GetStringRepresentationInProperFromat)
     ASSERT_EQ("1.1.1", d.toString());
 }
 
+TEST_F(DateShould, ParseYearMonthAndDay)
+{
+    date d("1066.9.15");
+    ASSERT_EQ(1066, d.getYear());
+    ASSERT_EQ(9, d.getMonth());
+    ASSERT_EQ(15, d.getDay());
+}
+
+TEST_F(DateShould, ParseQuotedDates)
+{
+    ASSERT_EQ(date(1399, 2, 1), date("\"1399.2.1\""));
+}
+
+TEST_F(DateShould, CompareByYearThenMonthThenDay)
+{
+    ASSERT_LT(date("1066.12.31"), date("1067.1.1"));
+    ASSERT_LT(date("1066.2.28"), date("1066.10.1"));
+    ASSERT_LT(date("1066.10.1"), date("1066.10.2"));
+    ASSERT_GT(date("1453.1.1"), date("-5.1.1"));
+}
+
+TEST_F(DateShould, WrapMonthsIntoYears)
+{
+    date d(1399, 12, 1);
+    d.addMonths(1);
+    ASSERT_EQ(date(1400, 1, 1), d);
+    d.addYears(-4);
+    ASSERT_EQ(date(1396, 1, 1), d);
+}
+
 } // namespace unittests
 } // namespace common
@@ -31,10 +31,10 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 #include <boost/algorithm/string.hpp>
 
-#include "EU3World\EU3World.h"
-#include "Parsers\Object.h"
-#include "Parsers\Parser.h"
-#include "V2World\V2World.h"
+#include "EU3World/EU3World.h"
+#include "Parsers/Object.h"
+#include "Parsers/Parser.h"
+#include "V2World/V2World.h"
 #include "Log.h"
 
 bool CountryMapping::ReadRules(const std::string& fileName)
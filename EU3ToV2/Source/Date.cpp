@@ -21,7 +21,8 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 
 #include "Date.h"
-#include "Parsers\Object.h"
+#include "Parsers/Object.h"
+#include "WinUtils.h"
 
 
 
@@ -244,10 +244,10 @@ void AddCategoryToRegimentTypeMap(Object* obj, RegimentCategory category, string
 
 void AddUnitFileToRegimentTypeMap(string directory, string name, RegimentTypeMap& rtm)
 {
-	Object* obj = doParseFile((directory + "\\" + name + ".txt").c_str());
+	Object* obj = doParseFile((directory + "/" + name + ".txt").c_str());
 	if (obj == NULL)
 	{
-		LOG(LogLevel::Error) << "Could not parse file " << directory << '\\' << name << ".txt";
+		LOG(LogLevel::Error) << "Could not parse file " << directory << '/' << name << ".txt";
 		exit(-1);
 	}
 
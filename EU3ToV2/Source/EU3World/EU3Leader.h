@@ -24,7 +24,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 #define EU3LEADER_H_
 
 
-#include "../date.h"
+#include "../Date.h"
 
 class Object;
 
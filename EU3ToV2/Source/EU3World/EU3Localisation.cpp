@@ -23,10 +23,11 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 #include "EU3Localisation.h"
 #include <fstream>
+#include <set>
 #include <vector>
-#include <Windows.h>
 #include <boost/tokenizer.hpp>
 #include <iterator>
+#include "../WinUtils.h"
 using namespace std;
 using namespace boost;
 
@@ -94,26 +95,13 @@ void EU3Localisation::ReadFromFile(const std::string& fileName)
 void EU3Localisation::ReadFromAllFilesInFolder(const std::string& folderPath)
 {
 	// Get all files in the folder.
-	std::vector<std::string> fileNames;
-	WIN32_FIND_DATA findData;	// the file data
-	HANDLE findHandle = FindFirstFile((folderPath + "\\*").c_str(), &findData);	// the find handle
-	if (findHandle == INVALID_HANDLE_VALUE)
-	{
-		return;
-	}
-	do
-	{
-		if (!(findData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY))
-		{
-			fileNames.push_back(findData.cFileName);
-		}
-	} while (FindNextFile(findHandle, &findData) != 0);
-	FindClose(findHandle);
+	std::set<std::string> fileNames;
+	WinUtils::GetAllFilesInFolder(folderPath, fileNames);
 
 	// Read all these files.
 	for (const auto& fileName : fileNames)
 	{
-		ReadFromFile(folderPath + '\\' + fileName);
+		ReadFromFile(folderPath + '/' + fileName);
 	}
 }
 
@@ -36,7 +36,7 @@ struct EU3Agreement;
 
 
 
-enum WorldType
+enum WorldType : int
 {
 	unknown = 0,
 	VeryOld,
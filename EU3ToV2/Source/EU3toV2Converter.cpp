@@ -20,15 +20,13 @@ TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
 SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 
-#include <io.h>
 #include <stdexcept>
 #include <fstream>
-#include <sys/stat.h>
-#include <io.h>
-#include <Windows.h>
+#include <set>
 #include "Configuration.h"
 #include "Log.h"
-#include "Parsers\Parser.h"
+#include "WinUtils.h"
+#include "Parsers/Parser.h"
 #include "EU3World/EU3World.h"
 #include "EU3World/EU3Religion.h"
 #include "EU3World/EU3Localisation.h"
@@ -36,6 +34,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 #include "V2World/V2Factory.h"
 #include "V2World/V2TechSchools.h"
 #include "V2World/V2LeaderTraits.h"
+#include "../../common_items/Profiler.h"
 
 
 
@@ -46,17 +45,15 @@ int ConvertEU3ToV2(const std::string& EU3SaveFileName)
 	Object*	obj;				// generic object
 	ifstream	read;				// ifstream for reading files
 
-	char curDir[MAX_PATH];
-	GetCurrentDirectory(MAX_PATH, curDir);
-	LOG(LogLevel::Debug) << "Current directory is " << curDir;
+	LOG(LogLevel::Debug) << "Current directory is " << WinUtils::GetCurrentFolder();
 
+	ProfilePhase phase("Reading configuration");	// times each stage of the conversion
 	Configuration::getInstance();
 
 	//Get V2 install location
 	LOG(LogLevel::Info) << "Get V2 Install Path";
 	string V2Loc = Configuration::getV2Path();
-	struct _stat st;
-	if (V2Loc.empty() || (_stat(V2Loc.c_str(), &st) != 0))
+	if (V2Loc.empty() || !WinUtils::DoesFolderExist(V2Loc))
 	{
 		LOG(LogLevel::Error) << "No Victoria 2 path was specified in configuration.txt, or the path was invalid";
 		return (-1);
@@ -69,7 +66,7 @@ int ConvertEU3ToV2(const std::string& EU3SaveFileName)
 	// Get V2 Documents Directory
 	LOG(LogLevel::Debug) << "Get V2 Documents directory";
 	string V2DocLoc = Configuration::getV2DocumentsPath();
-	if (V2DocLoc.empty() || (_stat(V2DocLoc.c_str(), &st) != 0))
+	if (V2DocLoc.empty() || !WinUtils::DoesFolderExist(V2DocLoc))
 	{
 		LOG(LogLevel::Error) << "No Victoria 2 documents directory was specified in configuration.txt, or the path was invalid";
 		return (-1);
@@ -82,7 +79,7 @@ int ConvertEU3ToV2(const std::string& EU3SaveFileName)
 	//Get EU3 install location
 	LOG(LogLevel::Debug) << "Get EU3 Install Path";
 	string EU3Loc = Configuration::getEU3Path();
-	if (EU3Loc.empty() || (_stat(EU3Loc.c_str(), &st) != 0))
+	if (EU3Loc.empty() || !WinUtils::DoesFolderExist(EU3Loc))
 	{
 		LOG(LogLevel::Error) << "No Europa Universalis 3 path was specified in configuration.txt, or the path was invalid";
 		return (-1);
@@ -98,8 +95,8 @@ int ConvertEU3ToV2(const std::string& EU3SaveFileName)
 	string modName = Configuration::getEU3Mod();
 	if (modName != "")
 	{
-		fullModPath = EU3Loc + "\\mod\\" + modName;
-		if (fullModPath.empty() || (_stat(fullModPath.c_str(), &st) != 0))
+		fullModPath = EU3Loc + "/mod/" + modName;
+		if (fullModPath.empty() || !WinUtils::DoesFolderExist(fullModPath))
 		{
 			LOG(LogLevel::Error) << modName << " could not be found at the specified directory.  A valid path and mod must be specified.";
 			return (-1);
@@ -111,7 +108,7 @@ int ConvertEU3ToV2(const std::string& EU3SaveFileName)
 	}
 
 	//get output name
-	const int slash	= EU3SaveFileName.find_last_of("\\");				// the last slash in the save's filename
+	const int slash	= EU3SaveFileName.find_last_of("/\\");				// the last slash in the save's filename
 	string outputName	= EU3SaveFileName.substr(slash + 1, EU3SaveFileName.length());
 	const int length	= outputName.find_first_of(".");						// the first period after the slash
 	outputName			= outputName.substr(0, length);						// the name to use to output the mod
@@ -130,6 +127,7 @@ int ConvertEU3ToV2(const std::string& EU3SaveFileName)
 	Configuration::setOutputName(outputName);
 	LOG(LogLevel::Info) << "Using output name " << outputName;
 
+	phase.next("Importing EU3 save");
 	LOG(LogLevel::Info) << "* Importing EU3 save *";
 
 	// Parse EU3 Save
@@ -144,11 +142,11 @@ int ConvertEU3ToV2(const std::string& EU3SaveFileName)
 	// Read all localisations.
 	LOG(LogLevel::Info) << "Reading localisation";
 	EU3Localisation localisation;
-	localisation.ReadFromAllFilesInFolder(Configuration::getEU3Path() + "\\localisation");
+	localisation.ReadFromAllFilesInFolder(Configuration::getEU3Path() + "/localisation");
 	if (!fullModPath.empty())
 	{
 		LOG(LogLevel::Debug) << "Reading mod localisation";
-		localisation.ReadFromAllFilesInFolder(fullModPath + "\\localisation");
+		localisation.ReadFromAllFilesInFolder(fullModPath + "/localisation");
 	}
 
 	// Construct world from EU3 save.
@@ -156,13 +154,13 @@ int ConvertEU3ToV2(const std::string& EU3SaveFileName)
 	EU3World sourceWorld(obj);
 
 	// Read EU3 common\countries
-	LOG(LogLevel::Info) << "Reading EU3 common\\countries";
+	LOG(LogLevel::Info) << "Reading EU3 common/countries";
 	{
-		ifstream commonCountries(Configuration::getEU3Path() + "\\common\\countries.txt");
+		ifstream commonCountries(Configuration::getEU3Path() + "/common/countries.txt");
 		sourceWorld.readCommonCountries(commonCountries, Configuration::getEU3Path());
 		if (!fullModPath.empty())
 		{
-			ifstream convertedCommonCountries(fullModPath + "\\common\\countries.txt");
+			ifstream convertedCommonCountries(fullModPath + "/common/countries.txt");
 			sourceWorld.readCommonCountries(convertedCommonCountries, fullModPath);
 		}
 	}
@@ -213,24 +211,22 @@ int ConvertEU3ToV2(const std::string& EU3SaveFileName)
 	else
 	{
 		LOG(LogLevel::Info) << "Reading unit strengths from EU3 installation folder";
-		struct _finddata_t unitFileData;
-		intptr_t fileListing;
-		if ( (fileListing = _findfirst( (EU3Loc + "\\common\\units\\*.txt").c_str(), &unitFileData)) == -1L)
+		if (!WinUtils::DoesFolderExist(EU3Loc + "/common/units"))
 		{
 			LOG(LogLevel::Info) << "Could not open units directory.";
 			return -1;
 		}
-		do
+		set<string> unitFilenames;
+		WinUtils::GetAllFilesInFolder(EU3Loc + "/common/units", unitFilenames);
+		for (auto unitFilename: unitFilenames)
 		{
-			if (strcmp(unitFileData.name, ".") == 0 || strcmp(unitFileData.name, "..") == 0 )
+			if ((unitFilename.size() < 4) || (unitFilename.substr(unitFilename.size() - 4) != ".txt"))
 			{
 				continue;
 			}
-			string unitFilename = unitFileData.name;
 			string unitName = unitFilename.substr(0, unitFilename.find_first_of('.'));
-			AddUnitFileToRegimentTypeMap((EU3Loc + "\\common\\units"), unitName, rtm);
-		} while(_findnext(fileListing, &unitFileData) == 0);
-		_findclose(fileListing);
+			AddUnitFileToRegimentTypeMap((EU3Loc + "/common/units"), unitName, rtm);
+		}
 	}
 	read.close();
 	read.clear();
@@ -249,6 +245,7 @@ int ConvertEU3ToV2(const std::string& EU3SaveFileName)
 
 
 	// Parse V2 input file
+	phase.next("Importing V2 data");
 	LOG(LogLevel::Info) << "Parsing Vicky2 data";
 	vector<pair<string, string>> minorityPops;
 	minorityPops.push_back(make_pair("ashkenazi","jewish"));
@@ -293,8 +290,8 @@ int ConvertEU3ToV2(const std::string& EU3SaveFileName)
 	continentMapping continentMap;
 	if (EU3Mod != "")
 	{
-		string continentFile = Configuration::getEU3Path() + "\\mod\\" + EU3Mod + "\\map\\continent.txt";
-		if ((_stat(continentFile.c_str(), &st) == 0))
+		string continentFile = Configuration::getEU3Path() + "/mod/" + EU3Mod + "/map/continent.txt";
+		if (WinUtils::DoesFileExist(continentFile))
 		{
 			obj = doParseFile(continentFile.c_str());
 			if ((obj != NULL) && (obj->getLeaves().size() > 0))
@@ -305,10 +302,10 @@ int ConvertEU3ToV2(const std::string& EU3SaveFileName)
 	}
 	if (continentMap.size() == 0)
 	{
-		obj = doParseFile((EU3Loc + "\\map\\continent.txt").c_str());
+		obj = doParseFile((EU3Loc + "/map/continent.txt").c_str());
 		if (obj == NULL)
 		{
-			LOG(LogLevel::Error) << "Could not parse file " << EU3Loc << "\\map\\continent.txt";
+			LOG(LogLevel::Error) << "Could not parse file " << EU3Loc << "/map/continent.txt";
 			exit(-1);
 		}
 		if (obj->getLeaves().size() < 1)
@@ -325,21 +322,21 @@ int ConvertEU3ToV2(const std::string& EU3SaveFileName)
 	
 	// Generate region mapping
 	LOG(LogLevel::Info) << "Parsing region structure";
-	if (_stat(".\\blankMod\\output\\map\\region.txt", &st) == 0)
+	if (WinUtils::DoesFileExist("./blankMod/output/map/region.txt"))
 	{
-		obj = doParseFile(".\\blankMod\\output\\map\\region.txt");
+		obj = doParseFile("./blankMod/output/map/region.txt");
 		if (obj == NULL)
 		{
-			LOG(LogLevel::Error) << "Could not parse file .\\blankMod\\output\\map\\region.txt";
+			LOG(LogLevel::Error) << "Could not parse file ./blankMod/output/map/region.txt";
 			exit(-1);
 		}
 	}
 	else
 	{
-		obj = doParseFile((V2Loc + "\\map\\region.txt").c_str());
+		obj = doParseFile((V2Loc + "/map/region.txt").c_str());
 		if (obj == NULL)
 		{
-			LOG(LogLevel::Error) << "Could not parse file " << V2Loc << "\\map\\region.txt";
+			LOG(LogLevel::Error) << "Could not parse file " << V2Loc << "/map/region.txt";
 			exit(-1);
 		}
 	}
@@ -386,8 +383,8 @@ int ConvertEU3ToV2(const std::string& EU3SaveFileName)
 	inverseUnionCulturesMap	inverseUnionCultures;
 	if (EU3Mod != "")
 	{
-		string modCultureFile = Configuration::getEU3Path() + "\\mod\\" + EU3Mod + "\\common\\cultures.txt";
-		if ((_stat(modCultureFile.c_str(), &st) == 0))
+		string modCultureFile = Configuration::getEU3Path() + "/mod/" + EU3Mod + "/common/cultures.txt";
+		if (WinUtils::DoesFileExist(modCultureFile))
 		{
 			obj = doParseFile(modCultureFile.c_str());
 			if ((obj != NULL) && (obj->getLeaves().size() > 0))
@@ -398,10 +395,10 @@ int ConvertEU3ToV2(const std::string& EU3SaveFileName)
 	}
 	if (unionCultures.size() == 0)
 	{
-		obj = doParseFile((EU3Loc + "\\common\\cultures.txt").c_str());
+		obj = doParseFile((EU3Loc + "/common/cultures.txt").c_str());
 		if (obj == NULL)
 		{
-			LOG(LogLevel::Error) << "Could not parse file " << EU3Loc << "\\common\\cultures.txt";
+			LOG(LogLevel::Error) << "Could not parse file " << EU3Loc << "/common/cultures.txt";
 			exit(-1);
 		}
 		initUnionCultures(obj, unionCultures, inverseUnionCultures);
@@ -413,8 +410,8 @@ int ConvertEU3ToV2(const std::string& EU3SaveFileName)
 	bool parsedReligions = false;
 	if (EU3Mod != "")
 	{
-		string modReligionFile = Configuration::getEU3Path() + "\\mod\\" + EU3Mod + "\\common\\religion.txt";
-		if ((_stat(modReligionFile.c_str(), &st) == 0))
+		string modReligionFile = Configuration::getEU3Path() + "/mod/" + EU3Mod + "/common/religion.txt";
+		if (WinUtils::DoesFileExist(modReligionFile))
 		{
 			obj = doParseFile(modReligionFile.c_str());
 			if ((obj != NULL) && (obj->getLeaves().size() > 0))
@@ -426,10 +423,10 @@ int ConvertEU3ToV2(const std::string& EU3SaveFileName)
 	}
 	if (!parsedReligions)
 	{
-		obj = doParseFile((EU3Loc + "\\common\\religion.txt").c_str());
+		obj = doParseFile((EU3Loc + "/common/religion.txt").c_str());
 		if (obj == NULL)
 		{
-			LOG(LogLevel::Error) << "Could not parse file " << EU3Loc << "\\common\\religion.txt";
+			LOG(LogLevel::Error) << "Could not parse file " << EU3Loc << "/common/religion.txt";
 			exit(-1);
 		}
 		if (obj->getLeaves().size() < 1)
@@ -500,10 +497,10 @@ int ConvertEU3ToV2(const std::string& EU3SaveFileName)
 	vector<string> blockedTechSchools;
 	blockedTechSchools = initBlockedTechSchools(obj);
 	initParser();
-	obj = doParseFile( (V2Loc + "\\common\\technology.txt").c_str() );
+	obj = doParseFile( (V2Loc + "/common/technology.txt").c_str() );
 	if (obj == NULL)
 	{
-		LOG(LogLevel::Error) << "Could not parse file " << V2Loc << "\\common\\technology.txt";
+		LOG(LogLevel::Error) << "Could not parse file " << V2Loc << "/common/technology.txt";
 		exit(-1);
 	}
 	vector<techSchool> techSchools;
@@ -517,10 +514,10 @@ int ConvertEU3ToV2(const std::string& EU3SaveFileName)
 
 	// Parse EU4 Regions
 	LOG(LogLevel::Info) << "Parsing EU4 regions";
-	obj = doParseFile((EU3Loc + "\\map\\region.txt").c_str());
+	obj = doParseFile((EU3Loc + "/map/region.txt").c_str());
 	if (obj == NULL)
 	{
-		LOG(LogLevel::Error) << "Could not parse file " << EU3Loc << "\\map\\region.txt";
+		LOG(LogLevel::Error) << "Could not parse file " << EU3Loc << "/map/region.txt";
 		exit(-1);
 	}
 	if (obj->getLeaves().size() < 1)
@@ -532,8 +529,8 @@ int ConvertEU3ToV2(const std::string& EU3SaveFileName)
 	initEU3RegionMap(obj, EU3RegionsMap);
 	if (EU3Mod != "")
 	{
-		string modRegionFile = Configuration::getEU3Path() + "\\mod\\" + EU3Mod + "\\map\\region.txt";
-		if ((_stat(modRegionFile.c_str(), &st) == 0))
+		string modRegionFile = Configuration::getEU3Path() + "/mod/" + EU3Mod + "/map/region.txt";
+		if (WinUtils::DoesFileExist(modRegionFile))
 		{
 			obj = doParseFile(modRegionFile.c_str());
 			if (obj == NULL)
@@ -546,6 +543,8 @@ int ConvertEU3ToV2(const std::string& EU3SaveFileName)
 	}
 
 	// Create Country Mapping
+	phase.next("Converting");
+	ProfilePhase step("Mapping countries");	// times each step of converting
 	removeEmptyNations(sourceWorld);
 	if (Configuration::getRemovetype() == "dead")
 	{
@@ -559,35 +558,53 @@ int ConvertEU3ToV2(const std::string& EU3SaveFileName)
 
 
 	// Convert
+	step.next("Converting countries");
 	LOG(LogLevel::Info) << "Converting countries";
 	destWorld.convertCountries(sourceWorld, countryMap, cultureMap, unionCultures, religionMap, governmentMap, inverseProvinceMap, techSchools, leaderIDMap, lt, EU3RegionsMap);
 	destWorld.scalePrestige();
+	step.next("Converting provinces");
 	LOG(LogLevel::Info) << "Converting provinces";
 	destWorld.convertProvinces(sourceWorld, provinceMap, resettableProvinces, countryMap, cultureMap, slaveCultureMap, religionMap, stateIndexMap, EU3RegionsMap);
+	step.next("Converting diplomacy");
 	LOG(LogLevel::Info) << "Converting diplomacy";
 	destWorld.convertDiplomacy(sourceWorld, countryMap);
+	step.next("Setting colonies");
 	LOG(LogLevel::Info) << "Setting colonies";
 	destWorld.setupColonies(adjacencyMap, continentMap);
+	step.next("Creating states");
 	LOG(LogLevel::Info) << "Creating states";
 	destWorld.setupStates(stateMap);
+	step.next("Setting unciv reforms");
 	LOG(LogLevel::Info) << "Setting unciv reforms";
 	destWorld.convertUncivReforms();
+	step.next("Converting techs");
 	LOG(LogLevel::Info) << "Converting techs";
 	destWorld.convertTechs(sourceWorld);
+	step.next("Allocating starting factories");
 	LOG(LogLevel::Info) << "Allocating starting factories";
 	destWorld.allocateFactories(sourceWorld, factoryBuilder);
+	step.next("Creating pops");
 	LOG(LogLevel::Info) << "Creating pops";
 	destWorld.setupPops(sourceWorld);
+	step.next("Adding unions");
 	LOG(LogLevel::Info) << "Adding unions";
 	destWorld.addUnions(unionMap);
+	step.next("Converting armies and navies");
 	LOG(LogLevel::Info) << "Converting armies and navies";
 	destWorld.convertArmies(sourceWorld, inverseProvinceMap, leaderIDMap, adjacencyMap);
 
+	step.end();
+
 	// Output results
+	phase.next("Outputting mod");
 	LOG(LogLevel::Info) << "Outputting mod";
-	system("%systemroot%\\System32\\xcopy blankMod output /E /Q /Y /I");
+	if (!WinUtils::TryCopyFolder("blankMod", "output"))
+	{
+		LOG(LogLevel::Error) << "Could not copy blankMod";
+		exit(-1);
+	}
 	FILE* modFile;
-	if (fopen_s(&modFile, ("Output\\" + Configuration::getOutputName() + ".mod").c_str(), "w") != 0)
+	if (fopen_s(&modFile, ("output/" + Configuration::getOutputName() + ".mod").c_str(), "w") != 0)
 	{
 		LOG(LogLevel::Error) << "Could not create .mod file";
 		exit(-1);
@@ -608,11 +625,19 @@ int ConvertEU3ToV2(const std::string& EU3SaveFileName)
 	fprintf(modFile, "replace = \"localisation/0_Cultures.csv\"\n");
 	fprintf(modFile, "replace = \"history/wars\"\n");
 	fclose(modFile);
-	string renameCommand = "move /Y output\\output output\\" + Configuration::getOutputName();
-	system(renameCommand.c_str());
+	if (!WinUtils::TryRenameFolder("output/output", "output/" + Configuration::getOutputName()))
+	{
+		LOG(LogLevel::Error) << "Could not rename output/output to output/" << Configuration::getOutputName();
+		exit(-1);
+	}
 	destWorld.output();
+	phase.end();
 
 	LOG(LogLevel::Info) << "* Conversion complete *";
+	if (!Profiler::getInstance().writeReport("EU3ToV2"))
+	{
+		LOG(LogLevel::Warning) << "Could not write the profiling report";
+	}
 	return 0;
 }
 
@@ -0,0 +1,246 @@
+/*Copyright (c) 2014 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#include "WinUtils.h"
+
+#include <algorithm>
+#include <cstdarg>
+#include <cstring>
+
+#include <boost/filesystem.hpp>
+
+#include "Log.h"
+
+
+
+void sprintf_s_Linux (char *__restrict __s, size_t __maxlen, const char *__restrict __format, ...)
+{
+	va_list argptr;
+	va_start(argptr, __format);
+	vsnprintf(__s, __maxlen, __format, argptr);
+	va_end(argptr);
+}
+
+int fopen_s_Linux(FILE** file, const char* filename, const char* mode)
+{
+	*file = fopen(filename, mode);
+	return *file == NULL;
+}
+
+void fprintf_s_Linux(FILE* file, const char* format, ...)
+{
+	va_list argptr;
+	va_start(argptr, format);
+	vfprintf(file, format, argptr);
+	va_end(argptr);
+}
+
+
+
+namespace WinUtils {
+
+static boost::system::error_code lastError;	// the result of the most recent file system call
+
+bool TryCreateFolder(const std::string& path)
+{
+	if (DoesFolderExist(path) || boost::filesystem::create_directory(path, lastError))
+	{
+		return true;
+	}
+	else
+	{
+		LOG(LogLevel::Warning) << "Could not create folder " << path << " - " << GetLastWindowsError();
+		return false;
+	}
+}
+
+void GetAllFilesInFolder(const std::string& path, std::set<std::string>& fileNames)
+{
+	boost::filesystem::directory_iterator entry(path, lastError);
+	for (; !lastError && (entry != boost::filesystem::directory_iterator()); entry.increment(lastError))
+	{
+		if (!boost::filesystem::is_directory(entry->status()))
+		{
+			fileNames.insert(entry->path().filename().string());
+		}
+	}
+}
+
+void GetAllFilesInFolderRecursive(const std::string& path, std::set<std::string>& fileNames)
+{
+	const size_t prefixLength = boost::filesystem::path(path).string().size();
+	boost::filesystem::recursive_directory_iterator entry(path, lastError);
+	for (; !lastError && (entry != boost::filesystem::recursive_directory_iterator()); entry.increment(lastError))
+	{
+		if (!boost::filesystem::is_directory(entry->status()))
+		{
+			std::string relativePath = entry->path().string().substr(prefixLength);
+			if (relativePath.empty() || (relativePath[0] != '/'))
+			{
+				relativePath.insert(0, "/");
+			}
+			fileNames.insert(relativePath);
+		}
+	}
+}
+
+bool TryCopyFile(const std::string& sourcePath, const std::string& destPath)
+{
+	boost::filesystem::copy_file(sourcePath, destPath, boost::filesystem::copy_option::overwrite_if_exists, lastError);
+	if (!lastError)
+	{
+		return true;
+	}
+	else
+	{
+		LOG(LogLevel::Warning) << "Could not copy file " << sourcePath << " to " << destPath << " - " << GetLastWindowsError();
+		return false;
+	}
+}
+
+bool DoesFileExist(const std::string& path)
+{
+	return boost::filesystem::is_regular_file(path, lastError);
+}
+
+std::string GetCurrentFolder()
+{
+	return boost::filesystem::current_path(lastError).string();
+}
+
+bool DoesFolderExist(const std::string& path)
+{
+	return boost::filesystem::is_directory(path, lastError);
+}
+
+bool TryCopyFolder(const std::string& sourceFolder, const std::string& destFolder)
+{
+	const boost::filesystem::path source(sourceFolder);
+	boost::filesystem::create_directories(destFolder, lastError);
+	boost::filesystem::recursive_directory_iterator entry(source, lastError);
+	for (; !lastError && (entry != boost::filesystem::recursive_directory_iterator()); entry.increment(lastError))
+	{
+		boost::filesystem::path destination = destFolder / boost::filesystem::relative(entry->path(), source, lastError);
+		if (boost::filesystem::is_directory(entry->status()))
+		{
+			boost::filesystem::create_directories(destination, lastError);
+		}
+		else
+		{
+			boost::filesystem::copy_file(entry->path(), destination, boost::filesystem::copy_option::overwrite_if_exists, lastError);
+		}
+	}
+
+	if (!lastError)
+	{
+		return true;
+	}
+	else
+	{
+		LOG(LogLevel::Warning) << "Could not copy folder " << sourceFolder << " to " << destFolder << " - " << GetLastWindowsError();
+		return false;
+	}
+}
+
+bool TryRenameFolder(const std::string& sourceFolder, const std::string& destFolder)
+{
+	// Windows' move replaces what is already there, so do the same
+	boost::filesystem::remove_all(destFolder, lastError);
+	boost::filesystem::rename(sourceFolder, destFolder, lastError);
+	if (!lastError)
+	{
+		return true;
+	}
+	else
+	{
+		LOG(LogLevel::Warning) << "Could not rename folder " << sourceFolder << " to " << destFolder << " - " << GetLastWindowsError();
+		return false;
+	}
+}
+
+std::string ConvertUTF8To1252(const std::string& text)
+{
+	// The characters Windows-1252 has in 0x80-0x9F, where Latin-1 has control codes
+	static const unsigned short extraCharacters[32] =
+	{
+		0x20AC, 0,      0x201A, 0x0192, 0x201E, 0x2026, 0x2020, 0x2021, 0x02C6, 0x2030, 0x0160, 0x2039, 0x0152, 0,      0x017D, 0,
+		0,      0x2018, 0x2019, 0x201C, 0x201D, 0x2022, 0x2013, 0x2014, 0x02DC, 0x2122, 0x0161, 0x203A, 0x0153, 0,      0x017E, 0x0178
+	};
+
+	std::string converted;
+	converted.reserve(text.size());
+	for (size_t i = 0; i < text.size(); )
+	{
+		unsigned char lead = text[i];
+		unsigned int codePoint;
+		size_t length;
+		if (lead < 0x80)
+		{
+			codePoint = lead;
+			length = 1;
+		}
+		else if ((lead & 0xE0) == 0xC0)
+		{
+			codePoint = lead & 0x1F;
+			length = 2;
+		}
+		else if ((lead & 0xF0) == 0xE0)
+		{
+			codePoint = lead & 0x0F;
+			length = 3;
+		}
+		else
+		{
+			codePoint = lead & 0x07;
+			length = 4;
+		}
+		for (size_t j = 1; j < length; j++)
+		{
+			codePoint = (codePoint << 6) | ((i + j < text.size()) ? (text[i + j] & 0x3F) : 0);
+		}
+		i += length;
+
+		if ((codePoint < 0x80) || ((codePoint >= 0xA0) && (codePoint < 0x100)))
+		{
+			converted += static_cast<char>(codePoint);
+			continue;
+		}
+		const unsigned short* extra = std::find(extraCharacters, extraCharacters + 32, codePoint);
+		if (extra != extraCharacters + 32)
+		{
+			converted += static_cast<char>(0x80 + (extra - extraCharacters));
+		}
+		else
+		{
+			converted += '0';
+		}
+	}
+	return converted;
+}
+
+std::string GetLastWindowsError()
+{
+	return lastError.message();
+}
+
+} // namespace WinUtils
@@ -26,7 +26,9 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 #include <fstream>
 #include <iostream>
 
+#ifdef _WIN32
 #include <Windows.h>
+#endif
 
 Log::Log(LogLevel level)
 : logLevel(level)
@@ -54,6 +56,7 @@ void Log::WriteToConsole(LogLevel level, const std::string& logMessage)
 		return;
 	}
 
+#ifdef _WIN32
 	HANDLE console = GetStdHandle(STD_OUTPUT_HANDLE);
 	if (console != INVALID_HANDLE_VALUE)
 	{
@@ -90,6 +93,7 @@ void Log::WriteToConsole(LogLevel level, const std::string& logMessage)
 			return;
 		}
 	}
+#endif
 
 	std::cout << logMessage;
 }
@@ -101,8 +105,12 @@ void Log::WriteToFile(LogLevel level, const std::string& logMessage)
 	time_t rawtime;
 	time(&rawtime);
 	tm timeInfo;
-	errno_t error = localtime_s(&timeInfo, &rawtime);
-	if (error == 0)
+#ifdef _WIN32
+	bool converted = (localtime_s(&timeInfo, &rawtime) == 0);
+#else
+	bool converted = (localtime_r(&rawtime, &timeInfo) != NULL);
+#endif
+	if (converted)
 	{
 		char timeBuffer[64];
 		size_t bytesWritten = strftime(timeBuffer, 64, "%Y-%m-%d %H:%M:%S ", &timeInfo);
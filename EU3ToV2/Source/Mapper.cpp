@@ -23,14 +23,14 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 #include "Mapper.h"
 #include "Log.h"
 #include "Configuration.h"
-#include "Parsers\Object.h"
+#include "WinUtils.h"
+#include "Parsers/Object.h"
 #include "EU3World/EU3World.h"
 #include "EU3World/EU3Country.h"
 #include "EU3World/EU3Province.h"
 #include "V2World/V2World.h"
 #include "V2World/V2Country.h"
 #include <algorithm>
-#include <sys/stat.h>
 
 
 
@@ -192,12 +192,11 @@ typedef struct {
 adjacencyMapping initAdjacencyMap()
 {
 	FILE* adjacenciesBin = NULL;
-	string filename = Configuration::getV2DocumentsPath() + "\\map\\cache\\adjacencies.bin";
-	struct _stat st;
-	if ((_stat(filename.c_str(), &st) != 0))
+	string filename = Configuration::getV2DocumentsPath() + "/map/cache/adjacencies.bin";
+	if (!WinUtils::DoesFileExist(filename))
 	{
 		LOG(LogLevel::Warning) << "Could not find " << filename << " - looking in install folder";
-		filename = Configuration::getV2Path() + "\\map\\cache\\adjacencies.bin";
+		filename = Configuration::getV2Path() + "/map/cache/adjacencies.bin";
 	}
 	fopen_s(&adjacenciesBin, filename.c_str(), "rb");
 	if (adjacenciesBin == NULL)
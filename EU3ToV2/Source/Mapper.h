@@ -25,7 +25,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 
 
-#include "Parsers\Object.h"
+#include "Parsers/Object.h"
 #include <map>
 #include <set>
 #include <vector>
@@ -35,7 +35,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 class V2World;
 class EU3World;
-enum WorldType;
+enum WorldType : int;
 
 
 
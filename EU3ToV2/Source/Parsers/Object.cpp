@@ -45,6 +45,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 #include "Object.h"
 #include "Parser.h"
+#include "../WinUtils.h"
 #include <sstream> 
 #include <fstream>
 #include <algorithm>
@@ -48,7 +48,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 #include <fstream>
 #include <boost/spirit/include/support_istream_iterator.hpp>
 #include <boost/spirit/include/qi.hpp>
-#include "..\Log.h"
+#include "../Log.h"
 
 using namespace boost::spirit;
 
@@ -428,7 +428,7 @@ Object* doParseFile(const char* filename)
 
 	/* - when using parser debugging, also ensure that the parser object is non-static!
 	debugme = false;
-	if (string(filename) == "D:\\Victoria 2\\technologies\\commerce_tech.txt")
+	if (string(filename) == "D:/Victoria 2/technologies/commerce_tech.txt")
 		debugme = true;
 	*/
 
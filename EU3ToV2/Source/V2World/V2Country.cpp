@@ -24,13 +24,13 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 #include <algorithm>
 #include <math.h>
 #include <float.h>
-#include <io.h>
 #include <fstream>
 #include <sstream>
 #include <queue>
 #include "../Log.h"
 #include "../Configuration.h"
 #include "../Parsers/Parser.h"
+#include "../WinUtils.h"
 #include "../EU3World/EU3World.h"
 #include "../EU3World/EU3Province.h"
 #include "../EU3World/EU3Relations.h"
@@ -151,7 +151,7 @@ void V2Country::output() const
 	if(!dynamicCountry)
  	{
 		FILE* output;
-		if (fopen_s(&output, ("Output\\" + Configuration::getOutputName() + "\\history\\countries\\" + filename).c_str(), "w") != 0)
+		if (fopen_s(&output, ("output/" + Configuration::getOutputName() + "/history/countries/" + filename).c_str(), "w") != 0)
 		{
 			LOG(LogLevel::Error) << "Could not create country history file " << filename;
 			exit(-1);
@@ -245,10 +245,10 @@ void V2Country::output() const
 	if (newCountry)
 	{
 		// Output common country file. 
-		std::ofstream commonCountryOutput("Output\\" + Configuration::getOutputName() + "\\common\\countries\\" + commonCountryFile);
+		std::ofstream commonCountryOutput("output/" + Configuration::getOutputName() + "/common/countries/" + commonCountryFile);
 		if (!commonCountryOutput.is_open())
 		{
-			LOG(LogLevel::Error) << "Could not open Output\\" + Configuration::getOutputName() + "\\common\\countries\\" + commonCountryFile;
+			LOG(LogLevel::Error) << "Could not open Output/" + Configuration::getOutputName() + "/common/countries/" + commonCountryFile;
 			exit(-1);
 		}
 		commonCountryOutput << "graphical_culture = UsGC\n";	// default to US graphics
@@ -319,7 +319,7 @@ void V2Country::outputElection(FILE* output) const
 void V2Country::outputOOB() const
 {
 	FILE* output;
-	if (fopen_s(&output, ("Output\\" + Configuration::getOutputName() + "\\history\\units\\" + tag + "_OOB.txt").c_str(), "w") != 0)
+	if (fopen_s(&output, ("output/" + Configuration::getOutputName() + "/history/units/" + tag + "_OOB.txt").c_str(), "w") != 0)
 	{
 		LOG(LogLevel::Error) << "Could not create OOB file " << (tag + "_OOB.txt");
 		exit(-1);
@@ -350,26 +350,30 @@ void V2Country::outputOOB() const
 }
 
 
+// Returns the name of the history file for the given tag in the given folder, or an empty string if there is none
+static string findHistoryFile(const string& folder, const string& tag)
+{
+	set<string> filenames;
+	WinUtils::GetAllFilesInFolder(folder, filenames);
+	for (auto filename: filenames)
+	{
+		if ((filename.compare(0, tag.size(), tag) == 0) && (filename.size() > 4) && (filename.substr(filename.size() - 4) == ".txt"))
+		{
+			return filename;
+		}
+	}
+	return "";
+}
+
+
 void V2Country::initFromEU3Country(const EU3Country* _srcCountry, vector<string> outputOrder, const CountryMapping& countryMap, cultureMapping cultureMap, religionMapping religionMap, unionCulturesMap unionCultures, governmentMapping governmentMap, inverseProvinceMapping inverseProvinceMap, vector<V2TechSchool> techSchools, map<int, int>& leaderMap, const V2LeaderTraits& lt, const EU3RegionsMapping& regionsMap)
 {
 	srcCountry = _srcCountry;
 
-	struct _finddata_t	fileData;
-	intptr_t					fileListing;
-	string filesearch = ".\\blankMod\\output\\history\\countries\\" + tag + "*.txt";
-	if ((fileListing = _findfirst(filesearch.c_str(), &fileData)) != -1L)
-	{
-		filename = fileData.name;
-	}
-	_findclose(fileListing);
+	filename = findHistoryFile("./blankMod/output/history/countries", tag);
 	if (filename == "")
 	{
-		string filesearch = Configuration::getV2Path() + "\\history\\countries\\" + tag + "*.txt";
-		if ((fileListing = _findfirst(filesearch.c_str(), &fileData)) != -1L)
-		{
-			filename = fileData.name;
-			}
-		_findclose(fileListing);
+		filename = findHistoryFile(Configuration::getV2Path() + "/history/countries", tag);
 	}
 	if (filename == "")
 	{
@@ -810,24 +814,18 @@ void V2Country::initFromEU3Country(const EU3Country* _srcCountry, vector<string>
 void V2Country::initFromHistory()
 {
 	string fullFilename;
-	struct _finddata_t	fileData;
-	intptr_t					fileListing;
-	string filesearch = ".\\blankMod\\output\\history\\countries\\" + tag + "*.txt";
-	if ((fileListing = _findfirst(filesearch.c_str(), &fileData)) != -1L)
+	filename = findHistoryFile("./blankMod/output/history/countries", tag);
+	if (filename != "")
 	{
-		filename = fileData.name;
-		fullFilename = string(".\\blankMod\\output\\history\\countries\\") + fileData.name;
+		fullFilename = "./blankMod/output/history/countries/" + filename;
 	}
-	_findclose(fileListing);
-	if (fullFilename == "")
+	else
 	{
-		string filesearch = Configuration::getV2Path() + "\\history\\countries\\" + tag + "*.txt";
-		if ((fileListing = _findfirst(filesearch.c_str(), &fileData)) != -1L)
+		filename = findHistoryFile(Configuration::getV2Path() + "/history/countries", tag);
+		if (filename != "")
 		{
-			filename = fileData.name;
-			fullFilename = Configuration::getV2Path() + "\\history\\countries\\" + fileData.name;
+			fullFilename = Configuration::getV2Path() + "/history/countries/" + filename;
 		}
-		_findclose(fileListing);
 	}
 	if (fullFilename == "")
 	{
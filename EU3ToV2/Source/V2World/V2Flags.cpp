@@ -27,9 +27,9 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 #include <random>
 #include <boost/algorithm/string/predicate.hpp>
 #include "V2Country.h"
-#include "..\Configuration.h"
-#include "..\Log.h"
-#include "..\WinUtils.h"
+#include "../Configuration.h"
+#include "../Log.h"
+#include "../WinUtils.h"
 
 
 
@@ -40,7 +40,7 @@ void V2Flags::SetV2Tags(const std::map<std::string, V2Country*>& V2Countries)
 	tagMapping.clear();
 
 	// Generate a list of all flags that we can use.
-	const std::vector<std::string> availableFlagFolders = { "blankMod\\output\\gfx\\flags", Configuration::getV2Path() + "\\gfx\\flags" };
+	const std::vector<std::string> availableFlagFolders = { "blankMod/output/gfx/flags", Configuration::getV2Path() + "/gfx/flags" };
 	std::set<std::string> availableFlags;
 	for (size_t i = 0; i < availableFlagFolders.size(); ++i)
 	{
@@ -126,19 +126,19 @@ bool V2Flags::Output() const
 	LOG(LogLevel::Debug) << "Copying flags";
 
 	// Create output folders.
-	std::string outputGraphicsFolder = "Output\\" + Configuration::getOutputName() + "\\gfx";
+	std::string outputGraphicsFolder = "output/" + Configuration::getOutputName() + "/gfx";
 	if (!WinUtils::TryCreateFolder(outputGraphicsFolder))
 	{
 		return false;
 	}
-	std::string outputFlagFolder = outputGraphicsFolder + "\\flags";
+	std::string outputFlagFolder = outputGraphicsFolder + "/flags";
 	if (!WinUtils::TryCreateFolder(outputFlagFolder))
 	{
 		return false;
 	}
 
 	// Copy files.
-	const std::vector<std::string> availableFlagFolders = { "blankMod\\output\\gfx\\flags", Configuration::getV2Path() + "\\gfx\\flags" };
+	const std::vector<std::string> availableFlagFolders = { "blankMod/output/gfx/flags", Configuration::getV2Path() + "/gfx/flags" };
 	for (V2TagToFlagTagMap::const_iterator i = tagMapping.begin(); i != tagMapping.end(); ++i)
 	{
 		const std::string& V2Tag = i->first;
@@ -150,11 +150,11 @@ bool V2Flags::Output() const
 			for (std::vector<std::string>::const_iterator j = availableFlagFolders.begin(); j != availableFlagFolders.end() && !flagFileFound; ++j)
 			{
 				const std::string& folderPath = *j;
-				std::string sourceFlagPath = folderPath + '\\' + flagTag + suffix;
+				std::string sourceFlagPath = folderPath + '/' + flagTag + suffix;
 				flagFileFound = WinUtils::DoesFileExist(sourceFlagPath);
 				if (flagFileFound)
 				{
-					std::string destFlagPath = outputFlagFolder + '\\' + V2Tag + suffix;
+					std::string destFlagPath = outputFlagFolder + '/' + V2Tag + suffix;
 					WinUtils::TryCopyFile(sourceFlagPath, destFlagPath);
 				}
 			}
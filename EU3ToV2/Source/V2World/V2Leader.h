@@ -25,7 +25,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 
 
-#include "../date.h"
+#include "../Date.h"
 #include <string>
 using namespace std;
 
@@ -21,10 +21,10 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 
 #include "V2Localisation.h"
-#include <Windows.h>
-#include "..\EU3World\EU3Country.h"
-#include "..\Log.h"
-#include "..\WinUtils.h"
+#include <algorithm>
+#include "../EU3World/EU3Country.h"
+#include "../Log.h"
+#include "../WinUtils.h"
 
 const std::array<std::string, V2Localisation::numLanguages> V2Localisation::languages = 
 	{ "code", "english", "french", "german", "spanish" };
@@ -107,38 +107,7 @@ std::string V2Localisation::convertCountryFileName(const std::string countryFile
 
 std::string V2Localisation::Convert(const std::string& text)
 {
-	if (text.empty())
-	{
-		return "";
-	}
-
-	int utf16Size = MultiByteToWideChar(CP_UTF8, 0, text.c_str(), text.size(), NULL, 0);
-	if (utf16Size == 0)
-	{
-		LOG(LogLevel::Warning) << "Can't convert \"" << text << "\" to UTF-16: " << WinUtils::GetLastWindowsError();
-		return "";
-	}
-	std::vector<wchar_t> utf16Text(utf16Size, L'\0');
-	int result = MultiByteToWideChar(CP_UTF8, 0, text.c_str(), text.size(), &utf16Text[0], utf16Size);
-	if (result == 0)
-	{
-		LOG(LogLevel::Warning) << "Can't convert \"" << text << "\" to UTF-16: " << WinUtils::GetLastWindowsError();
-		return "";
-	}
-	int latin1Size = WideCharToMultiByte(1252, WC_NO_BEST_FIT_CHARS | WC_COMPOSITECHECK | WC_DEFAULTCHAR, &utf16Text[0], utf16Size, NULL, 0, "0", NULL);
-	if (latin1Size == 0)
-	{
-		LOG(LogLevel::Warning) << "Can't convert \"" << text << "\" to Latin-1: " << WinUtils::GetLastWindowsError();
-		return "";
-	}
-	std::vector<char> latin1Text(latin1Size, '\0');
-	result = WideCharToMultiByte(1252, WC_NO_BEST_FIT_CHARS | WC_COMPOSITECHECK | WC_DEFAULTCHAR, &utf16Text[0], utf16Size, &latin1Text[0], latin1Size, "0", NULL);
-	if (result == 0)
-	{
-		LOG(LogLevel::Warning) << "Can't convert \"" << text << "\" to Latin-1: " << WinUtils::GetLastWindowsError();
-		return "";
-	}
-	return std::string(latin1Text.begin(), latin1Text.end());
+	return WinUtils::ConvertUTF8To1252(text);
 }
 
 
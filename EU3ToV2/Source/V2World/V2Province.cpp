@@ -22,6 +22,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 #include "V2Province.h"
 #include "../Log.h"
+#include "../WinUtils.h"
 #include "../Parsers/Object.h"
 #include "../Parsers/Parser.h"
 #include "../EU3World/EU3World.h"
@@ -32,7 +33,8 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 #include <sstream>
 #include <algorithm>
 #include <stdio.h>
-#include <sys/stat.h>
+#include <cerrno>
+#include <cstring>
 using namespace std;
 
 
@@ -78,28 +80,27 @@ V2Province::V2Province(string _filename)
 
 	resettable			= false;
 
-	int slash = filename.find_last_of("\\");
+	int slash = filename.find_last_of("/");
 	int numDigits = filename.find_first_of("-") - slash - 2;
 	string temp = filename.substr(slash + 1, numDigits);
 	num = atoi(temp.c_str());
 
 	Object* obj;
-	struct _stat st;
-	if (_stat((string(".\\blankMod\\output\\history\\provinces") + _filename).c_str(), &st) == 0)
+	if (WinUtils::DoesFileExist(string("./blankMod/output/history/provinces") + _filename))
 	{
-		obj = doParseFile((string(".\\blankMod\\output\\history\\provinces") + _filename).c_str());
+		obj = doParseFile((string("./blankMod/output/history/provinces") + _filename).c_str());
 		if (obj == NULL)
 		{
-			LOG(LogLevel::Error) << "Could not parse .\\blankMod\\output\\history\\provinces" << _filename;
+			LOG(LogLevel::Error) << "Could not parse ./blankMod/output/history/provinces" << _filename;
 			exit(-1);
 		}
 	}
 	else
 	{
-		obj = doParseFile((Configuration::getV2Path() + "\\history\\provinces\\" + _filename).c_str());
+		obj = doParseFile((Configuration::getV2Path() + "/history/provinces/" + _filename).c_str());
 		if (obj == NULL)
 		{
-			LOG(LogLevel::Error) << "Could not parse " << Configuration::getV2Path() << "\\history\\provinces\\" << _filename;
+			LOG(LogLevel::Error) << "Could not parse " << Configuration::getV2Path() << "/history/provinces/" << _filename;
 			exit(-1);
 		}
 	}
@@ -174,13 +175,9 @@ V2Province::V2Province(string _filename)
 void V2Province::output() const
 {
 	FILE* output;
-	if (fopen_s(&output, ("Output\\" + Configuration::getOutputName() + "\\history\\provinces\\" + filename).c_str(), "w") != 0)
+	if (fopen_s(&output, ("output/" + Configuration::getOutputName() + "/history/provinces/" + filename).c_str(), "w") != 0)
 	{
-		int errNum;
-		_get_errno(&errNum);
-		char errStr[256];
-		strerror_s(errStr, sizeof(errStr), errNum);
-		LOG(LogLevel::Error) << "Could not create province history file Output\\" << Configuration::getOutputName() << "\\history\\provinces\\" << filename << " - " << errStr;
+		LOG(LogLevel::Error) << "Could not create province history file Output/" << Configuration::getOutputName() << "/history/provinces/" << filename << " - " << strerror(errno);
 		exit(-1);
 	}
 	if (owner != "")
@@ -20,7 +20,7 @@ TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
 SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 
-#include "..\EU3World\EU3Province.h"
+#include "../EU3World/EU3Province.h"
 #include "V2State.h"
 #include "V2Pop.h"
 #include "V2Province.h"
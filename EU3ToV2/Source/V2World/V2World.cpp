@@ -21,15 +21,12 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 
 #include "V2World.h"
-#include <Windows.h>
 #include <fstream>
 #include <algorithm>
-#include <io.h>
 #include <list>
 #include <queue>
 #include <cmath>
 #include <cfloat>
-#include <sys/stat.h>
 #include "../Parsers/Parser.h"
 #include "../Log.h"
 #include "../Mapper.h"
@@ -68,82 +65,32 @@ V2World::V2World(vector<pair<string, string>> minorities)
 {
 	LOG(LogLevel::Info) << "Importing provinces";
 
-	struct _finddata_t	provinceFileData;
-	intptr_t					fileListing = NULL;
-	list<string>			directories;
-	directories.push_back("");
-	struct _stat st;
-	if (_stat(".\\blankMod\\output\\history\\provinces\\", &st) == 0)
+	string provincesFolder = "./blankMod/output/history/provinces";
+	if (!WinUtils::DoesFolderExist(provincesFolder))
 	{
-		while (directories.size() > 0)
-		{
-			if ((fileListing = _findfirst((string(".\\blankMod\\output\\history\\provinces") + directories.front() + "\\*.*").c_str(), &provinceFileData)) == -1L)
-			{
-				LOG(LogLevel::Error) << "Could not open directory .\\blankMod\\output\\history\\provinces" << directories.front() << "\\*.*";
-				exit(-1);
-			}
-
-			do
-			{
-				if (strcmp(provinceFileData.name, ".") == 0 || strcmp(provinceFileData.name, "..") == 0)
-				{
-					continue;
-				}
-				if (provinceFileData.attrib & _A_SUBDIR)
-				{
-					string newDirectory = directories.front() + "\\" + provinceFileData.name;
-					directories.push_back(newDirectory);
-				}
-				else
-				{
-					V2Province* newProvince = new V2Province(directories.front() + "\\" + provinceFileData.name);
-					provinces.insert(make_pair(newProvince->getNum(), newProvince));
-				}
-			} while (_findnext(fileListing, &provinceFileData) == 0);
-			_findclose(fileListing);
-			directories.pop_front();
-		}
+		provincesFolder = Configuration::getV2Path() + "/history/provinces";
 	}
-	else
+	if (!WinUtils::DoesFolderExist(provincesFolder))
 	{
-		while (directories.size() > 0)
-		{
-			if ((fileListing = _findfirst((Configuration::getV2Path() + "\\history\\provinces" + directories.front() + "\\*.*").c_str(), &provinceFileData)) == -1L)
-			{
-				LOG(LogLevel::Error) << "Could not open directory " << Configuration::getV2Path() << "\\history\\provinces" << directories.front() << "\\*.*";
-				exit(-1);
-			}
-
-			do
-			{
-				if (strcmp(provinceFileData.name, ".") == 0 || strcmp(provinceFileData.name, "..") == 0)
-				{
-					continue;
-				}
-				if (provinceFileData.attrib & _A_SUBDIR)
-				{
-					string newDirectory = directories.front() + "\\" + provinceFileData.name;
-					directories.push_back(newDirectory);
-				}
-				else
-				{
-					V2Province* newProvince = new V2Province(directories.front() + "\\" + provinceFileData.name);
-					provinces.insert(make_pair(newProvince->getNum(), newProvince));
-				}
-			} while (_findnext(fileListing, &provinceFileData) == 0);
-			_findclose(fileListing);
-			directories.pop_front();
-		}
+		LOG(LogLevel::Error) << "Could not open directory " << provincesFolder;
+		exit(-1);
+	}
+	set<string> provinceFilenames;
+	WinUtils::GetAllFilesInFolderRecursive(provincesFolder, provinceFilenames);
+	for (auto provinceFilename: provinceFilenames)
+	{
+		V2Province* newProvince = new V2Province(provinceFilename);
+		provinces.insert(make_pair(newProvince->getNum(), newProvince));
 	}
 
 	// Get province names
-	if (_stat(".\\blankMod\\output\\localisation\\text.csv", &st) == 0)
+	if (WinUtils::DoesFileExist("./blankMod/output/localisation/text.csv"))
 	{
-		getProvinceLocalizations(".\\blankMod\\output\\localisation\\text.csv");
+		getProvinceLocalizations("./blankMod/output/localisation/text.csv");
 	}
 	else
 	{
-		getProvinceLocalizations((Configuration::getV2Path() + "\\localisation\\text.csv"));
+		getProvinceLocalizations((Configuration::getV2Path() + "/localisation/text.csv"));
 	}
 
 	// set V2 basic population levels
@@ -152,11 +99,11 @@ V2World::V2World(vector<pair<string, string>> minorities)
 
 	totalWorldPopulation	= 0;
 	set<string> fileNames;
-	WinUtils::GetAllFilesInFolder(".\\blankMod\\output\\history\\pops\\1836.1.1\\", fileNames);
+	WinUtils::GetAllFilesInFolder("./blankMod/output/history/pops/1836.1.1/", fileNames);
 	for (set<string>::iterator itr = fileNames.begin(); itr != fileNames.end(); itr++)
 	{
 		list<int>* popProvinces = new list<int>;
-		Object*	obj2	= doParseFile((".\\blankMod\\output\\history\\pops\\1836.1.1\\" + *itr).c_str());				// generic object
+		Object*	obj2	= doParseFile(("./blankMod/output/history/pops/1836.1.1/" + *itr).c_str());				// generic object
 		vector<Object*> leaves = obj2->getLeaves();
 		for (unsigned int j = 0; j < leaves.size(); j++)
 		{
@@ -238,7 +185,7 @@ V2World::V2World(vector<pair<string, string>> minorities)
 			popRegions.insert( make_pair(*itr, popProvinces) );
 		}
 	}
-	WinUtils::GetAllFilesInFolder(Configuration::getV2Path() + "\\history\\pops\\1836.1.1\\", fileNames);
+	WinUtils::GetAllFilesInFolder(Configuration::getV2Path() + "/history/pops/1836.1.1/", fileNames);
 	for (set<string>::iterator itr = fileNames.begin(); itr != fileNames.end(); itr++)
 	{
 		auto duplicateCheck = popRegions.find(*itr);
@@ -248,7 +195,7 @@ V2World::V2World(vector<pair<string, string>> minorities)
 		}
 
 		list<int>* popProvinces = new list<int>;
-		Object*	obj2	= doParseFile((Configuration::getV2Path() + "\\history\\pops\\1836.1.1\\" + *itr).c_str());				// generic object
+		Object*	obj2	= doParseFile((Configuration::getV2Path() + "/history/pops/1836.1.1/" + *itr).c_str());				// generic object
 		vector<Object*> leaves = obj2->getLeaves();
 		for (unsigned int j = 0; j < leaves.size(); j++)
 		{
@@ -348,16 +295,16 @@ V2World::V2World(vector<pair<string, string>> minorities)
 	// determine whether a province is coastal or not by checking if it has a naval base
 	// if it's not coastal, we won't try to put any navies in it (otherwise Vicky crashes)
 	LOG(LogLevel::Info) << "Finding coastal provinces.";
-	Object*	obj2 = doParseFile((Configuration::getV2Path() + "\\map\\positions.txt").c_str());
+	Object*	obj2 = doParseFile((Configuration::getV2Path() + "/map/positions.txt").c_str());
 	if (obj2 == NULL)
 	{
-		LOG(LogLevel::Error) << "Could not parse file " << Configuration::getV2Path() << "\\map\\positions.txt";
+		LOG(LogLevel::Error) << "Could not parse file " << Configuration::getV2Path() << "/map/positions.txt";
 		exit(-1);
 	}
 	vector<Object*> objProv = obj2->getLeaves();
 	if (objProv.size() == 0)
 	{
-		LOG(LogLevel::Error) << "map\\positions.txt failed to parse.";
+		LOG(LogLevel::Error) << "map/positions.txt failed to parse.";
 		exit(1);
 	}
 	for (vector<Object*>::iterator itr = objProv.begin(); itr != objProv.end(); ++itr)
@@ -390,13 +337,13 @@ V2World::V2World(vector<pair<string, string>> minorities)
 	dynamicCountries.clear();
 	const date FirstStartDate = date("1836.1.1");
 	ifstream V2CountriesInput;
-	if (_stat(".\\blankMod\\output\\common\\countries.txt", &st) == 0)
+	if (WinUtils::DoesFileExist("./blankMod/output/common/countries.txt"))
 	{
-		V2CountriesInput.open(".\\blankMod\\output\\common\\countries.txt");
+		V2CountriesInput.open("./blankMod/output/common/countries.txt");
 	}
 	else
 	{
-		V2CountriesInput.open((Configuration::getV2Path() + "\\common\\countries.txt").c_str());
+		V2CountriesInput.open((Configuration::getV2Path() + "/common/countries.txt").c_str());
 	}
 	if (!V2CountriesInput.is_open())
 	{
@@ -429,25 +376,25 @@ V2World::V2World(vector<pair<string, string>> minorities)
 		countryFileName	= line.substr(start, size);
 
 		Object* countryData;
-		if (_stat((string(".\\blankMod\\output\\common\\countries\\") + countryFileName).c_str(), &st) == 0)
+		if (WinUtils::DoesFileExist(string("./blankMod/output/common/countries/") + countryFileName))
 		{
-			countryData = doParseFile((string(".\\blankMod\\output\\common\\countries\\") + countryFileName).c_str());
+			countryData = doParseFile((string("./blankMod/output/common/countries/") + countryFileName).c_str());
 			if (countryData == NULL)
 			{
-				LOG(LogLevel::Warning) << "Could not parse file .\\blankMod\\output\\common\\countries\\" << countryFileName;
+				LOG(LogLevel::Warning) << "Could not parse file ./blankMod/output/common/countries/" << countryFileName;
 			}
 		}
-		else if (_stat((Configuration::getV2Path() + "\\common\\countries\\" + countryFileName).c_str(), &st) == 0)
+		else if (WinUtils::DoesFileExist(Configuration::getV2Path() + "/common/countries/" + countryFileName))
 		{
-			countryData = doParseFile((Configuration::getV2Path() + "\\common\\countries\\" + countryFileName).c_str());
+			countryData = doParseFile((Configuration::getV2Path() + "/common/countries/" + countryFileName).c_str());
 			if (countryData == NULL)
 			{
-				LOG(LogLevel::Warning) << "Could not parse file " << Configuration::getV2Path() << "\\common\\countries\\" << countryFileName;
+				LOG(LogLevel::Warning) << "Could not parse file " << Configuration::getV2Path() << "/common/countries/" << countryFileName;
 			}
 		}
 		else
 		{
-			LOG(LogLevel::Debug) << "Could not find file common\\countries\\" << countryFileName << " - skipping";
+			LOG(LogLevel::Debug) << "Could not find file common/countries/" << countryFileName << " - skipping";
 			continue;
 		}
 
@@ -479,7 +426,7 @@ V2World::V2World(vector<pair<string, string>> minorities)
 void V2World::output() const
 {
 	// Create common\countries path.
-	string countriesPath = "Output\\" + Configuration::getOutputName() + "\\common\\countries";
+	string countriesPath = "output/" + Configuration::getOutputName() + "/common/countries";
 	if (!WinUtils::TryCreateFolder(countriesPath))
 	{
 		return;
@@ -488,7 +435,7 @@ void V2World::output() const
 	// Output common\countries.txt
 	LOG(LogLevel::Debug) << "Writing countries file";
 	FILE* allCountriesFile;
-	if (fopen_s(&allCountriesFile, ("Output\\" + Configuration::getOutputName() + "\\common\\countries.txt").c_str(), "w") != 0)
+	if (fopen_s(&allCountriesFile, ("output/" + Configuration::getOutputName() + "/common/countries.txt").c_str(), "w") != 0)
 	{
 		LOG(LogLevel::Error) << "Could not create countries file";
 		exit(-1);
@@ -521,13 +468,13 @@ void V2World::output() const
 
 	// Create localisations for all new countries. We don't actually know the names yet so we just use the tags as the names.
 	LOG(LogLevel::Debug) << "Writing localisation text";
-	string localisationPath = "Output\\" + Configuration::getOutputName() + "\\localisation";
+	string localisationPath = "output/" + Configuration::getOutputName() + "/localisation";
 	if (!WinUtils::TryCreateFolder(localisationPath))
 	{
 		return;
 	}
-	string source = Configuration::getV2Path() + "\\localisation\\text.csv";
-	string dest = localisationPath + "\\text.csv";
+	string source = Configuration::getV2Path() + "/localisation/text.csv";
+	string dest = localisationPath + "/text.csv";
 	WinUtils::TryCopyFile(source, dest);
 	FILE* localisationFile;
 	if (fopen_s(&localisationFile, dest.c_str(), "a") != 0)
@@ -561,7 +508,7 @@ void V2World::output() const
 
 	// verify countries got written
 	ifstream V2CountriesInput;
-	V2CountriesInput.open(("Output\\" + Configuration::getOutputName() + "\\common\\countries.txt").c_str());
+	V2CountriesInput.open(("output/" + Configuration::getOutputName() + "/common/countries.txt").c_str());
 	if (!V2CountriesInput.is_open())
 	{
 		LOG(LogLevel::Error) << "Could not open countries.txt";
@@ -588,16 +535,15 @@ void V2World::output() const
 		int size				= line.find_last_of('\"') - start - 1;
 		countryFileName	= line.substr(start + 1, size);
 
-		struct _stat st;
-		if (_stat(("Output\\" + Configuration::getOutputName() + "\\common\\countries\\" + countryFileName).c_str(), &st) == 0)
+		if (WinUtils::DoesFileExist("output/" + Configuration::getOutputName() + "/common/countries/" + countryFileName))
 		{
 		}
-		else if (_stat((Configuration::getV2Path() + "\\common\\countries\\" + countryFileName).c_str(), &st) == 0)
+		else if (WinUtils::DoesFileExist(Configuration::getV2Path() + "/common/countries/" + countryFileName))
 		{
 		}
 		else
 		{
-			LOG(LogLevel::Warning) << "common\\countries\\" << countryFileName << " does not exists. This will likely crash Victoria 2.";
+			LOG(LogLevel::Warning) << "common/countries/" << countryFileName << " does not exists. This will likely crash Victoria 2.";
 			continue;
 		}
 	}
@@ -611,9 +557,9 @@ void V2World::outputPops() const
 	for (map<string, list<int>* >::const_iterator itr = popRegions.begin(); itr != popRegions.end(); itr++)
 	{
 		FILE* popsFile;
-		if (fopen_s(&popsFile, ("Output\\" + Configuration::getOutputName() + "\\history\\pops\\1836.1.1\\" + itr->first).c_str(), "w") != 0)
+		if (fopen_s(&popsFile, ("output/" + Configuration::getOutputName() + "/history/pops/1836.1.1/" + itr->first).c_str(), "w") != 0)
 		{
-			LOG(LogLevel::Error) << "Could not create pops file Output\\" << Configuration::getOutputName() << "\\history\\pops\\1836.1.1\\" << itr->first;
+			LOG(LogLevel::Error) << "Could not create pops file Output/" << Configuration::getOutputName() << "/history/pops/1836.1.1/" << itr->first;
 			exit(-1);
 		}
 
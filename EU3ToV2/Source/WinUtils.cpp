@@ -22,6 +22,9 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 #include "WinUtils.h"
 
+#include <cstring>
+#include <vector>
+
 #include <Windows.h>
 
 #include "Log.h"
@@ -45,7 +48,7 @@ bool TryCreateFolder(const std::string& path)
 void GetAllFilesInFolder(const std::string& path, std::set<std::string>& fileNames)
 {
 	WIN32_FIND_DATA findData;
-	HANDLE findHandle = FindFirstFile((path + "\\*").c_str(), &findData);
+	HANDLE findHandle = FindFirstFile((path + "/*").c_str(), &findData);
 	if (findHandle == INVALID_HANDLE_VALUE)
 	{
 		return;
@@ -60,6 +63,36 @@ void GetAllFilesInFolder(const std::string& path, std::set<std::string>& fileNam
 	FindClose(findHandle);
 }
 
+static void GetAllFilesInSubfolder(const std::string& path, const std::string& subfolder, std::set<std::string>& fileNames)
+{
+	WIN32_FIND_DATA findData;
+	HANDLE findHandle = FindFirstFile((path + subfolder + "/*").c_str(), &findData);
+	if (findHandle == INVALID_HANDLE_VALUE)
+	{
+		return;
+	}
+	do
+	{
+		if (findData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
+		{
+			if ((strcmp(findData.cFileName, ".") != 0) && (strcmp(findData.cFileName, "..") != 0))
+			{
+				GetAllFilesInSubfolder(path, subfolder + "/" + findData.cFileName, fileNames);
+			}
+		}
+		else
+		{
+			fileNames.insert(subfolder + "/" + findData.cFileName);
+		}
+	} while (FindNextFile(findHandle, &findData) != 0);
+	FindClose(findHandle);
+}
+
+void GetAllFilesInFolderRecursive(const std::string& path, std::set<std::string>& fileNames)
+{
+	GetAllFilesInSubfolder(path, "", fileNames);
+}
+
 bool TryCopyFile(const std::string& sourcePath, const std::string& destPath)
 {
 	BOOL success = ::CopyFile(sourcePath.c_str(), destPath.c_str(), FALSE);
@@ -80,6 +113,100 @@ bool DoesFileExist(const std::string& path)
 	return (attributes != INVALID_FILE_ATTRIBUTES && !(attributes & FILE_ATTRIBUTE_DIRECTORY));
 }
 
+std::string GetCurrentFolder()
+{
+	char curDir[MAX_PATH];
+	::GetCurrentDirectory(MAX_PATH, curDir);
+	return curDir;
+}
+
+bool DoesFolderExist(const std::string& path)
+{
+	DWORD attributes = GetFileAttributes(path.c_str());
+	return (attributes != INVALID_FILE_ATTRIBUTES && (attributes & FILE_ATTRIBUTE_DIRECTORY));
+}
+
+// SHFileOperation wants each path followed by two null characters
+static bool TryFolderOperation(UINT operation, const std::string& sourceFolder, const std::string& destFolder)
+{
+	std::vector<char> from(sourceFolder.begin(), sourceFolder.end());
+	from.resize(from.size() + 2, '\0');
+	std::vector<char> to(destFolder.begin(), destFolder.end());
+	to.resize(to.size() + 2, '\0');
+
+	SHFILEOPSTRUCT fileOptStruct;
+	fileOptStruct.hwnd	= NULL;
+	fileOptStruct.wFunc	= operation;
+	fileOptStruct.pFrom	= &from[0];
+	fileOptStruct.pTo		= &to[0];
+	fileOptStruct.fFlags	= FOF_NOCONFIRMATION | FOF_NOCONFIRMMKDIR | FOF_NOERRORUI | FOF_SILENT;
+
+	int result = SHFileOperation(&fileOptStruct);
+	return ((result == 0) && !fileOptStruct.fAnyOperationsAborted);
+}
+
+bool TryCopyFolder(const std::string& sourceFolder, const std::string& destFolder)
+{
+	if (TryFolderOperation(FO_COPY, sourceFolder, destFolder))
+	{
+		return true;
+	}
+	else
+	{
+		LOG(LogLevel::Warning) << "Could not copy folder " << sourceFolder << " to " << destFolder;
+		return false;
+	}
+}
+
+bool TryRenameFolder(const std::string& sourceFolder, const std::string& destFolder)
+{
+	if (TryFolderOperation(FO_MOVE, sourceFolder, destFolder))
+	{
+		return true;
+	}
+	else
+	{
+		LOG(LogLevel::Warning) << "Could not rename folder " << sourceFolder << " to " << destFolder;
+		return false;
+	}
+}
+
+std::string ConvertUTF8To1252(const std::string& text)
+{
+	if (text.empty())
+	{
+		return "";
+	}
+
+	int utf16Size = MultiByteToWideChar(CP_UTF8, 0, text.c_str(), text.size(), NULL, 0);
+	if (utf16Size == 0)
+	{
+		LOG(LogLevel::Warning) << "Can't convert \"" << text << "\" to UTF-16: " << GetLastWindowsError();
+		return "";
+	}
+	std::vector<wchar_t> utf16Text(utf16Size, L'\0');
+	int result = MultiByteToWideChar(CP_UTF8, 0, text.c_str(), text.size(), &utf16Text[0], utf16Size);
+	if (result == 0)
+	{
+		LOG(LogLevel::Warning) << "Can't convert \"" << text << "\" to UTF-16: " << GetLastWindowsError();
+		return "";
+	}
+	int latin1Size = WideCharToMultiByte(1252, WC_NO_BEST_FIT_CHARS | WC_COMPOSITECHECK | WC_DEFAULTCHAR, &utf16Text[0], utf16Size, NULL, 0, "0", NULL);
+	if (latin1Size == 0)
+	{
+		LOG(LogLevel::Warning) << "Can't convert \"" << text << "\" to Latin-1: " << GetLastWindowsError();
+		return "";
+	}
+	std::vector<char> latin1Text(latin1Size, '\0');
+	result = WideCharToMultiByte(1252, WC_NO_BEST_FIT_CHARS | WC_COMPOSITECHECK | WC_DEFAULTCHAR, &utf16Text[0], utf16Size, &latin1Text[0], latin1Size, "0", NULL);
+	if (result == 0)
+	{
+		LOG(LogLevel::Warning) << "Can't convert \"" << text << "\" to Latin-1: " << GetLastWindowsError();
+		return "";
+	}
+	return std::string(latin1Text.begin(), latin1Text.end());
+}
+
 std::string GetLastWindowsError()
 {
 	DWORD errorCode = ::GetLastError();
@@ -23,9 +23,31 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 #ifndef WINUTILS_H_
 #define WINUTILS_H_
 
+#include <cstdio>
 #include <set>
 #include <string>
 
+
+
+//Linux specific defines
+#ifdef __linux
+
+//The secure CRT functions are not implemented on Linux. These behave like their counterparts for the ways the converter
+//uses them; see common_items/OSCompatibilityLayer.h, which these mirror.
+#define sprintf_s sprintf_s_Linux
+void sprintf_s_Linux (char *__restrict __s, size_t __maxlen, const char *__restrict __format, ...);
+
+//Very basic implementation, simply returns 0 if FILE* is not NULL
+#define fopen_s fopen_s_Linux
+int fopen_s_Linux(FILE** file, const char* filename, const char* mode);
+
+#define fprintf_s fprintf_s_Linux
+void fprintf_s_Linux(FILE* file, const char* format, ...);
+
+#endif //__linux
+
+
+
 namespace WinUtils {
 
 // Creates a new folder corresponding to the given path.
@@ -34,12 +56,30 @@ namespace WinUtils {
 bool TryCreateFolder(const std::string& path);
 // Adds all files (just the file name) in the specified folder to the given collection.
 void GetAllFilesInFolder(const std::string& path, std::set<std::string>& fileNames);
+// For the specified folder and all subfolders, adds all files (just the subfolder and file name, starting
+// with a slash) to the given collection.
+void GetAllFilesInFolderRecursive(const std::string& path, std::set<std::string>& fileNames);
 // Copies the file specified by sourcePath as destPath.
 // Returns true on success.
 // Returns false and logs a warning on failure.
 bool TryCopyFile(const std::string& sourcePath, const std::string& destPath);
 // Returns true if the specified file exists (and is a file rather than a folder).
 bool DoesFileExist(const std::string& path);
+// Returns the folder the converter is running in.
+std::string GetCurrentFolder();
+// Returns true if the specified folder exists (and is a folder rather than a file).
+bool DoesFolderExist(const std::string& path);
+// Copies the folder specified by sourceFolder, and everything in it, as destFolder.
+// Returns true on success.
+// Returns false and logs a warning on failure.
+bool TryCopyFolder(const std::string& sourceFolder, const std::string& destFolder);
+// Renames the folder specified by sourceFolder as destFolder.
+// Returns true on success.
+// Returns false and logs a warning on failure.
+bool TryRenameFolder(const std::string& sourceFolder, const std::string& destFolder);
+
+// Converts UTF-8 text to Windows-1252, which Victoria 2 reads. Characters with no equivalent become '0'.
+std::string ConvertUTF8To1252(const std::string& text);
 
 // Returns a formatted string describing the last error on the WinAPI.
 std::string GetLastWindowsError();
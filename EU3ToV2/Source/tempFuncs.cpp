@@ -51,7 +51,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 +		{
 +			//do whatever processing you need for each directory
 +
-+			foldersToProcess.push_back(currentFolder + directoriesData.name + "\\");
++			foldersToProcess.push_back(currentFolder + directoriesData.name + "/");
 +		}
 +		else
 +		{
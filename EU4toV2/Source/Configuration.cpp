@@ -24,6 +24,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 #include "Configuration.h"
 #include "OSCompatibilityLayer.h"
 #include "ParadoxParserUTF8.h"
+#include "ParsedFileCache.h"
 #include "Object.h"
 #include "Log.h"
 #include <vector>
@@ -51,6 +52,12 @@ Configuration::Configuration()
 		exit (-1);
 	}
 
+	string logLevel = obj[0]->safeGetString("logLevel");	// the least important messages to log
+	if ((logLevel != "") && !Log::setLevel(logLevel))
+	{
+		LOG(LogLevel::Warning) << "Unknown log level " << logLevel << ", logging everything";
+	}
+
 	EU4Path = obj[0]->getLeaf("EU4directory");
 	if (Utils::DoesFileExist(EU4Path))
 	{
@@ -94,5 +101,13 @@ Configuration::Configuration()
 	Removetype			= obj[0]->getLeaf("Removetype");
 	libertyThreshold	= stof(obj[0]->getLeaf("libertyThreshold"));
 	convertPopTotals	= (obj[0]->getLeaf("convertPopTotals") == "yes");
+	ironmanTokens		= obj[0]->safeGetString("ironmanTokens");
 	outputName			= "";
+
+	string parsedFileCache = obj[0]->safeGetString("parsedFileCache");	// where to keep parsed game and converter data between runs
+	if (parsedFileCache != "")
+	{
+		LOG(LogLevel::Debug) << "Caching parsed files in " << parsedFileCache;
+		ParsedFileCache::setSharedDirectory(parsedFileCache);
+	}
 }
\ No newline at end of file
@@ -122,6 +122,11 @@ class Configuration
 			return getInstance()->convertPopTotals;
 		}
 
+		static string getIronmanTokens()
+		{
+			return getInstance()->ironmanTokens;
+		}
+
 		static void setOutputName(string name)
 		{
 			getInstance()->outputName = name;
@@ -185,6 +190,7 @@ class Configuration
 		string Removetype;
 		double libertyThreshold;
 		bool convertPopTotals;
+		string ironmanTokens;
 	
 		// items set during conversion
 		EU4Version version;
@@ -155,7 +155,7 @@ EU4Country::EU4Country(Object* obj, EU4Version* version)
 		}
 
 		vector<Object*> historyLeaves = historyObj[0]->getLeaves();	// the object holding the individual histories for this country
-		date hundredYearsOld = date("1740.1.1");							// one hundred years before conversion
+		date hundredYearsOld = date(1740, 1, 1);							// one hundred years before conversion
 		for (vector<Object*>::iterator itr = historyLeaves.begin(); itr != historyLeaves.end(); ++itr)
 		{
 			// grab leaders from history, ignoring those that are more than 100 years old...
@@ -598,7 +598,7 @@ bool EU4Country::cultureSurvivesInCores()
 			continue;
 		}
 
-		if (core->getCulturePercent(primaryCulture) >= 0.5)
+		if (core->getCulturePercent(Symbol(primaryCulture)) >= 0.5)
 		{
 			return true;
 		}
@@ -44,17 +44,14 @@ EU4Province::EU4Province(Object* obj)
 
 	num = 0 - atoi(obj->getKey().c_str());
 
-	vector<Object*> baseTaxObjs;			// the object holding the base tax
-	baseTaxObjs = obj->getValue("base_tax");
-	baseTax = (baseTaxObjs.size() > 0) ? atof(baseTaxObjs[0]->getLeaf().c_str()) : 0.0f;
+	Object* baseTaxObj = obj->getFirst("base_tax");					// the object holding the base tax
+	baseTax = (baseTaxObj != nullptr) ? atof(baseTaxObj->getLeaf().c_str()) : 0.0f;
 
-	vector<Object*> baseProdObjs;			// the object holding the base production
-	baseProdObjs = obj->getValue("base_production");
-	baseProd = (baseProdObjs.size() > 0) ? atof(baseProdObjs[0]->getLeaf().c_str()) : 0.0f;
+	Object* baseProdObj = obj->getFirst("base_production");		// the object holding the base production
+	baseProd = (baseProdObj != nullptr) ? atof(baseProdObj->getLeaf().c_str()) : 0.0f;
 
-	vector<Object*> baseManpowerObjs;		// the object holding the base manpower
-	baseManpowerObjs = obj->getValue("base_manpower");
-	manpower = (baseManpowerObjs.size() > 0) ? atof(baseManpowerObjs[0]->getLeaf().c_str()) : 0.0f;
+	Object* baseManpowerObj = obj->getFirst("base_manpower");	// the object holding the base manpower
+	manpower = (baseManpowerObj != nullptr) ? atof(baseManpowerObj->getLeaf().c_str()) : 0.0f;
 
 	// for old versions of EU4 (< 1.12), copy tax to production if necessary
 	if (baseProd == 0.0f && baseTax > 0.0f)
@@ -62,21 +59,17 @@ EU4Province::EU4Province(Object* obj)
 		baseProd = baseTax;
 	}
 
-	vector<Object*> ownerObjs;				// the object holding the owner
-	ownerObjs = obj->getValue("owner");
-	(ownerObjs.size() == 0) ? ownerString = "" : ownerString = ownerObjs[0]->getLeaf();
+	ownerString = obj->safeGetString("owner");
 	owner = NULL;
 
 	cores.clear();
-	vector<Object*> coreObjs;				// the object holding the cores
-	coreObjs = obj->getValue("core");
-	for (unsigned int i = 0; i < coreObjs.size(); i++)
+	for (auto coreObj: obj->getRange("core"))
 	{
-		cores.push_back(coreObjs[i]->getLeaf());
+		cores.push_back(coreObj->getLeaf());
 	}
 
-	vector<Object*> hreObj = obj->getValue("hre");
-	if ((hreObj.size() > 0) && (hreObj[0]->getLeaf() == "yes"))
+	Object* hreObj = obj->getFirst("hre");	// the object holding the HRE status
+	if ((hreObj != nullptr) && (hreObj->getLeaf() == "yes"))
 	{
 		inHRE = true;
 	}
@@ -91,10 +84,10 @@ EU4Province::EU4Province(Object* obj)
 	lastPossessedDate.clear();
 	religionHistory.clear();
 	cultureHistory.clear();
-	vector<Object*> historyObj = obj->getValue("history");				// the objects holding the history of this province
-	if (historyObj.size() > 0)
+	Object* historyObj = obj->getFirst("history");				// the object holding the history of this province
+	if (historyObj != nullptr)
 	{
-		vector<Object*> historyObjs = historyObj[0]->getLeaves();		// the object holding the current history point
+		const vector<Object*>& historyObjs = historyObj->getLeaves();		// the object holding the current history point
 		string lastOwner;				// the last owner of the province
 		string thisCountry;			// the current owner of the province
 		for (unsigned int i = 0; i < historyObjs.size(); i++)
@@ -117,11 +110,11 @@ EU4Province::EU4Province(Object* obj)
 				continue;
 			}
 
-			vector<Object*> ownerObj = historyObjs[i]->getValue("owner");	// the object holding the current historical owner change
-			if (ownerObj.size() > 0)
+			Object* ownerObj = historyObjs[i]->getFirst("owner");	// the object holding the current historical owner change
+			if (ownerObj != nullptr)
 			{
 				const date newDate(historyObjs[i]->getKey());	// the date this happened
-				thisCountry = ownerObj[0]->getLeaf();
+				thisCountry = ownerObj->getLeaf();
 
 				map<string, date>::iterator itr = lastPossessedDate.find(lastOwner);
 				if (itr != lastPossessedDate.end())
@@ -132,17 +125,17 @@ EU4Province::EU4Province(Object* obj)
 
 				ownershipHistory.push_back(make_pair(newDate, thisCountry));
 			}
-			vector<Object*> culObj = historyObjs[i]->getValue("culture");	// the object holding the current historical culture change
-			if (culObj.size() > 0)
+			Object* culObj = historyObjs[i]->getFirst("culture");	// the object holding the current historical culture change
+			if (culObj != nullptr)
 			{
 				const date newDate(historyObjs[i]->getKey());	// the date this happened
-				cultureHistory.push_back(make_pair(newDate, culObj[0]->getLeaf()));
+				cultureHistory.push_back(make_pair(newDate, culObj->getLeaf()));
 			}
-			vector<Object*> religObj = historyObjs[i]->getValue("religion");	// the object holding the current historical religion change
-			if (religObj.size() > 0)
+			Object* religObj = historyObjs[i]->getFirst("religion");	// the object holding the current historical religion change
+			if (religObj != nullptr)
 			{
 				const date newDate(historyObjs[i]->getKey());	// the date this happened
-				religionHistory.push_back(make_pair(newDate, religObj[0]->getLeaf()));
+				religionHistory.push_back(make_pair(newDate, religObj->getLeaf()));
 			}
 		}
 	}
@@ -384,11 +377,11 @@ date EU4Province::getLastPossessedDate(string tag) const
 }
 
 
-double EU4Province::getCulturePercent(string culture)
+double EU4Province::getCulturePercent(Symbol culture)
 {
 	double culturePercent = 0.0f;
 
-	for (auto pop: popRatios)
+	for (auto& pop: popRatios)
 	{
 		if (pop.culture == culture)
 		{
@@ -402,9 +395,8 @@ double EU4Province::getCulturePercent(string culture)
 
 void EU4Province::checkBuilding(const Object* provinceObj, string building)
 {
-	vector<Object*> buildingObj;	// the object holding the building
-	buildingObj = provinceObj->getValue(building);
-	if ((buildingObj.size() > 0) && (buildingObj[0]->getLeaf() == "yes"))
+	Object* buildingObj = provinceObj->getFirst(building);	// the object holding the building
+	if ((buildingObj != nullptr) && (buildingObj->getLeaf() == "yes"))
 	{
 		buildings[building] = true;
 	}
@@ -414,18 +406,18 @@ void EU4Province::checkBuilding(const Object* provinceObj, string building)
 void EU4Province::buildPopRatios()
 {
 	date endDate = Configuration::getLastEU4Date();
-	if (endDate < date("1821.1.1"))
+	if (endDate < date(1821, 1, 1))
 	{
-		endDate = date("1821.1.1");
+		endDate = date(1821, 1, 1);
 	}
-	date cutoffDate	 = endDate;
-	cutoffDate.year	-= 200;
+	date cutoffDate = endDate;
+	cutoffDate.addYears(-200);
 
 	// fast-forward to 200 years before the end date (200 year decay means any changes before then will be at 100%)
 	string curCulture		= "";	// the current culture
 	string curReligion	= "";	// the current religion
 	vector< pair<date, string> >::iterator cItr = cultureHistory.begin();	// the culture under consideration
-	while (cItr != cultureHistory.end() && cItr->first.year < cutoffDate.year)
+	while (cItr != cultureHistory.end() && cItr->first.getYear() < cutoffDate.getYear())
 	{
 		curCulture = cItr->second;
 		++cItr;
@@ -436,7 +428,7 @@ void EU4Province::buildPopRatios()
 		curCulture = cItr->second;
 	}
 	vector< pair<date, string> >::iterator rItr = religionHistory.begin();	// the religion under consideration
-	while (rItr != religionHistory.end() && rItr->first.year < cutoffDate.year)
+	while (rItr != religionHistory.end() && rItr->first.getYear() < cutoffDate.getYear())
 	{
 		curReligion = rItr->second;
 		++rItr;
@@ -449,8 +441,8 @@ void EU4Province::buildPopRatios()
 
 	// build and scale historic culture-religion pairs
 	EU4PopRatio pr;		// a pop ratio
-	pr.culture			= curCulture;
-	pr.religion			= curReligion;
+	pr.culture			= Symbol(curCulture);
+	pr.religion			= Symbol(curReligion);
 	pr.upperPopRatio	= 1.0;
 	pr.middlePopRatio	= 1.0;
 	pr.lowerPopRatio	= 1.0;
@@ -459,7 +451,7 @@ void EU4Province::buildPopRatios()
 	{
 		if (cItr == cultureHistory.end())
 		{
-			cDate = date("2000.1.1");
+			cDate = date(2000, 1, 1);
 		}
 		else
 		{
@@ -467,7 +459,7 @@ void EU4Province::buildPopRatios()
 		}
 		if (rItr == religionHistory.end())
 		{
-			rDate = date("2000.1.1");
+			rDate = date(2000, 1, 1);
 		}
 		else
 		{
@@ -485,7 +477,7 @@ void EU4Province::buildPopRatios()
 			pr.upperPopRatio	= 0.5;
 			pr.middlePopRatio	= 0.5;
 			pr.lowerPopRatio	= 0.0;
-			pr.culture			= cItr->second;
+			pr.culture			= Symbol(cItr->second);
 			lastLoopDate		= cDate;
 			++cItr;
 		}
@@ -502,8 +494,8 @@ void EU4Province::buildPopRatios()
 			pr.upperPopRatio	= 0.5;
 			pr.middlePopRatio	= 0.5;
 			pr.lowerPopRatio	= 0.0;
-			pr.culture			= cItr->second;
-			pr.religion			= rItr->second;
+			pr.culture			= Symbol(cItr->second);
+			pr.religion			= Symbol(rItr->second);
 			lastLoopDate		= cDate;
 			++cItr;
 			++rItr;
@@ -520,14 +512,14 @@ void EU4Province::buildPopRatios()
 			pr.upperPopRatio	= 0.5;
 			pr.middlePopRatio	= 0.5;
 			pr.lowerPopRatio	= 0.0;
-			pr.religion			= rItr->second;
+			pr.religion			= Symbol(rItr->second);
 			lastLoopDate		= rDate;
 			++rItr;
 		}
 	}
 	decayPopRatios(lastLoopDate, endDate, pr);
 
-	if ((pr.culture != "") || (pr.religion != ""))
+	if (!pr.culture.empty() || !pr.religion.empty())
 	{
 		popRatios.push_back(pr);
 	}
@@ -543,7 +535,7 @@ void	EU4Province::decayPopRatios(date oldDate, date newDate, EU4PopRatio& curren
 	}
 
 	// quick out for same year (we do decay at year end)
-	if (oldDate.year == newDate.year)
+	if (oldDate.getYear() == newDate.getYear())
 	{
 		return;
 	}
@@ -554,15 +546,15 @@ void	EU4Province::decayPopRatios(date oldDate, date newDate, EU4PopRatio& curren
 	double lowerNonCurrentRatio	= (1.0 - currentPop.lowerPopRatio);
 	for (auto itr: popRatios)
 	{
-		itr.upperPopRatio		-= .0025 * (newDate.year - oldDate.year) * itr.upperPopRatio	/ upperNonCurrentRatio;
-		itr.middlePopRatio	-= .0025 * (newDate.year - oldDate.year) * itr.middlePopRatio	/ middleNonCurrentRatio;
-		itr.lowerPopRatio		-= .0025 * (newDate.year - oldDate.year) * itr.lowerPopRatio	/ lowerNonCurrentRatio;
+		itr.upperPopRatio		-= .0025 * (newDate.getYear() - oldDate.getYear()) * itr.upperPopRatio	/ upperNonCurrentRatio;
+		itr.middlePopRatio	-= .0025 * (newDate.getYear() - oldDate.getYear()) * itr.middlePopRatio	/ middleNonCurrentRatio;
+		itr.lowerPopRatio		-= .0025 * (newDate.getYear() - oldDate.getYear()) * itr.lowerPopRatio	/ lowerNonCurrentRatio;
 	}
 	
 	// increase current pop by .0025 per year
-	currentPop.upperPopRatio	+= .0025 * (newDate.year - oldDate.year);
-	currentPop.middlePopRatio	+= .0025 * (newDate.year - oldDate.year);
-	currentPop.lowerPopRatio	+= .0025 * (newDate.year - oldDate.year);
+	currentPop.upperPopRatio	+= .0025 * (newDate.getYear() - oldDate.getYear());
+	currentPop.middlePopRatio	+= .0025 * (newDate.getYear() - oldDate.getYear());
+	currentPop.lowerPopRatio	+= .0025 * (newDate.getYear() - oldDate.getYear());
 }
 
 
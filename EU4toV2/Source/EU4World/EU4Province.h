@@ -24,6 +24,7 @@ THE SOFTWARE. */
 
 
 #include "Date.h"
+#include "Symbol.h"
 #include <string>
 #include <vector>
 #include <map>
@@ -35,8 +36,8 @@ class EU4Country;
 
 
 struct EU4PopRatio {
-	string culture;			// the culture
-	string religion;			// the religion
+	Symbol culture;			// the culture
+	Symbol religion;			// the religion
 	double upperPopRatio;	// the percent of the total upper-class population this represents
 	double middlePopRatio;	// the percent of the total middle-class population this represents
 	double lowerPopRatio;	// the percent of the total lower-class population this represents
@@ -56,7 +57,7 @@ class EU4Province {
 		bool						hasBuilding(string building) const;
 		vector<EU4Country*>	getCores(const map<string, EU4Country*>& countries) const;
 		date						getLastPossessedDate(string tag) const;
-		double getCulturePercent(string culture);
+		double getCulturePercent(Symbol culture);
 
 		int						getNum()					const { return num; }
 		double					getBaseTax()			const { return baseTax; }
@@ -37,7 +37,7 @@ class EU4Version
 		EU4Version();
 		EU4Version(Object* obj);
 		EU4Version(string version);
-		bool operator >= (EU4Version& rhs) const;
+		bool operator >= (const EU4Version& rhs) const;
 	private:
 		int	first;		// the first part of the version number
 		int	second;		// the second part of the version number
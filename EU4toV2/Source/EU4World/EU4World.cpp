@@ -31,8 +31,11 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 #include "../Mappers/EU4CultureGroupMapper.h"
 #include "../Mappers/ProvinceMapper.h"
 #include "../Mappers/ReligionMapper.h"
+#include "BinaryTokenTable.h"
 #include "Object.h"
+#include "ParadoxParser.h"
 #include "ParadoxParserUTF8.h"
+#include "Profiler.h"
 #include "EU4Province.h"
 #include "EU4Country.h"
 #include "EU4Diplomacy.h"
@@ -50,12 +53,25 @@ EU4World::EU4World(const string& EU4SaveFileName, map<string, string> possibleMo
 
 	//	Parse EU4 Save
 	LOG(LogLevel::Info) << "Parsing save";
-	Object* obj = parser_UTF8::doParseFile(EU4SaveFileName.c_str());
+	ProfilePhase parsePhase("Parsing save");	// times how long reading the save takes
+	ParadoxParser saveParser(ParserEncoding::UTF8);	// parses the save, which is only read once so is not cached
+	saveParser.setCache(nullptr);
+	BinaryTokenTable ironmanTokens;	// the names of the tokens in ironman saves
+	if (Configuration::getIronmanTokens() != "")
+	{
+		if (!ironmanTokens.load(Configuration::getIronmanTokens()))
+		{
+			exit(-1);
+		}
+		saveParser.setBinaryTokens(&ironmanTokens);
+	}
+	Object* obj = saveParser.parseFile(EU4SaveFileName);
 	if (obj == NULL)
 	{
 		LOG(LogLevel::Error) << "Could not parse file " << EU4SaveFileName;
 		exit(-1);
 	}
+	parsePhase.end();
 
 	LOG(LogLevel::Debug) << "Get EU4 Mod";
 	vector<Object*> modObj = obj->getValue("mod_enabled");	// the used mods
@@ -412,7 +428,7 @@ void EU4World::setNumbersOfDestinationProvinces()
 {
 	for (auto province: provinces)
 	{
-		auto Vic2Provinces = provinceMapper::getVic2ProvinceNumbers(province.first);
+		const auto& Vic2Provinces = provinceMapper::getVic2ProvinceNumbers(province.first);
 		province.second->setNumDestV2Provs(Vic2Provinces.size());
 	}
 }
@@ -547,7 +563,7 @@ void EU4World::checkAllProvincesMapped() const
 {
 	for (auto province: provinces)
 	{
-		auto Vic2Provinces = provinceMapper::getVic2ProvinceNumbers(province.first);
+		const auto& Vic2Provinces = provinceMapper::getVic2ProvinceNumbers(province.first);
 		if (Vic2Provinces.size() == 0)
 		{
 			LOG(LogLevel::Warning) << "No mapping for province " << province.first;
@@ -560,9 +576,9 @@ void EU4World::checkAllEU4CulturesMapped() const
 {
 	for (auto cultureItr: EU4CultureGroupMapper::getCultureToGroupMap())
 	{
-		string Vi2Culture;
+		Symbol Vi2Culture;
 
-		string	EU4Culture	= cultureItr.first;
+		Symbol	EU4Culture	= Symbol(cultureItr.first);
 		bool		matched		= cultureMapper::cultureMatch(EU4Culture, Vi2Culture);
 		if (!matched)
 		{
@@ -576,8 +592,8 @@ void EU4World::checkAllEU4ReligionsMapped() const
 {
 	for (auto EU4Religion: EU4Religion::getAllReligions())
 	{
-		auto Vic2Religion = religionMapper::getVic2Religion(EU4Religion.first);
-		if (Vic2Religion == "")
+		auto Vic2Religion = religionMapper::getVic2Religion(Symbol(EU4Religion.first));
+		if (Vic2Religion.empty())
 		{
 			Log(LogLevel::Warning) << "No religion mapping for EU4 religion " << EU4Religion.first;
 		}
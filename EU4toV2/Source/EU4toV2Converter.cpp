@@ -28,6 +28,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 #include "OSCompatibilityLayer.h"
 #include "ParadoxParserUTF8.h"
 #include "ParadoxParser8859_15.h"
+#include "Profiler.h"
 #include "EU4World/EU4World.h"
 #include "EU4World/EU4Religion.h"
 #include "EU4World/EU4Localisation.h"
@@ -82,6 +83,7 @@ void convert(V2World& destWorld, const EU4World& sourceWorld);
 void output(const V2World& destWorld);
 void ConvertEU4ToV2(const string& EU4SaveFileName)
 {
+	ProfilePhase phase("Reading configuration");	// times each step of the conversion
 	Configuration::getInstance();
 
 	verifySave(EU4SaveFileName);
@@ -89,12 +91,21 @@ void ConvertEU4ToV2(const string& EU4SaveFileName)
 
 	map<string, string> possibleMods = getPossibleMods();
 
+	phase.next("Importing EU4 save");
 	EU4World sourceWorld(EU4SaveFileName, possibleMods);
+	phase.next("Importing V2 data");
 	V2World destWorld;
+	phase.next("Converting");
 	convert(destWorld, sourceWorld);
+	phase.next("Outputting mod");
 	output(destWorld);
+	phase.end();
 
 	LOG(LogLevel::Info) << "* Conversion complete *";
+	if (!Profiler::getInstance().writeReport("EU4toV2"))
+	{
+		LOG(LogLevel::Warning) << "Could not write the profiling report";
+	}
 }
 
 
@@ -108,16 +119,12 @@ void verifySave(const string& EU4SaveFileName)
 	}
 	else
 	{
+		// compressed saves are checked as they are read, as their headers are inside the archive
 		char buffer[7];
 		fread(buffer, 1, 7, saveFile);
-		if ((buffer[0] == 'P') && (buffer[1] == 'K'))
-		{
-			LOG(LogLevel::Error) << "Saves must be uncompressed to be converted.";
-			exit(-1);
-		}
-		else if ((buffer[0] = 'E') && (buffer[1] == 'U') && (buffer[2] == '4') && (buffer[3] = 'b') && (buffer[4] == 'i') && (buffer[5] == 'n') && (buffer[6] == 'M'))
+		if ((buffer[0] == 'E') && (buffer[1] == 'U') && (buffer[2] == '4') && (buffer[3] == 'b') && (buffer[4] == 'i') && (buffer[5] == 'n') && (Configuration::getIronmanTokens() == ""))
 		{
-			LOG(LogLevel::Error) << "Ironman saves cannot be converted.";
+			LOG(LogLevel::Error) << "Ironman saves can only be converted with a token file. Set ironmanTokens in configuration.txt.";
 			exit(-1);
 		}
 	}
@@ -126,7 +133,7 @@ void verifySave(const string& EU4SaveFileName)
 
 void getOutputName(const string& EU4SaveFileName)
 {
-	const int slash	= EU4SaveFileName.find_last_of("\\");				// the last slash in the save's filename
+	const int slash	= EU4SaveFileName.find_last_of("/\\");				// the last slash in the save's filename
 	string outputName	= EU4SaveFileName.substr(slash + 1, EU4SaveFileName.length());
 	const int length	= outputName.find_first_of(".");						// the first period after the slash
 	outputName			= outputName.substr(0, length);						// the name to use to output the mod
@@ -284,6 +291,7 @@ void convert(V2World& destWorld, const EU4World& sourceWorld)
 	map<int, int> leaderIDMap; // <EU4, V2>
 
 	// Parse tech schools
+	ProfilePhase phase("Parsing tech schools");	// times each step of converting
 	LOG(LogLevel::Info) << "Parsing tech schools.";
 	Object* techSchoolObj = parser_UTF8::doParseFile("blocked_tech_schools.txt");
 	if (techSchoolObj == NULL)
@@ -303,29 +311,41 @@ void convert(V2World& destWorld, const EU4World& sourceWorld)
 	techSchools = initTechSchools(technologyObj, blockedTechSchools);
 
 	// Construct factory factory
+	phase.next("Determining factory allocation rules");
 	LOG(LogLevel::Info) << "Determining factory allocation rules.";
 	V2FactoryFactory factoryBuilder;
 
+	phase.next("Converting countries");
 	LOG(LogLevel::Info) << "Converting countries";
 	destWorld.convertCountries(sourceWorld, techSchools, leaderIDMap);
+	phase.next("Converting provinces");
 	LOG(LogLevel::Info) << "Converting provinces";
 	destWorld.convertProvinces(sourceWorld);
+	phase.next("Converting diplomacy");
 	LOG(LogLevel::Info) << "Converting diplomacy";
 	destWorld.convertDiplomacy(sourceWorld);
+	phase.next("Setting colonies");
 	LOG(LogLevel::Info) << "Setting colonies";
 	destWorld.setupColonies();
+	phase.next("Creating states");
 	LOG(LogLevel::Info) << "Creating states";
 	destWorld.setupStates();
+	phase.next("Setting unciv reforms");
 	LOG(LogLevel::Info) << "Setting unciv reforms";
 	destWorld.convertUncivReforms();
+	phase.next("Converting techs");
 	LOG(LogLevel::Info) << "Converting techs";
 	destWorld.convertTechs(sourceWorld);
+	phase.next("Allocating starting factories");
 	LOG(LogLevel::Info) << "Allocating starting factories";
 	destWorld.allocateFactories(sourceWorld, factoryBuilder);
+	phase.next("Creating pops");
 	LOG(LogLevel::Info) << "Creating pops";
 	destWorld.setupPops(sourceWorld);
+	phase.next("Adding unions");
 	LOG(LogLevel::Info) << "Adding unions";
 	destWorld.addUnions();
+	phase.next("Converting armies and navies");
 	LOG(LogLevel::Info) << "Converting armies and navies";
 	destWorld.convertArmies(sourceWorld, leaderIDMap);
 }
@@ -346,7 +366,7 @@ void output(const V2World& destWorld)
 
 void createModFile()
 {
-	ofstream modFile("Output/" + Configuration::getOutputName() + ".mod");
+	ofstream modFile("output/" + Configuration::getOutputName() + ".mod");
 	if (!modFile.is_open())
 	{
 		LOG(LogLevel::Error) << "Could not create " << Configuration::getOutputName() << ".mod";
@@ -116,21 +116,21 @@ bool CreateCustomFlag(FlagColour c1, FlagColour c2, FlagColour c3, std::string e
 			tg /= 255;
 			tb /= 255;
 
-			uint8_t or = 0, og = 0, ob = 0, oa = 0;
+			uint8_t overlayR = 0, overlayG = 0, overlayB = 0, overlayA = 0;
 
 			uint8_t *targetOverlayAddress = tga_find_pixel(&emblem, x, y);
 			if (targetOverlayAddress)
 			{
-				res = tga_unpack_pixel(targetOverlayAddress, emblem.pixel_depth, &ob, &og, &or, &oa);
+				res = tga_unpack_pixel(targetOverlayAddress, emblem.pixel_depth, &overlayB, &overlayG, &overlayR, &overlayA);
 				if (0 != res)
 				{
 					LOG(LogLevel::Error) << "Failed to create custom flag: could not read pixel data";
 					return false;
 				}
 				
-				tr = (or*oa / 255) + ((tr *(255 - oa)) / 255);
-				tg = (og*oa / 255) + ((tg *(255 - oa)) / 255);
-				tb = (ob*oa / 255) + ((tb *(255 - oa)) / 255);
+				tr = (overlayR*overlayA / 255) + ((tr *(255 - overlayA)) / 255);
+				tg = (overlayG*overlayA / 255) + ((tg *(255 - overlayA)) / 255);
+				tb = (overlayB*overlayA / 255) + ((tb *(255 - overlayA)) / 255);
 			}
 			else
 			{
@@ -23,7 +23,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 #include "AdjacencyMapper.h"
 #include "../Configuration.h"
-#include "log.h"
+#include "Log.h"
 #include "OSCompatibilityLayer.h"
 #include <fstream>
 
@@ -22,9 +22,9 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 
 #include "CK2TitleMapper.h"
-#include "log.h"
+#include "Log.h"
 #include "Object.h"
-#include "paradoxParserUTF8.h"
+#include "ParadoxParserUTF8.h"
 #include "../V2World/V2Localisation.h"
 
 
@@ -324,7 +324,7 @@ bool CountryMapping::mapToExistingVic2Country(const vector<string>& possibleVic2
 	{
 		if ((Vic2Countries.find(possibleVic2Tag) != Vic2Countries.end()) && (tagIsAlreadyAssigned(possibleVic2Tag)))
 		{
-			EU4TagToV2TagMap.left.insert(make_pair(EU4Tag, possibleVic2Tag));
+			addMapping(EU4Tag, possibleVic2Tag);
 			logMapping(EU4Tag, possibleVic2Tag, "default V2 country");
 
 			return true;
@@ -341,7 +341,7 @@ bool CountryMapping::mapToFirstUnusedVic2Tag(const vector<string>& possibleVic2T
 	{
 		if (!tagIsAlreadyAssigned(possibleVic2Tag))
 		{
-			EU4TagToV2TagMap.left.insert(make_pair(EU4Tag, possibleVic2Tag));
+			addMapping(EU4Tag, possibleVic2Tag);
 			logMapping(EU4Tag, possibleVic2Tag, "mapping rule, not a V2 country");
 
 			return true;
@@ -371,11 +371,27 @@ string CountryMapping::generateNewTag()
 
 void CountryMapping::mapToNewTag(const string& EU4Tag, const string& Vic2Tag)
 {
-	EU4TagToV2TagMap.left.insert(make_pair(EU4Tag, Vic2Tag));
+	addMapping(EU4Tag, Vic2Tag);
 	logMapping(EU4Tag, Vic2Tag, "generated tag");
 }
 
 
+// Maps the tags to each other unless either is already mapped
+bool CountryMapping::addMapping(const string& EU4Tag, const string& Vic2Tag)
+{
+	const TagId EU4Id		= TagRegistry::getId(EU4Tag);
+	const TagId Vic2Id	= TagRegistry::getId(Vic2Tag);
+	if (EU4TagToV2TagMap.contains(EU4Id) || V2TagToEU4TagMap.contains(Vic2Id))
+	{
+		return false;
+	}
+
+	EU4TagToV2TagMap.set(EU4Id, Vic2Id);
+	V2TagToEU4TagMap.set(Vic2Id, EU4Id);
+	return true;
+}
+
+
 map<string, vector<string>>::iterator CountryMapping::ifValidGetCK2MappingRule(const EU4Country* country, map<string, vector<string>>::iterator mappingRule)
 {
 	if ((mappingRule == EU4TagToV2TagsRules.end()) || (country->isCustom()))
@@ -397,7 +413,7 @@ bool CountryMapping::attemptColonialReplacement(EU4Country* country, const EU4Wo
 
 	int Vic2Capital;
 	int EU4Capital = country->getCapital();
-	auto potentialVic2Capitals = provinceMapper::getVic2ProvinceNumbers(EU4Capital);
+	const auto& potentialVic2Capitals = provinceMapper::getVic2ProvinceNumbers(EU4Capital);
 	if (potentialVic2Capitals.size() > 0)
 	{
 		Vic2Capital = potentialVic2Capitals[0];
@@ -423,7 +439,7 @@ bool CountryMapping::attemptColonialReplacement(EU4Country* country, const EU4Wo
 
 		if (tagIsAvailable(colony, Vic2Countries))
 		{
-			EU4TagToV2TagMap.left.insert(make_pair(country->getTag(), colony.tag));
+			addMapping(country->getTag(), colony.tag);
 			logMapping(country->getTag(), colony.tag, "colonial replacement");
 			return true;
 		}
@@ -467,7 +483,7 @@ bool CountryMapping::capitalInRightVic2Region(const colonyStruct& colony, int Vi
 		{
 			for (auto Vic2ProvinceNumber: Vic2Region->second)
 			{
-				auto EU4ProvinceNumbers = provinceMapper::getEU4ProvinceNumbers(Vic2ProvinceNumber);
+				const auto& EU4ProvinceNumbers = provinceMapper::getEU4ProvinceNumbers(Vic2ProvinceNumber);
 				if (EU4ProvinceNumbers.size() > 0)
 				{
 					return false;
@@ -525,27 +541,29 @@ void CountryMapping::logMapping(const string& EU4Tag, const string& V2Tag, const
 
 bool CountryMapping::tagIsAlreadyAssigned(const string& Vic2Tag)
 {
-	return (EU4TagToV2TagMap.right.find(Vic2Tag) != EU4TagToV2TagMap.right.end());
+	const TagId Vic2Id = TagRegistry::findId(Vic2Tag);
+	return ((Vic2Id != TagRegistry::invalidId) && V2TagToEU4TagMap.contains(Vic2Id));
 }
 
 
-const string CountryMapping::GetV2Tag(const string& EU4Tag) const
+const string& CountryMapping::GetV2Tag(const string& EU4Tag) const
 {
-	const vector<string> EU4RebelTags = { "REB", "PIR", "NAT" };
 	static const string V2RebelTag = "REB";
-	if (find(EU4RebelTags.begin(), EU4RebelTags.end(), EU4Tag) != EU4RebelTags.end())
+	static const string noTag;
+	if ((EU4Tag == "REB") || (EU4Tag == "PIR") || (EU4Tag == "NAT"))
 	{
 		return V2RebelTag;
 	}
 
-	auto findIter = EU4TagToV2TagMap.left.find(EU4Tag);
-	if (findIter != EU4TagToV2TagMap.left.end())
+	const TagId EU4Id = TagRegistry::findId(EU4Tag);
+	const TagId* Vic2Id = (EU4Id != TagRegistry::invalidId) ? EU4TagToV2TagMap.find(EU4Id) : nullptr;
+	if (Vic2Id != nullptr)
 	{
-		return findIter->second;
+		return TagRegistry::getTag(*Vic2Id);
 	}
 	else
 	{
-		return "";
+		return noTag;
 	}
 }
 
@@ -30,8 +30,8 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 #include <set>
 #include <string>
 #include <vector>
-#include <boost/bimap.hpp>
 #include "ColonialTagsMapper.h"
+#include "IdRegistry.h"
 using namespace std;
 
 
@@ -52,7 +52,7 @@ class CountryMapping
 			getInstance()->CreateMappings(srcWorld, Vic2Countries);
 		}
 
-		static string getVic2Tag(const string& EU4Tag)
+		static const string& getVic2Tag(const string& EU4Tag)
 		{
 			return getInstance()->GetV2Tag(EU4Tag);
 		}
@@ -93,6 +93,7 @@ class CountryMapping
 		bool mapToFirstUnusedVic2Tag(const vector<string>& possibleVic2Tags, const string& EU4Tag);
 		string generateNewTag();
 		void mapToNewTag(const string& EU4Tag, const string& Vic2Tag);
+		bool addMapping(const string& EU4Tag, const string& Vic2Tag);
 		bool attemptColonialReplacement(EU4Country* country, const EU4World& srcWorld, const map<string, V2Country*>& Vic2Countries);
 		bool capitalInRightEU4Region(const colonyStruct& colony, int EU4Capital);
 		bool capitalInRightVic2Region(const colonyStruct& colony, int Vic2Capital, const EU4World& srcWorld, const string& EU4Tag);
@@ -101,12 +102,13 @@ class CountryMapping
 		void logMapping(const string& EU4Tag, const string& V2Tag, const string& reason);
 		bool tagIsAlreadyAssigned(const string& Vic2Tag);
 
-		const string GetV2Tag(const string& EU4Tag) const;
+		const string& GetV2Tag(const string& EU4Tag) const;
 
 		string GetCK2Title(const string& EU4Tag, const string& countryName, const set<string>& availableFlags);
 
 		map<string, vector<string>> EU4TagToV2TagsRules;
-		boost::bimap<string, string> EU4TagToV2TagMap;
+		DenseIdMap<TagId> EU4TagToV2TagMap;	// the Vic2 tag for each EU4 tag, by tag ID
+		DenseIdMap<TagId> V2TagToEU4TagMap;	// the EU4 tag for each Vic2 tag, by tag ID
 		map<string, set<int>> EU4ColonialRegions;
 		map<string, set<int>> Vic2Regions;
 
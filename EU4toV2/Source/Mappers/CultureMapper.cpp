@@ -70,7 +70,7 @@ void cultureMapper::initCultureMap(Object* cultureMapObj, Object* slaveCultureMa
 		vector<cultureStruct> newRules = createNewRules(rule);
 		for (auto newRule: newRules)
 		{
-			cultureMap.push_back(newRule);
+			cultureMap[newRule.srcCulture].push_back(newRule);
 		}
 	}
 
@@ -79,7 +79,7 @@ void cultureMapper::initCultureMap(Object* cultureMapObj, Object* slaveCultureMa
 		vector<cultureStruct> newRules = createNewRules(rule);
 		for (auto newRule: newRules)
 		{
-			slaveCultureMap.push_back(newRule);
+			slaveCultureMap[newRule.srcCulture].push_back(newRule);
 		}
 	}
 }
@@ -89,18 +89,18 @@ vector<cultureStruct> cultureMapper::createNewRules(Object* ruleObj)
 {
 	vector<cultureStruct> newRules;
 
-	vector<string> srcCultures;
-	string dstCulture;
+	vector<Symbol> srcCultures;
+	Symbol dstCulture;
 	map<string, string> distinguishers;
 	for (auto item: ruleObj->getLeaves())
 	{
 		if (item->getKey() == "v2")
 		{
-			dstCulture = item->getLeaf();
+			dstCulture = Symbol(item->getLeaf());
 		}
 		else if (item->getKey() == "eu4")
 		{
-			srcCultures.push_back(item->getLeaf());
+			srcCultures.push_back(Symbol(item->getLeaf()));
 		}
 		else
 		{
@@ -121,35 +121,38 @@ vector<cultureStruct> cultureMapper::createNewRules(Object* ruleObj)
 }
 
 
-bool cultureMapper::CultureMatch(const string& srcCulture, string& dstCulture, const string& religion, int EU4Province, const string& ownerTag)
+bool cultureMapper::CultureMatch(Symbol srcCulture, Symbol& dstCulture, Symbol religion, int EU4Province, const string& ownerTag)
 {
-	for (auto cultureMapping: cultureMap)
+	auto rules = cultureMap.find(srcCulture);
+	if (rules == cultureMap.end())
 	{
-		if (cultureMapping.srcCulture == srcCulture)
-		{
-			if (distinguishersMatch(cultureMapping.distinguishers, religion, EU4Province, ownerTag))
-			{
-				dstCulture = cultureMapping.dstCulture;
-				return true;
-			}
-		}
+		return false;
 	}
 
-	return false;
+	return matchRules(rules->second, dstCulture, religion, EU4Province, ownerTag);
+}
+
+
+bool cultureMapper::SlaveCultureMatch(Symbol srcCulture, Symbol& dstCulture, Symbol religion, int EU4Province, const string& ownerTag)
+{
+	auto rules = slaveCultureMap.find(srcCulture);
+	if (rules == slaveCultureMap.end())
+	{
+		return false;
+	}
+
+	return matchRules(rules->second, dstCulture, religion, EU4Province, ownerTag);
 }
 
 
-bool cultureMapper::SlaveCultureMatch(const string& srcCulture, string& dstCulture, const string& religion, int EU4Province, const string& ownerTag)
+bool cultureMapper::matchRules(const vector<cultureStruct>& rules, Symbol& dstCulture, Symbol religion, int EU4Province, const string& ownerTag)
 {
-	for (auto cultureMapping: slaveCultureMap)
+	for (auto& cultureMapping: rules)
 	{
-		if (cultureMapping.srcCulture == srcCulture)
+		if (distinguishersMatch(cultureMapping.distinguishers, religion, EU4Province, ownerTag))
 		{
-			if (distinguishersMatch(cultureMapping.distinguishers, religion, EU4Province, ownerTag))
-			{
-				dstCulture = cultureMapping.dstCulture;
-				return true;
-			}
+			dstCulture = cultureMapping.dstCulture;
+			return true;
 		}
 	}
 
@@ -157,9 +160,9 @@ bool cultureMapper::SlaveCultureMatch(const string& srcCulture, string& dstCultu
 }
 
 
-bool cultureMapper::distinguishersMatch(const map<string, string>& distinguishers, const string& religion, int EU4Province, const string& ownerTag)
+bool cultureMapper::distinguishersMatch(const map<string, string>& distinguishers, Symbol religion, int EU4Province, const string& ownerTag)
 {
-	for (auto currentDistinguisher: distinguishers)
+	for (auto& currentDistinguisher: distinguishers)
 	{
 		if (currentDistinguisher.first == "owner")
 		{
@@ -170,7 +173,7 @@ bool cultureMapper::distinguishersMatch(const map<string, string>& distinguisher
 		}
 		else if (currentDistinguisher.first == "religion")
 		{
-			if (religion != currentDistinguisher.second)
+			if (religion.str() != currentDistinguisher.second)
 			{
 				return false;
 			}
@@ -28,7 +28,9 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 #include <map>
 #include <string>
+#include <unordered_map>
 #include <vector>
+#include "Symbol.h"
 using namespace std;
 
 
@@ -39,8 +41,8 @@ class Object;
 
 typedef struct
 {
-	string srcCulture;
-	string dstCulture;
+	Symbol srcCulture;
+	Symbol dstCulture;
 	map<string, string> distinguishers;	// type, details
 } cultureStruct;
 
@@ -49,12 +51,12 @@ typedef struct
 class cultureMapper
 {
 	public:
-		static bool cultureMatch(const string& srcCulture, string& dstCulture, const string& religion = "", int EU4Province = -1, const string& ownerTag = "")
+		static bool cultureMatch(Symbol srcCulture, Symbol& dstCulture, Symbol religion = Symbol(), int EU4Province = -1, const string& ownerTag = "")
 		{
 			return getInstance()->CultureMatch(srcCulture, dstCulture, religion, EU4Province, ownerTag);
 		}
 
-		static bool slaveCultureMatch(const string& srcCulture, string& dstCulture, const string& religion = "", int EU4Province = -1, const string& ownerTag = "")
+		static bool slaveCultureMatch(Symbol srcCulture, Symbol& dstCulture, Symbol religion = Symbol(), int EU4Province = -1, const string& ownerTag = "")
 		{
 			return getInstance()->SlaveCultureMatch(srcCulture, dstCulture, religion, EU4Province, ownerTag);
 		}
@@ -74,12 +76,13 @@ class cultureMapper
 		void initCultureMap(Object* cultureMapObj, Object* slaveCultureMapObj);
 		vector<cultureStruct> createNewRules(Object* ruleObj);
 
-		bool CultureMatch(const string& srcCulture, string& dstCulture, const string& religion = "", int EU4Province = -1, const string& ownerTag = "");
-		bool SlaveCultureMatch(const string& srcCulture, string& dstCulture, const string& religion = "", int EU4Province = -1, const string& ownerTag = "");
-		bool distinguishersMatch(const map<string, string>& distinguishers, const string& religion = "", int EU4Province = -1, const string& ownerTag = "");
+		bool CultureMatch(Symbol srcCulture, Symbol& dstCulture, Symbol religion = Symbol(), int EU4Province = -1, const string& ownerTag = "");
+		bool SlaveCultureMatch(Symbol srcCulture, Symbol& dstCulture, Symbol religion = Symbol(), int EU4Province = -1, const string& ownerTag = "");
+		bool matchRules(const vector<cultureStruct>& rules, Symbol& dstCulture, Symbol religion, int EU4Province, const string& ownerTag);
+		bool distinguishersMatch(const map<string, string>& distinguishers, Symbol religion = Symbol(), int EU4Province = -1, const string& ownerTag = "");
 
-		vector<cultureStruct> cultureMap;
-		vector<cultureStruct> slaveCultureMap;
+		unordered_map<Symbol, vector<cultureStruct>> cultureMap;			// EU4 culture -> its rules, in file order
+		unordered_map<Symbol, vector<cultureStruct>> slaveCultureMap;	// EU4 culture -> its rules, in file order
 };
 
 
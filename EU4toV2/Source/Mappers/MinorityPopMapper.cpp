@@ -71,27 +71,27 @@ void minorityPopMapper::initMinorityPopMap(Object* obj)
 			}
 		}
 
-		minorityPopMap.push_back(make_pair(minorityCulture, minorityReligion));
+		minorityPopMap.push_back(make_pair(Symbol(minorityCulture), Symbol(minorityReligion)));
 	}
 }
 
 
 bool minorityPopMapper::MatchMinorityPop(V2Pop* pop)
 {
-	for (auto minorityItr: minorityPopMap)
+	for (auto& minorityItr: minorityPopMap)
 	{
 		if ((pop->getCulture() == minorityItr.first) && (pop->getReligion() == minorityItr.second))
 		{
 			return true;
 		}
-		else if ((minorityItr.first == "") && (pop->getReligion() == minorityItr.second))
+		else if (minorityItr.first.empty() && (pop->getReligion() == minorityItr.second))
 		{
-			pop->setCulture("");
+			pop->setCulture(Symbol());
 			return true;
 		}
-		else if ((pop->getCulture() == minorityItr.first) && (minorityItr.second == ""))
+		else if ((pop->getCulture() == minorityItr.first) && minorityItr.second.empty())
 		{
-			pop->setReligion("");
+			pop->setReligion(Symbol());
 			return true;
 		}
 	}
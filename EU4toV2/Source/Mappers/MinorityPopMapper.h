@@ -28,6 +28,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 #include <string>
 #include <vector>
+#include "Symbol.h"
 using namespace std;
 
 
@@ -61,7 +62,7 @@ class minorityPopMapper
 
 		bool MatchMinorityPop(V2Pop* pop);
 
-		vector<pair<string, string>> minorityPopMap;
+		vector<pair<Symbol, Symbol>> minorityPopMap;
 };
 
 
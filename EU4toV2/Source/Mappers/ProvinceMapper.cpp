@@ -24,7 +24,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 #include "ProvinceMapper.h"
 #include "Log.h"
 #include "Object.h"
-#include "paradoxParserUTF8.h"
+#include "ParadoxParserUTF8.h"
 #include "../Configuration.h"
 #include "../EU4World/EU4Version.h"
 
@@ -119,9 +119,9 @@ void provinceMapper::createMappings(Object* mapping)
 
 	for (auto Vic2Number: Vic2Numbers)
 	{
-		if (Vic2Number != 0)
+		if (Vic2Number > 0)
 		{
-			Vic2ToEU4ProvinceMap.insert(make_pair(Vic2Number, EU4Numbers));
+			Vic2ToEU4ProvinceMap.insert(Vic2Number, EU4Numbers);
 			if (resettable)
 			{
 				resettableProvinces.insert(Vic2Number);
@@ -130,41 +130,28 @@ void provinceMapper::createMappings(Object* mapping)
 	}
 	for (auto EU4Number: EU4Numbers)
 	{
-		if (EU4Number != 0)
+		if (EU4Number > 0)
 		{
-			EU4ToVic2ProvinceMap.insert(make_pair(EU4Number, Vic2Numbers));
+			EU4ToVic2ProvinceMap.insert(EU4Number, Vic2Numbers);
 		}
 	}
 }
 
 
-const vector<int> provinceMapper::GetVic2ProvinceNumbers(const int EU4ProvinceNumber)
+static const vector<int> noProvinces;
+
+
+const vector<int>& provinceMapper::GetVic2ProvinceNumbers(const int EU4ProvinceNumber) const
 {
-	auto mapping = EU4ToVic2ProvinceMap.find(EU4ProvinceNumber);
-	if (mapping != EU4ToVic2ProvinceMap.end())
-	{
-		return mapping->second;
-	}
-	else
-	{
-		vector<int> empty;
-		return empty;
-	}
+	auto mapping = (EU4ProvinceNumber > 0) ? EU4ToVic2ProvinceMap.find(EU4ProvinceNumber) : nullptr;
+	return (mapping != nullptr) ? *mapping : noProvinces;
 }
 
 
-const vector<int> provinceMapper::GetEU4ProvinceNumbers(int Vic2ProvinceNumber)
+const vector<int>& provinceMapper::GetEU4ProvinceNumbers(int Vic2ProvinceNumber) const
 {
-	auto mapping = Vic2ToEU4ProvinceMap.find(Vic2ProvinceNumber);
-	if (mapping != Vic2ToEU4ProvinceMap.end())
-	{
-		return mapping->second;
-	}
-	else
-	{
-		vector<int> empty;
-		return empty;
-	}
+	auto mapping = (Vic2ProvinceNumber > 0) ? Vic2ToEU4ProvinceMap.find(Vic2ProvinceNumber) : nullptr;
+	return (mapping != nullptr) ? *mapping : noProvinces;
 }
 
 
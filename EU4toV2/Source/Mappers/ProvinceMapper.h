@@ -26,9 +26,9 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 
 
-#include <map>
 #include <unordered_set>
 #include <vector>
+#include "IdRegistry.h"
 using namespace std;
 
 
@@ -40,12 +40,12 @@ class Object;
 class provinceMapper
 {
 	public:
-		static const vector<int> getVic2ProvinceNumbers(int EU4ProvinceNumber)
+		static const vector<int>& getVic2ProvinceNumbers(int EU4ProvinceNumber)
 		{
 			return getInstance()->GetVic2ProvinceNumbers(EU4ProvinceNumber);
 		}
 
-		static const vector<int> getEU4ProvinceNumbers(int Vic2ProvinceNumber)
+		static const vector<int>& getEU4ProvinceNumbers(int Vic2ProvinceNumber)
 		{
 			return getInstance()->GetEU4ProvinceNumbers(Vic2ProvinceNumber);
 		}
@@ -72,12 +72,12 @@ class provinceMapper
 		int getMappingsIndex(vector<Object*> versions);
 		void createMappings(Object* mapping);
 
-		const vector<int> GetVic2ProvinceNumbers(int EU4ProvinceNumber);
-		const vector<int> GetEU4ProvinceNumbers(int Vic2ProvinceNumber);
+		const vector<int>& GetVic2ProvinceNumbers(int EU4ProvinceNumber) const;
+		const vector<int>& GetEU4ProvinceNumbers(int Vic2ProvinceNumber) const;
 		bool IsProvinceResettable(int Vic2ProvinceNumber);
 
-		map<int, vector<int>> Vic2ToEU4ProvinceMap;
-		map<int, vector<int>> EU4ToVic2ProvinceMap;
+		DenseIdMap<vector<int>> Vic2ToEU4ProvinceMap;	// the EU4 provinces for each Vic2 province, by province number
+		DenseIdMap<vector<int>> EU4ToVic2ProvinceMap;	// the Vic2 provinces for each EU4 province, by province number
 		unordered_set<int> resettableProvinces;
 };
 
@@ -59,18 +59,18 @@ void religionMapper::initReligionMap(Object* obj)
 
 	for (auto rule: rules)
 	{
-		string Vic2Religion;
-		vector<string> EU4Religions;
+		Symbol Vic2Religion;
+		vector<Symbol> EU4Religions;
 
 		for (auto ruleItem: rule->getLeaves())
 		{
 			if (ruleItem->getKey() == "v2")
 			{
-				Vic2Religion = ruleItem->getLeaf();
+				Vic2Religion = Symbol(ruleItem->getLeaf());
 			}
 			if (ruleItem->getKey() == "eu4")
 			{
-				EU4Religions.push_back(ruleItem->getLeaf());
+				EU4Religions.push_back(Symbol(ruleItem->getLeaf()));
 			}
 		}
 
@@ -82,7 +82,7 @@ void religionMapper::initReligionMap(Object* obj)
 }
 
 
-string religionMapper::GetVic2Religion(const string& EU4Religion)
+Symbol religionMapper::GetVic2Religion(Symbol EU4Religion)
 {
 	auto mapping = EU4ToVic2ReligionMap.find(EU4Religion);
 	if (mapping != EU4ToVic2ReligionMap.end())
@@ -91,6 +91,6 @@ string religionMapper::GetVic2Religion(const string& EU4Religion)
 	}
 	else
 	{
-		return "";
+		return Symbol();
 	}
 }
\ No newline at end of file
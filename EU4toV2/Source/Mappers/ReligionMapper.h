@@ -26,8 +26,9 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 
 
-#include <map>
 #include <string>
+#include <unordered_map>
+#include "Symbol.h"
 using namespace std;
 
 
@@ -39,7 +40,7 @@ class Object;
 class religionMapper
 {
 	public:
-		static string getVic2Religion(const string& EU4Religion)
+		static Symbol getVic2Religion(Symbol EU4Religion)
 		{
 			return getInstance()->GetVic2Religion(EU4Religion);
 		}
@@ -57,9 +58,9 @@ class religionMapper
 		religionMapper();
 		void initReligionMap(Object* obj);
 
-		string GetVic2Religion(const string& EU4Religion);
+		Symbol GetVic2Religion(Symbol EU4Religion);
 
-		map<string, string> EU4ToVic2ReligionMap;
+		unordered_map<Symbol, Symbol> EU4ToVic2ReligionMap;
 };
 
 
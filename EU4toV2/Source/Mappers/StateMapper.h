@@ -25,6 +25,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 #define STATE_MAPPER_H
 
 
+#include <cstddef>
 #include <map>
 #include <vector>
 using namespace std;
@@ -22,7 +22,9 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 
 #include "V2Army.h"
+#include <cstring>
 #include "Log.h"
+#include "OutputWriter.h"
 
 
 
@@ -36,14 +38,14 @@ V2ArmyID::V2ArmyID()
 }
 
 
-void V2ArmyID::output(FILE* out, int indentlevel) const
+void V2ArmyID::output(OutputFile& out, int indentlevel) const
 {
 	string indent(indentlevel, '\t');
-	fprintf(out, "%sid=\n", indent.c_str());
-	fprintf(out, "%s{\n", indent.c_str());
-	fprintf(out, "%s\tid=%d\n", indent.c_str(), id);
-	fprintf(out, "%s\ttype=%d\n", indent.c_str(), type);
-	fprintf(out, "%s}\n", indent.c_str());
+	out.print("%sid=\n", indent.c_str());
+	out.print("%s{\n", indent.c_str());
+	out.print("%s\tid=%d\n", indent.c_str(), id);
+	out.print("%s\ttype=%d\n", indent.c_str(), type);
+	out.print("%s}\n", indent.c_str());
 }
 
 
@@ -85,23 +87,23 @@ V2Regiment::V2Regiment(RegimentCategory rc) : category(rc)
 }
 
 
-void V2Regiment::output(FILE* out) const
+void V2Regiment::output(OutputFile& out) const
 {
 	if (isShip)
 	{
-		fprintf(out, "\tship = {\n");
+		out.print("\tship = {\n");
 	}
 	else
 	{
-		fprintf(out, "\tregiment = {\n");
+		out.print("\tregiment = {\n");
 	}
-	fprintf(out, "\t\tname=\"%s\"\n", name.c_str());
-	fprintf(out, "\t\ttype=%s\n", type.c_str());
+	out.print("\t\tname=\"%s\"\n", name.c_str());
+	out.print("\t\ttype=%s\n", type.c_str());
 	if (!isShip)
 	{
-		fprintf(out, "\t\thome=%d\n", home);
+		out.print("\t\thome=%d\n", home);
 	}
-	fprintf(out, "\t}\n");
+	out.print("\t}\n");
 }
 
 
@@ -116,7 +118,7 @@ V2Army::V2Army(EU4Army* oldArmy, map<int, int> leaderIDMap)
 }
 
 
-void V2Army::output(FILE* out) const
+void V2Army::output(OutputFile& out) const
 {
 	if (regiments.size() == 0)
 	{
@@ -125,20 +127,20 @@ void V2Army::output(FILE* out) const
 	}
 	if (isNavy)
 	{
-		fprintf(out, "navy = {\n");
+		out.print("navy = {\n");
 	}
 	else
 	{
-		fprintf(out, "army = {\n");
+		out.print("army = {\n");
 	}
-	fprintf(out, "\tname=\"%s\"\n", name.c_str());
-	fprintf(out, "\tlocation=%d\n", location);
+	out.print("\tname=\"%s\"\n", name.c_str());
+	out.print("\tlocation=%d\n", location);
 	for (vector<V2Regiment>::const_iterator itr = regiments.begin(); itr != regiments.end(); ++itr)
 	{
 		itr->output(out);
 	}
-	fprintf(out, "}\n");
-	fprintf(out, "\n");
+	out.print("}\n");
+	out.print("\n");
 }
 
 
@@ -28,13 +28,15 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 #include "../EU4World/EU4Army.h"
 
+class OutputFile;
+
 
 
 struct V2ArmyID
 {
 	public:
 		V2ArmyID();
-		void output(FILE* out, int indentlevel) const;
+		void output(OutputFile& out, int indentlevel) const;
 
 		int id;
 		int type;
@@ -45,7 +47,7 @@ class V2Regiment // also Ship
 {
 	public:
 		V2Regiment(RegimentCategory rc);
-		void output(FILE* out) const;
+		void output(OutputFile& out) const;
 
 		void setName(string _name)		{ name = _name; };
 		void setHome(int newHome)		{ home = newHome; };
@@ -66,7 +68,7 @@ class V2Army // also Navy
 {
 	public:
 		V2Army(EU4Army* oldArmy, map<int, int> leaderIDMap);
-		void					output(FILE* out) const;
+		void					output(OutputFile& out) const;
 		void					addRegiment(V2Regiment reg);
 
 		void					setLocation(int provinceID)												{ location = provinceID; };
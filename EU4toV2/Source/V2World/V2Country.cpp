@@ -33,8 +33,9 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 #include "../Configuration.h"
 #include "../Mappers/ReligionMapper.h"
 #include "CardinalToOrdinal.h"
-#include "paradoxParser8859_15.h"
+#include "ParadoxParser8859_15.h"
 #include "OSCompatibilityLayer.h"
+#include "OutputWriter.h"
 #include "../EU4World/EU4World.h"
 #include "../EU4World/EU4Country.h"
 #include "../EU4World/EU4Province.h"
@@ -151,7 +152,7 @@ V2Country::V2Country(string _tag, string _commonCountryFile, vector<V2Party*> _p
 	// set a default ruling party
 	for (vector<V2Party*>::iterator i = parties.begin(); i != parties.end(); i++)
 	{
-		if ((*i)->isActiveOn(date("1836.1.1")))
+		if ((*i)->isActiveOn(date(1836, 1, 1)))
 		{
 			rulingParty = (*i)->name;
 			break;
@@ -173,52 +174,47 @@ void V2Country::output() const
 {
 	if(!dynamicCountry)
 	{
-		FILE* output;
-		if (fopen_s(&output, ("Output/" + Configuration::getOutputName() + "/history/countries/" + filename).c_str(), "w") != 0)
-		{
-			LOG(LogLevel::Error) << "Could not create country history file " << filename;
-			exit(-1);
-		}
+		OutputFile output("output/" + Configuration::getOutputName() + "/history/countries/" + filename);
 
 		if (capital > 0)
 		{
-			fprintf(output, "capital=%d\n", capital);
+			output.print("capital=%d\n", capital);
 		}
-		fprintf(output, "primary_culture = %s\n", primaryCulture.c_str());
+		output.print("primary_culture = %s\n", primaryCulture.c_str());
 		for (set<string>::iterator i = acceptedCultures.begin(); i != acceptedCultures.end(); i++)
 		{
-			fprintf(output, "culture = %s\n", i->c_str());
+			output.print("culture = %s\n", i->c_str());
 		}
-		fprintf(output, "religion = %s\n", religion.c_str());
-		fprintf(output, "government = %s\n", government.c_str());
-		fprintf(output, "plurality=%f\n", plurality);
-		fprintf(output, "nationalvalue=%s\n", nationalValue.c_str());
-		fprintf(output, "literacy=%f\n", literacy);
+		output.print("religion = %s\n", religion.c_str());
+		output.print("government = %s\n", government.c_str());
+		output.print("plurality=%f\n", plurality);
+		output.print("nationalvalue=%s\n", nationalValue.c_str());
+		output.print("literacy=%f\n", literacy);
 		if (civilized)
 		{
-			fprintf(output, "civilized=yes\n");
+			output.print("civilized=yes\n");
 		}
 		if (!isReleasableVassal)
 		{
-			fprintf(output, "is_releasable_vassal=no\n");
-		}
-		fprintf(output, "\n");
-		fprintf(output, "ruling_party=%s\n", rulingParty.c_str());
-		fprintf(output, "upper_house=\n");
-		fprintf(output, "{\n");
-		fprintf(output, "	fascist = 0\n");
-		fprintf(output, "	liberal = %d\n", upperHouseLiberal);
-		fprintf(output, "	conservative = %d\n", upperHouseConservative);
-		fprintf(output, "	reactionary = %d\n", upperHouseReactionary);
-		fprintf(output, "	anarcho_liberal = 0\n");
-		fprintf(output, "	socialist = 0\n");
-		fprintf(output, "	communist = 0\n");
-		fprintf(output, "}\n");
-		fprintf(output, "\n");
-		fprintf(output, "# Starting Consciousness\n");
-		fprintf(output, "consciousness = 0\n");
-		fprintf(output, "nonstate_consciousness = 0\n");
-		fprintf(output, "\n");
+			output.print("is_releasable_vassal=no\n");
+		}
+		output.print("\n");
+		output.print("ruling_party=%s\n", rulingParty.c_str());
+		output.print("upper_house=\n");
+		output.print("{\n");
+		output.print("	fascist = 0\n");
+		output.print("	liberal = %d\n", upperHouseLiberal);
+		output.print("	conservative = %d\n", upperHouseConservative);
+		output.print("	reactionary = %d\n", upperHouseReactionary);
+		output.print("	anarcho_liberal = 0\n");
+		output.print("	socialist = 0\n");
+		output.print("	communist = 0\n");
+		output.print("}\n");
+		output.print("\n");
+		output.print("# Starting Consciousness\n");
+		output.print("consciousness = 0\n");
+		output.print("nonstate_consciousness = 0\n");
+		output.print("\n");
 		outputTech(output);
 		if (!civilized)
 		{
@@ -227,29 +223,29 @@ void V2Country::output() const
 				uncivReforms->output(output);
 			}
 		}
-		fprintf(output, "prestige=%f\n", prestige);
+		output.print("prestige=%f\n", prestige);
 
 		if (!decisions.empty())
 		{
-			fprintf(output, "\n");
-			fprintf(output, "# Decisions\n");
-			fprintf(output, "1835.1.1 = {\n");
+			output.print("\n");
+			output.print("# Decisions\n");
+			output.print("1835.1.1 = {\n");
 			for (const auto& decision : decisions)
 			{
-				fprintf(output, "\tdecision = %s\n", decision.c_str());
+				output.print("\tdecision = %s\n", decision.c_str());
 			}
-			fprintf(output, "}\n");
+			output.print("}\n");
 		}
 
-		fprintf(output, "\n");
-		fprintf(output, "# Social Reforms\n");
-		fprintf(output, "wage_reform = no_minimum_wage\n");
-		fprintf(output, "work_hours = no_work_hour_limit\n");
-		fprintf(output, "safety_regulations = no_safety\n");
-		fprintf(output, "health_care = no_health_care\n");
-		fprintf(output, "unemployment_subsidies = no_subsidies\n");
-		fprintf(output, "pensions = no_pensions\n");
-		fprintf(output, "school_reforms = no_schools\n");
+		output.print("\n");
+		output.print("# Social Reforms\n");
+		output.print("wage_reform = no_minimum_wage\n");
+		output.print("work_hours = no_work_hour_limit\n");
+		output.print("safety_regulations = no_safety\n");
+		output.print("health_care = no_health_care\n");
+		output.print("unemployment_subsidies = no_subsidies\n");
+		output.print("pensions = no_pensions\n");
+		output.print("school_reforms = no_schools\n");
 
 		if (reforms != NULL)
 		{
@@ -257,31 +253,31 @@ void V2Country::output() const
 		}
 		else
 		{
-			fprintf(output, "# Political Reforms\n");
-			fprintf(output, "slavery=yes_slavery\n");
-			fprintf(output, "vote_franschise=none_voting\n");
-			fprintf(output, "upper_house_composition=appointed\n");
-			fprintf(output, "voting_system=jefferson_method\n");
-			fprintf(output, "public_meetings=yes_meeting\n");
-			fprintf(output, "press_rights=censored_press\n");
-			fprintf(output, "trade_unions=no_trade_unions\n");
-			fprintf(output, "political_parties=underground_parties\n");
+			output.print("# Political Reforms\n");
+			output.print("slavery=yes_slavery\n");
+			output.print("vote_franschise=none_voting\n");
+			output.print("upper_house_composition=appointed\n");
+			output.print("voting_system=jefferson_method\n");
+			output.print("public_meetings=yes_meeting\n");
+			output.print("press_rights=censored_press\n");
+			output.print("trade_unions=no_trade_unions\n");
+			output.print("political_parties=underground_parties\n");
 		}
 	
-		//fprintf(output, "	schools=\"%s\"\n", techSchool.c_str());
+		//output.print("	schools=\"%s\"\n", techSchool.c_str());
 
-		fprintf(output, "oob = \"%s\"\n", (tag + "_OOB.txt").c_str());
+		output.print("oob = \"%s\"\n", (tag + "_OOB.txt").c_str());
 
 		if (holyRomanEmperor)
 		{
-			fprintf(output, "set_country_flag = emperor_hre\n");
+			output.print("set_country_flag = emperor_hre\n");
 		}
 		else if (inHRE)
 		{
-			fprintf(output, "set_country_flag = member_hre\n");
+			output.print("set_country_flag = member_hre\n");
 		}
 
-		fclose(output);
+		output.close();
 
 		outputOOB();
 	}
@@ -289,12 +285,7 @@ void V2Country::output() const
 	if (newCountry)
 	{
 		// Output common country file. 
-		std::ofstream commonCountryOutput("Output/" + Configuration::getOutputName() + "/common/countries/" + commonCountryFile);
-		if (!commonCountryOutput.is_open())
-		{
-			LOG(LogLevel::Error) << "Could not open Output/" + Configuration::getOutputName() + "/common/countries/" + commonCountryFile;
-			exit(-1);
-		}
+		OutputFile commonCountryOutput("output/" + Configuration::getOutputName() + "/common/countries/" + commonCountryFile);
 		commonCountryOutput << "graphical_culture = UsGC\n";	// default to US graphics
 		commonCountryOutput << "color = { " << color << " }\n";
 		for (auto party : parties)
@@ -316,9 +307,9 @@ void V2Country::output() const
 }
 
 
-void V2Country::outputToCommonCountriesFile(FILE* output) const
+void V2Country::outputToCommonCountriesFile(OutputFile& output) const
 {
-	fprintf(output, "%s = \"countries%s\"\n", tag.c_str(), commonCountryFile.c_str());
+	output.print("%s = \"countries%s\"\n", tag.c_str(), commonCountryFile.c_str());
 }
 
 
@@ -331,66 +322,51 @@ void V2Country::outputLocalisation(FILE* output) const
 }
 
 
-void V2Country::outputTech(FILE* output) const
+void V2Country::outputTech(OutputFile& output) const
 {
-	fprintf(output, "\n");
-	fprintf(output, "# Technologies\n");
+	output.print("\n");
+	output.print("# Technologies\n");
 	for (vector<string>::const_iterator itr = techs.begin(); itr != techs.end(); ++itr)
 	{
-		fprintf(output, itr->c_str()); fprintf(output, " = 1\n");
+		output.print(itr->c_str()); output.print(" = 1\n");
 	}
 }
 
 
-void V2Country::outputElection(FILE* output) const
+void V2Country::outputElection(OutputFile& output) const
 {
-	date electionDate = date("1836.1.1");
-
-	if (electionDate.month == 12)
-	{
-		electionDate.month = 1;
-		electionDate.year++;
-	}
-	else
-	{
-		electionDate.month++;
-	}
-	electionDate.year -= 4;
-	fprintf(output, "	last_election=%s\n", electionDate.toString().c_str());
+	date electionDate = date(1836, 1, 1);
+	electionDate.addMonths(1);
+	electionDate.addYears(-4);
+	output.print("	last_election=%s\n", electionDate.toString().c_str());
 }
 
 
 void V2Country::outputOOB() const
 {
-	FILE* output;
-	if (fopen_s(&output, ("Output/" + Configuration::getOutputName() + "/history/units/" + tag + "_OOB.txt").c_str(), "w") != 0)
-	{
-		LOG(LogLevel::Error) << "Could not create OOB file " << (tag + "_OOB.txt");
-		exit(-1);
-	}
+	OutputFile output("output/" + Configuration::getOutputName() + "/history/units/" + tag + "_OOB.txt");
 
-	fprintf(output, "#Sphere of Influence\n");
-	fprintf(output, "\n");
+	output.print("#Sphere of Influence\n");
+	output.print("\n");
 	for (map<string, V2Relations*>::const_iterator relationsItr = relations.begin(); relationsItr != relations.end(); relationsItr++)
 	{
 		relationsItr->second->output(output);
 	}
 
-	fprintf(output, "\n");
-	fprintf(output, "#Leaders\n");
+	output.print("\n");
+	output.print("#Leaders\n");
 	for (vector<V2Leader*>::const_iterator itr = leaders.begin(); itr != leaders.end(); ++itr)
 	{
 		(*itr)->output(output);
 	}
 
-	fprintf(output, "\n");
-	fprintf(output, "#Armies\n");
+	output.print("\n");
+	output.print("#Armies\n");
 	for (vector<V2Army*>::const_iterator itr = armies.begin(); itr != armies.end(); ++itr)
 	{
 		(*itr)->output(output);
 	}
 
-	fclose(output);
 }
 
 
@@ -425,7 +401,7 @@ void V2Country::initFromEU4Country(EU4Country* _srcCountry, vector<V2TechSchool>
 
 	// Capital
 	int oldCapital = srcCountry->getCapital();
-	auto potentialCapitals = provinceMapper::getVic2ProvinceNumbers(oldCapital);
+	const auto& potentialCapitals = provinceMapper::getVic2ProvinceNumbers(oldCapital);
 	if (potentialCapitals.size() > 0)
 	{
 		capital = potentialCapitals[0];
@@ -449,7 +425,7 @@ void V2Country::initFromEU4Country(EU4Country* _srcCountry, vector<V2TechSchool>
 	string srcReligion = srcCountry->getReligion();
 	if (srcReligion.size() > 0)
 	{
-		religion = religionMapper::getVic2Religion(srcReligion);
+		religion = religionMapper::getVic2Religion(Symbol(srcReligion)).str();
 		if (religion == "")
 		{
 			LOG(LogLevel::Warning) << "No religion mapping defined for " << srcReligion << " (" << _srcCountry->getTag() << " -> " << tag << ')';
@@ -461,7 +437,12 @@ void V2Country::initFromEU4Country(EU4Country* _srcCountry, vector<V2TechSchool>
 
 	if (srcCulture.size() > 0)
 	{
-		bool matched = cultureMapper::cultureMatch(srcCulture, primaryCulture, religion, oldCapital, srcCountry->getTag());
+		Symbol dstCulture;
+		bool matched = cultureMapper::cultureMatch(Symbol(srcCulture), dstCulture, Symbol(religion), oldCapital, srcCountry->getTag());
+		if (matched)
+		{
+			primaryCulture = dstCulture.str();
+		}
 		if (!matched)
 		{
 			LOG(LogLevel::Warning) << "No culture mapping defined for " << srcCulture << " (" << srcCountry->getTag() << " -> " << tag << ')';
@@ -479,13 +460,13 @@ void V2Country::initFromEU4Country(EU4Country* _srcCountry, vector<V2TechSchool>
 	}
 	for (auto srcCulture: srcAceptedCultures)
 	{
-		string dstCulture;
-		bool matched = cultureMapper::cultureMatch(srcCulture, dstCulture, religion, oldCapital, srcCountry->getTag());
+		Symbol dstCulture;
+		bool matched = cultureMapper::cultureMatch(Symbol(srcCulture), dstCulture, Symbol(religion), oldCapital, srcCountry->getTag());
 		if (matched)
 		{
-			if (primaryCulture != dstCulture)
+			if (primaryCulture != dstCulture.str())
 			{
-				acceptedCultures.insert(dstCulture);
+				acceptedCultures.insert(dstCulture.str());
 			}
 		}
 		if (!matched)
@@ -528,7 +509,7 @@ void V2Country::initFromEU4Country(EU4Country* _srcCountry, vector<V2TechSchool>
 	}
 	for (vector<V2Party*>::iterator i = parties.begin(); i != parties.end(); i++)
 	{
-		if ((*i)->isActiveOn(date("1836.1.1")) && ((*i)->ideology == idealogy))
+		if ((*i)->isActiveOn(date(1836, 1, 1)) && ((*i)->ideology == idealogy))
 		{
 			rulingParty = (*i)->name;
 			break;
@@ -2003,11 +1984,14 @@ bool ProvinceRegimentCapacityPredicate(V2Province* prov1, V2Province* prov2)
 
 V2Province* V2Country::getProvinceForExpeditionaryArmy()
 {
+	static const Symbol soldiers("soldiers");
+	const Symbol culture(primaryCulture);
+
 	vector<V2Province*> candidates;
 	for (auto pitr = provinces.begin(); pitr != provinces.end(); ++pitr)
 	{
 		if ( (pitr->second->getOwner() == tag) && !pitr->second->wasColony() && !pitr->second->wasInfidelConquest()
-			&& ( pitr->second->hasCulture(primaryCulture, 0.5) ) && ( pitr->second->getPops("soldiers").size() > 0) )
+			&& ( pitr->second->hasCulture(culture, 0.5) ) && ( pitr->second->getPops(soldiers).size() > 0) )
 		{
 			candidates.push_back(pitr->second);
 		}
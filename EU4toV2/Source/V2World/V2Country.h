@@ -28,7 +28,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 #include "../Color.h"
 #include "Date.h"
-#include "../Eu4World/EU4Army.h"
+#include "../EU4World/EU4Army.h"
 #include "V2Inventions.h"
 #include "V2Localisation.h"
 #include "V2TechSchools.h"
@@ -38,6 +38,7 @@ using namespace std;
 
 class EU4World;
 class EU4Country;
+class OutputFile;
 class V2World;
 class V2State;
 class V2Province;
@@ -58,7 +59,7 @@ class V2Country
 	public:
 		V2Country(string _tag, string _commonCountryFile, vector<V2Party*> _parties, V2World* _theWorld, bool _newCountry = false, bool _dynamicCountry = false);
 		void								output() const;
-		void								outputToCommonCountriesFile(FILE*) const;
+		void								outputToCommonCountriesFile(OutputFile&) const;
 		void								outputLocalisation(FILE*) const;
 		void								outputOOB() const;
 		void								initFromEU4Country(EU4Country* _srcCountry, vector<V2TechSchool> techSchools, const map<int, int>& leaderMap, const V2LeaderTraits& lt);
@@ -115,8 +116,8 @@ class V2Country
 		string							getReligion() const { return religion; }
 
 	private:
-		void			outputTech(FILE*) const ;
-		void			outputElection(FILE*) const;
+		void			outputTech(OutputFile&) const ;
+		void			outputElection(OutputFile&) const;
 		void			addLoan(string creditor, double size, double interest);
 		int			addRegimentToArmy(V2Army* army, RegimentCategory rc, map<int, V2Province*> allProvinces);
 		vector<int>	getPortProvinces(vector<int> locationCandidates, map<int, V2Province*> allProvinces);
@@ -24,6 +24,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 #include "V2Factory.h"
 #include "ParadoxParser8859_15.h"
 #include "Log.h"
+#include "OutputWriter.h"
 #include "../Configuration.h"
 
 
@@ -76,15 +77,15 @@ V2FactoryType::V2FactoryType(Object* factory)
 }
 
 
-void V2Factory::output(FILE* output) const
+void V2Factory::output(OutputFile& output) const
 {
 	// V2 takes care of hiring employees on day 1, provided sufficient starting capital
-	fprintf(output, "state_building=\n");
-	fprintf(output, "{\n");
-	fprintf(output, "\tlevel=%d\n", level);
-	fprintf(output, "\tbuilding = %s\n", type->name.c_str());
-	fprintf(output, "\tupgrade = yes\n");
-	fprintf(output, "}\n");
+	output.print("state_building=\n");
+	output.print("{\n");
+	output.print("\tlevel=%d\n", level);
+	output.print("\tbuilding = %s\n", type->name.c_str());
+	output.print("\tupgrade = yes\n");
+	output.print("}\n");
 }
 
 
@@ -33,6 +33,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 using namespace std;
 
 class Object;
+class OutputFile;
 
 
 
@@ -56,7 +57,7 @@ class V2Factory
 {
 	public:
 		V2Factory(const V2FactoryType* _type) : type(_type) { level = 1; };
-		void					output(FILE* output) const;
+		void					output(OutputFile& output) const;
 		map<string,float>	getRequiredRGO() const;
 		void					increaseLevel();
 
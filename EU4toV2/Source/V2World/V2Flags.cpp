@@ -297,7 +297,7 @@ bool V2Flags::Output() const
 	LOG(LogLevel::Debug) << "Copying flags";
 
 	// Create output folders.
-	std::string outputGraphicsFolder = "Output/" + Configuration::getOutputName() + "/gfx";
+	std::string outputGraphicsFolder = "output/" + Configuration::getOutputName() + "/gfx";
 	std::string outputFlagFolder = outputGraphicsFolder + "/flags";
 
 	//Utils::DeleteFolder(outputFlagFolder); 
@@ -25,6 +25,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 #include "V2LeaderTraits.h"
 #include "V2Country.h"
 #include "../EU4World/EU4Leader.h"
+#include "OutputWriter.h"
 
 
 
@@ -38,21 +39,21 @@ V2Leader::V2Leader(const EU4Leader* oldLeader, const V2LeaderTraits& traits)
 }
 
 
-void V2Leader::output(FILE *output) const
+void V2Leader::output(OutputFile& output) const
 {
-	fprintf(output, "leader = {\n");
-	fprintf(output, "\tname=\"%s\"\n", name.c_str());
-	fprintf(output, "\tdate=\"%s\"\n", activationDate.toString().c_str());
+	output.print("leader = {\n");
+	output.print("\tname=\"%s\"\n", name.c_str());
+	output.print("\tdate=\"%s\"\n", activationDate.toString().c_str());
 	if (isLand)
 	{
-		fprintf(output, "\ttype=land\n");
+		output.print("\ttype=land\n");
 	}
 	else
 	{
-		fprintf(output, "\ttype=sea\n");
+		output.print("\ttype=sea\n");
 	}
-	fprintf(output, "\tpersonality=\"%s\"\n", personality.c_str());
-	fprintf(output, "\tbackground=\"%s\"\n", background.c_str());
-	fprintf(output, "}\n");
-	fprintf(output, "\n");
+	output.print("\tpersonality=\"%s\"\n", personality.c_str());
+	output.print("\tbackground=\"%s\"\n", background.c_str());
+	output.print("}\n");
+	output.print("\n");
 }
@@ -26,11 +26,12 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 
 
-#include "date.h"
+#include "Date.h"
 #include <string>
 using namespace std;
 
 class EU4Leader;
+class OutputFile;
 class V2Country;
 class V2LeaderTraits;
 
@@ -40,7 +41,7 @@ class V2Leader
 {
 	public:
 		V2Leader(const EU4Leader* oldLeader, const V2LeaderTraits& traits);
-		void output(FILE* output) const;
+		void output(OutputFile& output) const;
 	private:
 		string	name;
 		date		activationDate;
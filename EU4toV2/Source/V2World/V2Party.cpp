@@ -45,8 +45,8 @@ V2Party::V2Party(const std::string& name, const std::string& ideology)
 {
 	if (ideology == "conservative")
 	{
-		start_date = date("1820.1.1");
-		end_date = date("2000.1.1");
+		start_date = date(1820, 1, 1);
+		end_date = date(2000, 1, 1);
 		economic_policy = "interventionism";
 		trade_policy = "protectionism";
 		religious_policy = "moralism";
@@ -55,8 +55,8 @@ V2Party::V2Party(const std::string& name, const std::string& ideology)
 	}
 	else if (ideology == "liberal")
 	{
-		start_date = date("1820.1.1");
-		end_date = date("2000.1.1");
+		start_date = date(1820, 1, 1);
+		end_date = date(2000, 1, 1);
 		economic_policy = "laissez_faire";
 		trade_policy = "free_trade";
 		religious_policy = "pluralism";
@@ -65,8 +65,8 @@ V2Party::V2Party(const std::string& name, const std::string& ideology)
 	}
 	else if (ideology == "reactionary")
 	{
-		start_date = date("1820.1.1");
-		end_date = date("2000.1.1");
+		start_date = date(1820, 1, 1);
+		end_date = date(2000, 1, 1);
 		economic_policy = "state_capitalism";
 		trade_policy = "protectionism";
 		religious_policy = "moralism";
@@ -75,8 +75,8 @@ V2Party::V2Party(const std::string& name, const std::string& ideology)
 	}
 	else if (ideology == "socialist")
 	{
-		start_date = date("1849.1.1");
-		end_date = date("2000.1.1");
+		start_date = date(1849, 1, 1);
+		end_date = date(2000, 1, 1);
 		economic_policy = "state_capitalism";
 		trade_policy = "free_trade";
 		religious_policy = "secularized";
@@ -85,8 +85,8 @@ V2Party::V2Party(const std::string& name, const std::string& ideology)
 	}
 	else if (ideology == "communist")
 	{
-		start_date = date("1849.1.1");
-		end_date = date("2000.1.1");
+		start_date = date(1849, 1, 1);
+		end_date = date(2000, 1, 1);
 		economic_policy = "planned_economy";
 		trade_policy = "protectionism";
 		religious_policy = "pro_atheism";
@@ -95,8 +95,8 @@ V2Party::V2Party(const std::string& name, const std::string& ideology)
 	}
 	else if (ideology == "anarcho_liberal")
 	{
-		start_date = date("1830.1.1");
-		end_date = date("2000.1.1");
+		start_date = date(1830, 1, 1);
+		end_date = date(2000, 1, 1);
 		economic_policy = "laissez_faire";
 		trade_policy = "free_trade";
 		religious_policy = "pro_atheism";
@@ -105,8 +105,8 @@ V2Party::V2Party(const std::string& name, const std::string& ideology)
 	}
 	else if (ideology == "fascist")
 	{
-		start_date = date("1905.1.1");
-		end_date = date("2000.1.1");
+		start_date = date(1905, 1, 1);
+		end_date = date(2000, 1, 1);
 		economic_policy = "state_capitalism";
 		trade_policy = "protectionism";
 		religious_policy = "moralism";
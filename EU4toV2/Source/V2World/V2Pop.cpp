@@ -23,10 +23,11 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 #include "V2Pop.h"
 #include "Log.h"
+#include "OutputWriter.h"
 
 
 
-V2Pop::V2Pop(string _type, int _size, string _culture, string _religion)
+V2Pop::V2Pop(Symbol _type, int _size, Symbol _culture, Symbol _religion)
 {
 	type						= _type;
 	size						= _size;
@@ -36,16 +37,16 @@ V2Pop::V2Pop(string _type, int _size, string _culture, string _religion)
 }
 
 
-void V2Pop::output(FILE* output) const
+void V2Pop::output(OutputFile& output) const
 {
 	if (size > 0)
 	{
-		fprintf(output, "\t%s=\n", type.c_str());
-		fprintf(output, "\t{\n");
-		fprintf(output, "\t\tculture = %s\n", culture.c_str());
-		fprintf(output, "\t\treligion = %s\n", religion.c_str());
-		fprintf(output, "\t\tsize=%d\n", size);
-		fprintf(output, "\t}\n");
+		output.print("\t%s=\n", type.c_str());
+		output.print("\t{\n");
+		output.print("\t\tculture = %s\n", culture.c_str());
+		output.print("\t\treligion = %s\n", religion.c_str());
+		output.print("\t\tsize=%d\n", size);
+		output.print("\t}\n");
 	}
 }
 
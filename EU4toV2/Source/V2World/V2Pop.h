@@ -28,33 +28,36 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 #include <string>
 #include <vector>
+#include "Symbol.h"
 using namespace std;
 
+class OutputFile;
+
 
 
 class V2Pop
 {
 	public:
-		V2Pop(string type, int size, string culture, string religion);
-		void output(FILE*) const;
+		V2Pop(Symbol type, int size, Symbol culture, Symbol religion);
+		void output(OutputFile&) const;
 		bool combine(const V2Pop& rhs);
 
 		void	changeSize(int delta)					{ size += delta; }
 		void	incrementSupportedRegimentCount()	{ supportedRegiments++; }
-		void	setCulture(string _culture)			{ culture = _culture; }
-		void	setReligion(string _religion)			{ religion = _religion; }
+		void	setCulture(Symbol _culture)			{ culture = _culture; }
+		void	setReligion(Symbol _religion)			{ religion = _religion; }
 
 		int		getSize()							const	{ return size; }
-		string	getType()							const	{ return type; }
-		string	getCulture()						const	{ return culture; }
-		string	getReligion()						const	{ return religion; }
+		Symbol	getType()							const	{ return type; }
+		Symbol	getCulture()						const	{ return culture; }
+		Symbol	getReligion()						const	{ return religion; }
 		int		getSupportedRegimentCount()	const	{ return supportedRegiments; }
 
 	private:
-		string	type;
+		Symbol	type;
 		int		size;
-		string	culture;
-		string	religion;
+		Symbol	culture;
+		Symbol	religion;
 		int		supportedRegiments;
 };
 
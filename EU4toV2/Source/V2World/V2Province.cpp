@@ -26,7 +26,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 #include "Log.h"
 #include "Object.h"
 #include "OSCompatibilityLayer.h"
-#include "ParadoxParser8859_15.h"
+#include "OutputWriter.h"
 #include "../EU4World/EU4World.h"
 #include "../EU4World/EU4Province.h"
 #include "V2Pop.h"
@@ -35,11 +35,12 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 #include <sstream>
 #include <algorithm>
 #include <stdio.h>
+#include <unordered_map>
 using namespace std;
 
 
 
-V2Province::V2Province(string _filename)
+V2Province::V2Province(string _filename, const Object* obj)
 {
 	srcProvince			= NULL;
 	filename				= _filename;
@@ -83,25 +84,6 @@ V2Province::V2Province(string _filename)
 	string temp		= filename.substr(slash + 1, numDigits);
 	num				= atoi(temp.c_str());
 
-	Object* obj;
-	if (Utils::DoesFileExist(string("./blankMod/output/history/provinces") + _filename))
-	{
-		obj = parser_8859_15::doParseFile((string("./blankMod/output/history/provinces") + _filename).c_str());
-		if (obj == NULL)
-		{
-			LOG(LogLevel::Error) << "Could not parse ./blankMod/output/history/provinces" << _filename;
-			exit(-1);
-		}
-	}
-	else
-	{
-		obj = parser_8859_15::doParseFile((Configuration::getV2Path() + "/history/provinces" + _filename).c_str());
-		if (obj == NULL)
-		{
-			LOG(LogLevel::Error) << "Could not parse " << Configuration::getV2Path() << "/history/provinces" << _filename;
-			exit(-1);
-		}
-	}
 	vector<Object*> leaves = obj->getLeaves();
 	for (vector<Object*>::iterator itr = leaves.begin(); itr != leaves.end(); itr++)
 	{
@@ -172,60 +154,51 @@ V2Province::V2Province(string _filename)
 
 void V2Province::output() const
 {
-	FILE* output;
-	if (fopen_s(&output, ("Output/" + Configuration::getOutputName() + "/history/provinces/" + filename).c_str(), "w") != 0)
-	{
-		int errNum;
-		_get_errno(&errNum);
-		char errStr[256];
-		strerror_s(errStr, sizeof(errStr), errNum);
-		LOG(LogLevel::Error) << "Could not create province history file Output/" << Configuration::getOutputName() << "/history/provinces/" << filename << " - " << errStr;
-		exit(-1);
-	}
+	OutputFile output("output/" + Configuration::getOutputName() + "/history/provinces/" + filename);
 	if (owner != "")
 	{
-		fprintf_s(output, "owner=%s\n", owner.c_str());
-		fprintf_s(output, "controller=%s\n", owner.c_str());
+		output.print("owner=%s\n", owner.c_str());
+		output.print("controller=%s\n", owner.c_str());
 	}
 	for (unsigned int i = 0; i < cores.size(); i++)
 	{
-		fprintf_s(output, "add_core=%s\n", cores[i].c_str());
+		output.print("add_core=%s\n", cores[i].c_str());
 	}
 	if (inHRE)
 	{
-		fprintf_s(output, "add_core=HRE\n");
+		output.print("add_core=HRE\n");
 	}
 	if(rgoType != "")
 	{
-		fprintf_s(output, "trade_goods = %s\n", rgoType.c_str());
+		output.print("trade_goods = %s\n", rgoType.c_str());
 	}
 	if (lifeRating > 0)
 	{
-		fprintf_s(output, "life_rating = %d\n", lifeRating);
+		output.print("life_rating = %d\n", lifeRating);
 	}
 	if (terrain != "")
 	{
-		fprintf_s(output, "terrain = %s\n", terrain.c_str());
+		output.print("terrain = %s\n", terrain.c_str());
 	}
 	if (colonial > 0)
 	{
-		fprintf(output, "colonial=%d\n", colonial);
+		output.print("colonial=%d\n", colonial);
 	}
 	if (navalBaseLevel > 0)
 	{
-		fprintf_s(output, "naval_base = %d\n", navalBaseLevel);
+		output.print("naval_base = %d\n", navalBaseLevel);
 	}
 	if (fortLevel > 0)
 	{
-		fprintf_s(output, "fort = %d\n", fortLevel);
+		output.print("fort = %d\n", fortLevel);
 	}
 	if (railLevel > 0)
 	{
-		fprintf_s(output, "railroad = %d\n", railLevel);
+		output.print("railroad = %d\n", railLevel);
 	}
 	if (slaveState)
 	{
-		fprintf_s(output, "is_slave = yes\n");
+		output.print("is_slave = yes\n");
 	}
 	for (auto itr = factories.begin(); itr != factories.end(); itr++)
 	{
@@ -234,46 +207,45 @@ void V2Province::output() const
 	/*else if ((*itr)->getKey() == "party_loyalty")
 	{
 	}*/
-	fclose(output);
 }
 
 
-void V2Province::outputPops(FILE* output) const
+void V2Province::outputPops(OutputFile& output) const
 {
 	if (resettable && (Configuration::getResetProvinces() == "yes"))
 	{
-		fprintf(output, "%d = {\n", num);
+		output.print("%d = {\n", num);
 		if (oldPops.size() > 0)
 		{
 			for (unsigned int i = 0; i < oldPops.size(); i++)
 			{
 				oldPops[i]->output(output);
-				fprintf(output, "\n");
+				output.print("\n");
 			}
-			fprintf(output, "}\n");
+			output.print("}\n");
 		}
 	}
 	else
 	{
 		if (pops.size() > 0)
 		{
-			fprintf(output, "%d = {\n", num);
+			output.print("%d = {\n", num);
 			for (auto i: pops)
 			{
 				i->output(output);
-				fprintf(output, "\n");
+				output.print("\n");
 			}
-			fprintf(output, "}\n");
+			output.print("}\n");
 		}
 		else if (oldPops.size() > 0)
 		{
-			fprintf(output, "%d = {\n", num);
+			output.print("%d = {\n", num);
 			for (unsigned int i = 0; i < oldPops.size(); i++)
 			{
 				oldPops[i]->output(output);
-				fprintf(output, "\n");
+				output.print("\n");
 			}
-			fprintf(output, "}\n");
+			output.print("}\n");
 		}
 	}
 }
@@ -292,7 +264,7 @@ static const int unitNameOffsets[num_reg_categories] =
 };
 
 
-void V2Province::outputUnits(FILE* output) const
+void V2Province::outputUnits(OutputFile& output) const
 {
 	// unit name counts are stored in an odd kind of variable-length sparse array.  try to emulate.
 	int outputUnitNameUntil = 0;
@@ -305,24 +277,24 @@ void V2Province::outputUnits(FILE* output) const
 	}
 	if (outputUnitNameUntil > 0)
 	{
-		fprintf(output, "\tunit_names=\n");
-		fprintf(output, "\t{\n");
-		fprintf(output, "\t\tdata=\n");
-		fprintf(output, "\t\t{\n");
+		output.print("\tunit_names=\n");
+		output.print("\t{\n");
+		output.print("\t\tdata=\n");
+		output.print("\t\t{\n");
 		for (int i = 1; i <= outputUnitNameUntil; ++i)
 		{
-			fprintf(output, "\t\t\t{\n");
+			output.print("\t\t\t{\n");
 			for (int j = 0; j < num_reg_categories; ++j)
 			{
 				if ((i == unitNameOffsets[j]) && unitNameCount[j] > 0)
 				{
-					fprintf(output, "\t\t\t\tcount=%d\n", unitNameCount[j]);
+					output.print("\t\t\t\tcount=%d\n", unitNameCount[j]);
 				}
 			}
-			fprintf(output, "\t\t\t}\n\n");
+			output.print("\t\t\t}\n\n");
 		}
-		fprintf(output, "\t\t}\n");
-		fprintf(output, "\t}\n");
+		output.print("\t\t}\n");
+		output.print("\t}\n");
 	}
 }
 
@@ -383,11 +355,11 @@ void V2Province::doCreatePops(double popWeightRatio, V2Country* _owner, int popC
 	combinePops();
 
 	// organize pops for adding minorities
-	map<string, int>					totals;
-	map<string, vector<V2Pop*>>	thePops;
+	unordered_map<Symbol, int>					totals;
+	unordered_map<Symbol, vector<V2Pop*>>	thePops;
 	for (auto popItr: pops)
 	{
-		string type = popItr->getType();
+		Symbol type = popItr->getType();
 
 		auto totalsItr = totals.find(type);
 		if (totalsItr == totals.end())
@@ -432,13 +404,13 @@ void V2Province::doCreatePops(double popWeightRatio, V2Country* _owner, int popC
 		{
 			for (auto popsItr: thePopsItr->second)
 			{
-				string newCulture		= minorityItr->getCulture();
-				string newReligion	= minorityItr->getReligion();
-				if (newCulture == "")
+				Symbol newCulture		= minorityItr->getCulture();
+				Symbol newReligion	= minorityItr->getReligion();
+				if (newCulture.empty())
 				{
 					newCulture = popsItr->getCulture();
 				}
-				if (newReligion == "")
+				if (newReligion.empty())
 				{
 					newReligion = popsItr->getReligion();
 				}
@@ -842,79 +814,91 @@ void V2Province::createPops(const V2Demographic& demographic, double popWeightRa
 		pts.bureaucrats -= 5;
 	}
 
-	int farmers = static_cast<int>(demographic.lowerRatio * newPopulation + 0.5);
+	static const Symbol slaves("slaves");
+	static const Symbol soldiers("soldiers");
+	static const Symbol craftsmen("craftsmen");
+	static const Symbol artisans("artisans");
+	static const Symbol clergymen("clergymen");
+	static const Symbol clerks("clerks");
+	static const Symbol bureaucrats("bureaucrats");
+	static const Symbol officers("officers");
+	static const Symbol capitalists("capitalists");
+	static const Symbol aristocrats("aristocrats");
+	static const Symbol farmers("farmers");
+
+	int farmersSize = static_cast<int>(demographic.lowerRatio * newPopulation + 0.5);
 	if (slaveProportion > 0.0)
 	{
 		int size = static_cast<int>(demographic.lowerRatio * newPopulation * slaveProportion);
-		farmers -= size;
-		V2Pop* slavesPop = new V2Pop("slaves", size,	demographic.slaveCulture, demographic.religion);
+		farmersSize -= size;
+		V2Pop* slavesPop = new V2Pop(slaves, size,	demographic.slaveCulture, demographic.religion);
 		pops.push_back(slavesPop);
 	}
 	if (pts.soldiers > 0)
 	{
 		int size = static_cast<int>(demographic.lowerRatio * newPopulation * (pts.soldiers / 10000) + 0.5);
-		farmers -= size;
-		V2Pop* soldiersPop = new V2Pop("soldiers", size, demographic.culture, demographic.religion);
+		farmersSize -= size;
+		V2Pop* soldiersPop = new V2Pop(soldiers, size, demographic.culture, demographic.religion);
 		pops.push_back(soldiersPop);
 	}
 	if (pts.craftsmen > 0)
 	{
 		int size = static_cast<int>(demographic.lowerRatio * newPopulation * (pts.craftsmen / 10000) + 0.5);
-		farmers -= size;
-		V2Pop* craftsmenPop = new V2Pop("craftsmen", size,	demographic.culture, demographic.religion);
+		farmersSize -= size;
+		V2Pop* craftsmenPop = new V2Pop(craftsmen, size,	demographic.culture, demographic.religion);
 		pops.push_back(craftsmenPop);
 	}
 	if (pts.artisans > 0)
 	{
 		int size = static_cast<int>(demographic.middleRatio * newPopulation * (pts.artisans / 10000) + 0.5);
-		farmers -= size;
-		V2Pop* artisansPop = new V2Pop("artisans", size, demographic.culture, demographic.religion);
+		farmersSize -= size;
+		V2Pop* artisansPop = new V2Pop(artisans, size, demographic.culture, demographic.religion);
 		pops.push_back(artisansPop);
 	}
 	if (pts.clergymen > 0)
 	{
 		int size = static_cast<int>(demographic.middleRatio * newPopulation * (pts.clergymen / 10000) + 0.5);
-		farmers -= size;
-		V2Pop* clergymenPop = new V2Pop("clergymen", size,	demographic.culture, demographic.religion);
+		farmersSize -= size;
+		V2Pop* clergymenPop = new V2Pop(clergymen, size,	demographic.culture, demographic.religion);
 		pops.push_back(clergymenPop);
 	}
 	if (pts.clerks > 0)
 	{
 		int size = static_cast<int>(demographic.middleRatio * newPopulation * (pts.clerks / 10000) + 0.5);
-		farmers -= size;
-		V2Pop* clerksPop = new V2Pop("clerks", size,	demographic.culture, demographic.religion);
+		farmersSize -= size;
+		V2Pop* clerksPop = new V2Pop(clerks, size,	demographic.culture, demographic.religion);
 		pops.push_back(clerksPop);
 	}
 	if (pts.bureaucrats > 0)
 	{
 		int size = static_cast<int>(demographic.middleRatio * newPopulation * (pts.bureaucrats / 10000) + 0.5);
-		farmers -= size;
-		V2Pop* bureaucratsPop = new V2Pop("bureaucrats", size, demographic.culture, demographic.religion);
+		farmersSize -= size;
+		V2Pop* bureaucratsPop = new V2Pop(bureaucrats, size, demographic.culture, demographic.religion);
 		pops.push_back(bureaucratsPop);
 	}
 	if (pts.officers > 0)
 	{
 		int size = static_cast<int>(demographic.middleRatio * newPopulation * (pts.officers / 10000) + 0.5);
-		farmers -= size;
-		V2Pop* officersPop = new V2Pop("officers", size, demographic.culture, demographic.religion);
+		farmersSize -= size;
+		V2Pop* officersPop = new V2Pop(officers, size, demographic.culture, demographic.religion);
 		pops.push_back(officersPop);
 	}
 	if (pts.capitalists > 0)
 	{
 		int size = static_cast<int>(demographic.upperRatio * newPopulation * (pts.capitalists / 10000) + 0.5);
-		farmers -= size;
-		V2Pop* capitalistsPop = new V2Pop("capitalists", size, demographic.culture, demographic.religion);
+		farmersSize -= size;
+		V2Pop* capitalistsPop = new V2Pop(capitalists, size, demographic.culture, demographic.religion);
 		pops.push_back(capitalistsPop);
 	}
 	if (pts.aristocrats > 0)
 	{
 		int size = static_cast<int>(demographic.upperRatio * newPopulation * (pts.aristocrats / 10000) + 0.5);
-		farmers -= size;
-		V2Pop* aristocratsPop = new V2Pop("aristocrats", size, demographic.culture, demographic.religion);
+		farmersSize -= size;
+		V2Pop* aristocratsPop = new V2Pop(aristocrats, size, demographic.culture, demographic.religion);
 		pops.push_back(aristocratsPop);
 	}
 
-	V2Pop* farmersPop = new V2Pop("farmers", farmers, demographic.culture, demographic.religion);
+	V2Pop* farmersPop = new V2Pop(farmers, farmersSize, demographic.culture, demographic.religion);
 	pops.push_back(farmersPop);
 
 	/*LOG(LogLevel::Info) << "Name: " << this->getSrcProvince()->getProvName() << " demographics.upperRatio: " << demographic.upperRatio 
@@ -1007,12 +991,12 @@ int V2Province::getTotalPopulation() const
 }
 
 
-vector<V2Pop*> V2Province::getPops(string type) const
+vector<V2Pop*> V2Province::getPops(Symbol type) const
 {
 	vector<V2Pop*> retval;
 	for (vector<V2Pop*>::const_iterator itr = pops.begin(); itr != pops.end(); ++itr)
 	{
-		if (type == "*" || (*itr)->getType() == type)
+		if ((*itr)->getType() == type)
 			retval.push_back(*itr);
 	}
 	return retval;
@@ -1037,7 +1021,9 @@ static int getRequiredPopForRegimentCount(int count)
 // pick a soldier pop to use for an army.  prefer larger pops to smaller ones, and grow only if necessary.
 V2Pop* V2Province::getSoldierPopForArmy(bool force)
 {
-	vector<V2Pop*> spops = getPops("soldiers");
+	static const Symbol soldiers("soldiers");
+
+	vector<V2Pop*> spops = getPops(soldiers);
 	if (spops.size() == 0)
 		return NULL; // no soldier pops
 
@@ -1077,6 +1063,9 @@ V2Pop* V2Province::getSoldierPopForArmy(bool force)
 
 bool V2Province::growSoldierPop(V2Pop* pop)
 {
+	static const Symbol farmers("farmers");
+	static const Symbol labourers("labourers");
+
 	int growBy = getRequiredPopForRegimentCount(pop->getSupportedRegimentCount() + 1) - pop->getSize();
 	if (growBy > 0)
 	{
@@ -1085,7 +1074,7 @@ bool V2Province::growSoldierPop(V2Pop* pop)
 		bool foundSourcePop = false;
 		for (vector<V2Pop*>::iterator isrc = pops.begin(); isrc != pops.end(); ++isrc)
 		{
-			if ( (*isrc)->getType() == "farmers" || (*isrc)->getType() == "labourers" )
+			if ( (*isrc)->getType() == farmers || (*isrc)->getType() == labourers )
 			{
 				if ( (*isrc)->getCulture() == pop->getCulture() && (*isrc)->getReligion() == pop->getReligion() )
 				{
@@ -1112,17 +1101,21 @@ bool V2Province::growSoldierPop(V2Pop* pop)
 
 pair<int, int> V2Province::getAvailableSoldierCapacity() const
 {
+	static const Symbol soldiers("soldiers");
+	static const Symbol farmers("farmers");
+	static const Symbol labourers("labourers");
+
 	int soldierCap = 0;
 	int draftCap = 0;
 	int provincePop = getTotalPopulation();
 	for (vector<V2Pop*>::const_iterator itr = pops.begin(); itr != pops.end(); ++itr)
 	{
-		if ( (*itr)->getType() == "soldiers" )
+		if ( (*itr)->getType() == soldiers )
 		{
 			// unused capacity is the size of the pop minus the capacity already used, or 0, if it's already overdrawn
 			soldierCap += max( (*itr)->getSize() - getRequiredPopForRegimentCount( (*itr)->getSupportedRegimentCount() ), 0 );
 		}
-		else if ( (*itr)->getType() == "farmers" || (*itr)->getType() == "labourers" )
+		else if ( (*itr)->getType() == farmers || (*itr)->getType() == labourers )
 		{
 			// unused capacity is the size of the pop in excess of 10% of the province pop, or 0, if it's already too small
 			draftCap += max( (*itr)->getSize() - int(0.10 * provincePop), 0 );
@@ -1166,7 +1159,7 @@ string V2Province::getRegimentName(RegimentCategory rc)
 }
 
 
-bool V2Province::hasCulture(string culture, float percentOfPopulation) const
+bool V2Province::hasCulture(Symbol culture, float percentOfPopulation) const
 {
 	int culturePops = 0;
 	for (vector<V2Pop*>::const_iterator itr = pops.begin(); itr != pops.end(); ++itr)
@@ -1185,7 +1178,7 @@ vector<string> V2Province::getCulturesOverThreshold(float percentOfPopulation) c
 {
 	int totalPopulation = getTotalPopulation();
 
-	map<string, double> cultureAmounts;
+	map<Symbol, double> cultureAmounts;
 	for (auto pop: pops)
 	{
 		auto cultureAmount = cultureAmounts.find(pop->getCulture());
@@ -1205,7 +1198,7 @@ vector<string> V2Province::getCulturesOverThreshold(float percentOfPopulation) c
 	{
 		if (cultureAmount.second >= percentOfPopulation)
 		{
-			culturesOverThreshold.push_back(cultureAmount.first);
+			culturesOverThreshold.push_back(cultureAmount.first.str());
 		}
 	}
 
@@ -29,7 +29,10 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 #include "../Configuration.h"
 #include "../EU4World/EU4World.h"
 #include "../EU4World/EU4Country.h"
+#include "Symbol.h"
 
+class Object;
+class OutputFile;
 class V2Pop;
 class V2Factory;
 class V2Country;
@@ -38,9 +41,9 @@ class V2Country;
 
 struct V2Demographic
 {
-	string								culture;
-	string								slaveCulture;
-	string								religion;
+	Symbol								culture;
+	Symbol								slaveCulture;
+	Symbol								religion;
 	double								upperRatio;
 	double								middleRatio;
 	double								lowerRatio;
@@ -52,9 +55,9 @@ struct V2Demographic
 class V2Province
 {
 	public:
-		V2Province(string _filename);
+		V2Province(string _filename, const Object* obj);
 		void output() const;
-		void outputPops(FILE*) const;
+		void outputPops(OutputFile&) const;
 		void convertFromOldProvince(const EU4Province* oldProvince);
 		void determineColonial();
 		void addCore(string);
@@ -65,11 +68,11 @@ class V2Province
 		void addPopDemographic(V2Demographic d);
 
 		int				getTotalPopulation() const;
-		vector<V2Pop*>	getPops(string type) const;
+		vector<V2Pop*>	getPops(Symbol type) const;
 		V2Pop*			getSoldierPopForArmy(bool force = false);
 		pair<int, int>	getAvailableSoldierCapacity() const;
 		string			getRegimentName(RegimentCategory rc);
-		bool				hasCulture(string culture, float percentOfPopulation) const;
+		bool				hasCulture(Symbol culture, float percentOfPopulation) const;
 		vector<string> getCulturesOverThreshold(float percentOfPopulation) const;
 		
 		void				clearCores()									{ cores.clear(); }
@@ -99,7 +102,7 @@ class V2Province
 		vector<V2Pop*>			getPops()				const { return pops; }
 
 	private:
-		void outputUnits(FILE*) const;
+		void outputUnits(OutputFile&) const;
 
 		struct pop_points;
 		pop_points getPopPoints_1(const V2Demographic& demographic, double newPopulation, const V2Country* _owner); // EU4 1.0-1.11
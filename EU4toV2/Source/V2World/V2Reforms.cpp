@@ -23,6 +23,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 #include "V2Reforms.h"
 #include "Log.h"
+#include "OutputWriter.h"
 #include "../Configuration.h"
 #include "../EU4World/EU4Country.h"
 #include "V2Country.h"
@@ -51,124 +52,124 @@ V2Reforms::V2Reforms(const V2Country* dstCountry, const EU4Country* srcCountry)
 }
 
 
-void V2Reforms::output(FILE* output) const
+void V2Reforms::output(OutputFile& output) const
 {
-	fprintf(output, "\n");
-	fprintf(output, "# political reforms\n");
+	output.print("\n");
+	output.print("# political reforms\n");
 	if (slavery >= 1)
 	{
-		fprintf(output, "slavery=no_slavery\n");
+		output.print("slavery=no_slavery\n");
 	}
 	else
 	{
-		fprintf(output, "slavery=yes_slavery\n");
+		output.print("slavery=yes_slavery\n");
 	}
 
 	if (vote_franchise >= 20)
 	{
-		fprintf(output, "vote_franschise=universal_voting\n");
+		output.print("vote_franschise=universal_voting\n");
 	}
 	else if (vote_franchise >= 15)
 	{
-		fprintf(output, "vote_franschise=universal_weighted_voting\n");
+		output.print("vote_franschise=universal_weighted_voting\n");
 	}
 	else if (vote_franchise >= 10)
 	{
-		fprintf(output, "vote_franschise=wealth_voting\n");
+		output.print("vote_franschise=wealth_voting\n");
 	}
 	else if (vote_franchise >= 5)
 	{
-		fprintf(output, "vote_franschise=wealth_weighted_voting\n");
+		output.print("vote_franschise=wealth_weighted_voting\n");
 	}
 	else if (vote_franchise >= 0)
 	{
-		fprintf(output, "vote_franschise=landed_voting\n");
+		output.print("vote_franschise=landed_voting\n");
 	}
 	else
 	{
-		fprintf(output, "vote_franschise=none_voting\n");
+		output.print("vote_franschise=none_voting\n");
 	}
 
 	if (upper_house_composition >= 10)
 	{
-		fprintf(output, "upper_house_composition=population_equal_weight\n");
+		output.print("upper_house_composition=population_equal_weight\n");
 	}
 	else if (upper_house_composition >= 5)
 	{
-		fprintf(output, "upper_house_composition=state_equal_weight\n");
+		output.print("upper_house_composition=state_equal_weight\n");
 	}
 	else if (upper_house_composition >= 0)
 	{
-		fprintf(output, "upper_house_composition=appointed\n");
+		output.print("upper_house_composition=appointed\n");
 	}
 	else
 	{
-		fprintf(output, "upper_house_composition=party_appointed\n");
+		output.print("upper_house_composition=party_appointed\n");
 	}
 
 	if (voting_system >= 10)
 	{
-		fprintf(output, "voting_system=proportional_representation\n");
+		output.print("voting_system=proportional_representation\n");
 	}
 	else if (voting_system >= 5)
 	{
-		fprintf(output, "voting_system=jefferson_method\n");
+		output.print("voting_system=jefferson_method\n");
 	}
 	else
 	{
-		fprintf(output, "voting_system=first_past_the_post\n");
+		output.print("voting_system=first_past_the_post\n");
 	}
 
 	if (public_meetings >= 10)
 	{
-		fprintf(output, "public_meetings=yes_meeting\n");
+		output.print("public_meetings=yes_meeting\n");
 	}
 	else
 	{
-		fprintf(output, "public_meetings=no_meeting\n");
+		output.print("public_meetings=no_meeting\n");
 	}
 
 	if (press_rights >= 8)
 	{
-		fprintf(output, "press_rights=free_press\n");
+		output.print("press_rights=free_press\n");
 	}
 	else if (press_rights >= -8)
 	{
-		fprintf(output, "press_rights=censored_press\n");
+		output.print("press_rights=censored_press\n");
 	}
 	else
 	{
-		fprintf(output, "press_rights=state_press\n");
+		output.print("press_rights=state_press\n");
 	}
 
 	if (trade_unions >= 1.0)
 	{
-		fprintf(output, "trade_unions=all_trade_unions\n");
+		output.print("trade_unions=all_trade_unions\n");
 	}
 	else if (trade_unions >= 0.01)
 	{
-		fprintf(output, "trade_unions=non_socialist\n");
+		output.print("trade_unions=non_socialist\n");
 	}
 	else
 	{
-		fprintf(output, "trade_unions=no_trade_unions\n");
+		output.print("trade_unions=no_trade_unions\n");
 	}
 
 	if (political_parties >= 0.0)
 	{
-		fprintf(output, "political_parties=non_secret_ballots\n");
+		output.print("political_parties=non_secret_ballots\n");
 	}
 	else if (political_parties >= -0.66)
 	{
-		fprintf(output, "political_parties=gerrymandering\n");
+		output.print("political_parties=gerrymandering\n");
 	}
 	else if (political_parties >= -0.75)
 	{
-		fprintf(output, "political_parties=harassment\n");
+		output.print("political_parties=harassment\n");
 	}
 	else
 	{
-		fprintf(output, "political_parties=underground_parties\n");
+		output.print("political_parties=underground_parties\n");
 	}
 }
 
@@ -398,128 +399,128 @@ V2UncivReforms::V2UncivReforms(int westernizationProgress, double milFocus, doub
 }
 
 
-void V2UncivReforms::output(FILE* output) const
+void V2UncivReforms::output(OutputFile& output) const
 {
 	if (reforms[0]) {
-		fprintf(output, "land_reform=yes_land_reform\n");
+		output.print("land_reform=yes_land_reform\n");
 	}
 	else
 	{
-		fprintf(output, "land_reform=no_land_reform\n");
+		output.print("land_reform=no_land_reform\n");
 	}
 
 	if (reforms[1]) {
-		fprintf(output, "admin_reform=yes_admin_reform\n");
+		output.print("admin_reform=yes_admin_reform\n");
 	}
 	else
 	{
-		fprintf(output, "admin_reform=no_admin_reform\n");
+		output.print("admin_reform=no_admin_reform\n");
 	}
 
 	if (reforms[3] && reforms[2]) {
-		fprintf(output, "finance_reform=finance_reform_two\n");
+		output.print("finance_reform=finance_reform_two\n");
 	}
 	else if (reforms[2]) {
-		fprintf(output, "finance_reform=yes_finance_reform\n");
+		output.print("finance_reform=yes_finance_reform\n");
 	}
 	else
 	{
-		fprintf(output, "finance_reform=no_finance_reform\n");
+		output.print("finance_reform=no_finance_reform\n");
 	}
 
 	if (reforms[4]) {
-		fprintf(output, "education_reform=yes_education_reform\n");
+		output.print("education_reform=yes_education_reform\n");
 	}
 	else
 	{
-		fprintf(output, "education_reform=no_education_reform\n");
+		output.print("education_reform=no_education_reform\n");
 	}
 
 	if (reforms[5]) {
-		fprintf(output, "transport_improv=yes_transport_improv\n");
+		output.print("transport_improv=yes_transport_improv\n");
 	}
 	else
 	{
-		fprintf(output, "transport_improv=no_transport_improv\n");
+		output.print("transport_improv=no_transport_improv\n");
 	}
 
 	if (reforms[6]) {
-		fprintf(output, "pre_indust=yes_pre_indust\n");
+		output.print("pre_indust=yes_pre_indust\n");
 	}
 	else
 	{
-		fprintf(output, "pre_indust=no_pre_indust\n");
+		output.print("pre_indust=no_pre_indust\n");
 	}
 
 	if (reforms[7]) {
-		fprintf(output, "industrial_construction=yes_industrial_construction\n");
+		output.print("industrial_construction=yes_industrial_construction\n");
 	}
 	else
 	{
-		fprintf(output, "industrial_construction=no_industrial_construction\n");
+		output.print("industrial_construction=no_industrial_construction\n");
 	}
 
 	if (reforms[8]) {
-		fprintf(output, "foreign_training=yes_foreign_training\n");
+		output.print("foreign_training=yes_foreign_training\n");
 	}
 	else
 	{
-		fprintf(output, "foreign_training=no_foreign_training\n");
+		output.print("foreign_training=no_foreign_training\n");
 	}
 
 	if (reforms[9]) {
-		fprintf(output, "foreign_weapons=yes_foreign_weapons\n");
+		output.print("foreign_weapons=yes_foreign_weapons\n");
 	}
 	else
 	{
-		fprintf(output, "foreign_weapons=no_foreign_weapons\n");
+		output.print("foreign_weapons=no_foreign_weapons\n");
 	}
 
 	if (reforms[10]) {
-		fprintf(output, "military_constructions=yes_military_constructions\n");
+		output.print("military_constructions=yes_military_constructions\n");
 	}
 	else
 	{
-		fprintf(output, "military_constructions=no_military_constructions\n");
+		output.print("military_constructions=no_military_constructions\n");
 	}
 
 	if (reforms[11]) {
-		fprintf(output, "foreign_officers=yes_foreign_officers\n");
+		output.print("foreign_officers=yes_foreign_officers\n");
 	}
 	else
 	{
-		fprintf(output, "foreign_officers=no_foreign_officers\n");
+		output.print("foreign_officers=no_foreign_officers\n");
 	}
 
 	if (reforms[12]) {
-		fprintf(output, "army_schools=yes_army_schools\n");
+		output.print("army_schools=yes_army_schools\n");
 	}
 	else
 	{
-		fprintf(output, "army_schools=no_army_schools\n");
+		output.print("army_schools=no_army_schools\n");
 	}
 
 	if (reforms[13]) {
-		fprintf(output, "foreign_naval_officers=yes_foreign_naval_officers\n");
+		output.print("foreign_naval_officers=yes_foreign_naval_officers\n");
 	}
 	else
 	{
-		fprintf(output, "foreign_naval_officers=no_foreign_naval_officers\n");
+		output.print("foreign_naval_officers=no_foreign_naval_officers\n");
 	}
 
 	if (reforms[14]) {
-		fprintf(output, "naval_schools=yes_naval_schools\n");
+		output.print("naval_schools=yes_naval_schools\n");
 	}
 	else
 	{
-		fprintf(output, "naval_schools=no_naval_schools\n");
+		output.print("naval_schools=no_naval_schools\n");
 	}
 
 	if (reforms[14]) {
-		fprintf(output, "foreign_navies=yes_foreign_navies\n");
+		output.print("foreign_navies=yes_foreign_navies\n");
 	}
 	else
 	{
-		fprintf(output, "foreign_navies=no_foreign_navies\n");
+		output.print("foreign_navies=no_foreign_navies\n");
 	}
 }
\ No newline at end of file
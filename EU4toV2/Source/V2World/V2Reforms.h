@@ -31,6 +31,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 using namespace std;
 
 class EU4Country;
+class OutputFile;
 class V2Country;
 
 
@@ -38,7 +39,7 @@ class V2Country;
 class V2Reforms {
 	public:
 		V2Reforms(const V2Country*, const EU4Country*);
-		void output(FILE*) const;
+		void output(OutputFile&) const;
 	private:
 		void governmentEffects(const V2Country*);
 		void upperHouseEffects(const V2Country*);
@@ -57,7 +58,7 @@ class V2Reforms {
 class V2UncivReforms {
 	public:
 		V2UncivReforms(int westernizationProgress, double milFocus, double socioEcoFocus, V2Country* country);
-		void output(FILE*) const;
+		void output(OutputFile&) const;
 	private:
 		bool reforms[16];
 };
@@ -23,6 +23,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 #include "V2Relations.h"
 #include "../EU4World/EU4Relations.h"
+#include "OutputWriter.h"
 
 
 
@@ -48,17 +49,17 @@ V2Relations::V2Relations(string newTag, EU4Relations* oldRelations)
 }
 
 
-void V2Relations::output(FILE* out) const
+void V2Relations::output(OutputFile& out) const
 {
-	fprintf(out, "\t%s=\n", tag.c_str());
-	fprintf(out, "\t{\n");
-	fprintf(out, "\t\tvalue=%d\n", value);
+	out.print("\t%s=\n", tag.c_str());
+	out.print("\t{\n");
+	out.print("\t\tvalue=%d\n", value);
 	if (militaryAccess)
 	{
-		fprintf(out, "\t\tmilitary_access=yes\n");
+		out.print("\t\tmilitary_access=yes\n");
 	}
-	fprintf(out, "\t\tlevel=%d\n", level);
-	fprintf(out, "\t}\n");
+	out.print("\t\tlevel=%d\n", level);
+	out.print("\t}\n");
 }
 
 
@@ -29,6 +29,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 #include "Date.h"
 
 class EU4Relations;
+class OutputFile;
 
 
 
@@ -37,7 +38,7 @@ class V2Relations
 	public:
 		V2Relations(string newTag);
 		V2Relations(string newTag, EU4Relations* oldRelations);
-		void output(FILE* out) const;
+		void output(OutputFile& out) const;
 
 		void		setLevel(int level);
 
@@ -31,9 +31,11 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 #include <queue>
 #include <cmath>
 #include <cfloat>
+#include "ParadoxParser.h"
 #include "ParadoxParser8859_15.h"
 #include "Log.h"
 #include "OSCompatibilityLayer.h"
+#include "OutputWriter.h"
 #include "../Mappers/AdjacencyMapper.h"
 #include "../Mappers/ContinentMapper.h"
 #include "../Mappers/CountryMapping.h"
@@ -87,10 +89,32 @@ V2World::V2World()
 		Utils::GetAllFilesInFolderRecursive(Configuration::getV2Path() + "/history/provinces", provinceFilenames);
 	}
 
+	vector<string> provincePaths;	// the full paths of the province history files
 	for (auto provinceFilename: provinceFilenames)
 	{
-		V2Province* newProvince = new V2Province(provinceFilename);
+		if (Utils::DoesFileExist("./blankMod/output/history/provinces" + provinceFilename))
+		{
+			provincePaths.push_back("./blankMod/output/history/provinces" + provinceFilename);
+		}
+		else
+		{
+			provincePaths.push_back(Configuration::getV2Path() + "/history/provinces" + provinceFilename);
+		}
+	}
+
+	ParadoxParser parser(ParserEncoding::ISO_8859_15);	// parses the province and pop histories
+	vector<Object*> provinceObjs = parser.parseFiles(provincePaths);	// the parsed province histories
+	unsigned int i = 0;
+	for (auto provinceFilename: provinceFilenames)
+	{
+		if (provinceObjs[i] == NULL)
+		{
+			LOG(LogLevel::Error) << "Could not parse " << provincePaths[i];
+			exit(-1);
+		}
+		V2Province* newProvince = new V2Province(provinceFilename, provinceObjs[i]);
 		provinces.insert(make_pair(newProvince->getNum(), newProvince));
+		i++;
 	}
 
 	// Get province names
@@ -110,10 +134,18 @@ V2World::V2World()
 	totalWorldPopulation	= 0;
 	set<string> fileNames;
 	Utils::GetAllFilesInFolder("./blankMod/output/history/pops/1836.1.1/", fileNames);
-	for (set<string>::iterator itr = fileNames.begin(); itr != fileNames.end(); itr++)
+	vector<string> popPaths;	// the full paths of the pop history files
+	for (auto fileName: fileNames)
+	{
+		popPaths.push_back("./blankMod/output/history/pops/1836.1.1/" + fileName);
+	}
+	vector<Object*> popObjs = parser.parseFiles(popPaths);	// the parsed pop histories
+	const Symbol slaves("slaves");
+	i = 0;
+	for (set<string>::iterator itr = fileNames.begin(); itr != fileNames.end(); itr++, i++)
 	{
 		list<int>* popProvinces = new list<int>;
-		Object*	obj2	= parser_8859_15::doParseFile(("./blankMod/output/history/pops/1836.1.1/" + *itr).c_str());				// generic object
+		Object*	obj2	= popObjs[i];				// generic object
 		vector<Object*> leaves = obj2->getLeaves();
 		for (unsigned int j = 0; j < leaves.size(); j++)
 		{
@@ -141,10 +173,10 @@ V2World::V2World()
 				vector<Object*> pops = leaves[j]->getLeaves();
 				for(unsigned int l = 0; l < pops.size(); l++)
 				{
-					string	popType		= pops[l]->getKey();
+					Symbol	popType		= Symbol(pops[l]->getKey());
 					int		popSize		= atoi(pops[l]->getLeaf("size").c_str());
-					string	popCulture	= pops[l]->getLeaf("culture");
-					string	popReligion	= pops[l]->getLeaf("religion");
+					Symbol	popCulture	= Symbol(pops[l]->getLeaf("culture"));
+					Symbol	popReligion	= Symbol(pops[l]->getLeaf("religion"));
 
 					/*auto popItr = countryPopItr->second.find(pops[l]->getKey());
 					if (popItr == countryPopItr->second.end())
@@ -164,7 +196,7 @@ V2World::V2World()
 						k->second->addMinorityPop(newPop);
 					}
 
-					if ((popType == "slaves") || (popCulture.substr(0, 4) == "afro"))
+					if ((popType == slaves) || (popCulture.str().compare(0, 4, "afro") == 0))
 					{
 						provinceSlavePopulation += popSize;
 					}
@@ -325,7 +357,7 @@ V2World::V2World()
 void V2World::output() const
 {
 	// Create common\countries path.
-	string countriesPath = "Output/" + Configuration::getOutputName() + "/common/countries";
+	string countriesPath = "output/" + Configuration::getOutputName() + "/common/countries";
 	if (!Utils::TryCreateFolder(countriesPath))
 	{
 		return;
@@ -333,12 +365,7 @@ void V2World::output() const
 
 	// Output common\countries.txt
 	LOG(LogLevel::Debug) << "Writing countries file";
-	FILE* allCountriesFile;
-	if (fopen_s(&allCountriesFile, ("Output/" + Configuration::getOutputName() + "/common/countries.txt").c_str(), "w") != 0)
-	{
-		LOG(LogLevel::Error) << "Could not create countries file";
-		exit(-1);
-	}
+	OutputFile allCountriesFile("output/" + Configuration::getOutputName() + "/common/countries.txt");
 	for (map<string, V2Country*>::const_iterator i = countries.begin(); i != countries.end(); i++)
 	{
 		const V2Country& country = *i->second;
@@ -348,17 +375,17 @@ void V2World::output() const
 			country.outputToCommonCountriesFile(allCountriesFile);
 		}
 	}
-	fprintf(allCountriesFile, "\n");
+	allCountriesFile.print("\n");
 	if ((Configuration::getV2Gametype() == "HOD") || (Configuration::getV2Gametype() == "HoD_NNM"))
 	{
-		fprintf(allCountriesFile, "##HoD Dominions\n");
-		fprintf(allCountriesFile, "dynamic_tags = yes # any tags after this is considered dynamic dominions\n");
+		allCountriesFile.print("##HoD Dominions\n");
+		allCountriesFile.print("dynamic_tags = yes # any tags after this is considered dynamic dominions\n");
 		for (map<string, V2Country*>::const_iterator i = dynamicCountries.begin(); i != dynamicCountries.end(); i++)
 		{
 			i->second->outputToCommonCountriesFile(allCountriesFile);
 		}
 	}
-	fclose(allCountriesFile);
+	allCountriesFile.close();
 
 	// Create flags for all new countries.
 	V2Flags flags;
@@ -367,7 +394,7 @@ void V2World::output() const
 
 	// Create localisations for all new countries. We don't actually know the names yet so we just use the tags as the names.
 	LOG(LogLevel::Debug) << "Writing localisation text";
-	string localisationPath = "Output/" + Configuration::getOutputName() + "/localisation";
+	string localisationPath = "output/" + Configuration::getOutputName() + "/localisation";
 	if (!Utils::TryCreateFolder(localisationPath))
 	{
 		return;
@@ -441,9 +468,16 @@ void V2World::output() const
 
 	outputPops();
 
+	// everything written above is still being written in the background, and must be on disk to be checked
+	if (!OutputWriter::getShared().finish())
+	{
+		LOG(LogLevel::Error) << "Could not write the mod";
+		exit(-1);
+	}
+
 	// verify countries got written
 	ifstream V2CountriesInput;
-	V2CountriesInput.open(("Output/" + Configuration::getOutputName() + "/common/countries.txt").c_str());
+	V2CountriesInput.open(("output/" + Configuration::getOutputName() + "/common/countries.txt").c_str());
 	if (!V2CountriesInput.is_open())
 	{
 		LOG(LogLevel::Error) << "Could not open countries.txt";
@@ -470,7 +504,7 @@ void V2World::output() const
 		int size				= line.find_last_of('\"') - start - 1;
 		countryFileName	= line.substr(start + 1, size);
 
-		if (Utils::DoesFileExist("Output/" + Configuration::getOutputName() + "/common/countries/" + countryFileName))
+		if (Utils::DoesFileExist("output/" + Configuration::getOutputName() + "/common/countries/" + countryFileName))
 		{
 		}
 		else if (Utils::DoesFileExist(Configuration::getV2Path() + "/common/countries/" + countryFileName))
@@ -491,12 +525,7 @@ void V2World::outputPops() const
 	LOG(LogLevel::Debug) << "Writing pops";
 	for (map<string, list<int>* >::const_iterator itr = popRegions.begin(); itr != popRegions.end(); itr++)
 	{
-		FILE* popsFile;
-		if (fopen_s(&popsFile, ("Output/" + Configuration::getOutputName() + "/history/pops/1836.1.1/" + itr->first).c_str(), "w") != 0)
-		{
-			LOG(LogLevel::Error) << "Could not create pops file Output/" << Configuration::getOutputName() << "/history/pops/1836.1.1/" << itr->first;
-			exit(-1);
-		}
+		OutputFile popsFile("output/" + Configuration::getOutputName() + "/history/pops/1836.1.1/" + itr->first);
 
 		for (list<int>::const_iterator provNumItr = itr->second->begin(); provNumItr != itr->second->end(); provNumItr++)
 		{
@@ -821,7 +850,7 @@ void V2World::convertProvinces(const EU4World& sourceWorld)
 {
 	for (auto Vic2Province: provinces)
 	{
-		auto EU4ProvinceNumbers = provinceMapper::getEU4ProvinceNumbers(Vic2Province.first);
+		const auto& EU4ProvinceNumbers = provinceMapper::getEU4ProvinceNumbers(Vic2Province.first);
 		if (EU4ProvinceNumbers.size() == 0)
 		{
 			LOG(LogLevel::Warning) << "No source for " << Vic2Province.second->getName() << " (province " << Vic2Province.first << ')';
@@ -971,30 +1000,33 @@ void V2World::convertProvinces(const EU4World& sourceWorld)
 }
 
 
-vector<V2Demographic> V2World::determineDemographics(vector<EU4PopRatio>& popRatios, EU4Province* eProv, V2Province* vProv, EU4Country* oldOwner, int destNum, double provPopRatio)
+vector<V2Demographic> V2World::determineDemographics(const vector<EU4PopRatio>& popRatios, EU4Province* eProv, V2Province* vProv, EU4Country* oldOwner, int destNum, double provPopRatio)
 {
 	vector<V2Demographic> demographics;
-	for (auto prItr: popRatios)
+	static const Symbol noCulture("no_culture");
+	static const Symbol africanMinor("african_minor");
+
+	for (auto& prItr: popRatios)
 	{
-		string dstCulture = "no_culture";
+		Symbol dstCulture = noCulture;
 		bool matched = cultureMapper::cultureMatch(prItr.culture, dstCulture, prItr.religion, eProv->getNum(), oldOwner->getTag());
 		if (!matched)
 		{
 			LOG(LogLevel::Warning) << "Could not set culture for pops in Vic2 province " << destNum;
 		}
 
-		string religion = religionMapper::getVic2Religion(prItr.religion);;
-		if (religion == "")
+		Symbol religion = religionMapper::getVic2Religion(prItr.religion);
+		if (religion.empty())
 		{
 			LOG(LogLevel::Warning) << "Could not set religion for pops in Vic2 province " << destNum;
 		}
 
-		string slaveCulture = "";
-		matched = cultureMapper::slaveCultureMatch(prItr.culture, slaveCulture, prItr.religion, eProv->getNum(), oldOwner->getTag());;
+		Symbol slaveCulture;
+		matched = cultureMapper::slaveCultureMatch(prItr.culture, slaveCulture, prItr.religion, eProv->getNum(), oldOwner->getTag());
 		if (!matched)
 		{
 			//LOG(LogLevel::Warning) << "Could not set slave culture for pops in Vic2 province " << destNum;
-			slaveCulture = "african_minor";
+			slaveCulture = africanMinor;
 		}
 
 		V2Demographic demographic;
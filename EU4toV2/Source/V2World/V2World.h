@@ -66,7 +66,7 @@ class V2World {
 
 	private:
 		void checkForCivilizedNations();
-		vector<V2Demographic>	determineDemographics(vector<EU4PopRatio>& popRatios, EU4Province* eProv, V2Province* vProv, EU4Country* oldOwner, int destNum, double provPopRatio);
+		vector<V2Demographic>	determineDemographics(const vector<EU4PopRatio>& popRatios, EU4Province* eProv, V2Province* vProv, EU4Country* oldOwner, int destNum, double provPopRatio);
 
 		void				outputPops() const;
 		void				getProvinceLocalizations(string file);
@@ -33,9 +33,9 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 #include <boost/algorithm/string.hpp>
 
 #include "Object.h"
-#include "paradoxParser.h"
-#include "V2World\V2World.h"
-#include "HoI3World\HoI3World.h"
+#include "ParadoxParser8859_15.h"
+#include "V2World/V2World.h"
+#include "HOI3World/HoI3World.h"
 #include "Log.h"
 
 bool CountryMapping::ReadRules(const std::string& fileName)
@@ -44,8 +44,8 @@ bool CountryMapping::ReadRules(const std::string& fileName)
 
 	// Read the rule nodes from file.
 	LOG(LogLevel::Debug) << "Parsing rules from file " << fileName;
-	initParser();
-	Object* countryMappingsFile = doParseFile(fileName.c_str());	// the parsed country mappings file
+	parser_8859_15::initParser();
+	Object* countryMappingsFile = parser_8859_15::doParseFile(fileName.c_str());	// the parsed country mappings file
 	if (!countryMappingsFile)
 	{
 		LOG(LogLevel::Error) << "Failed to parse " << fileName;
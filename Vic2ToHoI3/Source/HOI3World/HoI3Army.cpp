@@ -24,15 +24,15 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 #include "HoI3Army.h"
 #include "Log.h"
 #include "../Configuration.h"
-#include "ParadoxParser.h"
+#include "ParadoxParser8859_15.h"
 #include <sstream>
 
 
 
 HoI3RegimentType::HoI3RegimentType(string type)
 {
-	string	filename	= Configuration::getHoI3Path() + "\\tfh\\units\\" + type + ".txt";
-	Object*	obj		= doParseFile(filename.c_str());
+	string	filename	= Configuration::getHoI3Path() + "/tfh/units/" + type + ".txt";
+	Object*	obj		= parser_8859_15::doParseFile(filename.c_str());
 	obj					= obj->getLeaves()[0];
 	name					= obj->getKey();
 
@@ -26,7 +26,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 
 
-#include <io.h>
+#include <cstdio>
 #include <string>
 #include <map>
 #include <set>
@@ -24,7 +24,8 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 #include "HoI3Country.h"
 #include <fstream>
 #include "Log.h"
-#include "ParadoxParser.h"
+#include "ParadoxParser8859_15.h"
+#include "OSCompatibilityLayer.h"
 #include "HoI3Leader.h"
 #include "HoI3Minister.h"
 #include "../V2World/V2Relations.h"
@@ -128,7 +129,7 @@ void HoI3Country::output() const
 {
 	// output history file
 	FILE* output;
-	if (fopen_s(&output, ("Output\\" + Configuration::getOutputName() + "\\history\\countries\\" + filename).c_str(), "w") != 0)
+	if (fopen_s(&output, ("output/" + Configuration::getOutputName() + "/history/countries/" + filename).c_str(), "w") != 0)
 	{
 		LOG(LogLevel::Error) << "Could not create country history file " << filename;
 		exit(-1);
@@ -179,9 +180,9 @@ void HoI3Country::output() const
 	outputLeaders();
 
 	// Output common country file. 
-	if (fopen_s(&output, ("Output\\" + Configuration::getOutputName() + "\\common\\countries\\" + commonCountryFile).c_str(), "w") != 0)
+	if (fopen_s(&output, ("output/" + Configuration::getOutputName() + "/common/countries/" + commonCountryFile).c_str(), "w") != 0)
 	{
-		Log(LogLevel::Error) << "Could not open " << "Output\\" << Configuration::getOutputName() << "\\common\\countries\\" << commonCountryFile;
+		Log(LogLevel::Error) << "Could not open " << "output/" << Configuration::getOutputName() << "/common/countries/" << commonCountryFile;
 		exit(-1);
 	}
 	int red;
@@ -356,9 +357,9 @@ void HoI3Country::outputParties(FILE* output) const
 	fprintf(output, "\n");
 
 	FILE* partyLocalisations;
-	if (fopen_s(&partyLocalisations, ("Output\\" + Configuration::getOutputName() + "\\localisation\\Parties.csv").c_str(), "a") != 0)
+	if (fopen_s(&partyLocalisations, ("output/" + Configuration::getOutputName() + "/localisation/Parties.csv").c_str(), "a") != 0)
 	{
-		LOG(LogLevel::Error) << "Could not open " << "Output\\" << Configuration::getOutputName() << "\\localisation\\Parties.csv";
+		LOG(LogLevel::Error) << "Could not open " << "output/" << Configuration::getOutputName() << "/localisation/Parties.csv";
 		exit(-1);
 	}
 	for (auto party: parties)
@@ -372,9 +373,9 @@ void HoI3Country::outputParties(FILE* output) const
 void HoI3Country::outputLeaders() const
 {
 	FILE* leadersFile;
-	if (fopen_s(&leadersFile, ("Output\\" + Configuration::getOutputName() + "\\history\\leaders\\" + tag.c_str() + ".txt").c_str(), "w") != 0)
+	if (fopen_s(&leadersFile, ("output/" + Configuration::getOutputName() + "/history/leaders/" + tag.c_str() + ".txt").c_str(), "w") != 0)
 	{
-		LOG(LogLevel::Error) << "Could not open " << "Output\\" << Configuration::getOutputName() << "\\history\\leaders\\" << tag.c_str() << ".txt";
+		LOG(LogLevel::Error) << "Could not open " << "output/" << Configuration::getOutputName() << "/history/leaders/" << tag.c_str() << ".txt";
 	}
 	int landLeaders	= 0;
 	int seaLeaders		= 0;
@@ -409,7 +410,7 @@ void HoI3Country::outputLeaders() const
 void HoI3Country::outputOOB() const
 {
 	FILE* output;
-	if (fopen_s(&output, ("Output\\" + Configuration::getOutputName() + "\\history\\units\\" + tag + "_OOB.txt").c_str(), "w") != 0)
+	if (fopen_s(&output, ("output/" + Configuration::getOutputName() + "/history/units/" + tag + "_OOB.txt").c_str(), "w") != 0)
 	{
 		LOG(LogLevel::Error) << "Could not create OOB file " << (tag + "_OOB.txt");
 		exit(-1);
@@ -435,31 +436,14 @@ void HoI3Country::initFromV2Country(const V2World& _srcWorld, const V2Country* _
 {
 	srcCountry = _srcCountry;
 
-	struct _finddata_t	fileData;
-	intptr_t					fileListing;
-	string filesearch = ".\\blankMod\\output\\history\\countries\\" + tag + "*.txt";
-	if ((fileListing = _findfirst(filesearch.c_str(), &fileData)) != -1L)
+	filename = Utils::GetFileFromTag("./blankMod/output/history/countries/", tag);
+	if (filename == "")
 	{
-		filename = fileData.name;
+		filename = Utils::GetFileFromTag(Configuration::getHoI3Path() + "/tfh/history/countries/", tag);
 	}
-	_findclose(fileListing);
 	if (filename == "")
 	{
-		string filesearch = Configuration::getHoI3Path() + "\\tfh\\history\\countries\\" + tag + "*.txt";
-		if ((fileListing = _findfirst(filesearch.c_str(), &fileData)) != -1L)
-		{
-			filename = fileData.name;
-		}
-		else
-		{
-			_findclose(fileListing);
-			filesearch = Configuration::getHoI3Path() + "\\history\\countries\\" + tag + "*.txt";
-			if ((fileListing = _findfirst(filesearch.c_str(), &fileData)) != -1L)
-			{
-				filename = fileData.name;
-			}
-		}
-		_findclose(fileListing);
+		filename = Utils::GetFileFromTag(Configuration::getHoI3Path() + "/history/countries/", tag);
 	}
 	if (filename == "")
 	{
@@ -698,34 +682,20 @@ void HoI3Country::initFromV2Country(const V2World& _srcWorld, const V2Country* _
 void HoI3Country::initFromHistory()
 {
 	string fullFilename;
-	struct _finddata_t	fileData;
-	intptr_t					fileListing;
-	string filesearch = ".\\blankMod\\output\\history\\countries\\" + tag + "*.txt";
-	if ((fileListing = _findfirst(filesearch.c_str(), &fileData)) != -1L)
+	const string historyFolders[] =
 	{
-		filename			= fileData.name;
-		fullFilename	= string(".\\blankMod\\output\\history\\countries\\") + fileData.name;
-	}
-	_findclose(fileListing);
-	if (fullFilename == "")
+		"./blankMod/output/history/countries/",
+		Configuration::getHoI3Path() + "/tfh/history/countries/",
+		Configuration::getHoI3Path() + "/history/countries/"
+	};
+	for (auto historyFolder: historyFolders)
 	{
-		string filesearch = Configuration::getHoI3Path() + "\\tfh\\history\\countries\\" + tag + "*.txt";
-		if ((fileListing = _findfirst(filesearch.c_str(), &fileData)) != -1L)
-		{
-			filename			= fileData.name;
-			fullFilename = Configuration::getHoI3Path() + "\\tfh\\history\\countries\\" + fileData.name;
-		}
-		else
+		filename = Utils::GetFileFromTag(historyFolder, tag);
+		if (filename != "")
 		{
-			_findclose(fileListing);
-			filesearch = Configuration::getHoI3Path() + "\\history\\countries\\" + tag + "*.txt";
-			if ((fileListing = _findfirst(filesearch.c_str(), &fileData)) != -1L)
-			{
-				filename			= fileData.name;
-				fullFilename = Configuration::getHoI3Path() + "\\history\\countries\\" + fileData.name;
-			}
+			fullFilename = historyFolder + filename;
+			break;
 		}
-		_findclose(fileListing);
 	}
 	if (fullFilename == "")
 	{
@@ -736,7 +706,7 @@ void HoI3Country::initFromHistory()
 		return;
 	}
 
-	Object* obj = doParseFile(fullFilename.c_str());
+	Object* obj = parser_8859_15::doParseFile(fullFilename.c_str());
 	if (obj == NULL)
 	{
 		LOG(LogLevel::Error) << "Could not parse file " << fullFilename;
@@ -1889,7 +1859,7 @@ void HoI3Country::outputLocalisation(FILE* output) const
 void HoI3Country::outputAIScript() const
 {
 	FILE* output;
-	if (fopen_s(&output, ("Output\\" + Configuration::getOutputName() + "\\script\\country\\" + tag + ".lua").c_str(), "w") != 0)
+	if (fopen_s(&output, ("output/" + Configuration::getOutputName() + "/script/country/" + tag + ".lua").c_str(), "w") != 0)
 	{
 		LOG(LogLevel::Error) << "Could not create country script file for " << tag;
 		exit(-1);
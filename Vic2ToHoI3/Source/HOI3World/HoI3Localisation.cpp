@@ -23,12 +23,11 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 #include "HoI3Localisation.h"
 
-#include <Windows.h>
 #include <fstream>
 
-#include "..\V2World\V2Country.h"
+#include "../V2World/V2Country.h"
 #include "Log.h"
-#include "..\WinUtils.h"
+#include "OSCompatibilityLayer.h"
 
 const std::array<std::string, HoI3Localisation::numLanguages> HoI3Localisation::languages = 
 	{ "english", "french", "german", "spanish" };
@@ -108,36 +107,6 @@ std::string HoI3Localisation::convertCountryFileName(const std::string countryFi
 
 std::string HoI3Localisation::Convert(const std::string& text)
 {
-	if (text.empty())
-	{
-		return "";
-	}
-
-	int utf16Size = MultiByteToWideChar(CP_UTF8, 0, text.c_str(), text.size(), NULL, 0);
-	if (utf16Size == 0)
-	{
-		LOG(LogLevel::Warning) << "Can't convert \"" << text << "\" to UTF-16: " << WinUtils::GetLastWindowsError();
-		return "";
-	}
-	std::vector<wchar_t> utf16Text(utf16Size, L'\0');
-	int result = MultiByteToWideChar(CP_UTF8, 0, text.c_str(), text.size(), &utf16Text[0], utf16Size);
-	if (result == 0)
-	{
-		LOG(LogLevel::Warning) << "Can't convert \"" << text << "\" to UTF-16: " << WinUtils::GetLastWindowsError();
-		return "";
-	}
-	int latin1Size = WideCharToMultiByte(1252, WC_NO_BEST_FIT_CHARS | WC_COMPOSITECHECK | WC_DEFAULTCHAR, &utf16Text[0], utf16Size, NULL, 0, "0", NULL);
-	if (latin1Size == 0)
-	{
-		LOG(LogLevel::Warning) << "Can't convert \"" << text << "\" to Latin-1: " << WinUtils::GetLastWindowsError();
-		return "";
-	}
-	std::vector<char> latin1Text(latin1Size, '\0');
-	result = WideCharToMultiByte(1252, WC_NO_BEST_FIT_CHARS | WC_COMPOSITECHECK | WC_DEFAULTCHAR, &utf16Text[0], utf16Size, &latin1Text[0], latin1Size, "0", NULL);
-	if (result == 0)
-	{
-		LOG(LogLevel::Warning) << "Can't convert \"" << text << "\" to Latin-1: " << WinUtils::GetLastWindowsError();
-		return "";
-	}
-	return std::string(latin1Text.begin(), latin1Text.end());
+	// characters with no Latin-1 equivalent become '0', as they did through the Windows API
+	return Utils::convertUTF8To8859_15(text);
 }
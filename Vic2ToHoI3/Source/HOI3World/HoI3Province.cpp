@@ -24,11 +24,13 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 #include "HoI3Province.h"
 #include "Log.h"
 #include "Object.h"
-#include "ParadoxParser.h"
+#include "ParadoxParser8859_15.h"
+#include "OSCompatibilityLayer.h"
 #include <sstream>
 #include <algorithm>
+#include <cerrno>
+#include <cstring>
 #include <stdio.h>
-#include <sys/stat.h>
 using namespace std;
 
 
@@ -56,16 +58,16 @@ HoI3Province::HoI3Province(string _filename)
 	rawIndustry			= 0.0;
 	cores.clear();
 
-	int slash		= _filename.find_last_of("\\");
+	int slash		= _filename.find_last_of("/");
 	int numDigits	= _filename.find_first_of("-") - slash - 2;
 	string temp		= _filename.substr(slash + 1, numDigits);
 	num				= atoi(temp.c_str());
 
 	Object* obj;
-	obj = doParseFile((string(".\\blankMod\\output\\history\\provinces") + _filename).c_str());
+	obj = parser_8859_15::doParseFile((string("./blankMod/output/history/provinces") + _filename).c_str());
 	if (obj == NULL)
 	{
-		LOG(LogLevel::Error) << "Could not parse .\\blankMod\\output\\history\\provinces" << _filename;
+		LOG(LogLevel::Error) << "Could not parse ./blankMod/output/history/provinces" << _filename;
 		exit(-1);
 	}
 
@@ -118,13 +120,9 @@ void HoI3Province::output() const
 	for (auto filename: filenames)
 	{
 		FILE* output;
-		if (fopen_s(&output, ("Output\\" + Configuration::getOutputName() + "\\history\\provinces\\" + filename.first).c_str(), "w") != 0)
+		if (fopen_s(&output, ("output/" + Configuration::getOutputName() + "/history/provinces/" + filename.first).c_str(), "w") != 0)
 		{
-			int errNum;
-			_get_errno(&errNum);
-			char errStr[256];
-			strerror_s(errStr, sizeof(errStr), errNum);
-			LOG(LogLevel::Error) << "Could not create province history file Output\\" << Configuration::getOutputName() << "\\history\\provinces\\" << filename.first << " - " << errStr;
+			LOG(LogLevel::Error) << "Could not create province history file output/" << Configuration::getOutputName() << "/history/provinces/" << filename.first << " - " << strerror(errno);
 			exit(-1);
 		}
 		if (owner != "")
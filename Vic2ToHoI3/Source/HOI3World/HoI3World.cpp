@@ -21,19 +21,16 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 
 #include "HoI3World.h"
-#include <Windows.h>
 #include <fstream>
 #include <algorithm>
-#include <io.h>
 #include <list>
 #include <queue>
 #include <cmath>
 #include <cfloat>
-#include <sys/stat.h>
-#include "ParadoxParser.h"
+#include "ParadoxParser8859_15.h"
 #include "Log.h"
 #include "../Configuration.h"
-#include "../WinUtils.h"
+#include "OSCompatibilityLayer.h"
 #include "../V2World/V2Province.h"
 #include "../V2World/V2Party.h"
 #include "HoI3Relations.h"
@@ -54,49 +51,23 @@ void HoI3World::importProvinces(const provinceMapping& provinceMap)
 {
 	LOG(LogLevel::Info) << "Importing provinces";
 
-	struct _finddata_t	provinceFileData;
-	intptr_t					fileListing = NULL;
-	list<string>			directories;
-
-	directories.push_back("");
-	while (directories.size() > 0)
+	set<string> provinceFilenames;
+	Utils::GetAllFilesInFolderRecursive("./blankMod/output/history/provinces", provinceFilenames);
+	for (auto provinceFilename: provinceFilenames)
 	{
-		if ((fileListing = _findfirst((string(".\\blankMod\\output\\history\\provinces") + directories.front() + "\\*.*").c_str(), &provinceFileData)) == -1L)
+		HoI3Province* newProvince = new HoI3Province(provinceFilename);
+
+		int provinceNum = newProvince->getNum();
+		auto provinceItr = provinces.find(provinceNum);
+		if (provinceItr == provinces.end())
 		{
-			LOG(LogLevel::Error) << "Could not open directory .\\blankMod\\output\\history\\provinces" << directories.front() << "\\*.*";
-			exit(-1);
+			provinces.insert(make_pair(provinceNum, newProvince));
 		}
-
-		do
+		else
 		{
-			if (strcmp(provinceFileData.name, ".") == 0 || strcmp(provinceFileData.name, "..") == 0)
-			{
-				continue;
-			}
-			if (provinceFileData.attrib & _A_SUBDIR)
-			{
-				string newDirectory = directories.front() + "\\" + provinceFileData.name;
-				directories.push_back(newDirectory);
-			}
-			else
-			{
-				HoI3Province* newProvince = new HoI3Province(directories.front() + "\\" + provinceFileData.name);
-
-				int provinceNum = newProvince->getNum();
-				auto provinceItr = provinces.find(provinceNum);
-				if (provinceItr == provinces.end())
-				{
-					provinces.insert(make_pair(provinceNum, newProvince));
-				}
-				else
-				{
-					provinceItr->second->addFilename(directories.front() + "\\" + provinceFileData.name);
-					provinceNum++;
-				}
-			}
-		} while (_findnext(fileListing, &provinceFileData) == 0);
-		_findclose(fileListing);
-		directories.pop_front();
+			provinceItr->second->addFilename(provinceFilename);
+			provinceNum++;
+		}
 	}
 	checkAllProvincesMapped(provinceMap);
 }
@@ -106,11 +77,11 @@ void HoI3World::checkCoastalProvinces()
 {
 	// determine whether each province is coastal or not by checking if it has a naval base
 	// if it's not coastal, we won't try to put any navies in it (otherwise HoI3 crashes)
-	Object*	obj2 = doParseFile((Configuration::getHoI3Path() + "\\tfh\\map\\positions.txt").c_str());
+	Object*	obj2 = parser_8859_15::doParseFile((Configuration::getHoI3Path() + "/tfh/map/positions.txt").c_str());
 	vector<Object*> objProv = obj2->getLeaves();
 	if (objProv.size() == 0)
 	{
-		LOG(LogLevel::Error) << "map\\positions.txt failed to parse.";
+		LOG(LogLevel::Error) << "map/positions.txt failed to parse.";
 		exit(1);
 	}
 	for (auto itr: objProv)
@@ -143,14 +114,13 @@ void HoI3World::importPotentialCountries()
 	potentialCountries.clear();
 	const date FirstStartDate("1936.1.1");
 	ifstream HoI3CountriesInput;
-	struct _stat st;
-	if (_stat(".\\blankMod\\output\\common\\countries.txt", &st) == 0)
+	if (Utils::DoesFileExist("./blankMod/output/common/countries.txt"))
 	{
-		HoI3CountriesInput.open(".\\blankMod\\output\\common\\countries.txt");
+		HoI3CountriesInput.open("./blankMod/output/common/countries.txt");
 	}
 	else
 	{
-		HoI3CountriesInput.open((Configuration::getHoI3Path() + "\\common\\countries.txt").c_str());
+		HoI3CountriesInput.open((Configuration::getHoI3Path() + "/common/countries.txt").c_str());
 	}
 	if (!HoI3CountriesInput.is_open())
 	{
@@ -197,17 +167,17 @@ void HoI3World::output() const
 void HoI3World::outputCommonCountries() const
 {
 	// Create common\countries path.
-	string countriesPath = "Output\\" + Configuration::getOutputName() + "\\common\\countries";
-	if (!WinUtils::TryCreateFolder(countriesPath))
+	string countriesPath = "output/" + Configuration::getOutputName() + "/common/countries";
+	if (!Utils::TryCreateFolder(countriesPath))
 	{
-		LOG(LogLevel::Error) << "Could not create \"Output\\" + Configuration::getOutputName() + "\\common\\countries\"";
+		LOG(LogLevel::Error) << "Could not create \"output/" + Configuration::getOutputName() + "/common/countries\"";
 		exit(-1);
 	}
 
 	// Output common\countries.txt
 	LOG(LogLevel::Debug) << "Writing countries file";
 	FILE* allCountriesFile;
-	if (fopen_s(&allCountriesFile, ("Output\\" + Configuration::getOutputName() + "\\common\\countries.txt").c_str(), "w") != 0)
+	if (fopen_s(&allCountriesFile, ("output/" + Configuration::getOutputName() + "/common/countries.txt").c_str(), "w") != 0)
 	{
 		LOG(LogLevel::Error) << "Could not create countries file";
 		exit(-1);
@@ -290,7 +260,7 @@ void HoI3World::outputAutoexecLua() const
 {
 	// output autoexec.lua
 	FILE* autoexec;
-	if (fopen_s(&autoexec, ("Output\\" + Configuration::getOutputName() + "\\script\\autoexec.lua").c_str(), "w") != 0)
+	if (fopen_s(&autoexec, ("output/" + Configuration::getOutputName() + "/script/autoexec.lua").c_str(), "w") != 0)
 	{
 		LOG(LogLevel::Error) << "Could not create autoexec.lua";
 		exit(-1);
@@ -324,15 +294,15 @@ void HoI3World::outputLocalisations() const
 {
 	// Create localisations for all new countries. We don't actually know the names yet so we just use the tags as the names.
 	LOG(LogLevel::Debug) << "Writing localisation text";
-	string localisationPath = "Output\\" + Configuration::getOutputName() + "\\localisation";
-	if (!WinUtils::TryCreateFolder(localisationPath))
+	string localisationPath = "output/" + Configuration::getOutputName() + "/localisation";
+	if (!Utils::TryCreateFolder(localisationPath))
 	{
 		return;
 	}
 
-	string source = ".\\blankMod\\output\\localisation\\countries.csv";
-	string dest = localisationPath + "\\countries.csv";
-	WinUtils::TryCopyFile(source, dest);
+	string source = "./blankMod/output/localisation/countries.csv";
+	string dest = localisationPath + "/countries.csv";
+	Utils::TryCopyFile(source, dest);
 	FILE* localisationFile;
 	if (fopen_s(&localisationFile, dest.c_str(), "a") != 0)
 	{
@@ -703,7 +673,7 @@ void HoI3World::convertProvinceItems(const V2World& sourceWorld, const provinceM
 			}
 			else if (Configuration::getIcConversion() == "logarithmic")
 			{
-				industry = log(max(1, industry / 70000)) / log(2) * 5.33;
+				industry = log(max(1.0, industry / 70000)) / log(2) * 5.33;
 				dstProvItr->second->addRawIndustry(industry * Configuration::getIcFactor());
 			}
 					
@@ -757,7 +727,7 @@ void HoI3World::convertTechs(const V2World& sourceWorld)
 	map<string, vector<pair<string, int> > > invTechMap;
 
 	// build tech maps - the code is ugly so the file can be pretty
-	Object* obj = doParseFile("tech_mapping.txt");
+	Object* obj = parser_8859_15::doParseFile("tech_mapping.txt");
 	vector<Object*> objs = obj->getValue("tech_map");
 	if (objs.size() < 1)
 	{
@@ -884,7 +854,7 @@ unitTypeMapping HoI3World::getUnitMappings()
 {
 	// parse the mapping file
 	map<string, multimap<HoI3RegimentType, unsigned> > unitTypeMap; // <vic, hoi>
-	Object* obj = doParseFile("unit_mapping.txt");
+	Object* obj = parser_8859_15::doParseFile("unit_mapping.txt");
 	vector<Object*> leaves = obj->getLeaves();
 	if (leaves.size() < 1)
 	{
@@ -1040,7 +1010,7 @@ int HoI3World::getAirLocation(HoI3Province* locationProvince, const HoI3Adjacenc
 }
 
 
-vector<HoI3Regiment*> HoI3World::convertRegiments(const unitTypeMapping& unitTypeMap, vector<V2Regiment*>& sourceRegiments, map<string, unsigned>& typeCount, const pair<string, HoI3Country*>& country)
+vector<HoI3Regiment*> HoI3World::convertRegiments(const unitTypeMapping& unitTypeMap, const vector<V2Regiment*>& sourceRegiments, map<string, unsigned>& typeCount, const pair<string, HoI3Country*>& country)
 {
 	vector<HoI3Regiment*> destRegiments;
 
@@ -2044,7 +2014,7 @@ void HoI3World::convertDiplomacy(const V2World& sourceWorld, const CountryMappin
 			}
 
 			hoi3a.value = relationItr.second->getRelations();
-			hoi3a.start_date = date("1930.1.1"); // Arbitrary date
+			hoi3a.start_date = date(1930, 1, 1); // Arbitrary date
 			hoi3a.type = "relation";
 			diplomacy.addAgreement(hoi3a);
 
@@ -2053,7 +2023,7 @@ void HoI3World::convertDiplomacy(const V2World& sourceWorld, const CountryMappin
 				HoI3Agreement hoi3a;
 				hoi3a.country1 = country.first;
 				hoi3a.country2 = relationItr.first;
-				hoi3a.start_date = date("1930.1.1"); // Arbitrary date
+				hoi3a.start_date = date(1930, 1, 1); // Arbitrary date
 				hoi3a.type = "guarantee";
 				diplomacy.addAgreement(hoi3a);
 			}
@@ -2089,18 +2059,18 @@ void HoI3World::copyFlags(const V2World &sourceWorld, const CountryMapping& coun
 	LOG(LogLevel::Debug) << "Copying flags";
 
 	// Create output folders.
-	std::string outputGraphicsFolder = "Output\\" + Configuration::getOutputName() + "\\gfx";
-	if (!WinUtils::TryCreateFolder(outputGraphicsFolder))
+	std::string outputGraphicsFolder = "output/" + Configuration::getOutputName() + "/gfx";
+	if (!Utils::TryCreateFolder(outputGraphicsFolder))
 	{
 		return;
 	}
-	std::string outputFlagFolder = outputGraphicsFolder + "\\flags";
-	if (!WinUtils::TryCreateFolder(outputFlagFolder))
+	std::string outputFlagFolder = outputGraphicsFolder + "/flags";
+	if (!Utils::TryCreateFolder(outputFlagFolder))
 	{
 		return;
 	}
 
-	const std::string folderPath = Configuration::getV2Path() + "\\gfx\\flags";
+	const std::string folderPath = Configuration::getV2Path() + "/gfx/flags";
 	for (auto country: sourceWorld.getCountries())
 	{
 		std::string V2Tag = country.first;
@@ -2112,11 +2082,11 @@ void HoI3World::copyFlags(const V2World &sourceWorld, const CountryMapping& coun
 		vector<string> mods = Configuration::getVic2Mods();
 		for (auto mod: mods)
 		{
-			string sourceFlagPath = Configuration::getV2Path() + "\\mod\\" + mod + "\\gfx\\flags\\"+ V2FlagFile;
-			if (WinUtils::DoesFileExist(sourceFlagPath))
+			string sourceFlagPath = Configuration::getV2Path() + "/mod/" + mod + "/gfx/flags/"+ V2FlagFile;
+			if (Utils::DoesFileExist(sourceFlagPath))
 			{
-				std::string destFlagPath = outputFlagFolder + '\\' + HoI3Tag + ".tga";
-				flagCopied = WinUtils::TryCopyFile(sourceFlagPath, destFlagPath);
+				std::string destFlagPath = outputFlagFolder + '/' + HoI3Tag + ".tga";
+				flagCopied = Utils::TryCopyFile(sourceFlagPath, destFlagPath);
 				if (flagCopied)
 				{
 					break;
@@ -2125,11 +2095,11 @@ void HoI3World::copyFlags(const V2World &sourceWorld, const CountryMapping& coun
 		}
 		if (!flagCopied)
 		{
-			std::string sourceFlagPath = folderPath + '\\' + V2FlagFile;
-			if (WinUtils::DoesFileExist(sourceFlagPath))
+			std::string sourceFlagPath = folderPath + '/' + V2FlagFile;
+			if (Utils::DoesFileExist(sourceFlagPath))
 			{
-				std::string destFlagPath = outputFlagFolder + '\\' + HoI3Tag + ".tga";
-				WinUtils::TryCopyFile(sourceFlagPath, destFlagPath);
+				std::string destFlagPath = outputFlagFolder + '/' + HoI3Tag + ".tga";
+				Utils::TryCopyFile(sourceFlagPath, destFlagPath);
 			}
 		}
 	}
@@ -74,7 +74,7 @@ class HoI3World
 		unitTypeMapping			getUnitMappings();
 		vector<int>					getPortLocationCandidates(const vector<int>& locationCandidates, const HoI3AdjacencyMapping& HoI3AdjacencyMap);
 		int							getAirLocation(HoI3Province* locationProvince, const HoI3AdjacencyMapping& HoI3AdjacencyMap, string owner);
-		vector<HoI3Regiment*>	convertRegiments(const unitTypeMapping& unitTypeMap, vector<V2Regiment*>& sourceRegiments, map<string, unsigned>& typeCount, const pair<string, HoI3Country*>& country);
+		vector<HoI3Regiment*>	convertRegiments(const unitTypeMapping& unitTypeMap, const vector<V2Regiment*>& sourceRegiments, map<string, unsigned>& typeCount, const pair<string, HoI3Country*>& country);
 		HoI3RegGroup*				createArmy(const inverseProvinceMapping& inverseProvinceMap, const HoI3AdjacencyMapping& HoI3AdjacencyMap, string tag, const V2Army* oldArmy, vector<HoI3Regiment*>& sourceRegiments, int& airForceIndex);
 
 		void	outputCommonCountries() const;
@@ -25,9 +25,10 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 #include "Log.h"
 #include "Configuration.h"
 #include "Object.h"
-#include "V2World\V2World.h"
-#include "V2World\V2Country.h"
-#include "V2World\V2Province.h"
+#include "OSCompatibilityLayer.h"
+#include "V2World/V2World.h"
+#include "V2World/V2Country.h"
+#include "V2World/V2Province.h"
 #include <algorithm>
 #include <sys/stat.h>
 
@@ -120,7 +121,7 @@ vector<int> getHoI3ProvinceNums(inverseProvinceMapping invProvMap, const int v2P
 HoI3AdjacencyMapping initHoI3AdjacencyMap()
 {
 	FILE* adjacenciesBin = NULL;	// the adjacencies.bin file
-	string filename = Configuration::getHoI3Path() + "\\tfh\\map\\cache\\adjacencies.bin";
+	string filename = Configuration::getHoI3Path() + "/tfh/map/cache/adjacencies.bin";
 	fopen_s(&adjacenciesBin, filename.c_str(), "rb");
 	if (adjacenciesBin == NULL)
 	{
@@ -23,7 +23,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 #include "V2Army.h"
 #include "Log.h"
-#include "ParadoxParser.h"
+#include "ParadoxParser8859_15.h"
 
 
 
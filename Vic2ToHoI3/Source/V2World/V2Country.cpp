@@ -25,12 +25,11 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 #include <algorithm>
 #include <math.h>
 #include <float.h>
-#include <io.h>
 #include <fstream>
 #include <sstream>
 #include "Log.h"
 #include "../Configuration.h"
-#include "ParadoxParser.h"
+#include "ParadoxParser8859_15.h"
 #include "V2Army.h"
 #include "V2Factory.h"
 #include "V2Leader.h"
@@ -22,10 +22,10 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 
 #include "V2Localisation.h"
-#include <Windows.h>
+#include <algorithm>
 #include <fstream>
 #include "Log.h"
-#include "..\WinUtils.h"
+#include "OSCompatibilityLayer.h"
 #include "Object.h"
 
 
@@ -97,38 +97,8 @@ std::string V2Localisation::convertCountryFileName(const std::string countryFile
 
 std::string V2Localisation::Convert(const std::string& text)
 {
-	if (text.empty())
-	{
-		return "";
-	}
-
-	int utf16Size = MultiByteToWideChar(CP_UTF8, 0, text.c_str(), text.size(), NULL, 0);
-	if (utf16Size == 0)
-	{
-		LOG(LogLevel::Warning) << "Can't convert \"" << text << "\" to UTF-16: " << WinUtils::GetLastWindowsError();
-		return "";
-	}
-	std::vector<wchar_t> utf16Text(utf16Size, L'\0');
-	int result = MultiByteToWideChar(CP_UTF8, 0, text.c_str(), text.size(), &utf16Text[0], utf16Size);
-	if (result == 0)
-	{
-		LOG(LogLevel::Warning) << "Can't convert \"" << text << "\" to UTF-16: " << WinUtils::GetLastWindowsError();
-		return "";
-	}
-	int latin1Size = WideCharToMultiByte(1252, WC_NO_BEST_FIT_CHARS | WC_COMPOSITECHECK | WC_DEFAULTCHAR, &utf16Text[0], utf16Size, NULL, 0, "0", NULL);
-	if (latin1Size == 0)
-	{
-		LOG(LogLevel::Warning) << "Can't convert \"" << text << "\" to Latin-1: " << WinUtils::GetLastWindowsError();
-		return "";
-	}
-	std::vector<char> latin1Text(latin1Size, '\0');
-	result = WideCharToMultiByte(1252, WC_NO_BEST_FIT_CHARS | WC_COMPOSITECHECK | WC_DEFAULTCHAR, &utf16Text[0], utf16Size, &latin1Text[0], latin1Size, "0", NULL);
-	if (result == 0)
-	{
-		LOG(LogLevel::Warning) << "Can't convert \"" << text << "\" to Latin-1: " << WinUtils::GetLastWindowsError();
-		return "";
-	}
-	return std::string(latin1Text.begin(), latin1Text.end());
+	// characters with no Latin-1 equivalent become '0', as they did through the Windows API
+	return Utils::convertUTF8To8859_15(text);
 }
 
 
@@ -174,26 +144,13 @@ void V2Localisation::ReadFromFile(const std::string& fileName)
 void V2Localisation::ReadFromAllFilesInFolder(const std::string& folderPath)
 {
 	// Get all files in the folder.
-	std::vector<std::string> fileNames;
-	WIN32_FIND_DATA findData;	// the file data
-	HANDLE findHandle = FindFirstFile((folderPath + "\\*").c_str(), &findData);	// the find handle
-	if (findHandle == INVALID_HANDLE_VALUE)
-	{
-		return;
-	}
-	do
-	{
-		if (!(findData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY))
-		{
-			fileNames.push_back(findData.cFileName);
-		}
-	} while (FindNextFile(findHandle, &findData) != 0);
-	FindClose(findHandle);
+	std::set<std::string> fileNames;
+	Utils::GetAllFilesInFolder(folderPath, fileNames);
 
 	// Read all these files.
 	for (const auto& fileName : fileNames)
 	{
-		ReadFromFile(folderPath + '\\' + fileName);
+		ReadFromFile(folderPath + '/' + fileName);
 	}
 }
 
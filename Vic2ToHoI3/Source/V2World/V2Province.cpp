@@ -25,6 +25,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 #include "Log.h"
 #include "Object.h"
 #include "V2Pop.h"
+#include <algorithm>
 using namespace std;
 
 
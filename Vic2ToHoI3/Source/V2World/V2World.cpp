@@ -23,11 +23,10 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 #include "V2World.h"
 #include <fstream>
-#include <sys/stat.h>
-#include "ParadoxParser.h"
+#include "ParadoxParser8859_15.h"
 #include "Log.h"
 #include "../Configuration.h"
-#include "../WinUtils.h"
+#include "OSCompatibilityLayer.h"
 #include "V2Province.h"
 #include "V2Relations.h"
 #include "V2Army.h"
@@ -150,11 +149,11 @@ V2World::V2World(Object* obj, const inventionNumToName& iNumToName, map<string,
 	vector<string> vic2Mods = Configuration::getVic2Mods();
 	for (auto itr: vic2Mods)
 	{
-		readCountryFiles(Configuration::getV2Path() + "\\mod\\" + itr + "\\common\\countries.txt", itr);
+		readCountryFiles(Configuration::getV2Path() + "/mod/" + itr + "/common/countries.txt", itr);
 	}
 	if (vic2Mods.size() == 0)
 	{
-		readCountryFiles(Configuration::getV2Path() + "\\common\\countries.txt", "");
+		readCountryFiles(Configuration::getV2Path() + "/common/countries.txt", "");
 	}
 }
 
@@ -271,7 +270,6 @@ void V2World::removeEmptyNations()
 
 void V2World::readCountryFiles(string countryListFile, string mod)
 {
-	struct _stat st;
 	ifstream V2CountriesInput;
 	V2CountriesInput.open(countryListFile.c_str());
 	if (!V2CountriesInput.is_open())
@@ -312,10 +310,10 @@ void V2World::readCountryFiles(string countryListFile, string mod)
 		string file;
 		if (mod != "")
 		{
-			file = Configuration::getV2Path() + "\\mod\\" + mod + "\\common\\countries\\" + countryFileName;
-			if (_stat(file.c_str(), &st) == 0)
+			file = Configuration::getV2Path() + "/mod/" + mod + "/common/countries/" + countryFileName;
+			if (Utils::DoesFileExist(file))
 			{
-				countryData = doParseFile(file.c_str());
+				countryData = parser_8859_15::doParseFile(file.c_str());
 				if (countryData == NULL)
 				{
 					LOG(LogLevel::Warning) << "Could not parse file " << file;
@@ -324,10 +322,10 @@ void V2World::readCountryFiles(string countryListFile, string mod)
 		}
 		if (countryData == NULL)
 		{
-			file = Configuration::getV2Path() +  "\\common\\countries\\" + countryFileName;
-			if (_stat(file.c_str(), &st) == 0)
+			file = Configuration::getV2Path() +  "/common/countries/" + countryFileName;
+			if (Utils::DoesFileExist(file))
 			{
-				countryData = doParseFile(file.c_str());
+				countryData = parser_8859_15::doParseFile(file.c_str());
 				if (countryData == NULL)
 				{
 					LOG(LogLevel::Warning) << "Could not parse file " << file;
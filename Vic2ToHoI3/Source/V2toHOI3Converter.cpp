@@ -22,20 +22,17 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 
 #include <fstream>
-#include <io.h>
 #include <stdexcept>
-#include <sys/stat.h>
-
-#include <Windows.h>
 
 #include "Configuration.h"
 #include "Log.h"
-#include "ParadoxParser.h"
-#include "HOI3World\HoI3World.h"
-#include "V2World\V2World.h"
-#include "V2World\V2Factory.h"
-#include "V2World\V2Localisation.h"
-#include "WinUtils.h"
+#include "ParadoxParser8859_15.h"
+#include "Profiler.h"
+#include "HOI3World/HoI3World.h"
+#include "V2World/V2World.h"
+#include "V2World/V2Factory.h"
+#include "V2World/V2Localisation.h"
+#include "OSCompatibilityLayer.h"
 
 
 // Converts the given V2 save into a HOI3 mod.
@@ -45,17 +42,15 @@ int ConvertV2ToHoI3(const std::string& V2SaveFileName)
 	LOG(LogLevel::Info) << "Converter version 1.2";
 	Object*	obj;					// generic object
 
+	ProfilePhase phase("Reading configuration");	// times each stage of the conversion
 	Configuration::getInstance();
 
-	char curDir[MAX_PATH];
-	GetCurrentDirectory(MAX_PATH, curDir);
-	LOG(LogLevel::Debug) << "Current directory is " << curDir;
+	LOG(LogLevel::Debug) << "Current directory is " << Utils::getCurrentDirectory();
 
 	// Get HoI3 install location
 	LOG(LogLevel::Debug) << "Get HoI3 Install Path";
 	string HoI3Loc = Configuration::getHoI3Path();	// the HOI3 install location as stated in the configuration file
-	struct _stat st;										// the file info
-	if (HoI3Loc.empty() || (_stat(HoI3Loc.c_str(), &st) != 0))
+	if (HoI3Loc.empty() || !Utils::doesFolderExist(HoI3Loc))
 	{
 		LOG(LogLevel::Error) << "No HoI3 path was specified in configuration.txt, or the path was invalid";
 		return (-1);
@@ -68,7 +63,7 @@ int ConvertV2ToHoI3(const std::string& V2SaveFileName)
 	// Get HOI3 Documents Directory
 	LOG(LogLevel::Debug) << "Get HOI3 Documents directory";
 	string HoI3DocLoc = Configuration::getHoI3DocumentsPath();	// the HoI3 My Documents location as stated in the configuration file
-	if (HoI3DocLoc.empty() || (_stat(HoI3DocLoc.c_str(), &st) != 0))
+	if (HoI3DocLoc.empty() || !Utils::doesFolderExist(HoI3DocLoc))
 	{
 		LOG(LogLevel::Error) << "No HoI3 documents directory was specified in configuration.txt, or the path was invalid";
 		return (-1);
@@ -81,7 +76,7 @@ int ConvertV2ToHoI3(const std::string& V2SaveFileName)
 	// Get V2 install location
 	LOG(LogLevel::Debug) << "Get V2 Install Path";
 	string V2Loc = Configuration::getV2Path();	// the V2 install location as stated in the configuration file
-	if (V2Loc.empty() || (_stat(V2Loc.c_str(), &st) != 0))
+	if (V2Loc.empty() || !Utils::doesFolderExist(V2Loc))
 	{
 		LOG(LogLevel::Error) << "No Victoria 2 path was specified in configuration.txt, or the path was invalid";
 		return (-1);
@@ -95,7 +90,7 @@ int ConvertV2ToHoI3(const std::string& V2SaveFileName)
 	map<string, string> possibleMods; // name, path
 	LOG(LogLevel::Debug) << "Get V2 Documents Directory";
 	string V2DocumentsLoc = Configuration::getV2DocumentsPath();	// the Victoria 2 My Documents location as stated in the configuration file
-	if (V2DocumentsLoc.empty() || (_stat(V2DocumentsLoc.c_str(), &st) != 0))
+	if (V2DocumentsLoc.empty() || !Utils::doesFolderExist(V2DocumentsLoc))
 	{
 		LOG(LogLevel::Error) << "No Victoria 2 documents directory was specified in configuration.txt, or the path was invalid";
 		return (-1);
@@ -114,14 +109,14 @@ int ConvertV2ToHoI3(const std::string& V2SaveFileName)
 	}
 
 	set<string> fileNames;
-	WinUtils::GetAllFilesInFolder(Configuration::getV2Path() + "\\mod", fileNames);
+	Utils::GetAllFilesInFolder(Configuration::getV2Path() + "/mod", fileNames);
 	for (set<string>::iterator itr = fileNames.begin(); itr != fileNames.end(); itr++)
 	{
 		const int pos = itr->find_last_of('.');	// the position of the last period in the filename
 		if (itr->substr(pos, itr->length()) == ".mod")
 		{
 			string folderName = itr->substr(0, pos);
-			if (WinUtils::doesFolderExist(Configuration::getV2Path() + "\\mod\\" + folderName))
+			if (Utils::doesFolderExist(Configuration::getV2Path() + "/mod/" + folderName))
 			{
 				LOG(LogLevel::Debug) << "\tFound mod with name " << folderName;
 			}
@@ -136,7 +131,7 @@ int ConvertV2ToHoI3(const std::string& V2SaveFileName)
 	// parse technologies
 	LOG(LogLevel::Info) << "Parsing Vic2 technologies";
 	map<string, string> armyTechs;
-	obj = doParseFile((Configuration::getV2Path() + "\\technologies\\army_tech.txt").c_str());
+	obj = parser_8859_15::doParseFile((Configuration::getV2Path() + "/technologies/army_tech.txt").c_str());
 	if (obj != NULL)
 	{
 		for (auto tech: obj->getLeaves())
@@ -145,7 +140,7 @@ int ConvertV2ToHoI3(const std::string& V2SaveFileName)
 		}
 	}
 	map<string, string> navyTechs;
-	obj = doParseFile((Configuration::getV2Path() + "\\technologies\\navy_tech.txt").c_str());
+	obj = parser_8859_15::doParseFile((Configuration::getV2Path() + "/technologies/navy_tech.txt").c_str());
 	if (obj != NULL)
 	{
 		for (auto tech: obj->getLeaves())
@@ -157,14 +152,14 @@ int ConvertV2ToHoI3(const std::string& V2SaveFileName)
 	// parse continents
 	LOG(LogLevel::Info) << "Parsing continents";
 	continentMapping continentMap;
-	obj = doParseFile((Configuration::getV2Path() + "\\map\\continent.txt").c_str());
+	obj = parser_8859_15::doParseFile((Configuration::getV2Path() + "/map/continent.txt").c_str());
 	if (obj != NULL)
 	{
 		initContinentMap(obj, continentMap);
 	}
 
 	//get output name
-	const int slash	= V2SaveFileName.find_last_of("\\");				// the last slash in the save's filename
+	const int slash	= V2SaveFileName.find_last_of("/\\");				// the last slash in the save's filename
 	string outputName = V2SaveFileName.substr(slash + 1, V2SaveFileName.length());
 	const int length	= outputName.find_first_of(".");						// the first period after the slash
 	outputName			= outputName.substr(0, length);						// the name to use to output the mod
@@ -183,17 +178,18 @@ int ConvertV2ToHoI3(const std::string& V2SaveFileName)
 	Configuration::setOutputName(outputName);
 	LOG(LogLevel::Info) << "Using output name " << outputName;
 
-	string outputFolder = string(curDir) + "\\output\\" + Configuration::getOutputName();
-	if (WinUtils::doesFolderExist(outputFolder.c_str()))
+	string outputFolder = Utils::getCurrentDirectory() + "/output/" + Configuration::getOutputName();
+	if (Utils::doesFolderExist(outputFolder))
 	{
 		LOG(LogLevel::Error) << "Output folder " << Configuration::getOutputName() << " already exists! Clear the output folder before running again!";
 		exit(0);
 	}
 
 	// Parse government mapping
+	phase.next("Parsing mappings");
 	LOG(LogLevel::Info) << "Parsing governments mappings";
-	initParser();
-	obj = doParseFile("governmentMapping.txt");
+	parser_8859_15::initParser();
+	obj = parser_8859_15::doParseFile("governmentMapping.txt");
 	if (obj == NULL)
 	{
 		LOG(LogLevel::Error) << "Could not parse file governmentMapping.txt";
@@ -205,9 +201,9 @@ int ConvertV2ToHoI3(const std::string& V2SaveFileName)
 	LOG(LogLevel::Info) << "Parsing governments reforms";
 	for (auto itr : vic2Mods)
 	{
-		if (WinUtils::DoesFileExist(Configuration::getV2Path() + "\\mod\\" + itr + "\\common\\issues.txt"))
+		if (Utils::DoesFileExist(Configuration::getV2Path() + "/mod/" + itr + "/common/issues.txt"))
 		{
-			obj = doParseFile((Configuration::getV2Path() + "\\mod\\" + itr + "\\common\\issues.txt").c_str());
+			obj = parser_8859_15::doParseFile((Configuration::getV2Path() + "/mod/" + itr + "/common/issues.txt").c_str());
 			if (obj != NULL)
 			{
 				governmentMapper::getInstance()->initReforms(obj);
@@ -217,18 +213,19 @@ int ConvertV2ToHoI3(const std::string& V2SaveFileName)
 	}
 	if (!governmentMapper::getInstance()->areReformsInitialized())
 	{
-		obj = doParseFile((Configuration::getV2Path() + "\\common\\issues.txt").c_str());
+		obj = parser_8859_15::doParseFile((Configuration::getV2Path() + "/common/issues.txt").c_str());
 		if (obj != NULL)
 		{
 			governmentMapper::getInstance()->initReforms(obj);
 		}
 	}
 
+	phase.next("Importing V2 save");
 	LOG(LogLevel::Info) << "* Importing V2 save *";
 
 	//	Parse V2 Save
 	LOG(LogLevel::Info) << "Parsing save";
-	obj = doParseFile(V2SaveFileName.c_str());
+	obj = parser_8859_15::doParseFile(V2SaveFileName.c_str());
 	if (obj == NULL)
 	{
 		LOG(LogLevel::Error) << "Could not parse file " << V2SaveFileName << ". File is likely missing.";
@@ -242,11 +239,11 @@ int ConvertV2ToHoI3(const std::string& V2SaveFileName)
 	// Read all localisations.
 	LOG(LogLevel::Info) << "Reading localisation";
 	V2Localisation localisation;
-	localisation.ReadFromAllFilesInFolder(Configuration::getV2Path() + "\\localisation");
+	localisation.ReadFromAllFilesInFolder(Configuration::getV2Path() + "/localisation");
 	for (auto itr: vic2Mods)
 	{
 		LOG(LogLevel::Debug) << "Reading mod localisation";
-		localisation.ReadFromAllFilesInFolder(Configuration::getV2Path() + "\\mod\\" + itr + "\\localisation");
+		localisation.ReadFromAllFilesInFolder(Configuration::getV2Path() + "/mod/" + itr + "/localisation");
 	}
 
 	sourceWorld.setLocalisations(localisation);
@@ -254,7 +251,7 @@ int ConvertV2ToHoI3(const std::string& V2SaveFileName)
 
 	// Merge nations
 	LOG(LogLevel::Info) << "Merging nations";
-	obj = doParseFile("merge_nations.txt");
+	obj = parser_8859_15::doParseFile("merge_nations.txt");
 	if (obj == NULL)
 	{
 		LOG(LogLevel::Error) << "Could not parse file merge_nations.txt";
@@ -263,8 +260,9 @@ int ConvertV2ToHoI3(const std::string& V2SaveFileName)
 	mergeNations(sourceWorld, obj);
 
 	// Parse province mappings
+	phase.next("Importing HoI3 data");
 	LOG(LogLevel::Info) << "Parsing province mappings";
-	obj = doParseFile("province_mappings.txt");
+	obj = parser_8859_15::doParseFile("province_mappings.txt");
 	if (obj == NULL)
 	{
 		LOG(LogLevel::Error) << "Could not parse file province_mappings.txt";
@@ -297,8 +295,8 @@ int ConvertV2ToHoI3(const std::string& V2SaveFileName)
 
 	// Parse government jobs
 	LOG(LogLevel::Info) << "Parsing government jobs";
-	initParser();
-	obj = doParseFile("governmentJobs.txt");
+	parser_8859_15::initParser();
+	obj = parser_8859_15::doParseFile("governmentJobs.txt");
 	if (obj == NULL)
 	{
 		LOG(LogLevel::Error) << "Could not parse file governmentJobs.txt";
@@ -309,8 +307,8 @@ int ConvertV2ToHoI3(const std::string& V2SaveFileName)
 
 	// Parse leader traits
 	LOG(LogLevel::Info) << "Parsing government jobs";
-	initParser();
-	obj = doParseFile("leader_traits.txt");
+	parser_8859_15::initParser();
+	obj = parser_8859_15::doParseFile("leader_traits.txt");
 	if (obj == NULL)
 	{
 		LOG(LogLevel::Error) << "Could not parse file leader_traits.txt";
@@ -326,13 +324,13 @@ int ConvertV2ToHoI3(const std::string& V2SaveFileName)
 	for (auto itr: vic2Mods)
 	{
 		LOG(LogLevel::Debug) << "Reading mod cultures";
-		obj = doParseFile((Configuration::getV2Path() + "\\mod\\" + itr + "\\common\\cultures.txt").c_str());
+		obj = parser_8859_15::doParseFile((Configuration::getV2Path() + "/mod/" + itr + "/common/cultures.txt").c_str());
 		if (obj != NULL)
 		{
 			initNamesMapping(obj, namesMap);
 		}
 	}
-	obj = doParseFile((Configuration::getV2Path() + "\\common\\cultures.txt").c_str());
+	obj = parser_8859_15::doParseFile((Configuration::getV2Path() + "/common/cultures.txt").c_str());
 	if (obj != NULL)
 	{
 		initNamesMapping(obj, namesMap);
@@ -341,7 +339,7 @@ int ConvertV2ToHoI3(const std::string& V2SaveFileName)
 	// parse portraits list
 	LOG(LogLevel::Info) << "Parsing portraits list";
 	portraitMapping portraitMap;
-	obj = doParseFile("portraits.txt");
+	obj = parser_8859_15::doParseFile("portraits.txt");
 	if (obj != NULL)
 	{
 		initPortraitMapping(obj, portraitMap);
@@ -349,7 +347,7 @@ int ConvertV2ToHoI3(const std::string& V2SaveFileName)
 
 	// parse culture mapping
 	LOG(LogLevel::Info) << "Parsing culture mappings";
-	obj = doParseFile("culture_map.txt");
+	obj = parser_8859_15::doParseFile("culture_map.txt");
 	if (obj == NULL)
 	{
 		LOG(LogLevel::Error) << "Could not parse file culture_map.txt";
@@ -365,7 +363,7 @@ int ConvertV2ToHoI3(const std::string& V2SaveFileName)
 
 	// parse personality mapping
 	LOG(LogLevel::Info) << "Parsing personality mappings";
-	obj = doParseFile("personality_map.txt");
+	obj = parser_8859_15::doParseFile("personality_map.txt");
 	if (obj == NULL)
 	{
 		LOG(LogLevel::Error) << "Could not parse file personality_map.txt";
@@ -382,7 +380,7 @@ int ConvertV2ToHoI3(const std::string& V2SaveFileName)
 
 	// parse background mapping
 	LOG(LogLevel::Info) << "Parsing background mappings";
-	obj = doParseFile("background_map.txt");
+	obj = parser_8859_15::doParseFile("background_map.txt");
 	if (obj == NULL)
 	{
 		LOG(LogLevel::Error) << "Could not parse file background_map.txt";
@@ -399,7 +397,7 @@ int ConvertV2ToHoI3(const std::string& V2SaveFileName)
 
 	// parse AI focus data
 	LOG(LogLevel::Info) << "Parsing AI focuses";
-	obj = doParseFile("ai_focus.txt");
+	obj = parser_8859_15::doParseFile("ai_focus.txt");
 	if (obj == NULL)
 	{
 		LOG(LogLevel::Error) << "Could not parse file ai_focus.txt";
@@ -414,6 +412,7 @@ int ConvertV2ToHoI3(const std::string& V2SaveFileName)
 	initAIFocusModifiers(obj, focusModifiers);
 
 	// Convert
+	phase.next("Converting");
 	LOG(LogLevel::Info) << "Converting countries";
 	destWorld.convertCountries(sourceWorld, countryMap, inverseProvinceMap, leaderIDMap, localisation, governmentJobs, leaderTraits, namesMap, portraitMap, cultureMap, landPersonalityMap, seaPersonalityMap, landBackgroundMap, seaBackgroundMap);
 	LOG(LogLevel::Info) << "Converting provinces";
@@ -439,11 +438,15 @@ int ConvertV2ToHoI3(const std::string& V2SaveFileName)
 	destWorld.setAIFocuses(focusModifiers);
 
 	// Output results
+	phase.next("Outputting mod");
 	LOG(LogLevel::Info) << "Outputting mod";
-	system("%systemroot%\\System32\\xcopy blankMod output /E /Q /Y /I");
+	if (!Utils::copyFolder("blankMod/output", "output/output"))
+	{
+		exit(-1);
+	}
 
 	FILE* modFile;	// the .mod file for this mod
-	if (fopen_s(&modFile, ("Output\\" + Configuration::getOutputName() + ".mod").c_str(), "w") != 0)
+	if (fopen_s(&modFile, ("output/" + Configuration::getOutputName() + ".mod").c_str(), "w") != 0)
 	{
 		LOG(LogLevel::Error) << "Could not create .mod file";
 		exit(-1);
@@ -458,15 +461,22 @@ int ConvertV2ToHoI3(const std::string& V2SaveFileName)
 	fprintf(modFile, "replace_path = \"events\"\n");
 	fprintf(modFile, "replace_path = \"decisions\"\n");
 	fclose(modFile);
-	string renameCommand = "move /Y output\\output output\\" + Configuration::getOutputName();	// the command to rename the mod correctly
-	system(renameCommand.c_str());
+	if (!Utils::renameFolder("output/output", "output/" + Configuration::getOutputName()))
+	{
+		exit(-1);
+	}
 	LOG(LogLevel::Info) << "Copying flags";
 	destWorld.copyFlags(sourceWorld, countryMap);
 
 	LOG(LogLevel::Info) << "Outputting world";
 	destWorld.output();
+	phase.end();
 
 	LOG(LogLevel::Info) << "* Conversion complete *";
+	if (!Profiler::getInstance().writeReport("Vic2ToHoI3"))
+	{
+		LOG(LogLevel::Warning) << "Could not write the profiling report";
+	}
 	return 0;
 }
 
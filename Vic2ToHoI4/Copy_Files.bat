@@ -20,6 +20,9 @@ copy "Data_Files\navalprovinces.txt" "release\navalprovinces.txt"
 copy "Data_Files\positions.txt" "release\positions.txt"
 copy "Data_Files\adj.txt" "release\adj.txt"
 
+rem **Copy script templates**
+xcopy "Data_Files\scriptTemplates" "release\scriptTemplates" /Y /E /I
+
 rem **Copy flags**
 xcopy "Data_Files\flags" "release\flags" /Y /E /I
 
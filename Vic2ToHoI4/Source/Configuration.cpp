@@ -23,6 +23,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 #include "Configuration.h"
 #include "ParadoxParserUTF8.h"
+#include "ParsedFileCache.h"
 #include "Object.h"
 #include "Log.h"
 #include <vector>
@@ -50,6 +51,12 @@ Configuration::Configuration()
 		exit (-1);
 	}
 
+	string logLevel = obj[0]->safeGetString("logLevel");	// the least important messages to log
+	if ((logLevel != "") && !Log::setLevel(logLevel))
+	{
+		LOG(LogLevel::Warning) << "Unknown log level " << logLevel << ", logging everything";
+	}
+
 	V2Path				= obj[0]->getLeaf("V2directory");
 	HoI4Path				= obj[0]->getLeaf("HoI4directory");
 	HoI4DocumentsPath = obj[0]->getLeaf("HoI4Documentsdirectory");
@@ -61,6 +68,13 @@ Configuration::Configuration()
 		Vic2Mods = modsObj[0]->getTokens();
 	}
 
+	// where mods disagree the converter uses the first one listed, so that one is added last
+	Vic2Files.addLayer("", V2Path, "mod");
+	for (auto mod = Vic2Mods.rbegin(); mod != Vic2Mods.rend(); ++mod)
+	{
+		Vic2Files.addLayer(*mod, V2Path + "/mod/" + *mod);
+	}
+
 	manpowerFactor			= stof(obj[0]->getLeaf("manpower_factor"));
 	industrialShapeFactor= stof(obj[0]->getLeaf("industrial_shape_factor"));
 	icFactor					= stof(obj[0]->getLeaf("ic_factor"));
@@ -75,4 +89,11 @@ Configuration::Configuration()
 
 	leaderID					= 1000;
 	leaderIDCountryIdx	= 1;
+
+	string parsedFileCache = obj[0]->safeGetString("parsedFileCache");	// where to keep parsed game and converter data between runs
+	if (parsedFileCache != "")
+	{
+		LOG(LogLevel::Debug) << "Caching parsed files in " << parsedFileCache;
+		ParsedFileCache::setSharedDirectory(parsedFileCache);
+	}
 }
\ No newline at end of file
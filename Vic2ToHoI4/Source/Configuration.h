@@ -27,6 +27,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 #include <string>
 #include <vector>
+#include "VirtualFileSystem.h"
 using namespace std;
 
 
@@ -56,6 +57,11 @@ class Configuration // Singleton
 			return getInstance()->Vic2Mods;
 		}
 
+		static const VirtualFileSystem& getVic2Files()
+		{
+			return getInstance()->Vic2Files;
+		}
+
 		static void setOutputName(string name)
 		{
 			getInstance()->outputName = name;
@@ -113,6 +119,7 @@ class Configuration // Singleton
 		string			HoI4DocumentsPath;	// HoI4's directory under My Documents
 		string			V2Path;					// the install directory for V2
 		vector<string>	Vic2Mods;
+		VirtualFileSystem	Vic2Files;			// the files in the V2 install and mods, with the first mod listed on top
 		string			outputName;				// the name the outputted mod should have
 
 		double			manpowerFactor;
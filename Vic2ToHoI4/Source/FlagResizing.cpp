@@ -0,0 +1,232 @@
+/*Copyright (c) 2016 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#include "FlagResizing.h"
+#include <algorithm>
+#include <cstring>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#define FLAGS_USE_SSE2
+#include <emmintrin.h>
+#endif
+
+
+
+bool getFlagPixels(tga_image* flag, vector<uint8_t>& pixels)
+{
+	// bring every flag to bottom-up, left-to-right BGRA, whatever depth and layout it was saved with
+	if (tga_is_colormapped(flag) && (tga_color_unmap(flag) != TGA_NOERR))
+	{
+		return false;
+	}
+	if (tga_is_top_to_bottom(flag) && (tga_flip_vert(flag) != TGA_NOERR))
+	{
+		return false;
+	}
+	if (tga_is_right_to_left(flag) && (tga_flip_horiz(flag) != TGA_NOERR))
+	{
+		return false;
+	}
+
+	const bool hasAlpha = (tga_get_attribute_bits(flag) != 0);
+	const unsigned int bytesPerPixel = flag->pixel_depth / 8;
+	const size_t pixelCount = static_cast<size_t>(flag->width) * flag->height;
+	pixels.resize(pixelCount * 4);
+	for (size_t i = 0; i < pixelCount; i++)
+	{
+		uint8_t* pixel = &pixels[i * 4];
+		if (tga_unpack_pixel(&flag->image_data[i * bytesPerPixel], flag->pixel_depth, &pixel[0], &pixel[1], &pixel[2], &pixel[3]) != TGA_NOERR)
+		{
+			return false;
+		}
+		if (!hasAlpha)
+		{
+			pixel[3] = 255;
+		}
+	}
+
+	return true;
+}
+
+
+vector<resizeSpan> getResizeSpans(unsigned int sourceLength, unsigned int destLength)
+{
+	// each destination pixel is the average of the area of the source it covers, counting partly covered pixels by
+	// how much of them it covers
+	const double scale = static_cast<double>(sourceLength) / destLength;
+	vector<resizeSpan> spans(destLength);
+	for (unsigned int i = 0; i < destLength; i++)
+	{
+		const double start = i * scale;
+		const double end = min((i + 1) * scale, static_cast<double>(sourceLength));
+		spans[i].first = static_cast<unsigned int>(start);
+		for (unsigned int j = spans[i].first; (j < sourceLength) && (j < end); j++)
+		{
+			double covered = min(end, j + 1.0) - max(start, static_cast<double>(j));
+			spans[i].weights.push_back(static_cast<float>(covered / (end - start)));
+		}
+	}
+
+	return spans;
+}
+
+
+#ifdef FLAGS_USE_SSE2
+static inline __m128 loadFlagPixel(const uint8_t* pixel)
+{
+	int packed;
+	memcpy(&packed, pixel, sizeof(packed));
+	__m128i bytes = _mm_cvtsi32_si128(packed);
+	__m128i words = _mm_unpacklo_epi8(bytes, _mm_setzero_si128());
+	return _mm_cvtepi32_ps(_mm_unpacklo_epi16(words, _mm_setzero_si128()));
+}
+
+
+static inline void storeFlagPixel(__m128 channels, uint8_t* pixel)
+{
+	__m128i rounded = _mm_cvttps_epi32(_mm_add_ps(channels, _mm_set1_ps(0.5f)));
+	__m128i words = _mm_packs_epi32(rounded, rounded);
+	int packed = _mm_cvtsi128_si32(_mm_packus_epi16(words, words));
+	memcpy(pixel, &packed, sizeof(packed));
+}
+#endif
+
+
+void resizeFlagScalar(const vector<uint8_t>& sourcePixels, unsigned int sourceWidth, unsigned int sourceHeight, unsigned int destWidth, unsigned int destHeight, vector<uint8_t>& destPixels)
+{
+	// area averaging separates into a horizontal pass into a float buffer, then a vertical pass out of it
+	const vector<resizeSpan> columns = getResizeSpans(sourceWidth, destWidth);
+	const vector<resizeSpan> rows = getResizeSpans(sourceHeight, destHeight);
+
+	vector<float> narrowed(static_cast<size_t>(destWidth) * sourceHeight * 4);
+	for (unsigned int y = 0; y < sourceHeight; y++)
+	{
+		const uint8_t* sourceRow = &sourcePixels[static_cast<size_t>(y) * sourceWidth * 4];
+		float* narrowedRow = &narrowed[static_cast<size_t>(y) * destWidth * 4];
+		for (unsigned int x = 0; x < destWidth; x++)
+		{
+			const resizeSpan& column = columns[x];
+			const uint8_t* sourcePixel = sourceRow + column.first * 4;
+			float sum[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+			for (size_t i = 0; i < column.weights.size(); i++)
+			{
+				for (unsigned int channel = 0; channel < 4; channel++)
+				{
+					sum[channel] += sourcePixel[i * 4 + channel] * column.weights[i];
+				}
+			}
+			memcpy(narrowedRow + x * 4, sum, sizeof(sum));
+		}
+	}
+
+	destPixels.resize(static_cast<size_t>(destWidth) * destHeight * 4);
+	for (unsigned int y = 0; y < destHeight; y++)
+	{
+		const resizeSpan& row = rows[y];
+		uint8_t* destRow = &destPixels[static_cast<size_t>(y) * destWidth * 4];
+		for (unsigned int x = 0; x < destWidth; x++)
+		{
+			const float* narrowedPixel = &narrowed[(static_cast<size_t>(row.first) * destWidth + x) * 4];
+			const size_t rowStride = static_cast<size_t>(destWidth) * 4;
+			for (unsigned int channel = 0; channel < 4; channel++)
+			{
+				float sum = 0.0f;
+				for (size_t i = 0; i < row.weights.size(); i++)
+				{
+					sum += narrowedPixel[i * rowStride + channel] * row.weights[i];
+				}
+				destRow[x * 4 + channel] = static_cast<uint8_t>(min(max(sum + 0.5f, 0.0f), 255.0f));
+			}
+		}
+	}
+}
+
+
+void resizeFlag(const vector<uint8_t>& sourcePixels, unsigned int sourceWidth, unsigned int sourceHeight, unsigned int destWidth, unsigned int destHeight, vector<uint8_t>& destPixels)
+{
+#ifdef FLAGS_USE_SSE2
+	// the same two passes as resizeFlagScalar, with all four channels of a pixel worked on at once
+	const vector<resizeSpan> columns = getResizeSpans(sourceWidth, destWidth);
+	const vector<resizeSpan> rows = getResizeSpans(sourceHeight, destHeight);
+
+	vector<float> narrowed(static_cast<size_t>(destWidth) * sourceHeight * 4);
+	for (unsigned int y = 0; y < sourceHeight; y++)
+	{
+		const uint8_t* sourceRow = &sourcePixels[static_cast<size_t>(y) * sourceWidth * 4];
+		float* narrowedRow = &narrowed[static_cast<size_t>(y) * destWidth * 4];
+		for (unsigned int x = 0; x < destWidth; x++)
+		{
+			const resizeSpan& column = columns[x];
+			const uint8_t* sourcePixel = sourceRow + column.first * 4;
+			__m128 sum = _mm_setzero_ps();
+			for (size_t i = 0; i < column.weights.size(); i++)
+			{
+				sum = _mm_add_ps(sum, _mm_mul_ps(loadFlagPixel(sourcePixel + i * 4), _mm_set1_ps(column.weights[i])));
+			}
+			_mm_storeu_ps(narrowedRow + x * 4, sum);
+		}
+	}
+
+	destPixels.resize(static_cast<size_t>(destWidth) * destHeight * 4);
+	for (unsigned int y = 0; y < destHeight; y++)
+	{
+		const resizeSpan& row = rows[y];
+		uint8_t* destRow = &destPixels[static_cast<size_t>(y) * destWidth * 4];
+		for (unsigned int x = 0; x < destWidth; x++)
+		{
+			const float* narrowedPixel = &narrowed[(static_cast<size_t>(row.first) * destWidth + x) * 4];
+			const size_t rowStride = static_cast<size_t>(destWidth) * 4;
+			__m128 sum = _mm_setzero_ps();
+			for (size_t i = 0; i < row.weights.size(); i++)
+			{
+				sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(narrowedPixel + i * rowStride), _mm_set1_ps(row.weights[i])));
+			}
+			storeFlagPixel(sum, destRow + x * 4);
+		}
+	}
+#else
+	resizeFlagScalar(sourcePixels, sourceWidth, sourceHeight, destWidth, destHeight, destPixels);
+#endif
+}
+
+
+string encodeFlag(const vector<uint8_t>& pixels, unsigned int width, unsigned int height)
+{
+	// an uncompressed 32 bit BGRA targa with eight bits of alpha, laid out as tga_write_to_FILE would write it
+	const uint8_t header[18] = {
+		0, TGA_COLOR_MAP_ABSENT, TGA_IMAGE_TYPE_BGR,
+		0, 0, 0, 0, 0,
+		0, 0, 0, 0,
+		static_cast<uint8_t>(width & 0xFF), static_cast<uint8_t>(width >> 8),
+		static_cast<uint8_t>(height & 0xFF), static_cast<uint8_t>(height >> 8),
+		32, 8
+	};
+	const char footer[26] = "\0\0\0\0\0\0\0\0TRUEVISION-XFILE.";
+
+	string flag;
+	flag.reserve(sizeof(header) + pixels.size() + sizeof(footer));
+	flag.append(reinterpret_cast<const char*>(header), sizeof(header));
+	flag.append(reinterpret_cast<const char*>(pixels.data()), pixels.size());
+	flag.append(footer, sizeof(footer));
+	return flag;
+}
@@ -0,0 +1,64 @@
+/*Copyright (c) 2016 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#ifndef FLAG_RESIZING_H_
+#define FLAG_RESIZING_H_
+
+
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "targa.h"
+using namespace std;
+
+
+
+// Turns the flag's pixels into bottom-up, left-to-right BGRA, eight bits a channel
+bool getFlagPixels(tga_image* flag, vector<uint8_t>& pixels);
+
+
+// The source pixels that make up one pixel of a resized flag along one axis, and how much each contributes
+struct resizeSpan
+{
+	unsigned int	first;		// the first source pixel
+	vector<float>	weights;		// the weights of that pixel and the ones after it, which add up to one
+};
+
+
+// Where each pixel of a resized line comes from in a line of sourceLength pixels
+vector<resizeSpan> getResizeSpans(unsigned int sourceLength, unsigned int destLength);
+
+// Resizes BGRA pixels by averaging the area of the source each new pixel covers. Uses SSE2 where the build has it,
+// and resizeFlagScalar otherwise.
+void resizeFlag(const vector<uint8_t>& sourcePixels, unsigned int sourceWidth, unsigned int sourceHeight, unsigned int destWidth, unsigned int destHeight, vector<uint8_t>& destPixels);
+
+// resizeFlag one channel at a time. Every build has it, so the SSE2 version can be checked against it.
+void resizeFlagScalar(const vector<uint8_t>& sourcePixels, unsigned int sourceWidth, unsigned int sourceHeight, unsigned int destWidth, unsigned int destHeight, vector<uint8_t>& destPixels);
+
+// Wraps BGRA pixels in an uncompressed 32 bit targa
+string encodeFlag(const vector<uint8_t>& pixels, unsigned int width, unsigned int height);
+
+
+
+#endif // FLAG_RESIZING_H_
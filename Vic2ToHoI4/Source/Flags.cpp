@@ -22,24 +22,46 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 
 #include "Flags.h"
+#include <cstring>
 #include "targa.h"
 #include "Log.h"
 #include "Configuration.h"
+#include "FlagResizing.h"
 #include "OSCompatibilityLayer.h"
+#include "OutputWriter.h"
+#include "ParsedFileCache.h"
+#include "ThreadPool.h"
+#include "VirtualFileSystem.h"
 
 
 
+static VirtualFileSystem converterFlags;	// the flags shipped with the converter
+static string flagCacheFolder;				// where resized flags are kept between runs, or "" if they aren't
+
+
 void processFlagsForCountry(const pair<string, HoI4Country*>& country);
 void copyFlags(const map<string, HoI4Country*>& countries)
 {
-	Utils::TryCreateFolder("Output/" + Configuration::getOutputName() + "/gfx");
-	Utils::TryCreateFolder("Output/" + Configuration::getOutputName() + "/gfx/flags");
-	Utils::TryCreateFolder("Output/" + Configuration::getOutputName() + "/gfx/flags/medium");
-	Utils::TryCreateFolder("Output/" + Configuration::getOutputName() + "/gfx/flags/small");
-	for (auto country: countries)
+	converterFlags.addLayer("converter", "flags");
+
+	const ParsedFileCache* cache = ParsedFileCache::getShared();
+	if (cache != nullptr)
 	{
-		processFlagsForCountry(country);
+		flagCacheFolder = cache->getDirectory() + "/flags";
+		Utils::TryCreateFolder(flagCacheFolder);
 	}
+
+	Utils::TryCreateFolder("output/" + Configuration::getOutputName() + "/gfx");
+	Utils::TryCreateFolder("output/" + Configuration::getOutputName() + "/gfx/flags");
+	Utils::TryCreateFolder("output/" + Configuration::getOutputName() + "/gfx/flags/medium");
+	Utils::TryCreateFolder("output/" + Configuration::getOutputName() + "/gfx/flags/small");
+
+	// no country's flags depend on another's, so the countries are shared out across the thread pool
+	vector<pair<string, HoI4Country*>> countryList(countries.begin(), countries.end());
+	ThreadPool::getShared().parallelFor(countryList.size(), [&countryList](size_t i)
+	{
+		processFlagsForCountry(countryList[i]);
+	});
 }
 
 
@@ -83,31 +105,53 @@ char* hoi4Suffixes[FLAG_END] = {
 };
 
 
+enum flagSizes
+{
+	BIG_FLAG		= 0,
+	MEDIUM_FLAG	= 1,
+	SMALL_FLAG	= 2,
+	SIZE_END		= 3
+};
+
+const unsigned int flagWidths[SIZE_END]	= { 82, 41, 10 };
+const unsigned int flagHeights[SIZE_END]	= { 52, 26, 7 };
+const char* flagFolders[SIZE_END] = {
+	"/gfx/flags/",
+	"/gfx/flags/medium/",
+	"/gfx/flags/small/",
+};
+
+
 vector<string> getSourceFlagPaths(string Vic2Tag);
-tga_image* readFlag(string path);
-tga_image* createNewFlag(const tga_image* sourceFlag, unsigned int sizeX, unsigned int sizeY);
-void createBigFlag(tga_image* sourceFlag, string filename);
-void createMediumFlag(tga_image* sourceFlag, string filename);
-void createSmallFlag(tga_image* sourceFlag, string filename);
+bool getResizedFlags(const string& sourcePath, vector<string>& resizedFlags);
 void processFlagsForCountry(const pair<string, HoI4Country*>& country)
 {
+	// several ideologies often share a source flag, so each source is only read and resized once
+	map<string, vector<unsigned int>> ideologiesBySource;
 	vector<string> sourcePath = getSourceFlagPaths(country.second->getSourceCountry()->getTag());
 	for (unsigned int i = BASE_FLAG; i < FLAG_END; i++)
 	{
 		if (sourcePath[i] != "")
 		{
-			tga_image* sourceFlag = readFlag(sourcePath[i]);
-			if (sourceFlag == nullptr)
-			{
-				return;
-			}
+			ideologiesBySource[sourcePath[i]].push_back(i);
+		}
+	}
 
-			createBigFlag(sourceFlag, country.first + hoi4Suffixes[i]);
-			createMediumFlag(sourceFlag, country.first + hoi4Suffixes[i]);
-			createSmallFlag(sourceFlag, country.first + hoi4Suffixes[i]);
+	for (auto source: ideologiesBySource)
+	{
+		vector<string> resizedFlags;
+		if (!getResizedFlags(source.first, resizedFlags))
+		{
+			continue;
+		}
 
-			tga_free_buffers(sourceFlag);
-			delete sourceFlag;
+		for (auto ideology: source.second)
+		{
+			for (unsigned int size = BIG_FLAG; size < SIZE_END; size++)
+			{
+				string path = "output/" + Configuration::getOutputName() + flagFolders[size] + country.first + hoi4Suffixes[ideology];
+				OutputWriter::getShared().writeBinary(path, string(resizedFlags[size]));
+			}
 		}
 	}
 }
@@ -143,24 +187,14 @@ string getConversionModFlag(string flagFilename);
 string getAllowModFlags(string flagFilename);
 string getSourceFlagPath(string Vic2Tag, string sourceSuffix)
 {
-	string path = "flags/" + Vic2Tag + sourceSuffix;
-	if (!Utils::DoesFileExist(path))
+	string path = converterFlags.resolve(Vic2Tag + sourceSuffix);
+	if ((path == "") && isThisAConvertedTag(Vic2Tag))
 	{
-		
-		
-			if (isThisAConvertedTag(Vic2Tag))
-			{
-				path = getConversionModFlag(Vic2Tag + sourceSuffix);
-			}
-			if (!Utils::DoesFileExist(path))
-			{
-				path = getAllowModFlags(Vic2Tag + sourceSuffix);
-			}
-			if (!Utils::DoesFileExist(path))
-			{
-				return "";
-			}
-		
+		path = getConversionModFlag(Vic2Tag + sourceSuffix);
+	}
+	if (path == "")
+	{
+		path = getAllowModFlags(Vic2Tag + sourceSuffix);
 	}
 	return path;
 }
@@ -176,8 +210,8 @@ string getConversionModFlag(string flagFilename)
 {
 	for (auto mod: Configuration::getVic2Mods())
 	{
-		string path = Configuration::getV2Path() + "/mod/" + mod + "/gfx/flags/" + flagFilename;
-		if (Utils::DoesFileExist(path))
+		string path = Configuration::getVic2Files().resolveInLayer(mod, "gfx/flags/" + flagFilename);
+		if (path != "")
 		{
 			return path;
 		}
@@ -196,8 +230,8 @@ string getAllowModFlags(string flagFilename)
 		{
 			continue;
 		}
-		string path = Configuration::getV2Path() + "/mod/" + mod + "/gfx/flags/" + flagFilename;
-		if (Utils::DoesFileExist(path))
+		string path = Configuration::getVic2Files().resolveInLayer(mod, "gfx/flags/" + flagFilename);
+		if (path != "")
 		{
 			return path;
 		}
@@ -207,113 +241,171 @@ string getAllowModFlags(string flagFilename)
 }
 
 
-tga_image* readFlag(string path)
+// The resized flags are cached under the hash of the source file's contents, so an unchanged flag is read from the
+// cache whichever mod or folder it comes from, and a changed one is resized again. The entry also records a second,
+// unrelated hash of the contents, so two flags whose names collide can't be mistaken for each other.
+static const char flagCacheMagic[8] = { 'V', '2', 'H', 'F', 'L', 'A', 'G', 'S' };
+static const uint32_t flagCacheVersion = 2;
+
+
+tga_image* readFlag(const Utils::MappedFile& flagFile, const string& path);
+bool loadCachedFlags(const string& path, uint64_t sourceSize, uint64_t sourceCheck, vector<string>& resizedFlags);
+void storeCachedFlags(const string& path, uint64_t sourceSize, uint64_t sourceCheck, const vector<string>& resizedFlags);
+bool getResizedFlags(const string& sourcePath, vector<string>& resizedFlags)
 {
-	FILE* flagFile;
-	if (fopen_s(&flagFile, path.c_str(), "r+b") != 0)
+	// the source is mapped once, both to hash it for the cache and to decode it
+	Utils::MappedFile sourceFile(sourcePath);
+	if (!sourceFile.isOpen())
+	{
+		LOG(LogLevel::Warning) << "Could not open " << sourcePath;
+		return false;
+	}
+
+	string cachePath;
+	const uint64_t sourceSize = sourceFile.getSize();
+	uint64_t sourceCheck = 0;	// the second hash of the source, checked against the cache entry's
+	if (flagCacheFolder != "")
+	{
+		// FNV-1a names the entry; the check is a multiply-xorshift hash, which shares none of its collisions
+		uint64_t hash = 14695981039346656037ull;
+		sourceCheck = 0x9E3779B97F4A7C15ull;
+		for (size_t i = 0; i < sourceFile.getSize(); i++)
+		{
+			const unsigned char byte = static_cast<unsigned char>(sourceFile.getData()[i]);
+			hash ^= byte;
+			hash *= 1099511628211ull;
+			sourceCheck = (sourceCheck + byte + 1) * 0xFF51AFD7ED558CCDull;
+			sourceCheck ^= sourceCheck >> 29;
+		}
+
+		char hashText[17];
+		snprintf(hashText, sizeof(hashText), "%016llx", static_cast<unsigned long long>(hash));
+		cachePath = flagCacheFolder + "/" + hashText + ".flags";
+
+		if (loadCachedFlags(cachePath, sourceSize, sourceCheck, resizedFlags))
+		{
+			return true;
+		}
+	}
+
+	tga_image* sourceFlag = readFlag(sourceFile, sourcePath);
+	if (sourceFlag == nullptr)
 	{
-		LOG(LogLevel::Warning) << "Could not open " << path;
-		return nullptr;
+		return false;
 	}
 
+	vector<uint8_t> sourcePixels;
+	bool converted = getFlagPixels(sourceFlag, sourcePixels);
+	unsigned int sourceWidth = sourceFlag->width;
+	unsigned int sourceHeight = sourceFlag->height;
+	tga_free_buffers(sourceFlag);
+	delete sourceFlag;
+	if (!converted)
+	{
+		LOG(LogLevel::Warning) << "Could not convert the pixels of flag " << sourcePath;
+		return false;
+	}
+
+	resizedFlags.clear();
+	for (unsigned int size = BIG_FLAG; size < SIZE_END; size++)
+	{
+		vector<uint8_t> destPixels;
+		resizeFlag(sourcePixels, sourceWidth, sourceHeight, flagWidths[size], flagHeights[size], destPixels);
+		resizedFlags.push_back(encodeFlag(destPixels, flagWidths[size], flagHeights[size]));
+	}
+
+	if (cachePath != "")
+	{
+		storeCachedFlags(cachePath, sourceSize, sourceCheck, resizedFlags);
+	}
+	return true;
+}
+
+
+tga_image* readFlag(const Utils::MappedFile& flagFile, const string& path)
+{
 	tga_image* flag = new tga_image;
-	tga_result result = tga_read_from_FILE(flag, flagFile);
+	tga_result result = tga_read_from_memory(flag, reinterpret_cast<const uint8_t*>(flagFile.getData()), flagFile.getSize());
 	if (result != TGA_NOERR)
 	{
-		LOG(LogLevel::Warning) << "Could not read flag " << path << ": " << tga_error(result) << ". FEOF: " << feof(flagFile) << ". Ferror: " << ferror(flagFile) << ".";
+		LOG(LogLevel::Warning) << "Could not read flag " << path << ": " << tga_error(result) << ".";
 		delete flag;
 		flag = nullptr;
 	}
 
-	fclose(flagFile);
 	return flag;
 }
 
 
-tga_image* createNewFlag(const tga_image* sourceFlag, unsigned int sizeX, unsigned int sizeY)
+bool loadCachedFlags(const string& path, uint64_t sourceSize, uint64_t sourceCheck, vector<string>& resizedFlags)
 {
-	tga_image* destFlag = new tga_image;
-	destFlag->image_id_length = 0;
-	destFlag->color_map_type = TGA_COLOR_MAP_ABSENT;
-	destFlag->image_type = TGA_IMAGE_TYPE_BGR;
-	destFlag->color_map_origin = 0;
-	destFlag->color_map_length = 0;
-	destFlag->color_map_depth = 0;
-	destFlag->origin_x = 0;
-	destFlag->origin_y = 0;
-	destFlag->width = sizeX;
-	destFlag->height = sizeY;
-	destFlag->pixel_depth = 32;
-	destFlag->image_descriptor = 8;
-	destFlag->image_id = nullptr;
-	destFlag->color_map_data = nullptr;
-
-	destFlag->image_data = static_cast<uint8_t*>(malloc(sizeX * sizeY * 4));
-	for (unsigned int y = 0; y < sizeY; y++)
+	Utils::MappedFile cachedFlags(path);
+	if (!cachedFlags.isOpen())
 	{
-		for (unsigned int x = 0; x < sizeX; x++)
-		{
-			int sourceY = static_cast<int>(1.0 * y / sizeY * sourceFlag->height);
-			int sourceX = static_cast<int>(1.0 * x / sizeX * sourceFlag->width);
-			int sourceBytesPerPixel = sourceFlag->pixel_depth / 8;
-			int sourceIndex = (sourceY * sourceFlag->width + sourceX) * sourceBytesPerPixel;
-
-			int destIndex = (y * sizeX + x) * 4;
+		return false;
+	}
 
-			destFlag->image_data[destIndex + 0] = sourceFlag->image_data[sourceIndex + 0];
-			destFlag->image_data[destIndex + 1] = sourceFlag->image_data[sourceIndex + 1];
-			destFlag->image_data[destIndex + 2] = sourceFlag->image_data[sourceIndex + 2];
-			destFlag->image_data[destIndex + 3] = sourceFlag->image_data[sourceIndex + 3];
+	// magic, version, the size and second hash of the source flag, then the length and contents of each resized flag
+	const char* current = cachedFlags.getData();
+	const char* end = cachedFlags.getData() + cachedFlags.getSize();
+	auto read = [&current, end](void* destination, size_t length)
+	{
+		if (static_cast<size_t>(end - current) < length)
+		{
+			return false;
 		}
+		memcpy(destination, current, length);
+		current += length;
+		return true;
+	};
+
+	char magic[sizeof(flagCacheMagic)];
+	uint32_t version;
+	uint64_t size, check;
+	if (
+		!read(magic, sizeof(magic)) || (memcmp(magic, flagCacheMagic, sizeof(flagCacheMagic)) != 0) ||
+		!read(&version, sizeof(version)) || (version != flagCacheVersion) ||
+		!read(&size, sizeof(size)) || (size != sourceSize) ||
+		!read(&check, sizeof(check)) || (check != sourceCheck)
+	)
+	{
+		return false;
 	}
 
-	return destFlag;
-}
-
-
-void createBigFlag(tga_image* sourceFlag, string filename)
-{
-	tga_image* destFlag = createNewFlag(sourceFlag, 82, 52);
-	FILE* outputFile;
-	if (fopen_s(&outputFile, ("Output/" + Configuration::getOutputName() + "/gfx/flags/" + filename).c_str(), "w+b") != 0)
+	resizedFlags.clear();
+	for (unsigned int i = BIG_FLAG; i < SIZE_END; i++)
 	{
-		LOG(LogLevel::Warning) << "Could not create Output/" << Configuration::getOutputName() << "/gfx/flags/" << filename;
-		return;
+		uint32_t length;
+		if (!read(&length, sizeof(length)) || (static_cast<size_t>(end - current) < length))
+		{
+			LOG(LogLevel::Warning) << "Ignoring a damaged cached flag " << path;
+			resizedFlags.clear();
+			return false;
+		}
+		resizedFlags.push_back(string(current, length));
+		current += length;
 	}
-	tga_write_to_FILE(outputFile, destFlag);
-	fclose(outputFile);
-	tga_free_buffers(destFlag);
-	delete destFlag;
+
+	return true;
 }
 
 
-void createMediumFlag(tga_image* sourceFlag, string filename)
+void storeCachedFlags(const string& path, uint64_t sourceSize, uint64_t sourceCheck, const vector<string>& resizedFlags)
 {
-	tga_image* destFlag = createNewFlag(sourceFlag, 41, 26);
-	FILE* outputFile;
-	if (fopen_s(&outputFile, ("Output/" + Configuration::getOutputName() + "/gfx/flags/medium/" + filename).c_str(), "w+b") != 0)
+	string cachedFlags;	// laid out as loadCachedFlags reads it
+	cachedFlags.append(flagCacheMagic, sizeof(flagCacheMagic));
+	cachedFlags.append(reinterpret_cast<const char*>(&flagCacheVersion), sizeof(flagCacheVersion));
+	cachedFlags.append(reinterpret_cast<const char*>(&sourceSize), sizeof(sourceSize));
+	cachedFlags.append(reinterpret_cast<const char*>(&sourceCheck), sizeof(sourceCheck));
+	for (auto& resizedFlag: resizedFlags)
 	{
-		LOG(LogLevel::Warning) << "Could not create Output/" << Configuration::getOutputName() << "/gfx/flags/medium/" << filename;
-		return;
+		const uint32_t length = static_cast<uint32_t>(resizedFlag.size());
+		cachedFlags.append(reinterpret_cast<const char*>(&length), sizeof(length));
+		cachedFlags.append(resizedFlag);
 	}
-	tga_write_to_FILE(outputFile, destFlag);
-	fclose(outputFile);
-	tga_free_buffers(destFlag);
-	delete destFlag;
-}
-
 
-void createSmallFlag(tga_image* sourceFlag, string filename)
-{
-	tga_image* destFlag = createNewFlag(sourceFlag, 10, 7);
-	FILE* outputFile;
-	if (fopen_s(&outputFile, ("Output/" + Configuration::getOutputName() + "/gfx/flags/small/" + filename).c_str(), "w+b") != 0)
+	if (!Utils::WriteFileAtomically(path, cachedFlags))
 	{
-		LOG(LogLevel::Warning) << "Could not create Output/" << Configuration::getOutputName() << "/gfx/flags/small/" << filename;
-		return;
+		LOG(LogLevel::Debug) << "Could not cache the resized flags in " << path;
 	}
-	tga_write_to_FILE(outputFile, destFlag);
-	fclose(outputFile);
-	tga_free_buffers(destFlag);
-	delete destFlag;
-}
\ No newline at end of file
+}
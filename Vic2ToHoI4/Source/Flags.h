@@ -28,7 +28,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 #include <string>
 #include <map>
-#include "HOI4World\HoI4Country.h"
+#include "HOI4World/HoI4Country.h"
 using namespace std;
 
 
@@ -24,7 +24,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 #include "HoI4Buildings.h"
 #include "../Configuration.h"
 #include "../Mappers/CoastalHoI4Provinces.h"
-#include "log.h"
+#include "Log.h"
 #include "HoI4Province.h"
 #include <string>
 using namespace std;
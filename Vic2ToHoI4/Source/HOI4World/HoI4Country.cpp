@@ -128,10 +128,10 @@ void HoI4Country::output(map<int, HoI4State*> states, vector<HoI4Faction*> Facti
 		&& newCountry
 		)
 	{
-		output.open("Output/" + Configuration::getOutputName() + "/history/countries/" + Utils::convertToASCII(filename));
+		output.open("output/" + Configuration::getOutputName() + "/history/countries/" + Utils::convertUTF8ToASCII(filename));
 		if (!output.is_open())
 		{
-			Log(LogLevel::Error) << "Could not open " << "Output/" << Configuration::getOutputName() << "/common/history/" << Utils::convertToASCII(filename);
+			Log(LogLevel::Error) << "Could not open " << "output/" << Configuration::getOutputName() << "/common/history/" << Utils::convertUTF8ToASCII(filename);
 			exit(-1);
 		}
 		output << "\xEF\xBB\xBF";    // add the BOM to make HoI4 happy
@@ -381,10 +381,10 @@ void HoI4Country::output(map<int, HoI4State*> states, vector<HoI4Faction*> Facti
 void HoI4Country::outputCommonCountryFile() const
 {
 	ofstream output;
-	output.open("Output/" + Configuration::getOutputName() + "/common/countries/" + Utils::convertToASCII(commonCountryFile));
+	output.open("output/" + Configuration::getOutputName() + "/common/countries/" + Utils::convertUTF8ToASCII(commonCountryFile));
 	if (!output.is_open())
 	{
-		Log(LogLevel::Error) << "Could not open " << "Output/" << Configuration::getOutputName() << "/common/countries/" << Utils::convertToASCII(commonCountryFile);
+		Log(LogLevel::Error) << "Could not open " << "output/" << Configuration::getOutputName() << "/common/countries/" << Utils::convertUTF8ToASCII(commonCountryFile);
 		exit(-1);
 	}
 
@@ -414,7 +414,7 @@ void HoI4Country::outputColors(ofstream& out) const
 
 void HoI4Country::outputToCommonCountriesFile(FILE* output) const
 {
-	fprintf(output, "%s = \"countries%s\"\n", tag.c_str(), Utils::convertToASCII(commonCountryFile).c_str());
+	fprintf(output, "%s = \"countries%s\"\n", tag.c_str(), Utils::convertUTF8ToASCII(commonCountryFile).c_str());
 }
 
 
@@ -460,9 +460,9 @@ void HoI4Country::outputParties(FILE* output) const
 	fprintf(output, "\n");
 
 	FILE* partyLocalisations;
-	if (fopen_s(&partyLocalisations, ("Output/" + Configuration::getOutputName() + "/localisation/Parties.csv").c_str(), "a") != 0)
+	if (fopen_s(&partyLocalisations, ("output/" + Configuration::getOutputName() + "/localisation/Parties.csv").c_str(), "a") != 0)
 	{
-	LOG(LogLevel::Error) << "Could not open " << "Output/" << Configuration::getOutputName() << "/localisation/Parties.csv";
+	LOG(LogLevel::Error) << "Could not open " << "output/" << Configuration::getOutputName() << "/localisation/Parties.csv";
 	exit(-1);
 	}
 	for (auto party: parties)
@@ -476,9 +476,9 @@ void HoI4Country::outputParties(FILE* output) const
 void HoI4Country::outputLeaders() const
 {
 	FILE* leadersFile;
-	if (fopen_s(&leadersFile, ("Output/" + Configuration::getOutputName() + "/history/leaders/" + tag + ".txt").c_str(), "w") != 0)
+	if (fopen_s(&leadersFile, ("output/" + Configuration::getOutputName() + "/history/leaders/" + tag + ".txt").c_str(), "w") != 0)
 	{
-		LOG(LogLevel::Error) << "Could not open " << "Output/" << Configuration::getOutputName() << "/history/leaders/" << tag << ".txt";
+		LOG(LogLevel::Error) << "Could not open " << "output/" << Configuration::getOutputName() << "/history/leaders/" << tag << ".txt";
 	}
 	int landLeaders = 0;
 	int seaLeaders = 0;
@@ -512,7 +512,7 @@ void HoI4Country::outputLeaders() const
 
 void HoI4Country::outputOOB() const
 {
-	ofstream output("Output/" + Configuration::getOutputName() + "/history/units/" + tag + "_OOB.txt");
+	ofstream output("output/" + Configuration::getOutputName() + "/history/units/" + tag + "_OOB.txt");
 	if (!output.is_open())
 	{
 		Log(LogLevel::Error) << "Could not open Output/" << Configuration::getOutputName() << "/history/units/" << tag << "_OOB.txt";
@@ -633,7 +633,10 @@ void HoI4Country::initFromV2Country(const V2World& _srcWorld, const V2Country* _
 		auto oldLocalisation = V2Localisations::GetTextInEachLanguage(partyItr.name);
 		partyItr.localisationString = partyItr.ideology + "_" + tag;
 		auto localisationItr = oldLocalisation.begin();
-		localisationItr++;
+		if (localisationItr != oldLocalisation.end())
+		{
+			localisationItr++;
+		}
 		for (; localisationItr != oldLocalisation.end(); localisationItr++)
 		{
 			partyItr.localisationString += ";" + localisationItr->second;
@@ -1726,11 +1729,10 @@ void HoI4Country::convertParties(const V2Country* srcCountry, vector<V2Party*> V
 				rulingIdeology = "fascistic";
 				rulingHoI4Ideology = "fascism";
 			}
-
-			V2Ideologies.erase(ideologyItr);
-			auto itr = unmappedParties.find("fascistic");
-			unmappedParties.erase(itr);
 		}
+		V2Ideologies.erase(ideologyItr);
+		auto itr = unmappedParties.find("fascistic");
+		unmappedParties.erase(itr);
 	}
 	ideologyItr = V2Ideologies.find("reactionary");
 	if ((ideologyItr != V2Ideologies.end()))
@@ -1751,11 +1753,10 @@ void HoI4Country::convertParties(const V2Country* srcCountry, vector<V2Party*> V
 				rulingIdeology = "paternal_autocrat";
 				rulingHoI4Ideology = "autocratic";
 			}
-
-			V2Ideologies.erase(ideologyItr);
-			auto itr = unmappedParties.find("paternal_autocrat");
-			unmappedParties.erase(itr);
 		}
+		V2Ideologies.erase(ideologyItr);
+		auto itr = unmappedParties.find("paternal_autocrat");
+		unmappedParties.erase(itr);
 	}
 	ideologyItr = V2Ideologies.find("conservative");
 	if ((ideologyItr != V2Ideologies.end()))
@@ -1776,11 +1777,10 @@ void HoI4Country::convertParties(const V2Country* srcCountry, vector<V2Party*> V
 				rulingIdeology = "social_conservative";
 				rulingHoI4Ideology = "democratic";
 			}
-
-			V2Ideologies.erase(ideologyItr);
-			auto itr = unmappedParties.find("social_conservative");
-			unmappedParties.erase(itr);
 		}
+		V2Ideologies.erase(ideologyItr);
+		auto itr = unmappedParties.find("social_conservative");
+		unmappedParties.erase(itr);
 	}
 	ideologyItr = V2Ideologies.find("socialist");
 	if ((ideologyItr != V2Ideologies.end()))
@@ -1801,11 +1801,10 @@ void HoI4Country::convertParties(const V2Country* srcCountry, vector<V2Party*> V
 				rulingIdeology = "left_wing_radical";
 				rulingHoI4Ideology = "socialist";
 			}
-
-			V2Ideologies.erase(ideologyItr);
-			auto itr = unmappedParties.find("left_wing_radical");
-			unmappedParties.erase(itr);
 		}
+		V2Ideologies.erase(ideologyItr);
+		auto itr = unmappedParties.find("left_wing_radical");
+		unmappedParties.erase(itr);
 	}
 	ideologyItr = V2Ideologies.find("communist");
 	if ((ideologyItr != V2Ideologies.end()))
@@ -1826,11 +1825,10 @@ void HoI4Country::convertParties(const V2Country* srcCountry, vector<V2Party*> V
 				rulingIdeology = "stalinist";
 				rulingHoI4Ideology = "communism";
 			}
-
-			V2Ideologies.erase(ideologyItr);
-			auto itr = unmappedParties.find("stalinist");
-			unmappedParties.erase(itr);
 		}
+		V2Ideologies.erase(ideologyItr);
+		auto itr = unmappedParties.find("stalinist");
+		unmappedParties.erase(itr);
 	}
 	ideologyItr = V2Ideologies.find("liberal");
 	if ((ideologyItr != V2Ideologies.end()))
@@ -1851,11 +1849,10 @@ void HoI4Country::convertParties(const V2Country* srcCountry, vector<V2Party*> V
 				rulingIdeology = "social_liberal";
 				rulingHoI4Ideology = "liberal";
 			}
-
-			V2Ideologies.erase(ideologyItr);
-			auto itr = unmappedParties.find("social_liberal");
-			unmappedParties.erase(itr);
 		}
+		V2Ideologies.erase(ideologyItr);
+		auto itr = unmappedParties.find("social_liberal");
+		unmappedParties.erase(itr);
 	}
 	ideologyItr = V2Ideologies.find("anarcho_liberal");
 	if ((ideologyItr != V2Ideologies.end()))
@@ -1876,11 +1873,10 @@ void HoI4Country::convertParties(const V2Country* srcCountry, vector<V2Party*> V
 				rulingIdeology = "market_liberal";
 				rulingHoI4Ideology = "ancap";
 			}
-
-			V2Ideologies.erase(ideologyItr);
-			auto itr = unmappedParties.find("market_liberal");
-			unmappedParties.erase(itr);
 		}
+		V2Ideologies.erase(ideologyItr);
+		auto itr = unmappedParties.find("market_liberal");
+		unmappedParties.erase(itr);
 	}
 
 	if (V2Ideologies.size() == 0)
@@ -101,12 +101,12 @@ class HoI4Country
 		map<int, HoI4Province*>					getProvinces() const			{ return provinces; }
 		string										getTag() const					{ return tag; }
 		const V2Country*							getSourceCountry() const	{ return srcCountry; }
-		string										getGovernment() const		{ return government; }
+		const string&								getGovernment() const		{ return government; }
 		bool											isNewCountry() const			{ return newCountry; }
 		string										getFaction() const			{ return faction; }
 		HoI4Alignment*								getAlignment()					{ return &alignment; }
 		string										getIdeology() const			{ return ideology; }
-		string										getRulingIdeology() const { return rulingHoI4Ideology; }
+		const string&								getRulingIdeology() const { return rulingHoI4Ideology; }
 		const set<string>&						getAllies() const				{ return allies; }
 		set<string>&								editAllies()					{ return allies; }
 		map<string, double>&						getPracticals()				{ return practicals; }
@@ -114,7 +114,7 @@ class HoI4Country
 		vector<int>									getBrigs() const			{ return brigs; }
 		int											getCapitalProv() const { return capital; }
 		const string									getSphereLeader() const { return sphereLeader; }
-		HoI4Party									getRulingParty() const { return RulingPartyModel; }
+		const HoI4Party&							getRulingParty() const { return RulingPartyModel; }
 		map<int, HoI4State*> getStates() const { return states; }
 		
 		vector<HoI4Party> getParties() const { return parties; }
@@ -0,0 +1,292 @@
+/*Copyright (c) 2016 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#include "HoI4ScriptTemplate.h"
+#include <algorithm>
+#include <cstdlib>
+#include <sstream>
+#include "Log.h"
+#include "OSCompatibilityLayer.h"
+
+
+
+const string* HoI4ScriptValues::find(const string& name, scriptValueType type) const
+{
+	for (auto& value: values)
+	{
+		if (value.name == name)
+		{
+			return (value.type == type) ? &value.text : nullptr;
+		}
+	}
+	return nullptr;
+}
+
+
+void HoI4ScriptValues::set(const string& name, scriptValueType type, const string& text)
+{
+	for (auto& value: values)
+	{
+		if (value.name == name)
+		{
+			value.type = type;
+			value.text = text;
+			return;
+		}
+	}
+
+	scriptValue newValue;
+	newValue.name = name;
+	newValue.type = type;
+	newValue.text = text;
+	values.push_back(newValue);
+}
+
+
+
+HoI4ScriptTemplate::HoI4ScriptTemplate(const string& _name, const string& declarations, const string& text):
+	name(_name),
+	placeholders(),
+	literals(),
+	segments()
+{
+	readDeclarations(declarations);
+	compile(text);
+}
+
+
+void HoI4ScriptTemplate::readDeclarations(const string& declarations)
+{
+	istringstream declarationStream(declarations);
+	string declaration;
+	while (declarationStream >> declaration)
+	{
+		size_t separator = declaration.find(':');
+		if (separator == string::npos)
+		{
+			LOG(LogLevel::Error) << "Script template " << name << " declares " << declaration << " without a type";
+			exit(-1);
+		}
+
+		placeholder newPlaceholder;
+		newPlaceholder.name = declaration.substr(0, separator);
+		string type = declaration.substr(separator + 1);
+		if (type == "tag")
+		{
+			newPlaceholder.type = scriptValueType::tag;
+		}
+		else if (type == "text")
+		{
+			newPlaceholder.type = scriptValueType::text;
+		}
+		else if (type == "integer")
+		{
+			newPlaceholder.type = scriptValueType::integer;
+		}
+		else if (type == "decimal")
+		{
+			newPlaceholder.type = scriptValueType::decimal;
+		}
+		else
+		{
+			LOG(LogLevel::Error) << "Script template " << name << " declares " << newPlaceholder.name << " with unknown type " << type;
+			exit(-1);
+		}
+		placeholders.push_back(newPlaceholder);
+	}
+}
+
+
+void HoI4ScriptTemplate::compile(const string& text)
+{
+	literals.reserve(text.size());
+
+	size_t position = 0;
+	while (position <= text.size())
+	{
+		segment newSegment;
+		newSegment.literalStart = literals.size();
+		newSegment.placeholderIndex = -1;
+
+		size_t placeholderStart = text.find('$', position);
+		if (placeholderStart == string::npos)
+		{
+			literals.append(text, position, string::npos);
+			newSegment.literalLength = literals.size() - newSegment.literalStart;
+			segments.push_back(newSegment);
+			break;
+		}
+
+		size_t placeholderEnd = text.find('$', placeholderStart + 1);
+		if (placeholderEnd == string::npos)
+		{
+			LOG(LogLevel::Error) << "Script template " << name << " has a $ without a closing $";
+			exit(-1);
+		}
+
+		string placeholderName = text.substr(placeholderStart + 1, placeholderEnd - placeholderStart - 1);
+		newSegment.placeholderIndex = findPlaceholder(placeholderName);
+		if (newSegment.placeholderIndex < 0)
+		{
+			LOG(LogLevel::Error) << "Script template " << name << " uses undeclared placeholder " << placeholderName;
+			exit(-1);
+		}
+
+		literals.append(text, position, placeholderStart - position);
+		newSegment.literalLength = literals.size() - newSegment.literalStart;
+		segments.push_back(newSegment);
+
+		position = placeholderEnd + 1;
+	}
+}
+
+
+int HoI4ScriptTemplate::findPlaceholder(const string& placeholderName) const
+{
+	for (unsigned int i = 0; i < placeholders.size(); i++)
+	{
+		if (placeholders[i].name == placeholderName)
+		{
+			return i;
+		}
+	}
+	return -1;
+}
+
+
+void HoI4ScriptTemplate::render(const HoI4ScriptValues& values, string& output) const
+{
+	// look each placeholder's value up once, however many times the template uses it
+	vector<const string*> placeholderValues(placeholders.size());
+	for (unsigned int i = 0; i < placeholders.size(); i++)
+	{
+		placeholderValues[i] = values.find(placeholders[i].name, placeholders[i].type);
+		if (placeholderValues[i] == nullptr)
+		{
+			LOG(LogLevel::Error) << "No value of the right type was given for " << placeholders[i].name << " in script template " << name;
+			exit(-1);
+		}
+	}
+
+	size_t renderedSize = literals.size();
+	for (auto& templateSegment: segments)
+	{
+		if (templateSegment.placeholderIndex >= 0)
+		{
+			renderedSize += placeholderValues[templateSegment.placeholderIndex]->size();
+		}
+	}
+	output.reserve(output.size() + renderedSize);
+
+	for (auto& templateSegment: segments)
+	{
+		output.append(literals, templateSegment.literalStart, templateSegment.literalLength);
+		if (templateSegment.placeholderIndex >= 0)
+		{
+			output += *placeholderValues[templateSegment.placeholderIndex];
+		}
+	}
+}
+
+
+
+HoI4ScriptTemplates* HoI4ScriptTemplates::instance = NULL;
+
+
+
+HoI4ScriptTemplates::HoI4ScriptTemplates()
+{
+	LOG(LogLevel::Info) << "Reading script templates";
+	readTemplateFile("scriptTemplates/focusTrees.txt");
+	readTemplateFile("scriptTemplates/events.txt");
+}
+
+
+void HoI4ScriptTemplates::readTemplateFile(const string& filename)
+{
+	Utils::MappedFile file(filename);
+	if (!file.isOpen())
+	{
+		LOG(LogLevel::Error) << "Could not open " << filename;
+		exit(-1);
+	}
+
+	// the files may have been checked out with Windows line endings, but the templates are written with plain ones
+	string contents;
+	contents.reserve(file.getSize());
+	for (size_t i = 0; i < file.getSize(); i++)
+	{
+		if ((file.getData()[i] != '\r') || (i + 1 == file.getSize()) || (file.getData()[i + 1] != '\n'))
+		{
+			contents += file.getData()[i];
+		}
+	}
+
+	// each template runs from the line after its @@ line up to the line break before the next @@ line or the end of
+	// the file, so the last line break at the end of the file is dropped like the ones before each @@ line
+	if ((contents.size() > 0) && (contents.back() == '\n'))
+	{
+		contents.pop_back();
+	}
+
+	size_t header = contents.find("\n@@ ");
+	if (contents.compare(0, 3, "@@ ") == 0)
+	{
+		header = 0;
+	}
+	else if (header != string::npos)
+	{
+		header++;
+	}
+	while (header != string::npos)
+	{
+		size_t headerEnd = contents.find('\n', header);
+		if (headerEnd == string::npos)
+		{
+			headerEnd = contents.size();
+		}
+		string headerLine = contents.substr(header + 3, headerEnd - header - 3);
+		size_t nameEnd = headerLine.find(' ');
+		string name = headerLine.substr(0, nameEnd);
+		string declarations = (nameEnd == string::npos) ? "" : headerLine.substr(nameEnd + 1);
+
+		size_t textStart = min(headerEnd + 1, contents.size());
+		size_t nextHeader = contents.find("\n@@ ", headerEnd);
+		size_t textEnd = (nextHeader == string::npos) ? contents.size() : max(nextHeader, textStart);
+		templates.insert(make_pair(name, HoI4ScriptTemplate(name, declarations, contents.substr(textStart, textEnd - textStart))));
+
+		header = (nextHeader == string::npos) ? string::npos : nextHeader + 1;
+	}
+}
+
+
+const HoI4ScriptTemplate& HoI4ScriptTemplates::getTemplate(const string& name) const
+{
+	auto scriptTemplate = templates.find(name);
+	if (scriptTemplate == templates.end())
+	{
+		LOG(LogLevel::Error) << "There is no script template named " << name;
+		exit(-1);
+	}
+	return scriptTemplate->second;
+}
@@ -0,0 +1,148 @@
+/*Copyright (c) 2016 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+
+#ifndef HOI4_SCRIPT_TEMPLATE_H_
+#define HOI4_SCRIPT_TEMPLATE_H_
+
+
+
+#include <map>
+#include <string>
+#include <vector>
+using namespace std;
+
+
+
+// The kinds of value a placeholder in a script template can stand for
+enum class scriptValueType
+{
+	tag,			// a country tag
+	text,			// free text, such as a country name
+	integer,		// a number such as a state id, an event number or a focus position
+	decimal		// a number with a fractional part, written the way to_string() writes it
+};
+
+
+// The values to fill a script template's placeholders with. Each value is formatted when it is set, so a set of
+// values can be rendered into several templates without formatting it again.
+class HoI4ScriptValues
+{
+	public:
+		void setTag(const string& name, const string& tag)			{ set(name, scriptValueType::tag, tag); }
+		void setText(const string& name, const string& text)		{ set(name, scriptValueType::text, text); }
+		void setInteger(const string& name, int value)				{ set(name, scriptValueType::integer, to_string(value)); }
+		void setDecimal(const string& name, double value)			{ set(name, scriptValueType::decimal, to_string(value)); }
+
+		// The formatted value for the placeholder, or nullptr if it hasn't been set or was set as another type
+		const string* find(const string& name, scriptValueType type) const;
+
+	private:
+		struct scriptValue
+		{
+			string				name;		// the placeholder the value is for
+			scriptValueType	type;		// what kind of value it is
+			string				text;		// the value, formatted for the script
+		};
+
+		void set(const string& name, scriptValueType type, const string& text);
+
+		vector<scriptValue> values;	// a template only has a handful of placeholders, so they are searched in turn
+};
+
+
+// A piece of script with typed placeholders, compiled once into runs of literal text and the placeholders between
+// them. Rendering works out the length of the result first and reserves it, then appends each run and value, so
+// the output grows once per render rather than once per line.
+class HoI4ScriptTemplate
+{
+	public:
+		// declarations lists the placeholders the text uses, as NAME:type separated by spaces. Placeholders are
+		// written $NAME$ in the text.
+		HoI4ScriptTemplate(const string& _name, const string& declarations, const string& text);
+
+		// Appends the template to output, with each placeholder replaced by its value
+		void render(const HoI4ScriptValues& values, string& output) const;
+
+		const string&	getName() const { return name; }
+
+	private:
+		struct placeholder
+		{
+			string				name;		// the name the placeholder is written with
+			scriptValueType	type;		// the kind of value it takes
+		};
+
+		struct segment
+		{
+			size_t	literalStart;		// where the segment's text starts in literals
+			size_t	literalLength;		// the length of the segment's text
+			int		placeholderIndex;	// the placeholder after the text, or -1 if there isn't one
+		};
+
+		void	readDeclarations(const string& declarations);
+		void	compile(const string& text);
+		int	findPlaceholder(const string& placeholderName) const;
+
+		string					name;				// the template's name, for error messages
+		vector<placeholder>	placeholders;	// the placeholders the template declares
+		string					literals;		// all the template's literal text, one segment after another
+		vector<segment>		segments;		// the template, as literal text each followed by a placeholder
+};
+
+
+// The script templates for the generated focus trees and events, read from the files in scriptTemplates/ the first
+// time one is asked for and compiled then. Templates don't change once they are read, so they can be rendered from
+// several threads at once.
+class HoI4ScriptTemplates
+{
+	public:
+		static const HoI4ScriptTemplate& get(const string& name)
+		{
+			return getInstance()->getTemplate(name);
+		}
+
+	private:
+		static HoI4ScriptTemplates* instance;
+		static HoI4ScriptTemplates* getInstance()
+		{
+			if (instance == NULL)
+			{
+				instance = new HoI4ScriptTemplates();
+			}
+
+			return instance;
+		}
+
+		HoI4ScriptTemplates();
+
+		void readTemplateFile(const string& filename);
+
+		const HoI4ScriptTemplate& getTemplate(const string& name) const;
+
+		map<string, HoI4ScriptTemplate> templates;	// the templates, by name
+};
+
+
+
+#endif // HOI4_SCRIPT_TEMPLATE_H_
@@ -0,0 +1,397 @@
+/*Copyright (c) 2016 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+
+#include "HoI4SpatialIndex.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include "Log.h"
+#include "HoI4Country.h"
+#include "HoI4State.h"
+
+
+
+const int		HoI4SpatialIndex::mapWidth;
+const double	HoI4SpatialIndex::farAway = 100000;
+
+
+
+void HoI4PositionGrid::build(const vector<pair<int, int>>& _positions, int cellSize)
+{
+	positions = _positions;
+
+	columns = max(1, HoI4SpatialIndex::mapWidth / cellSize);
+	cellHeight = cellSize;
+	minY = 0;
+	int maxY = 0;
+	if (positions.size() > 0)
+	{
+		minY = positions[0].second;
+		maxY = positions[0].second;
+		for (auto position: positions)
+		{
+			minY = min(minY, position.second);
+			maxY = max(maxY, position.second);
+		}
+	}
+	rows = (maxY - minY) / cellHeight + 1;
+
+	// count the points in each cell, then place them, so each cell's points are together and in index order
+	vector<unsigned int> pointCells(positions.size());
+	cellStarts.assign(columns * rows + 1, 0);
+	for (unsigned int i = 0; i < positions.size(); i++)
+	{
+		pointCells[i] = getRow(positions[i].second) * columns + getColumn(positions[i].first);
+		cellStarts[pointCells[i] + 1]++;
+	}
+	for (unsigned int cell = 0; cell < cellStarts.size() - 1; cell++)
+	{
+		cellStarts[cell + 1] += cellStarts[cell];
+	}
+
+	cellPoints.resize(positions.size());
+	vector<uint32_t> nextInCell(cellStarts.begin(), cellStarts.end() - 1);
+	for (unsigned int i = 0; i < positions.size(); i++)
+	{
+		cellPoints[nextInCell[pointCells[i]]++] = i;
+	}
+}
+
+
+vector<unsigned int> HoI4PositionGrid::findWithin(pair<int, int> centre, double radius) const
+{
+	vector<unsigned int> found;
+	if (positions.size() == 0)
+	{
+		return found;
+	}
+
+	const int reach = static_cast<int>(ceil(radius));
+
+	// the columns to search, walking east from the western edge of the search and wrapping around the map
+	int firstColumn = getColumn(centre.first - reach);
+	int columnCount = (getColumn(centre.first + reach) - firstColumn + columns) % columns + 1;
+	if (2 * reach + 2 * (HoI4SpatialIndex::mapWidth / columns + 1) >= HoI4SpatialIndex::mapWidth)
+	{
+		firstColumn = 0;
+		columnCount = columns;
+	}
+	const int firstRow	= getRow(centre.second - reach);
+	const int lastRow		= getRow(centre.second + reach);
+
+	for (int row = firstRow; row <= lastRow; row++)
+	{
+		for (int i = 0; i < columnCount; i++)
+		{
+			const int cell = row * columns + (firstColumn + i) % columns;
+			for (uint32_t point = cellStarts[cell]; point < cellStarts[cell + 1]; point++)
+			{
+				if (HoI4SpatialIndex::getDistanceBetweenPoints(centre, positions[cellPoints[point]]) <= radius)
+				{
+					found.push_back(cellPoints[point]);
+				}
+			}
+		}
+	}
+
+	sort(found.begin(), found.end());
+	return found;
+}
+
+
+vector<unsigned int> HoI4PositionGrid::findNearest(pair<int, int> centre, unsigned int count) const
+{
+	vector<unsigned int> nearest;
+	if ((count == 0) || (positions.size() == 0))
+	{
+		return nearest;
+	}
+
+	// search rings of cells further and further out, until the closest count points found so far are all closer
+	// than anything in the next ring could be
+	vector<pair<double, unsigned int>> candidates;	// distance, point
+	vector<bool> searchedCells(columns * rows, false);
+	unsigned int cellsSearched = 0;
+
+	const int centreColumn	= getColumn(centre.first);
+	const int centreRow		= getRow(centre.second);
+	const int cellWidth		= HoI4SpatialIndex::mapWidth / columns;
+	for (int ring = 0; cellsSearched < searchedCells.size(); ring++)
+	{
+		for (int row = centreRow - ring; row <= centreRow + ring; row++)
+		{
+			if ((row < 0) || (row >= rows))
+			{
+				continue;
+			}
+
+			const int columnStep = ((row == centreRow - ring) || (row == centreRow + ring)) ? 1 : 2 * ring;
+			for (int column = centreColumn - ring; column <= centreColumn + ring; column += max(columnStep, 1))
+			{
+				const int cell = row * columns + ((column % columns) + columns) % columns;
+				if (searchedCells[cell])
+				{
+					continue;
+				}
+				searchedCells[cell] = true;
+				cellsSearched++;
+
+				for (uint32_t point = cellStarts[cell]; point < cellStarts[cell + 1]; point++)
+				{
+					candidates.push_back(make_pair(HoI4SpatialIndex::getDistanceBetweenPoints(centre, positions[cellPoints[point]]), cellPoints[point]));
+				}
+			}
+		}
+
+		if (candidates.size() >= count)
+		{
+			nth_element(candidates.begin(), candidates.begin() + (count - 1), candidates.end());
+			if (candidates[count - 1].first < ring * min(cellWidth, cellHeight))
+			{
+				break;
+			}
+		}
+	}
+
+	sort(candidates.begin(), candidates.end());
+	for (unsigned int i = 0; (i < count) && (i < candidates.size()); i++)
+	{
+		nearest.push_back(candidates[i].second);
+	}
+	return nearest;
+}
+
+
+int HoI4PositionGrid::getColumn(int x) const
+{
+	const int wrappedX = ((x % HoI4SpatialIndex::mapWidth) + HoI4SpatialIndex::mapWidth) % HoI4SpatialIndex::mapWidth;
+	return min(columns - 1, wrappedX * columns / HoI4SpatialIndex::mapWidth);
+}
+
+
+int HoI4PositionGrid::getRow(int y) const
+{
+	return min(rows - 1, max(0, (y - minY) / cellHeight));
+}
+
+
+
+HoI4SpatialIndex::HoI4SpatialIndex()
+{
+	readProvincePositions();
+
+	vector<pair<int, int>> positions;
+	for (auto province: provinceNumbers)
+	{
+		positions.push_back(provincePositions[province]);
+	}
+	provinceGrid.build(positions, 64);
+}
+
+
+void HoI4SpatialIndex::readProvincePositions()
+{
+	// province number; type; x; rotation; y; ...
+	ifstream positionsFile("positions.txt");
+	if (!positionsFile.is_open())
+	{
+		LOG(LogLevel::Error) << "Could not open positions.txt";
+		exit(-1);
+	}
+
+	string line;
+	while (getline(positionsFile, line))
+	{
+		int fields[5];
+		unsigned int fieldCount = 0;
+		size_t fieldStart = 0;
+		while ((fieldCount < 5) && (fieldStart <= line.size()))
+		{
+			fields[fieldCount++] = atoi(line.c_str() + fieldStart);
+			size_t fieldEnd = line.find(';', fieldStart);
+			if (fieldEnd == string::npos)
+			{
+				break;
+			}
+			fieldStart = fieldEnd + 1;
+		}
+		if (fieldCount < 5)
+		{
+			continue;
+		}
+
+		if (provincePositions.insert(make_pair(fields[0], make_pair(fields[2], fields[4]))).second)
+		{
+			provinceNumbers.push_back(fields[0]);
+		}
+	}
+
+	positionsFile.close();
+}
+
+
+void HoI4SpatialIndex::indexCapitals(const map<string, HoI4Country*>& countries, const map<int, HoI4State*>& states)
+{
+	capitalCountries.clear();
+	capitalPositions.clear();
+	capitalIndices.clear();
+
+	for (auto country: countries)
+	{
+		if (country.second->getCapitalProv() == 0)
+		{
+			continue;
+		}
+
+		auto capitalState = states.find(country.second->getCapitalProv());
+		pair<int, int> capitalPosition;
+		if (
+			(capitalState == states.end()) ||
+			capitalState->second->getProvinces().empty() ||
+			!getProvincePosition(*(capitalState->second->getProvinces().begin()), capitalPosition)
+		)
+		{
+			LOG(LogLevel::Warning) << "Could not find where the capital of " << country.first << " is; it will be treated as having no capital";
+			continue;
+		}
+
+		capitalIndices.insert(make_pair(country.second, static_cast<unsigned int>(capitalCountries.size())));
+		capitalCountries.push_back(country.second);
+		capitalPositions.push_back(capitalPosition);
+	}
+	capitalGrid.build(capitalPositions, 256);
+
+	const size_t capitalCount = capitalCountries.size();
+	capitalDistances.resize(capitalCount * capitalCount);
+	for (size_t i = 0; i < capitalCount; i++)
+	{
+		capitalDistances[i * capitalCount + i] = 0.0;
+		for (size_t j = i + 1; j < capitalCount; j++)
+		{
+			const double distance = getDistanceBetweenPoints(capitalPositions[i], capitalPositions[j]);
+			capitalDistances[i * capitalCount + j] = distance;
+			capitalDistances[j * capitalCount + i] = distance;
+		}
+	}
+}
+
+
+bool HoI4SpatialIndex::getProvincePosition(int province, pair<int, int>& position) const
+{
+	auto itr = provincePositions.find(province);
+	if (itr == provincePositions.end())
+	{
+		return false;
+	}
+
+	position = itr->second;
+	return true;
+}
+
+
+vector<int> HoI4SpatialIndex::findProvincesWithin(pair<int, int> centre, double radius) const
+{
+	vector<int> provinces;
+	for (auto index: provinceGrid.findWithin(centre, radius))
+	{
+		provinces.push_back(provinceNumbers[index]);
+	}
+	return provinces;
+}
+
+
+vector<int> HoI4SpatialIndex::findNearestProvinces(pair<int, int> centre, unsigned int count) const
+{
+	vector<int> provinces;
+	for (auto index: provinceGrid.findNearest(centre, count))
+	{
+		provinces.push_back(provinceNumbers[index]);
+	}
+	return provinces;
+}
+
+
+double HoI4SpatialIndex::getDistanceBetweenCountries(const HoI4Country* country1, const HoI4Country* country2) const
+{
+	auto index1 = capitalIndices.find(country1);
+	auto index2 = capitalIndices.find(country2);
+	if ((index1 == capitalIndices.end()) || (index2 == capitalIndices.end()))
+	{
+		return farAway;
+	}
+
+	return capitalDistances[index1->second * capitalCountries.size() + index2->second];
+}
+
+
+vector<HoI4Country*> HoI4SpatialIndex::findCountriesWithin(const HoI4Country* country, double radius) const
+{
+	vector<HoI4Country*> found;
+	auto index = capitalIndices.find(country);
+	if (index == capitalIndices.end())
+	{
+		return found;
+	}
+
+	for (auto foundIndex: capitalGrid.findWithin(capitalPositions[index->second], radius))
+	{
+		found.push_back(capitalCountries[foundIndex]);
+	}
+	return found;
+}
+
+
+vector<HoI4Country*> HoI4SpatialIndex::findNearestCountries(const HoI4Country* country, unsigned int count) const
+{
+	vector<HoI4Country*> nearest;
+	auto index = capitalIndices.find(country);
+	if (index == capitalIndices.end())
+	{
+		return nearest;
+	}
+
+	for (auto foundIndex: capitalGrid.findNearest(capitalPositions[index->second], count + 1))
+	{
+		if ((foundIndex != index->second) && (nearest.size() < count))
+		{
+			nearest.push_back(capitalCountries[foundIndex]);
+		}
+	}
+	return nearest;
+}
+
+
+double HoI4SpatialIndex::getDistanceBetweenPoints(pair<int, int> point1, pair<int, int> point2)
+{
+	int xDistance = abs(point2.first - point1.first);
+	if (xDistance > mapWidth / 2)
+	{
+		xDistance = mapWidth - xDistance;
+	}
+
+	int yDistance = point2.second - point1.second;
+
+	return sqrt(pow(xDistance, 2) + pow(yDistance, 2));
+}
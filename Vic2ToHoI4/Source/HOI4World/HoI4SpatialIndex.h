@@ -0,0 +1,123 @@
+/*Copyright (c) 2016 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+
+#ifndef HOI4_SPATIAL_INDEX_H_
+#define HOI4_SPATIAL_INDEX_H_
+
+
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+using namespace std;
+
+
+
+class HoI4Country;
+class HoI4State;
+
+
+
+// Points on the HoI4 map, bucketed into cells so that a search only looks at the cells near where it is
+// searching. The map wraps around from east to west, and so do the cells. Points are identified by their
+// index in the list the grid was built from.
+class HoI4PositionGrid
+{
+	public:
+		HoI4PositionGrid(): columns(0), rows(0), cellHeight(1), minY(0) {}
+
+		void build(const vector<pair<int, int>>& _positions, int cellSize);
+
+		// The points no further than radius from centre, in index order
+		vector<unsigned int> findWithin(pair<int, int> centre, double radius) const;
+
+		// The count points closest to centre, closest first. Points the same distance away are in index order.
+		vector<unsigned int> findNearest(pair<int, int> centre, unsigned int count) const;
+
+	private:
+		int	getColumn(int x) const;
+		int	getRow(int y) const;
+
+		vector<pair<int, int>>	positions;		// the points, by index
+		vector<uint32_t>			cellStarts;		// where each cell's points start in cellPoints, with an extra entry marking the end of the last cell's
+		vector<unsigned int>		cellPoints;		// the points in each cell, one cell after another
+		int							columns;			// the number of cells across the map
+		int							rows;				// the number of cells down the map
+		int							cellHeight;		// the height of a cell; cells are as close to square as fits the map's width
+		int							minY;				// the top of the first row
+};
+
+
+// Where the provinces and the country capitals are on the HoI4 map, with grids to find the provinces and
+// capitals near a point and a table of the distance between every pair of capitals. The faction and war
+// generation asks for country distances many times over, so they are all worked out once instead of by
+// looking up the capitals for each pair.
+class HoI4SpatialIndex
+{
+	public:
+		HoI4SpatialIndex();
+
+		// Records the capitals of the countries that have one and works out the distances between them.
+		// Called once the countries' capitals are settled.
+		void indexCapitals(const map<string, HoI4Country*>& countries, const map<int, HoI4State*>& states);
+
+		bool						getProvincePosition(int province, pair<int, int>& position) const;
+		vector<int>				findProvincesWithin(pair<int, int> centre, double radius) const;
+		vector<int>				findNearestProvinces(pair<int, int> centre, unsigned int count) const;
+
+		// The distance between the capitals of two countries, or farAway if either has no capital
+		double					getDistanceBetweenCountries(const HoI4Country* country1, const HoI4Country* country2) const;
+		// The countries with capitals no further than radius from the country's capital, including the country, in tag order
+		vector<HoI4Country*>	findCountriesWithin(const HoI4Country* country, double radius) const;
+		// The count countries with capitals closest to the country's capital, not including the country, closest first
+		vector<HoI4Country*>	findNearestCountries(const HoI4Country* country, unsigned int count) const;
+
+		static double getDistanceBetweenPoints(pair<int, int> point1, pair<int, int> point2);
+
+		static const int		mapWidth = 5250;		// the distance around the map from east to west
+		static const double	farAway;					// the distance given for countries without capitals
+
+	private:
+		HoI4SpatialIndex(const HoI4SpatialIndex&);
+		HoI4SpatialIndex& operator=(const HoI4SpatialIndex&);
+
+		void readProvincePositions();
+
+		vector<int>									provinceNumbers;			// the provinces with positions, in the order provinceGrid has them
+		unordered_map<int, pair<int, int>>	provincePositions;		// the position of each province
+		HoI4PositionGrid							provinceGrid;				// the provinces, bucketed by position
+
+		vector<HoI4Country*>										capitalCountries;		// the countries with capitals, in tag order
+		vector<pair<int, int>>									capitalPositions;		// the position of each of those countries' capitals
+		unordered_map<const HoI4Country*, unsigned int>	capitalIndices;		// where each country with a capital is in capitalCountries
+		HoI4PositionGrid											capitalGrid;			// the capitals, bucketed by position
+		vector<double>												capitalDistances;		// the distance between each pair of capitals, a row per country
+};
+
+
+
+#endif // HOI4_SPATIAL_INDEX_H_
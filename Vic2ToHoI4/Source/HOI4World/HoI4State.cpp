@@ -32,6 +32,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 #include "../V2World/V2World.h"
 #include "Log.h"
 #include "OSCompatibilityLayer.h"
+#include "OutputWriter.h"
 
 
 
@@ -67,13 +68,8 @@ HoI4State::HoI4State(const Vic2State* _sourceState, int _ID, string _ownerTag)
 void HoI4State::output(string _filename)
 {
 	// create the file
-	string filename("Output/" + Configuration::getOutputName() + "/history/states/" + _filename);
-	ofstream out(filename);
-	if (!out.is_open())
-	{
-		LOG(LogLevel::Error) << "Could not open \"output/" + Configuration::getOutputName() + "/history/states/" + _filename;
-		exit(-1);
-	}
+	string filename("output/" + Configuration::getOutputName() + "/history/states/" + _filename);
+	OutputFile out(filename);
 
 	// output the data
 	out << "state={" << endl;
@@ -29,7 +29,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 #include <vector>
 #include <string>
 #include <map>
-#include "..\V2World\Vic2State.h"
+#include "../V2World/Vic2State.h"
 using namespace std;
 
 
@@ -53,8 +53,8 @@ class HoI4State
 		void addCores(const vector<string>& newCores);
 
 		const Vic2State* getSourceState() const { return sourceState; }
-		set<int>	getProvinces() const { return provinces; }
-		string getOwner() const { return ownerTag; }
+		const set<int>&	getProvinces() const { return provinces; }
+		const string& getOwner() const { return ownerTag; }
 		set<string> getCores() const { return cores; }
 		int getID() const { return ID; }
 		int getNavalLocation() const { return navalLocation; }
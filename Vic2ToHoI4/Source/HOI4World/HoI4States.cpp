@@ -22,8 +22,9 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 
 #include "HoI4States.h"
-#include "log.h"
+#include "Log.h"
 #include "OSCompatibilityLayer.h"
+#include "OutputWriter.h"
 #include "ParadoxParserUTF8.h"
 #include "../Mappers/CountryMapping.h"
 #include "../Mappers/V2Localisations.h"
@@ -471,10 +472,10 @@ void HoI4States::output() const
 
 void HoI4States::outputHistory() const
 {
-	string statesPath = "Output/" + Configuration::getOutputName() + "/history/states";
+	string statesPath = "output/" + Configuration::getOutputName() + "/history/states";
 	if (!Utils::TryCreateFolder(statesPath))
 	{
-		LOG(LogLevel::Error) << "Could not create \"Output/" + Configuration::getOutputName() + "/history/states";
+		LOG(LogLevel::Error) << "Could not create \"output/" + Configuration::getOutputName() + "/history/states";
 		exit(-1);
 	}
 	for (auto state: states)
@@ -493,12 +494,7 @@ void HoI4States::outputHistory() const
 	}
 	for (auto nameItr = stateFilenames.find(states.size() + 1); nameItr != stateFilenames.end(); nameItr++)
 	{
-		ofstream emptyStateFile("Output/" + Configuration::getOutputName() + "/history/states/" + nameItr->second);
-		if (!emptyStateFile.is_open())
-		{
-			LOG(LogLevel::Warning) << "Could not create " << "Output/" << Configuration::getOutputName() << "/history/states/" << nameItr->second;
-		}
-		emptyStateFile.close();
+		OutputFile emptyStateFile("output/" + Configuration::getOutputName() + "/history/states/" + nameItr->second);
 	}
 }
 
@@ -511,7 +507,7 @@ void HoI4States::outputStateLocalisations() const
 		{
 			continue;
 		}
-		ofstream localisationFile("Output/" + Configuration::getOutputName() + "/localisation/state_names_l_" + languageToLocalisations.first + ".yml");
+		ofstream localisationFile("output/" + Configuration::getOutputName() + "/localisation/state_names_l_" + languageToLocalisations.first + ".yml");
 		if (!localisationFile.is_open())
 		{
 			LOG(LogLevel::Error) << "Could not update localisation text file";
@@ -536,7 +532,7 @@ void HoI4States::outputVPLocalisations() const
 		{
 			continue;
 		}
-		ofstream localisationFile("Output/" + Configuration::getOutputName() + "/localisation/victory_points_l_" + languageToLocalisations.first + ".yml");
+		ofstream localisationFile("output/" + Configuration::getOutputName() + "/localisation/victory_points_l_" + languageToLocalisations.first + ".yml");
 		if (!localisationFile.is_open())
 		{
 			LOG(LogLevel::Error) << "Could not update localisation text file";
@@ -30,7 +30,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 #include <vector>
 #include "HoI4Localisation.h"
 #include "HoI4State.h"
-#include "..\V2World\V2Province.h"
+#include "../V2World/V2Province.h"
 #include "../Mappers/ProvinceMapper.h"
 using namespace std;
 
@@ -23,7 +23,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 #include "../Configuration.h"
 #include "HoI4StrategicRegion.h"
-#include "log.h"
+#include "Log.h"
 #include "ParadoxParserUTF8.h"
 #include <fstream>
 using namespace std;
@@ -0,0 +1,183 @@
+/*Copyright (c) 2016 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+
+#include "HoI4WarPlanningSnapshot.h"
+#include "HoI4Country.h"
+#include "HoI4Relations.h"
+#include "HoI4SpatialIndex.h"
+#include "HoI4State.h"
+#include "../Mappers/CountryMapping.h"
+#include "../Mappers/ProvinceNeighborMapper.h"
+#include "../V2World/V2World.h"
+
+
+
+HoI4WarPlanningSnapshot::HoI4WarPlanningSnapshot(const V2World& sourceWorld, const map<string, HoI4Country*>& countries, const map<int, HoI4State*>& states, const HoI4SpatialIndex& _spatialIndex):
+	spatialIndex(_spatialIndex),
+	greatCountries(),
+	summaries(),
+	provinceOwners()
+{
+	summaries.reserve(countries.size());
+	for (auto country: countries)
+	{
+		summaries[country.second];
+	}
+
+	findGreatCountries(sourceWorld, countries);
+	findSphereLeaders(countries);
+	findProvinces(countries, states);
+}
+
+
+void HoI4WarPlanningSnapshot::findGreatCountries(const V2World& sourceWorld, const map<string, HoI4Country*>& countries)
+{
+	for (auto Vic2Tag: sourceWorld.getGreatPowers())
+	{
+		auto country = countries.find(CountryMapper::getHoI4Tag(Vic2Tag));
+		if (country != countries.end())
+		{
+			greatCountries.push_back(country->second);
+			summaries[country->second].isGreatCountry = true;
+		}
+	}
+}
+
+
+void HoI4WarPlanningSnapshot::findSphereLeaders(const map<string, HoI4Country*>& countries)
+{
+	// a country counts as in the sphere of the first great power that claims it
+	for (auto greatCountry: greatCountries)
+	{
+		for (auto relation: greatCountry->getRelations())
+		{
+			if (!relation.second->getSphereLeader())
+			{
+				continue;
+			}
+
+			auto spheredCountry = countries.find(relation.second->getTag());
+			if (spheredCountry != countries.end())
+			{
+				countrySummary& summary = summaries[spheredCountry->second];
+				if (summary.sphereLeader == "")
+				{
+					summary.sphereLeader = greatCountry->getTag();
+				}
+			}
+		}
+	}
+}
+
+
+void HoI4WarPlanningSnapshot::findProvinces(const map<string, HoI4Country*>& countries, const map<int, HoI4State*>& states)
+{
+	for (auto state: states)
+	{
+		auto owner = countries.find(state.second->getOwner());
+		if (owner == countries.end())
+		{
+			continue;
+		}
+
+		vector<int>& ownerProvinces = summaries[owner->second].provinces;
+		for (auto province: state.second->getProvinces())
+		{
+			ownerProvinces.push_back(province);
+			provinceOwners.insert(make_pair(province, owner->second));
+		}
+	}
+}
+
+
+bool HoI4WarPlanningSnapshot::isGreatCountry(const HoI4Country* country) const
+{
+	return getSummary(country).isGreatCountry;
+}
+
+
+const string& HoI4WarPlanningSnapshot::getSphereLeader(const HoI4Country* country) const
+{
+	return getSummary(country).sphereLeader;
+}
+
+
+const vector<int>& HoI4WarPlanningSnapshot::getProvinces(const HoI4Country* country) const
+{
+	return getSummary(country).provinces;
+}
+
+
+const map<string, HoI4Country*>& HoI4WarPlanningSnapshot::getNeighbors(const HoI4Country* country) const
+{
+	countrySummary& summary = summaries[country];
+	if (!summary.neighborsFound)
+	{
+		findNeighbors(country, summary);
+		summary.neighborsFound = true;
+	}
+	return summary.neighbors;
+}
+
+
+void HoI4WarPlanningSnapshot::findNeighbors(const HoI4Country* country, countrySummary& summary) const
+{
+	for (auto province: summary.provinces)
+	{
+		for (int neighborProvince: provinceNeighborMapper::getNeighbors(province))
+		{
+			auto owner = provinceOwners.find(neighborProvince);
+			if ((owner != provinceOwners.end()) && (owner->second != country) && (owner->second->getProvinceCount() > 0))
+			{
+				summary.neighbors.insert(make_pair(owner->second->getTag(), owner->second));
+			}
+		}
+	}
+
+	if (summary.neighbors.size() == 0)
+	{
+		//IMPROVE
+		//need to get further neighbors, as well as countries without capital in an area
+		for (auto nearbyCountry: spatialIndex.findCountriesWithin(country, 500))
+		{
+			if (nearbyCountry->getProvinceCount() > 0)
+			{
+				summary.neighbors.insert(make_pair(nearbyCountry->getTag(), nearbyCountry));
+			}
+		}
+	}
+}
+
+
+const HoI4WarPlanningSnapshot::countrySummary& HoI4WarPlanningSnapshot::getSummary(const HoI4Country* country) const
+{
+	static const countrySummary unknownCountry;
+
+	auto summary = summaries.find(country);
+	if (summary == summaries.end())
+	{
+		return unknownCountry;
+	}
+	return summary->second;
+}
@@ -0,0 +1,97 @@
+/*Copyright (c) 2016 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+
+#ifndef HOI4_WAR_PLANNING_SNAPSHOT_H_
+#define HOI4_WAR_PLANNING_SNAPSHOT_H_
+
+
+
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+using namespace std;
+
+
+
+class HoI4Country;
+class HoI4SpatialIndex;
+class HoI4State;
+class V2World;
+
+
+
+// What the faction and war generation needs to know about each country, worked out once before it starts.
+// None of it changes while factions and wars are planned, so the war creators look it up here instead of
+// searching the source world and the states again for every great power they plan for.
+class HoI4WarPlanningSnapshot
+{
+	public:
+		HoI4WarPlanningSnapshot(const V2World& sourceWorld, const map<string, HoI4Country*>& countries, const map<int, HoI4State*>& states, const HoI4SpatialIndex& _spatialIndex);
+
+		// The great powers, in the order the source world lists them
+		const vector<HoI4Country*>&			getGreatCountries() const { return greatCountries; }
+		bool										isGreatCountry(const HoI4Country* country) const;
+
+		// The tag of the great power whose sphere the country is in, or "" if it is in none
+		const string&							getSphereLeader(const HoI4Country* country) const;
+
+		// The provinces the country owns, state by state
+		const vector<int>&					getProvinces(const HoI4Country* country) const;
+
+		// The countries with provinces next to the country's. A country with no land neighbors gets the countries
+		// with capitals near its own instead.
+		const map<string, HoI4Country*>&	getNeighbors(const HoI4Country* country) const;
+
+	private:
+		HoI4WarPlanningSnapshot(const HoI4WarPlanningSnapshot&);
+		HoI4WarPlanningSnapshot& operator=(const HoI4WarPlanningSnapshot&);
+
+		struct countrySummary
+		{
+			countrySummary(): isGreatCountry(false), neighborsFound(false) {}
+
+			bool								isGreatCountry;	// whether or not the country is a great power
+			string							sphereLeader;		// the great power whose sphere the country is in, or ""
+			vector<int>						provinces;			// the provinces the country owns
+			map<string, HoI4Country*>	neighbors;			// the country's neighbors, once they have been asked for
+			bool								neighborsFound;	// whether or not neighbors has been filled in
+		};
+
+		void	findGreatCountries(const V2World& sourceWorld, const map<string, HoI4Country*>& countries);
+		void	findSphereLeaders(const map<string, HoI4Country*>& countries);
+		void	findProvinces(const map<string, HoI4Country*>& countries, const map<int, HoI4State*>& states);
+		void	findNeighbors(const HoI4Country* country, countrySummary& summary) const;
+
+		const countrySummary& getSummary(const HoI4Country* country) const;
+
+		const HoI4SpatialIndex&											spatialIndex;		// where the countries' capitals are
+		vector<HoI4Country*>												greatCountries;	// the great powers, in the source world's order
+		mutable unordered_map<const HoI4Country*, countrySummary>	summaries;			// what is known about each country
+		unordered_map<int, HoI4Country*>								provinceOwners;	// the country owning each province
+};
+
+
+
+#endif // HOI4_WAR_PLANNING_SNAPSHOT_H_
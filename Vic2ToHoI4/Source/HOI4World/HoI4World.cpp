@@ -31,16 +31,19 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 #include "ParadoxParserUTF8.h"
 #include "Log.h"
 #include "OSCompatibilityLayer.h"
+#include "Profiler.h"
 #include "../Configuration.h"
 #include "../V2World/Vic2Agreement.h"
 #include "../V2World/V2Diplomacy.h"
 #include "../V2World/V2Province.h"
 #include "../V2World/V2Party.h"
 #include "HoI4Relations.h"
+#include "HoI4ScriptTemplate.h"
 #include "HoI4State.h"
 #include "HoI4SupplyZone.h"
 #include "../Mappers/CountryMapping.h"
 #include "../Mappers/ProvinceMapper.h"
+#include "../Mappers/ProvinceNeighborMapper.h"
 
 
 
@@ -149,27 +152,27 @@ void HoI4World::output() const
 void HoI4World::outputCommonCountries() const
 {
 	// Create common\countries path.
-	string countriesPath = "Output/" + Configuration::getOutputName() + "/common";
+	string countriesPath = "output/" + Configuration::getOutputName() + "/common";
 	/*if (!Utils::TryCreateFolder(countriesPath))
 	{
-		LOG(LogLevel::Error) << "Could not create \"Output/" + Configuration::getOutputName() + "/common\"";
+		LOG(LogLevel::Error) << "Could not create \"output/" + Configuration::getOutputName() + "/common\"";
 		exit(-1);
 	}*/
 	if (!Utils::TryCreateFolder(countriesPath + "/countries"))
 	{
-		LOG(LogLevel::Error) << "Could not create \"Output/" + Configuration::getOutputName() + "/common/countries\"";
+		LOG(LogLevel::Error) << "Could not create \"output/" + Configuration::getOutputName() + "/common/countries\"";
 		exit(-1);
 	}
 	if (!Utils::TryCreateFolder(countriesPath + "/country_tags"))
 	{
-		LOG(LogLevel::Error) << "Could not create \"Output/" + Configuration::getOutputName() + "/common/country_tags\"";
+		LOG(LogLevel::Error) << "Could not create \"output/" + Configuration::getOutputName() + "/common/country_tags\"";
 		exit(-1);
 	}
 
 	// Output common\countries.txt
 	LOG(LogLevel::Debug) << "Writing countries file";
 	FILE* allCountriesFile;
-	if (fopen_s(&allCountriesFile, ("Output/" + Configuration::getOutputName() + "/common/country_tags/00_countries.txt").c_str(), "w") != 0)
+	if (fopen_s(&allCountriesFile, ("output/" + Configuration::getOutputName() + "/common/country_tags/00_countries.txt").c_str(), "w") != 0)
 	{
 		LOG(LogLevel::Error) << "Could not create countries file";
 		exit(-1);
@@ -191,7 +194,7 @@ void HoI4World::outputColorsfile() const
 {
 
 	ofstream output;
-	output.open(("Output/" + Configuration::getOutputName() + "/common/countries/colors.txt"));
+	output.open(("output/" + Configuration::getOutputName() + "/common/countries/colors.txt"));
 	if (!output.is_open())
 	{
 		Log(LogLevel::Error) << "Could not open Output/" << Configuration::getOutputName() << "/common/countries/colors.txt";
@@ -215,7 +218,7 @@ void HoI4World::outputAutoexecLua() const
 {
 	// output autoexec.lua
 	FILE* autoexec;
-	if (fopen_s(&autoexec, ("Output/" + Configuration::getOutputName() + "/script/autoexec.lua").c_str(), "w") != 0)
+	if (fopen_s(&autoexec, ("output/" + Configuration::getOutputName() + "/script/autoexec.lua").c_str(), "w") != 0)
 	{
 		LOG(LogLevel::Error) << "Could not create autoexec.lua";
 		exit(-1);
@@ -245,7 +248,7 @@ void HoI4World::outputLocalisations() const
 {
 	// Create localisations for all new countries. We don't actually know the names yet so we just use the tags as the names.
 	LOG(LogLevel::Debug) << "Writing localisation text";
-	string localisationPath = "Output/" + Configuration::getOutputName() + "/localisation";
+	string localisationPath = "output/" + Configuration::getOutputName() + "/localisation";
 	if (!Utils::TryCreateFolder(localisationPath))
 	{
 		LOG(LogLevel::Error) << "Could not create localisation folder";
@@ -261,14 +264,14 @@ void HoI4World::outputMap() const
 	LOG(LogLevel::Debug) << "Writing Map Info";
 
 	// create the map folder
-	if (!Utils::TryCreateFolder("Output/" + Configuration::getOutputName() + "/map"))
+	if (!Utils::TryCreateFolder("output/" + Configuration::getOutputName() + "/map"))
 	{
-		LOG(LogLevel::Error) << "Could not create \"Output/" + Configuration::getOutputName() + "/map";
+		LOG(LogLevel::Error) << "Could not create \"output/" + Configuration::getOutputName() + "/map";
 		exit(-1);
 	}
 
 	// create the rocket sites file
-	ofstream rocketSitesFile("Output/" + Configuration::getOutputName() + "/map/rocketsites.txt");
+	ofstream rocketSitesFile("output/" + Configuration::getOutputName() + "/map/rocketsites.txt");
 	if (!rocketSitesFile.is_open())
 	{
 		LOG(LogLevel::Error) << "Could not create Output/" << Configuration::getOutputName() << "/map/rocketsites.txt";
@@ -282,7 +285,7 @@ void HoI4World::outputMap() const
 	rocketSitesFile.close();
 
 	// create the airports file
-	ofstream airportsFile("Output/" + Configuration::getOutputName() + "/map/airports.txt");
+	ofstream airportsFile("output/" + Configuration::getOutputName() + "/map/airports.txt");
 	if (!airportsFile.is_open())
 	{
 		LOG(LogLevel::Error) << "Could not create Output/" << Configuration::getOutputName() << "/map/airports.txt";
@@ -296,14 +299,14 @@ void HoI4World::outputMap() const
 	airportsFile.close();
 
 	// output strategic regions
-	if (!Utils::TryCreateFolder("Output/" + Configuration::getOutputName() + "/map/strategicregions"))
+	if (!Utils::TryCreateFolder("output/" + Configuration::getOutputName() + "/map/strategicregions"))
 	{
-		LOG(LogLevel::Error) << "Could not create \"Output/" + Configuration::getOutputName() + "/map/strategicregions";
+		LOG(LogLevel::Error) << "Could not create \"output/" + Configuration::getOutputName() + "/map/strategicregions";
 		exit(-1);
 	}
 	for (auto strategicRegion : strategicRegions)
 	{
-		strategicRegion.second->output("Output/" + Configuration::getOutputName() + "/map/strategicregions/");
+		strategicRegion.second->output("output/" + Configuration::getOutputName() + "/map/strategicregions/");
 	}
 }
 
@@ -313,10 +316,10 @@ void HoI4World::outputHistory() const
 	states->output();
 
 	LOG(LogLevel::Debug) << "Writing countries";
-	string unitsPath = "Output/" + Configuration::getOutputName() + "/history/units";
+	string unitsPath = "output/" + Configuration::getOutputName() + "/history/units";
 	if (!Utils::TryCreateFolder(unitsPath))
 	{
-		LOG(LogLevel::Error) << "Could not create \"Output/" + Configuration::getOutputName() + "/history/units";
+		LOG(LogLevel::Error) << "Could not create \"output/" + Configuration::getOutputName() + "/history/units";
 		exit(-1);
 	}
 	/*for (auto countryItr: countries)
@@ -388,9 +391,9 @@ void HoI4World::convertCountries(map<int, int>& leaderMap, const governmentJobsM
 void HoI4World::outputSupply() const
 {
 	// create the folders
-	if (!Utils::TryCreateFolder("Output/" + Configuration::getOutputName() + "/map/supplyareas"))
+	if (!Utils::TryCreateFolder("output/" + Configuration::getOutputName() + "/map/supplyareas"))
 	{
-		LOG(LogLevel::Error) << "Could not create \"Output/" + Configuration::getOutputName() + "/map/supplyareas";
+		LOG(LogLevel::Error) << "Could not create \"output/" + Configuration::getOutputName() + "/map/supplyareas";
 		exit(-1);
 	}
 
@@ -1541,7 +1544,7 @@ void HoI4World::convertDiplomacy()
 			}
 
 			HoI4a->value = relationItr.second->getRelations();
-			HoI4a->start_date = date("1930.1.1"); // Arbitrary date
+			HoI4a->start_date = date(1930, 1, 1); // Arbitrary date
 			HoI4a->type = "relation";
 			diplomacy.addAgreement(HoI4a);
 
@@ -1550,7 +1553,7 @@ void HoI4World::convertDiplomacy()
 				HoI4Agreement* HoI4a = new HoI4Agreement;
 				HoI4a->country1 = country.first;
 				HoI4a->country2 = relationItr.first;
-				HoI4a->start_date = date("1930.1.1"); // Arbitrary date
+				HoI4a->start_date = date(1930, 1, 1); // Arbitrary date
 				HoI4a->type = "guarantee";
 				diplomacy.addAgreement(HoI4a);
 			}
@@ -1559,7 +1562,7 @@ void HoI4World::convertDiplomacy()
 				HoI4Agreement* HoI4a = new HoI4Agreement;
 				HoI4a->country1 = country.first;
 				HoI4a->country2 = relationItr.first;
-				HoI4a->start_date = date("1930.1.1"); // Arbitrary date
+				HoI4a->start_date = date(1930, 1, 1); // Arbitrary date
 				HoI4a->type = "sphere";
 				diplomacy.addAgreement(HoI4a);
 			}
@@ -1668,211 +1671,52 @@ void HoI4World::setSphereLeaders(const V2World &sourceWorld)
 }
 string HoI4World::createAnnexEvent(HoI4Country* Annexer, HoI4Country* Annexed, int eventnumber)
 {
+	HoI4ScriptValues values;
+	values.setTag("ANNEXER", Annexer->getTag());
+	values.setTag("ANNEXED", Annexed->getTag());
+	values.setText("ANNEXER_NAME", Annexer->getSourceCountry()->getName("english"));
+	values.setText("ANNEXED_NAME", Annexed->getSourceCountry()->getName("english"));
+	values.setInteger("EVENT", eventnumber);
+	values.setInteger("ACCEPT_EVENT", eventnumber + 1);
+	values.setInteger("REFUSE_EVENT", eventnumber + 2);
+
 	string Events;
-	string annexername = Annexer->getSourceCountry()->getName("english");
-	string annexedname = Annexed->getSourceCountry()->getName("english");
-	Events += "country_event = {\n";
-	Events += "	id = NFEvents." + to_string(eventnumber) + "\n";
-	Events += "	title = \"" + annexername + " Demands " + annexedname + "!\"\n";
-	Events += "	desc = \"Today " + annexername + " sent an envoy to us with a proposition of an union. We are alone and in this world, and a union with " + annexername + " might prove to be fruiteful.";
-	Events += " Our people would be safe with the mighty army of " + annexername + " and we could possibly flourish with their established economy. Or we could refuse the union which would surely lead to war, but maybe we can hold them off!\"\n";
-	Events += "	picture = GFX_report_event_hitler_parade\n";
-	Events += "	\n";
-	Events += "	is_triggered_only = yes\n";
-	Events += "	\n";
-	Events += "	option = { # Accept\n";
-	Events += "		name = \"We accept the Union\"\n";
-	Events += "		ai_chance = {\n";
-	Events += "			base = 30\n";
-	Events += "			modifier = {\n";
-	Events += "				add = -15\n";
-	Events += "				" + Annexer->getTag() + " = { has_army_size = { size < 40 } }\n";
-	Events += "			}\n";
-	Events += "			modifier = {\n";
-	Events += "				add = 45\n";
-	Events += "				" + Annexer->getTag() + " = { has_army_size = { size > 39 } }\n";
-	Events += "			}\n";
-	Events += "		}\n";
-	Events += "		" + Annexer->getTag() + " = {\n";
-	Events += "			country_event = { hours = 2 id = NFEvents." + to_string(eventnumber + 1) + " }\n";//+1 accept
-	Events += "		}\n";
-	Events += "		custom_effect_tooltip = GAME_OVER_TT\n";
-	Events += "	}\n";
-	Events += "	option = { # Refuse\n";
-	Events += "		name = \"We Refuse!\"\n";
-	Events += "		ai_chance = {\n";
-	Events += "			base = 10 \n";
-	Events += "\n";
-	Events += "			modifier = {\n";
-	Events += "				factor = 0\n";
-	Events += "				GER = { has_army_size = { size > 39 } }\n";
-	Events += "			}\n";
-	Events += "			modifier = {\n";
-	Events += "				add = 20\n";
-	Events += "				GER = { has_army_size = { size < 30 } }\n";
-	Events += "			}\n";
-	Events += "		}\n";
-	Events += "		" + Annexer->getTag() + " = {\n";
-	//Events += "			add_opinion_modifier = { target = ROOT modifier = " + Annexer->getTag() + "_anschluss_rejected }\n";
-	Events += "			country_event = { hours = 2 id = NFEvents." + to_string(eventnumber + 2) + " }\n";//+2 refuse
-	Events += "			if = { limit = { is_in_faction_with = " + Annexed->getTag() + " }\n";
-	Events += "				remove_from_faction = " + Annexed->getTag() + "\n";
-	Events += "			}\n";
-	Events += "		}\n";
-	Events += "	}\n";
-	Events += "}\n";
-	Events += "\n";
-	//Country Refuses!
-	Events += "# Austria refuses Anschluss\n";
-	Events += "country_event = {\n";
-	Events += "	id = NFEvents." + to_string(eventnumber + 2) + "\n";
-	Events += "	title = \"" + annexedname + " Refuses!\"\n";
-	Events += "	desc = \"" + annexedname + " Refused our proposed union! This is an insult to us that cannot go unanswered!\"\n";
-	Events += "	picture = GFX_report_event_german_troops\n";
-	Events += "	\n";
-	Events += "	is_triggered_only = yes\n";
-	Events += "	\n";
-	Events += "	option = {\n";
-	Events += "		name = \"It's time for war\"\n";
-	Events += "		create_wargoal = {\n";
-	Events += "				type = annex_everything\n";
-	Events += "			target = " + Annexed->getTag() + "\n";
-	Events += "		}\n";
-	Events += "	}\n";
-	Events += "}";
-	//accepts
-	Events += "# Austrian Anschluss Completed\n";
-	Events += "country_event = {\n";
-	Events += "	id = NFEvents." + to_string(eventnumber + 1) + "\n";
-	Events += "	title = \"" + annexedname + " accepts!\"\n";
-	Events += "	desc = \"" + annexedname + " accepted our proposed union, their added strength will push us to greatness!\"\n";
-	Events += "	picture = GFX_report_event_german_speech\n";
-	Events += "	\n";
-	Events += "	is_triggered_only = yes\n";
-	Events += "	\n";
-	Events += "	option = {\n";
-	Events += "		name = \"A stronger Union!\"\n";
+	HoI4ScriptTemplates::get("annexEvent").render(values, Events);
+	const HoI4ScriptTemplate& stateTemplate = HoI4ScriptTemplates::get("annexEventState");
 	for (auto cstate : Annexed->getStates())
 	{
-		Events += "		" + to_string(cstate.first) + " = {\n";
-		Events += "			if = {\n";
-		Events += "				limit = { is_owned_by = " + Annexed->getTag() + " }\n";
-		Events += "				add_core_of = " + Annexer->getTag() + "\n";
-		Events += "			}\n";
-		Events += "		}\n";
-
-	}
-	Events += "\n";
-	Events += "		annex_country = { target = " + Annexed->getTag() + " transfer_troops = yes }\n";
-	Events += "		add_political_power = 50\n";
-	Events += "		add_named_threat = { threat = 2 name = \"" + annexername + " annexed " + annexedname + "\" }\n";
-	Events += "		set_country_flag = " + Annexed->getTag() + "_annexed\n";
-	Events += "	}\n";
-	Events += "}\n";
+		values.setInteger("STATE", cstate.first);
+		stateTemplate.render(values, Events);
+	}
+	HoI4ScriptTemplates::get("annexEventEnd").render(values, Events);
 	return Events;
 }
-string HoI4World::createSudatenEvent(HoI4Country* Annexer, HoI4Country* Annexed, int eventnumber, vector<int> claimedStates)
+string HoI4World::createSudatenEvent(HoI4Country* Annexer, HoI4Country* Annexed, int eventnumber, const vector<int>& claimedStates)
 {
-	string Events;
 	//flesh out this event more, possibly make it so allies have a chance to help?
-	string annexername = Annexer->getSourceCountry()->getName("english");
-	string annexedname = Annexed->getSourceCountry()->getName("english");
-	Events += "#Sudaten Events\n";
-	Events += "country_event = {\n";
-	Events += "	id = NFEvents." + to_string(eventnumber) + "\n";
-	Events += "	title = \"" + annexername + " Demands " + annexedname + "!\"\n";
-	Events += "	desc = \"" + annexername + " has recently been making claims to our bordering states, saying that these states are full of " + Annexer->getSourceCountry()->getAdjective("english") + " people and that the territory should be given to them. Although it ";
-	Events += "is true that recently our neighboring states have had an influx of " + Annexer->getSourceCountry()->getAdjective("english") + " people in the recent years, we cannot give up our lands because a few " + Annexer->getSourceCountry()->getAdjective("english") + " settled down in our land. ";
-	Events += "In response " + annexername + " has called for a conference, demanding their territory in exchange for peace. How do we resond? ";
-	Events += " Our people would be safe with the mighty army of " + annexername + " and we could possibly flourish with their established economy. Or we could refuse the union which would surely lead to war, but maybe we can hold them off!\"\n";
-	Events += "	picture = GFX_report_event_hitler_parade\n";
-	Events += "	\n";
-	Events += "	is_triggered_only = yes\n";
-	Events += "	\n";
-	Events += "	option = { # Accept\n";
-	Events += "		name = \"We Accept\"\n";
-	Events += "		ai_chance = {\n";
-	Events += "			base = 30\n";
-	Events += "			modifier = {\n";
-	Events += "				add = -15\n";
-	Events += "				" + Annexer->getTag() + " = { has_army_size = { size < 40 } }\n";
-	Events += "			}\n";
-	Events += "			modifier = {\n";
-	Events += "				add = 45\n";
-	Events += "				" + Annexer->getTag() + " = { has_army_size = { size > 39 } }\n";
-	Events += "			}\n";
-	Events += "		}\n";
-	Events += "		" + Annexer->getTag() + " = {\n";
-	Events += "			country_event = { hours = 2 id = NFEvents." + to_string(eventnumber + 1) + " }\n";//+1 accept
-	Events += "		}\n";
-	Events += "	}\n";
-	Events += "	option = { # Refuse\n";
-	Events += "		name = \"We Refuse!\"\n";
-	Events += "		ai_chance = {\n";
-	Events += "			base = 10 \n";
-	Events += "\n";
-	Events += "			modifier = {\n";
-	Events += "				factor = 0\n";
-	Events += "				GER = { has_army_size = { size > 39 } }\n";
-	Events += "			}\n";
-	Events += "			modifier = {\n";
-	Events += "				add = 20\n";
-	Events += "				GER = { has_army_size = { size < 30 } }\n";
-	Events += "			}\n";
-	Events += "		}\n";
-	Events += "		" + Annexer->getTag() + " = {\n";
-	//Events += "			add_opinion_modifier = { target = ROOT modifier = " + Annexer->getTag() + "_anschluss_rejected }\n";
-	Events += "			country_event = { hours = 2 id = NFEvents." + to_string(eventnumber + 2) + " }\n";//+2 refuse
-	Events += "			if = { limit = { is_in_faction_with = " + Annexed->getTag() + " }\n";
-	Events += "				remove_from_faction = " + Annexed->getTag() + "\n";
-	Events += "			}\n";
-	Events += "		}\n";
-	Events += "	}\n";
-	Events += "}\n";
-	Events += "\n";
-	//Country Refuses!
-	Events += "# refuses Sudaten\n";
-	Events += "country_event = {\n";
-	Events += "	id = NFEvents." + to_string(eventnumber + 2) + "\n";
-	Events += "	title = \"" + annexedname + " Refuses!\"\n";
-	Events += "	desc = \"" + annexedname + " Refused our proposed proposition! This is an insult to us that cannot go unanswered!\"\n";
-	Events += "	picture = GFX_report_event_german_troops\n";
-	Events += "	\n";
-	Events += "	is_triggered_only = yes\n";
-	Events += "	\n";
-	Events += "	option = {\n";
-	Events += "		name = \"It's time for war\"\n";
-	Events += "		create_wargoal = {\n";
-	Events += "				type = annex_everything\n";
-	Events += "			target = " + Annexed->getTag() + "\n";
-	Events += "		}\n";
-	Events += "	}\n";
-	Events += "}";
-	//accepts
-	Events += "#  Sudaten Completed\n";
-	Events += "country_event = {\n";
-	Events += "	id = NFEvents." + to_string(eventnumber + 1) + "\n";
-	Events += "	title = \"" + annexedname + " accepts!\"\n";
-	Events += "	desc = \"" + annexedname + " accepted our proposed demands, the added lands will push us to greatness!\"\n";
-	Events += "	picture = GFX_report_event_german_speech\n";
-	Events += "	\n";
-	Events += "	is_triggered_only = yes\n";
-	Events += "	\n";
-	Events += "	option = {\n";
-	Events += "		name = \"A stronger Union!\"\n";
+	HoI4ScriptValues values;
+	values.setTag("ANNEXER", Annexer->getTag());
+	values.setTag("ANNEXED", Annexed->getTag());
+	values.setText("ANNEXER_NAME", Annexer->getSourceCountry()->getName("english"));
+	values.setText("ANNEXED_NAME", Annexed->getSourceCountry()->getName("english"));
+	values.setText("ANNEXER_ADJECTIVE", Annexer->getSourceCountry()->getAdjective("english"));
+	values.setInteger("EVENT", eventnumber);
+	values.setInteger("ACCEPT_EVENT", eventnumber + 1);
+	values.setInteger("REFUSE_EVENT", eventnumber + 2);
+
+	string Events;
+	HoI4ScriptTemplates::get("sudetenEvent").render(values, Events);
+	const HoI4ScriptTemplate& stateTemplate = HoI4ScriptTemplates::get("sudetenEventState");
 	for (auto cstate : claimedStates)
 	{
-		Events += "		" + to_string(cstate) + " = { add_core_of = " + Annexer->getTag() + " }\n";
-		Events += "		" + Annexer->getTag() + " = { transfer_state =  " + to_string(cstate) + " }\n";
+		values.setInteger("STATE", cstate);
+		stateTemplate.render(values, Events);
 	}
-	Events += "		set_country_flag = " + Annexed->getTag() + "_demanded\n";
-	Events += "	}\n";
-	Events += "}\n";
+	HoI4ScriptTemplates::get("sudetenEventEnd").render(values, Events);
 	return Events;
 }
-string HoI4World::createDemocracyNF(HoI4Country* Home, vector<HoI4Country*> CountriesToContain, int XStart)
+string HoI4World::createDemocracyNF(HoI4Country* Home, const vector<HoI4Country*>& CountriesToContain, int XStart)
 {
-	string FocusTree = "";
 	double WTModifier = 1;
 	if (Home->getGovernment() == "democratic")
 	{
@@ -1896,2946 +1740,90 @@ string HoI4World::createDemocracyNF(HoI4Country* Home, vector<HoI4Country*> Coun
 		if (warPol == "pacifism" || warPol == "pacifist")
 			WTModifier = 0.5;
 	}
-	//War Propoganda
-	FocusTree += "		focus = { \n";
-	FocusTree += "		id = WarProp" + Home->getTag() + "\n";
-	FocusTree += "		icon = GFX_goal_generic_propaganda\n";
-	FocusTree += "		text = \"War Propoganda\"\n";
-	FocusTree += "		available = {\n";
-	FocusTree += "			threat > " + to_string(0.2*WTModifier) + "\n";
-	FocusTree += "		}\n";
-	FocusTree += "		\n";
-	FocusTree += "		x =  " + to_string(XStart) + "\n";
-	FocusTree += "		y = 0\n";
-	FocusTree += "		cost = 10\n";
-	FocusTree += "		ai_will_do = {\n";
-	FocusTree += "			factor = 10\n";
-	FocusTree += "		}	\n";
-	FocusTree += "		completion_reward = {\n";
-	FocusTree += "			add_ideas = militarism_focus\n";
-	FocusTree += "		}\n";
-	FocusTree += "	}";
-
-	//Prepare Intervention
-	FocusTree += "		focus = { \n";
-	FocusTree += "		id = PrepInter" + Home->getTag() + "\n";
-	FocusTree += "		icon = GFX_goal_generic_occupy_states_ongoing_war\n";
-	FocusTree += "		text = \"War Propoganda\"\n";
-	FocusTree += "		prerequisite = { focus = WarProp" + Home->getTag() + "}\n";
-	FocusTree += "		available = {\n";
-	FocusTree += "			threat > " + to_string(0.4 * WTModifier) + "\n";
-	FocusTree += "		}\n";
-	FocusTree += "		\n";
-	FocusTree += "		x =  " + to_string(XStart) + "\n";
-	FocusTree += "		y = 1\n";
-	FocusTree += "		cost = 10\n";
-	FocusTree += "		ai_will_do = {\n";
-	FocusTree += "			factor = 10\n";
-	FocusTree += "		}	\n";
-	FocusTree += "		completion_reward = {\n";
-	FocusTree += "			set_rule = { can_send_volunteers = yes }\n";
-	FocusTree += "		}\n";
-	FocusTree += "	}";
 
 	int offBalance = 0;
 	if (CountriesToContain.size() >= 2)
 		offBalance = -3;
 	if (CountriesToContain.size() == 1)
 		offBalance = -2;
-	//Limited Intervention
-	FocusTree += "		focus = { \n";
-	FocusTree += "		id = Lim" + Home->getTag() + "\n";
-	FocusTree += "		icon = GFX_goal_generic_more_territorial_claims\n";
-	FocusTree += "		text = \"Limited Intervention\"\n";
-	FocusTree += "		prerequisite = { focus = PrepInter" + Home->getTag() + "}\n";
-	FocusTree += "		available = {\n";
-	FocusTree += "			threat > " + to_string(0.8 * WTModifier) + "\n";
-	FocusTree += "		}\n";
-	FocusTree += "		\n";
-	FocusTree += "		x =  " + to_string(XStart + offBalance) + "\n";
-	FocusTree += "		y = 3\n";
-	FocusTree += "		cost = 10\n";
-	FocusTree += "		ai_will_do = {\n";
-	FocusTree += "			factor = 10\n";
-	FocusTree += "		}	\n";
-	FocusTree += "		completion_reward = {\n";
-	FocusTree += "			add_ideas = limited_interventionism\n";
-	FocusTree += "			set_rule = { can_send_volunteers = yes }\n";
-	FocusTree += "		}\n";
-	FocusTree += "	}";
 
+	//War Propoganda, Prepare Intervention and Limited Intervention
+	HoI4ScriptValues values;
+	values.setTag("HOME", Home->getTag());
+	values.setInteger("X", XStart);
+	values.setInteger("LIMITED_X", XStart + offBalance);
+	values.setDecimal("PROPAGANDA_THREAT", 0.2 * WTModifier);
+	values.setDecimal("INTERVENTION_THREAT", 0.4 * WTModifier);
+	values.setDecimal("LIMITED_THREAT", 0.8 * WTModifier);
+	string FocusTree;
+	HoI4ScriptTemplates::get("democracyIntervention").render(values, FocusTree);
+
+	//War Plan, Embargo and WAR for each country to contain
+	const HoI4ScriptTemplate& warPlanTemplate = HoI4ScriptTemplates::get("democracyWarPlan");
 	int warPlannumber = 1;
-	//for (auto Country : CountriesToContain)
-
 	for (int i = CountriesToContain.size() - 1; i >= 0; i--)
 	{
 		HoI4Country* Country = CountriesToContain[i];
-		//War Plan
-		FocusTree += "		focus = { \n";
-		FocusTree += "		id = WarPlan" + Home->getTag() + Country->getTag() + "\n";
-		FocusTree += "		icon = GFX_goal_generic_position_armies\n";
-		FocusTree += "		text = \"War Plan " + Country->getSourceCountry()->getName("english") + "\"\n";
-		FocusTree += "		prerequisite = { focus = PrepInter" + Home->getTag() + "}\n";
-		FocusTree += "		available = {\n";
-		FocusTree += "			" + Country->getTag() + " = { is_in_faction_with = " + Home->getTag() + " }\n";
-		FocusTree += "			" + Country->getTag() + " = { has_added_tension_amount > 30 }\n";
-		FocusTree += "		}\n";
-		FocusTree += "		\n";
-		FocusTree += "		x =  " + to_string(XStart + offBalance + warPlannumber * 2) + "\n";
-		FocusTree += "		y = 2\n";
-		FocusTree += "		cost = 10\n";
-		FocusTree += "		ai_will_do = {\n";
-		FocusTree += "			factor = 10\n";
-		FocusTree += "		}	\n";
-		FocusTree += "		completion_reward = {\n";
-		FocusTree += "			army_experience = 20\n";
-		FocusTree += "			add_tech_bonus = {\n";
-		FocusTree += "				name = land_doc_bonus\n";
-		FocusTree += "				bonus = 0.5\n";
-		FocusTree += "				uses = 1\n";
-		FocusTree += "				category = land_doctrine\n";
-		FocusTree += "			}\n";
-		FocusTree += "		}\n";
-		FocusTree += "	}";
-
-		//Embargo
-		FocusTree += "		focus = { \n";
-		FocusTree += "		id = Embargo" + Home->getTag() + Country->getTag() + "\n";
-		FocusTree += "		icon = GFX_goal_generic_trade\n";
-		FocusTree += "		text = \"Embargo " + Country->getSourceCountry()->getName("english") + "\"\n";
-		FocusTree += "		prerequisite = { focus =  WarPlan" + Home->getTag() + Country->getTag() + "}\n";
-		FocusTree += "		available = {\n";
-		FocusTree += "			" + Country->getTag() + " = { is_in_faction_with = " + Home->getTag() + " }\n";
-		FocusTree += "			" + Country->getTag() + " = { has_added_tension_amount > 30 }\n";
-		FocusTree += "		}\n";
-		FocusTree += "		\n";
-		FocusTree += "		x =  " + to_string(XStart + offBalance + warPlannumber * 2) + "\n";
-		FocusTree += "		y = 3\n";
-		FocusTree += "		cost = 10\n";
-		FocusTree += "		ai_will_do = {\n";
-		FocusTree += "			factor = 10\n";
-		FocusTree += "		}	\n";
-		FocusTree += "		completion_reward = {\n";
-		FocusTree += "			" + Country->getTag() + " = {\n";
-		FocusTree += "			add_opinion_modifier = { target = " + Home->getTag() + " modifier = embargo }\n}\n";
-		FocusTree += "		}\n";
-		FocusTree += "	}";
-
-		//WAR
-		FocusTree += "		focus = { \n";
-		FocusTree += "		id = WAR" + Home->getTag() + Country->getTag() + "\n";
-		FocusTree += "		icon = GFX_goal_support_democracy\n";
-		FocusTree += "		text = \"Enact War Plan " + Country->getSourceCountry()->getName("english") + "\"\n";
-		FocusTree += "		available = {\n";
-		FocusTree += "			" + Country->getTag() + " = { is_in_faction_with = " + Home->getTag() + " }\n";
-		FocusTree += "		}\n";
-		FocusTree += "		prerequisite = { focus =  Embargo" + Home->getTag() + Country->getTag() + " }\n";
-		FocusTree += "		prerequisite = { focus =  Lim" + Home->getTag() + " }\n";
-		FocusTree += "		x =  " + to_string(XStart + offBalance + warPlannumber++ * 2) + "\n";
-		FocusTree += "		y =4\n";
-		FocusTree += "		cost = 10\n";
-		FocusTree += "		ai_will_do = {\n";
-		FocusTree += "			factor = 10\n";
-		FocusTree += "		}	\n";
-		FocusTree += "		completion_reward = {\n";
-		FocusTree += "			create_wargoal = {\n";
-		FocusTree += "				type = puppet_wargoal_focus\n";
-		FocusTree += "				target = " + Country->getTag() + "\n";
-		FocusTree += "			}";
-		FocusTree += "		}\n";
-		FocusTree += "	}";
+		values.setTag("TARGET", Country->getTag());
+		values.setText("TARGET_NAME", Country->getSourceCountry()->getName("english"));
+		values.setInteger("X", XStart + offBalance + warPlannumber++ * 2);
+		warPlanTemplate.render(values, FocusTree);
 	}
 	return FocusTree;
 }
 string HoI4World::createMonarchyEmpireNF(HoI4Country* Home, HoI4Country* Annexed1, HoI4Country* Annexed2, HoI4Country* Annexed3, HoI4Country* Annexed4, int ProtectorateNumber, int AnnexNumber, int x)
 {
-	string FocusTree = "";
-	//Glory to Empire!
-	FocusTree += "		focus = { \n";
-	FocusTree += "		id = EmpireGlory" + Home->getTag() + "\n";
-	FocusTree += "		icon = GFX_goal_anschluss\n";
-	FocusTree += "		text = \"Glory to the Empire!\"\n";
-	FocusTree += "		available = {\n";
-	//FocusTree += "			is_puppet = no\n";
-	FocusTree += "		}\n";
-	FocusTree += "		\n";
-	FocusTree += "		x =  29\n";
-	FocusTree += "		y = 0\n";
-	FocusTree += "		cost = 10\n";
-	FocusTree += "		ai_will_do = {\n";
-	FocusTree += "			factor = 10\n";
-	FocusTree += "			modifier = {\n";
-	FocusTree += "				factor = 0\n";
-	FocusTree += "				date < 1937.6.6\n";
-	FocusTree += "			}\n";
-	FocusTree += "		}	\n";
-	FocusTree += "		completion_reward = {\n";
-	FocusTree += "			add_national_unity = 0.1\n";
-	FocusTree += "		}\n";
-	FocusTree += "	}";
-
-	//Colonies Focus
-	FocusTree += "		focus = { \n";
-	FocusTree += "		id = StrengthenColonies" + Home->getTag() + "\n";
-	FocusTree += "		icon = GFX_goal_generic_position_armies\n";
-	FocusTree += "		text = \"Strengthen the Colonies\"\n";
-	FocusTree += "		prerequisite = { focus = EmpireGlory" + Home->getTag() + " }\n";
-	FocusTree += "		mutually_exclusive = { focus = StrengthenHome" + Home->getTag() + " }\n";
-	FocusTree += "		x =  28\n";
-	FocusTree += "		y = 1\n";
-	FocusTree += "		cost = 10\n";
-	FocusTree += "		ai_will_do = {\n";
-	FocusTree += "			factor = 0\n";
-	FocusTree += "			modifier = {\n";
-	FocusTree += "			}\n";
-	FocusTree += "		}	\n";
-	FocusTree += "		completion_reward = {\n";
-	FocusTree += "			navy_experience = 25\n";
-	FocusTree += "		}\n";
-	FocusTree += "	}";
-	//Home Focus
-	FocusTree += "		focus = { \n";
-	FocusTree += "		id = StrengthenHome" + Home->getTag() + "\n";
-	FocusTree += "		icon = GFX_goal_generic_national_unity\n";
-	FocusTree += "		text = \"Strengthen Home\"\n";
-	FocusTree += "		prerequisite = { focus = EmpireGlory" + Home->getTag() + " }\n";
-	FocusTree += "		mutually_exclusive = { focus = StrengthenColonies" + Home->getTag() + " }\n";
-	FocusTree += "		x =  30\n";
-	FocusTree += "		y = 1\n";
-	FocusTree += "		cost = 10\n";
-	FocusTree += "		ai_will_do = {\n";
-	FocusTree += "			factor = 10\n";
-	FocusTree += "			modifier = {\n";
-	FocusTree += "			}\n";
-	FocusTree += "		}	\n";
-	FocusTree += "		completion_reward = {\n";
-	FocusTree += "			army_experience = 25\n";
-	FocusTree += "		}\n";
-	FocusTree += "	}";
-
-	//Colonial Factories
-	FocusTree += "		focus = { \n";
-	FocusTree += "		id = ColonialInd" + Home->getTag() + "\n";
-	FocusTree += "		icon = GFX_goal_generic_construct_civ_factory\n";
-	FocusTree += "		text = \"Colonial Industry Buildup\"\n";
-	FocusTree += "		prerequisite = { focus = StrengthenColonies" + Home->getTag() + " }\n";
-	FocusTree += "		x =  26\n";
-	FocusTree += "		y = 2\n";
-	FocusTree += "		cost = 10\n";
-	FocusTree += "		ai_will_do = {\n";
-	FocusTree += "			factor = 10\n";
-	FocusTree += "			modifier = {\n";
-	FocusTree += "			}\n";
-	FocusTree += "		}	\n";
-	FocusTree += "		completion_reward = {\n";
-	FocusTree += "			random_owned_state = {\n";
-	FocusTree += "				limit = {\n";
-	FocusTree += "					free_building_slots = {\n";
-	FocusTree += "						building = arms_factory\n";
-	FocusTree += "						size > 0\n";
-	FocusTree += "						include_locked = yes\n";
-	FocusTree += "					}\n";
-	FocusTree += "					OR = {\n";
-	FocusTree += "						is_in_home_area = no\n";
-	FocusTree += "						NOT = {\n";
-	FocusTree += "							owner = {\n";
-	FocusTree += "								any_owned_state = {\n";
-	FocusTree += "									free_building_slots = {\n";
-	FocusTree += "										building = industrial_complex\n";
-	FocusTree += "										size > 0\n";
-	FocusTree += "										include_locked = yes\n";
-	FocusTree += "									}\n";
-	FocusTree += "									is_in_home_area = no\n";
-	FocusTree += "								}\n";
-	FocusTree += "							}\n";
-	FocusTree += "						}\n";
-	FocusTree += "					}\n";
-	FocusTree += "				}\n";
-	FocusTree += "				add_extra_state_shared_building_slots = 1\n";
-	FocusTree += "				add_building_construction = {\n";
-	FocusTree += "					type = arms_factory\n";
-	FocusTree += "					level = 1\n";
-	FocusTree += "					instant_build = yes\n";
-	FocusTree += "				}\n";
-	FocusTree += "			}\n";
-	FocusTree += "		}\n";
-	FocusTree += "		completion_reward = {\n";
-	FocusTree += "			random_owned_state = {\n";
-	FocusTree += "				limit = {\n";
-	FocusTree += "					free_building_slots = {\n";
-	FocusTree += "						building = arms_factory\n";
-	FocusTree += "						size > 0\n";
-	FocusTree += "						include_locked = yes\n";
-	FocusTree += "					}\n";
-	FocusTree += "					OR = {\n";
-	FocusTree += "						is_in_home_area = no\n";
-	FocusTree += "						NOT = {\n";
-	FocusTree += "							owner = {\n";
-	FocusTree += "								any_owned_state = {\n";
-	FocusTree += "									free_building_slots = {\n";
-	FocusTree += "										building = industrial_complex\n";
-	FocusTree += "										size > 0\n";
-	FocusTree += "										include_locked = yes\n";
-	FocusTree += "									}\n";
-	FocusTree += "									is_in_home_area = no\n";
-	FocusTree += "								}\n";
-	FocusTree += "							}\n";
-	FocusTree += "						}\n";
-	FocusTree += "					}\n";
-	FocusTree += "				}\n";
-	FocusTree += "				add_extra_state_shared_building_slots = 1\n";
-	FocusTree += "				add_building_construction = {\n";
-	FocusTree += "					type = arms_factory\n";
-	FocusTree += "					level = 1\n";
-	FocusTree += "					instant_build = yes\n";
-	FocusTree += "				}\n";
-	FocusTree += "			}\n";
-	FocusTree += "		}\n";
-	FocusTree += "		completion_reward = {\n";
-	FocusTree += "			random_owned_state = {\n";
-	FocusTree += "				limit = {\n";
-	FocusTree += "					free_building_slots = {\n";
-	FocusTree += "						building = arms_factory\n";
-	FocusTree += "						size > 0\n";
-	FocusTree += "						include_locked = yes\n";
-	FocusTree += "					}\n";
-	FocusTree += "					OR = {\n";
-	FocusTree += "						is_in_home_area = no\n";
-	FocusTree += "						NOT = {\n";
-	FocusTree += "							owner = {\n";
-	FocusTree += "								any_owned_state = {\n";
-	FocusTree += "									free_building_slots = {\n";
-	FocusTree += "										building = industrial_complex\n";
-	FocusTree += "										size > 0\n";
-	FocusTree += "										include_locked = yes\n";
-	FocusTree += "									}\n";
-	FocusTree += "									is_in_home_area = no\n";
-	FocusTree += "								}\n";
-	FocusTree += "							}\n";
-	FocusTree += "						}\n";
-	FocusTree += "					}\n";
-	FocusTree += "				}\n";
-	FocusTree += "				add_extra_state_shared_building_slots = 1\n";
-	FocusTree += "				add_building_construction = {\n";
-	FocusTree += "					type = arms_factory\n";
-	FocusTree += "					level = 1\n";
-	FocusTree += "					instant_build = yes\n";
-	FocusTree += "				}\n";
-	FocusTree += "			}\n";
-	FocusTree += "		}\n";
-	FocusTree += "	}";
-
-	//Colonial Highway
-	FocusTree += "		focus = { \n";
-	FocusTree += "		id = ColonialHwy" + Home->getTag() + "\n";
-	FocusTree += "		icon = GFX_goal_generic_construct_infrastructure\n";
-	FocusTree += "		text = \"Colonial Highway\"\n";
-	FocusTree += "		prerequisite = { focus = ColonialInd" + Home->getTag() + " }\n";
-	FocusTree += "		x =  24\n";
-	FocusTree += "		y = 3\n";
-	FocusTree += "		cost = 10\n";
-	FocusTree += "		ai_will_do = {\n";
-	FocusTree += "			factor = 10\n";
-	FocusTree += "			modifier = {\n";
-	FocusTree += "			}\n";
-	FocusTree += "		}	\n";
-	FocusTree += "		completion_reward = {\n";
-	FocusTree += "			random_owned_state = {\n";
-	FocusTree += "				limit = {\n";
-	FocusTree += "					free_building_slots = {\n";
-	FocusTree += "						building = infrastructure\n";
-	FocusTree += "						size > 0\n";
-	FocusTree += "						include_locked = yes\n";
-	FocusTree += "					}\n";
-	FocusTree += "					OR = {\n";
-	FocusTree += "						is_in_home_area = no\n";
-	FocusTree += "						NOT = {\n";
-	FocusTree += "							owner = {\n";
-	FocusTree += "								any_owned_state = {\n";
-	FocusTree += "									free_building_slots = {\n";
-	FocusTree += "										building = infrastructure\n";
-	FocusTree += "										size > 0\n";
-	FocusTree += "										include_locked = yes\n";
-	FocusTree += "									}\n";
-	FocusTree += "									is_in_home_area = no\n";
-	FocusTree += "								}\n";
-	FocusTree += "							}\n";
-	FocusTree += "						}\n";
-	FocusTree += "					}\n";
-	FocusTree += "				}\n";
-	FocusTree += "				add_extra_state_shared_building_slots = 1\n";
-	FocusTree += "				add_building_construction = {\n";
-	FocusTree += "					type = infrastructure\n";
-	FocusTree += "					level = 1\n";
-	FocusTree += "					instant_build = yes\n";
-	FocusTree += "				}\n";
-	FocusTree += "			}\n";
-	FocusTree += "		}\n";
-	FocusTree += "		completion_reward = {\n";
-	FocusTree += "			random_owned_state = {\n";
-	FocusTree += "				limit = {\n";
-	FocusTree += "					free_building_slots = {\n";
-	FocusTree += "						building = infrastructure\n";
-	FocusTree += "						size > 0\n";
-	FocusTree += "						include_locked = yes\n";
-	FocusTree += "					}\n";
-	FocusTree += "					OR = {\n";
-	FocusTree += "						is_in_home_area = no\n";
-	FocusTree += "						NOT = {\n";
-	FocusTree += "							owner = {\n";
-	FocusTree += "								any_owned_state = {\n";
-	FocusTree += "									free_building_slots = {\n";
-	FocusTree += "										building = infrastructure\n";
-	FocusTree += "										size > 0\n";
-	FocusTree += "										include_locked = yes\n";
-	FocusTree += "									}\n";
-	FocusTree += "									is_in_home_area = no\n";
-	FocusTree += "								}\n";
-	FocusTree += "							}\n";
-	FocusTree += "						}\n";
-	FocusTree += "					}\n";
-	FocusTree += "				}\n";
-	FocusTree += "				add_extra_state_shared_building_slots = 1\n";
-	FocusTree += "				add_building_construction = {\n";
-	FocusTree += "					type = infrastructure\n";
-	FocusTree += "					level = 1\n";
-	FocusTree += "					instant_build = yes\n";
-	FocusTree += "				}\n";
-	FocusTree += "			}\n";
-	FocusTree += "		}\n";
-	FocusTree += "		completion_reward = {\n";
-	FocusTree += "			random_owned_state = {\n";
-	FocusTree += "				limit = {\n";
-	FocusTree += "					free_building_slots = {\n";
-	FocusTree += "						building = infrastructure\n";
-	FocusTree += "						size > 0\n";
-	FocusTree += "						include_locked = yes\n";
-	FocusTree += "					}\n";
-	FocusTree += "					OR = {\n";
-	FocusTree += "						is_in_home_area = no\n";
-	FocusTree += "						NOT = {\n";
-	FocusTree += "							owner = {\n";
-	FocusTree += "								any_owned_state = {\n";
-	FocusTree += "									free_building_slots = {\n";
-	FocusTree += "										building = infrastructure\n";
-	FocusTree += "										size > 0\n";
-	FocusTree += "										include_locked = yes\n";
-	FocusTree += "									}\n";
-	FocusTree += "									is_in_home_area = no\n";
-	FocusTree += "								}\n";
-	FocusTree += "							}\n";
-	FocusTree += "						}\n";
-	FocusTree += "					}\n";
-	FocusTree += "				}\n";
-	FocusTree += "				add_extra_state_shared_building_slots = 1\n";
-	FocusTree += "				add_building_construction = {\n";
-	FocusTree += "					type = infrastructure\n";
-	FocusTree += "					level = 1\n";
-	FocusTree += "					instant_build = yes\n";
-	FocusTree += "				}\n";
-	FocusTree += "			}\n";
-	FocusTree += "		}\n";
-	FocusTree += "	}";
-
-	//improve resources
-	FocusTree += "		focus = { \n";
-	FocusTree += "		id = ResourceFac" + Home->getTag() + "\n";
-	FocusTree += "		icon = GFX_goal_generic_oil_refinery\n";
-	FocusTree += "		text = \"Improve Resource Factories\"\n";
-	FocusTree += "		prerequisite = { focus = ColonialInd" + Home->getTag() + " }\n";
-	FocusTree += "		mutually_exclusive = { focus = StrengthenColonies" + Home->getTag() + " }\n";
-	FocusTree += "		x =  26\n";
-	FocusTree += "		y = 3\n";
-	FocusTree += "		cost = 10\n";
-	FocusTree += "		ai_will_do = {\n";
-	FocusTree += "			factor = 10\n";
-	FocusTree += "			modifier = {\n";
-	FocusTree += "			}\n";
-	FocusTree += "		}	\n";
-	FocusTree += "		completion_reward = {\n";
-	FocusTree += "			add_ideas = improved_resource_industry\n";
-	FocusTree += "		}\n";
-	FocusTree += "	}";
-
-	//establish colonial army
-	FocusTree += "		focus = { \n";
-	FocusTree += "		id = ColonialArmy" + Home->getTag() + "\n";
-	FocusTree += "		icon = GFX_goal_generic_allies_build_infantry\n";
-	FocusTree += "		text = \"Establish Colonial Army\"\n";
-	FocusTree += "		prerequisite = { focus = StrengthenColonies" + Home->getTag() + " }\n";
-	FocusTree += "		x =  28\n";
-	FocusTree += "		y = 2\n";
-	FocusTree += "		cost = 10\n";
-	FocusTree += "		ai_will_do = {\n";
-	FocusTree += "			factor = 10\n";
-	FocusTree += "			modifier = {\n";
-	FocusTree += "			}\n";
-	FocusTree += "		}	\n";
-	FocusTree += "		completion_reward = {\n";
-	FocusTree += "			add_ideas = militarism_focus\n";
-	FocusTree += "		}\n";
-	FocusTree += "	}";
-	string protectorateNFs = "";
+	HoI4ScriptValues values;
+	values.setTag("HOME", Home->getTag());
+	values.setText("HOME_ADJECTIVE", Home->getSourceCountry()->getAdjective("english"));
+
+	//Glory to Empire!, strengthening the colonies or home, and the colonial industry and army
+	string FocusTree;
+	HoI4ScriptTemplates::get("monarchyEmpire").render(values, FocusTree);
+
 	//establish protectorate
 	if (ProtectorateNumber >= 1)
 	{
-		FocusTree += "focus = {\n";
-		FocusTree += "		id = Protectorate" + Home->getTag() + Annexed1->getTag() + "\n";
-		FocusTree += "		icon = GFX_goal_generic_major_war\n";
-		FocusTree += "		text = \"Establish Protectorate over " + Annexed1->getSourceCountry()->getName("english") + "\"\n";
-		FocusTree += "		available = { " + Annexed1->getTag() + " = { is_in_faction = no } }\n";
-		FocusTree += "		prerequisite = { focus = ColonialArmy" + Home->getTag() + " }\n";
-		FocusTree += "		x = 28\n";
-		FocusTree += "		y = 3\n";
-		FocusTree += "		cost = 10\n";
-		FocusTree += "		bypass = { \n";
-		FocusTree += "			\n";
-		FocusTree += "			OR = {\n";
-		FocusTree += "				" + Home->getTag() + " = { is_in_faction_with = " + Annexed1->getTag() + "\n";
-		FocusTree += "				has_war_with = " + Annexed1->getTag() + "}\n";
-		FocusTree += "				NOT = { country_exists = " + Annexed1->getTag() + " }\n";
-		FocusTree += "			}\n";
-		FocusTree += "		}\n";
-		FocusTree += "		ai_will_do = {\n";
-		FocusTree += "			factor = 10\n";
-		FocusTree += "			modifier = {\n";
-		FocusTree += "			factor = 0\n";
-		FocusTree += "			strength_ratio = { tag = " + Annexed1->getTag() + " ratio < 1 }\n";
-		FocusTree += "			}";
-		FocusTree += "		}	\n";
-		FocusTree += "		completion_reward = {\n";
-		FocusTree += "			create_wargoal = {\n";
-		FocusTree += "				type = annex_everything\n";
-		FocusTree += "				target = " + Annexed1->getTag() + "\n";
-		FocusTree += "			}";
-		FocusTree += "		}\n";
-		FocusTree += "	}\n";
-		protectorateNFs += " Protectorate" + Home->getTag() + Annexed1->getTag();
+		values.setTag("TARGET", Annexed1->getTag());
+		values.setText("TARGET_NAME", Annexed1->getSourceCountry()->getName("english"));
+		HoI4ScriptTemplates::get("monarchyProtectorate").render(values, FocusTree);
 	}
 	if (ProtectorateNumber >= 2)
 	{
-		FocusTree += "focus = {\n";
-		FocusTree += "		id = Protectorate" + Home->getTag() + Annexed2->getTag() + "\n";
-		FocusTree += "		icon = GFX_goal_generic_major_war\n";
-		FocusTree += "		text = \"Establish Protectorate over " + Annexed2->getSourceCountry()->getName("english") + "\"\n";
-		FocusTree += "		available = { " + Annexed2->getTag() + " = { is_in_faction = no } }\n";
-		FocusTree += "		prerequisite = { focus = Protectorate" + Home->getTag() + Annexed1->getTag() + " }\n";
-		FocusTree += "		x = 28\n";
-		FocusTree += "		y = 4\n";
-		FocusTree += "		cost = 10\n";
-		FocusTree += "		bypass = { \n";
-		FocusTree += "			\n";
-		FocusTree += "			OR = {\n";
-		FocusTree += "				" + Home->getTag() + " = { is_in_faction_with = " + Annexed1->getTag() + "\n";
-		FocusTree += "				has_war_with = " + Annexed1->getTag() + "}\n";
-		FocusTree += "				NOT = { country_exists = " + Annexed1->getTag() + " }\n";
-		FocusTree += "			}\n";
-		FocusTree += "		}\n";
-		FocusTree += "		ai_will_do = {\n";
-		FocusTree += "			factor = 5\n";
-		FocusTree += "			modifier = {\n";
-		FocusTree += "			factor = 0\n";
-		FocusTree += "			strength_ratio = { tag = " + Annexed2->getTag() + " ratio < 1 }\n";
-		FocusTree += "			}";
-		FocusTree += "		}	\n";
-		FocusTree += "		completion_reward = {\n";
-		FocusTree += "			create_wargoal = {\n";
-		FocusTree += "				type = annex_everything\n";
-		FocusTree += "				target = " + Annexed2->getTag() + "\n";
-		FocusTree += "			}";
-		FocusTree += "		}\n";
-		FocusTree += "	}\n";
-		protectorateNFs += " Protectorate" + Home->getTag() + Annexed2->getTag();
-	}
-
-	//Trade Empire
-	FocusTree += "		focus = { \n";
-	FocusTree += "		id = TradeEmpire" + Home->getTag() + "\n";
-	FocusTree += "		icon = GFX_goal_anschluss\n";
-	FocusTree += "		text = \"Fund the " + Home->getSourceCountry()->getAdjective("english") + " Colonial Trade Corporation\"\n";
-	FocusTree += "		prerequisite = { focus = ColonialHwy" + Home->getTag() + " focus = ResourceFac" + Home->getTag() + " }\n";
-	FocusTree += "		x =  25\n";
-	FocusTree += "		y = 4\n";
-	FocusTree += "		cost = 10\n";
-	FocusTree += "		ai_will_do = {\n";
-	FocusTree += "			factor = 10\n";
-	FocusTree += "			modifier = {\n";
-	FocusTree += "			}\n";
-	FocusTree += "		}	\n";
-	FocusTree += "		completion_reward = {\n";
-	FocusTree += "			add_ideas = established_traders";
-	FocusTree += "			set_country_flag = established_traders";
-	FocusTree += "			random_owned_state = {\n";
-	FocusTree += "				limit = {\n";
-	FocusTree += "					free_building_slots = {\n";
-	FocusTree += "						building = infrastructure\n";
-	FocusTree += "						size > 0\n";
-	FocusTree += "						include_locked = yes\n";
-	FocusTree += "					}\n";
-	FocusTree += "					OR = {\n";
-	FocusTree += "						is_in_home_area = no\n";
-	FocusTree += "						NOT = {\n";
-	FocusTree += "							owner = {\n";
-	FocusTree += "								any_owned_state = {\n";
-	FocusTree += "									free_building_slots = {\n";
-	FocusTree += "										building = infrastructure\n";
-	FocusTree += "										size > 0\n";
-	FocusTree += "										include_locked = yes\n";
-	FocusTree += "									}\n";
-	FocusTree += "									is_in_home_area = no\n";
-	FocusTree += "								}\n";
-	FocusTree += "							}\n";
-	FocusTree += "						}\n";
-	FocusTree += "					}\n";
-	FocusTree += "				}\n";
-	FocusTree += "				add_extra_state_shared_building_slots = 2\n";
-	FocusTree += "				add_building_construction = {\n";
-	FocusTree += "					type = dockyard\n";
-	FocusTree += "					level = 2\n";
-	FocusTree += "					instant_build = yes\n";
-	FocusTree += "				}\n";
-	FocusTree += "			}\n";
-	FocusTree += "		}\n";
-	FocusTree += "	}";
-
-	//Home Industry Buildup
-	FocusTree += "		focus = { \n";
-	FocusTree += "		id = IndHome" + Home->getTag() + "\n";
-	FocusTree += "		icon = GFX_goal_generic_production\n";
-	FocusTree += "		text = \"Fund Industrial Improvement\"\n";
-	FocusTree += "		prerequisite = { focus = StrengthenHome" + Home->getTag() + " }\n";
-	FocusTree += "		x =  31\n";
-	FocusTree += "		y = 2\n";
-	FocusTree += "		cost = 10\n";
-	FocusTree += "		ai_will_do = {\n";
-	FocusTree += "			factor = 10\n";
-	FocusTree += "		}	\n";
-	FocusTree += "		completion_reward = {\n";
-	//add tech
-	//FocusTree += "			research_time_factor = -0.1\n";
-	FocusTree += "		}\n";
-	FocusTree += "	}";
-
-	//National Highway
-	FocusTree += "		focus = { \n";
-	FocusTree += "		id = NationalHwy" + Home->getTag() + "\n";
-	FocusTree += "		icon = GFX_goal_generic_construct_infrastructure\n";
-	FocusTree += "		text = \"National Highway\"\n";
-	FocusTree += "		prerequisite = { focus = IndHome" + Home->getTag() + " }\n";
-	FocusTree += "		x =  30\n";
-	FocusTree += "		y = 3\n";
-	FocusTree += "		cost = 10\n";
-	FocusTree += "		ai_will_do = {\n";
-	FocusTree += "			factor = 10\n";
-	FocusTree += "			modifier = {\n";
-	FocusTree += "			}\n";
-	FocusTree += "		}	\n";
-	FocusTree += "		completion_reward = {\n";
-	FocusTree += "			random_owned_state = {\n";
-	FocusTree += "				limit = {\n";
-	FocusTree += "					free_building_slots = {\n";
-	FocusTree += "						building = infrastructure\n";
-	FocusTree += "						size > 0\n";
-	FocusTree += "						include_locked = yes\n";
-	FocusTree += "					}\n";
-	FocusTree += "					OR = {\n";
-	FocusTree += "						is_in_home_area = yes\n";
-	FocusTree += "						NOT = {\n";
-	FocusTree += "							owner = {\n";
-	FocusTree += "								any_owned_state = {\n";
-	FocusTree += "									free_building_slots = {\n";
-	FocusTree += "										building = infrastructure\n";
-	FocusTree += "										size > 0\n";
-	FocusTree += "										include_locked = yes\n";
-	FocusTree += "									}\n";
-	FocusTree += "									is_in_home_area = yes\n";
-	FocusTree += "								}\n";
-	FocusTree += "							}\n";
-	FocusTree += "						}\n";
-	FocusTree += "					}\n";
-	FocusTree += "				}\n";
-	FocusTree += "				add_extra_state_shared_building_slots = 1\n";
-	FocusTree += "				add_building_construction = {\n";
-	FocusTree += "					type = infrastructure\n";
-	FocusTree += "					level = 1\n";
-	FocusTree += "					instant_build = yes\n";
-	FocusTree += "				}\n";
-	FocusTree += "			}\n";
-	FocusTree += "		}\n";
-	FocusTree += "		completion_reward = {\n";
-	FocusTree += "			random_owned_state = {\n";
-	FocusTree += "				limit = {\n";
-	FocusTree += "					free_building_slots = {\n";
-	FocusTree += "						building = infrastructure\n";
-	FocusTree += "						size > 0\n";
-	FocusTree += "						include_locked = yes\n";
-	FocusTree += "					}\n";
-	FocusTree += "					OR = {\n";
-	FocusTree += "						is_in_home_area = yes\n";
-	FocusTree += "						NOT = {\n";
-	FocusTree += "							owner = {\n";
-	FocusTree += "								any_owned_state = {\n";
-	FocusTree += "									free_building_slots = {\n";
-	FocusTree += "										building = infrastructure\n";
-	FocusTree += "										size > 0\n";
-	FocusTree += "										include_locked = yes\n";
-	FocusTree += "									}\n";
-	FocusTree += "									is_in_home_area = yes\n";
-	FocusTree += "								}\n";
-	FocusTree += "							}\n";
-	FocusTree += "						}\n";
-	FocusTree += "					}\n";
-	FocusTree += "				}\n";
-	FocusTree += "				add_extra_state_shared_building_slots = 1\n";
-	FocusTree += "				add_building_construction = {\n";
-	FocusTree += "					type = infrastructure\n";
-	FocusTree += "					level = 1\n";
-	FocusTree += "					instant_build = yes\n";
-	FocusTree += "				}\n";
-	FocusTree += "			}\n";
-	FocusTree += "		}\n";
-	FocusTree += "		completion_reward = {\n";
-	FocusTree += "			random_owned_state = {\n";
-	FocusTree += "				limit = {\n";
-	FocusTree += "					free_building_slots = {\n";
-	FocusTree += "						building = infrastructure\n";
-	FocusTree += "						size > 0\n";
-	FocusTree += "						include_locked = yes\n";
-	FocusTree += "					}\n";
-	FocusTree += "					OR = {\n";
-	FocusTree += "						is_in_home_area = yes\n";
-	FocusTree += "						NOT = {\n";
-	FocusTree += "							owner = {\n";
-	FocusTree += "								any_owned_state = {\n";
-	FocusTree += "									free_building_slots = {\n";
-	FocusTree += "										building = infrastructure\n";
-	FocusTree += "										size > 0\n";
-	FocusTree += "										include_locked = yes\n";
-	FocusTree += "									}\n";
-	FocusTree += "									is_in_home_area = yes\n";
-	FocusTree += "								}\n";
-	FocusTree += "							}\n";
-	FocusTree += "						}\n";
-	FocusTree += "					}\n";
-	FocusTree += "				}\n";
-	FocusTree += "				add_extra_state_shared_building_slots = 1\n";
-	FocusTree += "				add_building_construction = {\n";
-	FocusTree += "					type = infrastructure\n";
-	FocusTree += "					level = 1\n";
-	FocusTree += "					instant_build = yes\n";
-	FocusTree += "				}\n";
-	FocusTree += "			}\n";
-	FocusTree += "		}\n";
-	FocusTree += "	}";
-
-	//National College
-	FocusTree += "		focus = { \n";
-	FocusTree += "		id = NatCollege" + Home->getTag() + "\n";
-	FocusTree += "		icon = GFX_goal_anschluss\n";
-	FocusTree += "		text = \"Establish National College\"\n";
-	FocusTree += "		prerequisite = { focus = IndHome" + Home->getTag() + " }\n";
-	FocusTree += "		x =  32\n";
-	FocusTree += "		y = 3\n";
-	FocusTree += "		cost = 10\n";
-	FocusTree += "		ai_will_do = {\n";
-	FocusTree += "			factor = 10\n";
-	FocusTree += "		}	\n";
-	FocusTree += "		completion_reward = {\n";
-	FocusTree += "			add_ideas = national_college\n";
-	FocusTree += "		}\n";
-	FocusTree += "	}";
-
-	//Improve Factories
-	FocusTree += "		focus = { \n";
-	FocusTree += "		id = MilitaryBuildup" + Home->getTag() + "\n";
-	FocusTree += "		icon = GFX_goal_generic_construct_mil_factory\n";
-	FocusTree += "		text = \"Military Buildup\"\n";
-	FocusTree += "		prerequisite = { focus = NatCollege" + Home->getTag() + " }\n";
-	FocusTree += "		prerequisite = { focus = NationalHwy" + Home->getTag() + " }\n";
-	FocusTree += "		x =  31\n";
-	FocusTree += "		y = 4\n";
-	FocusTree += "		cost = 10\n";
-	FocusTree += "		ai_will_do = {\n";
-	FocusTree += "			factor = 10\n";
-	FocusTree += "			modifier = {\n";
-	FocusTree += "			}\n";
-	FocusTree += "		}	\n";
-	FocusTree += "		completion_reward = {\n";
-	FocusTree += "			random_owned_state = {\n";
-	FocusTree += "				limit = {\n";
-	FocusTree += "					free_building_slots = {\n";
-	FocusTree += "						building = arms_factory\n";
-	FocusTree += "						size > 0\n";
-	FocusTree += "						include_locked = yes\n";
-	FocusTree += "					}\n";
-	FocusTree += "					OR = {\n";
-	FocusTree += "						is_in_home_area = yes\n";
-	FocusTree += "						NOT = {\n";
-	FocusTree += "							owner = {\n";
-	FocusTree += "								any_owned_state = {\n";
-	FocusTree += "									free_building_slots = {\n";
-	FocusTree += "										building = arms_factory\n";
-	FocusTree += "										size > 0\n";
-	FocusTree += "										include_locked = yes\n";
-	FocusTree += "									}\n";
-	FocusTree += "									is_in_home_area = yes\n";
-	FocusTree += "								}\n";
-	FocusTree += "							}\n";
-	FocusTree += "						}\n";
-	FocusTree += "					}\n";
-	FocusTree += "				}\n";
-	FocusTree += "				add_extra_state_shared_building_slots = 1\n";
-	FocusTree += "				add_building_construction = {\n";
-	FocusTree += "					type = arms_factory\n";
-	FocusTree += "					level = 1\n";
-	FocusTree += "					instant_build = yes\n";
-	FocusTree += "				}\n";
-	FocusTree += "			}\n";
-	FocusTree += "		}\n";
-	FocusTree += "		completion_reward = {\n";
-	FocusTree += "			random_owned_state = {\n";
-	FocusTree += "				limit = {\n";
-	FocusTree += "					free_building_slots = {\n";
-	FocusTree += "						building = arms_factory\n";
-	FocusTree += "						size > 0\n";
-	FocusTree += "						include_locked = yes\n";
-	FocusTree += "					}\n";
-	FocusTree += "					OR = {\n";
-	FocusTree += "						is_in_home_area = yes\n";
-	FocusTree += "						NOT = {\n";
-	FocusTree += "							owner = {\n";
-	FocusTree += "								any_owned_state = {\n";
-	FocusTree += "									free_building_slots = {\n";
-	FocusTree += "										building = arms_factory\n";
-	FocusTree += "										size > 0\n";
-	FocusTree += "										include_locked = yes\n";
-	FocusTree += "									}\n";
-	FocusTree += "									is_in_home_area = yes\n";
-	FocusTree += "								}\n";
-	FocusTree += "							}\n";
-	FocusTree += "						}\n";
-	FocusTree += "					}\n";
-	FocusTree += "				}\n";
-	FocusTree += "				add_extra_state_shared_building_slots = 1\n";
-	FocusTree += "				add_building_construction = {\n";
-	FocusTree += "					type = arms_factory\n";
-	FocusTree += "					level = 1\n";
-	FocusTree += "					instant_build = yes\n";
-	FocusTree += "				}\n";
-	FocusTree += "			}\n";
-	FocusTree += "		}\n";
-	FocusTree += "		completion_reward = {\n";
-	FocusTree += "			random_owned_state = {\n";
-	FocusTree += "				limit = {\n";
-	FocusTree += "					free_building_slots = {\n";
-	FocusTree += "						building = arms_factory\n";
-	FocusTree += "						size > 0\n";
-	FocusTree += "						include_locked = yes\n";
-	FocusTree += "					}\n";
-	FocusTree += "					OR = {\n";
-	FocusTree += "						is_in_home_area = yes\n";
-	FocusTree += "						NOT = {\n";
-	FocusTree += "							owner = {\n";
-	FocusTree += "								any_owned_state = {\n";
-	FocusTree += "									free_building_slots = {\n";
-	FocusTree += "										building = arms_factory\n";
-	FocusTree += "										size > 0\n";
-	FocusTree += "										include_locked = yes\n";
-	FocusTree += "									}\n";
-	FocusTree += "									is_in_home_area = yes\n";
-	FocusTree += "								}\n";
-	FocusTree += "							}\n";
-	FocusTree += "						}\n";
-	FocusTree += "					}\n";
-	FocusTree += "				}\n";
-	FocusTree += "				add_extra_state_shared_building_slots = 1\n";
-	FocusTree += "				add_building_construction = {\n";
-	FocusTree += "					type = arms_factory\n";
-	FocusTree += "					level = 1\n";
-	FocusTree += "					instant_build = yes\n";
-	FocusTree += "				}\n";
-	FocusTree += "			}\n";
-	FocusTree += "		}\n";
-	FocusTree += "	}";
-
-	//PrepBorder
-	FocusTree += "		focus = { \n";
-	FocusTree += "		id = PrepTheBorder" + Home->getTag() + "\n";
-	FocusTree += "		icon = GFX_goal_generic_defence\n";
-	FocusTree += "		text = \"Prepare the Border\"\n";
-	FocusTree += "		prerequisite = { focus = StrengthenHome" + Home->getTag() + " }\n";
-	FocusTree += "		x =  34\n";
-	FocusTree += "		y = 2\n";
-	FocusTree += "		cost = 10\n";
-	FocusTree += "		ai_will_do = {\n";
-	FocusTree += "			factor = 10\n";
-	FocusTree += "			modifier = {\n";
-	FocusTree += "			}\n";
-	FocusTree += "		}	\n";
-	FocusTree += "		completion_reward = {\n";
-	FocusTree += "			add_ideas = border_buildup\n";
-	FocusTree += "		}\n";
-	FocusTree += "	}";
-
-	//Promote Nationalistic Spirit
-	FocusTree += "		focus = { \n";
-	FocusTree += "		id = NatSpirit" + Home->getTag() + "\n";
-	FocusTree += "		icon = GFX_goal_generic_political_pressure\n";
-	FocusTree += "		text = \"Promote Nationalistic Spirit\"\n";
-	FocusTree += "		prerequisite = { focus = PrepTheBorder" + Home->getTag() + " }\n";
-	FocusTree += "		x =  34\n";
-	FocusTree += "		y = 3\n";
-	FocusTree += "		cost = 10\n";
-	FocusTree += "		ai_will_do = {\n";
-	FocusTree += "			factor = 10\n";
-	FocusTree += "			modifier = {\n";
-	FocusTree += "			}\n";
-	FocusTree += "		}	\n";
-	FocusTree += "		completion_reward = {\n";
-	FocusTree += "			add_ideas = paramilitarism_focus\n";
-	FocusTree += "		}\n";
-	FocusTree += "	}";
+		values.setTag("TARGET", Annexed2->getTag());
+		values.setText("TARGET_NAME", Annexed2->getSourceCountry()->getName("english"));
+		values.setTag("FIRST_TARGET", Annexed1->getTag());
+		HoI4ScriptTemplates::get("monarchySecondProtectorate").render(values, FocusTree);
+	}
+
+	//Trade Empire, and the home industry, military and borders
+	HoI4ScriptTemplates::get("monarchyHome").render(values, FocusTree);
 
 	//ANNEX
 	if (AnnexNumber >= 1)
 	{
-		FocusTree += "focus = {\n";
-		FocusTree += "		id = Annex" + Home->getTag() + Annexed3->getTag() + "\n";
-		FocusTree += "		icon = GFX_goal_generic_major_war\n";
-		FocusTree += "		text = \"Conquer " + Annexed3->getSourceCountry()->getName("english") + "\"\n";
-		FocusTree += "		available = { " + Annexed3->getTag() + " = { is_in_faction = no } }\n";
-		FocusTree += "		prerequisite = { focus = PrepTheBorder" + Home->getTag() + " }\n";
-		FocusTree += "		x = 36\n";
-		FocusTree += "		y = 3\n";
-		FocusTree += "		cost = 10\n";
-		FocusTree += "		bypass = { \n";
-		FocusTree += "			\n";
-		FocusTree += "			OR = {\n";
-		FocusTree += "				" + Home->getTag() + " = { is_in_faction_with = " + Annexed1->getTag() + "\n";
-		FocusTree += "				has_war_with = " + Annexed1->getTag() + "}\n";
-		FocusTree += "				NOT = { country_exists = " + Annexed1->getTag() + " }\n";
-		FocusTree += "			}\n";
-		FocusTree += "		}\n";
-		FocusTree += "		ai_will_do = {\n";
-		FocusTree += "			factor = 5\n";
-		FocusTree += "			modifier = {\n";
-		FocusTree += "			factor = 0\n";
-		FocusTree += "			strength_ratio = { tag = " + Annexed3->getTag() + " ratio < 1 }\n";
-		FocusTree += "			}";
-		FocusTree += "		}	\n";
-		FocusTree += "		completion_reward = {\n";
-		FocusTree += "			create_wargoal = {\n";
-		FocusTree += "				type = annex_everything\n";
-		FocusTree += "				target = " + Annexed3->getTag() + "\n";
-		FocusTree += "			}";
-		FocusTree += "		}\n";
-		FocusTree += "	}\n";
+		values.setTag("TARGET", Annexed3->getTag());
+		values.setText("TARGET_NAME", Annexed3->getSourceCountry()->getName("english"));
+		values.setTag("FIRST_TARGET", Annexed1->getTag());
+		HoI4ScriptTemplates::get("monarchyAnnex").render(values, FocusTree);
 	}
 	if (AnnexNumber >= 2)
 	{
-		FocusTree += "focus = {\n";
-		FocusTree += "		id = Annex" + Home->getTag() + Annexed4->getTag() + "\n";
-		FocusTree += "		icon = GFX_goal_generic_major_war\n";
-		FocusTree += "		text = \"Conquer " + Annexed4->getSourceCountry()->getName("english") + "\"\n";
-		FocusTree += "		available = { " + Annexed4->getTag() + " = { is_in_faction = no } }\n";
-		FocusTree += "		prerequisite = { focus = NatSpirit" + Home->getTag() + " }\n";
-		FocusTree += "		x = 34\n";
-		FocusTree += "		y = 4\n";
-		FocusTree += "		cost = 10\n";
-		FocusTree += "		bypass = { \n";
-		FocusTree += "			\n";
-		FocusTree += "			OR = {\n";
-		FocusTree += "				" + Home->getTag() + " = { is_in_faction_with = " + Annexed1->getTag() + "\n";
-		FocusTree += "				has_war_with = " + Annexed1->getTag() + "}\n";
-		FocusTree += "				NOT = { country_exists = " + Annexed1->getTag() + " }\n";
-		FocusTree += "			}\n";
-		FocusTree += "		}\n";
-		FocusTree += "		ai_will_do = {\n";
-		FocusTree += "			factor = 5\n";
-		FocusTree += "			modifier = {\n";
-		FocusTree += "			factor = 0\n";
-		FocusTree += "			strength_ratio = { tag = " + Annexed4->getTag() + " ratio < 1 }\n";
-		FocusTree += "			}";
-		FocusTree += "		}	\n";
-		FocusTree += "		completion_reward = {\n";
-		FocusTree += "			create_wargoal = {\n";
-		FocusTree += "				type = annex_everything\n";
-		FocusTree += "				target = " + Annexed4->getTag() + "\n";
-		FocusTree += "			}";
-		FocusTree += "		}\n";
-		FocusTree += "	}\n";
+		values.setTag("TARGET", Annexed4->getTag());
+		values.setText("TARGET_NAME", Annexed4->getSourceCountry()->getName("english"));
+		values.setTag("FIRST_TARGET", Annexed1->getTag());
+		HoI4ScriptTemplates::get("monarchySecondAnnex").render(values, FocusTree);
 	}
 
-
 	return FocusTree;
 }
-void HoI4World::fillProvinceNeighbors()
-{
-	std::ifstream file("adj.txt");
-	std::string str;
-	while (std::getline(file, str))
-	{
-		//	char output[100];
-		//myReadFile >> output;
-		vector<string> parts;
-		stringstream ss(str); // Turn the string into a stream.
-		string tok;
-		char delimiter = ';';
-		//crashes
-		while (getline(ss, tok, delimiter))
-			parts.push_back(tok);
-		vector<int> provneighbors;
-		for (unsigned int i = 5; i < parts.size(); i++)
-		{
-			//crashes
-			int neighborprov = stoi(parts[i]);
-			provneighbors.push_back(neighborprov);
-		}
-		provinceNeighbors.insert(make_pair(stoi(parts[0]), provneighbors));
-	}
-	file.close();
-}
 string HoI4World::genericFocusTreeCreator(HoI4Country* CreatingCountry)
 {
-	string s;
 	//DOES NOT INCLUDE LAST BRACKET!
-	s += "focus_tree = { \n";
-	s += "	id = german_focus\n";
-	s += "	\n";
-	s += "	country = {\n";
-	s += "		factor = 0\n";
-	s += "		\n";
-	s += "		modifier = {\n";
-	s += "			add = 10\n";
-	s += "			tag = " + CreatingCountry->getTag() + "\n";
-	s += "		}\n";
-	s += "	}\n";
-	s += "	\n";
-	s += "	default = no\n";
-	s += "\n";
-	s += "	focus = {\n";
-	s += "		id = army_effort" + CreatingCountry->getTag() + "\n";
-	s += "		icon = GFX_goal_generic_allies_build_infantry\n";
-	s += "		x = 1\n";
-	s += "		y = 0\n";
-	s += "		cost = 10\n";
-	s += "		completion_reward = {\n";
-	s += "			army_experience = 5\n";
-	s += "			add_tech_bonus = {\n";
-	s += "				name = land_doc_bonus\n";
-	s += "				bonus = 0.5\n";
-	s += "				uses = 1\n";
-	s += "				category = land_doctrine\n";
-	s += "			}\n";
-	s += "		}\n";
-	s += "	}\n";
-	s += "\n";
-	s += "	focus = {\n";
-	s += "		id = equipment_effort" + CreatingCountry->getTag() + "\n";
-	s += "		icon = GFX_goal_generic_small_arms\n";
-	s += "		prerequisite = { focus = army_effort" + CreatingCountry->getTag() + " }\n";
-	s += "		x = 0\n";
-	s += "		y = 1\n";
-	s += "		cost = 10\n";
-	s += "		completion_reward = {\n";
-	s += "			add_tech_bonus = {\n";
-	s += "				name = infantry_weapons_bonus\n";
-	s += "				bonus = 0.5\n";
-	s += "				uses = 1\n";
-	s += "				category = infantry_weapons\n";
-	s += "				category = artillery\n";
-	s += "			}\n";
-	s += "		}\n";
-	s += "	}\n";
-	s += "\n";
-	s += "	focus = {\n";
-	s += "		id = motorization_effort" + CreatingCountry->getTag() + "\n";
-	s += "		icon = GFX_goal_generic_army_motorized\n";
-	s += "		prerequisite = { focus = army_effort" + CreatingCountry->getTag() + " }\n";
-	s += "		bypass = { has_tech = motorised_infantry }\n";
-	s += "		x = 2\n";
-	s += "		y = 1\n";
-	s += "		cost = 10\n";
-	s += "		completion_reward = {\n";
-	s += "			add_tech_bonus = {\n";
-	s += "				name = motorized_bonus\n";
-	s += "				bonus = 0.75\n";
-	s += "				technology = motorised_infantry\n";
-	s += "			}\n";
-	s += "		}\n";
-	s += "	}\n";
-	s += "\n";
-	s += "	focus = {\n";
-	s += "		id = doctrine_effort" + CreatingCountry->getTag() + "\n";
-	s += "		icon = GFX_goal_generic_army_doctrines\n";
-	s += "		prerequisite = { focus = army_effort" + CreatingCountry->getTag() + " }\n";
-	s += "		x = 1\n";
-	s += "		y = 2\n";
-	s += "		cost = 10\n";
-	s += "		completion_reward = {\n";
-	s += "			army_experience = 5\n";
-	s += "			add_tech_bonus = {\n";
-	s += "				name = land_doc_bonus\n";
-	s += "				bonus = 0.5\n";
-	s += "				uses = 1\n";
-	s += "				category = land_doctrine\n";
-	s += "			}\n";
-	s += "		}\n";
-	s += "	}\n";
-	s += "\n";
-	s += "	focus = {\n";
-	s += "		id = equipment_effort_2" + CreatingCountry->getTag() + "\n";
-	s += "		icon = GFX_goal_generic_army_artillery\n";
-	s += "		prerequisite = { focus = equipment_effort" + CreatingCountry->getTag() + " }\n";
-	s += "		x = 0\n";
-	s += "		y = 3\n";
-	s += "		cost = 10\n";
-	s += "		completion_reward = {\n";
-	s += "			add_tech_bonus = {\n";
-	s += "				name = infantry_artillery_bonus\n";
-	s += "				bonus = 0.5\n";
-	s += "				uses = 1\n";
-	s += "				category = infantry_weapons\n";
-	s += "				category = artillery\n";
-	s += "			}\n";
-	s += "		}\n";
-	s += "	}\n";
-	s += "\n";
-	s += "	focus = {\n";
-	s += "		id = mechanization_effort" + CreatingCountry->getTag() + "\n";
-	s += "		icon = GFX_goal_generic_build_tank\n";
-	s += "		prerequisite = { focus = motorization_effort" + CreatingCountry->getTag() + " }\n";
-	s += "		x = 2\n";
-	s += "		y = 3\n";
-	s += "		cost = 10\n";
-	s += "		completion_reward = {\n";
-	s += "			add_tech_bonus = {\n";
-	s += "				name = motorized_bonus\n";
-	s += "				ahead_reduction = 0.5\n";
-	s += "				uses = 1\n";
-	s += "				category = motorized_equipment\n";
-	s += "			}\n";
-	s += "		}\n";
-	s += "	}\n";
-	s += "\n";
-	s += "	focus = {\n";
-	s += "		id = doctrine_effort_2" + CreatingCountry->getTag() + "\n";
-	s += "		icon = GFX_goal_generic_army_doctrines\n";
-	s += "		prerequisite = { focus = doctrine_effort" + CreatingCountry->getTag() + " }\n";
-	s += "		x = 1\n";
-	s += "		y = 4\n";
-	s += "		cost = 10\n";
-	s += "		completion_reward = {\n";
-	s += "			army_experience = 5\n";
-	s += "			add_tech_bonus = {\n";
-	s += "				name = land_doc_bonus\n";
-	s += "				bonus = 0.5\n";
-	s += "				uses = 1\n";
-	s += "				category = land_doctrine\n";
-	s += "			}\n";
-	s += "		}\n";
-	s += "	}\n";
-	s += "\n";
-	s += "	focus = {\n";
-	s += "		id = equipment_effort_3" + CreatingCountry->getTag() + "\n";
-	s += "		icon = GFX_goal_generic_army_artillery2\n";
-	s += "		prerequisite = { focus = equipment_effort_2" + CreatingCountry->getTag() + " }\n";
-	s += "		x = 0\n";
-	s += "		y = 5\n";
-	s += "		cost = 10\n";
-	s += "		completion_reward = {\n";
-	s += "			add_tech_bonus = {\n";
-	s += "				name = infantry_artillery_bonus\n";
-	s += "				ahead_reduction = 1\n";
-	s += "				uses = 1\n";
-	s += "				category = infantry_weapons\n";
-	s += "				category = artillery\n";
-	s += "			}\n";
-	s += "		}\n";
-	s += "	}\n";
-	s += "\n";
-	s += "	focus = {\n";
-	s += "		id = armor_effort" + CreatingCountry->getTag() + "\n";
-	s += "		icon = GFX_goal_generic_army_tanks\n";
-	s += "		prerequisite = { focus = mechanization_effort" + CreatingCountry->getTag() + " }\n";
-	s += "		x = 2\n";
-	s += "		y = 5\n";
-	s += "		cost = 10\n";
-	s += "		completion_reward = {\n";
-	s += "			add_tech_bonus = {\n";
-	s += "				name = armor_bonus\n";
-	s += "				bonus = 0.5\n";
-	s += "				uses = 2\n";
-	s += "				category = armor\n";
-	s += "			}\n";
-	s += "		}\n";
-	s += "	}\n";
-	s += "\n";
-	s += "	focus = {\n";
-	s += "		id = special_forces" + CreatingCountry->getTag() + "\n";
-	s += "		icon = GFX_goal_generic_special_forces\n";
-	s += "		prerequisite = { focus = equipment_effort_3" + CreatingCountry->getTag() + " }\n";
-	s += "		prerequisite = { focus = doctrine_effort_2" + CreatingCountry->getTag() + " }\n";
-	s += "		prerequisite = { focus = armor_effort" + CreatingCountry->getTag() + " }\n";
-	s += "		x = 1\n";
-	s += "		y = 6\n";
-	s += "		cost = 10\n";
-	s += "		completion_reward = {\n";
-	s += "			add_tech_bonus = {\n";
-	s += "				name = special_forces_bonus\n";
-	s += "				bonus = 0.5\n";
-	s += "				uses = 1\n";
-	s += "				technology = paratroopers\n";
-	s += "				technology = paratroopers2\n";
-	s += "				technology = marines\n";
-	s += "				technology = marines2\n";
-	s += "				technology = tech_mountaineers\n";
-	s += "				technology = tech_mountaineers2\n";
-	s += "			}\n";
-	s += "		}\n";
-	s += "	}\n";
-	s += "\n";
-	s += "	focus = {\n";
-	s += "		id = aviation_effort" + CreatingCountry->getTag() + "\n";
-	s += "		icon = GFX_goal_generic_build_airforce\n";
-	s += "		x = 5\n";
-	s += "		y = 0\n";
-	s += "		cost = 10\n";
-	s += "\n";
-	s += "		complete_tooltip = {\n";
-	s += "			air_experience = 25\n";
-	s += "			if = { limit = { has_country_flag = aviation_effort_AB }\n";
-	s += "				add_building_construction = {\n";
-	s += "					type = air_base\n";
-	s += "					level = 2\n";
-	s += "					instant_build = yes\n";
-	s += "				}\n";
-	s += "			}			\n";
-	s += "			add_tech_bonus = {\n";
-	s += "				name = air_doc_bonus\n";
-	s += "				bonus = 0.5\n";
-	s += "				uses = 1\n";
-	s += "				category = air_doctrine\n";
-	s += "			}			\n";
-	s += "		}\n";
-	s += "\n";
-	s += "		completion_reward = {\n";
-	s += "			air_experience = 25\n";
-	s += "\n";
-	s += "			if = {\n";
-	s += "				limit = {\n";
-	s += "					capital_scope = {\n";
-	s += "						NOT = {\n";
-	s += "							free_building_slots = {\n";
-	s += "								building = air_base\n";
-	s += "								size > 1\n";
-	s += "							}\n";
-	s += "						}\n";
-	s += "					}\n";
-	s += "				}\n";
-	s += "				random_owned_state = {\n";
-	s += "					limit = {\n";
-	s += "						free_building_slots = {\n";
-	s += "							building = air_base\n";
-	s += "							size > 1\n";
-	s += "						}\n";
-	s += "					}\n";
-	s += "					add_building_construction = {\n";
-	s += "						type = air_base\n";
-	s += "						level = 2\n";
-	s += "						instant_build = yes\n";
-	s += "					}\n";
-	s += "					ROOT = { set_country_flag = aviation_effort_AB }\n";
-	s += "				}\n";
-	s += "			}\n";
-	s += "			if = {\n";
-	s += "				limit = {\n";
-	s += "					capital_scope = {\n";
-	s += "						free_building_slots = {\n";
-	s += "							building = air_base\n";
-	s += "							size > 1\n";
-	s += "						}\n";
-	s += "					}\n";
-	s += "				}\n";
-	s += "				capital_scope = {\n";
-	s += "					add_building_construction = {\n";
-	s += "						type = air_base\n";
-	s += "						level = 2\n";
-	s += "						instant_build = yes\n";
-	s += "					}\n";
-	s += "					ROOT = { set_country_flag = aviation_effort_AB }\n";
-	s += "				}\n";
-	s += "			}\n";
-	s += "			add_tech_bonus = {\n";
-	s += "				name = air_doc_bonus\n";
-	s += "				bonus = 0.5\n";
-	s += "				uses = 1\n";
-	s += "				category = air_doctrine\n";
-	s += "			}\n";
-	s += "		}\n";
-	s += "	}\n";
-	s += "\n";
-	s += "	focus = {\n";
-	s += "		id = fighter_focus" + CreatingCountry->getTag() + "\n";
-	s += "		icon = GFX_goal_generic_air_fighter\n";
-	s += "		prerequisite = { focus = aviation_effort" + CreatingCountry->getTag() + " }\n";
-	s += "		mutually_exclusive = { focus = bomber_focus" + CreatingCountry->getTag() + " }\n";
-	s += "		x = 4\n";
-	s += "		y = 1\n";
-	s += "		cost = 10\n";
-	s += "		completion_reward = {\n";
-	s += "			add_tech_bonus = {\n";
-	s += "				name = fighter_bonus\n";
-	s += "				bonus = 0.5\n";
-	s += "				uses = 2\n";
-	s += "				technology = early_fighter\n";
-	s += "				technology = fighter1\n";
-	s += "				technology = fighter2\n";
-	s += "				technology = fighter3\n";
-	s += "				technology = heavy_fighter1\n";
-	s += "				technology = heavy_fighter2\n";
-	s += "				technology = heavy_fighter3\n";
-	s += "			}\n";
-	s += "		}\n";
-	s += "	}\n";
-	s += "\n";
-	s += "	focus = {\n";
-	s += "		id = bomber_focus" + CreatingCountry->getTag() + "\n";
-	s += "		icon = GFX_goal_generic_air_bomber\n";
-	s += "		prerequisite = { focus = aviation_effort" + CreatingCountry->getTag() + " }\n";
-	s += "		mutually_exclusive = { focus = fighter_focus" + CreatingCountry->getTag() + " }\n";
-	s += "		x = 6\n";
-	s += "		y = 1\n";
-	s += "		cost = 10\n";
-	s += "		completion_reward = {\n";
-	s += "			add_tech_bonus = {\n";
-	s += "				name = bomber_bonus\n";
-	s += "				bonus = 0.5\n";
-	s += "				uses = 2\n";
-	s += "				technology = strategic_bomber1\n";
-	s += "				technology = strategic_bomber2\n";
-	s += "				technology = strategic_bomber3\n";
-	s += "				category = tactical_bomber\n";
-	s += "			}\n";
-	s += "		}\n";
-	s += "	}\n";
-	s += "\n";
-	s += "	focus = {\n";
-	s += "		id = aviation_effort_2" + CreatingCountry->getTag() + "\n";
-	s += "		icon = GFX_goal_generic_air_doctrine\n";
-	s += "		prerequisite = { focus = bomber_focus focus = fighter_focus" + CreatingCountry->getTag() + " }\n";
-	s += "		x = 5\n";
-	s += "		y = 2\n";
-	s += "		cost = 10\n";
-	s += "\n";
-	s += "		complete_tooltip = {\n";
-	s += "			air_experience = 25\n";
-	s += "			if = { limit = { has_country_flag = aviation_effort_2_AB }\n";
-	s += "				add_building_construction = {\n";
-	s += "					type = air_base\n";
-	s += "					level = 2\n";
-	s += "					instant_build = yes\n";
-	s += "				}\n";
-	s += "			}\n";
-	s += "			add_tech_bonus = {\n";
-	s += "				name =  air_doc_bonus\n";
-	s += "				bonus = 0.5\n";
-	s += "				uses = 1\n";
-	s += "				category = air_doctrine\n";
-	s += "			}\n";
-	s += "		}\n";
-	s += "		completion_reward = {\n";
-	s += "			air_experience = 25\n";
-	s += "			if = {\n";
-	s += "				limit = {\n";
-	s += "					capital_scope = {\n";
-	s += "						NOT = {\n";
-	s += "							free_building_slots = {\n";
-	s += "								building = air_base\n";
-	s += "								size > 1\n";
-	s += "							}\n";
-	s += "						}\n";
-	s += "					}\n";
-	s += "				}\n";
-	s += "				random_owned_state = {\n";
-	s += "					limit = {\n";
-	s += "						free_building_slots = {\n";
-	s += "							building = air_base\n";
-	s += "							size > 1\n";
-	s += "						}\n";
-	s += "					}\n";
-	s += "					add_building_construction = {\n";
-	s += "						type = air_base\n";
-	s += "						level = 2\n";
-	s += "						instant_build = yes\n";
-	s += "					}\n";
-	s += "					ROOT = { set_country_flag = aviation_effort_2_AB }\n";
-	s += "				}\n";
-	s += "			}\n";
-	s += "			if = {\n";
-	s += "				limit = {\n";
-	s += "					capital_scope = {\n";
-	s += "						free_building_slots = {\n";
-	s += "							building = air_base\n";
-	s += "							size > 1\n";
-	s += "						}\n";
-	s += "					}\n";
-	s += "				}\n";
-	s += "				capital_scope = {\n";
-	s += "					add_building_construction = {\n";
-	s += "						type = air_base\n";
-	s += "						level = 2\n";
-	s += "						instant_build = yes\n";
-	s += "					}				\n";
-	s += "					ROOT = { set_country_flag = aviation_effort_2_AB }\n";
-	s += "				}\n";
-	s += "			}\n";
-	s += "			add_tech_bonus = {\n";
-	s += "				name =  air_doc_bonus\n";
-	s += "				bonus = 0.5\n";
-	s += "				uses = 1\n";
-	s += "				category = air_doctrine\n";
-	s += "			}\n";
-	s += "		}\n";
-	s += "	}\n";
-	s += "\n";
-	s += "	focus = {\n";
-	s += "		id = CAS_effort" + CreatingCountry->getTag() + "\n";
-	s += "		icon = GFX_goal_generic_CAS\n";
-	s += "		prerequisite = { focus = aviation_effort_2" + CreatingCountry->getTag() + " }\n";
-	s += "		prerequisite = { focus = motorization_effort" + CreatingCountry->getTag() + " }\n";
-	s += "		x = 4\n";
-	s += "		y = 3\n";
-	s += "		cost = 10\n";
-	s += "		completion_reward = {\n";
-	s += "			add_tech_bonus = {\n";
-	s += "				name = CAS_bonus\n";
-	s += "				bonus = 0.5\n";
-	s += "				ahead_reduction = 1\n";
-	s += "				uses = 1\n";
-	s += "				category = cas_bomber\n";
-	s += "			}\n";
-	s += "		}\n";
-	s += "	}\n";
-	s += "\n";
-	s += "	focus = {\n";
-	s += "		id = rocket_effort" + CreatingCountry->getTag() + "\n";
-	s += "		icon = GFX_focus_rocketry\n";
-	s += "		prerequisite = { focus = aviation_effort_2" + CreatingCountry->getTag() + " }\n";
-	s += "		prerequisite = { focus = infrastructure_effort" + CreatingCountry->getTag() + " }\n";
-	s += "		x = 5\n";
-	s += "		y = 4\n";
-	s += "		cost = 10\n";
-	s += "		completion_reward = {\n";
-	s += "			add_tech_bonus = {\n";
-	s += "				name = jet_rocket_bonus\n";
-	s += "				ahead_reduction = 0.5\n";
-	s += "				uses = 2\n";
-	s += "				category = rocketry\n";
-	s += "				category = jet_technology\n";
-	s += "			}\n";
-	s += "		}\n";
-	s += "\n";
-	s += "		ai_will_do = {\n";
-	s += "			factor = 1\n";
-	s += "			modifier = {\n";
-	s += "				factor = 0.25\n";
-	s += "				always = yes\n";
-	s += "			}\n";
-	s += "		}\n";
-	s += "	}\n";
-	s += "\n";
-	s += "	focus = {\n";
-	s += "		id = NAV_effort" + CreatingCountry->getTag() + "\n";
-	s += "		icon = GFX_goal_generic_air_naval_bomber\n";
-	s += "		prerequisite = { focus = aviation_effort_2" + CreatingCountry->getTag() + " }\n";
-	s += "		prerequisite = { focus = flexible_navy" + CreatingCountry->getTag() + " }\n";
-	s += "		x = 6\n";
-	s += "		y = 3\n";
-	s += "		cost = 10\n";
-	s += "		completion_reward = {\n";
-	s += "			add_tech_bonus = {\n";
-	s += "				name = nav_bomber_bonus\n";
-	s += "				bonus = 0.5\n";
-	s += "				ahead_reduction = 1\n";
-	s += "				uses = 1\n";
-	s += "				category = naval_bomber\n";
-	s += "			}\n";
-	s += "		}\n";
-	s += "	}\n";
-	s += "\n";
-	s += "	focus = {\n";
-	s += "		id = naval_effort" + CreatingCountry->getTag() + "\n";
-	s += "		icon = GFX_goal_generic_construct_naval_dockyard\n";
-	s += "		x = 9\n";
-	s += "		y = 0\n";
-	s += "		cost = 10\n";
-	s += "\n";
-	s += "		available = {\n";
-	s += "			any_state = {\n";
-	s += "				is_coastal = yes\n";
-	s += "				is_controlled_by = ROOT\n";
-	s += "			}\n";
-	s += "		}\n";
-	s += "\n";
-	s += "		complete_tooltip = {\n";
-	s += "			navy_experience = 25\n";
-	s += "			add_extra_state_shared_building_slots = 3\n";
-	s += "			add_building_construction = {\n";
-	s += "				type = dockyard\n";
-	s += "				level = 3\n";
-	s += "				instant_build = yes\n";
-	s += "			}\n";
-	s += "		}\n";
-	s += "		\n";
-	s += "		completion_reward = {\n";
-	s += "			navy_experience = 25\n";
-	s += "			if = {\n";
-	s += "				limit = {\n";
-	s += "					NOT = {\n";
-	s += "						any_owned_state = {\n";
-	s += "							dockyard > 0\n";
-	s += "							free_building_slots = {\n";
-	s += "								building = dockyard\n";
-	s += "								size > 2\n";
-	s += "								include_locked = yes\n";
-	s += "							}\n";
-	s += "						}\n";
-	s += "					}\n";
-	s += "					any_owned_state = {\n";
-	s += "						is_coastal = yes\n";
-	s += "					}\n";
-	s += "				}\n";
-	s += "				random_owned_state = {\n";
-	s += "					limit = {\n";
-	s += "						is_coastal = yes\n";
-	s += "						free_building_slots = {\n";
-	s += "							building = dockyard\n";
-	s += "							size > 2\n";
-	s += "							include_locked = yes\n";
-	s += "						}\n";
-	s += "					}\n";
-	s += "					add_extra_state_shared_building_slots = 3\n";
-	s += "					add_building_construction = {\n";
-	s += "						type = dockyard\n";
-	s += "						level = 3\n";
-	s += "						instant_build = yes\n";
-	s += "					}\n";
-	s += "				}\n";
-	s += "				set_country_flag = naval_effort_built\n";
-	s += "			}\n";
-	s += "			if = {\n";
-	s += "				limit = {\n";
-	s += "					NOT = { has_country_flag = naval_effort_built }\n";
-	s += "					any_owned_state = {\n";
-	s += "						dockyard > 0\n";
-	s += "						free_building_slots = {\n";
-	s += "							building = dockyard\n";
-	s += "							size > 2\n";
-	s += "							include_locked = yes\n";
-	s += "						}\n";
-	s += "					}\n";
-	s += "				}\n";
-	s += "				random_owned_state = {\n";
-	s += "					limit = {\n";
-	s += "						dockyard > 0\n";
-	s += "						free_building_slots = {\n";
-	s += "							building = dockyard\n";
-	s += "							size > 2\n";
-	s += "							include_locked = yes\n";
-	s += "						}\n";
-	s += "					}\n";
-	s += "					add_extra_state_shared_building_slots = 3\n";
-	s += "					add_building_construction = {\n";
-	s += "						type = dockyard\n";
-	s += "						level = 3\n";
-	s += "						instant_build = yes\n";
-	s += "					}\n";
-	s += "				}\n";
-	s += "				set_country_flag = naval_effort_built\n";
-	s += "			}\n";
-	s += "			if = {\n";
-	s += "				limit = {\n";
-	s += "					NOT = { has_country_flag = naval_effort_built }\n";
-	s += "					NOT = {\n";
-	s += "						any_owned_state = {\n";
-	s += "							free_building_slots = {\n";
-	s += "								building = dockyard\n";
-	s += "								size > 2\n";
-	s += "								include_locked = yes\n";
-	s += "							}\n";
-	s += "						}\n";
-	s += "					}\n";
-	s += "				}\n";
-	s += "				random_state = {\n";
-	s += "					limit = {\n";
-	s += "						controller = { tag = ROOT }\n";
-	s += "						free_building_slots = {\n";
-	s += "							building = dockyard\n";
-	s += "							size > 2\n";
-	s += "							include_locked = yes\n";
-	s += "						}\n";
-	s += "					}\n";
-	s += "					add_extra_state_shared_building_slots = 3\n";
-	s += "					add_building_construction = {\n";
-	s += "						type = dockyard\n";
-	s += "						level = 3\n";
-	s += "						instant_build = yes\n";
-	s += "					}\n";
-	s += "				}\n";
-	s += "			}			\n";
-	s += "		}\n";
-	s += "	}\n";
-	s += "\n";
-	s += "	focus = {\n";
-	s += "		id = flexible_navy" + CreatingCountry->getTag() + "\n";
-	s += "		icon = GFX_goal_generic_build_navy\n";
-	s += "		prerequisite = { focus = naval_effort" + CreatingCountry->getTag() + " }\n";
-	s += "		mutually_exclusive = { focus = large_navy" + CreatingCountry->getTag() + " }\n";
-	s += "		x = 8\n";
-	s += "		y = 1\n";
-	s += "		cost = 10\n";
-	s += "\n";
-	s += "		ai_will_do = {\n";
-	s += "			factor = 1\n";
-	s += "			modifier = {\n";
-	s += "				factor = 0\n";
-	s += "				all_owned_state = {\n";
-	s += "					OR = {\n";
-	s += "						is_coastal = no\n";
-	s += "						dockyard < 1\n";
-	s += "					}\n";
-	s += "				}\n";
-	s += "			}\n";
-	s += "		}\n";
-	s += "\n";
-	s += "		completion_reward = {\n";
-	s += "			add_tech_bonus = {\n";
-	s += "				name = sub_op_bonus\n";
-	s += "				bonus = 0.5\n";
-	s += "				uses = 2\n";
-	s += "				technology = convoy_interdiction_ti\n";
-	s += "				technology = unrestricted_submarine_warfare\n";
-	s += "				technology = wolfpacks\n";
-	s += "				technology = advanced_submarine_warfare\n";
-	s += "				technology = combined_operations_raiding\n";
-	s += "			}\n";
-	s += "		}\n";
-	s += "	}\n";
-	s += "\n";
-	s += "	focus = {\n";
-	s += "		id = large_navy" + CreatingCountry->getTag() + "\n";
-	s += "		icon = GFX_goal_generic_navy_doctrines_tactics\n";
-	s += "		prerequisite = { focus = naval_effort" + CreatingCountry->getTag() + " }\n";
-	s += "		mutually_exclusive = { focus = flexible_navy" + CreatingCountry->getTag() + " }\n";
-	s += "		x = 10\n";
-	s += "		y = 1\n";
-	s += "		cost = 10\n";
-	s += "\n";
-	s += "		ai_will_do = {\n";
-	s += "			factor = 1\n";
-	s += "			modifier = {\n";
-	s += "				factor = 0\n";
-	s += "				all_owned_state = {\n";
-	s += "					OR = {\n";
-	s += "						is_coastal = no\n";
-	s += "						dockyard < 1\n";
-	s += "					}\n";
-	s += "				}\n";
-	s += "			}\n";
-	s += "		}\n";
-	s += "\n";
-	s += "		completion_reward = {\n";
-	s += "			add_tech_bonus = {\n";
-	s += "				name = fleet_in_being_bonus\n";
-	s += "				bonus = 0.5\n";
-	s += "				uses = 2\n";
-	s += "				category = fleet_in_being_tree\n";
-	s += "			}\n";
-	s += "		}\n";
-	s += "	}\n";
-	s += "\n";
-	s += "	focus = {\n";
-	s += "		id = submarine_effort" + CreatingCountry->getTag() + "\n";
-	s += "		icon = GFX_goal_generic_navy_submarine\n";
-	s += "		prerequisite = { focus = flexible_navy focus = large_navy" + CreatingCountry->getTag() + " }\n";
-	s += "		x = 8\n";
-	s += "		y = 2\n";
-	s += "		cost = 10\n";
-	s += "\n";
-	s += "		ai_will_do = {\n";
-	s += "			factor = 1\n";
-	s += "			modifier = {\n";
-	s += "				factor = 0\n";
-	s += "				all_owned_state = {\n";
-	s += "					OR = {\n";
-	s += "						is_coastal = no\n";
-	s += "						dockyard < 1\n";
-	s += "					}\n";
-	s += "				}\n";
-	s += "			}\n";
-	s += "		}\n";
-	s += "\n";
-	s += "		completion_reward = {\n";
-	s += "			add_tech_bonus = {\n";
-	s += "				name = ss_bonus\n";
-	s += "				bonus = 0.5\n";
-	s += "				ahead_reduction = 1\n";
-	s += "				uses = 1\n";
-	s += "				technology = early_submarine\n";
-	s += "				technology = basic_submarine\n";
-	s += "				technology = improved_submarine\n";
-	s += "				technology = advanced_submarine\n";
-	s += "			}\n";
-	s += "		}\n";
-	s += "	}\n";
-	s += "\n";
-	s += "	focus = {\n";
-	s += "		id = cruiser_effort" + CreatingCountry->getTag() + "\n";
-	s += "		icon = GFX_goal_generic_navy_cruiser\n";
-	s += "		prerequisite = { focus = large_navy focus = flexible_navy" + CreatingCountry->getTag() + " }\n";
-	s += "		x = 10\n";
-	s += "		y = 2\n";
-	s += "		cost = 10\n";
-	s += "\n";
-	s += "		ai_will_do = {\n";
-	s += "			factor = 1\n";
-	s += "			modifier = {\n";
-	s += "				factor = 0\n";
-	s += "				all_owned_state = {\n";
-	s += "					OR = {\n";
-	s += "						is_coastal = no\n";
-	s += "						dockyard < 1\n";
-	s += "					}\n";
-	s += "				}\n";
-	s += "			}\n";
-	s += "		}\n";
-	s += "\n";
-	s += "		completion_reward = {\n";
-	s += "			add_tech_bonus = {\n";
-	s += "				name = cr_bonus\n";
-	s += "				bonus = 0.5\n";
-	s += "				ahead_reduction = 1\n";
-	s += "				uses = 1\n";
-	s += "				technology = improved_light_cruiser\n";
-	s += "				technology = advanced_light_cruiser\n";
-	s += "				technology = improved_heavy_cruiser\n";
-	s += "				technology = advanced_heavy_cruiser\n";
-	s += "			}\n";
-	s += "		}\n";
-	s += "	}\n";
-	s += "\n";
-	s += "	focus = {\n";
-	s += "		id = destroyer_effort" + CreatingCountry->getTag() + "\n";
-	s += "		icon = GFX_goal_generic_wolf_pack\n";
-	s += "		prerequisite = { focus = submarine_effort" + CreatingCountry->getTag() + " }\n";
-	s += "		x = 8\n";
-	s += "		y = 3\n";
-	s += "		cost = 10\n";
-	s += "\n";
-	s += "		ai_will_do = {\n";
-	s += "			factor = 1\n";
-	s += "			modifier = {\n";
-	s += "				factor = 0\n";
-	s += "				all_owned_state = {\n";
-	s += "					OR = {\n";
-	s += "						is_coastal = no\n";
-	s += "						dockyard < 1\n";
-	s += "					}\n";
-	s += "				}\n";
-	s += "			}\n";
-	s += "		}\n";
-	s += "\n";
-	s += "		completion_reward = {\n";
-	s += "			add_tech_bonus = {\n";
-	s += "				name = dd_bonus\n";
-	s += "				bonus = 0.5\n";
-	s += "				ahead_reduction = 1\n";
-	s += "				uses = 1\n";
-	s += "				technology = early_destroyer\n";
-	s += "				technology = basic_destroyer\n";
-	s += "				technology = improved_destroyer\n";
-	s += "				technology = advanced_destroyer\n";
-	s += "			}\n";
-	s += "		}\n";
-	s += "	}\n";
-	s += "\n";
-	s += "	focus = {\n";
-	s += "		id = capital_ships_effort" + CreatingCountry->getTag() + "\n";
-	s += "		icon = GFX_goal_generic_navy_battleship\n";
-	s += "		prerequisite = { focus = cruiser_effort" + CreatingCountry->getTag() + " }\n";
-	s += "		x = 10\n";
-	s += "		y = 3\n";
-	s += "		cost = 10\n";
-	s += "\n";
-	s += "		ai_will_do = {\n";
-	s += "			factor = 1\n";
-	s += "			modifier = {\n";
-	s += "				factor = 0\n";
-	s += "				all_owned_state = {\n";
-	s += "					OR = {\n";
-	s += "						is_coastal = no\n";
-	s += "						dockyard < 1\n";
-	s += "					}\n";
-	s += "				}\n";
-	s += "			}\n";
-	s += "		}\n";
-	s += "\n";
-	s += "		completion_reward = {\n";
-	s += "			navy_experience = 25\n";
-	s += "			add_tech_bonus = {\n";
-	s += "				name = capital_ships_bonus\n";
-	s += "				bonus = 0.5\n";
-	s += "				ahead_reduction = 1\n";
-	s += "				uses = 1\n";
-	s += "				technology = basic_battlecruiser\n";
-	s += "				technology = basic_battleship\n";
-	s += "				technology = improved_battleship\n";
-	s += "				technology = advanced_battleship\n";
-	s += "				technology = heavy_battleship\n";
-	s += "				technology = heavy_battleship2\n";
-	s += "				technology = early_carrier\n";
-	s += "				technology = basic_carrier\n";
-	s += "				technology = improved_carrier\n";
-	s += "				technology = advanced_carrier\n";
-	s += "			}\n";
-	s += "		}\n";
-	s += "	}\n";
-	s += "\n";
-	s += "	focus = {\n";
-	s += "		id = industrial_effort" + CreatingCountry->getTag() + "\n";
-	s += "		icon = GFX_goal_generic_production\n";
-	s += "		x = 13\n";
-	s += "		y = 0\n";
-	s += "		cost = 10\n";
-	s += "		completion_reward = {\n";
-	s += "			add_tech_bonus = {\n";
-	s += "				name = industrial_bonus\n";
-	s += "				bonus = 0.5\n";
-	s += "				uses = 1\n";
-	s += "				category = industry\n";
-	s += "			}\n";
-	s += "		}\n";
-	s += "\n";
-	s += "		ai_will_do = {\n";
-	s += "			factor = 3\n";
-	s += "			modifier = {\n";
-	s += "				factor = 0\n";
-	s += "				date < 1939.1.1\n";
-	s += "				OR = { \n";
-	s += "\n";
-	s += "					# we also dont want tiny nations to go crazy with slots right away\n";
-	s += "					num_of_controlled_states < 2\n";
-	s += "				}				\n";
-	s += "			}\n";
-	s += "		}\n";
-	s += "	}\n";
-	s += "\n";
-	s += "	focus = {\n";
-	s += "		id = construction_effort" + CreatingCountry->getTag() + "\n";
-	s += "		icon = GFX_goal_generic_construct_civ_factory\n";
-	s += "		prerequisite = { focus = industrial_effort" + CreatingCountry->getTag() + " }\n";
-	s += "		x = 12\n";
-	s += "		y = 1\n";
-	s += "		cost = 10\n";
-	s += "\n";
-	s += "		\n";
-	s += "		ai_will_do = {\n";
-	s += "			factor = 2\n";
-	s += "		}\n";
-	s += "\n";
-	s += "		bypass = {\n";
-	s += "			custom_trigger_tooltip = {\n";
-	s += "				tooltip = construction_effort_tt\n";
-	s += "				all_owned_state = {\n";
-	s += "					free_building_slots = {\n";
-	s += "						building = industrial_complex\n";
-	s += "						size < 1\n";
-	s += "						include_locked = yes\n";
-	s += "					}					\n";
-	s += "				}\n";
-	s += "			}\n";
-	s += "		}\n";
-	s += "\n";
-	s += "		complete_tooltip = {\n";
-	s += "			add_extra_state_shared_building_slots = 1\n";
-	s += "			add_building_construction = {\n";
-	s += "				type = industrial_complex\n";
-	s += "				level = 1\n";
-	s += "				instant_build = yes\n";
-	s += "			}			\n";
-	s += "		}\n";
-	s += "\n";
-	s += "		completion_reward = {\n";
-	s += "			random_owned_state = {\n";
-	s += "				limit = {\n";
-	s += "					free_building_slots = {\n";
-	s += "						building = industrial_complex\n";
-	s += "						size > 0\n";
-	s += "						include_locked = yes\n";
-	s += "					}\n";
-	s += "					OR = {\n";
-	s += "						is_in_home_area = yes\n";
-	s += "						NOT = {\n";
-	s += "							owner = {\n";
-	s += "								any_owned_state = {\n";
-	s += "									free_building_slots = {\n";
-	s += "										building = industrial_complex\n";
-	s += "										size > 0\n";
-	s += "										include_locked = yes\n";
-	s += "									}\n";
-	s += "									is_in_home_area = yes\n";
-	s += "								}\n";
-	s += "							}\n";
-	s += "						}\n";
-	s += "					}\n";
-	s += "				}\n";
-	s += "				add_extra_state_shared_building_slots = 1\n";
-	s += "				add_building_construction = {\n";
-	s += "					type = industrial_complex\n";
-	s += "					level = 1\n";
-	s += "					instant_build = yes\n";
-	s += "				}\n";
-	s += "			}\n";
-	s += "		}\n";
-	s += "	}\n";
-	s += "\n";
-	s += "	focus = {\n";
-	s += "		id = production_effort" + CreatingCountry->getTag() + "\n";
-	s += "		icon = GFX_goal_generic_construct_mil_factory\n";
-	s += "		prerequisite = { focus = industrial_effort" + CreatingCountry->getTag() + " }\n";
-	s += "		x = 14\n";
-	s += "		y = 1\n";
-	s += "		cost = 10\n";
-	s += "\n";
-	s += "		ai_will_do = {\n";
-	s += "			factor = 2			\n";
-	s += "		}\n";
-	s += "\n";
-	s += "		bypass = {\n";
-	s += "			custom_trigger_tooltip = {\n";
-	s += "				tooltip = production_effort_tt\n";
-	s += "				all_owned_state = {\n";
-	s += "					free_building_slots = {\n";
-	s += "						building = arms_factory\n";
-	s += "						size < 1\n";
-	s += "						include_locked = yes\n";
-	s += "					}\n";
-	s += "				}\n";
-	s += "			}\n";
-	s += "		}\n";
-	s += "\n";
-	s += "		complete_tooltip = {\n";
-	s += "			add_extra_state_shared_building_slots = 1\n";
-	s += "			add_building_construction = {\n";
-	s += "				type = arms_factory\n";
-	s += "				level = 1\n";
-	s += "				instant_build = yes\n";
-	s += "			}\n";
-	s += "		}\n";
-	s += "\n";
-	s += "		completion_reward = {\n";
-	s += "			random_owned_state = {\n";
-	s += "				limit = {\n";
-	s += "					free_building_slots = {\n";
-	s += "						building = arms_factory\n";
-	s += "						size > 0\n";
-	s += "						include_locked = yes\n";
-	s += "					}\n";
-	s += "					OR = {\n";
-	s += "						is_in_home_area = yes\n";
-	s += "						NOT = {\n";
-	s += "							owner = {\n";
-	s += "								any_owned_state = {\n";
-	s += "									free_building_slots = {\n";
-	s += "										building = arms_factory\n";
-	s += "										size > 0\n";
-	s += "										include_locked = yes\n";
-	s += "									}\n";
-	s += "									is_in_home_area = yes\n";
-	s += "								}\n";
-	s += "							}\n";
-	s += "						}\n";
-	s += "					}\n";
-	s += "				}\n";
-	s += "				add_extra_state_shared_building_slots = 1\n";
-	s += "				add_building_construction = {\n";
-	s += "					type = arms_factory\n";
-	s += "					level = 1\n";
-	s += "					instant_build = yes\n";
-	s += "				}\n";
-	s += "			}\n";
-	s += "		}\n";
-	s += "	}\n";
-	s += "\n";
-	s += "	focus = {\n";
-	s += "		id = construction_effort_2" + CreatingCountry->getTag() + "\n";
-	s += "		icon = GFX_goal_generic_construct_civ_factory\n";
-	s += "		prerequisite = { focus = construction_effort" + CreatingCountry->getTag() + " }\n";
-	s += "		x = 12\n";
-	s += "		y = 2\n";
-	s += "		cost = 10\n";
-	s += "\n";
-	s += "		ai_will_do = {\n";
-	s += "			factor = 2\n";
-	s += "		}\n";
-	s += "\n";
-	s += "		bypass = {\n";
-	s += "			custom_trigger_tooltip = {\n";
-	s += "				tooltip = construction_effort_tt\n";
-	s += "				all_owned_state = {\n";
-	s += "					free_building_slots = {\n";
-	s += "						building = industrial_complex\n";
-	s += "						size < 1\n";
-	s += "						include_locked = yes\n";
-	s += "					}\n";
-	s += "				}\n";
-	s += "			}\n";
-	s += "		}\n";
-	s += "\n";
-	s += "		complete_tooltip = {\n";
-	s += "			add_extra_state_shared_building_slots = 1\n";
-	s += "			add_building_construction = {\n";
-	s += "				type = industrial_complex\n";
-	s += "				level = 1\n";
-	s += "				instant_build = yes\n";
-	s += "			}\n";
-	s += "		}		\n";
-	s += "\n";
-	s += "		completion_reward = {\n";
-	s += "			random_owned_state = {\n";
-	s += "				limit = {\n";
-	s += "					free_building_slots = {\n";
-	s += "						building = industrial_complex\n";
-	s += "						size > 0\n";
-	s += "						include_locked = yes\n";
-	s += "					}\n";
-	s += "					OR = {\n";
-	s += "						is_in_home_area = yes\n";
-	s += "						NOT = {\n";
-	s += "							owner = {\n";
-	s += "								any_owned_state = {\n";
-	s += "									free_building_slots = {\n";
-	s += "										building = industrial_complex\n";
-	s += "										size > 0\n";
-	s += "										include_locked = yes\n";
-	s += "									}\n";
-	s += "									is_in_home_area = yes\n";
-	s += "								}\n";
-	s += "							}\n";
-	s += "						}\n";
-	s += "					}\n";
-	s += "				}\n";
-	s += "				add_extra_state_shared_building_slots = 1\n";
-	s += "				add_building_construction = {\n";
-	s += "					type = industrial_complex\n";
-	s += "					level = 1\n";
-	s += "					instant_build = yes\n";
-	s += "				}\n";
-	s += "			}\n";
-	s += "		}\n";
-	s += "	}\n";
-	s += "\n";
-	s += "	focus = {\n";
-	s += "		id = production_effort_2" + CreatingCountry->getTag() + "\n";
-	s += "		icon = GFX_goal_generic_construct_mil_factory\n";
-	s += "		prerequisite = { focus = production_effort" + CreatingCountry->getTag() + " }\n";
-	s += "		x = 14\n";
-	s += "		y = 2\n";
-	s += "		cost = 10\n";
-	s += "\n";
-	s += "		ai_will_do = {\n";
-	s += "			factor = 2\n";
-	s += "		}\n";
-	s += "\n";
-	s += "		bypass = {\n";
-	s += "			custom_trigger_tooltip = {\n";
-	s += "				tooltip = production_effort_tt\n";
-	s += "				all_owned_state = {\n";
-	s += "					free_building_slots = {\n";
-	s += "						building = arms_factory\n";
-	s += "						size < 1\n";
-	s += "						include_locked = yes\n";
-	s += "					}\n";
-	s += "				}\n";
-	s += "			}\n";
-	s += "		}\n";
-	s += "\n";
-	s += "		complete_tooltip = {\n";
-	s += "			add_extra_state_shared_building_slots = 1\n";
-	s += "			add_building_construction = {\n";
-	s += "				type = arms_factory\n";
-	s += "				level = 1\n";
-	s += "				instant_build = yes\n";
-	s += "			}\n";
-	s += "		}		\n";
-	s += "\n";
-	s += "		completion_reward = {\n";
-	s += "			random_owned_state = {\n";
-	s += "				limit = {\n";
-	s += "					free_building_slots = {\n";
-	s += "						building = arms_factory\n";
-	s += "						size > 0\n";
-	s += "						include_locked = yes\n";
-	s += "					}\n";
-	s += "					OR = {\n";
-	s += "						is_in_home_area = yes\n";
-	s += "						NOT = {\n";
-	s += "							owner = {\n";
-	s += "								any_owned_state = {\n";
-	s += "									free_building_slots = {\n";
-	s += "										building = arms_factory\n";
-	s += "										size > 0\n";
-	s += "										include_locked = yes\n";
-	s += "									}\n";
-	s += "									is_in_home_area = yes\n";
-	s += "								}\n";
-	s += "							}\n";
-	s += "						}\n";
-	s += "					}\n";
-	s += "				}\n";
-	s += "				add_extra_state_shared_building_slots = 1\n";
-	s += "				add_building_construction = {\n";
-	s += "					type = arms_factory\n";
-	s += "					level = 1\n";
-	s += "					instant_build = yes\n";
-	s += "				}\n";
-	s += "			}\n";
-	s += "		}\n";
-	s += "	}\n";
-	s += "\n";
-	s += "	focus = {\n";
-	s += "		id = infrastructure_effort" + CreatingCountry->getTag() + "\n";
-	s += "		icon = GFX_goal_generic_construct_infrastructure\n";
-	s += "		prerequisite = { focus = construction_effort_2" + CreatingCountry->getTag() + " }\n";
-	s += "		x = 12\n";
-	s += "		y = 3\n";
-	s += "		cost = 10\n";
-	s += "		bypass = {\n";
-	s += "			custom_trigger_tooltip = {\n";
-	s += "				tooltip = infrastructure_effort_tt\n";
-	s += "				all_owned_state = {			\n";
-	s += "					free_building_slots = {\n";
-	s += "						building = infrastructure\n";
-	s += "						size < 1\n";
-	s += "					}\n";
-	s += "				}\n";
-	s += "			}\n";
-	s += "		}\n";
-	s += "\n";
-	s += "		complete_tooltip = {\n";
-	s += "			add_building_construction = {\n";
-	s += "				type = infrastructure\n";
-	s += "				level = 1\n";
-	s += "				instant_build = yes\n";
-	s += "			}\n";
-	s += "			add_building_construction = {\n";
-	s += "				type = infrastructure\n";
-	s += "				level = 1\n";
-	s += "				instant_build = yes\n";
-	s += "			}\n";
-	s += "		}\n";
-	s += "\n";
-	s += "		completion_reward = {\n";
-	s += "			random_owned_state = {\n";
-	s += "				limit = {\n";
-	s += "					free_building_slots = {\n";
-	s += "						building = infrastructure\n";
-	s += "						size > 0\n";
-	s += "					}\n";
-	s += "					OR = {\n";
-	s += "						is_in_home_area = yes\n";
-	s += "						NOT = {\n";
-	s += "							owner = {\n";
-	s += "								any_owned_state = {\n";
-	s += "									free_building_slots = {\n";
-	s += "										building = infrastructure\n";
-	s += "										size > 0\n";
-	s += "									}\n";
-	s += "									is_in_home_area = yes\n";
-	s += "								}\n";
-	s += "							}\n";
-	s += "						}\n";
-	s += "					}\n";
-	s += "				}\n";
-	s += "				add_building_construction = {\n";
-	s += "					type = infrastructure\n";
-	s += "					level = 1\n";
-	s += "					instant_build = yes\n";
-	s += "				}\n";
-	s += "			}\n";
-	s += "			random_owned_state = {\n";
-	s += "				limit = {\n";
-	s += "					free_building_slots = {\n";
-	s += "						building = infrastructure\n";
-	s += "						size > 0\n";
-	s += "					}\n";
-	s += "					OR = {\n";
-	s += "						is_in_home_area = yes\n";
-	s += "						NOT = {\n";
-	s += "							owner = {\n";
-	s += "								any_owned_state = {\n";
-	s += "									free_building_slots = {\n";
-	s += "										building = infrastructure\n";
-	s += "										size > 0\n";
-	s += "									}\n";
-	s += "									is_in_home_area = yes\n";
-	s += "								}\n";
-	s += "							}\n";
-	s += "						}\n";
-	s += "					}\n";
-	s += "				}\n";
-	s += "				add_building_construction = {\n";
-	s += "					type = infrastructure\n";
-	s += "					level = 1\n";
-	s += "					instant_build = yes\n";
-	s += "				}\n";
-	s += "			}\n";
-	s += "		}\n";
-	s += "	}\n";
-	s += "\n";
-	s += "	focus = {\n";
-	s += "		id = production_effort_3" + CreatingCountry->getTag() + "\n";
-	s += "		icon = GFX_goal_generic_construct_mil_factory\n";
-	s += "		prerequisite = { focus = production_effort_2" + CreatingCountry->getTag() + " }\n";
-	s += "		x = 14\n";
-	s += "		y = 3\n";
-	s += "		cost = 10\n";
-	s += "\n";
-	s += "		ai_will_do = {\n";
-	s += "			factor = 2\n";
-	s += "		}\n";
-	s += "\n";
-	s += "		bypass = {\n";
-	s += "			custom_trigger_tooltip = {\n";
-	s += "				tooltip = production_effort_tt\n";
-	s += "				all_owned_state = {\n";
-	s += "					free_building_slots = {\n";
-	s += "						building = arms_factory\n";
-	s += "						size < 1\n";
-	s += "						include_locked = yes\n";
-	s += "					}					\n";
-	s += "				}\n";
-	s += "			}\n";
-	s += "		}\n";
-	s += "\n";
-	s += "		complete_tooltip = {\n";
-	s += "			add_extra_state_shared_building_slots = 1\n";
-	s += "			add_building_construction = {\n";
-	s += "				type = arms_factory\n";
-	s += "				level = 1\n";
-	s += "				instant_build = yes\n";
-	s += "			}\n";
-	s += "		}		\n";
-	s += "\n";
-	s += "		completion_reward = {\n";
-	s += "			random_owned_state = {\n";
-	s += "				limit = {\n";
-	s += "					free_building_slots = {\n";
-	s += "						building = arms_factory\n";
-	s += "						size > 0\n";
-	s += "						include_locked = yes\n";
-	s += "					}\n";
-	s += "					OR = {\n";
-	s += "						is_in_home_area = yes\n";
-	s += "						NOT = {\n";
-	s += "							owner = {\n";
-	s += "								any_owned_state = {\n";
-	s += "									free_building_slots = {\n";
-	s += "										building = arms_factory\n";
-	s += "										size > 0\n";
-	s += "										include_locked = yes\n";
-	s += "									}\n";
-	s += "									is_in_home_area = yes\n";
-	s += "								}\n";
-	s += "							}\n";
-	s += "						}\n";
-	s += "					}\n";
-	s += "				}\n";
-	s += "				add_extra_state_shared_building_slots = 1\n";
-	s += "				add_building_construction = {\n";
-	s += "					type = arms_factory\n";
-	s += "					level = 1\n";
-	s += "					instant_build = yes\n";
-	s += "				}\n";
-	s += "			}\n";
-	s += "		}\n";
-	s += "	}\n";
-	s += "\n";
-	s += "	focus = {\n";
-	s += "		id = infrastructure_effort_2" + CreatingCountry->getTag() + "\n";
-	s += "		icon = GFX_goal_generic_construct_infrastructure\n";
-	s += "		prerequisite = { focus = infrastructure_effort" + CreatingCountry->getTag() + " }\n";
-	s += "		x = 12\n";
-	s += "		y = 4\n";
-	s += "		cost = 10\n";
-	s += "		bypass = {\n";
-	s += "			custom_trigger_tooltip = {\n";
-	s += "				tooltip = infrastructure_effort_tt\n";
-	s += "				all_owned_state = {			\n";
-	s += "					free_building_slots = {\n";
-	s += "						building = infrastructure\n";
-	s += "						size < 1\n";
-	s += "					}\n";
-	s += "				}\n";
-	s += "			}\n";
-	s += "		}\n";
-	s += "\n";
-	s += "		complete_tooltip = {\n";
-	s += "			add_building_construction = {\n";
-	s += "				type = infrastructure\n";
-	s += "				level = 1\n";
-	s += "				instant_build = yes\n";
-	s += "			}\n";
-	s += "			add_building_construction = {\n";
-	s += "				type = infrastructure\n";
-	s += "				level = 1\n";
-	s += "				instant_build = yes\n";
-	s += "			}\n";
-	s += "		}\n";
-	s += "\n";
-	s += "		completion_reward = {\n";
-	s += "			random_owned_state = {\n";
-	s += "				limit = {\n";
-	s += "					free_building_slots = {\n";
-	s += "						building = infrastructure\n";
-	s += "						size > 0\n";
-	s += "					}\n";
-	s += "					OR = {\n";
-	s += "						is_in_home_area = yes\n";
-	s += "						NOT = {\n";
-	s += "							owner = {\n";
-	s += "								any_owned_state = {\n";
-	s += "									free_building_slots = {\n";
-	s += "										building = infrastructure\n";
-	s += "										size > 0\n";
-	s += "									}\n";
-	s += "									is_in_home_area = yes\n";
-	s += "								}\n";
-	s += "							}\n";
-	s += "						}\n";
-	s += "					}\n";
-	s += "				}\n";
-	s += "				add_building_construction = {\n";
-	s += "					type = infrastructure\n";
-	s += "					level = 1\n";
-	s += "					instant_build = yes\n";
-	s += "				}\n";
-	s += "			}\n";
-	s += "			random_owned_state = {\n";
-	s += "				limit = {\n";
-	s += "					free_building_slots = {\n";
-	s += "						building = infrastructure\n";
-	s += "						size > 0\n";
-	s += "					}\n";
-	s += "					OR = {\n";
-	s += "						is_in_home_area = yes\n";
-	s += "						NOT = {\n";
-	s += "							owner = {\n";
-	s += "								any_owned_state = {\n";
-	s += "									free_building_slots = {\n";
-	s += "										building = infrastructure\n";
-	s += "										size > 0\n";
-	s += "									}\n";
-	s += "									is_in_home_area = yes\n";
-	s += "								}\n";
-	s += "							}\n";
-	s += "						}\n";
-	s += "					}\n";
-	s += "				}\n";
-	s += "				add_building_construction = {\n";
-	s += "					type = infrastructure\n";
-	s += "					level = 1\n";
-	s += "					instant_build = yes\n";
-	s += "				}\n";
-	s += "			}\n";
-	s += "		}\n";
-	s += "	}\n";
-	s += "\n";
-	s += "	focus = {\n";
-	s += "		id = construction_effort_3" + CreatingCountry->getTag() + "\n";
-	s += "		icon = GFX_goal_generic_construct_civ_factory\n";
-	s += "		prerequisite = { focus = infrastructure_effort" + CreatingCountry->getTag() + " }\n";
-	s += "		x = 14\n";
-	s += "		y = 4\n";
-	s += "		cost = 10\n";
-	s += "\n";
-	s += "		ai_will_do = {\n";
-	s += "			factor = 2\n";
-	s += "		}\n";
-	s += "\n";
-	s += "		bypass = {\n";
-	s += "			custom_trigger_tooltip = {\n";
-	s += "				tooltip = construction_effort_tt\n";
-	s += "				all_owned_state = {\n";
-	s += "					free_building_slots = {\n";
-	s += "						building = industrial_complex\n";
-	s += "						size < 2\n";
-	s += "						include_locked = yes\n";
-	s += "					}\n";
-	s += "				}\n";
-	s += "			}\n";
-	s += "		}\n";
-	s += "\n";
-	s += "		complete_tooltip = {\n";
-	s += "			add_extra_state_shared_building_slots = 2\n";
-	s += "			add_building_construction = {\n";
-	s += "				type = industrial_complex\n";
-	s += "				level = 2\n";
-	s += "				instant_build = yes\n";
-	s += "			}\n";
-	s += "		}\n";
-	s += "\n";
-	s += "		completion_reward = {\n";
-	s += "			random_owned_state = {\n";
-	s += "				limit = {\n";
-	s += "					free_building_slots = {\n";
-	s += "						building = industrial_complex\n";
-	s += "						size > 1\n";
-	s += "						include_locked = yes\n";
-	s += "					}\n";
-	s += "					OR = {\n";
-	s += "						is_in_home_area = yes\n";
-	s += "						NOT = {\n";
-	s += "							owner = {\n";
-	s += "								any_owned_state = {\n";
-	s += "									free_building_slots = {\n";
-	s += "										building = industrial_complex\n";
-	s += "										size > 1\n";
-	s += "										include_locked = yes\n";
-	s += "									}\n";
-	s += "									is_in_home_area = yes\n";
-	s += "								}\n";
-	s += "							}\n";
-	s += "						}\n";
-	s += "					}\n";
-	s += "				}\n";
-	s += "				add_extra_state_shared_building_slots = 2\n";
-	s += "				add_building_construction = {\n";
-	s += "					type = industrial_complex\n";
-	s += "					level = 2\n";
-	s += "					instant_build = yes\n";
-	s += "				}\n";
-	s += "			}\n";
-	s += "		}\n";
-	s += "	}\n";
-	s += "\n";
-	s += "	focus = {\n";
-	s += "		id = nuclear_effort" + CreatingCountry->getTag() + "\n";
-	s += "		icon = GFX_focus_wonderweapons\n";
-	s += "		prerequisite = { focus = infrastructure_effort_2" + CreatingCountry->getTag() + " }\n";
-	s += "		x = 10\n";
-	s += "		y = 5\n";
-	s += "		cost = 10\n";
-	s += "		completion_reward = {\n";
-	s += "			add_tech_bonus = {\n";
-	s += "				name = nuclear_bonus\n";
-	s += "				ahead_reduction = 0.5\n";
-	s += "				category = nuclear\n";
-	s += "			}\n";
-	s += "		}\n";
-	s += "\n";
-	s += "		ai_will_do = {\n";
-	s += "			factor = 1\n";
-	s += "			modifier = {\n";
-	s += "				factor = 0.25\n";
-	s += "				always = yes\n";
-	s += "			}\n";
-	s += "		}\n";
-	s += "	}\n";
-	s += "\n";
-	s += "	focus = {\n";
-	s += "		id = extra_tech_slot" + CreatingCountry->getTag() + "\n";
-	s += "		icon = GFX_focus_research\n";
-	s += "		prerequisite = { focus = infrastructure_effort_2" + CreatingCountry->getTag() + " }\n";
-	s += "		x = 12\n";
-	s += "		y = 5\n";
-	s += "		cost = 10\n";
-	s += "		completion_reward = {\n";
-	s += "			add_research_slot = 1\n";
-	s += "		}\n";
-	s += "	}\n";
-	s += "	\n";
-	s += "	focus = {\n";
-	s += "		id = extra_tech_slot_2" + CreatingCountry->getTag() + "\n";
-	s += "		icon = GFX_focus_research\n";
-	s += "		prerequisite = { focus = extra_tech_slot" + CreatingCountry->getTag() + " }\n";
-	s += "		available = {\n";
-	s += "			num_of_factories > 50\n";
-	s += "		}\n";
-	s += "		cancel_if_invalid = no\n";
-	s += "		continue_if_invalid = yes\n";
-	s += "		x = 12\n";
-	s += "		y = 6\n";
-	s += "		cost = 10\n";
-	s += "		completion_reward = {\n";
-	s += "			add_research_slot = 1\n";
-	s += "		}\n";
-	s += "	}	\n";
-	s += "\n";
-	s += "	focus = {\n";
-	s += "		id = secret_weapons" + CreatingCountry->getTag() + "\n";
-	s += "		icon = GFX_goal_generic_secret_weapon\n";
-	s += "		prerequisite = { focus = infrastructure_effort_2" + CreatingCountry->getTag() + " }\n";
-	s += "		x = 14\n";
-	s += "		y = 5\n";
-	s += "		cost = 10\n";
-	s += "		completion_reward = {\n";
-	s += "			add_tech_bonus = {\n";
-	s += "				name = secret_bonus\n";
-	s += "				bonus = 0.5\n";
-	s += "				uses = 4\n";
-	s += "				category = electronics\n";
-	s += "				category = nuclear\n";
-	s += "				category = rocketry\n";
-	s += "			}\n";
-	s += "		}\n";
-	s += "\n";
-	s += "		ai_will_do = {\n";
-	s += "			factor = 1\n";
-	s += "			modifier = {\n";
-	s += "				factor = 0.25\n";
-	s += "				always = yes\n";
-	s += "			}\n";
-	s += "		}\n";
-	s += "	}\n";
-	s += "\n";
-	s += "	focus = {\n";
-	s += "		id = political_effort" + CreatingCountry->getTag() + "\n";
-	s += "		icon = GFX_goal_generic_demand_territory\n";
-	s += "		x = 19\n";
-	s += "		y = 0\n";
-	s += "		cost = 10\n";
-	s += "		completion_reward = {\n";
-	s += "			add_political_power = 120\n";
-	s += "		}\n";
-	s += "	}\n";
-	s += "\n";
-	s += "	focus = {\n";
-	s += "		id = collectivist_ethos" + CreatingCountry->getTag() + "\n";
-	s += "		icon = GFX_goal_generic_national_unity #icon = GFX_goal_tripartite_pact\n";
-	s += "		prerequisite = { focus = political_effort" + CreatingCountry->getTag() + " }\n";
-	s += "		mutually_exclusive = { focus = liberty_ethos" + CreatingCountry->getTag() + "}\n";
-	s += "		available = {\n";
-	s += "			OR = {\n";
-	s += "				has_government = fascism\n";
-	s += "				has_government = communism\n";
-	s += "				has_government = neutrality\n";
-	s += "			}\n";
-	s += "		}\n";
-	s += "		x = 18\n";
-	s += "		y = 1\n";
-	s += "		cost = 10\n";
-	s += "\n";
-	s += "		ai_will_do = {\n";
-	s += "			factor = 5\n";
-	s += "			modifier = {\n";
-	s += "				factor = 0\n";
-	s += "				OR = {\n";
-	s += "					is_historical_focus_on = yes\n";
-	s += "					has_idea = neutrality_idea\n";
-	s += "				}\n";
-	s += "			}\n";
-	s += "		}\n";
-	s += "\n";
-	s += "		completion_reward = {\n";
-	s += "			add_ideas = collectivist_ethos_focus\n";
-	s += "		}\n";
-	s += "	}\n";
-	s += "\n";
-	s += "	focus = {\n";
-	s += "		id = nationalism_focus" + CreatingCountry->getTag() + "\n";
-	s += "		icon = GFX_goal_support_fascism #icon = GFX_goal_tripartite_pact\n";
-	s += "		prerequisite = { focus = collectivist_ethos" + CreatingCountry->getTag() + " }\n";
-	s += "		mutually_exclusive = { focus = internationalism_focus" + CreatingCountry->getTag() + " }\n";
-	s += "		available = {\n";
-	s += "			OR = {\n";
-	s += "				has_government = fascism\n";
-	s += "				has_government = neutrality\n";
-	s += "			}\n";
-	s += "		}\n";
-	s += "		x = 16\n";
-	s += "		y = 2\n";
-	s += "		cost = 10\n";
-	s += "\n";
-	s += "		ai_will_do = {\n";
-	s += "			factor = 5\n";
-	s += "			modifier = {\n";
-	s += "				factor = 2\n";
-	s += "				any_neighbor_country = {\n";
-	s += "					is_major = yes\n";
-	s += "					has_government = fascism\n";
-	s += "				}\n";
-	s += "			}\n";
-	s += "		}\n";
-	s += "\n";
-	s += "		completion_reward = {\n";
-	s += "			add_ideas = nationalism\n";
-	s += "		}\n";
-	s += "	}\n";
-	s += "	\n";
-	s += "	focus = {\n";
-	s += "		id = internationalism_focus" + CreatingCountry->getTag() + "\n";
-	s += "		icon = GFX_goal_support_communism #icon = GFX_goal_tripartite_pact\n";
-	s += "		prerequisite = { focus = collectivist_ethos" + CreatingCountry->getTag() + " }\n";
-	s += "		mutually_exclusive = { focus = nationalism_focus" + CreatingCountry->getTag() + " }\n";
-	s += "		available = {\n";
-	s += "			OR = {\n";
-	s += "				has_government = communism\n";
-	s += "				has_government = neutrality\n";
-	s += "			}\n";
-	s += "		}\n";
-	s += "		x = 18\n";
-	s += "		y = 2\n";
-	s += "		cost = 10\n";
-	s += "\n";
-	s += "		ai_will_do = {\n";
-	s += "			factor = 5\n";
-	s += "			modifier = {\n";
-	s += "				factor = 2\n";
-	s += "				any_neighbor_country = {\n";
-	s += "					is_major = yes\n";
-	s += "					has_government = communism\n";
-	s += "				}\n";
-	s += "			}\n";
-	s += "		}\n";
-	s += "\n";
-	s += "		completion_reward = {\n";
-	s += "			add_ideas = internationalism\n";
-	s += "		}\n";
-	s += "	}	\n";
-	s += "\n";
-	s += "	focus = {\n";
-	s += "		id = liberty_ethos" + CreatingCountry->getTag() + "\n";
-	s += "		icon = GFX_goal_support_democracy\n";
-	s += "		prerequisite = { focus = political_effort" + CreatingCountry->getTag() + " }\n";
-	s += "		mutually_exclusive = { focus = collectivist_ethos" + CreatingCountry->getTag() + " }\n";
-	s += "		available = {\n";
-	s += "			OR = {\n";
-	s += "				has_government = democratic\n";
-	s += "				has_government = neutrality\n";
-	s += "			}\n";
-	s += "		}\n";
-	s += "		x = 20\n";
-	s += "		y = 1\n";
-	s += "		cost = 10\n";
-	s += "\n";
-	s += "		ai_will_do = {\n";
-	s += "			factor = 95\n";
-	s += "			modifier = {\n";
-	s += "				factor = 0.1\n";
-	s += "				any_neighbor_country = {\n";
-	s += "					is_major = yes\n";
-	s += "					OR = {\n";
-	s += "						has_government = communism\n";
-	s += "						has_government = fascism\n";
-	s += "					}\n";
-	s += "				}\n";
-	s += "				NOT = {\n";
-	s += "					any_neighbor_country = {\n";
-	s += "						is_major = yes\n";
-	s += "						has_government = democratic\n";
-	s += "					}\n";
-	s += "				}\n";
-	s += "			}\n";
-	s += "		}\n";
-	s += "\n";
-	s += "		completion_reward = {\n";
-	s += "			add_ideas = liberty_ethos_focus\n";
-	s += "		}\n";
-	s += "	}\n";
-	s += "\n";
-	s += "	focus = {\n";
-	s += "		id = militarism" + CreatingCountry->getTag() + "\n";
-	s += "		icon = GFX_goal_generic_political_pressure\n";
-	s += "		prerequisite = { focus = nationalism_focus" + CreatingCountry->getTag() + " }\n";
-	s += "		x = 16\n";
-	s += "		y = 3\n";
-	s += "		cost = 10\n";
-	s += "		completion_reward = {\n";
-	s += "			if = {\n";
-	s += "				limit = { has_idea = neutrality_idea }\n";
-	s += "				remove_ideas = neutrality_idea\n";
-	s += "			}			\n";
-	s += "			add_ideas = militarism_focus\n";
-	s += "			army_experience = 20\n";
-	s += "			set_rule = { can_send_volunteers = yes }\n";
-	s += "		}\n";
-	s += "	}\n";
-	s += "\n";
-	s += "	focus = {\n";
-	s += "		id = political_correctness" + CreatingCountry->getTag() + "\n";
-	s += "		icon = GFX_goal_generic_dangerous_deal\n";
-	s += "		prerequisite = { focus = internationalism_focus" + CreatingCountry->getTag() + " }\n";
-	s += "		x = 18\n";
-	s += "		y = 3\n";
-	s += "		cost = 10\n";
-	s += "		completion_reward = {\n";
-	s += "			if = {\n";
-	s += "				limit = { has_idea = neutrality_idea }\n";
-	s += "				remove_ideas = neutrality_idea\n";
-	s += "			}		\n";
-	s += "			add_political_power = 200\n";
-	s += "			add_ideas = idea_political_correctness\n";
-	s += "		}\n";
-	s += "	}\n";
-	s += "\n";
-	s += "	focus = {\n";
-	s += "		id = neutrality_focus" + CreatingCountry->getTag() + "\n";
-	s += "		icon = GFX_goal_generic_neutrality_focus\n";
-	s += "		prerequisite = { focus = liberty_ethos" + CreatingCountry->getTag() + " }\n";
-	s += "		mutually_exclusive = { focus = interventionism_focus" + CreatingCountry->getTag() + " }\n";
-	s += "		x = 20\n";
-	s += "		y = 2\n";
-	s += "		cost = 10\n";
-	s += "		completion_reward = {\n";
-	s += "			if = {\n";
-	s += "				limit = { NOT = { has_idea = neutrality_idea } }\n";
-	s += "				add_ideas = neutrality_idea\n";
-	s += "			}\n";
-	s += "			add_political_power = 150\n";
-	s += "		}\n";
-	s += "	}\n";
-	s += "\n";
-	s += "	focus = {\n";
-	s += "		id = interventionism_focus" + CreatingCountry->getTag() + "\n";
-	s += "		icon = GFX_goal_generic_political_pressure\n";
-	s += "		prerequisite = { focus = liberty_ethos" + CreatingCountry->getTag() + " }\n";
-	s += "		mutually_exclusive = { focus = neutrality_focus" + CreatingCountry->getTag() + " }\n";
-	s += "		x = 22\n";
-	s += "		y = 2\n";
-	s += "		cost = 10\n";
-	s += "\n";
-	s += "		ai_will_do = {\n";
-	s += "			factor = 1\n";
-	s += "			modifier = {\n";
-	s += "				factor = 0\n";
-	s += "				has_idea = neutrality_idea\n";
-	s += "			}\n";
-	s += "		}\n";
-	s += "\n";
-	s += "		completion_reward = {\n";
-	s += "			if = {\n";
-	s += "				limit = { has_idea = neutrality_idea }\n";
-	s += "				remove_ideas = neutrality_idea\n";
-	s += "			}	\n";
-	s += "			set_rule = { can_send_volunteers = yes }\n";
-	s += "			add_political_power = 150\n";
-	s += "		}\n";
-	s += "	}\n";
-	s += "\n";
-	s += "	focus = {\n";
-	s += "		id = military_youth" + CreatingCountry->getTag() + "\n";
-	s += "		icon = GFX_goal_generic_more_territorial_claims\n";
-	s += "		prerequisite = { focus = militarism" + CreatingCountry->getTag() + " }\n";
-	s += "		x = 16\n";
-	s += "		y = 4\n";
-	s += "		cost = 10\n";
-	s += "		completion_reward = {\n";
-	s += "			add_ideas = military_youth_focus\n";
-	s += "			if = {\n";
-	s += "				limit = { has_government = fascism }\n";
-	s += "				add_popularity = {\n";
-	s += "					ideology = fascism\n";
-	s += "					popularity = 0.2\n";
-	s += "				}\n";
-	s += "			}\n";
-	s += "			if = {\n";
-	s += "				limit = { has_government = communism }\n";
-	s += "				add_popularity = {\n";
-	s += "					ideology = communism\n";
-	s += "					popularity = 0.2\n";
-	s += "				}\n";
-	s += "			}\n";
-	s += "		}\n";
-	s += "	}\n";
-	s += "\n";
-	s += "	focus = {\n";
-	s += "		id = deterrence" + CreatingCountry->getTag() + "\n";
-	s += "		icon = GFX_goal_generic_defence\n";
-	s += "		prerequisite = { focus = neutrality_focus" + CreatingCountry->getTag() + " }\n";
-	s += "		x = 20\n";
-	s += "		y = 3\n";
-	s += "		cost = 10\n";
-	s += "		completion_reward = {\n";
-	s += "			add_ideas = deterrence\n";
-	s += "		}\n";
-	s += "	}\n";
-	s += "\n";
-	s += "	focus = {\n";
-	s += "		id = volunteer_corps" + CreatingCountry->getTag() + "\n";
-	s += "		icon = GFX_goal_generic_allies_build_infantry\n";
-	s += "		prerequisite = { focus = interventionism_focus" + CreatingCountry->getTag() + " }\n";
-	s += "		x = 22\n";
-	s += "		y = 3\n";
-	s += "		cost = 10\n";
-	s += "		completion_reward = {\n";
-	s += "			add_ideas = volunteer_corps_focus\n";
-	s += "		}\n";
-	s += "	}\n";
-	s += "\n";
-	s += "	focus = {\n";
-	s += "		id = paramilitarism" + CreatingCountry->getTag() + "\n";
-	s += "		icon = GFX_goal_generic_military_sphere\n";
-	s += "		prerequisite = { focus = military_youth" + CreatingCountry->getTag() + " }\n";
-	s += "		x = 16\n";
-	s += "		y = 5\n";
-	s += "		cost = 10\n";
-	s += "		completion_reward = {\n";
-	s += "			add_ideas = paramilitarism_focus\n";
-	s += "		}\n";
-	s += "	}\n";
-	s += "\n";
-	s += "	focus = {\n";
-	s += "		id = indoctrination_focus" + CreatingCountry->getTag() + "\n";
-	s += "		icon = GFX_goal_generic_propaganda\n";
-	s += "		prerequisite = { focus = political_correctness" + CreatingCountry->getTag() + " }\n";
-	s += "		x = 18\n";
-	s += "		y = 4\n";
-	s += "		cost = 10\n";
-	s += "		completion_reward = {\n";
-	s += "			add_ideas = indoctrination_focus\n";
-	s += "			add_political_power = 150\n";
-	s += "		}\n";
-	s += "	}\n";
-	s += "\n";
-	s += "	focus = {\n";
-	s += "		id = foreign_expeditions" + CreatingCountry->getTag() + "\n";
-	s += "		icon = GFX_goal_generic_more_territorial_claims\n";
-	s += "		prerequisite = { focus = volunteer_corps" + CreatingCountry->getTag() + " }\n";
-	s += "		x = 22\n";
-	s += "		y = 4\n";
-	s += "		cost = 10\n";
-	s += "		completion_reward = {\n";
-	s += "			add_ideas = foreign_expeditions_focus\n";
-	s += "		}\n";
-	s += "	}\n";
-	s += "\n";
-	s += "	focus = {\n";
-	s += "		id = why_we_fight" + CreatingCountry->getTag() + "\n";
-	s += "		icon = GFX_goal_generic_propaganda\n";
-	s += "		prerequisite = { focus = foreign_expeditions focus = deterrence" + CreatingCountry->getTag() + " }\n";
-	s += "		available = { \n";
-	s += "			OR = { \n";
-	s += "				threat > 0.75 \n";
-	s += "				has_defensive_war = yes \n";
-	s += "			}\n";
-	s += "		}\n";
-	s += "\n";
-	s += "		continue_if_invalid = yes\n";
-	s += "		\n";
-	s += "		x = 20\n";
-	s += "		y = 5\n";
-	s += "		cost = 10\n";
-	s += "		completion_reward = {\n";
-	s += "			if = {\n";
-	s += "				limit = { NOT = { has_idea = neutrality_idea } }\n";
-	s += "				set_rule = { can_create_factions = yes }\n";
-	s += "			}\n";
-	s += "			add_ideas = why_we_fight_focus\n";
-	s += "		}\n";
-	s += "	}\n";
-	s += "\n";
-	s += "	focus = {\n";
-	s += "		id = political_commissars" + CreatingCountry->getTag() + "\n";
-	s += "		icon = GFX_goal_generic_forceful_treaty\n";
-	s += "		prerequisite = { focus = indoctrination_focus" + CreatingCountry->getTag() + " }\n";
-	s += "		available = {\n";
-	s += "		}\n";
-	s += "		x = 18\n";
-	s += "		y = 5\n";
-	s += "		cost = 10\n";
-	s += "		completion_reward = {\n";
-	s += "			add_ideas = political_commissars_focus\n";
-	s += "			if = {\n";
-	s += "				limit = { has_government = fascism }\n";
-	s += "				add_popularity = {\n";
-	s += "					ideology = fascism\n";
-	s += "					popularity = 0.2\n";
-	s += "				}\n";
-	s += "			}\n";
-	s += "			if = {\n";
-	s += "				limit = { has_government = communism }\n";
-	s += "				add_popularity = {\n";
-	s += "					ideology = communism\n";
-	s += "					popularity = 0.2\n";
-	s += "				}\n";
-	s += "			}\n";
-	s += "			add_political_power = 200\n";
-	s += "		}\n";
-	s += "	}\n";
-	s += "\n";
-	s += "	focus = {\n";
-	s += "		id = ideological_fanaticism" + CreatingCountry->getTag() + "\n";
-	s += "		icon = GFX_goal_generic_demand_territory\n";
-	s += "		prerequisite = { focus = paramilitarism" + CreatingCountry->getTag() + " focus = political_commissars" + CreatingCountry->getTag() + " }\n";
-	s += "		x = 17\n";
-	s += "		y = 6\n";
-	s += "		cost = 10\n";
-	s += "		completion_reward = {\n";
-	s += "			add_ideas = ideological_fanaticism_focus\n";
-	s += "			set_rule = {\n";
-	s += "				can_create_factions = yes\n";
-	s += "			}\n";
-	s += "			hidden_effect = {\n";
-	s += "				set_rule = { can_use_kamikaze_pilots = yes }\n";
-	s += "			}\n";
-	s += "			custom_effect_tooltip = kamikaze_focus_tooltip\n";
-	s += "		}\n";
-	s += "	}\n";
-	s += "	\n";
-	s += "	focus = {\n";
-	s += "		id = technology_sharing" + CreatingCountry->getTag() + "\n";
-	s += "		icon = GFX_goal_generic_scientific_exchange\n";
-	s += "		prerequisite = { focus = ideological_fanaticism" + CreatingCountry->getTag() + " focus = why_we_fight" + CreatingCountry->getTag() + " }\n";
-	s += "		available = {\n";
-	s += "			has_war = yes\n";
-	s += "			is_in_faction = yes\n";
-	s += "			OR = {\n";
-	s += "				num_of_factories > 50\n";
-	s += "				any_country = {\n";
-	s += "					is_in_faction_with = ROOT\n";
-	s += "					num_of_factories > 50\n";
-	s += "				}\n";
-	s += "			}\n";
-	s += "		}		\n";
-	s += "		x = 19\n";
-	s += "		y = 7\n";
-	s += "		cost = 10\n";
-	s += "		completion_reward = {\n";
-	s += "			if = {\n";
-	s += "				limit = {\n";
-	s += "					original_research_slots < 3\n";
-	s += "				}\n";
-	s += "				add_research_slot = 1\n";
-	s += "			}\n";
-	s += "			if = {\n";
-	s += "				limit = {\n";
-	s += "					original_research_slots > 2\n";
-	s += "				}\n";
-	s += "				add_tech_bonus = {\n";
-	s += "					name = electronics_bonus\n";
-	s += "					bonus = 0.5\n";
-	s += "					uses = 1\n";
-	s += "					category = electronics\n";
-	s += "				}\n";
-	s += "				add_tech_bonus = {\n";
-	s += "					name = industrial_bonus\n";
-	s += "					bonus = 0.5\n";
-	s += "					uses = 1\n";
-	s += "					category = industry\n";
-	s += "				}	\n";
-	s += "				add_tech_bonus = {\n";
-	s += "					name = infantry_weapons_bonus\n";
-	s += "					bonus = 0.5\n";
-	s += "					uses = 1\n";
-	s += "					category = infantry_weapons\n";
-	s += "					category = artillery\n";
-	s += "				}				\n";
-	s += "			}			\n";
-	s += "		}\n";
-	s += "	}	\n";
-	s += "\n";
+	HoI4ScriptValues values;
+	values.setTag("TAG", CreatingCountry->getTag());
+	string s;
+	HoI4ScriptTemplates::get("genericFocusTree").render(values, s);
 	return s;
 }
 
@@ -4856,19 +1844,19 @@ void HoI4World::outputRelations()
 		}
 		country.second->setRelations(countryrelation);
 	}
-	std::string outputcommon = "Output/" + Configuration::getOutputName() + "/common";
+	std::string outputcommon = "output/" + Configuration::getOutputName() + "/common";
 	if (!Utils::TryCreateFolder(outputcommon))
 	{
 		return;
 	}
 
-	std::string outputopinionfolder = "Output/" + Configuration::getOutputName() + "/common/opinion_modifiers";
+	std::string outputopinionfolder = "output/" + Configuration::getOutputName() + "/common/opinion_modifiers";
 	if (!Utils::TryCreateFolder(outputopinionfolder))
 	{
 		return;
 	}
 
-	string filename("Output/" + Configuration::getOutputName() + "/common/opinion_modifiers/01_opinion_modifiers.txt");
+	string filename("output/" + Configuration::getOutputName() + "/common/opinion_modifiers/01_opinion_modifiers.txt");
 	ofstream out;
 	out.open(filename);
 	{
@@ -4886,17 +1874,21 @@ void HoI4World::thatsgermanWarCreator(const V2World &sourceWorld)
 	//IMPROVE
 	//MAKE ARMY STRENGTH CALCS MORE ACCURATE!!
 	LOG(LogLevel::Info) << "Filling Map Information";
+	ProfilePhase warPhase("Summarising countries for war planning");	// times each part of the war planning
 	fillProvinces();
 	fillCountryProvinces();
-	LOG(LogLevel::Info) << "Filling province neighbors";
-	fillProvinceNeighbors();
+	spatialIndex = new HoI4SpatialIndex();
+	spatialIndex->indexCapitals(countries, states->getStates());
+	warPlanningSnapshot = new HoI4WarPlanningSnapshot(sourceWorld, countries, states->getStates(), *spatialIndex);
 	LOG(LogLevel::Info) << "Creating Factions";
-	Factions = CreateFactions(sourceWorld);
+	warPhase.next("Creating factions");
+	Factions = CreateFactions();
 	NewsEventNumber = 237;
 	NewsEvents = "add_namespace = news\n";
 	nfEventNumber = 0;
 	nfEvents = "add_namespace = NFEvents\n";
 	//outputting the country and factions
+	warPhase.next("Writing countries");
 
 	//REDO
 	for (auto country : countries)
@@ -4917,19 +1909,20 @@ void HoI4World::thatsgermanWarCreator(const V2World &sourceWorld)
 	bool fascismIsRelevant = false;
 	bool communismIsRelevant = false;
 
-	for each (auto AllGC in returnGreatCountries(sourceWorld))
+	warPhase.next("Planning wars");
+	for (auto AllGC: warPlanningSnapshot->getGreatCountries())
 	{
 		int maxGCWars = 0;
 		if ((AllGC->getGovernment() != "hms_government" || (AllGC->getGovernment() == "hms_government" && (AllGC->getRulingParty().war_pol == "jingoism" || AllGC->getRulingParty().war_pol == "pro_military"))) && AllGC->getGovernment() != "democratic")
 		{
-			vector<HoI4Country*> GreatCountries = returnGreatCountries(sourceWorld);
+			const vector<HoI4Country*>& GreatCountries = warPlanningSnapshot->getGreatCountries();
 			map<double, HoI4Country*> GCDistance;
 			vector<HoI4Country*> GCDistanceSorted;
 			//get great countries with a distance
-			for each (auto GC in GreatCountries)
+			for (auto GC: GreatCountries)
 			{
-				set<string> Allies = AllGC->getAllies();
-				if (std::find(Allies.begin(), Allies.end(), GC->getTag()) == Allies.end())
+				const set<string>& Allies = AllGC->getAllies();
+				if (Allies.count(GC->getTag()) == 0)
 				{
 					double distance = getDistanceBetweenCountries(AllGC, GC);
 					if (distance < 2200)
@@ -4943,7 +1936,7 @@ void HoI4World::thatsgermanWarCreator(const V2World &sourceWorld)
 			}
 			sort(GCDistanceSorted.begin(), GCDistanceSorted.end());
 			vector<HoI4Country*> GCTargets;
-			for each (auto GC in GCDistanceSorted)
+			for (auto GC: GCDistanceSorted)
 			{
 				if (maxGCWars < 1)
 				{
@@ -4953,7 +1946,8 @@ void HoI4World::thatsgermanWarCreator(const V2World &sourceWorld)
 					{
 						if (GC != AllGC)
 						{
-							int relations = AllGC->getRelations(GC->getTag())->getRelations();
+							HoI4Relations* relationsObj = AllGC->getRelations(GC->getTag());
+							int relations = (relationsObj != NULL) ? relationsObj->getRelations() : 0;
 							if (relations < 0)
 							{
 								string prereq = "";
@@ -4980,16 +1974,16 @@ void HoI4World::thatsgermanWarCreator(const V2World &sourceWorld)
 		}
 	}
 	//output folders
-	string NFpath = "Output/" + Configuration::getOutputName() + "/common/national_focus";
+	string NFpath = "output/" + Configuration::getOutputName() + "/common/national_focus";
 	if (!Utils::TryCreateFolder(NFpath))
 	{
-		LOG(LogLevel::Error) << "Could not create \"Output/" + Configuration::getOutputName() + "/common/national_focus\"";
+		LOG(LogLevel::Error) << "Could not create \"output/" + Configuration::getOutputName() + "/common/national_focus\"";
 		exit(-1);
 	}
-	string eventpath = "Output/" + Configuration::getOutputName() + "/events";
+	string eventpath = "output/" + Configuration::getOutputName() + "/events";
 	if (!Utils::TryCreateFolder(eventpath))
 	{
-		LOG(LogLevel::Error) << "Could not create \"Output/" + Configuration::getOutputName() + "/events\"";
+		LOG(LogLevel::Error) << "Could not create \"output/" + Configuration::getOutputName() + "/events\"";
 		exit(-1);
 	}
 
@@ -5033,7 +2027,7 @@ void HoI4World::thatsgermanWarCreator(const V2World &sourceWorld)
 		//time to do events for coms and fascs if they are relevant
 		LOG(LogLevel::Info) << "Calculating Fasc/Com AI";
 
-		for (auto GreatCountry : returnGreatCountries(sourceWorld))
+		for (auto GreatCountry : warPlanningSnapshot->getGreatCountries())
 		{
 			HoI4Country* Leader = GreatCountry;
 			volatile HoI4Country* GG = Leader;
@@ -5041,7 +2035,7 @@ void HoI4World::thatsgermanWarCreator(const V2World &sourceWorld)
 			if ((Leader->getGovernment() == "fascism") || Leader->getRulingIdeology() == "fascism")
 			{
 				vector <HoI4Faction*> newCountriesatWar;
-				newCountriesatWar = FascistWarMaker(Leader, sourceWorld);
+				newCountriesatWar = FascistWarMaker(Leader);
 				for (auto addedFactions : newCountriesatWar)
 				{
 					if (std::find(CountriesAtWar.begin(), CountriesAtWar.end(), addedFactions) == CountriesAtWar.end()) {
@@ -5052,7 +2046,7 @@ void HoI4World::thatsgermanWarCreator(const V2World &sourceWorld)
 			if (Leader->getGovernment() == "absolute_monarchy" || (Leader->getGovernment() == "prussian_constitutionalism" && Leader->getRulingParty().war_pol == "jingoism"))
 			{
 				vector <HoI4Faction*> newCountriesatWar;
-				newCountriesatWar = MonarchyWarCreator(Leader, sourceWorld);
+				newCountriesatWar = MonarchyWarCreator(Leader);
 				for (auto addedFactions : newCountriesatWar)
 				{
 					if (std::find(CountriesAtWar.begin(), CountriesAtWar.end(), addedFactions) == CountriesAtWar.end()) {
@@ -5063,7 +2057,7 @@ void HoI4World::thatsgermanWarCreator(const V2World &sourceWorld)
 			if ((Leader->getGovernment() == "communism"))
 			{
 				vector <HoI4Faction*> newCountriesatWar;
-				newCountriesatWar = CommunistWarCreator(Leader, sourceWorld);
+				newCountriesatWar = CommunistWarCreator(Leader);
 				for (auto addedFactions : newCountriesatWar)
 				{
 					if (std::find(CountriesAtWar.begin(), CountriesAtWar.end(), addedFactions) == CountriesAtWar.end()) {
@@ -5084,14 +2078,14 @@ void HoI4World::thatsgermanWarCreator(const V2World &sourceWorld)
 		{
 			out << "looking for democracies\n";
 			//Lets find out countries Evilness
-			vector<HoI4Country*> GreatCountries = returnGreatCountries(sourceWorld);
-			for each (auto GC in GreatCountries)
+			const vector<HoI4Country*>& GreatCountries = warPlanningSnapshot->getGreatCountries();
+			for (auto GC: GreatCountries)
 			{
 				if ((GC->getGovernment() == "hms_government" && (GC->getRulingParty().war_pol == "pacifism" || GC->getRulingParty().war_pol == "anti_military")) || GC->getGovernment() == "democratic")
 				{
 					out << "added a Democracy to make more wars " + GC->getSourceCountry()->getName("english") << endl;
 					vector <HoI4Faction*> newCountriesatWar;
-					newCountriesatWar = DemocracyWarCreator(GC, sourceWorld);
+					newCountriesatWar = DemocracyWarCreator(GC);
 					//add that faction to new countries at war
 					for (auto addedFactions : newCountriesatWar)
 					{
@@ -5105,10 +2099,10 @@ void HoI4World::thatsgermanWarCreator(const V2World &sourceWorld)
 		if (CountriesAtWarStrength / WorldStrength < 0.8)
 		{
 			//Lets find out countries Evilness
-			vector<HoI4Country*> GreatCountries = returnGreatCountries(sourceWorld);
+			const vector<HoI4Country*>& GreatCountries = warPlanningSnapshot->getGreatCountries();
 			map<double, HoI4Country*> GCEvilness;
 			vector<HoI4Country*> GCEvilnessSorted;
-			for each (auto GC in GreatCountries)
+			for (auto GC: GreatCountries)
 			{
 				if (GC->getGovernment() == "prussian_constitutionalism" || GC->getGovernment() == "hms_government" || GC->getGovernment() == "absolute_monarchy" && std::find(LeaderCountries.begin(), LeaderCountries.end(), GC) == LeaderCountries.end() && (GC->getGovernment() != "hms_government" || (GC->getGovernment() == "hms_government" && (GC->getRulingParty().war_pol == "jingoism" || GC->getRulingParty().war_pol == "pro_military"))) && GC->getGovernment() != "democratic")
 				{
@@ -5144,7 +2138,7 @@ void HoI4World::thatsgermanWarCreator(const V2World &sourceWorld)
 			{
 				out << "added country to make more wars " + GCEvilnessSorted[i]->getSourceCountry()->getName("english") << endl;
 				vector <HoI4Faction*> newCountriesatWar;
-				newCountriesatWar = MonarchyWarCreator(GCEvilnessSorted[i], sourceWorld);
+				newCountriesatWar = MonarchyWarCreator(GCEvilnessSorted[i]);
 				//add that faction to new countries at war
 				for (auto addedFactions : newCountriesatWar)
 				{
@@ -5170,8 +2164,9 @@ void HoI4World::thatsgermanWarCreator(const V2World &sourceWorld)
 		out << aiOutputLog;
 		out.close();
 		//output events
-		string filenameevents("Output/" + Configuration::getOutputName() + "/events/NF_events.txt");
-		//string filename2("Output/NF.txt");
+		warPhase.next("Writing war events");
+		string filenameevents("output/" + Configuration::getOutputName() + "/events/NF_events.txt");
+		//string filename2("output/NF.txt");
 		ofstream outevents;
 		outevents.open(filenameevents);
 		{
@@ -5180,8 +2175,8 @@ void HoI4World::thatsgermanWarCreator(const V2World &sourceWorld)
 		}
 		outevents.close();
 
-		string filenameNFs("Output/" + Configuration::getOutputName() + "/events/newsEvents.txt");
-		//string filename2("Output/NF.txt");
+		string filenameNFs("output/" + Configuration::getOutputName() + "/events/newsEvents.txt");
+		//string filename2("output/NF.txt");
 		ofstream outNewsEvents;
 		outNewsEvents.open(filenameNFs);
 		{
@@ -5258,19 +2253,17 @@ vector<HoI4Country*> HoI4World::GetMorePossibleAllies(HoI4Country* CountryThatWa
 {
 	int maxcountries = 0;
 	vector<HoI4Country*> newPossibleAllies;
-	set<string> currentAllies = CountryThatWantsAllies->getAllies();
+	const set<string>& currentAllies = CountryThatWantsAllies->getAllies();
 	//set<string> currentAllies = CountryThatWantsAllies->getAllies();
 	vector<HoI4Country*> CountriesWithin500Miles; //Rename to actual distance
-	for (auto country : countries)
+	for (auto country2 : spatialIndex->findCountriesWithin(CountryThatWantsAllies, 500))
 	{
-		if (country.second->getProvinceCount() != 0)
+		if (country2->getProvinceCount() != 0)
 		{
-			HoI4Country* country2 = country.second;
-			if (getDistanceBetweenCountries(CountryThatWantsAllies, country2) <= 500)
-				if (std::find(currentAllies.begin(), currentAllies.end(), country2->getTag()) == currentAllies.end())
-				{
-					CountriesWithin500Miles.push_back(country2);
-				}
+			if (std::find(currentAllies.begin(), currentAllies.end(), country2->getTag()) == currentAllies.end())
+			{
+				CountriesWithin500Miles.push_back(country2);
+			}
 		}
 	}
 	string yourgovernment = CountryThatWantsAllies->getGovernment();
@@ -5295,6 +2288,10 @@ vector<HoI4Country*> HoI4World::GetMorePossibleAllies(HoI4Country* CountryThatWa
 				//FIXME
 				//check if we are friendly at all?
 				HoI4Relations* relationswithposally = CountryThatWantsAllies->getRelations(CountriesWithin500Miles[i]->getTag());
+				if (relationswithposally == NULL)
+				{
+					continue;
+				}
 				int rel = relationswithposally->getRelations();
 				int size = findFaction(CountriesWithin500Miles[i])->getMembers().size();
 				double armysize = CountriesWithin500Miles[i]->getStrengthOverTime(1.0);
@@ -5336,109 +2333,11 @@ vector<HoI4Country*> HoI4World::GetMorePossibleAllies(HoI4Country* CountryThatWa
 
 double HoI4World::getDistanceBetweenCountries(const HoI4Country* country1, const HoI4Country* country2)
 {
-	if (!bothCountriesHaveCapitals(country1, country2))
-	{
-		return 100000;
-	}
-
-	pair<int, int> country1Position = getCapitalPosition(country1);
-	pair<int, int> country2Position = getCapitalPosition(country2);
-
-	return getDistanceBetweenPoints(country1Position, country2Position);
+	return spatialIndex->getDistanceBetweenCountries(country1, country2);
 }
 
 
-bool HoI4World::bothCountriesHaveCapitals(const HoI4Country* Country1, const HoI4Country* Country2)
-{
-	return (Country1->getCapitalProv() != 0) && (Country2->getCapitalProv() != 0);
-}
-
-
-pair<int, int> HoI4World::getCapitalPosition(const HoI4Country* country)
-{
-	auto capitalState = states->getStates().find(country->getCapitalProv());
-	int capitalProvince = *(capitalState->second->getProvinces().begin());
-	return getProvincePosition(capitalProvince);
-}
-
-
-pair<int, int> HoI4World::getProvincePosition(int provinceNum)
-{
-	if (provincePositions.size() == 0)
-	{
-		establishProvincePositions();
-	}
-
-	auto itr = provincePositions.find(provinceNum);
-	return itr->second;
-}
-
-
-void HoI4World::establishProvincePositions()
-{
-	ifstream positionsFile("positions.txt");
-	if (!positionsFile.is_open())
-	{
-		LOG(LogLevel::Error) << "Could not open positions.txt";
-		exit(-1);
-	}
-
-	string line;
-	while (getline(positionsFile, line))
-	{
-		processPositionLine(line);
-	}
-
-	positionsFile.close();
-}
-
-
-void HoI4World::processPositionLine(const string& line)
-{
-	vector<string> tokenizedLine = tokenizeLine(line);
-	addProvincePosition(tokenizedLine);
-}
-
-
-void HoI4World::addProvincePosition(const vector<string>& tokenizedLine)
-{
-	int province = stoi(tokenizedLine[0]);
-	int x = stoi(tokenizedLine[2]);
-	int y = stoi(tokenizedLine[4]);
-
-	provincePositions.insert(make_pair(province, make_pair(x, y)));
-}
-
-
-vector<string> HoI4World::tokenizeLine(const string& line)
-{
-	vector<string> parts;
-	stringstream ss(line);
-	string tok;
-	while (getline(ss, tok, ';'))
-	{
-		parts.push_back(tok);
-	}
-
-	return parts;
-}
-
-
-double HoI4World::getDistanceBetweenPoints(pair<int, int> point1, pair<int, int> point2)
-{
-	int xDistance = abs(point2.first - point1.first);
-	if (xDistance > 2625)
-	{
-		xDistance = 5250 - xDistance;
-	}
-
-	int yDistance = point2.second - point1.second;
-
-	return sqrt(pow(xDistance, 2) + pow(yDistance, 2));
-}
-
-
-double HoI4World::GetFactionStrengthWithDistance(HoI4Country* HomeCountry, vector<HoI4Country*> Faction, double time)
+double HoI4World::GetFactionStrengthWithDistance(HoI4Country* HomeCountry, const vector<HoI4Country*>& Faction, double time)
 {
 	double strength = 0.0;
 	for (auto country : Faction)
@@ -5486,66 +2385,6 @@ HoI4Faction* HoI4World::findFaction(HoI4Country* CheckingCountry)
 	HoI4Faction* newFaction = new HoI4Faction(CheckingCountry, myself);
 	return newFaction;
 }
-bool HoI4World::checkIfGreatCountry(HoI4Country* checkingCountry, const V2World &sourceWorld)
-{
-	bool isGreatCountry = false;
-	vector<HoI4Country*> GreatCountries = returnGreatCountries(sourceWorld);
-
-	if (std::find(GreatCountries.begin(), GreatCountries.end(), checkingCountry) != GreatCountries.end())
-	{
-		isGreatCountry = true;
-	}
-	return isGreatCountry;
-
-}
-map<string, HoI4Country*> HoI4World::findNeighbors(vector<int> CountryProvs, HoI4Country* CheckingCountry)
-{
-	map<string, HoI4Country*> Neighbors;
-	vector<HoI4Province> provinces2;
-	for (auto prov : CountryProvs)
-	{
-		vector<int> thisprovNeighbors = provinceNeighbors.find(prov)->second;
-		for (int prov : thisprovNeighbors)
-		{
-			//string ownertag = "";
-			auto ownertag = stateToProvincesMap.find(prov);
-			if (ownertag != stateToProvincesMap.end())
-			{
-				vector<string> tags = ownertag->second;
-				if (tags.size() >= 1)
-				{
-					HoI4Country* ownerCountry = countries.find(tags[1])->second;
-					if (ownerCountry != CheckingCountry && ownerCountry->getProvinceCount() > 0)
-					{
-						//if not already in neighbors
-						if (Neighbors.find(tags[1]) == Neighbors.end())
-						{
-							Neighbors.insert(make_pair(tags[1], ownerCountry));
-						}
-					}
-				}
-			}
-		}
-	}
-	if (Neighbors.size() == 0)
-	{
-
-		for (auto country : countries)
-		{
-
-			HoI4Country* country2 = country.second;
-			if (country2->getCapitalProv() != 0)
-			{
-				//IMPROVE
-				//need to get further neighbors, as well as countries without capital in an area
-				double distance = getDistanceBetweenCountries(CheckingCountry, country2);
-				if (distance <= 500 && country.second->getProvinceCount() > 0)
-					Neighbors.insert(country);
-			}
-		}
-	}
-	return Neighbors;
-}
 void HoI4World::fillProvinces()
 {
 	for (auto state : states->getStates())
@@ -5563,32 +2402,14 @@ void HoI4World::fillProvinces()
 		}
 	}
 }
-vector<int> HoI4World::getCountryProvinces(HoI4Country* Country)
-{
-	vector<int> countryprovinces;
-	for (auto state : states->getStates())
-	{
-		string owner = state.second->getOwner();
-		if (state.second->getOwner() == Country->getTag())
-		{
-			for (auto prov : state.second->getProvinces())
-			{
-
-				countryprovinces.push_back(prov);
-			}
-		}
-	}
-	volatile vector<int> asdfasdf = countryprovinces;
-	return countryprovinces;
-}
-vector<HoI4Faction*> HoI4World::CreateFactions(const V2World &sourceWorld)
+vector<HoI4Faction*> HoI4World::CreateFactions()
 {
 	vector<HoI4Faction*> Factions2;
 	string filename("Factions-logs.txt");
 	ofstream out;
 	out.open(filename);
 	{
-		vector<HoI4Country*> GreatCountries = returnGreatCountries(sourceWorld);
+		const vector<HoI4Country*>& GreatCountries = warPlanningSnapshot->getGreatCountries();
 		vector<string> usedCountries;
 		vector<string> alreadyAllied;
 		for (auto country : GreatCountries)
@@ -5621,7 +2442,7 @@ vector<HoI4Faction*> HoI4World::CreateFactions(const V2World &sourceWorld)
 							if (country.second->getTag() == ally)
 								name = country.second->getSourceCountry()->getName("english");
 						}
-						string sphere = returnIfSphere(country, allycountry, sourceWorld);
+						const string& sphere = warPlanningSnapshot->getSphereLeader(allycountry);
 
 						if (allygovernment == yourgovernment || sphere == country->getTag()
 							|| (yourgovernment == "absolute_monarchy" && (allygovernment == "fascism" || allygovernment == "democratic" || allygovernment == "prussian_constitutionalism" || allygovernment == "hms_government"))
@@ -5683,48 +2504,7 @@ double HoI4World::GetFactionStrength(HoI4Faction* Faction, int years)
 	}
 	return strength;
 }
-vector<HoI4Country*> HoI4World::returnGreatCountries(const V2World &sourceWorld)
-{
-	const vector<string>& greatCountries = sourceWorld.getGreatPowers();
-	vector<HoI4Country*> GreatCountries;
-	for (auto countryItr : greatCountries)
-	{
-		auto itr = countries.find(CountryMapper::getHoI4Tag(countryItr));
-		if (itr != countries.end())
-		{
-			GreatCountries.push_back(itr->second);
-		}
-	}
-	return GreatCountries;
-}
-string HoI4World::returnIfSphere(HoI4Country* leadercountry, HoI4Country* posLeaderCountry, const V2World &sourceWorld)
-{
-	vector<HoI4Country*> GreatCountries = returnGreatCountries(sourceWorld);
-	for (auto country : GreatCountries)
-	{
-		auto relations = country->getRelations();
-		for (auto relation : relations)
-		{
-			if (relation.second->getSphereLeader())
-			{
-
-				string tag = relation.second->getTag();
-				auto spheredcountry = countries.find(tag);
-				if (spheredcountry != countries.end())
-				{
-					if (posLeaderCountry->getTag() == spheredcountry->second->getTag())
-					{
-						return country->getTag();
-					}
-
-				}
-
-			}
-		}
-	}
-	return "";
-}
-vector<HoI4Faction*> HoI4World::FascistWarMaker(HoI4Country* Leader, V2World sourceWorld)
+vector<HoI4Faction*> HoI4World::FascistWarMaker(HoI4Country* Leader)
 {
 	vector<HoI4Faction*> CountriesAtWar;
 	LOG(LogLevel::Info) << "Calculating AI for " + Leader->getSourceCountry()->getName("english");
@@ -5735,11 +2515,11 @@ vector<HoI4Faction*> HoI4World::FascistWarMaker(HoI4Country* Leader, V2World sou
 	vector<HoI4Country*> EqualTargets;
 	vector<HoI4Country*> DifficultTargets;
 	//getting country provinces and its neighbors
-	vector<int> leaderProvs = getCountryProvinces(Leader);
-	map<string, HoI4Country*> AllNeighbors = findNeighbors(leaderProvs, Leader);
+	const vector<int>& leaderProvs = warPlanningSnapshot->getProvinces(Leader);
+	const map<string, HoI4Country*>& AllNeighbors = warPlanningSnapshot->getNeighbors(Leader);
 	map<string, HoI4Country*> CloseNeighbors;
 	//gets neighbors that are actually close to you
-	for each (auto neigh in AllNeighbors)
+	for (auto neigh: AllNeighbors)
 	{
 		if (neigh.second->getCapitalProv() != 0)
 		{
@@ -5751,7 +2531,7 @@ vector<HoI4Faction*> HoI4World::FascistWarMaker(HoI4Country* Leader, V2World sou
 		}
 	}
 
-	set<string> Allies = Leader->getAllies();
+	const set<string>& Allies = Leader->getAllies();
 	//should add method to look for cores you dont own
 	//should add method to look for more allies
 
@@ -5760,7 +2540,7 @@ vector<HoI4Faction*> HoI4World::FascistWarMaker(HoI4Country* Leader, V2World sou
 	for (auto neigh : CloseNeighbors)
 	{
 		//lets check to see if they are not our ally and not a great country
-		if (std::find(Allies.begin(), Allies.end(), neigh.second->getTag()) == Allies.end() && !checkIfGreatCountry(neigh.second, sourceWorld))
+		if (std::find(Allies.begin(), Allies.end(), neigh.second->getTag()) == Allies.end() && !warPlanningSnapshot->isGreatCountry(neigh.second))
 		{
 			volatile double enemystrength = neigh.second->getStrengthOverTime(1.5);
 			volatile double mystrength = Leader->getStrengthOverTime(1.5);
@@ -6100,8 +2880,7 @@ vector<HoI4Faction*> HoI4World::FascistWarMaker(HoI4Country* Leader, V2World sou
 				vector<int> demandedstates;
 				for (auto leaderprov : leaderProvs)
 				{
-					vector<int> thisprovNeighbors = provinceNeighbors.find(leaderprov)->second;
-					for (int prov : thisprovNeighbors)
+					for (int prov : provinceNeighborMapper::getNeighbors(leaderprov))
 					{
 						if (stateToProvincesMap.find(prov) == stateToProvincesMap.end())
 						{
@@ -6141,7 +2920,7 @@ vector<HoI4Faction*> HoI4World::FascistWarMaker(HoI4Country* Leader, V2World sou
 	}
 	//events for allies
 	vector<HoI4Country*> newAllies = GetMorePossibleAllies(Leader);
-	for each (auto newally in newAllies)
+	for (auto newally: newAllies)
 	{
 		findFaction(Leader)->addMember(newally);
 	}
@@ -6203,12 +2982,12 @@ vector<HoI4Faction*> HoI4World::FascistWarMaker(HoI4Country* Leader, V2World sou
 		CreateFactionEvents(Leader, newAllies[i]);
 	}
 
-	vector<HoI4Country*> GreatCountries = returnGreatCountries(sourceWorld);
+	const vector<HoI4Country*>& GreatCountries = warPlanningSnapshot->getGreatCountries();
 	vector<HoI4Faction*> FactionsAttackingMe;
 	int maxGCAlliance = 0;
 	if (WorldTargetMap.find(Leader) != WorldTargetMap.end())
 	{
-		for each (HoI4Country* country in WorldTargetMap.find(Leader)->second)
+		for (HoI4Country* country: WorldTargetMap.find(Leader)->second)
 		{
 			HoI4Faction* attackingFaction = findFaction(country);
 			if (find(FactionsAttackingMe.begin(), FactionsAttackingMe.end(), attackingFaction) == FactionsAttackingMe.end())
@@ -6217,7 +2996,7 @@ vector<HoI4Faction*> HoI4World::FascistWarMaker(HoI4Country* Leader, V2World sou
 			}
 		}
 		double FactionsAttackingMeStrength = 0;
-		for each (HoI4Faction* attackingFaction in FactionsAttackingMe)
+		for (HoI4Faction* attackingFaction: FactionsAttackingMe)
 		{
 			FactionsAttackingMeStrength += GetFactionStrengthWithDistance(Leader, attackingFaction->getMembers(), 3);
 		}
@@ -6228,7 +3007,8 @@ vector<HoI4Faction*> HoI4World::FascistWarMaker(HoI4Country* Leader, V2World sou
 
 			for (HoI4Country* GC : GreatCountries)
 			{
-				int relations = Leader->getRelations(GC->getTag())->getRelations();
+				HoI4Relations* relationsObj = Leader->getRelations(GC->getTag());
+				int relations = (relationsObj != NULL) ? relationsObj->getRelations() : 0;
 				if (relations > 0 && maxGCAlliance < 1)
 				{
 					aiOutputLog += Leader->getSourceCountry()->getName("english") + " can attempt to ally " + GC->getSourceCountry()->getName("english") + "\n";
@@ -6271,7 +3051,7 @@ vector<HoI4Faction*> HoI4World::FascistWarMaker(HoI4Country* Leader, V2World sou
 	map<double, HoI4Country*> GCDistance;
 	vector<HoI4Country*> GCDistanceSorted;
 	//get great countries with a distance
-	for each (auto GC in GreatCountries)
+	for (auto GC: GreatCountries)
 	{
 		double distance = getDistanceBetweenCountries(Leader, GC);
 		if (distance < 2200)
@@ -6284,7 +3064,7 @@ vector<HoI4Faction*> HoI4World::FascistWarMaker(HoI4Country* Leader, V2World sou
 	}
 	sort(GCDistanceSorted.begin(), GCDistanceSorted.end());
 	vector<HoI4Country*> GCTargets;
-	for each (auto GC in GCDistanceSorted)
+	for (auto GC: GCDistanceSorted)
 	{
 		string thetag = GC->getTag();
 		string HowToTakeGC = HowToTakeLand(GC, Leader, 3);
@@ -6301,13 +3081,14 @@ vector<HoI4Faction*> HoI4World::FascistWarMaker(HoI4Country* Leader, V2World sou
 	{
 		start = -1;
 	}
-	for each (auto GC in GCTargets)
+	for (auto GC: GCTargets)
 	{
-		int relations = Leader->getRelations(GC->getTag())->getRelations();
+		HoI4Relations* relationsObj = Leader->getRelations(GC->getTag());
+		int relations = (relationsObj != NULL) ? relationsObj->getRelations() : 0;
 		if (relations < 0)
 		{
 			string prereq = "";
-			set<string> Allies = Leader->getAllies();
+			const set<string>& Allies = Leader->getAllies();
 			if (maxGCWars < 1 && std::find(Allies.begin(), Allies.end(), GC->getTag()) == Allies.end())
 			{
 				CountriesAtWar.push_back(findFaction(Leader));
@@ -6381,7 +3162,7 @@ vector<HoI4Faction*> HoI4World::FascistWarMaker(HoI4Country* Leader, V2World sou
 	FocusTree += "\n}";
 
 	//output National Focus
-	string filenameNF("Output/" + Configuration::getOutputName() + "/common/national_focus/" + Leader->getSourceCountry()->getTag() + "_NF.txt");
+	string filenameNF("output/" + Configuration::getOutputName() + "/common/national_focus/" + Leader->getSourceCountry()->getTag() + "_NF.txt");
 	ofstream out2;
 	out2.open(filenameNF);
 	{
@@ -6391,16 +3172,16 @@ vector<HoI4Faction*> HoI4World::FascistWarMaker(HoI4Country* Leader, V2World sou
 
 	return CountriesAtWar;
 }
-vector<HoI4Faction*> HoI4World::CommunistWarCreator(HoI4Country* Leader, V2World sourceWorld)
+vector<HoI4Faction*> HoI4World::CommunistWarCreator(HoI4Country* Leader)
 {
 	vector<HoI4Faction*> CountriesAtWar;
 	//communism still needs great country war events
 	LOG(LogLevel::Info) << "Calculating AI for " + Leader->getSourceCountry()->getName("english");
-	vector<int> leaderProvs = getCountryProvinces(Leader);
+	const vector<int>& leaderProvs = warPlanningSnapshot->getProvinces(Leader);
 	LOG(LogLevel::Info) << "Calculating Neighbors for " + Leader->getSourceCountry()->getName("english");
-	map<string, HoI4Country*> AllNeighbors = findNeighbors(leaderProvs, Leader);
+	const map<string, HoI4Country*>& AllNeighbors = warPlanningSnapshot->getNeighbors(Leader);
 	map<string, HoI4Country*> Neighbors;
-	for each (auto neigh in AllNeighbors)
+	for (auto neigh: AllNeighbors)
 	{
 		if (neigh.second->getCapitalProv() != 0)
 		{
@@ -6411,7 +3192,7 @@ vector<HoI4Faction*> HoI4World::CommunistWarCreator(HoI4Country* Leader, V2World
 				Neighbors.insert(neigh);
 		}
 	}
-	set<string> Allies = Leader->getAllies();
+	const set<string>& Allies = Leader->getAllies();
 	vector<HoI4Country*> Targets;
 	map<string, vector<HoI4Country*>> NationalFocusesMap;
 	vector<HoI4Country*> coups;
@@ -6424,7 +3205,7 @@ vector<HoI4Faction*> HoI4World::CommunistWarCreator(HoI4Country* Leader, V2World
 	for (auto neigh : Neighbors)
 	{
 		//lets check to see if they are our ally and not a great country
-		if (std::find(Allies.begin(), Allies.end(), neigh.second->getTag()) == Allies.end() && !checkIfGreatCountry(neigh.second, sourceWorld))
+		if (std::find(Allies.begin(), Allies.end(), neigh.second->getTag()) == Allies.end() && !warPlanningSnapshot->isGreatCountry(neigh.second))
 		{
 			double com = 0;
 			HoI4Faction* neighFaction = findFaction(neigh.second);
@@ -6756,12 +3537,12 @@ vector<HoI4Faction*> HoI4World::CommunistWarCreator(HoI4Country* Leader, V2World
 		CreateFactionEvents(Leader, newAllies[i]);
 	}
 
-	vector<HoI4Country*> GreatCountries = returnGreatCountries(sourceWorld);
+	const vector<HoI4Country*>& GreatCountries = warPlanningSnapshot->getGreatCountries();
 	vector<HoI4Faction*> FactionsAttackingMe;
 	int maxGCAlliance = 0;
 	if (WorldTargetMap.find(Leader) != WorldTargetMap.end())
 	{
-		for each (HoI4Country* country in WorldTargetMap.find(Leader)->second)
+		for (HoI4Country* country: WorldTargetMap.find(Leader)->second)
 		{
 			HoI4Faction* attackingFaction = findFaction(country);
 			if (find(FactionsAttackingMe.begin(), FactionsAttackingMe.end(), attackingFaction) == FactionsAttackingMe.end())
@@ -6770,7 +3551,7 @@ vector<HoI4Faction*> HoI4World::CommunistWarCreator(HoI4Country* Leader, V2World
 			}
 		}
 		double FactionsAttackingMeStrength = 0;
-		for each (HoI4Faction* attackingFaction in FactionsAttackingMe)
+		for (HoI4Faction* attackingFaction: FactionsAttackingMe)
 		{
 			FactionsAttackingMeStrength += GetFactionStrengthWithDistance(Leader, attackingFaction->getMembers(), 3);
 		}
@@ -6781,7 +3562,8 @@ vector<HoI4Faction*> HoI4World::CommunistWarCreator(HoI4Country* Leader, V2World
 
 			for (HoI4Country* GC : GreatCountries)
 			{
-				int relations = Leader->getRelations(GC->getTag())->getRelations();
+				HoI4Relations* relationsObj = Leader->getRelations(GC->getTag());
+				int relations = (relationsObj != NULL) ? relationsObj->getRelations() : 0;
 				if (relations > 0 && maxGCAlliance < 1)
 				{
 					aiOutputLog += Leader->getSourceCountry()->getName("english") + " can attempt to ally " + GC->getSourceCountry()->getName("english") + "\n";
@@ -6825,7 +3607,7 @@ vector<HoI4Faction*> HoI4World::CommunistWarCreator(HoI4Country* Leader, V2World
 
 	map<double, HoI4Country*> GCDistance;
 	vector<HoI4Country*> GCDistanceSorted;
-	for each (auto GC in GreatCountries)
+	for (auto GC: GreatCountries)
 	{
 		double distance = getDistanceBetweenCountries(Leader, GC);
 		if (distance < 1200)
@@ -6838,7 +3620,7 @@ vector<HoI4Faction*> HoI4World::CommunistWarCreator(HoI4Country* Leader, V2World
 	}
 	sort(GCDistanceSorted.begin(), GCDistanceSorted.end());
 	vector<HoI4Country*> GCTargets;
-	for each (auto GC in GCDistanceSorted)
+	for (auto GC: GCDistanceSorted)
 	{
 		string thetag = GC->getTag();
 		string HowToTakeGC = HowToTakeLand(GC, Leader, 3);
@@ -6859,9 +3641,10 @@ vector<HoI4Faction*> HoI4World::CommunistWarCreator(HoI4Country* Leader, V2World
 	{
 		start = -1;
 	}
-	for each (auto GC in GCTargets)
+	for (auto GC: GCTargets)
 	{
-		int relations = Leader->getRelations(GC->getTag())->getRelations();
+		HoI4Relations* relationsObj = Leader->getRelations(GC->getTag());
+		int relations = (relationsObj != NULL) ? relationsObj->getRelations() : 0;
 		if (relations < 0)
 		{
 			string prereq = "";
@@ -6928,8 +3711,8 @@ vector<HoI4Faction*> HoI4World::CommunistWarCreator(HoI4Country* Leader, V2World
 		}
 	}
 	FocusTree += "\n}";
-	string filename2("Output/" + Configuration::getOutputName() + "/common/national_focus/" + Leader->getSourceCountry()->getTag() + "_NF.txt");
-	//string filename2("Output/NF.txt");
+	string filename2("output/" + Configuration::getOutputName() + "/common/national_focus/" + Leader->getSourceCountry()->getTag() + "_NF.txt");
+	//string filename2("output/NF.txt");
 	ofstream out2;
 	out2.open(filename2);
 	{
@@ -6938,18 +3721,19 @@ vector<HoI4Faction*> HoI4World::CommunistWarCreator(HoI4Country* Leader, V2World
 	out2.close();
 	return CountriesAtWar;
 }
-vector<HoI4Faction*> HoI4World::DemocracyWarCreator(HoI4Country* Leader, V2World sourceWorld)
+vector<HoI4Faction*> HoI4World::DemocracyWarCreator(HoI4Country* Leader)
 {
 	vector<HoI4Faction*> CountriesAtWar;
 	map<int, HoI4Country*> CountriesToContain;
 	vector<HoI4Country*> vCountriesToContain;
-	set<string> Allies = Leader->getAllies();
+	const set<string>& Allies = Leader->getAllies();
 	int v1 = rand() % 100;
 	v1 = v1 / 100;
 	string FocusTree = genericFocusTreeCreator(Leader);
-	for (auto GC : returnGreatCountries(sourceWorld))
+	for (auto GC : warPlanningSnapshot->getGreatCountries())
 	{
-		double relation = Leader->getRelations(GC->getTag())->getRelations();
+		HoI4Relations* relationObj = Leader->getRelations(GC->getTag());
+		double relation = (relationObj != NULL) ? relationObj->getRelations() : 0;
 		if (relation < 100 && (GC->getGovernment() != "hms_government" || (GC->getGovernment() == "hms_government" && (GC->getRulingParty().war_pol == "jingoism" || GC->getRulingParty().war_pol == "pro_military"))) && GC->getGovernment() != "democratic" && std::find(Allies.begin(), Allies.end(), GC->getTag()) == Allies.end())
 		{
 			string HowToTakeGC = HowToTakeLand(GC, Leader, 3);
@@ -6970,7 +3754,7 @@ vector<HoI4Faction*> HoI4World::DemocracyWarCreator(HoI4Country* Leader, V2World
 	}
 	FocusTree += "\n}";
 	//output National Focus
-	string filenameNF("Output/" + Configuration::getOutputName() + "/common/national_focus/" + Leader->getSourceCountry()->getTag() + "_NF.txt");
+	string filenameNF("output/" + Configuration::getOutputName() + "/common/national_focus/" + Leader->getSourceCountry()->getTag() + "_NF.txt");
 	ofstream out2;
 	out2.open(filenameNF);
 	{
@@ -6979,7 +3763,7 @@ vector<HoI4Faction*> HoI4World::DemocracyWarCreator(HoI4Country* Leader, V2World
 	out2.close();
 	return CountriesAtWar;
 }
-vector<HoI4Faction*> HoI4World::MonarchyWarCreator(HoI4Country* Leader, V2World sourceWorld)
+vector<HoI4Faction*> HoI4World::MonarchyWarCreator(HoI4Country* Leader)
 {
 	vector<HoI4Faction*> CountriesAtWar;
 	//this is for monarchy events, dont need for random
@@ -6990,12 +3774,12 @@ vector<HoI4Faction*> HoI4World::MonarchyWarCreator(HoI4Country* Leader, V2World
 	vector<HoI4Country*> EqualTargets;
 	vector<HoI4Country*> DifficultTargets;
 	//getting country provinces and its neighbors
-	vector<int> leaderProvs = getCountryProvinces(Leader);
-	map<string, HoI4Country*> AllNeighbors = findNeighbors(leaderProvs, Leader);
+	const vector<int>& leaderProvs = warPlanningSnapshot->getProvinces(Leader);
+	const map<string, HoI4Country*>& AllNeighbors = warPlanningSnapshot->getNeighbors(Leader);
 	map<string, HoI4Country*> CloseNeighbors;
 	map<string, HoI4Country*> FarNeighbors;
 	//gets neighbors that are actually close to you
-	for each (auto neigh in AllNeighbors)
+	for (auto neigh: AllNeighbors)
 	{
 		if (neigh.second->getCapitalProv() != 0)
 		{
@@ -7011,21 +3795,15 @@ vector<HoI4Faction*> HoI4World::MonarchyWarCreator(HoI4Country* Leader, V2World
 	//if farneighbors is 0, try to find colonial conquest
 	if (FarNeighbors.size() == 0)
 	{
-		for (auto Colcountry : countries)
+		//IMPROVE
+		//but this should never happen since the AI shouldnt even take this unless they already have colonies
+		for (auto country2 : spatialIndex->findCountriesWithin(Leader, 1000))
 		{
-
-			HoI4Country* country2 = Colcountry.second;
-			if (country2->getCapitalProv() != 0)
-			{
-				//IMPROVE
-				//but this should never happen since the AI shouldnt even take this unless they already have colonies
-				double distance = getDistanceBetweenCountries(Leader, country2);
-				if (distance <= 1000 && Colcountry.second->getProvinceCount() > 0)
-					FarNeighbors.insert(Colcountry);
-			}
+			if (country2->getProvinceCount() > 0)
+				FarNeighbors.insert(make_pair(country2->getTag(), country2));
 		}
 	}
-	set<string> Allies = Leader->getAllies();
+	const set<string>& Allies = Leader->getAllies();
 	//should add method to look for cores you dont own
 	//should add method to look for more allies
 
@@ -7034,7 +3812,7 @@ vector<HoI4Faction*> HoI4World::MonarchyWarCreator(HoI4Country* Leader, V2World
 	for (auto neigh : CloseNeighbors)
 	{
 		//lets check to see if they are not our ally and not a great country
-		if (std::find(Allies.begin(), Allies.end(), neigh.second->getTag()) == Allies.end() && !checkIfGreatCountry(neigh.second, sourceWorld))
+		if (std::find(Allies.begin(), Allies.end(), neigh.second->getTag()) == Allies.end() && !warPlanningSnapshot->isGreatCountry(neigh.second))
 		{
 			volatile double enemystrength = neigh.second->getStrengthOverTime(1.5);
 			volatile double mystrength = Leader->getStrengthOverTime(1.5);
@@ -7049,7 +3827,7 @@ vector<HoI4Faction*> HoI4World::MonarchyWarCreator(HoI4Country* Leader, V2World
 	for (auto neigh : FarNeighbors)
 	{
 		//lets check to see if they are not our ally and not a great country
-		if (std::find(Allies.begin(), Allies.end(), neigh.second->getTag()) == Allies.end() && !checkIfGreatCountry(neigh.second, sourceWorld))
+		if (std::find(Allies.begin(), Allies.end(), neigh.second->getTag()) == Allies.end() && !warPlanningSnapshot->isGreatCountry(neigh.second))
 		{
 			volatile double enemystrength = neigh.second->getStrengthOverTime(1.5);
 			volatile double mystrength = Leader->getStrengthOverTime(1.5);
@@ -7074,11 +3852,11 @@ vector<HoI4Faction*> HoI4World::MonarchyWarCreator(HoI4Country* Leader, V2World
 		WC = WeakColonies.size();
 	FocusTree += createMonarchyEmpireNF(Leader, WeakColonies.front(), WeakColonies.back(), WeakNeighbors.front(), WeakNeighbors.back(), WC, WN, 0);
 	//Declaring war with Great Country
-	vector<HoI4Country*> GreatCountries = returnGreatCountries(sourceWorld);
+	const vector<HoI4Country*>& GreatCountries = warPlanningSnapshot->getGreatCountries();
 	map<double, HoI4Country*> GCDistance;
 	vector<HoI4Country*> GCDistanceSorted;
 	//get great countries with a distance
-	for each (auto GC in GreatCountries)
+	for (auto GC: GreatCountries)
 	{
 		double distance = getDistanceBetweenCountries(Leader, GC);
 		if (distance < 1200)
@@ -7091,7 +3869,7 @@ vector<HoI4Faction*> HoI4World::MonarchyWarCreator(HoI4Country* Leader, V2World
 	}
 	sort(GCDistanceSorted.begin(), GCDistanceSorted.end());
 	vector<HoI4Country*> GCTargets;
-	for each (auto GC in GCDistanceSorted)
+	for (auto GC: GCDistanceSorted)
 	{
 		string thetag = GC->getTag();
 		string HowToTakeGC = HowToTakeLand(GC, Leader, 3);
@@ -7112,13 +3890,14 @@ vector<HoI4Faction*> HoI4World::MonarchyWarCreator(HoI4Country* Leader, V2World
 	{
 		start = -1;
 	}
-	for each (auto GC in GCTargets)
+	for (auto GC: GCTargets)
 	{
-		int relations = Leader->getRelations(GC->getTag())->getRelations();
+		HoI4Relations* relationsObj = Leader->getRelations(GC->getTag());
+		int relations = (relationsObj != NULL) ? relationsObj->getRelations() : 0;
 		if (relations < 0)
 		{
 			string prereq = "";
-			set<string> Allies = Leader->getAllies();
+			const set<string>& Allies = Leader->getAllies();
 			if (maxGCWars < 1 && std::find(Allies.begin(), Allies.end(), GC->getTag()) == Allies.end())
 			{
 				CountriesAtWar.push_back(findFaction(Leader));
@@ -7183,9 +3962,10 @@ vector<HoI4Faction*> HoI4World::MonarchyWarCreator(HoI4Country* Leader, V2World
 	FocusTree += "\n}";
 	string Events = "";
 	int eventNumber = 0;
-	for each (auto GC in GCTargets)
+	for (auto GC: GCTargets)
 	{
-		int relations = Leader->getRelations(GC->getTag())->getRelations();
+		HoI4Relations* relationsObj = Leader->getRelations(GC->getTag());
+		int relations = (relationsObj != NULL) ? relationsObj->getRelations() : 0;
 		if (relations < 0)
 		{
 			nfEvents += "country_event = {\n";
@@ -7217,8 +3997,8 @@ vector<HoI4Faction*> HoI4World::MonarchyWarCreator(HoI4Country* Leader, V2World
 		}
 	}
 	//output events
-	string filenameevents("Output/" + Configuration::getOutputName() + "/events/" + Leader->getSourceCountry()->getTag() + "_events.txt");
-	//string filename2("Output/NF.txt");
+	string filenameevents("output/" + Configuration::getOutputName() + "/events/" + Leader->getSourceCountry()->getTag() + "_events.txt");
+	//string filename2("output/NF.txt");
 	ofstream outevents;
 	outevents.open(filenameevents);
 	{
@@ -7228,7 +4008,7 @@ vector<HoI4Faction*> HoI4World::MonarchyWarCreator(HoI4Country* Leader, V2World
 	outevents.close();
 
 	//output National Focus
-	string filenameNF("Output/" + Configuration::getOutputName() + "/common/national_focus/" + Leader->getSourceCountry()->getTag() + "_NF.txt");
+	string filenameNF("output/" + Configuration::getOutputName() + "/common/national_focus/" + Leader->getSourceCountry()->getTag() + "_NF.txt");
 	ofstream out2;
 	out2.open(filenameNF);
 	{
@@ -7252,7 +4032,7 @@ void HoI4World::CreateFactionEvents(HoI4Country* Leader, HoI4Country* newAlly)
 	nfEvents += "	\n";
 	nfEvents += "	option = {\n";
 	nfEvents += "		name = \"Yes\"\n";
-	for each (auto member in findFaction(newAlly)->getMembers())
+	for (auto member: findFaction(newAlly)->getMembers())
 	{
 		nfEvents += "		" + member->getTag() + " = {\n";
 		nfEvents += "			add_ai_strategy = {\n";
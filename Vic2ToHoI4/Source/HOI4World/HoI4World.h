@@ -27,6 +27,8 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 #include <string>
 #include "HoI4Country.h"
 #include "HoI4Province.h"
+#include "HoI4SpatialIndex.h"
+#include "HoI4WarPlanningSnapshot.h"
 #include "HoI4Diplomacy.h"
 #include "HoI4Localisation.h"
 #include "HoI4States.h"
@@ -55,7 +57,7 @@ private:
 class HoI4World
 {
 	public:
-		HoI4World(const V2World* sourceWorld) { this->sourceWorld = sourceWorld; }
+		HoI4World(const V2World* sourceWorld): spatialIndex(nullptr), warPlanningSnapshot(nullptr) { this->sourceWorld = sourceWorld; }
 
 		void	output() const;
 
@@ -83,38 +85,24 @@ class HoI4World
 		void    setSphereLeaders(const V2World & sourceWorld);
 		void    thatsgermanWarCreator(const V2World & sourceWorld);
 		HoI4Country* FindProvOwner(int prov);
-		vector<int> getCountryProvinces(HoI4Country * Country);
-		vector<HoI4Faction*> CreateFactions(const V2World & sourceWorld);
+		vector<HoI4Faction*> CreateFactions();
 		HoI4Country *    GetFactionLeader(vector<HoI4Country*> Faction);
 		double    GetFactionStrength(HoI4Faction* Faction, int years);
-		vector<HoI4Country*>    returnGreatCountries(const V2World & sourceWorld);
-		string returnIfSphere(HoI4Country * leadercountry, HoI4Country * posLeaderCountry, const V2World & sourceWorld);
-		vector<HoI4Faction*> FascistWarMaker(HoI4Country * Leader, V2World sourceWorld);
-		vector<HoI4Faction*> CommunistWarCreator(HoI4Country * Leader, V2World sourceWorld);
-		vector<HoI4Faction*> DemocracyWarCreator(HoI4Country * Leader, V2World sourceWorld);
-		vector<HoI4Faction*> MonarchyWarCreator(HoI4Country * Leader, V2World sourceWorld);
+		vector<HoI4Faction*> FascistWarMaker(HoI4Country * Leader);
+		vector<HoI4Faction*> CommunistWarCreator(HoI4Country * Leader);
+		vector<HoI4Faction*> DemocracyWarCreator(HoI4Country * Leader);
+		vector<HoI4Faction*> MonarchyWarCreator(HoI4Country * Leader);
 		void CreateFactionEvents(HoI4Country * Leader, HoI4Country * newAlly);
 		string HowToTakeLand(HoI4Country * TargetCountry, HoI4Country * AttackingCountry, double time);
 		vector<HoI4Country*> GetMorePossibleAllies(HoI4Country * CountryThatWantsAllies);
 		double getDistanceBetweenCountries(const HoI4Country* Country1, const HoI4Country* Country2);
-		bool bothCountriesHaveCapitals(const HoI4Country* Country1, const HoI4Country* Country2);
-		pair<int, int> getCapitalPosition(const HoI4Country* country);
-		pair<int, int> getProvincePosition(int provinceNum);
-		void establishProvincePositions();
-		void processPositionLine(const string& line);
-		vector<string> tokenizeLine(const string& line);
-		void addProvincePosition(const vector<string>& tokenizedLine);
-		double getDistanceBetweenPoints(pair<int, int> point1, pair<int, int> point2);
-		double GetFactionStrengthWithDistance(HoI4Country * HomeCountry, vector<HoI4Country*> Faction, double time);
+		double GetFactionStrengthWithDistance(HoI4Country * HomeCountry, const vector<HoI4Country*>& Faction, double time);
 		HoI4Faction* findFaction(HoI4Country * CheckingCountry);
-		bool checkIfGreatCountry(HoI4Country * checkingCountry, const V2World & sourceWorld);
-		map<string, HoI4Country*> findNeighbors(vector<int> CountryProvs, HoI4Country * CheckingCountry);
 		void fillProvinces();
 		string createAnnexEvent(HoI4Country * Annexer, HoI4Country * Annexed, int eventnumber);
-		string createSudatenEvent(HoI4Country * Annexer, HoI4Country * Annexed, int eventnumber, vector<int> claimedStates);
-		string createDemocracyNF(HoI4Country * Home, vector<HoI4Country*> CountriesToContain, int XStart);
+		string createSudatenEvent(HoI4Country * Annexer, HoI4Country * Annexed, int eventnumber, const vector<int>& claimedStates);
+		string createDemocracyNF(HoI4Country * Home, const vector<HoI4Country*>& CountriesToContain, int XStart);
 		string createMonarchyEmpireNF(HoI4Country * Home, HoI4Country * Annexed1, HoI4Country * Annexed2, HoI4Country * Annexed3, HoI4Country * Annexed4, int ProtectorateNumber, int AnnexNumber, int x);
-		void fillProvinceNeighbors();
 		string genericFocusTreeCreator(HoI4Country * CreatingCountry);
 		void outputRelations();
 		void	checkAllProvincesMapped();
@@ -159,7 +147,6 @@ class HoI4World
 		void	outputHistory() const;
 		void	outputSupply() const;
 
-		map<int, vector<int>>			provinceNeighbors;
 		const V2World* sourceWorld;
 
 		const HoI4States* states;
@@ -179,7 +166,8 @@ class HoI4World
 		map<int, string>						supplyZonesFilenames;
 		map<int, HoI4StrategicRegion*>	strategicRegions;
 		map<int, int>							provinceToStratRegionMap;
-		map<int, pair<int, int>> provincePositions;
+		HoI4SpatialIndex*						spatialIndex;	// where provinces and capitals are; made once the capitals are settled
+		HoI4WarPlanningSnapshot*			warPlanningSnapshot;	// what the war creators know about each country; made along with spatialIndex
 
 		HoI4Localisation				localisation;
 		vector<HoI4Faction*> Factions;
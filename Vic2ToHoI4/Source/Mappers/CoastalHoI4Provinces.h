@@ -26,8 +26,10 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 
 
-#include <vector>
+#include <cstddef>
 #include <map>
+#include <string>
+#include <vector>
 using namespace std;
 
 
@@ -63,7 +65,6 @@ class coastalProvincesMapper
 
 		
 		map<int, province> getProvinces();
-		map<int, vector<int>> getAdjacencies();
 
 		map<int, int> coastalProvinces;	// province, connecting sea province
 };
@@ -31,9 +31,9 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 #include <utility>
 #include <boost/algorithm/string.hpp>
 #include "Object.h"
-#include "paradoxParserUTF8.h"
+#include "ParadoxParserUTF8.h"
 #include "../V2World/V2World.h"
-#include "../HoI4World/HoI4World.h"
+#include "../HOI4World/HoI4World.h"
 #include "Log.h"
 #include "OSCompatibilityLayer.h"
 
@@ -55,7 +55,13 @@ void CountryMapper::CreateMappings(const V2World* srcWorld)
 	for (auto Vic2Tag: srcWorld->getCountries())
 	{
 		string HoI4Tag = generateNewTag();
-		V2TagToHoI4TagMap.left.insert(make_pair(Vic2Tag.first, HoI4Tag));
+		const TagId Vic2Id	= TagRegistry::getId(Vic2Tag.first);
+		const TagId HoI4Id	= TagRegistry::getId(HoI4Tag);
+		if (!V2TagToHoI4TagMap.contains(Vic2Id) && !HoI4TagToV2TagMap.contains(HoI4Id))
+		{
+			V2TagToHoI4TagMap.set(Vic2Id, HoI4Id);
+			HoI4TagToV2TagMap.set(HoI4Id, Vic2Id);
+		}
 		LogMapping(Vic2Tag.first, HoI4Tag, "generated tag");
 	}
 }
@@ -64,6 +70,7 @@ void CountryMapper::CreateMappings(const V2World* srcWorld)
 void CountryMapper::resetMappingData()
 {
 	V2TagToHoI4TagMap.clear();
+	HoI4TagToV2TagMap.clear();
 
 	generatedHoI4TagPrefix = 'X';
 	generatedHoI4TagSuffix = 0;
@@ -93,29 +100,35 @@ void CountryMapper::LogMapping(const string& sourceTag, const string& targetTag,
 }
 
 
-const string CountryMapper::GetHoI4Tag(const string& V2Tag) const
+const string& CountryMapper::GetHoI4Tag(const string& V2Tag) const
 {
-	boost::bimap<string, string>::left_const_iterator findIter = V2TagToHoI4TagMap.left.find(V2Tag);
-	if (findIter != V2TagToHoI4TagMap.left.end())
+	static const string noTag;
+
+	const TagId Vic2Id = TagRegistry::findId(V2Tag);
+	const TagId* HoI4Id = (Vic2Id != TagRegistry::invalidId) ? V2TagToHoI4TagMap.find(Vic2Id) : nullptr;
+	if (HoI4Id != nullptr)
 	{
-		return findIter->second;
+		return TagRegistry::getTag(*HoI4Id);
 	}
 	else
 	{
-		return "";
+		return noTag;
 	}
 }
 
 
-const string CountryMapper::GetVic2Tag(const string& HoI4Tag) const
+const string& CountryMapper::GetVic2Tag(const string& HoI4Tag) const
 {
-	boost::bimap<string, string>::right_const_iterator findIter = V2TagToHoI4TagMap.right.find(HoI4Tag);
-	if (findIter != V2TagToHoI4TagMap.right.end())
+	static const string noTag;
+
+	const TagId HoI4Id = TagRegistry::findId(HoI4Tag);
+	const TagId* Vic2Id = (HoI4Id != TagRegistry::invalidId) ? HoI4TagToV2TagMap.find(HoI4Id) : nullptr;
+	if (Vic2Id != nullptr)
 	{
-		return findIter->second;
+		return TagRegistry::getTag(*Vic2Id);
 	}
 	else
 	{
-		return "";
+		return noTag;
 	}
 }
\ No newline at end of file
@@ -26,9 +26,8 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 
 
-#include <map>
 #include <string>
-#include <boost/bimap.hpp>
+#include "IdRegistry.h"
 using namespace std;
 
 
@@ -45,12 +44,12 @@ class CountryMapper
 			getInstance()->CreateMappings(srcWorld);
 		}
 
-		static const string getHoI4Tag(const string& V2Tag)
+		static const string& getHoI4Tag(const string& V2Tag)
 		{
 			return getInstance()->GetHoI4Tag(V2Tag);
 		}
 
-		static const string getVic2Tag(const string& HoI4Tag)
+		static const string& getVic2Tag(const string& HoI4Tag)
 		{
 			return getInstance()->GetVic2Tag(HoI4Tag);
 		}
@@ -73,10 +72,11 @@ class CountryMapper
 		string generateNewTag();
 		void LogMapping(const string& sourceTag, const string& targetTag, const string& reason);
 
-		const string GetHoI4Tag(const string& V2Tag) const;
-		const string GetVic2Tag(const string& HoI4Tag) const;
+		const string& GetHoI4Tag(const string& V2Tag) const;
+		const string& GetVic2Tag(const string& HoI4Tag) const;
 
-		boost::bimap<string, string> V2TagToHoI4TagMap;
+		DenseIdMap<TagId> V2TagToHoI4TagMap;	// the HoI4 tag for each Vic2 tag, by tag ID
+		DenseIdMap<TagId> HoI4TagToV2TagMap;	// the Vic2 tag for each HoI4 tag, by tag ID
 
 		char generatedHoI4TagPrefix;
 		int generatedHoI4TagSuffix;
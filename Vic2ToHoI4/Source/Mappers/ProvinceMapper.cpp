@@ -23,8 +23,8 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 #include "ProvinceMapper.h"
 #include <fstream>
-#include "log.h"
-#include "..\Configuration.h"
+#include "Log.h"
+#include "../Configuration.h"
 #include "Object.h"
 #include "ParadoxParser8859_15.h"
 
@@ -26,6 +26,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 
 
+#include <cstddef>
 #include <map>
 #include <unordered_set>
 #include <vector>
@@ -0,0 +1,311 @@
+/*Copyright (c) 2016 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+
+#include "ProvinceNeighborMapper.h"
+#include <algorithm>
+#include <cstring>
+#include "Log.h"
+#include "OSCompatibilityLayer.h"
+#include "ParsedFileCache.h"
+
+
+
+namespace
+{
+
+const char		graphMagic[8]	= { 'P', 'D', 'X', 'A', 'D', 'J', '\0', '\0' };	// the start of every cached graph
+const uint32_t	graphVersion	= 1;															// changes whenever the cached format does
+
+
+// One line of adj.txt: a province and where its neighbours were put while reading
+struct adjacencyLine
+{
+	int		province;			// the province the line is for
+	uint32_t	firstNeighbor;		// where the line's neighbours start
+	uint32_t	neighborCount;		// how many neighbours the line lists
+};
+
+
+// Reads the number in [start, end), returning false if there is none. adj.txt is mapped rather than copied, so
+// there is no terminating null to stop strtol.
+bool readNumber(const char* start, const char* end, int& number)
+{
+	bool negative = false;
+	if ((start < end) && (*start == '-'))
+	{
+		negative = true;
+		start++;
+	}
+
+	if ((start == end) || (*start < '0') || (*start > '9'))
+	{
+		return false;
+	}
+
+	number = 0;
+	for (; (start < end) && (*start >= '0') && (*start <= '9'); start++)
+	{
+		number = number * 10 + (*start - '0');
+	}
+	if (negative)
+	{
+		number = -number;
+	}
+	return true;
+}
+
+}
+
+
+
+provinceNeighborMapper* provinceNeighborMapper::instance = NULL;
+
+
+
+provinceNeighborMapper::provinceNeighborMapper()
+{
+	Utils::FileStamp stamp;
+	if (!Utils::GetFileStamp("adj.txt", stamp))
+	{
+		LOG(LogLevel::Error) << "Could not open adj.txt";
+		exit(-1);
+	}
+
+	string graphPath;	// where the graph is cached, if anywhere
+	const ParsedFileCache* cache = ParsedFileCache::getShared();
+	if (cache != nullptr)
+	{
+		graphPath = cache->getDirectory() + "/provinceNeighbors.graph";
+		if (loadGraph(graphPath, stamp))
+		{
+			return;
+		}
+	}
+
+	Utils::MappedFile adjacencies("adj.txt");
+	if (!adjacencies.isOpen())
+	{
+		LOG(LogLevel::Error) << "Could not open adj.txt";
+		exit(-1);
+	}
+	readAdjacencies(adjacencies.getData(), adjacencies.getSize());
+
+	if (cache != nullptr)
+	{
+		storeGraph(graphPath, stamp);
+	}
+}
+
+
+void provinceNeighborMapper::readAdjacencies(const char* data, size_t size)
+{
+	// each line is: province number; a flag; red; green; blue; <neighbours;>*
+	// the lines are read into one flat list first, then moved into province order
+	vector<adjacencyLine> lines;
+	vector<int> lineNeighbors;
+	int highestProvince = 0;
+
+	const char* end = data + size;
+	const char* current = data;
+	while (current < end)
+	{
+		const char* lineEnd = static_cast<const char*>(memchr(current, '\n', end - current));
+		if (lineEnd == nullptr)
+		{
+			lineEnd = end;
+		}
+
+		adjacencyLine line;
+		line.province = -1;
+		line.firstNeighbor = static_cast<uint32_t>(lineNeighbors.size());
+		unsigned int field = 0;
+		while (current < lineEnd)
+		{
+			const char* fieldEnd = static_cast<const char*>(memchr(current, ';', lineEnd - current));
+			if (fieldEnd == nullptr)
+			{
+				fieldEnd = lineEnd;
+			}
+
+			int number;
+			if (readNumber(current, fieldEnd, number))
+			{
+				if (field == 0)
+				{
+					line.province = number;
+				}
+				else if (field >= 5)
+				{
+					lineNeighbors.push_back(number);
+				}
+			}
+
+			field++;
+			current = fieldEnd + 1;
+		}
+		current = lineEnd + 1;
+
+		if (line.province >= 0)
+		{
+			line.neighborCount = static_cast<uint32_t>(lineNeighbors.size()) - line.firstNeighbor;
+			lines.push_back(line);
+			highestProvince = max(highestProvince, line.province);
+		}
+		else
+		{
+			lineNeighbors.resize(line.firstNeighbor);
+		}
+	}
+
+	// a province listed more than once keeps its first line
+	vector<const adjacencyLine*> provinceLines(highestProvince + 1, nullptr);
+	for (const auto& line: lines)
+	{
+		if (provinceLines[line.province] == nullptr)
+		{
+			provinceLines[line.province] = &line;
+		}
+	}
+
+	offsets.resize(highestProvince + 2);
+	neighbors.reserve(lineNeighbors.size());
+	for (int province = 0; province <= highestProvince; province++)
+	{
+		offsets[province] = static_cast<uint32_t>(neighbors.size());
+		const adjacencyLine* line = provinceLines[province];
+		if (line != nullptr)
+		{
+			neighbors.insert(neighbors.end(), lineNeighbors.begin() + line->firstNeighbor, lineNeighbors.begin() + line->firstNeighbor + line->neighborCount);
+		}
+	}
+	offsets[highestProvince + 1] = static_cast<uint32_t>(neighbors.size());
+}
+
+
+bool provinceNeighborMapper::loadGraph(const string& path, const Utils::FileStamp& stamp)
+{
+	Utils::MappedFile graph(path);
+	if (!graph.isOpen())
+	{
+		return false;
+	}
+
+	// magic, version, the size and time of adj.txt, then the length of its path and the path
+	const char* current = graph.getData();
+	const char* end = graph.getData() + graph.getSize();
+	auto read = [&current, end](void* destination, size_t length)
+	{
+		if (static_cast<size_t>(end - current) < length)
+		{
+			return false;
+		}
+		memcpy(destination, current, length);
+		current += length;
+		return true;
+	};
+
+	char magic[sizeof(graphMagic)];
+	uint32_t version, pathLength, offsetCount, neighborCount;
+	uint64_t size;
+	int64_t modifiedTime;
+	if (
+		!read(magic, sizeof(magic)) || (memcmp(magic, graphMagic, sizeof(graphMagic)) != 0) ||
+		!read(&version, sizeof(version)) || (version != graphVersion) ||
+		!read(&size, sizeof(size)) || (size != stamp.size) ||
+		!read(&modifiedTime, sizeof(modifiedTime)) || (modifiedTime != stamp.modifiedTime) ||
+		!read(&pathLength, sizeof(pathLength)) || (pathLength != stamp.absolutePath.size()) ||
+		(static_cast<size_t>(end - current) < pathLength) || (memcmp(current, stamp.absolutePath.data(), pathLength) != 0)
+	)
+	{
+		return false;
+	}
+	current += pathLength;
+
+	if (!read(&offsetCount, sizeof(offsetCount)) || !read(&neighborCount, sizeof(neighborCount)))
+	{
+		return false;
+	}
+	if (static_cast<size_t>(end - current) != (offsetCount * sizeof(uint32_t) + neighborCount * sizeof(int)))
+	{
+		LOG(LogLevel::Warning) << "Ignoring a damaged cached copy of adj.txt";
+		return false;
+	}
+	offsets.resize(offsetCount);
+	neighbors.resize(neighborCount);
+	read(offsets.data(), offsetCount * sizeof(uint32_t));
+	read(neighbors.data(), neighborCount * sizeof(int));
+
+	// GetNeighbors trusts the offsets, so they must start at zero, never go backwards and end at the last neighbour
+	bool offsetsValid = (offsetCount != 0) && (offsets.front() == 0) && (offsets.back() == neighborCount);
+	for (uint32_t i = 1; offsetsValid && (i < offsetCount); i++)
+	{
+		offsetsValid = (offsets[i - 1] <= offsets[i]);
+	}
+	if (!offsetsValid)
+	{
+		LOG(LogLevel::Warning) << "Ignoring a damaged cached copy of adj.txt";
+		offsets.clear();
+		neighbors.clear();
+		return false;
+	}
+
+	return true;
+}
+
+
+void provinceNeighborMapper::storeGraph(const string& path, const Utils::FileStamp& stamp) const
+{
+	const uint32_t pathLength		= static_cast<uint32_t>(stamp.absolutePath.size());
+	const uint32_t offsetCount		= static_cast<uint32_t>(offsets.size());
+	const uint32_t neighborCount	= static_cast<uint32_t>(neighbors.size());
+
+	string graph;	// the cached graph, laid out as loadGraph reads it
+	graph.append(graphMagic, sizeof(graphMagic));
+	graph.append(reinterpret_cast<const char*>(&graphVersion), sizeof(graphVersion));
+	graph.append(reinterpret_cast<const char*>(&stamp.size), sizeof(stamp.size));
+	graph.append(reinterpret_cast<const char*>(&stamp.modifiedTime), sizeof(stamp.modifiedTime));
+	graph.append(reinterpret_cast<const char*>(&pathLength), sizeof(pathLength));
+	graph.append(stamp.absolutePath.data(), pathLength);
+	graph.append(reinterpret_cast<const char*>(&offsetCount), sizeof(offsetCount));
+	graph.append(reinterpret_cast<const char*>(&neighborCount), sizeof(neighborCount));
+	graph.append(reinterpret_cast<const char*>(offsets.data()), offsetCount * sizeof(uint32_t));
+	graph.append(reinterpret_cast<const char*>(neighbors.data()), neighborCount * sizeof(int));
+
+	if (!Utils::WriteFileAtomically(path, graph))
+	{
+		LOG(LogLevel::Debug) << "Could not cache the province adjacencies";
+	}
+}
+
+
+provinceNeighbors provinceNeighborMapper::GetNeighbors(int province) const
+{
+	if ((province < 0) || (static_cast<size_t>(province) + 1 >= offsets.size()))
+	{
+		return provinceNeighbors(nullptr, nullptr);
+	}
+
+	const int* provinceNeighborsStart = neighbors.data();
+	return provinceNeighbors(provinceNeighborsStart + offsets[province], provinceNeighborsStart + offsets[province + 1]);
+}
@@ -0,0 +1,106 @@
+/*Copyright (c) 2016 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+
+#ifndef PROVINCE_NEIGHBOR_MAPPER_H_
+#define PROVINCE_NEIGHBOR_MAPPER_H_
+
+
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+using namespace std;
+
+
+
+namespace Utils
+{
+	struct FileStamp;
+}
+
+
+
+// The neighbours of one province. Points into the adjacency graph rather than holding a copy, and stays valid
+// for the whole run.
+class provinceNeighbors
+{
+	public:
+		provinceNeighbors(const int* _first, const int* _last): first(_first), last(_last) {}
+
+		const int*	begin() const	{ return first; }
+		const int*	end() const		{ return last; }
+		size_t		size() const	{ return last - first; }
+		bool			empty() const	{ return first == last; }
+
+	private:
+		const int*	first;	// the first neighbour
+		const int*	last;		// one past the last neighbour
+};
+
+
+// The HoI4 province adjacency graph from adj.txt, read once and shared by everything that needs neighbours. It is
+// kept in compressed sparse row form: one flat array with every province's neighbours, one province after
+// another, and an array of where each province's run starts, indexed by province number. Looking up a province
+// is a single index, and walking the neighbours of many provinces reads memory in order.
+//
+// When there is a parsed file cache the graph is also kept there in binary form, so later runs load it without
+// parsing adj.txt.
+class provinceNeighborMapper
+{
+	public:
+		static provinceNeighbors getNeighbors(int province)
+		{
+			return getInstance()->GetNeighbors(province);
+		}
+
+	private:
+		friend struct provinceNeighborMapperTests;	// stores and loads the cached graph directly
+
+		static provinceNeighborMapper* instance;
+		static provinceNeighborMapper* getInstance()
+		{
+			if (instance == NULL)
+			{
+				instance = new provinceNeighborMapper();
+			}
+
+			return instance;
+		}
+
+		provinceNeighborMapper();
+
+		void readAdjacencies(const char* data, size_t size);
+		bool loadGraph(const string& path, const Utils::FileStamp& stamp);
+		void storeGraph(const string& path, const Utils::FileStamp& stamp) const;
+
+		provinceNeighbors GetNeighbors(int province) const;
+
+		vector<uint32_t>	offsets;		// where each province's neighbours start in neighbors, with an extra entry marking the end of the last province's
+		vector<int>			neighbors;	// every province's neighbours, in province order
+};
+
+
+
+#endif // PROVINCE_NEIGHBOR_MAPPER_H_
@@ -22,8 +22,8 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 
 #include "StateMapper.h"
-#include "log.h"
-#include "..\Configuration.h"
+#include "Log.h"
+#include "../Configuration.h"
 #include "Object.h"
 #include "OSCompatibilityLayer.h"
 #include "ParadoxParser8859_15.h"
@@ -41,7 +41,7 @@ stateMapper::stateMapper()
 
 	for (auto itr: Configuration::getVic2Mods())
 	{
-		if (Utils::DoesFileExist(Configuration::getV2Path() + "/mod/" + itr + "/map/region.txt"))
+		if (Configuration::getVic2Files().layerHasFile(itr, "map/region.txt"))
 		{
 			Object* parsedMappingsFile = parser_8859_15::doParseFile((Configuration::getV2Path() + "/mod/" + itr + "/map/region.txt"));
 			if (parsedMappingsFile != NULL)
@@ -26,7 +26,9 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 
 
+#include <cstddef>
 #include <map>
+#include <string>
 #include <unordered_set>
 using namespace std;
 
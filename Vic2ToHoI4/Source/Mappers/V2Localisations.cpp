@@ -22,8 +22,9 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 
 #include "V2Localisations.h"
-#include <fstream>
+#include <algorithm>
 #include "../Configuration.h"
+#include "Encoding.h"
 #include "Log.h"
 #include "OSCompatibilityLayer.h"
 #include "Object.h"
@@ -62,19 +63,38 @@ void V2Localisations::ReadFromAllFilesInFolder(const string& folderPath)
 
 void V2Localisations::ReadFromFile(const string& fileName)
 {
-	ifstream in(fileName);
+	Utils::MappedFile file(fileName);
+	if (!file.isOpen())
+	{
+		return;
+	}
 
-	while (!in.eof())
+	// the files are in 8859-15, so the whole file is converted to UTF-8 at once rather than a string at a time
+	string contents(file.getData(), file.getSize());
+	replaceBadCharacters(contents);
+	string UTF8Contents;
+	Encoding::append8859_15AsUTF8(contents.data(), contents.data() + contents.size(), UTF8Contents);
+
+	size_t lineStart = 0;	// where the current line starts
+	while (lineStart < UTF8Contents.size())
 	{
-		string line;
-		getline(in, line);
+		size_t lineEnd = UTF8Contents.find('\n', lineStart);	// where the current line ends
+		if (lineEnd == string::npos)
+		{
+			lineEnd = UTF8Contents.size();
+		}
+
+		string line = UTF8Contents.substr(lineStart, lineEnd - lineStart);
+		if (!line.empty() && (line.back() == '\r'))
+		{
+			line.pop_back();
+		}
 		if (line[0] != '#')
 		{
 			processLine(line);
 		}
+		lineStart = lineEnd + 1;
 	}
-
-	in.close();
 }
 
 
@@ -86,9 +106,7 @@ void V2Localisations::processLine(string line)
 
 	for (auto language: languages)
 	{
-		string result = getNextLocalisation(line, division);
-		result = replaceBadCharacters(result);
-		localisations[key][language] = Utils::convert8859_15ToUTF8(result);
+		localisations[key][language] = getNextLocalisation(line, division);
 	}
 }
 
@@ -101,25 +119,13 @@ string V2Localisations::getNextLocalisation(string line, int& division)
 }
 
 
-string V2Localisations::replaceBadCharacters(string localisation)
+void V2Localisations::replaceBadCharacters(string& localisations)
 {
 	//  gets translated to an invalid character sequence. :-(
-	int O = localisation.find_first_of('');
-	while (O != string::npos)
-	{
-		localisation.replace(O, 1, "O");
-		O = localisation.find_first_of('');
-	}
+	replace(localisations.begin(), localisations.end(), '\xD6', 'O');
 
 	// dash characters other than 0x2D break HoI4
-	int dash = localisation.find_first_of('');
-	while (dash != string::npos)
-	{
-		localisation.replace(dash, 1, "-");
-		dash = localisation.find_first_of('');
-	}
-
-	return localisation;
+	replace(localisations.begin(), localisations.end(), '\x96', '-');
 }
 
 
@@ -61,7 +61,7 @@ class V2Localisations
 		void ReadFromFile(const string& fileName);
 		void processLine(string line);
 		string getNextLocalisation(string line, int& division);
-		string replaceBadCharacters(string localisation);
+		void replaceBadCharacters(string& localisations);
 
 		const string ActuallyGetTextInLanguage(const string& key, const string& language) const;
 		const map<string, string>& ActuallyGetTextInEachLanguage(const string& key) const;
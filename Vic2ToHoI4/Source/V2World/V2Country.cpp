@@ -255,6 +255,10 @@ void V2Country::readInGovernment(const Object* countryObj)
 void V2Country::readInUpperHouse(const Object* countryObj)
 {
 	auto upperHouseObjs = countryObj->getValue("upper_house");
+	if (upperHouseObjs.size() == 0)
+	{
+		return;
+	}
 	auto ideologyObjs = upperHouseObjs[0]->getLeaves();
 	for (auto ideologyObj: ideologyObjs)
 	{
@@ -43,10 +43,9 @@ string getInventionPath()
 {
 	for (auto mod: Configuration::getVic2Mods())
 	{
-		string possiblePath = Configuration::getV2Path() + "/mod/" + mod + "/inventions/";
-		if (Utils::doesFolderExist(possiblePath))
+		if (Configuration::getVic2Files().layerHasFolder(mod, "inventions"))
 		{
-			return possiblePath;
+			return Configuration::getV2Path() + "/mod/" + mod + "/inventions/";
 		}
 	}
 
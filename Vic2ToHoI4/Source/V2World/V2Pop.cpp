@@ -29,7 +29,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 V2Pop::V2Pop(Object *obj)
 {
-	type = obj->getKey();
+	type = Symbol(obj->getKey());
 
 	vector<Object*> childObj = obj->getValue("size");
 	if (childObj.size() > 0)
@@ -27,6 +27,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 
 #include <string>
+#include "Symbol.h"
 using namespace std;
 
 
@@ -40,12 +41,12 @@ class V2Pop
 		V2Pop(Object* obj);
 
 		int getSize() const { return size; }
-		string getType() const { return type; }
+		Symbol getType() const { return type; }
 		double getLiteracy() const { return literacy; }
 
 	private:
 		int size;
-		string type;
+		Symbol type;
 		double literacy;
 };
 
@@ -171,16 +171,16 @@ void V2Province::setCores(const map<string, V2Country*>& countries)
 
 int V2Province::getTotalPopulation() const
 {
-	return getPopulation("");
+	return getPopulation();
 }
 
 
-int V2Province::getPopulation(string type) const
+int V2Province::getPopulation(Symbol type) const
 {
 	int totalPopulation = 0;
 	for (auto pop: pops)
 	{
-		if (type == "" || type == pop->getType())
+		if (type.empty() || type == pop->getType())
 		{
 			totalPopulation += pop->getSize();
 		}
@@ -190,12 +190,12 @@ int V2Province::getPopulation(string type) const
 }
 
 
-int V2Province::getLiteracyWeightedPopulation(string type) const
+int V2Province::getLiteracyWeightedPopulation(Symbol type) const
 {
 	int totalPopulation = 0;
 	for (auto pop: pops)
 	{
-		if (type == "" || type == pop->getType())
+		if (type.empty() || type == pop->getType())
 		{
 			totalPopulation += calculateLiteracyWeightedPop(pop);
 		}
@@ -31,6 +31,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 #include <set>
 #include <string>
 #include <vector>
+#include "Symbol.h"
 using namespace std;
 
 
@@ -48,8 +49,8 @@ class V2Province
 		void setCores(const map<string, V2Country*>& countries);
 
 		int getTotalPopulation() const;
-		int getPopulation(string type = "") const;
-		int getLiteracyWeightedPopulation(string type = "") const;
+		int getPopulation(Symbol type = Symbol()) const;
+		int getLiteracyWeightedPopulation(Symbol type = Symbol()) const;
 
 		void setOwner(const V2Country* _owner) { owner = _owner; }
 		void addCoreString(string coreString) { coreStrings.insert(coreString); }
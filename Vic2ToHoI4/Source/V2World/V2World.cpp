@@ -23,6 +23,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 #include "V2World.h"
 #include <fstream>
+#include "ParadoxParser.h"
 #include "ParadoxParser8859_15.h"
 #include "Log.h"
 #include "OSCompatibilityLayer.h"
@@ -229,7 +230,10 @@ void V2World::readCountryFiles()
 
 	for (auto vic2Mod: Configuration::getVic2Mods())
 	{
-		if (processCountriesDotTxt(Configuration::getV2Path() + "/mod/" + vic2Mod + "/common/countries.txt", vic2Mod))
+		if (
+				Configuration::getVic2Files().layerHasFile(vic2Mod, "common/countries.txt") &&
+				processCountriesDotTxt(Configuration::getV2Path() + "/mod/" + vic2Mod + "/common/countries.txt", vic2Mod)
+			)
 		{
 			countriesDotTxtRead = true;
 		}
@@ -253,6 +257,8 @@ bool V2World::processCountriesDotTxt(string countryListFile, string mod)
 		return false;
 	}
 
+	vector<string> lines;			// the lines naming a country file
+	vector<string> countryFiles;	// the files to parse, one per line
 	while (!V2CountriesInput.eof())
 	{
 		string line;
@@ -262,17 +268,28 @@ bool V2World::processCountriesDotTxt(string countryListFile, string mod)
 			continue;
 		}
 
-		string countryFileName = extractCountryFileName(line);
-		Object* countryData = readCountryFile(countryFileName, mod);
+		lines.push_back(line);
+		countryFiles.push_back(findCountryFile(extractCountryFileName(line), mod));
+	}
+	V2CountriesInput.close();
+
+	vector<Object*> parsedCountries = ParadoxParser(ParserEncoding::ISO_8859_15).parseFiles(countryFiles);
+	for (unsigned int i = 0; i < lines.size(); i++)
+	{
+		Object* countryData = parsedCountries[i];
+		if (countryData == NULL)
+		{
+			// retry the slow way, which also logs why the file could not be read
+			countryData = readCountryFile(extractCountryFileName(lines[i]), mod);
+		}
 		if (countryData == NULL)
 		{
 			continue;
 		}
-		readCountryColor(countryData, line);
+		readCountryColor(countryData, lines[i]);
 		inputPartyInformation(countryData->getLeaves());
 	}
 
-	V2CountriesInput.close();
 	return true;
 }
 
@@ -294,13 +311,32 @@ string V2World::extractCountryFileName(string countryFileLine) const
 }
 
 
+string V2World::findCountryFile(string countryFileName, string mod) const
+{
+	if (mod != "")
+	{
+		if (Configuration::getVic2Files().layerHasFile(mod, "common/countries/" + countryFileName))
+		{
+			return Configuration::getV2Path() + "/mod/" + mod + "/common/countries/" + countryFileName;
+		}
+	}
+
+	if (Configuration::getVic2Files().layerHasFile("", "common/countries/" + countryFileName))
+	{
+		return Configuration::getV2Path() +  "/common/countries/" + countryFileName;
+	}
+
+	return "";
+}
+
+
 Object* V2World::readCountryFile(string countryFileName, string mod) const
 {
 	Object* countryData = NULL;
 	if (mod != "")
 	{
 		string file = Configuration::getV2Path() + "/mod/" + mod + "/common/countries/" + countryFileName;
-		if (Utils::DoesFileExist(file))
+		if (Configuration::getVic2Files().layerHasFile(mod, "common/countries/" + countryFileName))
 		{
 			countryData = parser_8859_15::doParseFile(file);
 			if (countryData == NULL)
@@ -312,7 +348,7 @@ Object* V2World::readCountryFile(string countryFileName, string mod) const
 	if (countryData == NULL)
 	{
 		string file = Configuration::getV2Path() +  "/common/countries/" + countryFileName;
-		if (Utils::DoesFileExist(file))
+		if (Configuration::getVic2Files().layerHasFile("", "common/countries/" + countryFileName))
 		{
 			countryData = parser_8859_15::doParseFile(file);
 			if (countryData == NULL)
@@ -79,6 +79,7 @@ class V2World
 		bool processCountriesDotTxt(string countryListFile, string mod);
 		bool shouldLineBeSkipped(string line) const;
 		string extractCountryFileName(string countryFileLine) const;
+		string findCountryFile(string countryFileName, string mod) const;
 		Object* readCountryFile(string countryFileName, string mod) const;
 		void readCountryColor(const Object* countryData, string line);
 		void inputPartyInformation(const vector<Object*>& leaves);
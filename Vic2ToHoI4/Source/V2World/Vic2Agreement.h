@@ -26,8 +26,8 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 
 
-#include "date.h"
-#include "object.h"
+#include "Date.h"
+#include "Object.h"
 #include <string>
 using namespace std;
 
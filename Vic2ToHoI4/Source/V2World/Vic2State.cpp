@@ -26,7 +26,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 #include "V2Province.h"
 #include "V2World.h"
 #include "../Mappers/StateMapper.h"
-#include "log.h"
+#include "Log.h"
 
 
 
@@ -110,14 +110,19 @@ void Vic2State::determineEmployedWorkers()
 
 workerStruct Vic2State::countEmployedWorkers()
 {
+	static const Symbol craftsmen("craftsmen");
+	static const Symbol clerks("clerks");
+	static const Symbol artisans("aristans");
+	static const Symbol capitalists("capitalists");
+
 	workerStruct workers;
 
 	for (auto province: provinces)
 	{
-		workers.craftsmen += province->getPopulation("craftsmen");
-		workers.clerks += province->getPopulation("clerks");
-		workers.artisans += province->getPopulation("aristans");
-		workers.capitalists += province->getLiteracyWeightedPopulation("capitalists");
+		workers.craftsmen += province->getPopulation(craftsmen);
+		workers.clerks += province->getPopulation(clerks);
+		workers.artisans += province->getPopulation(artisans);
+		workers.capitalists += province->getLiteracyWeightedPopulation(capitalists);
 	}
 
 	return workers;
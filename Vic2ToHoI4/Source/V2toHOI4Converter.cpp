@@ -26,10 +26,13 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 #include "Configuration.h"
 #include "Flags.h"
 #include "Log.h"
+#include "OutputWriter.h"
+#include "ParadoxParser.h"
 #include "ParadoxParser8859_15.h"
 #include "ParadoxParserUTF8.h"
+#include "Profiler.h"
 #include "HOI4World/HoI4Buildings.h"
-#include "HoI4World/HoI4World.h"
+#include "HOI4World/HoI4World.h"
 #include "V2World/V2World.h"
 #include "OSCompatibilityLayer.h"
 
@@ -42,6 +45,7 @@ int ConvertV2ToHoI4(const std::string& V2SaveFileName)
 	LOG(LogLevel::Info) << "Converter version 0.1";
 	Object*	obj;					// generic object
 
+	ProfilePhase phase("Reading configuration");	// times each stage of the conversion
 	Configuration::getInstance();
 
 	LOG(LogLevel::Debug) << "Current directory is " << Utils::getCurrentDirectory();
@@ -109,7 +113,7 @@ int ConvertV2ToHoI4(const std::string& V2SaveFileName)
 	}
 
 	//get output name
-	const int slash		= V2SaveFileName.find_last_of("\\");				// the last slash in the save's filename
+	const int slash		= V2SaveFileName.find_last_of("/\\");		// the last slash in the save's filename
 	string outputName		= V2SaveFileName.substr(slash + 1, V2SaveFileName.length());
 	const int length		= outputName.find_first_of(".");					// the first period after the slash
 	outputName				= outputName.substr(0, length);						// the name to use to output the mod
@@ -138,6 +142,7 @@ int ConvertV2ToHoI4(const std::string& V2SaveFileName)
 	}
 
 	// Parse government mapping
+	phase.next("Parsing mappings");
 	LOG(LogLevel::Info) << "Parsing governments mappings";
 	parser_UTF8::initParser();
 	obj = parser_UTF8::doParseFile("governmentMapping.txt");
@@ -152,7 +157,7 @@ int ConvertV2ToHoI4(const std::string& V2SaveFileName)
 	LOG(LogLevel::Info) << "Parsing governments reforms";
 	for (auto itr : vic2Mods)
 	{
-		if (Utils::DoesFileExist(Configuration::getV2Path() + "/mod/" + itr + "/common/issues.txt"))
+		if (Configuration::getVic2Files().layerHasFile(itr, "common/issues.txt"))
 		{
 			obj = parser_8859_15::doParseFile((Configuration::getV2Path() + "/mod/" + itr + "/common/issues.txt"));
 			if (obj != NULL)
@@ -171,11 +176,15 @@ int ConvertV2ToHoI4(const std::string& V2SaveFileName)
 		}
 	}
 
+	phase.next("Importing V2 save");
 	LOG(LogLevel::Info) << "* Importing V2 save *";
 
 	//	Parse V2 Save
+	ProfilePhase step("Parsing save");	// times each step within a stage
 	LOG(LogLevel::Info) << "Parsing save";
-	obj = parser_8859_15::doParseFile(V2SaveFileName);
+	ParadoxParser saveParser(ParserEncoding::ISO_8859_15);	// parses the save, which is only read once so is not cached
+	saveParser.setCache(nullptr);
+	obj = saveParser.parseFile(V2SaveFileName);
 	if (obj == NULL)
 	{
 		LOG(LogLevel::Error) << "Could not parse file " << V2SaveFileName << ". File is likely missing.";
@@ -183,10 +192,12 @@ int ConvertV2ToHoI4(const std::string& V2SaveFileName)
 	}
 
 	// Construct world from V2 save.
+	step.next("Building world");
 	LOG(LogLevel::Info) << "Building world";
 	V2World sourceWorld(obj);
 
 	// Merge nations
+	step.next("Merging nations");
 	LOG(LogLevel::Info) << "Merging nations";
 	obj = parser_UTF8::doParseFile("merge_nations.txt");
 	if (obj == NULL)
@@ -197,8 +208,10 @@ int ConvertV2ToHoI4(const std::string& V2SaveFileName)
 	mergeNations(sourceWorld, obj);
 
 	sourceWorld.checkAllProvincesMapped();
+	step.end();
 
 	// Parse HoI4 data files
+	phase.next("Importing HoI4 data");
 	LOG(LogLevel::Info) << "Parsing HoI4 data";
 	HoI4World destWorld(&sourceWorld);
 	map<int, vector<int>> HoI4DefaultStateToProvinceMap;
@@ -320,36 +333,49 @@ int ConvertV2ToHoI4(const std::string& V2SaveFileName)
 	//initLeaderBackgroundMap(obj->getLeaves()[0], landBackgroundMap, seaBackgroundMap);
 
 	// Convert
+	phase.next("Converting");
+	step.next("Converting states");
 	LOG(LogLevel::Info) << "Converting states";
 	theStates->convertStates();
 	destWorld.addStates(theStates);
 	destWorld.convertNavalBases();
+	step.next("Converting countries");
 	LOG(LogLevel::Info) << "Converting countries";
 	destWorld.convertCountries(leaderIDMap, governmentJobs, leaderTraits, namesMap, portraitMap, cultureMap, landPersonalityMap, seaPersonalityMap, landBackgroundMap, seaBackgroundMap);
 	theStates->addLocalisations();
+	step.next("Converting industry");
 	LOG(LogLevel::Info) << "Converting industry";
 	destWorld.convertIndustry();
 	destWorld.convertResources();
 	destWorld.convertSupplyZones(provinceToSupplyZoneMap);
 	destWorld.convertStrategicRegions();
+	step.next("Converting diplomacy");
 	LOG(LogLevel::Info) << "Converting diplomacy";
 	destWorld.convertDiplomacy();
+	step.next("Converting techs");
 	LOG(LogLevel::Info) << "Converting techs";
 	destWorld.convertTechs();
+	step.next("Setting up factions");
 	LOG(LogLevel::Info) << "Setting up factions";
 	destWorld.configureFactions();
+	step.next("Generating leaders");
 	LOG(LogLevel::Info) << "Generating Leaders";
 	destWorld.generateLeaders(leaderTraits, namesMap, portraitMap);
+	step.next("Converting armies and navies");
 	LOG(LogLevel::Info) << "Converting armies and navies";
 	destWorld.convertArmies();
 	destWorld.convertNavies();
 	destWorld.convertAirforces();
+	step.next("Adding bonuses to capitals");
 	LOG(LogLevel::Info) << "Adding bonuses to capitals";
 	destWorld.convertCapitalVPs();
+	step.next("Creating buildings");
 	LOG(LogLevel::Info) << "Creating buildings";
 	HoI4Buildings buildings(theStates->getProvinceToStateIDMap());
+	step.end();
 	
 	// Output results
+	phase.next("Outputting mod");
 	LOG(LogLevel::Info) << "Outputting mod";
 	if (!Utils::copyFolder("blankMod/output", "output/output"))
 	{
@@ -357,7 +383,7 @@ int ConvertV2ToHoI4(const std::string& V2SaveFileName)
 	}
 
 	FILE* modFile;	// the .mod file for this mod
-	if (fopen_s(&modFile, ("Output/" + Configuration::getOutputName() + ".mod").c_str(), "w") != 0)
+	if (fopen_s(&modFile, ("output/" + Configuration::getOutputName() + ".mod").c_str(), "w") != 0)
 	{
 		LOG(LogLevel::Error) << "Could not create .mod file";
 		exit(-1);
@@ -377,15 +403,31 @@ int ConvertV2ToHoI4(const std::string& V2SaveFileName)
 	}
 
 	destWorld.outputRelations();
+	step.next("Copying flags");
 	LOG(LogLevel::Info) << "Copying flags";
 	copyFlags(destWorld.getCountries());
-	//Utils::TryCopyFile("NeededFiles/gfx", "Output/" + Configuration::getOutputName());
+	//Utils::TryCopyFile("NeededFiles/gfx", "output/" + Configuration::getOutputName());
+	step.next("Outputting world");
 	LOG(LogLevel::Info) << "Outputting world";
 	destWorld.output();
 	buildings.output();
 
+	step.next("Creating wars");
 	destWorld.thatsgermanWarCreator(sourceWorld);
+	step.next("Finishing writing the mod");
+	if (!OutputWriter::getShared().finish())
+	{
+		LOG(LogLevel::Error) << "Could not write the mod";
+		exit(-1);
+	}
+	step.end();
+	phase.end();
+
 	LOG(LogLevel::Info) << "* Conversion complete *";
+	if (!Profiler::getInstance().writeReport("Vic2ToHoI4"))
+	{
+		LOG(LogLevel::Warning) << "Could not write the profiling report";
+	}
 	return 0;
 }
 
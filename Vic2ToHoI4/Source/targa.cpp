@@ -9,6 +9,10 @@
  * This code is provided without any warranty.  The copyright holder is
  * not liable for anything bad that might happen as a result of the
  * code.
+ *
+ * Modified for the Paradox Game Converters: added tga_read_from_memory(),
+ * which shares the reading code with tga_read_from_FILE() through
+ * tga_source.
  * -------------------------------------------------------------------------*/
 
 /*@unused@*/ static const char rcsid[] =
@@ -31,8 +35,20 @@ static const size_t tga_id_length = 26; /* tga_id + \0 */
 
 
 
+/* where an image is read from: a file if fp is set, otherwise the memory
+ * from data up to end */
+typedef struct
+{
+    FILE *fp;
+    const uint8_t *data;
+    const uint8_t *end;
+} tga_source;
+
 /* helpers */
-static tga_result tga_read_rle(tga_image *dest, FILE *fp);
+static int tga_source_read(tga_source *src, void *dest, const size_t size);
+static int tga_source_eof(const tga_source *src);
+static tga_result tga_read_from_source(tga_image *dest, tga_source *src);
+static tga_result tga_read_rle(tga_image *dest, tga_source *src);
 static tga_result tga_write_row_RLE(FILE *fp,
     const tga_image *src, const uint8_t *row);
 typedef enum { RAW, RLE } packet_type;
@@ -163,15 +179,73 @@ tga_result tga_read(tga_image *dest, const char *filename)
  *          valid.
  */
 tga_result tga_read_from_FILE(tga_image *dest, FILE *fp)
+{
+    tga_source src;
+    src.fp = fp;
+    src.data = NULL;
+    src.end = NULL;
+    return tga_read_from_source(dest, &src);
+}
+
+
+
+/* ---------------------------------------------------------------------------
+ * Read a Targa image from the <size> bytes at <data> to <dest>, for images
+ * that are already in memory, such as a mapped file.
+ *
+ * Returns: TGA_NOERR on success, or a TGAERR_* code on failure.  In the
+ *          case of failure, the contents of dest are not guaranteed to be
+ *          valid.
+ */
+tga_result tga_read_from_memory(tga_image *dest, const uint8_t *data,
+    const size_t size)
+{
+    tga_source src;
+    src.fp = NULL;
+    src.data = data;
+    src.end = data + size;
+    return tga_read_from_source(dest, &src);
+}
+
+
+
+/* ---------------------------------------------------------------------------
+ * Helper functions for reading.  Copy the next <size> bytes of <src> to
+ * <dest>, returning 0 if there aren't that many, and tell whether a read
+ * from <src> has already run past its end.  As with feof(), running out of
+ * memory is only noticed by the read that fails.
+ */
+static int tga_source_read(tga_source *src, void *dest, const size_t size)
+{
+    if (src->fp != NULL)
+        return fread(dest, size, 1, src->fp) == 1;
+
+    if ((size_t)(src->end - src->data) < size) return 0;
+    memcpy(dest, src->data, size);
+    src->data += size;
+    return 1;
+}
+
+static int tga_source_eof(const tga_source *src)
+{
+    return (src->fp != NULL) && feof(src->fp);
+}
+
+
+
+/* ---------------------------------------------------------------------------
+ * Helper function for tga_read_from_FILE() and tga_read_from_memory().
+ */
+static tga_result tga_read_from_source(tga_image *dest, tga_source *src)
 {
     #define BARF(errcode) \
         { tga_free_buffers(dest);  return errcode; }
 
     #define READ(destptr, size) \
-        if (fread(destptr, size, 1, fp) != 1) BARF(TGAERR_EOF)
+        if (!tga_source_read(src, destptr, size)) BARF(TGAERR_EOF)
 
     #define READ16(dest) \
-        { if (fread(&(dest), 2, 1, fp) != 1) BARF(TGAERR_EOF); \
+        { if (!tga_source_read(src, &(dest), 2)) BARF(TGAERR_EOF); \
           dest = letoh16(dest); }
 
     dest->image_id = NULL;
@@ -257,7 +331,7 @@ tga_result tga_read_from_FILE(tga_image *dest, FILE *fp)
     if (tga_is_rle(dest))
     {
         /* read RLE */
-        tga_result result = tga_read_rle(dest, fp);
+        tga_result result = tga_read_rle(dest, src);
         if (result != TGA_NOERR) BARF(result);
     }
     else
@@ -276,14 +350,14 @@ tga_result tga_read_from_FILE(tga_image *dest, FILE *fp)
 
 
 /* ---------------------------------------------------------------------------
- * Helper function for tga_read_from_FILE().  Decompresses RLE image data from
- * <fp>.  Assumes <dest> header fields are set correctly.
+ * Helper function for tga_read_from_source().  Decompresses RLE image data
+ * from <src>.  Assumes <dest> header fields are set correctly.
  */
-static tga_result tga_read_rle(tga_image *dest, FILE *fp)
+static tga_result tga_read_rle(tga_image *dest, tga_source *src)
 {
     #define RLE_BIT BIT(7)
     #define READ(dest, size) \
-        if (fread(dest, size, 1, fp) != 1) return TGAERR_EOF
+        if (!tga_source_read(src, dest, size)) return TGAERR_EOF
 
     uint8_t *pos;
     uint32_t p_loaded = 0,
@@ -292,7 +366,7 @@ static tga_result tga_read_rle(tga_image *dest, FILE *fp)
 
     pos = dest->image_data;
 
-    while ((p_loaded < p_expected) && !feof(fp))
+    while ((p_loaded < p_expected) && !tga_source_eof(src))
     {
         uint8_t b;
         READ(&b, 1);
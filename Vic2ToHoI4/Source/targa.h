@@ -12,6 +12,8 @@
  * This code is provided without any warranty.  The copyright holder is
  * not liable for anything bad that might happen as a result of the
  * code.
+ *
+ * Modified for the Paradox Game Converters: added tga_read_from_memory().
  * -------------------------------------------------------------------------*/
 
 #ifndef _TARGA_H_
@@ -143,6 +145,8 @@ const char *tga_error(const tga_result errcode);
 /* Load/save ---------------------------------------------------------------*/
 tga_result tga_read(tga_image *dest, const char *filename);
 tga_result tga_read_from_FILE(tga_image *dest, FILE *fp);
+tga_result tga_read_from_memory(tga_image *dest, const uint8_t *data,
+    const size_t size);
 tga_result tga_write(const char *filename, const tga_image *src);
 tga_result tga_write_to_FILE(FILE *fp, const tga_image *src);
 
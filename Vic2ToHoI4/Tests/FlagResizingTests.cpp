@@ -0,0 +1,182 @@
+/*Copyright (c) 2016 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+// Checks the flag resizing: the spans each resized pixel averages, that the SSE2 resize gives exactly what the
+// scalar one does, that the encoded flags are targas of the sizes HoI4 expects, and that they are written out
+// unchanged
+
+
+
+#define BOOST_TEST_MODULE FlagResizingTests
+#include <boost/test/included/unit_test.hpp>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include "FlagResizing.h"
+#include "OutputWriter.h"
+using namespace std;
+
+
+
+namespace
+{
+
+// the size of a Vic2 flag, and the sizes of the big, medium and small HoI4 ones
+const unsigned int sourceWidth = 93;
+const unsigned int sourceHeight = 64;
+const unsigned int flagWidths[] = { 82, 41, 10 };
+const unsigned int flagHeights[] = { 52, 26, 7 };
+
+// A flag of pseudo-random BGRA pixels, the same every run
+vector<uint8_t> makeFlag(unsigned int width, unsigned int height)
+{
+	vector<uint8_t> pixels(static_cast<size_t>(width) * height * 4);
+	uint32_t state = 12345;
+	for (auto& channel: pixels)
+	{
+		state = state * 1103515245 + 12345;
+		channel = static_cast<uint8_t>(state >> 24);
+	}
+	return pixels;
+}
+
+}
+
+
+
+BOOST_AUTO_TEST_CASE(resizeSpansCoverTheSourceOnce)
+{
+	// a line of three pixels made two: each new pixel is two thirds of its own old pixel and a third of the middle one
+	const vector<resizeSpan> spans = getResizeSpans(3, 2);
+	BOOST_REQUIRE_EQUAL(spans.size(), 2u);
+	BOOST_CHECK_EQUAL(spans[0].first, 0u);
+	BOOST_REQUIRE_EQUAL(spans[0].weights.size(), 2u);
+	BOOST_CHECK_CLOSE(spans[0].weights[0], 2.0f / 3.0f, 0.001);
+	BOOST_CHECK_CLOSE(spans[0].weights[1], 1.0f / 3.0f, 0.001);
+	BOOST_CHECK_EQUAL(spans[1].first, 1u);
+	BOOST_REQUIRE_EQUAL(spans[1].weights.size(), 2u);
+	BOOST_CHECK_CLOSE(spans[1].weights[0], 1.0f / 3.0f, 0.001);
+	BOOST_CHECK_CLOSE(spans[1].weights[1], 2.0f / 3.0f, 0.001);
+
+	// every span stays inside the source and its weights add up to one, shrinking or growing
+	const unsigned int lengths[][2] = { { 93, 82 }, { 93, 41 }, { 93, 10 }, { 64, 52 }, { 64, 26 }, { 64, 7 }, { 5, 10 } };
+	for (const auto& length: lengths)
+	{
+		const vector<resizeSpan> lengthSpans = getResizeSpans(length[0], length[1]);
+		BOOST_REQUIRE_EQUAL(lengthSpans.size(), length[1]);
+		for (const auto& span: lengthSpans)
+		{
+			BOOST_CHECK(!span.weights.empty());
+			BOOST_CHECK_LE(span.first + span.weights.size(), length[0]);
+			float total = 0.0f;
+			for (auto weight: span.weights)
+			{
+				total += weight;
+			}
+			BOOST_CHECK_SMALL(total - 1.0f, 0.0001f);
+		}
+	}
+}
+
+
+BOOST_AUTO_TEST_CASE(sse2AndScalarResizesAgree)
+{
+	const vector<uint8_t> source = makeFlag(sourceWidth, sourceHeight);
+	for (unsigned int size = 0; size < 3; size++)
+	{
+		vector<uint8_t> resized, resizedScalar;
+		resizeFlag(source, sourceWidth, sourceHeight, flagWidths[size], flagHeights[size], resized);
+		resizeFlagScalar(source, sourceWidth, sourceHeight, flagWidths[size], flagHeights[size], resizedScalar);
+		BOOST_REQUIRE_EQUAL(resized.size(), static_cast<size_t>(flagWidths[size]) * flagHeights[size] * 4);
+		BOOST_CHECK(resized == resizedScalar);
+	}
+
+	// a flag of one colour stays that colour
+	vector<uint8_t> plain(static_cast<size_t>(sourceWidth) * sourceHeight * 4);
+	for (size_t i = 0; i < plain.size(); i += 4)
+	{
+		const uint8_t pixel[4] = { 10, 20, 30, 255 };
+		memcpy(&plain[i], pixel, sizeof(pixel));
+	}
+	vector<uint8_t> resizedPlain;
+	resizeFlag(plain, sourceWidth, sourceHeight, flagWidths[2], flagHeights[2], resizedPlain);
+	BOOST_CHECK(resizedPlain == vector<uint8_t>(plain.begin(), plain.begin() + resizedPlain.size()));
+}
+
+
+BOOST_AUTO_TEST_CASE(encodedFlagsAreTargasOfTheHoI4Sizes)
+{
+	const vector<uint8_t> source = makeFlag(sourceWidth, sourceHeight);
+	for (unsigned int size = 0; size < 3; size++)
+	{
+		const unsigned int width = flagWidths[size];
+		const unsigned int height = flagHeights[size];
+		vector<uint8_t> pixels;
+		resizeFlag(source, sourceWidth, sourceHeight, width, height, pixels);
+		const string flag = encodeFlag(pixels, width, height);
+
+		// an uncompressed 32 bit BGR image with eight bits of alpha, then the pixels and the targa 2 footer
+		BOOST_REQUIRE_EQUAL(flag.size(), 18 + pixels.size() + 26);
+		const uint8_t* header = reinterpret_cast<const uint8_t*>(flag.data());
+		BOOST_CHECK_EQUAL(header[1], TGA_COLOR_MAP_ABSENT);
+		BOOST_CHECK_EQUAL(header[2], TGA_IMAGE_TYPE_BGR);
+		BOOST_CHECK_EQUAL(header[12] | (header[13] << 8), static_cast<int>(width));
+		BOOST_CHECK_EQUAL(header[14] | (header[15] << 8), static_cast<int>(height));
+		BOOST_CHECK_EQUAL(header[16], 32);
+		BOOST_CHECK_EQUAL(header[17], 8);
+		BOOST_CHECK(memcmp(flag.data() + 18, pixels.data(), pixels.size()) == 0);
+		BOOST_CHECK_EQUAL(flag.substr(flag.size() - 18), string("TRUEVISION-XFILE.", 18));
+
+		// and the targa reader gives back the same pixels
+		tga_image decoded;
+		BOOST_REQUIRE_EQUAL(tga_read_from_memory(&decoded, header, flag.size()), TGA_NOERR);
+		vector<uint8_t> decodedPixels;
+		BOOST_CHECK(getFlagPixels(&decoded, decodedPixels));
+		BOOST_CHECK(decodedPixels == pixels);
+		tga_free_buffers(&decoded);
+
+		// a flag cut short isn't read
+		BOOST_CHECK_EQUAL(tga_read_from_memory(&decoded, header, 18 + pixels.size() / 2), TGAERR_EOF);
+	}
+}
+
+
+BOOST_AUTO_TEST_CASE(writtenFlagsAreByteForByte)
+{
+	// line feeds in the header and pixels, which a file written as text would turn into CR LF on Windows
+	vector<uint8_t> pixels(static_cast<size_t>(flagWidths[0]) * 0x0A * 4, 0x0A);
+	pixels[1] = 0x0D;
+	const string flag = encodeFlag(pixels, flagWidths[0], 0x0A);
+	BOOST_REQUIRE(flag.find('\n') != string::npos);
+
+	OutputWriter writer(1);
+	writer.writeBinary("writtenFlag.tga", string(flag));
+	BOOST_REQUIRE(writer.finish());
+
+	ifstream written("writtenFlag.tga", ios::binary);
+	BOOST_CHECK(string(istreambuf_iterator<char>(written), istreambuf_iterator<char>()) == flag);
+}
@@ -0,0 +1,156 @@
+/*Copyright (c) 2016 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+// Checks that the cached province adjacency graph loads back as it was stored, and that a damaged one is refused
+// rather than handing out neighbours from outside the graph
+
+
+
+#define BOOST_TEST_MODULE ProvinceNeighborMapperTests
+#include <boost/test/included/unit_test.hpp>
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+#include "OSCompatibilityLayer.h"
+#include "ProvinceNeighborMapper.h"
+using namespace std;
+
+
+
+// Reaches the mapper's private parts. The mapper reads adj.txt from the working folder, which the tests write first.
+struct provinceNeighborMapperTests
+{
+	static unique_ptr<provinceNeighborMapper> read(const string& adjacencies)
+	{
+		ofstream("adj.txt", ios::binary) << adjacencies;
+		return unique_ptr<provinceNeighborMapper>(new provinceNeighborMapper());
+	}
+
+	static void store(const provinceNeighborMapper& mapper, const string& path, const Utils::FileStamp& stamp)
+	{
+		mapper.storeGraph(path, stamp);
+	}
+
+	static bool load(provinceNeighborMapper& mapper, const string& path, const Utils::FileStamp& stamp)
+	{
+		mapper.offsets.clear();
+		mapper.neighbors.clear();
+		return mapper.loadGraph(path, stamp);
+	}
+
+	static const vector<uint32_t>&	offsets(const provinceNeighborMapper& mapper)	{ return mapper.offsets; }
+	static const vector<int>&			neighbors(const provinceNeighborMapper& mapper)	{ return mapper.neighbors; }
+	static provinceNeighbors			neighborsOf(const provinceNeighborMapper& mapper, int province)	{ return mapper.GetNeighbors(province); }
+};
+
+
+namespace
+{
+
+// province 4 has no line, so its neighbours are an empty run between provinces 3 and 5
+const string adjacencies =
+	"0;0;0;0;0;\n"
+	"1;0;230;81;119;2;3;\n"
+	"2;0;0;0;55;1;\n"
+	"3;0;0;0;205;1;5;\n"
+	"5;0;0;0;1;3;\n";
+
+string readFile(const string& path)
+{
+	ifstream file(path, ios::binary);
+	return string(istreambuf_iterator<char>(file), istreambuf_iterator<char>());
+}
+
+void writeFile(const string& path, const string& contents)
+{
+	ofstream(path, ios::binary) << contents;
+}
+
+// Replaces the offset at index in a stored graph, which ends with the offsets followed by the neighbours
+string withOffset(string graph, size_t offsetCount, size_t neighborCount, size_t index, uint32_t offset)
+{
+	const size_t position = graph.size() - (offsetCount * sizeof(uint32_t) + neighborCount * sizeof(int)) + index * sizeof(uint32_t);
+	graph.replace(position, sizeof(offset), reinterpret_cast<const char*>(&offset), sizeof(offset));
+	return graph;
+}
+
+}
+
+
+
+BOOST_AUTO_TEST_CASE(storedGraphLoadsBackUnchanged)
+{
+	unique_ptr<provinceNeighborMapper> stored = provinceNeighborMapperTests::read(adjacencies);
+	Utils::FileStamp stamp;
+	BOOST_REQUIRE(Utils::GetFileStamp("adj.txt", stamp));
+	provinceNeighborMapperTests::store(*stored, "roundTrip.graph", stamp);
+
+	unique_ptr<provinceNeighborMapper> loaded = provinceNeighborMapperTests::read(adjacencies);
+	BOOST_REQUIRE(provinceNeighborMapperTests::load(*loaded, "roundTrip.graph", stamp));
+	BOOST_CHECK(provinceNeighborMapperTests::offsets(*loaded) == provinceNeighborMapperTests::offsets(*stored));
+	BOOST_CHECK(provinceNeighborMapperTests::neighbors(*loaded) == provinceNeighborMapperTests::neighbors(*stored));
+
+	const provinceNeighbors neighbors = provinceNeighborMapperTests::neighborsOf(*loaded, 3);
+	BOOST_CHECK(vector<int>(neighbors.begin(), neighbors.end()) == vector<int>({ 1, 5 }));
+	BOOST_CHECK(provinceNeighborMapperTests::neighborsOf(*loaded, 4).empty());
+	BOOST_CHECK(provinceNeighborMapperTests::neighborsOf(*loaded, 6).empty());
+}
+
+
+BOOST_AUTO_TEST_CASE(damagedGraphsAreRefused)
+{
+	unique_ptr<provinceNeighborMapper> mapper = provinceNeighborMapperTests::read(adjacencies);
+	Utils::FileStamp stamp;
+	BOOST_REQUIRE(Utils::GetFileStamp("adj.txt", stamp));
+	provinceNeighborMapperTests::store(*mapper, "damaged.graph", stamp);
+
+	const string graph = readFile("damaged.graph");
+	const size_t offsetCount = provinceNeighborMapperTests::offsets(*mapper).size();
+	const size_t neighborCount = provinceNeighborMapperTests::neighbors(*mapper).size();
+	BOOST_REQUIRE_EQUAL(offsetCount, 7u);
+	BOOST_REQUIRE_EQUAL(neighborCount, 6u);
+
+	const vector<string> damagedGraphs = {
+		withOffset(graph, offsetCount, neighborCount, 0, 1),					// not starting at zero
+		withOffset(graph, offsetCount, neighborCount, 2, 6),					// going backwards from province 2 to 3
+		withOffset(graph, offsetCount, neighborCount, offsetCount - 1, 5),	// not ending at the last neighbour
+		graph.substr(0, graph.size() - 1)												// cut short
+	};
+	for (const auto& damagedGraph: damagedGraphs)
+	{
+		writeFile("damaged.graph", damagedGraph);
+		BOOST_CHECK(!provinceNeighborMapperTests::load(*mapper, "damaged.graph", stamp));
+		BOOST_CHECK(provinceNeighborMapperTests::offsets(*mapper).empty());
+		BOOST_CHECK(provinceNeighborMapperTests::neighbors(*mapper).empty());
+	}
+
+	// and a stamp that no longer matches adj.txt is refused too
+	writeFile("damaged.graph", graph);
+	Utils::FileStamp changedStamp = stamp;
+	changedStamp.size++;
+	BOOST_CHECK(!provinceNeighborMapperTests::load(*mapper, "damaged.graph", changedStamp));
+	BOOST_CHECK(provinceNeighborMapperTests::load(*mapper, "damaged.graph", stamp));
+}
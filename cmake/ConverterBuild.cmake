@@ -0,0 +1,183 @@
+# The compiler settings, build types and helper functions every converter's CMakeLists.txt shares.
+
+
+
+set(CMAKE_CXX_STANDARD 14)
+set(CMAKE_CXX_STANDARD_REQUIRED ON)
+set(CMAKE_CXX_EXTENSIONS OFF)
+
+set(THREADS_PREFER_PTHREAD_FLAG ON)
+find_package(Threads REQUIRED)
+find_package(Boost 1.55 REQUIRED COMPONENTS filesystem system)
+
+get_filename_component(CONVERTERS_ROOT "${CMAKE_CURRENT_LIST_DIR}/.." ABSOLUTE)
+
+
+
+# Build types
+set(CONVERTERS_BUILD_TYPES Release RelWithDebInfo Debug LTO PGOInstrument PGOOptimize)
+if (CMAKE_CONFIGURATION_TYPES)
+	set(CMAKE_CONFIGURATION_TYPES ${CONVERTERS_BUILD_TYPES} CACHE STRING "" FORCE)
+elseif (NOT CMAKE_BUILD_TYPE)
+	set(CMAKE_BUILD_TYPE Release CACHE STRING "" FORCE)
+endif()
+set_property(CACHE CMAKE_BUILD_TYPE PROPERTY STRINGS ${CONVERTERS_BUILD_TYPES})
+
+set(CONVERTERS_PGO_PROFILE_DIR "${CMAKE_BINARY_DIR}/pgo-profile" CACHE PATH
+	"Where PGOInstrument builds record their profile, and where PGOOptimize builds read it from")
+
+# Counting allocations replaces the global operator new, which slows every allocation a little, so it is off unless
+# asked for
+option(CONVERTERS_PROFILE_ALLOCATIONS "Count allocations in the profiling report each converter writes" OFF)
+if (CONVERTERS_PROFILE_ALLOCATIONS)
+	add_compile_definitions(PROFILE_ALLOCATIONS)
+endif()
+
+if (MSVC)
+	# Visual Studio builds use the solutions, which have their own settings; these just keep CMake working there
+	set(CONVERTERS_PGO_GENERATE_FLAGS "")
+	set(CONVERTERS_PGO_USE_FLAGS "")
+	add_definitions(-D_CRT_SECURE_NO_WARNINGS -DNOMINMAX)
+elseif (CMAKE_CXX_COMPILER_ID MATCHES "Clang")
+	# clang writes raw profiles, which llvm-profdata must merge before they can be used; see pgo-merge below
+	set(CONVERTERS_PGO_GENERATE_FLAGS "-fprofile-generate=${CONVERTERS_PGO_PROFILE_DIR}")
+	set(CONVERTERS_PGO_USE_FLAGS "-fprofile-use=${CONVERTERS_PGO_PROFILE_DIR}/converters.profdata -Wno-profile-instr-unprofiled")
+else()
+	set(CONVERTERS_PGO_GENERATE_FLAGS "-fprofile-generate -fprofile-dir=${CONVERTERS_PGO_PROFILE_DIR} -fprofile-update=atomic")
+	set(CONVERTERS_PGO_USE_FLAGS "-fprofile-use -fprofile-dir=${CONVERTERS_PGO_PROFILE_DIR} -fprofile-correction -Wno-missing-profile")
+endif()
+
+if (CMAKE_CXX_COMPILER_ID STREQUAL "GNU")
+	# the sources are Windows-1252, as Visual Studio reads them; passing their bytes straight through keeps the
+	# few non-ASCII identifiers compiling and leaves non-ASCII string literals byte-for-byte as they are there
+	add_compile_options(-finput-charset=ISO-8859-1 -fexec-charset=ISO-8859-1)
+elseif (CMAKE_CXX_COMPILER_ID MATCHES "Clang")
+	add_compile_options(-Wno-invalid-source-encoding)
+endif()
+if (NOT MSVC)
+	# frame pointers let perf record call stacks without DWARF unwinding
+	set(CMAKE_CXX_FLAGS_RELWITHDEBINFO "-O2 -g -fno-omit-frame-pointer -DNDEBUG" CACHE STRING "" FORCE)
+endif()
+foreach (type LTO PGOINSTRUMENT PGOOPTIMIZE)
+	set(CMAKE_EXE_LINKER_FLAGS_${type} "${CMAKE_EXE_LINKER_FLAGS_RELEASE}" CACHE STRING "")
+	set(CMAKE_STATIC_LINKER_FLAGS_${type} "${CMAKE_STATIC_LINKER_FLAGS_RELEASE}" CACHE STRING "")
+endforeach()
+set(CMAKE_CXX_FLAGS_LTO "${CMAKE_CXX_FLAGS_RELEASE}" CACHE STRING "")
+set(CMAKE_CXX_FLAGS_PGOINSTRUMENT "${CMAKE_CXX_FLAGS_RELEASE} ${CONVERTERS_PGO_GENERATE_FLAGS}" CACHE STRING "")
+set(CMAKE_CXX_FLAGS_PGOOPTIMIZE "${CMAKE_CXX_FLAGS_RELEASE} ${CONVERTERS_PGO_USE_FLAGS}" CACHE STRING "")
+set(CMAKE_EXE_LINKER_FLAGS_PGOINSTRUMENT "${CMAKE_EXE_LINKER_FLAGS_RELEASE} ${CONVERTERS_PGO_GENERATE_FLAGS}" CACHE STRING "" FORCE)
+set(CMAKE_EXE_LINKER_FLAGS_PGOOPTIMIZE "${CMAKE_EXE_LINKER_FLAGS_RELEASE} ${CONVERTERS_PGO_USE_FLAGS}" CACHE STRING "" FORCE)
+
+include(CheckIPOSupported)
+check_ipo_supported(RESULT CONVERTERS_IPO_SUPPORTED OUTPUT CONVERTERS_IPO_OUTPUT LANGUAGES CXX)
+if (CONVERTERS_IPO_SUPPORTED)
+	set(CMAKE_INTERPROCEDURAL_OPTIMIZATION_LTO ON)
+	set(CMAKE_INTERPROCEDURAL_OPTIMIZATION_PGOINSTRUMENT ON)
+	set(CMAKE_INTERPROCEDURAL_OPTIMIZATION_PGOOPTIMIZE ON)
+else()
+	message(STATUS "Link-time optimization is not supported here, so LTO and PGO builds won't use it")
+endif()
+
+if (CMAKE_CXX_COMPILER_ID MATCHES "Clang")
+	find_program(CONVERTERS_LLVM_PROFDATA NAMES llvm-profdata)
+	add_custom_target(pgo-merge
+		COMMAND "${CONVERTERS_LLVM_PROFDATA}" merge -output=converters.profdata *.profraw
+		WORKING_DIRECTORY "${CONVERTERS_PGO_PROFILE_DIR}"
+		COMMENT "Merging the recorded profiles for a PGOOptimize build")
+endif()
+
+# runs every converter's benchmark, then zips up what they collected, as run_benchmarks.bat does
+add_custom_target(benchmark
+	COMMAND ${CMAKE_COMMAND} -E tar cf benchmark-results.zip --format=zip benchmark-results
+	WORKING_DIRECTORY "${CMAKE_BINARY_DIR}"
+	COMMENT "Zipping the benchmark results into ${CMAKE_BINARY_DIR}/benchmark-results.zip")
+
+
+
+# Adds a converter executable built from the given sources, linked with CommonItems and staged in
+# <build folder>/<converter folder>/Release along with the contents of the converter's data folders, as
+# Copy_Files.bat does for the Visual Studio builds.
+#
+# STANDALONE is for the older converters that carry their own copies of the common code (the log, dates, objects
+# and parser): they are built from their own sources alone, plus whichever common_items files they list, and
+# only get Boost and threads from CommonItems' dependencies.
+#
+#	add_converter(<target> [STANDALONE] OUTPUT_NAME <executable name> DATA_FILES <data folders...>
+#		[FOLDERS <empty folders to create...>] SOURCES <sources...>)
+function(add_converter target)
+	cmake_parse_arguments(CONVERTER "STANDALONE" "OUTPUT_NAME" "DATA_FILES;FOLDERS;SOURCES" ${ARGN})
+
+	add_executable(${target} ${CONVERTER_SOURCES})
+	set(runFolder "${CMAKE_CURRENT_BINARY_DIR}/Release")
+	set_target_properties(${target} PROPERTIES
+		OUTPUT_NAME "${CONVERTER_OUTPUT_NAME}"
+		RUNTIME_OUTPUT_DIRECTORY "${runFolder}")
+	foreach (type ${CONVERTERS_BUILD_TYPES})
+		string(TOUPPER ${type} upperType)
+		set_target_properties(${target} PROPERTIES RUNTIME_OUTPUT_DIRECTORY_${upperType} "${runFolder}")
+	endforeach()
+	target_include_directories(${target} PRIVATE "${CMAKE_CURRENT_SOURCE_DIR}/Source")
+	if (CONVERTER_STANDALONE)
+		target_link_libraries(${target} PRIVATE Boost::boost Boost::filesystem Boost::system Threads::Threads)
+	else()
+		target_link_libraries(${target} PRIVATE CommonItems)
+	endif()
+
+	foreach (dataFolder ${CONVERTER_DATA_FILES})
+		add_custom_command(TARGET ${target} POST_BUILD
+			COMMAND ${CMAKE_COMMAND} -E copy_directory "${dataFolder}" "${runFolder}"
+			COMMENT "Copying the ${target} data files from ${dataFolder}")
+	endforeach()
+	foreach (folder ${CONVERTER_FOLDERS})
+		add_custom_command(TARGET ${target} POST_BUILD
+			COMMAND ${CMAKE_COMMAND} -E make_directory "${runFolder}/${folder}")
+	endforeach()
+endfunction()
+
+
+
+# Adds a benchmark-<target> target that generates synthetic saves at each of CONVERTERS_BENCHMARK_SCALES and runs
+# the converter on each one. Every run gets its own copy of the converter's staged folder in
+# <build folder>/benchmark-work, with REMOVE_FOLDERS deleted from it and the generated install and data files copied
+# over it, so the staged folder itself is never touched. Each run's log and profile are collected in
+# <build folder>/benchmark-results/<scale>.
+#
+#	add_converter_benchmark(<target> SAVE <save, relative to the generator's output> GENERATED_FILES <folder, relative to the generator's output>
+#		[REMOVE_FOLDERS <staged folders the generated files replace outright...>])
+set(CONVERTERS_BENCHMARK_SCALES "1;4;16" CACHE STRING "The synthetic save scales the benchmark targets run at")
+function(add_converter_benchmark target)
+	cmake_parse_arguments(BENCHMARK "" "SAVE;GENERATED_FILES" "REMOVE_FOLDERS" ${ARGN})
+	string(REPLACE ";" "," scales "${CONVERTERS_BENCHMARK_SCALES}")
+	string(REPLACE ";" "," removeFolders "${BENCHMARK_REMOVE_FOLDERS}")
+
+	add_custom_target(benchmark-${target}
+		COMMAND ${CMAKE_COMMAND}
+			"-DGENERATOR=$<TARGET_FILE:SaveGenerator>"
+			"-DCONVERTER=$<TARGET_FILE:${target}>"
+			"-DCONVERTER_NAME=${target}"
+			"-DSAVE=${BENCHMARK_SAVE}"
+			"-DGENERATED_FILES=${BENCHMARK_GENERATED_FILES}"
+			"-DSCALES=${scales}"
+			"-DREMOVE_FOLDERS=${removeFolders}"
+			"-DWORK_FOLDER=${CMAKE_BINARY_DIR}/benchmark-work"
+			"-DRESULTS_FOLDER=${CMAKE_BINARY_DIR}/benchmark-results"
+			-P "${CONVERTERS_ROOT}/cmake/RunBenchmark.cmake"
+		DEPENDS ${target} SaveGenerator
+		USES_TERMINAL
+		COMMENT "Benchmarking ${target}")
+	add_dependencies(benchmark benchmark-${target})
+endfunction()
+
+
+
+# Adds a unit test executable and registers it with CTest. Tests use the header-only form of Boost.Test, so they
+# need no Boost libraries beyond the ones the converters already link.
+#
+#	add_converter_test(<target> SOURCES <sources...> [LIBRARIES <libraries...>])
+function(add_converter_test target)
+	cmake_parse_arguments(TEST "" "" "SOURCES;LIBRARIES" ${ARGN})
+
+	add_executable(${target} ${TEST_SOURCES})
+	target_link_libraries(${target} PRIVATE ${TEST_LIBRARIES})
+	add_test(NAME ${target} COMMAND ${target} WORKING_DIRECTORY "${CMAKE_CURRENT_BINARY_DIR}")
+endfunction()
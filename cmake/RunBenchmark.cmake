@@ -0,0 +1,57 @@
+# Runs one converter on synthetic saves of several sizes. Invoked by the benchmark-<converter> targets as
+#
+#	cmake -DGENERATOR=... -DCONVERTER=... -DCONVERTER_NAME=... -DSAVE=... -DGENERATED_FILES=... -DSCALES=1,4,16
+#		[-DREMOVE_FOLDERS=...,...] -DWORK_FOLDER=... -DRESULTS_FOLDER=... -P RunBenchmark.cmake
+#
+# The converter is run in a copy of the folder its executable was staged in under WORK_FOLDER, with REMOVE_FOLDERS
+# deleted from the copy and the generator's files for it copied over the top, so that the generated configuration
+# and data files are the only ones it reads. The staged folder itself is never written to.
+
+cmake_minimum_required(VERSION 3.12)
+
+get_filename_component(stagedFolder "${CONVERTER}" DIRECTORY)
+get_filename_component(converterFile "${CONVERTER}" NAME)
+string(REPLACE "," ";" SCALES "${SCALES}")
+string(REPLACE "," ";" REMOVE_FOLDERS "${REMOVE_FOLDERS}")
+file(MAKE_DIRECTORY "${WORK_FOLDER}")
+
+foreach (scale ${SCALES})
+	set(generated "${WORK_FOLDER}/synthetic-${scale}")
+	if (NOT EXISTS "${generated}/${SAVE}")
+		message(STATUS "Generating the scale ${scale} saves")
+		execute_process(COMMAND "${GENERATOR}" "${generated}" ${scale} RESULT_VARIABLE result)
+		if (NOT result EQUAL 0)
+			message(FATAL_ERROR "The save generator failed at scale ${scale}")
+		endif()
+	endif()
+
+	set(runFolder "${WORK_FOLDER}/${CONVERTER_NAME}-${scale}")
+	file(REMOVE_RECURSE "${runFolder}")
+	file(COPY "${stagedFolder}/" DESTINATION "${runFolder}")
+	foreach (folder ${REMOVE_FOLDERS})
+		file(REMOVE_RECURSE "${runFolder}/${folder}")
+	endforeach()
+	file(COPY "${generated}/${GENERATED_FILES}/" DESTINATION "${runFolder}")
+
+	message(STATUS "Timing ${CONVERTER_NAME} at scale ${scale}")
+	string(TIMESTAMP startTime "%s")
+	execute_process(COMMAND "${runFolder}/${converterFile}" "${generated}/${SAVE}"
+		WORKING_DIRECTORY "${runFolder}"
+		RESULT_VARIABLE result)
+	string(TIMESTAMP endTime "%s")
+	math(EXPR elapsed "${endTime} - ${startTime}")
+
+	set(results "${RESULTS_FOLDER}/${scale}")
+	file(MAKE_DIRECTORY "${results}")
+	foreach (output log.txt profile.csv profile.json)
+		if (EXISTS "${runFolder}/${output}")
+			configure_file("${runFolder}/${output}" "${results}/${CONVERTER_NAME}-${output}" COPYONLY)
+		endif()
+	endforeach()
+	if (NOT result EQUAL 0)
+		message(FATAL_ERROR "${CONVERTER_NAME} failed at scale ${scale} (${result}); see ${results}/${CONVERTER_NAME}-log.txt")
+	endif()
+	message(STATUS "${CONVERTER_NAME} converted the scale ${scale} save in about ${elapsed} s; its profile is in ${results}")
+
+	file(REMOVE_RECURSE "${runFolder}")
+endforeach()
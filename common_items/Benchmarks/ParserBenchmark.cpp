@@ -0,0 +1,164 @@
+/*Copyright (c) 2016 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+
+// Times the tokenizer and Spirit parser backends against each other on a single file, and the
+// tokenizer on one thread against the tokenizer on the shared thread pool. Checks that all of them
+// build the same tree. Also times reading the file as events without building a tree at all.
+//
+// Usage: ParserBenchmark <file> [iterations] [utf8|8859_15]
+
+
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include "../Object.h"
+#include "../ParadoxParser.h"
+#include "../ParadoxParserUTF8.h"
+#include "../ParadoxParser8859_15.h"
+using namespace std;
+
+
+
+Object* parse(const string& filename, bool is8859_15, ParserBackend backend, bool parallel = false)
+{
+	if (is8859_15)
+	{
+		parser_8859_15::setBackend(backend);
+		parser_8859_15::setParallelParsing(parallel);
+		return parser_8859_15::doParseFile(filename);
+	}
+	else
+	{
+		parser_UTF8::setBackend(backend);
+		parser_UTF8::setParallelParsing(parallel);
+		return parser_UTF8::doParseFile(filename);
+	}
+}
+
+
+double timeParse(const string& filename, bool is8859_15, ParserBackend backend, int iterations, bool parallel = false)
+{
+	double bestTime = 0.0;	// the fastest parse, in seconds
+	for (int i = 0; i < iterations; i++)
+	{
+		auto start = chrono::steady_clock::now();	// when this parse started
+		Object* obj = parse(filename, is8859_15, backend, parallel);
+		chrono::duration<double> elapsed = chrono::steady_clock::now() - start;	// how long this parse took
+		delete obj;
+
+		if ((i == 0) || (elapsed.count() < bestTime))
+		{
+			bestTime = elapsed.count();
+		}
+	}
+	return bestTime;
+}
+
+
+double timeEvents(const string& filename, bool is8859_15, int iterations)
+{
+	ParadoxParser parser(is8859_15 ? ParserEncoding::ISO_8859_15 : ParserEncoding::UTF8);	// reads the file as events
+	double bestTime = 0.0;	// the fastest read, in seconds
+	for (int i = 0; i < iterations; i++)
+	{
+		ParadoxEventHandler handler;	// reads everything and ignores it
+		auto start = chrono::steady_clock::now();	// when this read started
+		parser.streamFile(filename, handler);
+		chrono::duration<double> elapsed = chrono::steady_clock::now() - start;	// how long this read took
+
+		if ((i == 0) || (elapsed.count() < bestTime))
+		{
+			bestTime = elapsed.count();
+		}
+	}
+	return bestTime;
+}
+
+
+bool sameTree(Object* lhs, Object* rhs, const string& path)
+{
+	if (lhs->getKey() != rhs->getKey() || lhs->isLeaf() != rhs->isLeaf() || lhs->getLeaf() != rhs->getLeaf() || lhs->getTokens() != rhs->getTokens())
+	{
+		cout << "Trees differ at " << path << "\n";
+		return false;
+	}
+
+	vector<Object*> lhsChildren = lhs->getLeaves();	// the children of the left-hand object
+	vector<Object*> rhsChildren = rhs->getLeaves();	// the children of the right-hand object
+	if (lhsChildren.size() != rhsChildren.size())
+	{
+		cout << "Trees differ in the number of children at " << path << "\n";
+		return false;
+	}
+	for (unsigned int i = 0; i < lhsChildren.size(); i++)
+	{
+		if (!sameTree(lhsChildren[i], rhsChildren[i], path + "/" + lhsChildren[i]->getKey()))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+
+int main(int argc, char* argv[])
+{
+	if (argc < 2)
+	{
+		cout << "Usage: ParserBenchmark <file> [iterations] [utf8|8859_15]\n";
+		return 1;
+	}
+	const string filename	= argv[1];
+	const int iterations		= (argc > 2) ? atoi(argv[2]) : 3;
+	const bool is8859_15		= (argc > 3) && (string(argv[3]) == "8859_15");
+
+	Object* spiritTree		= parse(filename, is8859_15, ParserBackend::Spirit);
+	Object* tokenizerTree	= parse(filename, is8859_15, ParserBackend::Tokenizer);
+	Object* parallelTree		= parse(filename, is8859_15, ParserBackend::Tokenizer, true);
+	if ((spiritTree == nullptr) || (tokenizerTree == nullptr) || (parallelTree == nullptr))
+	{
+		cout << "Could not open " << filename << "\n";
+		return 1;
+	}
+	const bool treesMatch = sameTree(spiritTree, tokenizerTree, "") && sameTree(tokenizerTree, parallelTree, "");
+	delete spiritTree;
+	delete tokenizerTree;
+	delete parallelTree;
+
+	const double spiritTime		= timeParse(filename, is8859_15, ParserBackend::Spirit, iterations);
+	const double tokenizerTime	= timeParse(filename, is8859_15, ParserBackend::Tokenizer, iterations);
+	const double parallelTime	= timeParse(filename, is8859_15, ParserBackend::Tokenizer, iterations, true);
+	const double eventsTime		= timeEvents(filename, is8859_15, iterations);
+
+	cout << "Spirit:             " << spiritTime << " s\n";
+	cout << "Tokenizer:          " << tokenizerTime << " s\n";
+	cout << "Tokenizer, pooled:  " << parallelTime << " s\n";
+	cout << "Events, no tree:    " << eventsTime << " s\n";
+	cout << "Speedup:            " << spiritTime / tokenizerTime << "x, " << spiritTime / parallelTime << "x pooled\n";
+	cout << "Trees " << (treesMatch ? "match" : "differ") << "\n";
+
+	return treesMatch ? 0 : 2;
+}
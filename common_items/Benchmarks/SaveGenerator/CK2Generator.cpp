@@ -0,0 +1,542 @@
+/*Copyright (c) 2016 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+
+#include "CK2Generator.h"
+#include <algorithm>
+#include "GeneratorOutput.h"
+#include "../../OSCompatibilityLayer.h"
+
+
+
+static const char* traits[] = { "diligent", "brave", "just", "ambitious", "content", "gregarious" };
+static const char* EU3TradeGoods[] = { "grain", "wine", "wool", "cloth", "fish", "fur", "salt", "naval_supplies", "copper", "iron" };
+static const char* EU3TechCategories[] = { "government", "production", "trade", "naval", "land" };
+
+
+CK2Generator::CK2Generator(const SyntheticWorld& _world, const string& _outputFolder):
+	world(_world),
+	outputFolder(_outputFolder),
+	installFolder(_outputFolder + "/CK2"),
+	EU3Folder(_outputFolder + "/EU3"),
+	random(_world.getSeed() + 4)
+{
+}
+
+
+void CK2Generator::generate()
+{
+	outputCK2Common();
+	outputLandedTitles();
+	Utils::TryCreateFolder(outputFolder + "/CK2Mods");
+
+	outputSave();
+
+	outputEU3Install();
+	outputMappings();
+	outputConfiguration();
+}
+
+
+string CK2Generator::getKingdom(int countryIndex) const
+{
+	string tag = world.getCountries()[countryIndex].tag;
+	transform(tag.begin(), tag.end(), tag.begin(), ::tolower);
+	return "k_" + tag;
+}
+
+
+string CK2Generator::getDuchy(int stateIndex) const
+{
+	return "d_state" + to_string(world.getStates()[stateIndex].id);
+}
+
+
+string CK2Generator::getCounty(int provinceNum) const
+{
+	return "c_province" + to_string(provinceNum);
+}
+
+
+string CK2Generator::getBarony(int provinceNum) const
+{
+	return "b_province" + to_string(provinceNum);
+}
+
+
+int CK2Generator::getDuke(int stateIndex) const
+{
+	// kings are characters 1 up, one per country, and the dukes follow them, one per state
+	const SyntheticState& state = world.getStates()[stateIndex];
+	int capitalState = world.getProvince(world.getCountries()[state.owner].capital).state;
+	if (capitalState == stateIndex)
+	{
+		return state.owner + 1;
+	}
+	else
+	{
+		return world.getCountries().size() + stateIndex + 1;
+	}
+}
+
+
+void CK2Generator::outputCK2Common()
+{
+	ofstream opinionModifiers;
+	openOutputFile(installFolder, "common/opinion_modifiers.txt", opinionModifiers);
+	opinionModifiers << "opinion_synthetic = {\n\topinion = 10\n\tmonths = 120\n}\n";
+
+	ofstream buildings;
+	openOutputFile(installFolder, "common/buildings.txt", buildings);
+	buildings << "castle = {\n}\n";
+
+	ofstream traitsFile;
+	openOutputFile(installFolder, "common/traits.txt", traitsFile);
+	for (auto trait: traits)
+	{
+		traitsFile << trait << " = {\n";
+		traitsFile << "\tdiplomacy = " << random.between(0, 2) << "\n";
+		traitsFile << "\tstewardship = " << random.between(0, 2) << "\n";
+		traitsFile << "\tmartial = " << random.between(0, 2) << "\n";
+		traitsFile << "}\n";
+	}
+
+	ofstream dynasties;
+	openOutputFile(installFolder, "common/dynasties.txt", dynasties);
+	for (unsigned int i = 0; i < world.getCountries().size(); i++)
+	{
+		const SyntheticCountry& country = world.getCountries()[i];
+		dynasties << i + 1 << " = {\n";
+		dynasties << "\tname = \"" << country.tag << "ing\"\n";
+		dynasties << "\tculture = " << world.getCultures()[country.culture].name << "\n";
+		dynasties << "}\n";
+	}
+
+	ofstream religions;
+	openOutputFile(installFolder, "common/religion.txt", religions);
+	for (auto group: world.getReligionGroups())
+	{
+		religions << group << " = {\n";
+		for (auto religion: world.getReligions())
+		{
+			if (religion.group == group)
+			{
+				religions << '\t' << religion.name << " = {\n";
+				religions << "\t\tcolor = { " << religion.color[0] / 255.0 << ' ' << religion.color[1] / 255.0 << ' ' << religion.color[2] / 255.0 << " }\n";
+				religions << "\t\ticon = 1\n";
+				religions << "\t}\n";
+			}
+		}
+		religions << "}\n";
+	}
+
+	ofstream cultures;
+	openOutputFile(installFolder, "common/cultures.txt", cultures);
+	for (auto group: world.getCultureGroups())
+	{
+		cultures << group << " = {\n";
+		for (auto culture: world.getCultures())
+		{
+			if (culture.group == group)
+			{
+				cultures << '\t' << culture.name << " = {\n";
+				cultures << "\t\tcolor = { 0.5 0.5 0.5 }\n";
+				cultures << "\t\tmale_names = { Adam Bertil Carl }\n";
+				cultures << "\t\tfemale_names = { Anna Berit Cecilia }\n";
+				cultures << "\t}\n";
+			}
+		}
+		cultures << "}\n";
+	}
+
+	Utils::TryCreateFolder(installFolder + "/localisation");
+}
+
+
+void CK2Generator::outputLandedTitles()
+{
+	ofstream titles;
+	openOutputFile(installFolder, "common/landed_titles.txt", titles);
+	for (unsigned int i = 0; i < world.getCountries().size(); i++)
+	{
+		const SyntheticCountry& country = world.getCountries()[i];
+		titles << getKingdom(i) << " = {\n";
+		titles << "\tcolor = { " << country.color[0] << ' ' << country.color[1] << ' ' << country.color[2] << " }\n";
+		titles << "\tcapital = " << country.capital << "\n";
+		for (auto stateIndex: country.states)
+		{
+			titles << '\t' << getDuchy(stateIndex) << " = {\n";
+			titles << "\t\tcolor = { " << country.color[0] << ' ' << country.color[1] << ' ' << country.color[2] << " }\n";
+			for (auto province: world.getStates()[stateIndex].provinces)
+			{
+				titles << "\t\t" << getCounty(province) << " = {\n";
+				titles << "\t\t\tcolor = { " << country.color[0] << ' ' << country.color[1] << ' ' << country.color[2] << " }\n";
+				titles << "\t\t\t" << getBarony(province) << " = {\n\t\t\t}\n";
+				titles << "\t\t}\n";
+			}
+			titles << "\t}\n";
+		}
+		titles << "}\n";
+	}
+}
+
+
+void CK2Generator::outputSave()
+{
+	const vector<SyntheticCountry>& countries = world.getCountries();
+	const vector<SyntheticState>& states = world.getStates();
+
+	ofstream save;
+	openOutputFile(outputFolder, "saves/synthetic.ck2", save);
+	save << "CK2txt\n";
+	save << "version=\"2.2\"\n";
+	save << "date=\"1453.1.1\"\n";
+	save << "player=\n{\n\tid=1\n\ttype=45\n}\n";
+
+	save << "dynasties=\n{\n";
+	for (unsigned int i = 0; i < countries.size(); i++)
+	{
+		save << '\t' << i + 1 << "=\n\t{\n";
+		save << "\t\tname=\"" << countries[i].tag << "ing\"\n";
+		save << "\t\tculture=\"" << world.getCultures()[countries[i].culture].name << "\"\n";
+		save << "\t}\n";
+	}
+	save << "}\n";
+
+	save << "character=\n{\n";
+	for (unsigned int i = 0; i < countries.size(); i++)
+	{
+		outputSaveCharacter(save, i + 1, i, getBarony(countries[i].capital), getKingdom(i));
+	}
+	for (unsigned int i = 0; i < states.size(); i++)
+	{
+		if (getDuke(i) != states[i].owner + 1)
+		{
+			outputSaveCharacter(save, getDuke(i), states[i].owner, getBarony(states[i].provinces[0]), getDuchy(i));
+		}
+	}
+	save << "}\n";
+
+	save << "title=\n{\n";
+	for (unsigned int i = 0; i < countries.size(); i++)
+	{
+		outputSaveTitle(save, getKingdom(i), i + 1, "", "");
+	}
+	for (unsigned int i = 0; i < states.size(); i++)
+	{
+		int duke = getDuke(i);
+		string kingdom = getKingdom(states[i].owner);
+		outputSaveTitle(save, getDuchy(i), duke, (duke == states[i].owner + 1) ? "" : kingdom, kingdom);
+		for (auto province: states[i].provinces)
+		{
+			outputSaveTitle(save, getCounty(province), duke, (duke == states[i].owner + 1) ? "" : getDuchy(i), getDuchy(i));
+			outputSaveTitle(save, getBarony(province), duke, "", getCounty(province));
+		}
+	}
+	save << "}\n";
+
+	save << "provinces=\n{\n";
+	for (int i = 1; i <= world.getLandProvinceCount(); i++)
+	{
+		const SyntheticProvince& province = world.getProvince(i);
+		save << '\t' << i << "=\n\t{\n";
+		save << "\t\tname=\"Province" << i << "\"\n";
+		save << "\t\tculture=" << world.getCultures()[province.culture].name << "\n";
+		save << "\t\treligion=" << world.getReligions()[province.religion].name << "\n";
+		save << "\t\tmax_settlements=1\n";
+		save << "\t\ttechnology=\n\t\t{\n\t\t\ttech_levels={";
+		for (int j = 0; j < 24; j++)
+		{
+			save << ' ' << random.between(0, 30) / 10.0;
+		}
+		save << " }\n\t\t}\n";
+		save << "\t\t" << getBarony(i) << "=\n\t\t{\n";
+		save << "\t\t\ttype=castle\n";
+		save << "\t\t\tlevy=\n\t\t\t{\n";
+		for (auto troopType: { "light_infantry", "heavy_infantry", "pikemen", "light_cavalry", "knights", "archers" })
+		{
+			int troops = random.between(20, 200);
+			save << "\t\t\t\t" << troopType << "=\n\t\t\t\t{\n" << troops << ".000 " << troops << ".000\n\t\t\t\t}\n";
+		}
+		save << "\t\t\t}\n";
+		save << "\t\t}\n";
+		save << "\t}\n";
+	}
+	save << "}\n";
+}
+
+
+void CK2Generator::outputSaveCharacter(ofstream& save, int id, int countryIndex, const string& capital, const string& primaryTitle)
+{
+	const SyntheticCountry& country = world.getCountries()[countryIndex];
+
+	save << '\t' << id << "=\n\t{\n";
+	save << "\t\tbirth_name=\"Ruler" << id << "\"\n";
+	save << "\t\tbirth_date=" << random.between(1400, 1430) << ".1.1\n";
+	save << "\t\tprestige=" << random.between(0, 2000) << ".000\n";
+	save << "\t\tpiety=" << random.between(0, 500) << ".000\n";
+	save << "\t\tdynasty=" << countryIndex + 1 << "\n";
+	save << "\t\treligion=\"" << world.getReligions()[country.religion].name << "\"\n";
+	save << "\t\tculture=\"" << world.getCultures()[country.culture].name << "\"\n";
+	save << "\t\tattributes=\n\t\t{\n";
+	for (int i = 0; i < 5; i++)
+	{
+		save << random.between(2, 15) << ' ';
+	}
+	save << "\n\t\t}\n";
+	save << "\t\ttraits=\n\t\t{\n" << random.between(1, sizeof(traits) / sizeof(traits[0])) << "\n\t\t}\n";
+	save << "\t\tdemesne=\n\t\t{\n";
+	save << "\t\t\tcapital=\"" << capital << "\"\n";
+	save << "\t\t\tprimary=\n\t\t\t{\n\t\t\t\ttitle=\"" << primaryTitle << "\"\n\t\t\t}\n";
+	save << "\t\t}\n";
+	save << "\t}\n";
+}
+
+
+void CK2Generator::outputSaveTitle(ofstream& save, const string& title, int holder, const string& liege, const string& deJureLiege)
+{
+	save << '\t' << title << "=\n\t{\n";
+	save << "\t\tholder=" << holder << "\n";
+	save << "\t\tsuccession=primogeniture\n";
+	save << "\t\tgender=agnatic\n";
+	if (title.substr(0, 2) == "k_")
+	{
+		save << "\t\tlaw=centralization_" << random.between(0, 4) << "\n";
+		save << "\t\tlaw=feudal_contract_" << random.between(0, 2) << "\n";
+	}
+	if (!liege.empty())
+	{
+		save << "\t\tliege=\n\t\t{\n\t\t\ttitle=\"" << liege << "\"\n\t\t}\n";
+	}
+	if (!deJureLiege.empty())
+	{
+		save << "\t\tde_jure_liege=\"" << deJureLiege << "\"\n";
+	}
+	save << "\t}\n";
+}
+
+
+void CK2Generator::outputEU3Install()
+{
+	ofstream technology;
+	openOutputFile(EU3Folder, "common/technology.txt", technology);
+	technology << "groups = {\n";
+	for (auto group: { "western", "eastern", "ottoman", "muslim" })
+	{
+		technology << '\t' << group << " = {\n\t\tstart_level = 3\n\t\tmodifier = 0.5\n\t}\n";
+	}
+	technology << "}\n";
+
+	for (auto category: EU3TechCategories)
+	{
+		ofstream techs;
+		openOutputFile(EU3Folder, string("common/technologies/") + category + ".txt", techs);
+		for (int i = 0; i <= 60; i++)
+		{
+			techs << "technology = {\n\tid = " << i << "\n\taverage_year = " << 1399 + i * 7 << "\n}\n";
+		}
+	}
+
+	ofstream cultures;
+	openOutputFile(EU3Folder, "common/cultures.txt", cultures);
+	for (auto group: world.getCultureGroups())
+	{
+		cultures << group << " = {\n";
+		for (auto culture: world.getCultures())
+		{
+			if (culture.group == group)
+			{
+				cultures << '\t' << culture.name << " = {\n\t\tmale_names = { Adam }\n\t\tfemale_names = { Anna }\n\t\tdynasty_names = { Ahl }\n\t}\n";
+			}
+		}
+		cultures << "}\n";
+	}
+
+	ofstream religions;
+	openOutputFile(EU3Folder, "common/religion.txt", religions);
+	for (auto group: world.getReligionGroups())
+	{
+		religions << group << " = {\n";
+		for (auto religion: world.getReligions())
+		{
+			if (religion.group == group)
+			{
+				religions << '\t' << religion.name << " = {\n\t\tcolor = { 0.5 0.5 0.5 }\n\t}\n";
+			}
+		}
+		religions << "}\n";
+	}
+
+	ofstream prices;
+	openOutputFile(EU3Folder, "common/Prices.txt", prices);
+	for (auto good: EU3TradeGoods)
+	{
+		prices << good << " = {\n\tbase_price = " << random.between(2, 8) << "\n\tsupply = {\n\t}\n\tdemand = {\n\t}\n}\n";
+	}
+
+	ofstream continents;
+	openOutputFile(EU3Folder, "map/continent.txt", continents);
+	for (auto continent: { "europe", "asia" })
+	{
+		continents << continent << " = {\n\t";
+		for (int i = 1; i <= world.getLandProvinceCount(); i++)
+		{
+			if (world.getContinent(i) == continent)
+			{
+				continents << i << ' ';
+			}
+		}
+		continents << "\n}\n";
+	}
+
+	ofstream positions;
+	openOutputFile(EU3Folder, "map/positions.txt", positions);
+	for (int i = 1; i <= world.getLandProvinceCount(); i++)
+	{
+		const SyntheticProvince& province = world.getProvince(i);
+		positions << i << " = {\n";
+		positions << "\tunit = { x = " << province.x * 10 << ".000 y = " << province.y * 10 << ".000 }\n";
+		if (province.coastal)
+		{
+			positions << "\tport = { x = " << province.x * 10 + 5 << ".000 y = " << province.y * 10 + 5 << ".000 }\n";
+		}
+		positions << "}\n";
+	}
+
+	writeBinaryAdjacencies(world, EU3Folder, "map/cache/adjacencies.bin", 6);
+
+	for (int i = 1; i <= world.getLandProvinceCount(); i++)
+	{
+		const SyntheticProvince& province = world.getProvince(i);
+		ofstream history;
+		openOutputFile(EU3Folder, "history/provinces/" + to_string(i) + " - Province" + to_string(i) + ".txt", history);
+		history << "owner = " << world.getCountries()[province.owner].tag << "\n";
+		history << "controller = " << world.getCountries()[province.owner].tag << "\n";
+		history << "add_core = " << world.getCountries()[province.owner].tag << "\n";
+		history << "culture = " << world.getCultures()[province.culture].name << "\n";
+		history << "religion = " << world.getReligions()[province.religion].name << "\n";
+		history << "base_tax = " << random.between(1, 12) << "\n";
+		history << "manpower = " << random.between(1, 6) << "\n";
+		history << "citysize = " << province.population / 4 << "\n";
+		history << "trade_goods = " << EU3TradeGoods[random.between(0, sizeof(EU3TradeGoods) / sizeof(EU3TradeGoods[0]) - 1)] << "\n";
+	}
+
+	for (auto country: world.getCountries())
+	{
+		ofstream history;
+		openOutputFile(EU3Folder, "history/countries/" + country.tag + " - " + country.name + ".txt", history);
+		history << "government = feudal_monarchy\n";
+		history << "technology_group = western\n";
+		history << "primary_culture = " << world.getCultures()[country.culture].name << "\n";
+		history << "religion = " << world.getReligions()[country.religion].name << "\n";
+		history << "capital = " << country.capital << "\n";
+	}
+
+	Utils::TryCreateFolder(EU3Folder + "/history/advisors");
+}
+
+
+void CK2Generator::outputMappings()
+{
+	string converterFolder = outputFolder + "/CK2ToEU3";
+
+	ofstream provinceMappings;
+	openOutputFile(converterFolder, "province_mappings.txt", provinceMappings);
+	provinceMappings << "v2.2 = {\n";
+	for (int i = 1; i <= world.getLandProvinceCount(); i++)
+	{
+		provinceMappings << "\tlink = { ck2 = " << i << " eu3 = " << i << " }\n";
+	}
+	provinceMappings << "}\n";
+
+	ofstream countryMappings;
+	openOutputFile(converterFolder, "country_mappings.txt", countryMappings);
+	countryMappings << "mappings = {\n";
+	for (unsigned int i = 0; i < world.getCountries().size(); i++)
+	{
+		countryMappings << "\tlink = { CK2 = " << getKingdom(i) << " EU3 = " << world.getCountries()[i].tag << " }\n";
+	}
+	countryMappings << "}\n";
+
+	ofstream cultureMappings;
+	openOutputFile(converterFolder, "culture_mappings.txt", cultureMappings);
+	cultureMappings << "mappings = {\n";
+	for (auto culture: world.getCultures())
+	{
+		cultureMappings << "\tlink = { ck2 = " << culture.name << " eu3 = " << culture.name << " }\n";
+	}
+	cultureMappings << "}\n";
+
+	ofstream religionMappings;
+	openOutputFile(converterFolder, "religion_mappings.txt", religionMappings);
+	religionMappings << "religionMap = {\n";
+	for (auto religion: world.getReligions())
+	{
+		religionMappings << "\tlink = { ck2 = " << religion.name << " eu3 = " << religion.name << " }\n";
+	}
+	religionMappings << "}\n";
+
+	ofstream blockedNations;
+	openOutputFile(converterFolder, "blocked_nations.txt", blockedNations);
+	blockedNations << "blocked = {\n\teu3 = REB\n\teu3 = PIR\n\teu3 = NAT\n}\n";
+}
+
+
+void CK2Generator::outputConfiguration()
+{
+	ofstream configuration;
+	openOutputFile(outputFolder + "/CK2ToEU3", "configuration.txt", configuration);
+	configuration << "configuration =\n";
+	configuration << "{\n";
+	configuration << "\tEU3directory = \"" << EU3Folder << "\"\n";
+	configuration << "\tCK2directory = \"" << installFolder << "\"\n";
+	configuration << "\tCK2ModPath = \"" << outputFolder << "/CK2Mods\"\n";
+	configuration << "\tuseConverterMod = \"no\"\n";
+	configuration << "\tCK2Mod = \"\"\n";
+	configuration << "\ttechGroupMethod = \"learningRate\"\n";
+	configuration << "\tproxyMultiplierMethod = \"ones\"\n";
+	configuration << "\tmultipleProvsMethod = \"average\"\n";
+	configuration << "\tmanpower = \"historical\"\n";
+	configuration << "\tmanpowerblendamount = \"0.5\"\n";
+	configuration << "\tbasetax = \"historical\"\n";
+	configuration << "\tbasetaxblendamount = \"0.5\"\n";
+	configuration << "\tpopulation = \"historical\"\n";
+	configuration << "\tpopulationblendamount = \"0.9\"\n";
+	configuration << "\tHRETitle = \"e_hre\"\n";
+	configuration << "\tmergeTitles = \"inheritance\"\n";
+	configuration << "\tvassalScore = \"1800\"\n";
+	configuration << "\tadvisors = \"normal\"\n";
+	configuration << "\tleaders = \"normal\"\n";
+	configuration << "\tcolonists = \"normal\"\n";
+	configuration << "\tmerchants = \"normal\"\n";
+	configuration << "\tmissionaries = \"normal\"\n";
+	configuration << "\tinflation = \"normal\"\n";
+	configuration << "\tcolonist_size = \"normal\"\n";
+	configuration << "\tdifficulty = \"normal\"\n";
+	configuration << "\tAI_aggressiveness = \"normal\"\n";
+	configuration << "\tland_spread = \"normal (50)\"\n";
+	configuration << "\tsea_spread = \"normal (50)\"\n";
+	configuration << "\tspies = \"normal\"\n";
+	configuration << "\tlucky_nations = \"historical\"\n";
+	configuration << "}\n";
+}
@@ -0,0 +1,80 @@
+/*Copyright (c) 2016 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+
+#ifndef CK2_GENERATOR_H_
+#define CK2_GENERATOR_H_
+
+
+
+#include <fstream>
+#include <string>
+#include "SyntheticWorld.h"
+using namespace std;
+
+
+
+// Writes the parts of a CK2 install that CK2ToEU3 reads, a save of the synthetic world, the matching parts
+// of an EU3 install, and the CK2ToEU3 mapping files that link the two. Each country becomes a CK2 kingdom,
+// each state a duchy, and each province a county with a single barony. A king holds the duchy holding the
+// kingdom's capital and dukes hold the rest:
+//		<output>/CK2/						the install
+//		<output>/CK2Mods/					an empty mod folder
+//		<output>/EU3/						the EU3 install
+//		<output>/saves/synthetic.ck2
+//		<output>/CK2ToEU3/				files to copy over the converter's own, including its configuration.txt
+class CK2Generator
+{
+	public:
+		CK2Generator(const SyntheticWorld& world, const string& outputFolder);
+
+		void generate();
+
+	private:
+		void	outputCK2Common();
+		void	outputLandedTitles();
+
+		void	outputSave();
+		void	outputSaveCharacter(ofstream& save, int id, int countryIndex, const string& capital, const string& primaryTitle);
+		void	outputSaveTitle(ofstream& save, const string& title, int holder, const string& liege, const string& deJureLiege);
+
+		void	outputEU3Install();
+		void	outputMappings();
+		void	outputConfiguration();
+
+		string	getKingdom(int countryIndex) const;
+		string	getDuchy(int stateIndex) const;
+		string	getCounty(int provinceNum) const;
+		string	getBarony(int provinceNum) const;
+		int		getDuke(int stateIndex) const;
+
+		const SyntheticWorld&	world;				// the world to write out
+		string						outputFolder;		// where to write everything
+		string						installFolder;		// where to write the CK2 install
+		string						EU3Folder;			// where to write the EU3 install
+		SyntheticRandom			random;				// the source of the save's randomness
+};
+
+
+
+#endif // CK2_GENERATOR_H_
@@ -0,0 +1,511 @@
+/*Copyright (c) 2016 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+
+#include "EU4Generator.h"
+#include "GeneratorOutput.h"
+#include "../../OSCompatibilityLayer.h"
+
+
+
+// the unit file for each of EU4toV2's regiment categories
+static const char* unitTypes[][2] = {
+	{ "synthetic_infantry",		"infantry" },
+	{ "synthetic_cavalry",		"cavalry" },
+	{ "synthetic_artillery",	"artillery" },
+	{ "synthetic_heavy_ship",	"heavy_ship" },
+	{ "synthetic_light_ship",	"light_ship" },
+	{ "synthetic_galley",		"galley" },
+	{ "synthetic_transport",	"transport" }
+};
+
+static const char* tradeGoods[] = {
+	"grain", "wine", "wool", "cloth", "fish", "fur", "salt", "naval_supplies", "copper", "iron", "tea", "chinaware",
+	"spices", "coffee", "cotton", "sugar", "tobacco", "dyes", "silk", "gold"
+};
+
+static const char* buildings[] = {
+	"temple", "workshop", "marketplace", "courthouse", "dock", "shipyard", "barracks", "fort1", "university"
+};
+
+static const char* governments[] = {
+	"feudal_monarchy", "despotic_monarchy", "administrative_monarchy", "merchant_republic", "noble_republic",
+	"theocratic_government"
+};
+
+static const char* ideaGroups[] = {
+	"administrative_ideas", "economic_ideas", "trade_ideas", "offensive_ideas", "defensive_ideas", "quality_ideas",
+	"quantity_ideas", "maritime_ideas", "religious_ideas", "innovativeness_ideas"
+};
+
+
+EU4Generator::EU4Generator(const SyntheticWorld& _world, const string& _outputFolder):
+	world(_world),
+	outputFolder(_outputFolder),
+	installFolder(_outputFolder + "/EU4"),
+	random(_world.getSeed() + 1),
+	nextLeaderID(1)
+{
+}
+
+
+void EU4Generator::generate()
+{
+	outputDefinitions();
+	outputAreasAndRegions();
+	outputContinents();
+	outputCountryTags();
+	outputCultures();
+	outputReligions();
+	outputUnits();
+	outputColonialRegions();
+	outputLocalisation();
+
+	outputSave();
+
+	outputMappings();
+	outputConfiguration();
+}
+
+
+void EU4Generator::outputDefinitions()
+{
+	ofstream definitions;
+	openOutputFile(installFolder, "map/definition.csv", definitions);
+	definitions << "province;red;green;blue;x;x\n";
+	for (auto province: world.getProvinces())
+	{
+		definitions << province.id << ';' << province.id % 256 << ';' << (province.id / 256) % 256 << ';' << province.id / 65536;
+		definitions << ";Province" << province.id << ";x\n";
+	}
+}
+
+
+void EU4Generator::outputAreasAndRegions()
+{
+	ofstream areas;
+	openOutputFile(installFolder, "map/area.txt", areas);
+	for (auto state: world.getStates())
+	{
+		areas << "area_" << state.id << " = {\n\t";
+		for (auto province: state.provinces)
+		{
+			areas << province << ' ';
+		}
+		areas << "\n}\n";
+	}
+
+	ofstream regions;
+	openOutputFile(installFolder, "map/region.txt", regions);
+	for (auto country: world.getCountries())
+	{
+		regions << "region_" << country.tag << " = {\n";
+		regions << "\tareas = {\n\t\t";
+		for (auto stateIndex: country.states)
+		{
+			regions << "area_" << world.getStates()[stateIndex].id << ' ';
+		}
+		regions << "\n\t}\n";
+		regions << "}\n";
+	}
+}
+
+
+void EU4Generator::outputContinents()
+{
+	ofstream continents;
+	openOutputFile(installFolder, "map/continent.txt", continents);
+	for (auto continent: { "europe", "asia" })
+	{
+		continents << continent << " = {\n\t";
+		for (int i = 1; i <= world.getLandProvinceCount(); i++)
+		{
+			if (world.getContinent(i) == continent)
+			{
+				continents << i << ' ';
+			}
+		}
+		continents << "\n}\n";
+	}
+}
+
+
+void EU4Generator::outputCountryTags()
+{
+	ofstream tags;
+	openOutputFile(installFolder, "common/country_tags/00_countries.txt", tags);
+	for (auto country: world.getCountries())
+	{
+		tags << country.tag << " = \"countries/" << country.name << ".txt\"\n";
+
+		ofstream countryFile;
+		openOutputFile(installFolder, "common/countries/" + country.name + ".txt", countryFile);
+		countryFile << "graphical_culture = westerngfx\n";
+		countryFile << "color = { " << country.color[0] << ' ' << country.color[1] << ' ' << country.color[2] << " }\n";
+	}
+}
+
+
+void EU4Generator::outputCultures()
+{
+	ofstream cultures;
+	openOutputFile(installFolder, "common/cultures/00_cultures.txt", cultures);
+	for (auto group: world.getCultureGroups())
+	{
+		cultures << group << " = {\n";
+		cultures << "\tgraphical_culture = westerngfx\n";
+		for (auto culture: world.getCultures())
+		{
+			if (culture.group == group)
+			{
+				cultures << '\t' << culture.name << " = {\n";
+				cultures << "\t\tmale_names = { Adam Bertil Carl }\n";
+				cultures << "\t\tfemale_names = { Anna Berit Cecilia }\n";
+				cultures << "\t\tdynasty_names = { Ahl Berg Cronstedt }\n";
+				cultures << "\t}\n";
+			}
+		}
+		cultures << "}\n";
+	}
+}
+
+
+void EU4Generator::outputReligions()
+{
+	ofstream religions;
+	openOutputFile(installFolder, "common/religions/00_religion.txt", religions);
+	for (auto group: world.getReligionGroups())
+	{
+		religions << group << " = {\n";
+		for (auto religion: world.getReligions())
+		{
+			if (religion.group == group)
+			{
+				religions << '\t' << religion.name << " = {\n";
+				religions << "\t\tcolor = { " << religion.color[0] << ' ' << religion.color[1] << ' ' << religion.color[2] << " }\n";
+				religions << "\t\ticon = 1\n";
+				religions << "\t}\n";
+			}
+		}
+		religions << "\tcrusade_name = CRUSADE\n";
+		religions << "}\n";
+	}
+}
+
+
+void EU4Generator::outputUnits()
+{
+	for (auto unitType: unitTypes)
+	{
+		ofstream unit;
+		openOutputFile(installFolder, string("common/units/") + unitType[0] + ".txt", unit);
+		unit << "type = " << unitType[1] << "\n";
+		unit << "unit_type = western\n";
+		unit << "maneuver = 1\n";
+		unit << "offensive_morale = 2\n";
+		unit << "defensive_morale = 2\n";
+		unit << "offensive_fire = 1\n";
+		unit << "defensive_fire = 1\n";
+		unit << "offensive_shock = 1\n";
+		unit << "defensive_shock = 1\n";
+	}
+}
+
+
+void EU4Generator::outputColonialRegions()
+{
+	// the synthetic world has no colonies, but EU4toV2 insists on at least one colonial region
+	ofstream colonialRegions;
+	openOutputFile(installFolder, "common/colonial_regions/00_colonial_regions.txt", colonialRegions);
+	colonialRegions << "colonial_synthetic = {\n";
+	colonialRegions << "\tcolor = { 100 100 100 }\n";
+	colonialRegions << "\tprovinces = {\n\t}\n";
+	colonialRegions << "}\n";
+}
+
+
+void EU4Generator::outputLocalisation()
+{
+	ofstream localisation;
+	openOutputFile(installFolder, "localisation/synthetic_l_english.yml", localisation);
+	localisation << "\xEF\xBB\xBFl_english:\n";
+	for (auto country: world.getCountries())
+	{
+		localisation << ' ' << country.tag << ":0 \"" << country.name << "\"\n";
+		localisation << ' ' << country.tag << "_ADJ:0 \"" << country.name << "ian\"\n";
+	}
+}
+
+
+void EU4Generator::outputSave()
+{
+	ofstream save;
+	openOutputFile(outputFolder, "saves/synthetic.eu4", save);
+	save << "EU4txt\n";
+	save << "date=1821.1.1\n";
+	save << "savegame_version={\n\tfirst=1\n\tsecond=16\n\tthird=0\n\tforth=0\n}\n";
+	save << "dlc_enabled={\n\t\"Conquest of Paradise\"\n\t\"Art of War\"\n}\n";
+	save << "emperor=\"" << world.getCountries()[0].tag << "\"\n";
+
+	save << "provinces={\n";
+	for (auto province: world.getProvinces())
+	{
+		outputSaveProvince(save, province);
+	}
+	save << "}\n";
+
+	save << "countries={\n";
+	for (unsigned int i = 0; i < world.getCountries().size(); i++)
+	{
+		outputSaveCountry(save, i);
+	}
+	save << "}\n";
+
+	// each country is allied to its eastern neighbour
+	save << "diplomacy={\n";
+	const vector<SyntheticCountry>& countries = world.getCountries();
+	for (unsigned int i = 0; i + 1 < countries.size(); i += 2)
+	{
+		save << "\talliance={\n";
+		save << "\t\tfirst=\"" << countries[i].tag << "\"\n";
+		save << "\t\tsecond=\"" << countries[i + 1].tag << "\"\n";
+		save << "\t\tstart_date=1800.1.1\n";
+		save << "\t}\n";
+	}
+	save << "}\n";
+}
+
+
+void EU4Generator::outputSaveProvince(ofstream& save, const SyntheticProvince& province)
+{
+	save << "-" << province.id << "={\n";
+	save << "\tname=\"Province" << province.id << "\"\n";
+	if (province.isLand)
+	{
+		const SyntheticCountry& owner = world.getCountries()[province.owner];
+		const string& culture = world.getCultures()[province.culture].name;
+		const string& religion = world.getReligions()[province.religion].name;
+
+		save << "\towner=\"" << owner.tag << "\"\n";
+		save << "\tcontroller=\"" << owner.tag << "\"\n";
+		save << "\tcore=\"" << owner.tag << "\"\n";
+		save << "\tculture=" << culture << "\n";
+		save << "\treligion=" << religion << "\n";
+		save << "\tbase_tax=" << random.between(1, 12) << ".000\n";
+		save << "\tbase_production=" << random.between(1, 12) << ".000\n";
+		save << "\tbase_manpower=" << random.between(1, 8) << ".000\n";
+		save << "\ttrade_goods=" << tradeGoods[random.between(0, sizeof(tradeGoods) / sizeof(tradeGoods[0]) - 1)] << "\n";
+		if (province.owner == 0)
+		{
+			save << "\thre=yes\n";
+		}
+		for (auto building: buildings)
+		{
+			if (random.between(0, 3) == 0)
+			{
+				save << '\t' << building << "=yes\n";
+			}
+		}
+
+		// every province has a history, as EU4toV2 dates the start of the game by the first owner
+		save << "\thistory={\n";
+		save << "\t\towner=\"" << owner.tag << "\"\n";
+		save << "\t\tculture=" << world.getCultures()[owner.culture].name << "\n";
+		save << "\t\treligion=" << world.getReligions()[owner.religion].name << "\n";
+		if ((province.culture != owner.culture) || (province.religion != owner.religion))
+		{
+			save << "\t\t1650.1.1={\n";
+			save << "\t\t\tculture=" << culture << "\n";
+			save << "\t\t\treligion=" << religion << "\n";
+			save << "\t\t}\n";
+		}
+		save << "\t}\n";
+	}
+	save << "}\n";
+}
+
+
+void EU4Generator::outputSaveCountry(ofstream& save, int countryIndex)
+{
+	const vector<SyntheticCountry>& countries = world.getCountries();
+	const SyntheticCountry& country = countries[countryIndex];
+
+	save << "\t" << country.tag << "={\n";
+	save << "\t\tcapital=" << country.capital << "\n";
+	save << "\t\ttechnology_group=western\n";
+	save << "\t\tprimary_culture=" << world.getCultures()[country.culture].name << "\n";
+	save << "\t\treligion=" << world.getReligions()[country.religion].name << "\n";
+	save << "\t\ttechnology={\n";
+	save << "\t\t\tadm_tech=" << random.between(15, 25) << "\n";
+	save << "\t\t\tdip_tech=" << random.between(15, 25) << "\n";
+	save << "\t\t\tmil_tech=" << random.between(15, 25) << "\n";
+	save << "\t\t}\n";
+	save << "\t\tgovernment=" << governments[countryIndex % (sizeof(governments) / sizeof(governments[0]))] << "\n";
+	save << "\t\tscore=" << random.between(0, 1000) << ".000\n";
+	save << "\t\tstability=" << random.between(-3, 3) << ".000\n";
+	save << "\t\tlegitimacy=" << random.between(50, 100) << ".000\n";
+	save << "\t\tdevelopment=" << country.provinces.size() * 18 << ".000\n";
+
+	// relations with the countries to either side
+	save << "\t\tactive_relations={\n";
+	for (int neighbour: { countryIndex - 1, countryIndex + 1 })
+	{
+		if ((neighbour >= 0) && (neighbour < static_cast<int>(countries.size())))
+		{
+			save << "\t\t\t" << countries[neighbour].tag << "={\n";
+			save << "\t\t\t\tattitude=attitude_neutral\n";
+			save << "\t\t\t\tvalue=" << random.between(-100, 100) << "\n";
+			save << "\t\t\t}\n";
+		}
+	}
+	save << "\t\t}\n";
+
+	save << "\t\tactive_idea_groups={\n";
+	for (int i = 0; i < 3; i++)
+	{
+		save << "\t\t\t" << ideaGroups[(countryIndex + i) % (sizeof(ideaGroups) / sizeof(ideaGroups[0]))] << "=" << random.between(0, 7) << "\n";
+	}
+	save << "\t\t}\n";
+
+	int leaderID = nextLeaderID++;
+	save << "\t\thistory={\n";
+	save << "\t\t\t1800.1.1={\n";
+	save << "\t\t\t\tleader={\n";
+	save << "\t\t\t\t\tname=\"General " << country.tag << "\"\n";
+	save << "\t\t\t\t\ttype=general\n";
+	save << "\t\t\t\t\tmanuever=" << random.between(0, 6) << "\n";
+	save << "\t\t\t\t\tfire=" << random.between(0, 6) << "\n";
+	save << "\t\t\t\t\tshock=" << random.between(0, 6) << "\n";
+	save << "\t\t\t\t\tsiege=" << random.between(0, 2) << "\n";
+	save << "\t\t\t\t\tactivation=1800.1.1\n";
+	save << "\t\t\t\t\tid={\n\t\t\t\t\t\tid=" << leaderID << "\n\t\t\t\t\t\ttype=4713\n\t\t\t\t\t}\n";
+	save << "\t\t\t\t}\n";
+	save << "\t\t\t}\n";
+	save << "\t\t}\n";
+	save << "\t\tleader={\n\t\t\tid=" << leaderID << "\n\t\t\ttype=4713\n\t\t}\n";
+
+	save << "\t\tarmy={\n";
+	save << "\t\t\tname=\"" << country.name << " Army\"\n";
+	save << "\t\t\tlocation=" << country.capital << "\n";
+	for (int i = 0; i < 12; i++)
+	{
+		save << "\t\t\tregiment={\n";
+		save << "\t\t\t\tname=\"Regiment " << i + 1 << "\"\n";
+		save << "\t\t\t\thome=" << country.provinces[i % country.provinces.size()] << "\n";
+		save << "\t\t\t\ttype=\"" << unitTypes[i % 3][0] << "\"\n";
+		save << "\t\t\t\tstrength=1.000\n";
+		save << "\t\t\t}\n";
+	}
+	save << "\t\t\tleader={\n\t\t\t\tid=" << leaderID << "\n\t\t\t\ttype=4713\n\t\t\t}\n";
+	save << "\t\t}\n";
+
+	// only countries on the coast have navies, based in their first coastal province
+	for (auto province: country.provinces)
+	{
+		if (world.getProvince(province).coastal)
+		{
+			save << "\t\tnavy={\n";
+			save << "\t\t\tname=\"" << country.name << " Navy\"\n";
+			save << "\t\t\tlocation=" << province << "\n";
+			for (int i = 0; i < 8; i++)
+			{
+				save << "\t\t\tship={\n";
+				save << "\t\t\t\tname=\"Ship " << i + 1 << "\"\n";
+				save << "\t\t\t\thome=" << province << "\n";
+				save << "\t\t\t\ttype=\"" << unitTypes[3 + i % 4][0] << "\"\n";
+				save << "\t\t\t\tstrength=1.000\n";
+				save << "\t\t\t}\n";
+			}
+			save << "\t\t}\n";
+			break;
+		}
+	}
+
+	save << "\t}\n";
+}
+
+
+void EU4Generator::outputMappings()
+{
+	string converterFolder = outputFolder + "/EU4toV2";
+
+	ofstream provinceMappings;
+	openOutputFile(converterFolder, "province_mappings.txt", provinceMappings);
+	provinceMappings << "1.16.0.0 = {\n";
+	for (int i = 1; i <= world.getLandProvinceCount(); i++)
+	{
+		provinceMappings << "\tlink = { eu4 = " << i << " v2 = " << i << " }\n";
+	}
+	provinceMappings << "}\n";
+
+	ofstream countryMappings;
+	openOutputFile(converterFolder, "country_mappings.txt", countryMappings);
+	countryMappings << "mappings={\n";
+	for (auto country: world.getCountries())
+	{
+		countryMappings << "\tlink = { eu4 = " << country.tag << " v2 = " << country.tag << " }\n";
+	}
+	countryMappings << "}\n";
+
+	ofstream cultureMap;
+	openOutputFile(converterFolder, "cultureMap.txt", cultureMap);
+	cultureMap << "cultureMap = {\n";
+	for (auto culture: world.getCultures())
+	{
+		cultureMap << "\tlink = { v2 = " << culture.name << " eu4 = " << culture.name << " }\n";
+	}
+	cultureMap << "}\n";
+
+	ofstream religionMap;
+	openOutputFile(converterFolder, "religionMap.txt", religionMap);
+	religionMap << "religionmap = {\n";
+	for (auto religion: world.getReligions())
+	{
+		religionMap << "\tlink = { v2 = " << religion.name << " eu4 = " << religion.name << " }\n";
+	}
+	religionMap << "}\n";
+}
+
+
+void EU4Generator::outputConfiguration()
+{
+	// an empty documents folder, so that the converter does not pick up the user's own mods
+	Utils::TryCreateFolder(outputFolder + "/EU4Documents");
+	Utils::TryCreateFolder(outputFolder + "/EU4Documents/mod");
+
+	ofstream configuration;
+	openOutputFile(outputFolder + "/EU4toV2", "configuration.txt", configuration);
+	configuration << "configuration =\n";
+	configuration << "{\n";
+	configuration << "\tEU4directory = \"" << installFolder << "\"\n";
+	configuration << "\tEU4DocumentsDirectory = \"" << outputFolder << "/EU4Documents\"\n";
+	configuration << "\tCK2ExportDirectory = \"" << outputFolder << "/EU4Documents\"\n";
+	configuration << "\tV2directory = \"" << outputFolder << "/Vic2\"\n";
+	configuration << "\tV2Documentsdirectory = \"" << outputFolder << "/Vic2Documents\"\n";
+	configuration << "\tV2gametype = \"HOD\"\n";
+	configuration << "\tmax_literacy = 1.0\n";
+	configuration << "\tRemovetype = \"none\"\n";
+	configuration << "\tlibertyThreshold = 100\n";
+	configuration << "\tconvertPopTotals = \"no\"\n";
+	configuration << "}\n";
+}
@@ -0,0 +1,77 @@
+/*Copyright (c) 2016 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+
+#ifndef EU4_GENERATOR_H_
+#define EU4_GENERATOR_H_
+
+
+
+#include <fstream>
+#include <string>
+#include "SyntheticWorld.h"
+using namespace std;
+
+
+
+// Writes the parts of an EU4 install that EU4toV2 reads, a save of the synthetic world, and the EU4toV2
+// mapping files that link it to the Vic2 install from Vic2Generator:
+//		<output>/EU4/					the install
+//		<output>/EU4Documents/		an empty documents folder, so that no real mods are picked up
+//		<output>/saves/synthetic.eu4
+//		<output>/EU4toV2/				files to copy over the converter's own, including its configuration.txt
+class EU4Generator
+{
+	public:
+		EU4Generator(const SyntheticWorld& world, const string& outputFolder);
+
+		void generate();
+
+	private:
+		void	outputDefinitions();
+		void	outputAreasAndRegions();
+		void	outputContinents();
+		void	outputCountryTags();
+		void	outputCultures();
+		void	outputReligions();
+		void	outputUnits();
+		void	outputColonialRegions();
+		void	outputLocalisation();
+
+		void	outputSave();
+		void	outputSaveProvince(ofstream& save, const SyntheticProvince& province);
+		void	outputSaveCountry(ofstream& save, int countryIndex);
+
+		void	outputMappings();
+		void	outputConfiguration();
+
+		const SyntheticWorld&	world;				// the world to write out
+		string						outputFolder;		// where to write everything
+		string						installFolder;		// where to write the EU4 install
+		SyntheticRandom			random;				// the source of the save's randomness
+		int							nextLeaderID;		// the ID to give the next leader
+};
+
+
+
+#endif // EU4_GENERATOR_H_
@@ -0,0 +1,86 @@
+/*Copyright (c) 2016 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+
+#include "GeneratorOutput.h"
+#include <cstdlib>
+#include <vector>
+#include "../../Log.h"
+#include "../../OSCompatibilityLayer.h"
+
+
+
+void openOutputFile(const string& root, const string& relativePath, ofstream& file)
+{
+	// create each folder in the path in turn, as TryCreateFolder only creates the last one
+	string path = root;
+	if (!Utils::TryCreateFolder(path))
+	{
+		LOG(LogLevel::Error) << "Could not create folder " << path;
+		exit(-1);
+	}
+	size_t start = 0;
+	size_t slash = relativePath.find('/');
+	while (slash != string::npos)
+	{
+		path += "/" + relativePath.substr(start, slash - start);
+		if (!Utils::TryCreateFolder(path))
+		{
+			LOG(LogLevel::Error) << "Could not create folder " << path;
+			exit(-1);
+		}
+		start = slash + 1;
+		slash = relativePath.find('/', start);
+	}
+
+	string filename = root + "/" + relativePath;
+	file.open(filename, ios::binary);
+	if (!file.is_open())
+	{
+		LOG(LogLevel::Error) << "Could not open " << filename;
+		exit(-1);
+	}
+}
+
+
+void writeBinaryAdjacencies(const SyntheticWorld& world, const string& root, const string& relativePath, int intsPerEntry)
+{
+	ofstream file;
+	openOutputFile(root, relativePath, file);
+
+	// there is no province 0, but the games still give it an (empty) entry
+	int noNeighbours = 0;
+	file.write(reinterpret_cast<const char*>(&noNeighbours), sizeof(noNeighbours));
+
+	vector<int> entry(intsPerEntry, 0);
+	for (auto province: world.getProvinces())
+	{
+		int neighbourCount = province.neighbours.size();
+		file.write(reinterpret_cast<const char*>(&neighbourCount), sizeof(neighbourCount));
+		for (auto neighbour: province.neighbours)
+		{
+			entry[1] = neighbour;
+			file.write(reinterpret_cast<const char*>(entry.data()), intsPerEntry * sizeof(int));
+		}
+	}
+}
@@ -0,0 +1,49 @@
+/*Copyright (c) 2016 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+
+#ifndef GENERATOR_OUTPUT_H_
+#define GENERATOR_OUTPUT_H_
+
+
+
+#include <fstream>
+#include <string>
+#include "SyntheticWorld.h"
+using namespace std;
+
+
+
+// Opens root/relativePath for writing, creating root and any folders along the way. The folder holding root
+// must already exist. Logs an error and exits if the
+// file cannot be opened, since a benchmark with missing files would only fail later and less clearly.
+void openOutputFile(const string& root, const string& relativePath, ofstream& file);
+
+// Writes the world's map connections in the games' map/cache/adjacencies.bin format: for each province
+// number from 0 up, the count of its neighbours and then one entry of intsPerEntry ints per neighbour, the
+// second of which is the neighbour's number. The games differ only in how many ints each entry has.
+void writeBinaryAdjacencies(const SyntheticWorld& world, const string& root, const string& relativePath, int intsPerEntry);
+
+
+
+#endif // GENERATOR_OUTPUT_H_
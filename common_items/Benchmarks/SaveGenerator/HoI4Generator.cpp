@@ -0,0 +1,389 @@
+/*Copyright (c) 2016 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+
+#include "HoI4Generator.h"
+#include <fstream>
+#include "GeneratorOutput.h"
+#include "../../OSCompatibilityLayer.h"
+
+
+
+static const char* resourceTypes[] = { "oil", "aluminium", "rubber", "tungsten", "steel", "chromium" };
+
+
+HoI4Generator::HoI4Generator(const SyntheticWorld& _world, const string& _outputFolder):
+	world(_world),
+	outputFolder(_outputFolder),
+	installFolder(_outputFolder + "/HoI4"),
+	converterFolder(_outputFolder + "/Vic2ToHoI4"),
+	random(_world.getSeed() + 3)
+{
+}
+
+
+void HoI4Generator::generate()
+{
+	outputDefinitions();
+	outputStates();
+	outputStrategicRegions();
+	outputSupplyAreas();
+	Utils::TryCreateFolder(outputFolder + "/HoI4Documents");
+
+	outputProvinceMappings();
+	outputAdjacencies();
+	outputPositions();
+	outputNavalProvinces();
+	outputResources();
+	outputCultureMap();
+	outputConfiguration();
+}
+
+
+vector<int> HoI4Generator::getHoI4Provinces(int Vic2Province) const
+{
+	int landProvinces = world.getLandProvinceCount();
+	if (Vic2Province <= landProvinces)
+	{
+		return { 2 * Vic2Province - 1, 2 * Vic2Province };
+	}
+	else
+	{
+		return { Vic2Province + landProvinces };
+	}
+}
+
+
+vector<int> HoI4Generator::getHoI4Neighbours(int HoI4Province) const
+{
+	int landProvinces = world.getLandProvinceCount();
+	vector<int> neighbours;
+	if (HoI4Province <= 2 * landProvinces)
+	{
+		const SyntheticProvince& Vic2Province = world.getProvince((HoI4Province + 1) / 2);
+		bool westernHalf = (HoI4Province % 2 == 1);
+		neighbours.push_back(westernHalf ? HoI4Province + 1 : HoI4Province - 1);
+
+		for (auto Vic2Neighbour: Vic2Province.neighbours)
+		{
+			const SyntheticProvince& neighbour = world.getProvince(Vic2Neighbour);
+			if (!neighbour.isLand)
+			{
+				neighbours.push_back(getHoI4Provinces(Vic2Neighbour)[0]);
+			}
+			else if (neighbour.y != Vic2Province.y)
+			{
+				neighbours.push_back(getHoI4Provinces(Vic2Neighbour)[westernHalf ? 0 : 1]);
+			}
+			else if ((neighbour.x < Vic2Province.x) && westernHalf)
+			{
+				neighbours.push_back(getHoI4Provinces(Vic2Neighbour)[1]);
+			}
+			else if ((neighbour.x > Vic2Province.x) && !westernHalf)
+			{
+				neighbours.push_back(getHoI4Provinces(Vic2Neighbour)[0]);
+			}
+		}
+	}
+	else
+	{
+		for (auto Vic2Neighbour: world.getProvince(HoI4Province - landProvinces).neighbours)
+		{
+			for (auto neighbour: getHoI4Provinces(Vic2Neighbour))
+			{
+				neighbours.push_back(neighbour);
+			}
+		}
+	}
+
+	return neighbours;
+}
+
+
+void HoI4Generator::outputDefinitions()
+{
+	ofstream definitions;
+	openOutputFile(installFolder, "map/definition.csv", definitions);
+	definitions << "0;0;0;0;land;false;unknown;0\n";
+	for (auto province: world.getProvinces())
+	{
+		for (auto HoI4Province: getHoI4Provinces(province.id))
+		{
+			definitions << HoI4Province << ';' << HoI4Province % 256 << ';' << (HoI4Province / 256) % 256 << ';' << HoI4Province / 65536;
+			if (province.isLand)
+			{
+				definitions << ";land;false;plains;1\n";
+			}
+			else
+			{
+				definitions << ";sea;true;ocean;0\n";
+			}
+		}
+	}
+}
+
+
+void HoI4Generator::outputStates()
+{
+	for (auto state: world.getStates())
+	{
+		const SyntheticCountry& owner = world.getCountries()[state.owner];
+
+		ofstream stateFile;
+		openOutputFile(installFolder, "history/states/" + to_string(state.id) + "-State" + to_string(state.id) + ".txt", stateFile);
+		stateFile << "state={\n";
+		stateFile << "\tid=" << state.id << "\n";
+		stateFile << "\tname=\"STATE_" << state.id << "\"\n";
+		stateFile << "\tmanpower=" << random.between(10000, 500000) << "\n";
+		stateFile << "\tstate_category=town\n";
+		stateFile << "\thistory={\n";
+		stateFile << "\t\towner=" << owner.tag << "\n";
+		stateFile << "\t\tbuildings={\n";
+		stateFile << "\t\t\tinfrastructure=" << random.between(1, 8) << "\n";
+		stateFile << "\t\t\tindustrial_complex=" << random.between(0, 4) << "\n";
+		stateFile << "\t\t\tarms_factory=" << random.between(0, 3) << "\n";
+		stateFile << "\t\t\tdockyard=" << (world.getProvince(state.provinces[0]).coastal ? random.between(0, 2) : 0) << "\n";
+		stateFile << "\t\t}\n";
+		stateFile << "\t\tadd_core_of=" << owner.tag << "\n";
+		stateFile << "\t}\n";
+		stateFile << "\tprovinces={\n\t\t";
+		for (auto province: state.provinces)
+		{
+			for (auto HoI4Province: getHoI4Provinces(province))
+			{
+				stateFile << HoI4Province << ' ';
+			}
+		}
+		stateFile << "\n\t}\n";
+		stateFile << "}\n";
+	}
+}
+
+
+void HoI4Generator::outputStrategicRegions()
+{
+	// each country's land is a strategic region, and each row of sea is another
+	int regionID = 1;
+	auto outputRegion = [&](const vector<int>& provinces)
+	{
+		ofstream region;
+		openOutputFile(installFolder, "map/strategicregions/" + to_string(regionID) + "-Region" + to_string(regionID) + ".txt", region);
+		region << "strategic_region={\n";
+		region << "\tid=" << regionID << "\n";
+		region << "\tname=\"STRATEGICREGION_" << regionID << "\"\n";
+		region << "\tprovinces={\n\t\t";
+		for (auto province: provinces)
+		{
+			region << province << ' ';
+		}
+		region << "\n\t}\n";
+		region << "\tweather={\n";
+		region << "\t\tperiod={\n";
+		region << "\t\t\tbetween={ 0.0 30.11 }\n";
+		region << "\t\t\ttemperature={ -5.0 25.0 }\n";
+		region << "\t\t\tno_phenomenon=0.500\n";
+		region << "\t\t\train_light=0.300\n";
+		region << "\t\t\train_heavy=0.100\n";
+		region << "\t\t\tsnow=0.100\n";
+		region << "\t\t}\n";
+		region << "\t}\n";
+		region << "}\n";
+		regionID++;
+	};
+
+	for (auto country: world.getCountries())
+	{
+		vector<int> provinces;
+		for (auto Vic2Province: country.provinces)
+		{
+			for (auto HoI4Province: getHoI4Provinces(Vic2Province))
+			{
+				provinces.push_back(HoI4Province);
+			}
+		}
+		outputRegion(provinces);
+	}
+
+	int landProvinces = world.getLandProvinceCount();
+	int gridSize = world.getGridSize();
+	for (int row = 0; row < 2; row++)
+	{
+		vector<int> provinces;
+		for (int i = 1; i <= gridSize; i++)
+		{
+			provinces.push_back(getHoI4Provinces(landProvinces + row * gridSize + i)[0]);
+		}
+		outputRegion(provinces);
+	}
+}
+
+
+void HoI4Generator::outputSupplyAreas()
+{
+	for (unsigned int i = 0; i < world.getCountries().size(); i++)
+	{
+		ofstream area;
+		openOutputFile(installFolder, "map/supplyareas/" + to_string(i + 1) + "-Area" + to_string(i + 1) + ".txt", area);
+		area << "supply_area={\n";
+		area << "\tid=" << i + 1 << "\n";
+		area << "\tname=\"SUPPLYAREA_" << i + 1 << "\"\n";
+		area << "\tvalue=" << random.between(2, 12) << "\n";
+		area << "\tstates={\n\t\t";
+		for (auto stateIndex: world.getCountries()[i].states)
+		{
+			area << world.getStates()[stateIndex].id << ' ';
+		}
+		area << "\n\t}\n";
+		area << "}\n";
+	}
+}
+
+
+void HoI4Generator::outputProvinceMappings()
+{
+	ofstream mappings;
+	openOutputFile(converterFolder, "province_mappings.txt", mappings);
+	mappings << "0.0.0 = {\n";
+	for (auto province: world.getProvinces())
+	{
+		mappings << "\tlink = { vic2 = " << province.id;
+		for (auto HoI4Province: getHoI4Provinces(province.id))
+		{
+			mappings << " hoi4 = " << HoI4Province;
+		}
+		mappings << " }\n";
+	}
+	mappings << "}\n";
+}
+
+
+void HoI4Generator::outputAdjacencies()
+{
+	// the converter reads this line by line until the end of the file, so there must be no last newline
+	ofstream adjacencies;
+	openOutputFile(converterFolder, "adj.txt", adjacencies);
+	adjacencies << "0;0;0;0;0;";
+	for (auto province: world.getProvinces())
+	{
+		for (auto HoI4Province: getHoI4Provinces(province.id))
+		{
+			adjacencies << '\n' << HoI4Province << ";0;" << HoI4Province % 256 << ';' << (HoI4Province / 256) % 256 << ';' << HoI4Province / 65536 << ';';
+			for (auto neighbour: getHoI4Neighbours(HoI4Province))
+			{
+				adjacencies << neighbour << ';';
+			}
+		}
+	}
+}
+
+
+void HoI4Generator::outputPositions()
+{
+	// as with adj.txt, there must be no last newline
+	ofstream positions;
+	openOutputFile(converterFolder, "positions.txt", positions);
+	bool first = true;
+	for (auto province: world.getProvinces())
+	{
+		vector<int> HoI4Provinces = getHoI4Provinces(province.id);
+		for (unsigned int i = 0; i < HoI4Provinces.size(); i++)
+		{
+			if (!first)
+			{
+				positions << '\n';
+			}
+			first = false;
+
+			int x = province.x * 20 + i * 10 + 5;
+			int y = (province.y + 1) * 20 + 10;
+			positions << HoI4Provinces[i] << ";0;" << x << ".00;10.00;" << y << ".00;0.00;0.00";
+		}
+	}
+}
+
+
+void HoI4Generator::outputNavalProvinces()
+{
+	ofstream navalProvinces;
+	openOutputFile(converterFolder, "navalprovinces.txt", navalProvinces);
+	navalProvinces << "link = {\n";
+	for (int i = 1; i <= world.getLandProvinceCount(); i++)
+	{
+		if (world.getProvince(i).coastal)
+		{
+			navalProvinces << "\tprovince = " << getHoI4Provinces(i)[0] << "\n";
+		}
+	}
+	navalProvinces << "}\n";
+}
+
+
+void HoI4Generator::outputResources()
+{
+	ofstream resources;
+	openOutputFile(converterFolder, "resources.txt", resources);
+	resources << "resources = {\n";
+	for (int i = 1; i <= 2 * world.getLandProvinceCount(); i++)
+	{
+		if (random.between(0, 9) == 0)
+		{
+			resources << "link = { province = " << i << " resources = { ";
+			resources << resourceTypes[random.between(0, sizeof(resourceTypes) / sizeof(resourceTypes[0]) - 1)] << " = " << random.between(1, 40);
+			resources << " } }\n";
+		}
+	}
+	resources << "}\n";
+}
+
+
+void HoI4Generator::outputCultureMap()
+{
+	static const char* HoI4Cultures[] = { "German", "British", "Soviet", "French", "Italian", "Japanese" };
+
+	ofstream cultureMap;
+	openOutputFile(converterFolder, "culture_map.txt", cultureMap);
+	cultureMap << "cultureMap = {\n";
+	for (unsigned int i = 0; i < world.getCultures().size(); i++)
+	{
+		cultureMap << "link = { hoi3 = " << HoI4Cultures[i % (sizeof(HoI4Cultures) / sizeof(HoI4Cultures[0]))];
+		cultureMap << " v2 = " << world.getCultures()[i].name << " }\n";
+	}
+	cultureMap << "}\n";
+}
+
+
+void HoI4Generator::outputConfiguration()
+{
+	ofstream configuration;
+	openOutputFile(converterFolder, "configuration.txt", configuration);
+	configuration << "configuration =\n";
+	configuration << "{\n";
+	configuration << "\tV2directory = \"" << outputFolder << "/Vic2\"\n";
+	configuration << "\tHoI4directory = \"" << installFolder << "\"\n";
+	configuration << "\tHoI4Documentsdirectory = \"" << outputFolder << "/HoI4Documents\"\n";
+	configuration << "\tVic2Mods = { }\n";
+	configuration << "\tmanpower_factor = \"1.0\"\n";
+	configuration << "\tindustrial_shape_factor = 0.0\n";
+	configuration << "\tic_factor = 0.1\n";
+	configuration << "}\n";
+}
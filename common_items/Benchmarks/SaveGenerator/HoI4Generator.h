@@ -0,0 +1,76 @@
+/*Copyright (c) 2016 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+
+#ifndef HOI4_GENERATOR_H_
+#define HOI4_GENERATOR_H_
+
+
+
+#include <string>
+#include <vector>
+#include "SyntheticWorld.h"
+using namespace std;
+
+
+
+// Writes the parts of a HoI4 install that Vic2ToHoI4 reads, and the Vic2ToHoI4 map files that link it to the
+// Vic2 install from Vic2Generator. Each Vic2 land province is split into a western and an eastern HoI4
+// province, and each Vic2 sea province becomes one HoI4 sea province:
+//		<output>/HoI4/						the install
+//		<output>/HoI4Documents/			an empty documents folder
+//		<output>/Vic2ToHoI4/				files to copy over the converter's own, including its configuration.txt
+class HoI4Generator
+{
+	public:
+		HoI4Generator(const SyntheticWorld& world, const string& outputFolder);
+
+		void generate();
+
+	private:
+		void	outputDefinitions();
+		void	outputStates();
+		void	outputStrategicRegions();
+		void	outputSupplyAreas();
+
+		void	outputProvinceMappings();
+		void	outputAdjacencies();
+		void	outputPositions();
+		void	outputNavalProvinces();
+		void	outputResources();
+		void	outputCultureMap();
+		void	outputConfiguration();
+
+		vector<int>	getHoI4Provinces(int Vic2Province) const;
+		vector<int>	getHoI4Neighbours(int HoI4Province) const;
+
+		const SyntheticWorld&	world;				// the world to write out
+		string						outputFolder;		// where to write everything
+		string						installFolder;		// where to write the HoI4 install
+		string						converterFolder;	// where to write the Vic2ToHoI4 files
+		SyntheticRandom			random;				// the source of the resources' randomness
+};
+
+
+
+#endif // HOI4_GENERATOR_H_
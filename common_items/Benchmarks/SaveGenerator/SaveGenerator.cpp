@@ -0,0 +1,84 @@
+/*Copyright (c) 2016 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+
+// Builds a synthetic world and writes it out as an EU4 save, a Vic2 save and a CK2 save, along with just
+// enough of each game's install and of each converter's data files for EU4toV2, Vic2ToHoI4 and CK2ToEU3 to
+// run on them. Bigger scales give proportionally bigger saves, so converter timings can be compared across
+// sizes without needing real saves. The same scale and seed always give the same files.
+//
+// Usage: SaveGenerator <output folder (absolute)> [scale] [seed]
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include "SyntheticWorld.h"
+#include "EU4Generator.h"
+#include "Vic2Generator.h"
+#include "HoI4Generator.h"
+#include "CK2Generator.h"
+#include "../../OSCompatibilityLayer.h"
+using namespace std;
+
+
+
+int main(int argc, char* argv[])
+{
+	if (argc < 2)
+	{
+		cout << "Usage: SaveGenerator <output folder (absolute)> [scale] [seed]\n";
+		return 1;
+	}
+	const string outputFolder	= argv[1];
+	const int scale				= (argc > 2) ? atoi(argv[2]) : 1;
+	const unsigned int seed		= (argc > 3) ? static_cast<unsigned int>(atoi(argv[3])) : 1444;
+	if (scale < 1)
+	{
+		cout << "The scale must be at least 1\n";
+		return 1;
+	}
+	if (!Utils::TryCreateFolder(outputFolder))
+	{
+		cout << "Could not create " << outputFolder << "\n";
+		return 1;
+	}
+
+	auto start = chrono::steady_clock::now();	// when generation started
+	SyntheticWorld world(scale, seed);
+	cout << "World:    " << world.getLandProvinceCount() << " land provinces, " << world.getCountries().size() << " countries\n";
+
+	EU4Generator(world, outputFolder).generate();
+	cout << "EU4:      " << outputFolder << "/saves/synthetic.eu4\n";
+	Vic2Generator(world, outputFolder).generate();
+	cout << "Vic2:     " << outputFolder << "/saves/synthetic.v2\n";
+	HoI4Generator(world, outputFolder).generate();
+	cout << "HoI4:     " << outputFolder << "/HoI4\n";
+	CK2Generator(world, outputFolder).generate();
+	cout << "CK2:      " << outputFolder << "/saves/synthetic.ck2\n";
+
+	chrono::duration<double> elapsed = chrono::steady_clock::now() - start;	// how long generation took
+	cout << "Generated in " << elapsed.count() << " s\n";
+
+	return 0;
+}
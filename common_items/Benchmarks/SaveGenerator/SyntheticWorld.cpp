@@ -0,0 +1,260 @@
+/*Copyright (c) 2016 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+
+#include "SyntheticWorld.h"
+#include <cmath>
+
+
+
+const int baseLandProvinces	= 2000;	// the land provinces in a world of scale 1
+const int countryBlockSize		= 4;		// the width and height of the block of provinces each country owns
+const int stateBlockSize		= 2;		// the width and height of the block of provinces in each state
+const int culturesPerGroup		= 8;		// the cultures in each culture group
+const int religionsPerGroup	= 3;		// the religions in each religion group
+const int religionGroupCount	= 2;		// the number of religion groups
+
+
+SyntheticWorld::SyntheticWorld(int scale, unsigned int _seed):
+	seed(_seed),
+	random(_seed)
+{
+	if (scale < 1)
+	{
+		scale = 1;
+	}
+
+	// round the grid to whole country blocks so that every country is the same size
+	int blocksAcross = static_cast<int>(sqrt(static_cast<double>(baseLandProvinces * scale)) / countryBlockSize + 0.5);
+	if (blocksAcross < 1)
+	{
+		blocksAcross = 1;
+	}
+	gridSize = blocksAcross * countryBlockSize;
+
+	createCultures(blocksAcross * blocksAcross);
+	createReligions();
+	createCountries();
+	createStates();
+	createProvinces();
+	linkNeighbours();
+}
+
+
+string SyntheticWorld::getContinent(int provinceNum) const
+{
+	const SyntheticProvince& province = getProvince(provinceNum);
+	return (province.y < gridSize / 2) ? "europe" : "asia";
+}
+
+
+void SyntheticWorld::createCultures(int countryCount)
+{
+	// two countries share each culture, so that culture mapping and cultural unions have some work to do
+	int cultureCount = (countryCount + 1) / 2;
+	for (int i = 0; i < cultureCount; i++)
+	{
+		if (i % culturesPerGroup == 0)
+		{
+			cultureGroups.push_back("cgroup" + to_string(i / culturesPerGroup));
+		}
+
+		SyntheticCulture culture;
+		culture.name	= "cul" + to_string(i);
+		culture.group	= cultureGroups.back();
+		cultures.push_back(culture);
+	}
+}
+
+
+void SyntheticWorld::createReligions()
+{
+	for (int i = 0; i < religionGroupCount * religionsPerGroup; i++)
+	{
+		if (i % religionsPerGroup == 0)
+		{
+			religionGroups.push_back("rgroup" + to_string(i / religionsPerGroup));
+		}
+
+		SyntheticReligion religion;
+		religion.name		= "rel" + to_string(i);
+		religion.group		= religionGroups.back();
+		religion.color[0]	= random.between(0, 255);
+		religion.color[1]	= random.between(0, 255);
+		religion.color[2]	= random.between(0, 255);
+		religions.push_back(religion);
+	}
+}
+
+
+void SyntheticWorld::createCountries()
+{
+	int blocksAcross = gridSize / countryBlockSize;
+	for (int i = 0; i < blocksAcross * blocksAcross; i++)
+	{
+		int blockX = (i % blocksAcross) * countryBlockSize;
+		int blockY = (i / blocksAcross) * countryBlockSize;
+
+		SyntheticCountry country;
+		country.tag			= makeTag(i);
+		country.name		= "Land" + country.tag;
+		country.capital	= blockY * gridSize + blockX + 1;
+		country.culture	= i / 2;
+		country.religion	= (i / 5) % religions.size();
+		country.color[0]	= random.between(0, 255);
+		country.color[1]	= random.between(0, 255);
+		country.color[2]	= random.between(0, 255);
+		countries.push_back(country);
+	}
+}
+
+
+void SyntheticWorld::createStates()
+{
+	int statesAcross = gridSize / stateBlockSize;
+	for (int i = 0; i < statesAcross * statesAcross; i++)
+	{
+		int stateX = (i % statesAcross) * stateBlockSize;
+		int stateY = (i / statesAcross) * stateBlockSize;
+
+		SyntheticState state;
+		state.id		= i + 1;
+		state.owner	= (stateY / countryBlockSize) * (gridSize / countryBlockSize) + stateX / countryBlockSize;
+		states.push_back(state);
+
+		countries[state.owner].states.push_back(i);
+	}
+}
+
+
+void SyntheticWorld::createProvinces()
+{
+	int landProvinces = getLandProvinceCount();
+	for (int i = 0; i < landProvinces; i++)
+	{
+		SyntheticProvince province;
+		province.id			= i + 1;
+		province.x			= i % gridSize;
+		province.y			= i / gridSize;
+		province.isLand	= true;
+		province.coastal	= (province.y == 0) || (province.y == gridSize - 1);
+		province.owner		= (province.y / countryBlockSize) * (gridSize / countryBlockSize) + province.x / countryBlockSize;
+		province.state		= (province.y / stateBlockSize) * (gridSize / stateBlockSize) + province.x / stateBlockSize;
+
+		// most people follow their country, but some provinces hold minorities
+		const SyntheticCountry& owner = countries[province.owner];
+		province.culture		= (random.between(0, 9) == 0) ? random.between(0, cultures.size() - 1) : owner.culture;
+		province.religion		= (random.between(0, 9) == 0) ? random.between(0, religions.size() - 1) : owner.religion;
+		province.population	= random.between(20000, 120000);
+		provinces.push_back(province);
+
+		countries[province.owner].provinces.push_back(province.id);
+		states[province.state].provinces.push_back(province.id);
+	}
+
+	// a row of sea above the grid and another below it
+	for (int i = 0; i < 2 * gridSize; i++)
+	{
+		SyntheticProvince province;
+		province.id			= landProvinces + i + 1;
+		province.x			= i % gridSize;
+		province.y			= (i < gridSize) ? -1 : gridSize;
+		province.isLand	= false;
+		province.coastal	= false;
+		province.owner		= -1;
+		province.state		= -1;
+		province.culture	= 0;
+		province.religion	= 0;
+		province.population	= 0;
+		provinces.push_back(province);
+	}
+}
+
+
+void SyntheticWorld::linkNeighbours()
+{
+	int landProvinces = getLandProvinceCount();
+	auto findProvince = [&](int x, int y)
+	{
+		if ((x < 0) || (x >= gridSize) || (y < -1) || (y > gridSize))
+		{
+			return 0;
+		}
+		else if (y == -1)
+		{
+			return landProvinces + x + 1;
+		}
+		else if (y == gridSize)
+		{
+			return landProvinces + gridSize + x + 1;
+		}
+		else
+		{
+			return y * gridSize + x + 1;
+		}
+	};
+
+	for (auto& province: provinces)
+	{
+		const int offsets[4][2] = { { 0, -1 }, { -1, 0 }, { 1, 0 }, { 0, 1 } };
+		for (auto offset: offsets)
+		{
+			int neighbour = findProvince(province.x + offset[0], province.y + offset[1]);
+			if (neighbour != 0)
+			{
+				province.neighbours.push_back(neighbour);
+			}
+		}
+	}
+}
+
+
+string SyntheticWorld::makeTag(int index)
+{
+	// skip the tags the games reserve for rebels, pirates and natives
+	static const char* reservedTags[] = { "NAT", "PIR", "REB" };
+
+	string tag;
+	int next = 0;
+	for (int i = 0; i <= index; i++)
+	{
+		bool reserved = true;
+		while (reserved)
+		{
+			tag = string(1, 'A' + (next / 676) % 26) + string(1, 'A' + (next / 26) % 26) + string(1, 'A' + next % 26);
+			next++;
+
+			reserved = false;
+			for (auto reservedTag: reservedTags)
+			{
+				if (tag == reservedTag)
+				{
+					reserved = true;
+				}
+			}
+		}
+	}
+
+	return tag;
+}
+
@@ -0,0 +1,156 @@
+/*Copyright (c) 2016 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+
+#ifndef SYNTHETIC_WORLD_H_
+#define SYNTHETIC_WORLD_H_
+
+
+
+#include <random>
+#include <string>
+#include <vector>
+using namespace std;
+
+
+
+// A seeded Mersenne twister used without any of the standard distributions, whose results differ between
+// standard libraries, so that the same seed gives the same saves on every platform.
+class SyntheticRandom
+{
+	public:
+		explicit SyntheticRandom(unsigned int seed): generator(seed) {}
+
+		// Returns a number from low to high, inclusive
+		int between(int low, int high)
+		{
+			return low + static_cast<int>(generator() % static_cast<unsigned int>(high - low + 1));
+		}
+
+	private:
+		mt19937 generator;	// the source of the randomness
+};
+
+
+struct SyntheticProvince
+{
+	int			id;				// the province number, starting from 1
+	int			x;					// the column of the map grid the province is in
+	int			y;					// the row of the map grid the province is in, -1 or the grid height for sea provinces
+	bool			isLand;			// whether the province is land or sea
+	bool			coastal;			// whether or not the province is land bordering a sea province
+	int			owner;			// the index of the country owning the province, or -1 for sea provinces
+	int			state;			// the index of the state the province is in, or -1 for sea provinces
+	int			culture;			// the index of the culture of the people in the province
+	int			religion;		// the index of the religion of the people in the province
+	int			population;		// the number of people in the province
+	vector<int>	neighbours;		// the numbers of the provinces bordering this one
+};
+
+
+struct SyntheticCountry
+{
+	string		tag;				// the country's tag, the same in every game
+	string		name;				// the country's name, also used for its file names
+	int			capital;			// the number of the country's capital province
+	int			culture;			// the index of the country's primary culture
+	int			religion;		// the index of the country's religion
+	int			color[3];		// the country's map colour
+	vector<int>	provinces;		// the numbers of the provinces the country owns
+	vector<int>	states;			// the indices of the states the country owns
+};
+
+
+struct SyntheticState
+{
+	int			id;				// the state number, starting from 1
+	int			owner;			// the index of the country owning the state
+	vector<int>	provinces;		// the numbers of the provinces in the state
+};
+
+
+struct SyntheticCulture
+{
+	string	name;		// the culture's name
+	string	group;	// the name of the culture group the culture is in
+};
+
+
+struct SyntheticReligion
+{
+	string	name;			// the religion's name
+	string	group;		// the name of the religion group the religion is in
+	int		color[3];	// the religion's colour
+};
+
+
+// A made-up map that every save generator builds its games from. Land provinces are laid out on a square grid
+// with a row of sea provinces above and below it, so the top and bottom rows are coastal. Each country owns a
+// 4x4 block of the grid made of four 2x2 states. Province numbers are the same in every game, which keeps the
+// province mappings one to one. The same scale and seed always give the same world.
+class SyntheticWorld
+{
+	public:
+		// A scale of 1 gives about 2000 land provinces and 125 countries. Provinces and countries grow linearly
+		// with the scale.
+		SyntheticWorld(int scale, unsigned int seed);
+
+		const SyntheticProvince&	getProvince(int provinceNum) const { return provinces[provinceNum - 1]; }
+		string							getContinent(int provinceNum) const;
+
+		int											getGridSize() const				{ return gridSize; }
+		int											getLandProvinceCount() const	{ return gridSize * gridSize; }
+		unsigned int								getSeed() const					{ return seed; }
+		const vector<SyntheticProvince>&		getProvinces() const				{ return provinces; }
+		const vector<SyntheticCountry>&		getCountries() const				{ return countries; }
+		const vector<SyntheticState>&			getStates() const					{ return states; }
+		const vector<SyntheticCulture>&		getCultures() const				{ return cultures; }
+		const vector<SyntheticReligion>&		getReligions() const				{ return religions; }
+		const vector<string>&					getCultureGroups() const		{ return cultureGroups; }
+		const vector<string>&					getReligionGroups() const		{ return religionGroups; }
+
+	private:
+		void	createCultures(int countryCount);
+		void	createReligions();
+		void	createCountries();
+		void	createStates();
+		void	createProvinces();
+		void	linkNeighbours();
+
+		static string makeTag(int index);
+
+		int								gridSize;			// the width and height of the grid of land provinces
+		unsigned int					seed;					// the seed the world was built from
+		SyntheticRandom				random;				// the source of the world's randomness
+		vector<SyntheticProvince>	provinces;			// every province, land then sea, indexed by number - 1
+		vector<SyntheticCountry>	countries;			// every country
+		vector<SyntheticState>		states;				// every state
+		vector<SyntheticCulture>	cultures;			// every culture
+		vector<SyntheticReligion>	religions;			// every religion
+		vector<string>					cultureGroups;		// the names of the culture groups
+		vector<string>					religionGroups;	// the names of the religion groups
+};
+
+
+
+#endif // SYNTHETIC_WORLD_H_
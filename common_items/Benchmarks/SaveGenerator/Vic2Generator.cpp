@@ -0,0 +1,755 @@
+/*Copyright (c) 2016 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+
+#include "Vic2Generator.h"
+#include <algorithm>
+#include "GeneratorOutput.h"
+#include "../../OSCompatibilityLayer.h"
+
+
+
+static const char* ideologies[] = { "conservative", "liberal", "reactionary", "socialist", "fascist", "communist", "anarcho_liberal" };
+
+static const char* governments[] = {
+	"absolute_monarchy", "prussian_constitutionalism", "hms_government", "democracy", "presidential_dictatorship",
+	"bourgeois_dictatorship", "fascist_dictatorship", "proletarian_dictatorship"
+};
+
+// the political and social reforms, each followed by its levels
+static const char* politicalReforms[][5] = {
+	{ "vote_franschise", "none_voting", "landed_voting", "wealth_voting", "universal_voting" },
+	{ "upper_house_composition", "appointed", "state_equal_weight", "population_equal_weight", "population_equal_weight" },
+	{ "press_rights", "state_press", "censored_press", "free_press", "free_press" }
+};
+static const char* socialReforms[][5] = {
+	{ "minimum_wage", "no_minimum_wage", "trinket_wage", "low_minimum_wage", "acceptable_minimum_wage" },
+	{ "work_hours", "no_work_hour_limit", "fourteen_hours", "twelve_hours", "eight_hours" }
+};
+
+// the tech schools, with the last blocked by EU4toV2's blocked_tech_schools.txt
+static const char* techSchools[] = { "traditional_academic", "army_tech_school", "naval_tech_school", "prussian_tech_school" };
+
+// the technologies Vic2ToHoI4 maps, and the factories each unlocks in EU4toV2
+static const char* technologies[][3] = {
+	{ "army", "post_napoleonic_thought", "ammunition_factory" },
+	{ "army", "military_directionism", "small_arms_factory" },
+	{ "army", "bolt_action_rifles", "artillery_factory" },
+	{ "army", "infiltration", "explosives_factory" },
+	{ "army", "modern_army_doctrine", "" },
+	{ "army", "great_war_experience", "" },
+	{ "commerce", "organizational_development", "paper_mill" },
+	{ "commerce", "shift_work", "furniture_factory" },
+	{ "culture", "mass_politics", "" },
+	{ "culture", "social_alienation", "" },
+	{ "culture", "behaviorism", "" },
+	{ "industry", "electric_furnace", "steel_factory" },
+	{ "industry", "electrical_power_generation", "cement_factory" },
+	{ "industry", "integral_rail_system", "" },
+	{ "industry", "limited_access_roads", "" },
+	{ "industry", "synthetic_polymers", "glass_factory" },
+	{ "navy", "naval_directionism", "clipper_shipyard" },
+	{ "navy", "steam_turbine_ships", "" },
+	{ "navy", "oil_driven_ships", "" },
+	{ "navy", "advanced_naval_design", "" },
+	{ "navy", "modern_naval_design", "" },
+	{ "navy", "naval_integration", "" },
+	{ "navy", "modern_naval_doctrine", "" }
+};
+
+// the inventions Vic2ToHoI4 maps, and the factories each unlocks in EU4toV2
+static const char* inventions[][3] = {
+	{ "army", "interwar_infantry", "" },
+	{ "army", "interwar_cavalry", "" },
+	{ "army", "light_tank", "" },
+	{ "army", "armoured_cars", "" },
+	{ "army", "tank_experiments", "" },
+	{ "army", "light_artillery", "" },
+	{ "army", "heavy_artillery", "" },
+	{ "commerce", "daimlers_automobile", "" },
+	{ "commerce", "mass_advertising", "canned_food_factory" },
+	{ "culture", "the_talkies", "" },
+	{ "culture", "the_revolt_of_the_masses", "" },
+	{ "culture", "the_doctrine_of_fascism", "" },
+	{ "industry", "alternating_current", "" },
+	{ "industry", "direct_current", "" },
+	{ "industry", "wireless", "" },
+	{ "industry", "bakelite", "" },
+	{ "industry", "rayon", "luxury_clothes_factory" },
+	{ "industry", "stainless_steel", "" },
+	{ "navy", "dreadnoughts", "" },
+	{ "navy", "advanced_battleships", "" },
+	{ "navy", "modern_cruisers", "" },
+	{ "navy", "naval_exercises", "" }
+};
+static const char* techCategories[] = { "army", "commerce", "culture", "industry", "navy" };
+
+// the factories EU4toV2 builds from its starting_factories.txt, with what they make and use
+static const char* productionTypes[][3] = {
+	{ "fabric_factory", "fabric", "cotton" },
+	{ "ammunition_factory", "ammunition", "sulphur" },
+	{ "steel_factory", "steel", "iron" },
+	{ "paper_mill", "paper", "timber" },
+	{ "cement_factory", "cement", "coal" },
+	{ "lumber_mill", "lumber", "timber" },
+	{ "regular_clothes_factory", "regular_clothes", "fabric" },
+	{ "explosives_factory", "explosives", "sulphur" },
+	{ "small_arms_factory", "small_arms", "steel" },
+	{ "glass_factory", "glass", "coal" },
+	{ "artillery_factory", "artillery", "steel" },
+	{ "clipper_shipyard", "clipper_convoy", "lumber" },
+	{ "canned_food_factory", "canned_food", "cattle" },
+	{ "furniture_factory", "furniture", "lumber" },
+	{ "liquor_distillery", "liquor", "grain" },
+	{ "luxury_furniture_factory", "luxury_furniture", "furniture" },
+	{ "winery", "wine", "fruit" },
+	{ "luxury_clothes_factory", "luxury_clothes", "silk" }
+};
+
+static const char* tradeGoods[] = {
+	"grain", "cattle", "wool", "cotton", "fish", "fruit", "timber", "coal", "iron", "sulphur", "silk", "tea", "coffee"
+};
+
+static const char* popTypes[] = {
+	"aristocrats", "artisans", "bureaucrats", "capitalists", "clergymen", "craftsmen", "clerks", "farmers",
+	"soldiers", "officers", "labourers"
+};
+
+static const char* regimentTypes[] = { "infantry", "infantry", "cavalry", "artillery", "engineer", "guard" };
+static const char* shipTypes[] = { "frigate", "ironclad", "manowar", "cruiser", "dreadnought" };
+
+const int partiesPerCountry = 3;	// the parties each country has, which Vic2 numbers through every country in turn
+
+
+Vic2Generator::Vic2Generator(const SyntheticWorld& _world, const string& _outputFolder):
+	world(_world),
+	outputFolder(_outputFolder),
+	installFolder(_outputFolder + "/Vic2"),
+	random(_world.getSeed() + 2),
+	nextPopID(1)
+{
+}
+
+
+void Vic2Generator::generate()
+{
+	outputCountries(installFolder);
+	outputCultures();
+	outputReligions();
+	outputIssues();
+	outputTechnologies();
+	outputInventions();
+	outputProductionTypes();
+	outputProvinceHistories();
+	outputCountryHistories();
+	outputMap();
+	outputLocalisation();
+	Utils::TryCreateFolder(installFolder + "/mod");
+	Utils::TryCreateFolder(outputFolder + "/Vic2Documents");
+
+	outputBlankMod();
+
+	outputSave();
+}
+
+
+void Vic2Generator::outputCountries(const string& root)
+{
+	ofstream countries;
+	openOutputFile(root, "common/countries.txt", countries);
+	countries << "REB = \"countries/Rebels.txt\"\n";
+	for (auto country: world.getCountries())
+	{
+		countries << country.tag << " = \"countries/" << country.name << ".txt\"\n";
+	}
+	countries << "dynamic_tags = yes\n";
+
+	ofstream rebels;
+	openOutputFile(root, "common/countries/Rebels.txt", rebels);
+	rebels << "color = { 20 20 20 }\n";
+	rebels << "graphical_culture = Generic\n";
+
+	for (unsigned int i = 0; i < world.getCountries().size(); i++)
+	{
+		const SyntheticCountry& country = world.getCountries()[i];
+
+		ofstream countryFile;
+		openOutputFile(root, "common/countries/" + country.name + ".txt", countryFile);
+		countryFile << "color = { " << country.color[0] << ' ' << country.color[1] << ' ' << country.color[2] << " }\n";
+		countryFile << "graphical_culture = EuropeanGC\n";
+		for (int j = 0; j < partiesPerCountry; j++)
+		{
+			countryFile << "party = {\n";
+			countryFile << "\tname = \"" << country.tag << "_party" << j << "\"\n";
+			countryFile << "\tstart_date = 1800.1.1\n";
+			countryFile << "\tend_date = 2000.1.1\n";
+			countryFile << "\tideology = " << ideologies[(i + j) % (sizeof(ideologies) / sizeof(ideologies[0]))] << "\n";
+			countryFile << "\teconomic_policy = interventionism\n";
+			countryFile << "\ttrade_policy = protectionism\n";
+			countryFile << "\treligious_policy = moralism\n";
+			countryFile << "\tcitizenship_policy = residency\n";
+			countryFile << "\twar_policy = pro_military\n";
+			countryFile << "}\n";
+		}
+	}
+}
+
+
+void Vic2Generator::outputCultures()
+{
+	ofstream cultures;
+	openOutputFile(installFolder, "common/cultures.txt", cultures);
+	for (auto group: world.getCultureGroups())
+	{
+		cultures << group << " = {\n";
+		cultures << "\tleader = european\n";
+		cultures << "\tunit = EuropeanGC\n";
+		for (auto culture: world.getCultures())
+		{
+			if (culture.group == group)
+			{
+				cultures << '\t' << culture.name << " = {\n";
+				cultures << "\t\tcolor = { " << random.between(0, 255) << ' ' << random.between(0, 255) << ' ' << random.between(0, 255) << " }\n";
+				cultures << "\t\tfirst_names = { Adam Bertil Carl David Erik }\n";
+				cultures << "\t\tlast_names = { Ahl Berg Cronstedt Dahl Ek }\n";
+				cultures << "\t}\n";
+			}
+		}
+		cultures << "}\n";
+	}
+}
+
+
+void Vic2Generator::outputReligions()
+{
+	ofstream religions;
+	openOutputFile(installFolder, "common/religion.txt", religions);
+	for (auto group: world.getReligionGroups())
+	{
+		religions << group << " = {\n";
+		for (auto religion: world.getReligions())
+		{
+			if (religion.group == group)
+			{
+				religions << '\t' << religion.name << " = {\n";
+				religions << "\t\ticon = 1\n";
+				religions << "\t\tcolor = { " << religion.color[0] / 255.0 << ' ' << religion.color[1] / 255.0 << ' ' << religion.color[2] / 255.0 << " }\n";
+				religions << "\t}\n";
+			}
+		}
+		religions << "}\n";
+	}
+}
+
+
+void Vic2Generator::outputIssues()
+{
+	ofstream issues;
+	openOutputFile(installFolder, "common/issues.txt", issues);
+	issues << "political_reforms = {\n";
+	for (auto reform: politicalReforms)
+	{
+		issues << '\t' << reform[0] << " = {\n";
+		issues << "\t\tnext_step_only = yes\n";
+		for (int i = 1; i < 5; i++)
+		{
+			if (string(reform[i]) != reform[i - 1])
+			{
+				issues << "\t\t" << reform[i] << " = {\n\t\t}\n";
+			}
+		}
+		issues << "\t}\n";
+	}
+	issues << "}\n";
+
+	issues << "social_reforms = {\n";
+	for (auto reform: socialReforms)
+	{
+		issues << '\t' << reform[0] << " = {\n";
+		issues << "\t\tnext_step_only = yes\n";
+		for (int i = 1; i < 5; i++)
+		{
+			issues << "\t\t" << reform[i] << " = {\n\t\t}\n";
+		}
+		issues << "\t}\n";
+	}
+	issues << "}\n";
+}
+
+
+void Vic2Generator::outputTechnologies()
+{
+	ofstream schools;
+	openOutputFile(installFolder, "common/technology.txt", schools);
+	schools << "folders = {\n";
+	for (auto category: techCategories)
+	{
+		schools << '\t' << category << " = {\n\t}\n";
+	}
+	schools << "}\n";
+	schools << "schools = {\n";
+	for (unsigned int i = 0; i < sizeof(techSchools) / sizeof(techSchools[0]); i++)
+	{
+		schools << '\t' << techSchools[i] << " = {\n";
+		schools << "\t\tarmy_tech_research_bonus = " << ((i == 1) ? "0.15" : "0") << "\n";
+		schools << "\t\tcommerce_tech_research_bonus = 0\n";
+		schools << "\t\tculture_tech_research_bonus = 0\n";
+		schools << "\t\tindustry_tech_research_bonus = 0\n";
+		schools << "\t\tnavy_tech_research_bonus = " << ((i == 2) ? "0.15" : "0") << "\n";
+		schools << "\t}\n";
+	}
+	schools << "}\n";
+
+	for (auto category: techCategories)
+	{
+		ofstream techs;
+		openOutputFile(installFolder, string("technologies/") + category + "_tech.txt", techs);
+		int year = 1836;
+		for (auto technology: technologies)
+		{
+			if (string(technology[0]) == category)
+			{
+				techs << technology[1] << " = {\n";
+				techs << "\tarea = " << category << "\n";
+				techs << "\tyear = " << year << "\n";
+				techs << "\tcost = 3600\n";
+				if (technology[2][0] != '\0')
+				{
+					techs << "\tactivate_building = " << technology[2] << "\n";
+				}
+				techs << "}\n";
+				year += 15;
+			}
+		}
+	}
+}
+
+
+void Vic2Generator::outputInventions()
+{
+	for (auto category: techCategories)
+	{
+		ofstream inventionsFile;
+		openOutputFile(installFolder, string("inventions/") + category + "_inventions.txt", inventionsFile);
+		for (auto invention: inventions)
+		{
+			if (string(invention[0]) == category)
+			{
+				inventionsFile << invention[1] << " = {\n";
+				inventionsFile << "\tlimit = {\n\t}\n";
+				inventionsFile << "\tchance = {\n\t\tbase = 3\n\t}\n";
+				inventionsFile << "\teffect = {\n";
+				if (invention[2][0] != '\0')
+				{
+					inventionsFile << "\t\tactivate_building = " << invention[2] << "\n";
+				}
+				inventionsFile << "\t}\n";
+				inventionsFile << "}\n";
+			}
+		}
+	}
+}
+
+
+void Vic2Generator::outputProductionTypes()
+{
+	ofstream production;
+	openOutputFile(installFolder, "common/production_types.txt", production);
+	for (auto productionType: productionTypes)
+	{
+		production << productionType[0] << " = {\n";
+		production << "\ttype = factory\n";
+		production << "\tinput_goods = {\n\t\t" << productionType[2] << " = 1.0\n\t}\n";
+		production << "\toutput_goods = " << productionType[1] << "\n";
+		production << "\tvalue = 1.0\n";
+		if (string(productionType[0]) == "clipper_shipyard")
+		{
+			production << "\tis_coastal = yes\n";
+		}
+		production << "}\n";
+	}
+}
+
+
+void Vic2Generator::outputProvinceHistories()
+{
+	for (int i = 1; i <= world.getLandProvinceCount(); i++)
+	{
+		const SyntheticProvince& province = world.getProvince(i);
+		const SyntheticCountry& owner = world.getCountries()[province.owner];
+
+		ofstream history;
+		openOutputFile(installFolder, "history/provinces/synthetic/" + to_string(province.id) + " - Province" + to_string(province.id) + ".txt", history);
+		history << "owner = " << owner.tag << "\n";
+		history << "controller = " << owner.tag << "\n";
+		history << "add_core = " << owner.tag << "\n";
+		history << "trade_goods = " << tradeGoods[random.between(0, sizeof(tradeGoods) / sizeof(tradeGoods[0]) - 1)] << "\n";
+		history << "life_rating = " << random.between(20, 40) << "\n";
+		history << "terrain = " << (province.coastal ? "coast" : "plains") << "\n";
+	}
+}
+
+
+void Vic2Generator::outputCountryHistories()
+{
+	for (unsigned int i = 0; i < world.getCountries().size(); i++)
+	{
+		const SyntheticCountry& country = world.getCountries()[i];
+
+		ofstream history;
+		openOutputFile(installFolder, "history/countries/" + country.tag + " - " + country.name + ".txt", history);
+		history << "capital = " << country.capital << "\n";
+		history << "primary_culture = " << world.getCultures()[country.culture].name << "\n";
+		history << "religion = " << world.getReligions()[country.religion].name << "\n";
+		history << "government = " << governments[i % (sizeof(governments) / sizeof(governments[0]))] << "\n";
+		history << "plurality = 0.0\n";
+		history << "nationalvalue = nv_order\n";
+		history << "literacy = 0.2\n";
+		history << "civilized = yes\n";
+		history << "ruling_party = " << country.tag << "_party0\n";
+	}
+}
+
+
+void Vic2Generator::outputMap()
+{
+	// Vic2's coastal provinces are the ones with somewhere to put a naval base
+	ofstream positions;
+	openOutputFile(installFolder, "map/positions.txt", positions);
+	for (int i = 1; i <= world.getLandProvinceCount(); i++)
+	{
+		const SyntheticProvince& province = world.getProvince(i);
+		positions << province.id << " = {\n";
+		positions << "\tunit = { x = " << province.x * 10 << ".000 y = " << province.y * 10 << ".000 }\n";
+		if (province.coastal)
+		{
+			positions << "\tbuilding_position = {\n";
+			positions << "\t\tnaval_base = { x = " << province.x * 10 + 5 << ".000 y = " << province.y * 10 + 5 << ".000 }\n";
+			positions << "\t}\n";
+		}
+		positions << "}\n";
+	}
+
+	ofstream regions;
+	openOutputFile(installFolder, "map/region.txt", regions);
+	for (auto state: world.getStates())
+	{
+		regions << "STATE_" << state.id << " = { ";
+		for (auto province: state.provinces)
+		{
+			regions << province << ' ';
+		}
+		regions << "}\n";
+	}
+
+	writeBinaryAdjacencies(world, installFolder, "map/cache/adjacencies.bin", 9);
+}
+
+
+void Vic2Generator::outputLocalisation()
+{
+	ofstream localisation;
+	openOutputFile(installFolder, "localisation/text.csv", localisation);
+	localisation << "#CODE;ENGLISH;FRENCH;GERMAN;POLISH;SPANISH;x\n";
+	for (auto country: world.getCountries())
+	{
+		localisation << country.tag << ';' << country.name << ';' << country.name << ';' << country.name << ";;" << country.name << ";x\n";
+		localisation << country.tag << "_ADJ;" << country.name << "ian;" << country.name << "ian;" << country.name << "ian;;" << country.name << "ian;x\n";
+	}
+	for (auto province: world.getProvinces())
+	{
+		string name = "Province" + to_string(province.id);
+		localisation << "PROV" << province.id << ';' << name << ';' << name << ';' << name << ";;" << name << ";x\n";
+	}
+	for (auto state: world.getStates())
+	{
+		string name = "State" + to_string(state.id);
+		localisation << "STATE_" << state.id << ';' << name << ';' << name << ';' << name << ";;" << name << ";x\n";
+	}
+}
+
+
+void Vic2Generator::outputBlankMod()
+{
+	// EU4toV2 takes its countries and 1836 pops from its own blankMod rather than the install
+	string blankModFolder = outputFolder + "/EU4toV2";
+
+	ofstream pops;
+	openOutputFile(blankModFolder, "blankMod/output/history/pops/1836.1.1/Synthetic.txt", pops);
+	for (int i = 1; i <= world.getLandProvinceCount(); i++)
+	{
+		const SyntheticProvince& province = world.getProvince(i);
+		const string& culture = world.getCultures()[province.culture].name;
+		const string& religion = world.getReligions()[province.religion].name;
+
+		pops << province.id << " = {\n";
+		pops << "\tfarmers = {\n";
+		pops << "\t\tculture = " << culture << "\n";
+		pops << "\t\treligion = " << religion << "\n";
+		pops << "\t\tsize = " << province.population * 7 / 10 << "\n";
+		pops << "\t}\n";
+		pops << "\tcraftsmen = {\n";
+		pops << "\t\tculture = " << culture << "\n";
+		pops << "\t\treligion = " << religion << "\n";
+		pops << "\t\tsize = " << province.population / 5 << "\n";
+		pops << "\t}\n";
+		pops << "\taristocrats = {\n";
+		pops << "\t\tculture = " << culture << "\n";
+		pops << "\t\treligion = " << religion << "\n";
+		pops << "\t\tsize = " << province.population / 10 << "\n";
+		pops << "\t}\n";
+		pops << "}\n";
+	}
+
+	// the pops have created the output folder by now
+	outputCountries(blankModFolder + "/blankMod/output");
+}
+
+
+void Vic2Generator::outputSave()
+{
+	const vector<SyntheticCountry>& countries = world.getCountries();
+
+	ofstream save;
+	openOutputFile(outputFolder, "saves/synthetic.v2", save);
+	save << "date=\"1936.1.1\"\n";
+	save << "player=\"" << countries[0].tag << "\"\n";
+	save << "government=1\n";
+
+	// the first countries are great nations, counting from 1 at REB. There are eight, as in the base game, until
+	// the world is large enough to have more, as modded games do; the war planning does work for each of them.
+	unsigned int greatNations = max(8u, static_cast<unsigned int>(countries.size() / 16));
+	save << "great_nations=\n{\n";
+	for (unsigned int i = 0; (i < greatNations) && (i < countries.size()); i++)
+	{
+		save << i + 2 << ' ';
+	}
+	save << "\n}\n";
+
+	for (auto province: world.getProvinces())
+	{
+		outputSaveProvince(save, province);
+	}
+
+	save << "REB=\n{\n}\n";
+	for (unsigned int i = 0; i < countries.size(); i++)
+	{
+		outputSaveCountry(save, i);
+	}
+
+	save << "diplomacy=\n{\n";
+	for (unsigned int i = 0; i + 1 < countries.size(); i += 2)
+	{
+		save << "\talliance=\n\t{\n";
+		save << "\t\tfirst=\"" << countries[i].tag << "\"\n";
+		save << "\t\tsecond=\"" << countries[i + 1].tag << "\"\n";
+		save << "\t\tstart_date=\"1900.1.1\"\n";
+		save << "\t}\n";
+	}
+	save << "}\n";
+}
+
+
+void Vic2Generator::outputSaveProvince(ofstream& save, const SyntheticProvince& province)
+{
+	save << province.id << "=\n{\n";
+	save << "\tname=\"Province" << province.id << "\"\n";
+	if (province.isLand)
+	{
+		const SyntheticCountry& owner = world.getCountries()[province.owner];
+		const string& culture = world.getCultures()[province.culture].name;
+		const string& religion = world.getReligions()[province.religion].name;
+
+		save << "\towner=\"" << owner.tag << "\"\n";
+		save << "\tcontroller=\"" << owner.tag << "\"\n";
+		save << "\tcore=\"" << owner.tag << "\"\n";
+		save << "\tfort=\n\t{\n" << random.between(0, 3) << ".000 0.000\n\t}\n";
+		if (province.coastal)
+		{
+			save << "\tnaval_base=\n\t{\n" << random.between(0, 2) << ".000 0.000\n\t}\n";
+		}
+		save << "\trailroad=\n\t{\n" << random.between(0, 5) << ".000 0.000\n\t}\n";
+
+		// the people are spread over every pop type, farmers most of all
+		int remaining = province.population;
+		for (auto popType: popTypes)
+		{
+			int size = (string(popType) == "farmers") ? remaining / 2 : remaining / 10;
+			remaining -= size;
+			save << '\t' << popType << "=\n\t{\n";
+			save << "\t\tid=" << nextPopID++ << "\n";
+			save << "\t\tsize=" << size << "\n";
+			save << '\t' << '\t' << culture << '=' << religion << "\n";
+			save << "\t\tliteracy=" << random.between(10, 90) / 100.0 << "\n";
+			save << "\t}\n";
+		}
+	}
+	save << "}\n";
+}
+
+
+void Vic2Generator::outputSaveCountry(ofstream& save, int countryIndex)
+{
+	const vector<SyntheticCountry>& countries = world.getCountries();
+	const SyntheticCountry& country = countries[countryIndex];
+
+	save << country.tag << "=\n{\n";
+	save << "\tcapital=" << country.capital << "\n";
+	save << "\tprimary_culture=\"" << world.getCultures()[country.culture].name << "\"\n";
+	save << "\treligion=\"" << world.getReligions()[country.religion].name << "\"\n";
+
+	save << "\ttechnology=\n\t{\n";
+	for (auto technology: technologies)
+	{
+		if (random.between(0, 2) != 0)
+		{
+			save << "\t\t" << technology[1] << "=\n\t\t{\n1 0.000\n\t\t}\n";
+		}
+	}
+	save << "\t}\n";
+
+	// Vic2ToHoI4 numbers inventions through the invention files in alphabetical order
+	save << "\tactive_inventions=\n\t{\n";
+	int inventionNum = 1;
+	for (auto category: techCategories)
+	{
+		for (auto invention: inventions)
+		{
+			if (string(invention[0]) == category)
+			{
+				if (random.between(0, 1) == 0)
+				{
+					save << inventionNum << ' ';
+				}
+				inventionNum++;
+			}
+		}
+	}
+	save << "\n\t}\n";
+
+	int firstParty = countryIndex * partiesPerCountry + 1;
+	for (int i = 0; i < partiesPerCountry; i++)
+	{
+		save << "\tactive_party=" << firstParty + i << "\n";
+	}
+	save << "\truling_party=" << firstParty << "\n";
+
+	for (auto reform: politicalReforms)
+	{
+		save << '\t' << reform[0] << '=' << reform[random.between(1, 4)] << "\n";
+	}
+	for (auto reform: socialReforms)
+	{
+		save << '\t' << reform[0] << '=' << reform[random.between(1, 4)] << "\n";
+	}
+
+	save << "\teducation_spending=\n\t{\n\t\tsettings=" << random.between(20, 100) / 100.0 << "\n\t}\n";
+	save << "\tmilitary_spending=\n\t{\n\t\tsettings=" << random.between(20, 100) / 100.0 << "\n\t}\n";
+	save << "\trevanchism=" << random.between(0, 50) / 100.0 << "\n";
+	save << "\twar_exhaustion=" << random.between(0, 20) << ".000\n";
+	save << "\tgovernment=" << governments[countryIndex % (sizeof(governments) / sizeof(governments[0]))] << "\n";
+	save << "\tupper_house=\n\t{\n";
+	save << "\t\tconservative=0.40000\n\t\tliberal=0.30000\n\t\treactionary=0.10000\n\t\tsocialist=0.10000\n\t\tfascist=0.10000\n";
+	save << "\t}\n";
+
+	for (int neighbour: { countryIndex - 1, countryIndex + 1 })
+	{
+		if ((neighbour >= 0) && (neighbour < static_cast<int>(countries.size())))
+		{
+			save << '\t' << countries[neighbour].tag << "=\n\t{\n";
+			save << "\t\tvalue=" << random.between(-200, 200) << "\n";
+			save << "\t\tlevel=3\n";
+			save << "\t}\n";
+		}
+	}
+
+	save << "\tleader=\n\t{\n";
+	save << "\t\tname=\"General " << country.tag << "\"\n";
+	save << "\t\tdate=\"1900.1.1\"\n";
+	save << "\t\ttype=land\n";
+	save << "\t\tpersonality=\"no_personality\"\n";
+	save << "\t\tbackground=\"no_background\"\n";
+	save << "\t\tprestige=" << random.between(0, 100) / 100.0 << "\n";
+	save << "\t}\n";
+
+	save << "\tarmy=\n\t{\n";
+	save << "\t\tname=\"" << country.name << " Army\"\n";
+	save << "\t\tlocation=" << country.capital << "\n";
+	for (int i = 0; i < 12; i++)
+	{
+		save << "\t\tregiment=\n\t\t{\n";
+		save << "\t\t\tname=\"Regiment " << i + 1 << "\"\n";
+		save << "\t\t\ttype=" << regimentTypes[i % (sizeof(regimentTypes) / sizeof(regimentTypes[0]))] << "\n";
+		save << "\t\t\tstrength=3.000\n";
+		save << "\t\t\torganisation=" << random.between(50, 100) << ".000\n";
+		save << "\t\t\texperience=" << random.between(0, 50) << ".000\n";
+		save << "\t\t}\n";
+	}
+	save << "\t}\n";
+
+	for (auto province: country.provinces)
+	{
+		if (world.getProvince(province).coastal)
+		{
+			save << "\tnavy=\n\t{\n";
+			save << "\t\tname=\"" << country.name << " Navy\"\n";
+			save << "\t\tlocation=" << province << "\n";
+			for (int i = 0; i < 6; i++)
+			{
+				save << "\t\tship=\n\t\t{\n";
+				save << "\t\t\tname=\"Ship " << i + 1 << "\"\n";
+				save << "\t\t\ttype=" << shipTypes[i % (sizeof(shipTypes) / sizeof(shipTypes[0]))] << "\n";
+				save << "\t\t\tstrength=100.000\n";
+				save << "\t\t\torganisation=100.000\n";
+				save << "\t\t\texperience=0.000\n";
+				save << "\t\t}\n";
+			}
+			save << "\t}\n";
+			break;
+		}
+	}
+
+	for (auto stateIndex: country.states)
+	{
+		const SyntheticState& state = world.getStates()[stateIndex];
+		save << "\tstate=\n\t{\n";
+		save << "\t\tid=\n\t\t{\n\t\t\tid=" << state.id << "\n\t\t\ttype=47\n\t\t}\n";
+		save << "\t\tprovinces=\n\t\t{\n";
+		for (auto province: state.provinces)
+		{
+			save << province << ' ';
+		}
+		save << "\n\t\t}\n";
+		int factories = random.between(0, 2);
+		for (int i = 0; i < factories; i++)
+		{
+			save << "\t\tstate_buildings=\n\t\t{\n";
+			save << "\t\t\tbuilding=\"" << productionTypes[random.between(0, sizeof(productionTypes) / sizeof(productionTypes[0]) - 1)][0] << "\"\n";
+			save << "\t\t\tlevel=" << random.between(1, 3) << "\n";
+			save << "\t\t}\n";
+		}
+		save << "\t}\n";
+	}
+
+	save << "}\n";
+}
@@ -0,0 +1,78 @@
+/*Copyright (c) 2016 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+
+#ifndef VIC2_GENERATOR_H_
+#define VIC2_GENERATOR_H_
+
+
+
+#include <fstream>
+#include <string>
+#include "SyntheticWorld.h"
+using namespace std;
+
+
+
+// Writes the parts of a Vic2 install that EU4toV2 and Vic2ToHoI4 read, a save of the synthetic world for
+// Vic2ToHoI4, and the EU4toV2 blankMod files that describe the world as it stood in 1836:
+//		<output>/Vic2/						the install
+//		<output>/Vic2Documents/			an empty documents folder
+//		<output>/saves/synthetic.v2
+//		<output>/EU4toV2/blankMod/		pops and countries to copy over the converter's own blankMod
+class Vic2Generator
+{
+	public:
+		Vic2Generator(const SyntheticWorld& world, const string& outputFolder);
+
+		void generate();
+
+	private:
+		void	outputCountries(const string& root);
+		void	outputCultures();
+		void	outputReligions();
+		void	outputIssues();
+		void	outputTechnologies();
+		void	outputInventions();
+		void	outputProductionTypes();
+		void	outputProvinceHistories();
+		void	outputCountryHistories();
+		void	outputMap();
+		void	outputLocalisation();
+
+		void	outputBlankMod();
+
+		void	outputSave();
+		void	outputSaveProvince(ofstream& save, const SyntheticProvince& province);
+		void	outputSaveCountry(ofstream& save, int countryIndex);
+
+		const SyntheticWorld&	world;				// the world to write out
+		string						outputFolder;		// where to write everything
+		string						installFolder;		// where to write the Vic2 install
+		SyntheticRandom			random;				// the source of the save's randomness
+		int							nextPopID;			// the ID to give the next pop
+};
+
+
+
+#endif // VIC2_GENERATOR_H_
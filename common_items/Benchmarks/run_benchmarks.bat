@@ -0,0 +1,75 @@
+echo off
+
+rem Generates synthetic saves at several scales and times EU4toV2, Vic2ToHoI4 and CK2ToEU3 on each of them.
+rem The converters must already be built. Each converter runs in its own copy of its Release folder under
+rem benchmark-work, with the generated files copied over it, so the Release folders are never written to. Each
+rem converter's profile.csv, profile.json and log.txt are collected in benchmarkresults\<scale>, and then zipped.
+rem
+rem CMake builds have the same runs as the benchmark target; see the top-level CMakeLists.txt.
+rem
+rem Usage: run_benchmarks.bat <CK2ToEU3 build folder> [SaveGenerator.exe]
+
+set ck2_path=%~1
+set generator=%~2
+if "%generator%"=="" set generator=%CD%\SaveGenerator.exe
+set old_path=%CD%
+set eu4_path=%old_path%\..\..\EU4toV2\Release
+set vic2_path=%old_path%\..\..\Vic2ToHoI4\Release
+set work=%old_path%\benchmark-work
+
+for /f %%p in ('dir /b benchmarkresults\') do call rmdir benchmarkresults\%%p /s /q
+rmdir benchmarkresults
+mkdir benchmarkresults\
+rmdir "%work%" /s /q
+mkdir "%work%"
+
+for %%s in (1 4 16) do call :benchmark %%s
+
+cd "%old_path%\benchmarkresults"
+call "%SEVENZIP_LOC%\7z.exe" a -tzip -r "..\benchmarkresults.zip" "*.*" -mx5
+cd "%old_path%"
+rmdir "%work%" /s /q
+goto :eof
+
+
+:benchmark
+set scale=%1
+set out=%work%\synthetic-%scale%
+set results=%old_path%\benchmarkresults\%scale%
+mkdir "%results%"
+
+echo Generating the scale %scale% saves
+call "%generator%" "%out%" %scale%
+
+rem the real pops are for the real map's provinces, which the synthetic saves don't have
+call :run "%eu4_path%" EU4toV2 EU4toV2Converter.exe synthetic.eu4 "blankMod\output\history\pops\1836.1.1"
+call :run "%vic2_path%" Vic2ToHoI4 V2ToHoI4Converter.exe synthetic.v2
+call :run "%ck2_path%" CK2ToEU3 ConverterApp.exe synthetic.ck2
+
+rmdir "%out%" /s /q
+goto :eof
+
+
+rem Runs a converter on the synthetic save in a copy of its folder, with an optional folder of the copy deleted
+rem before the generated files are copied over it
+rem
+rem Usage: call :run <converter folder> <name> <executable> <save> [folder to delete]
+:run
+echo Timing %2 at scale %scale%
+set run=%work%\%2-%scale%
+xcopy "%~1" "%run%" /E /Q /Y /I
+if not "%~5"=="" rmdir "%run%\%~5" /s /q
+xcopy "%out%\%2" "%run%" /E /Q /Y /I
+cd "%run%"
+call %3 "%out%\saves\%4"
+call :collect "%run%" %2
+cd "%old_path%"
+rmdir "%run%" /s /q
+goto :eof
+
+
+:collect
+copy "%~1\profile.csv" "%results%\%2-profile.csv"
+copy "%~1\profile.json" "%results%\%2-profile.json"
+copy "%~1\log.txt" "%results%\%2-log.txt"
+goto :eof
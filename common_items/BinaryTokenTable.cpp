@@ -0,0 +1,97 @@
+/*Copyright (c) 2016 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+
+#include "BinaryTokenTable.h"
+#include "Log.h"
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+
+
+BinaryTokenTable::BinaryTokenTable():
+	names(0x10000),
+	dates(0x10000, false)
+{
+}
+
+
+bool BinaryTokenTable::load(const string& filename)
+{
+	ifstream tokenFile(filename);
+	if (!tokenFile.is_open())
+	{
+		LOG(LogLevel::Error) << "Could not open the binary token file " << filename;
+		return false;
+	}
+
+	int lineNumber = 0;	// the line being read, for reporting errors
+	string line;
+	while (getline(tokenFile, line))
+	{
+		lineNumber++;
+		istringstream fields(line);
+		string idText, name, type;
+		if (!(fields >> idText) || (idText[0] == '#'))
+		{
+			continue;
+		}
+		fields >> name >> type;
+
+		unsigned long id;	// the token id
+		try
+		{
+			id = stoul(idText, nullptr, 0);
+		}
+		catch (const exception&)
+		{
+			id = 0x10000;
+		}
+		if ((id >= 0x10000) || name.empty())
+		{
+			LOG(LogLevel::Warning) << "Skipping malformed line " << lineNumber << " in " << filename;
+			continue;
+		}
+
+		names[id] = name;
+		dates[id] = (type == "date");
+	}
+
+	return true;
+}
+
+
+size_t BinaryTokenTable::getBinaryHeaderLength(const char* begin, const char* end)
+{
+	static const char* const headers[] = { "EU4bin", "CK2bin", "HOI4bin" };	// the headers of the games' binary saves
+	for (auto header: headers)
+	{
+		const size_t length = strlen(header);	// the length of this header
+		if ((static_cast<size_t>(end - begin) >= length) && (memcmp(begin, header, length) == 0))
+		{
+			return length;
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,67 @@
+/*Copyright (c) 2016 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+
+#ifndef BINARY_TOKEN_TABLE_H_
+#define BINARY_TOKEN_TABLE_H_
+
+
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+using namespace std;
+
+
+
+// The names behind the token ids in binary (ironman) saves. Binary saves replace every key and keyword
+// with a 16-bit id, and the game does not ship the list of ids, so it comes from a text file with one
+// token per line:
+//
+//		<id> <name> [date]
+//
+// The id may be decimal or hex (0x...). 'date' marks keys whose integer values are dates, which binary
+// saves store as a count of hours. Blank lines and lines starting with # are ignored.
+class BinaryTokenTable
+{
+	public:
+		BinaryTokenTable();
+
+		// Reads a token file. Returns false and logs an error if it could not be read.
+		bool	load(const string& filename);
+
+		// The name of a token, or nullptr if the table does not have it
+		const string*	getName(uint16_t id) const	{ return (names[id].empty() ? nullptr : &names[id]); }
+		bool				isDate(uint16_t id) const	{ return dates[id]; }
+
+		// The length of the header that marks a binary save, such as 'EU4bin', or 0 if the buffer is not one
+		static size_t	getBinaryHeaderLength(const char* begin, const char* end);
+
+	private:
+		vector<string>	names;	// the name of each token id, empty if unknown
+		vector<bool>	dates;	// whether or not each token id is a key for dates
+};
+
+
+
+#endif // BINARY_TOKEN_TABLE_H_
@@ -19,6 +19,11 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 
 #include <boost/filesystem.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <thread>
 #include "OSCompatibilityLayer.h"
 
 
@@ -39,4 +44,26 @@ namespace Utils
 
 		return "";
 	}
+
+
+	bool WriteFileAtomically(const std::string& path, const std::string& contents)
+	{
+		// write to a name no other thread or process will use, then move it into place in one step
+		static std::atomic<unsigned int> filesWritten(0);	// makes the temporary names unique within this process
+		const std::string temporaryPath = path + "." +
+			std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + "." +
+			std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()) + "." +
+			std::to_string(filesWritten++);
+
+		std::ofstream file(temporaryPath, std::ios::binary);
+		file.write(contents.data(), contents.size());
+		file.close();
+		if (file.fail() || !TryReplaceFile(temporaryPath, path))
+		{
+			std::remove(temporaryPath.c_str());
+			return false;
+		}
+
+		return true;
+	}
 }
\ No newline at end of file
@@ -21,219 +21,143 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 
 
+
 #include "Date.h"
-#include <vector>
+#include <cctype>
 #include "Object.h"
+#include "OSCompatibilityLayer.h"
 using namespace std;
 
 
 
-date::date(string _init)
+// Reads a number from the start of text the way stoi does, skipping leading spaces and stopping at the first
+// character that isn't a digit, without copying text into a string first
+static bool parseNumber(boost::string_ref text, int& number)
 {
-	if (_init.length() < 1)
+	size_t position = 0;	// the current position in the text
+	while ((position < text.size()) && isspace(static_cast<unsigned char>(text[position])))
 	{
-		return;
+		position++;
 	}
 
-	if (_init[0] == '\"')
+	bool negative = false;	// whether or not the number has a minus sign
+	if ((position < text.size()) && ((text[position] == '-') || (text[position] == '+')))
 	{
-		_init = _init.substr(1, _init.length() - 2);
+		negative = (text[position] == '-');
+		position++;
 	}
-	const int first_dot	= _init.find_first_of('.');	// the position of the first period in the date
-	const int last_dot	= _init.find_last_of('.');		// the position of the second period in the date
 
-	try
+	const size_t firstDigit = position;	// where the digits start
+	number = 0;
+	while ((position < text.size()) && (text[position] >= '0') && (text[position] <= '9'))
 	{
-		year						= stoi( _init.substr(0, first_dot) );
-		month						= stoi( _init.substr(first_dot + 1, last_dot - first_dot) );
-		day						= stoi( _init.substr(last_dot + 1, 2) );
+		number = number * 10 + (text[position] - '0');
+		position++;
 	}
-	catch (const std::exception& e)
+	if (negative)
 	{
-		year = 0;
-		month = 0;
-		day = 0;
+		number = -number;
 	}
+
+	return (position > firstDigit);
 }
 
 
-date::date(const date& _init)
+date::date(boost::string_ref _init)
 {
-	year = _init.year;
-	month = _init.month;
-	day = _init.day;
-}
+	packed = pack(1, 1, 1);
+	if (_init.length() < 1)
+	{
+		return;
+	}
 
-date& date::operator=(const date& _rhs)
-{
-	year = _rhs.year;
-	month = _rhs.month;
-	day = _rhs.day;
-	return *this;
+	if (_init[0] == '\"')
+	{
+		_init = _init.substr(1, _init.length() - 2);
+	}
+	const size_t first_dot	= _init.find_first_of('.');	// the position of the first period in the date
+	const size_t last_dot	= _init.find_last_of('.');		// the position of the second period in the date
+
+	int year;	// the year read from the text
+	int month;	// the month read from the text
+	int day;		// the day read from the text
+	if (
+			(first_dot == boost::string_ref::npos) ||
+			!parseNumber(_init.substr(0, first_dot), year) ||
+			!parseNumber(_init.substr(first_dot + 1, last_dot - first_dot), month) ||
+			!parseNumber(_init.substr(last_dot + 1, 2), day)
+		)
+	{
+		packed = pack(0, 0, 0);
+		return;
+	}
+	packed = pack(year, month, day);
 }
 
+
 date::date(const Object* _init)
 {
-	vector<Object*> dateSubObj = _init->getValue("year");	// the date within the larger object
-	if (dateSubObj.size() > 0)
+	Object* yearObj = _init->getFirst("year");	// the year, if the date is given as year=, month=, day=
+	if (yearObj != nullptr)
 	{
-		// date specified by year=, month=, day=
-		year	= stoi(_init->getLeaf("year"));
-		month	= stoi(_init->getLeaf("month"));
-		day	= stoi(_init->getLeaf("day"));
+		packed = pack(stoi(yearObj->getLeaf()), stoi(_init->getLeaf("month")), stoi(_init->getLeaf("day")));
 	}
 	else
 	{
 		// date specified by year.month.day
-		// build another date object via date(string&) and copy it to this one
-		(*this) = date(_init->getLeaf());
+		packed = date(_init->getLeaf()).packed;
 	}
 }
 
-bool date::operator==(const date& _rhs) const
-{
-	return ((year == _rhs.year)
-		 && (month == _rhs.month)
-		 && (day == _rhs.day));
-}
-
-bool date::operator!=(const date& _rhs) const
-{
-	return !(*this == _rhs);
-}
 
-bool date::operator<(const date& _rhs) const
+ostream& operator<<(ostream& out, const date& d)
 {
-	return ((year < _rhs.year)
-		|| ((year == _rhs.year) && (month < _rhs.month))
-		|| ((year == _rhs.year) && (month == _rhs.month) && (day < _rhs.day)));
+	out << d.getYear() << '.' << d.getMonth() << '.' << d.getDay();
+	return out;
 }
 
-bool date::operator>(const date& _rhs) const
-{
-	return ((year > _rhs.year)
-		|| ((year == _rhs.year) && (month > _rhs.month))
-		|| ((year == _rhs.year) && (month == _rhs.month) && (day > _rhs.day)));
-}
 
-bool date::operator<=(const date& _rhs) const
+void date::addYears(int years)
 {
-	return ((*this == _rhs) || (*this < _rhs));
-}
-
-bool date::operator>=(const date& _rhs) const
-{ 
-	return ((*this == _rhs) || (*this > _rhs));
+	packed = pack(getYear() + years, getMonth(), getDay());
 }
 
-ostream& operator<<(ostream& out, const date& d)
-{
-	out << d.year << '.' << d.month << '.' << d.day;
-	return out;
-}
 
-float date::diffInYears(const date& _rhs) const
+void date::addMonths(int months)
 {
-	float years = float(year - _rhs.year);	// the difference in years
-
-	int lhsDays;	// the number of says into the year on the left-hand side
-	switch (month)
+	int year		= getYear();			// the new year
+	int month	= getMonth() + months;	// the new month, before wrapping into the year
+	while (month > 12)
 	{
-		case 1:
-			lhsDays = day;
-			break;
-		case 2:
-			lhsDays = day + 31;
-			break;
-		case 3:
-			lhsDays = day + 59;
-			break;
-		case 4:
-			lhsDays = day + 90;
-			break;
-		case 5:
-			lhsDays = day + 120;
-			break;
-		case 6:
-			lhsDays = day + 151;
-			break;
-		case 7:
-			lhsDays = day + 181;
-			break;
-		case 8:
-			lhsDays = day + 212;
-			break;
-		case 9:
-			lhsDays = day + 243;
-			break;
-		case 10:
-			lhsDays = day + 273;
-			break;
-		case 11:
-			lhsDays = day + 304;
-			break;
-		case 12:
-		default:
-			lhsDays = day + 334;
-			break;
+		month -= 12;
+		year++;
 	}
-
-	int rhsDays;	// the number of says into the year on the right-hand side
-	switch (month)
+	while (month < 1)
 	{
-		case 1:
-			rhsDays = day;
-			break;
-		case 2:
-			rhsDays = day + 31;
-			break;
-		case 3:
-			rhsDays = day + 59;
-			break;
-		case 4:
-			rhsDays = day + 90;
-			break;
-		case 5:
-			rhsDays = day + 120;
-			break;
-		case 6:
-			rhsDays = day + 151;
-			break;
-		case 7:
-			rhsDays = day + 181;
-			break;
-		case 8:
-			rhsDays = day + 212;
-			break;
-		case 9:
-			rhsDays = day + 243;
-			break;
-		case 10:
-			rhsDays = day + 273;
-			break;
-		case 11:
-			rhsDays = day + 304;
-			break;
-		case 12:
-		default:
-			rhsDays = day + 334;
-			break;
+		month += 12;
+		year--;
 	}
+	packed = pack(year, month, getDay());
+}
 
-	years += (lhsDays - rhsDays) / 365;
 
-	return years;
+float date::diffInYears(const date& _rhs) const
+{
+	// only whole years count, as the part-year difference was always truncated away
+	return float(getYear() - _rhs.getYear());
 }
 
+
 bool date::isSet() const
 {
 	const date default_date;	// an instance with the default date
 	return (*this != default_date);
 }
 
+
 string date::toString() const
 {
 	char buf[16];	// a buffer to temporarily hold the formatted string
-	sprintf_s(buf, 16, "%d.%d.%d", year, month, day);
+	sprintf_s(buf, 16, "%d.%d.%d", getYear(), getMonth(), getDay());
 	return string(buf);
-}
\ No newline at end of file
+}
@@ -21,42 +21,62 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 
 
+
 #ifndef DATE_H_
 #define DATE_H_
 
+#include <cstdint>
 #include <iostream>
 #include <string>
+#include <boost/utility/string_ref.hpp>
 using namespace std;
 
 
 
 class Object;
 
+// A date packed into 32 bits, with the year in the high half and the month and day in a byte each below it, so
+// that comparing two dates is comparing two integers. Fixed dates can be built at compile time with the
+// (year, month, day) constructor rather than parsed from a string each time they are used.
 struct date
 {
-	date() : year(1), month(1), day(1) {};
-	date(string _init);
-	date(const date& _init);
+	constexpr date() : packed(pack(1, 1, 1)) {};
+	constexpr date(int year, int month, int day) : packed(pack(year, month, day)) {};
+	date(boost::string_ref _init);
+	date(const string& _init) : date(boost::string_ref(_init)) {};
+	date(const char* _init) : date(boost::string_ref(_init)) {};
 	date(const Object* _init);
 
-	date& operator=(const date& _rhs);
-	bool operator==(const date& _rhs) const;
-	bool operator!=(const date& _rhs) const;
-	bool operator<(const date& _rhs) const;
-	bool operator>(const date& _rhs) const;
-	bool operator<=(const date& _rhs) const;
-	bool operator>=(const date& _rhs) const;
+	bool operator==(const date& _rhs) const	{ return packed == _rhs.packed; }
+	bool operator!=(const date& _rhs) const	{ return packed != _rhs.packed; }
+	bool operator<(const date& _rhs) const		{ return packed < _rhs.packed; }
+	bool operator>(const date& _rhs) const		{ return packed > _rhs.packed; }
+	bool operator<=(const date& _rhs) const	{ return packed <= _rhs.packed; }
+	bool operator>=(const date& _rhs) const	{ return packed >= _rhs.packed; }
 
 	friend ostream& operator<<(ostream&, const date&);
-	
+
+	int getYear() const	{ return static_cast<int>(packed >> 16) - yearBias; }
+	int getMonth() const	{ return (packed >> 8) & 0xFF; }
+	int getDay() const	{ return packed & 0xFF; }
+
+	void addYears(int years);
+	void addMonths(int months);
+
 	float diffInYears(const date& _rhs) const;
 
 	bool isSet() const;
 	string toString() const;
 
-	int year;		// the year
-	int month;		// the month
-	int day;			// the day
+	private:
+		static const int yearBias = 32768;	// added to the year so that years before 1 still sort first
+
+		static constexpr uint32_t pack(int year, int month, int day)
+		{
+			return (static_cast<uint32_t>(year + yearBias) << 16) | ((static_cast<uint32_t>(month) & 0xFF) << 8) | (static_cast<uint32_t>(day) & 0xFF);
+		}
+
+		uint32_t packed;	// the year, month and day
 };
 
-#endif // _DATE_H
\ No newline at end of file
+#endif // _DATE_H
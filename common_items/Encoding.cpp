@@ -0,0 +1,354 @@
+/*Copyright (c) 2016 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+
+#include "Encoding.h"
+#include <cstdint>
+#include <cstring>
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#define ENCODING_USE_SSE2
+#include <emmintrin.h>
+#endif
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+
+
+namespace
+{
+
+const uint32_t replacementCharacter = 0xFFFD;	// what malformed text becomes
+
+
+// The code points of 8859-15's upper half. It is Latin-1 apart from the eight characters it swapped out for
+// the euro sign and some letters for French, Finnish and Estonian.
+const uint16_t upper8859_15[128] =
+{
+	0x0080, 0x0081, 0x0082, 0x0083, 0x0084, 0x0085, 0x0086, 0x0087, 0x0088, 0x0089, 0x008A, 0x008B, 0x008C, 0x008D, 0x008E, 0x008F,
+	0x0090, 0x0091, 0x0092, 0x0093, 0x0094, 0x0095, 0x0096, 0x0097, 0x0098, 0x0099, 0x009A, 0x009B, 0x009C, 0x009D, 0x009E, 0x009F,
+	0x00A0, 0x00A1, 0x00A2, 0x00A3, 0x20AC, 0x00A5, 0x0160, 0x00A7, 0x0161, 0x00A9, 0x00AA, 0x00AB, 0x00AC, 0x00AD, 0x00AE, 0x00AF,
+	0x00B0, 0x00B1, 0x00B2, 0x00B3, 0x017D, 0x00B5, 0x00B6, 0x00B7, 0x017E, 0x00B9, 0x00BA, 0x00BB, 0x0152, 0x0153, 0x0178, 0x00BF,
+	0x00C0, 0x00C1, 0x00C2, 0x00C3, 0x00C4, 0x00C5, 0x00C6, 0x00C7, 0x00C8, 0x00C9, 0x00CA, 0x00CB, 0x00CC, 0x00CD, 0x00CE, 0x00CF,
+	0x00D0, 0x00D1, 0x00D2, 0x00D3, 0x00D4, 0x00D5, 0x00D6, 0x00D7, 0x00D8, 0x00D9, 0x00DA, 0x00DB, 0x00DC, 0x00DD, 0x00DE, 0x00DF,
+	0x00E0, 0x00E1, 0x00E2, 0x00E3, 0x00E4, 0x00E5, 0x00E6, 0x00E7, 0x00E8, 0x00E9, 0x00EA, 0x00EB, 0x00EC, 0x00ED, 0x00EE, 0x00EF,
+	0x00F0, 0x00F1, 0x00F2, 0x00F3, 0x00F4, 0x00F5, 0x00F6, 0x00F7, 0x00F8, 0x00F9, 0x00FA, 0x00FB, 0x00FC, 0x00FD, 0x00FE, 0x00FF
+};
+
+
+// The 8859-15 byte for a code point, or 0 if it has none
+unsigned char to8859_15(uint32_t codePoint)
+{
+	switch (codePoint)
+	{
+		case 0x20AC:	return 0xA4;
+		case 0x0160:	return 0xA6;
+		case 0x0161:	return 0xA8;
+		case 0x017D:	return 0xB4;
+		case 0x017E:	return 0xB8;
+		case 0x0152:	return 0xBC;
+		case 0x0153:	return 0xBD;
+		case 0x0178:	return 0xBE;
+		case 0x00A4:
+		case 0x00A6:
+		case 0x00A8:
+		case 0x00B4:
+		case 0x00B8:
+		case 0x00BC:
+		case 0x00BD:
+		case 0x00BE:	return 0;	// the Latin-1 characters 8859-15 replaced
+		default:			return (codePoint < 0x100) ? static_cast<unsigned char>(codePoint) : 0;
+	}
+}
+
+
+unsigned int countTrailingZeros(unsigned int bits)
+{
+#ifdef _MSC_VER
+	unsigned long index;
+	_BitScanForward(&index, bits);
+	return index;
+#else
+	return __builtin_ctz(bits);
+#endif
+}
+
+
+void appendCodePointAsUTF8(uint32_t codePoint, string& UTF8)
+{
+	if (codePoint < 0x80)
+	{
+		UTF8.push_back(static_cast<char>(codePoint));
+	}
+	else if (codePoint < 0x800)
+	{
+		UTF8.push_back(static_cast<char>(0xC0 | (codePoint >> 6)));
+		UTF8.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+	}
+	else if (codePoint < 0x10000)
+	{
+		UTF8.push_back(static_cast<char>(0xE0 | (codePoint >> 12)));
+		UTF8.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+		UTF8.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+	}
+	else
+	{
+		UTF8.push_back(static_cast<char>(0xF0 | (codePoint >> 18)));
+		UTF8.push_back(static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F)));
+		UTF8.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+		UTF8.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+	}
+}
+
+
+void appendCodePointAsUTF16(uint32_t codePoint, wstring& UTF16)
+{
+	if ((sizeof(wchar_t) == 2) && (codePoint >= 0x10000))
+	{
+		codePoint -= 0x10000;
+		UTF16.push_back(static_cast<wchar_t>(0xD800 | (codePoint >> 10)));
+		UTF16.push_back(static_cast<wchar_t>(0xDC00 | (codePoint & 0x3FF)));
+	}
+	else
+	{
+		UTF16.push_back(static_cast<wchar_t>(codePoint));
+	}
+}
+
+
+// Decodes the (non-ASCII) character at position and moves past it. A malformed sequence gives the replacement
+// character and moves past its first byte only.
+uint32_t decodeUTF8(const char*& position, const char* end)
+{
+	const unsigned char lead = static_cast<unsigned char>(*position);
+	int length;				// the number of bytes in the sequence
+	uint32_t codePoint;	// the character so far
+	uint32_t minimum;		// the smallest character that needs this many bytes, as anything less is overlong
+	if ((lead & 0xE0) == 0xC0)
+	{
+		length		= 2;
+		codePoint	= lead & 0x1F;
+		minimum		= 0x80;
+	}
+	else if ((lead & 0xF0) == 0xE0)
+	{
+		length		= 3;
+		codePoint	= lead & 0x0F;
+		minimum		= 0x800;
+	}
+	else if ((lead & 0xF8) == 0xF0)
+	{
+		length		= 4;
+		codePoint	= lead & 0x07;
+		minimum		= 0x10000;
+	}
+	else
+	{
+		position++;
+		return replacementCharacter;
+	}
+
+	if (end - position < length)
+	{
+		position++;
+		return replacementCharacter;
+	}
+	for (int i = 1; i < length; i++)
+	{
+		const unsigned char continuation = static_cast<unsigned char>(position[i]);
+		if ((continuation & 0xC0) != 0x80)
+		{
+			position++;
+			return replacementCharacter;
+		}
+		codePoint = (codePoint << 6) | (continuation & 0x3F);
+	}
+	if ((codePoint < minimum) || (codePoint > 0x10FFFF) || ((codePoint >= 0xD800) && (codePoint <= 0xDFFF)))
+	{
+		position++;
+		return replacementCharacter;
+	}
+
+	position += length;
+	return codePoint;
+}
+
+}
+
+
+
+size_t Encoding::countASCII(const char* begin, const char* end)
+{
+	const char* position = begin;	// how far the text has been checked
+
+#ifdef ENCODING_USE_SSE2
+	for (; end - position >= 32; position += 32)
+	{
+		const __m128i low		= _mm_loadu_si128(reinterpret_cast<const __m128i*>(position));
+		const __m128i high	= _mm_loadu_si128(reinterpret_cast<const __m128i*>(position + 16));
+		const unsigned int mask = static_cast<unsigned int>(_mm_movemask_epi8(_mm_or_si128(low, high)));	// which bytes (of either half) have their top bit set
+		if (mask != 0)
+		{
+			const unsigned int lowMask = static_cast<unsigned int>(_mm_movemask_epi8(low));	// which bytes in the first half do
+			if (lowMask != 0)
+			{
+				return (position - begin) + countTrailingZeros(lowMask);
+			}
+			return (position - begin) + 16 + countTrailingZeros(static_cast<unsigned int>(_mm_movemask_epi8(high)));
+		}
+	}
+	if (end - position >= 16)
+	{
+		const unsigned int mask = static_cast<unsigned int>(_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(position))));
+		if (mask != 0)
+		{
+			return (position - begin) + countTrailingZeros(mask);
+		}
+		position += 16;
+	}
+#else
+	for (; end - position >= 8; position += 8)
+	{
+		uint64_t word;
+		memcpy(&word, position, 8);
+		if ((word & 0x8080808080808080ULL) != 0)
+		{
+			break;
+		}
+	}
+#endif
+
+	while ((position < end) && (static_cast<unsigned char>(*position) < 0x80))
+	{
+		position++;
+	}
+	return position - begin;
+}
+
+
+void Encoding::append8859_15AsUTF8(const char* begin, const char* end, string& UTF8)
+{
+	UTF8.reserve(UTF8.size() + (end - begin));
+	while (begin < end)
+	{
+		const size_t ASCIILength = countASCII(begin, end);
+		UTF8.append(begin, ASCIILength);
+		begin += ASCIILength;
+
+		for (; (begin < end) && (static_cast<unsigned char>(*begin) >= 0x80); ++begin)
+		{
+			appendCodePointAsUTF8(upper8859_15[static_cast<unsigned char>(*begin) - 0x80], UTF8);
+		}
+	}
+}
+
+
+void Encoding::append8859_15AsUTF16(const char* begin, const char* end, wstring& UTF16)
+{
+	UTF16.reserve(UTF16.size() + (end - begin));
+	for (; begin < end; ++begin)
+	{
+		const unsigned char character = static_cast<unsigned char>(*begin);
+		UTF16.push_back(static_cast<wchar_t>((character < 0x80) ? character : upper8859_15[character - 0x80]));
+	}
+}
+
+
+void Encoding::appendUTF8AsUTF16(const char* begin, const char* end, wstring& UTF16)
+{
+	UTF16.reserve(UTF16.size() + (end - begin));
+	while (begin < end)
+	{
+		const char* ASCIIEnd = begin + countASCII(begin, end);	// where the run of ASCII ends
+		for (; begin < ASCIIEnd; ++begin)
+		{
+			UTF16.push_back(static_cast<wchar_t>(*begin));
+		}
+
+		while ((begin < end) && (static_cast<unsigned char>(*begin) >= 0x80))
+		{
+			appendCodePointAsUTF16(decodeUTF8(begin, end), UTF16);
+		}
+	}
+}
+
+
+void Encoding::appendUTF16AsUTF8(const wchar_t* begin, const wchar_t* end, string& UTF8)
+{
+	UTF8.reserve(UTF8.size() + (end - begin));
+	while (begin < end)
+	{
+		uint32_t codePoint = static_cast<uint32_t>(*begin++);	// the character to append
+		if (codePoint < 0x80)
+		{
+			UTF8.push_back(static_cast<char>(codePoint));
+			continue;
+		}
+
+		if ((codePoint >= 0xD800) && (codePoint <= 0xDFFF))
+		{
+			const bool pairs = (sizeof(wchar_t) == 2) && (codePoint <= 0xDBFF) && (begin < end) && (*begin >= 0xDC00) && (*begin <= 0xDFFF);	// whether or not this is the first half of a surrogate pair
+			if (pairs)
+			{
+				codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (static_cast<uint32_t>(*begin++) - 0xDC00);
+			}
+			else
+			{
+				codePoint = replacementCharacter;
+			}
+		}
+		else if (codePoint > 0x10FFFF)
+		{
+			codePoint = replacementCharacter;
+		}
+		appendCodePointAsUTF8(codePoint, UTF8);
+	}
+}
+
+
+bool Encoding::appendUTF8As8859_15(const char* begin, const char* end, string& output, char replacement)
+{
+	bool allConverted = true;	// whether or not every character had an 8859-15 equivalent
+	output.reserve(output.size() + (end - begin));
+	while (begin < end)
+	{
+		const size_t ASCIILength = countASCII(begin, end);
+		output.append(begin, ASCIILength);
+		begin += ASCIILength;
+
+		while ((begin < end) && (static_cast<unsigned char>(*begin) >= 0x80))
+		{
+			const unsigned char character = to8859_15(decodeUTF8(begin, end));
+			if (character != 0)
+			{
+				output.push_back(static_cast<char>(character));
+			}
+			else
+			{
+				output.push_back(replacement);
+				allConverted = false;
+			}
+		}
+	}
+	return allConverted;
+}
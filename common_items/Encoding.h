@@ -0,0 +1,59 @@
+/*Copyright (c) 2016 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+
+#ifndef ENCODING_H_
+#define ENCODING_H_
+
+
+
+#include <string>
+using namespace std;
+
+
+
+// Conversions between the text encodings the games use: ISO 8859-15 for older games' files, UTF-8 for newer
+// ones and internally, and UTF-16 (or UTF-32, wherever wchar_t is four bytes) for the Windows API. Almost all
+// game text is ASCII, which reads the same in all of them, so each conversion skips through ASCII runs 16 or 32
+// bytes at a time and only looks at the rest a character at a time. The conversions work on whole buffers and
+// append to their output, so a file can be converted in one call and output buffers can be reused.
+//
+// Malformed UTF-8 and unpaired UTF-16 surrogates become U+FFFD, as the Windows API would make them.
+namespace Encoding
+{
+	// How many characters at the start of the text are ASCII
+	size_t	countASCII(const char* begin, const char* end);
+	inline bool	isASCII(const char* begin, const char* end) { return (countASCII(begin, end) == static_cast<size_t>(end - begin)); }
+
+	void	append8859_15AsUTF8(const char* begin, const char* end, string& UTF8);
+	void	append8859_15AsUTF16(const char* begin, const char* end, wstring& UTF16);
+	void	appendUTF8AsUTF16(const char* begin, const char* end, wstring& UTF16);
+	void	appendUTF16AsUTF8(const wchar_t* begin, const wchar_t* end, string& UTF8);
+
+	// Characters with no 8859-15 equivalent are each replaced by replacement. Returns false if there were any.
+	bool	appendUTF8As8859_15(const char* begin, const char* end, string& output, char replacement);
+}
+
+
+
+#endif // ENCODING_H_
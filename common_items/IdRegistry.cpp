@@ -0,0 +1,181 @@
+/*Copyright (c) 2016 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+
+#include "IdRegistry.h"
+#include <functional>
+#include <stdexcept>
+
+
+
+namespace
+{
+
+const size_t initialIndexCapacity = 1024;	// the number of slots in the first index, enough for every vanilla tag
+
+
+size_t hashTag(const string& tag)
+{
+	return hash<string>()(tag);
+}
+
+}
+
+
+
+const TagId TagRegistry::invalidId;
+
+
+TagRegistry& TagRegistry::getInstance()
+{
+	static TagRegistry instance;
+	return instance;
+}
+
+
+TagRegistry::Index::Index(size_t _capacity):
+	capacity(_capacity),
+	slots(new atomic<TagId>[_capacity])
+{
+	for (size_t i = 0; i < capacity; i++)
+	{
+		slots[i].store(invalidId, memory_order_relaxed);
+	}
+}
+
+
+TagRegistry::TagRegistry():
+	registryMutex(),
+	tagChunks(),
+	tagCount(0),
+	index(nullptr),
+	indexes()
+{
+	indexes.push_back(unique_ptr<Index>(new Index(initialIndexCapacity)));
+	index.store(indexes.back().get(), memory_order_release);
+}
+
+
+TagId TagRegistry::GetId(const string& tag)
+{
+	const size_t tagHash = hashTag(tag);	// where the tag's search starts in an index
+	const TagId existingId = find(*index.load(memory_order_acquire), tag, tagHash);	// the tag's ID, if it is already registered
+	if (existingId != invalidId)
+	{
+		return existingId;
+	}
+
+	lock_guard<mutex> lock(registryMutex);
+	Index* currentIndex = index.load(memory_order_relaxed);	// only changed under the lock
+	const TagId racedId = find(*currentIndex, tag, tagHash);	// the tag's ID, if another thread registered it first
+	if (racedId != invalidId)
+	{
+		return racedId;
+	}
+
+	const TagId id = tagCount.load(memory_order_relaxed);	// the new tag's ID
+	if (id >= chunkSize * maxChunks)
+	{
+		throw runtime_error("Too many country tags to register " + tag);
+	}
+	if (id % chunkSize == 0)
+	{
+		tagChunks[id / chunkSize].reset(new string[chunkSize]);
+	}
+	tagChunks[id / chunkSize][id % chunkSize] = tag;
+	tagCount.store(id + 1, memory_order_release);
+
+	// keep the index at most half full, so searches stay short
+	if ((id + 1) * 2 > currentIndex->capacity)
+	{
+		unique_ptr<Index> biggerIndex(new Index(currentIndex->capacity * 2));	// the replacement index
+		for (TagId existing = 0; existing < id; existing++)
+		{
+			place(*biggerIndex, existing, hashTag(tagChunks[existing / chunkSize][existing % chunkSize]));
+		}
+		place(*biggerIndex, id, tagHash);
+		indexes.push_back(move(biggerIndex));
+		index.store(indexes.back().get(), memory_order_release);
+	}
+	else
+	{
+		place(*currentIndex, id, tagHash);
+	}
+	return id;
+}
+
+
+TagId TagRegistry::FindId(const string& tag)
+{
+	return find(*index.load(memory_order_acquire), tag, hashTag(tag));
+}
+
+
+const string& TagRegistry::GetTag(TagId id)
+{
+	static const string noTag;
+
+	if (id >= tagCount.load(memory_order_acquire))
+	{
+		return noTag;
+	}
+	return tagChunks[id / chunkSize][id % chunkSize];
+}
+
+
+size_t TagRegistry::Size()
+{
+	return tagCount.load(memory_order_acquire);
+}
+
+
+TagId TagRegistry::find(const Index& searchIndex, const string& tag, size_t hash) const
+{
+	const size_t mask = searchIndex.capacity - 1;
+	for (size_t i = hash & mask; ; i = (i + 1) & mask)
+	{
+		// a slot is filled only after its tag is stored, so the tag can be read once the slot is seen
+		const TagId id = searchIndex.slots[i].load(memory_order_acquire);	// the ID of the tag in this slot
+		if (id == invalidId)
+		{
+			return invalidId;
+		}
+		if (tagChunks[id / chunkSize][id % chunkSize] == tag)
+		{
+			return id;
+		}
+	}
+}
+
+
+// Called with registryMutex held
+void TagRegistry::place(Index& targetIndex, TagId id, size_t hash)
+{
+	const size_t mask = targetIndex.capacity - 1;
+	size_t i = hash & mask;	// the slot to try
+	while (targetIndex.slots[i].load(memory_order_relaxed) != invalidId)
+	{
+		i = (i + 1) & mask;
+	}
+	targetIndex.slots[i].store(id, memory_order_release);
+}
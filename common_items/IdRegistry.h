@@ -0,0 +1,162 @@
+/*Copyright (c) 2016 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+
+#ifndef ID_REGISTRY_H_
+#define ID_REGISTRY_H_
+
+
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+using namespace std;
+
+
+
+// A country tag's dense ID, handed out by the TagRegistry
+typedef uint32_t TagId;
+
+
+
+// Gives every country tag the converter meets a small, dense ID, in the order the tags are first seen. The IDs
+// are shared by the whole process, so the same tag has the same ID in the source and destination worlds, and
+// tables keyed by tag can be DenseIdMaps indexed by ID instead of maps searched by string.
+//
+// Registering a tag takes a lock, but looking one up does not: the tags are kept in an append-only table, and
+// the index from tag to ID is an open-addressed table whose slots are published atomically, so the mappers can
+// be queried from the parallel phases without serializing on the registry.
+//
+// Province numbers need no registry: every game already numbers its provinces densely from 1, so they are used
+// as IDs directly.
+class TagRegistry
+{
+	public:
+		static const TagId invalidId = 0xFFFFFFFF;
+
+		// The tag's ID, registering the tag if it is new
+		static TagId			getId(const string& tag)		{ return getInstance().GetId(tag); }
+		// The tag's ID, or invalidId if it was never registered
+		static TagId			findId(const string& tag)		{ return getInstance().FindId(tag); }
+		// The tag with the ID, or "" if no tag has it. The reference stays valid for the rest of the run.
+		static const string&	getTag(TagId id)					{ return getInstance().GetTag(id); }
+		static size_t			size()								{ return getInstance().Size(); }
+
+	private:
+		static TagRegistry&	getInstance();
+		TagRegistry();
+		TagRegistry(const TagRegistry&);
+		TagRegistry& operator=(const TagRegistry&);
+
+		// An index from tags to IDs. Readers probe it without a lock; a full index is replaced by a bigger one
+		// rather than rehashed in place, and kept until the registry is destroyed in case a reader is still in it.
+		struct Index
+		{
+			explicit Index(size_t _capacity);
+
+			size_t						capacity;	// the number of slots, always a power of two
+			unique_ptr<atomic<TagId>[]>	slots;		// the ID of the tag hashed to each slot, or invalidId if empty
+		};
+
+		TagId				GetId(const string& tag);
+		TagId				FindId(const string& tag);
+		const string&	GetTag(TagId id);
+		size_t			Size();
+
+		TagId				find(const Index& index, const string& tag, size_t hash) const;
+		void				place(Index& index, TagId id, size_t hash);
+
+		static const size_t chunkSize	= 256;		// the number of tags in each chunk of the tag table
+		static const size_t maxChunks	= 1024;		// the most chunks the tag table can have
+
+		mutex								registryMutex;			// serializes registering tags
+		unique_ptr<string[]>			tagChunks[maxChunks];	// the tag with each ID, in chunks that are never moved or freed
+		atomic<TagId>					tagCount;				// the number of registered tags, published after the tag itself
+		atomic<Index*>					index;					// the current index from tags to IDs
+		vector<unique_ptr<Index>>	indexes;					// every index built so far, including the current one
+};
+
+
+
+// A table from dense IDs (such as TagIds or province numbers) to values, held in a vector indexed by ID. Looking
+// a value up is an array index rather than a tree search.
+template<class T>
+class DenseIdMap
+{
+	public:
+		DenseIdMap(): values(), present(), count(0) {}
+
+		// Adds the value unless the ID already has one, as map::insert would. Returns whether it was added.
+		bool insert(size_t id, const T& value)
+		{
+			if ((id < present.size()) && present[id])
+			{
+				return false;
+			}
+			set(id, value);
+			return true;
+		}
+
+		void set(size_t id, const T& value)
+		{
+			if (id >= present.size())
+			{
+				values.resize(id + 1);
+				present.resize(id + 1, false);
+			}
+			if (!present[id])
+			{
+				present[id] = true;
+				count++;
+			}
+			values[id] = value;
+		}
+
+		// The ID's value, or nullptr if it has none
+		const T* find(size_t id) const
+		{
+			return ((id < present.size()) && present[id]) ? &values[id] : nullptr;
+		}
+
+		bool		contains(size_t id) const	{ return (find(id) != nullptr); }
+		size_t	size() const					{ return count; }
+
+		void clear()
+		{
+			values.clear();
+			present.clear();
+			count = 0;
+		}
+
+	private:
+		vector<T>		values;	// the value for each ID, or a default-constructed one if it has none
+		vector<bool>	present;	// whether or not each ID has a value
+		size_t			count;	// how many IDs have values
+};
+
+
+
+#endif // ID_REGISTRY_H_
@@ -16,16 +16,22 @@ CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
 TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
 SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
-#include "OSCompatabilityLayer.h"
+#include "OSCompatibilityLayer.h"
+#include "Encoding.h"
 
 #include <iostream>
 #include <stdarg.h>
 #include <stdio.h>
+#include <stdlib.h>
 
 #include <boost/system/error_code.hpp>
 #include <boost/filesystem.hpp>
 
 #include <iconv.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 static boost::system::error_code lastError;
 
@@ -33,7 +39,7 @@ void sprintf_s_Linux (char *__restrict __s, size_t __maxlen, const char *__restr
 {
   va_list argptr;
   va_start(argptr, __format);
-  snprintf(__s, __maxlen, __format, argptr);
+  vsnprintf(__s, __maxlen, __format, argptr);
   va_end(argptr);
 }
 
@@ -52,7 +58,7 @@ void fprintf_s_Linux(FILE* file, const char* format, ...)
 {
   va_list argptr;
   va_start(argptr, format);
-  fprintf(file, format, argptr);
+  vfprintf(file, format, argptr);
   va_end(argptr);
 }
 
@@ -68,9 +74,42 @@ namespace Utils
       return doesFolderExist(path) || boost::filesystem::create_directory(path, lastError);
   }
   
-  void getCurrentDirectory(uint32_t length, char directory[MAX_PATH])
+  std::string getCurrentDirectory()
   {
-    boost::filesystem::current_path(directory, lastError);
+    return boost::filesystem::current_path(lastError).string();
+  }
+
+  void GetAllFilesInFolder(const std::string& path, std::set<std::string>& fileNames)
+  {
+    boost::filesystem::directory_iterator entry(path, lastError);
+    for(; !lastError && entry != boost::filesystem::directory_iterator(); entry.increment(lastError))
+    {
+      if(!boost::filesystem::is_directory(entry->status()))
+        fileNames.insert(entry->path().filename().string());
+    }
+  }
+
+  // Names are relative to path and start with a '/', as on Windows
+  void GetAllFilesInFolderRecursive(const std::string& path, std::set<std::string>& filenames)
+  {
+    if(!doesFolderExist(path))
+    {
+      LOG(LogLevel::Error) << "Could not open directory " << path;
+      exit(-1);
+    }
+
+    const size_t prefixLength = boost::filesystem::path(path).string().size();
+    boost::filesystem::recursive_directory_iterator entry(path, lastError);
+    for(; !lastError && entry != boost::filesystem::recursive_directory_iterator(); entry.increment(lastError))
+    {
+      if(!boost::filesystem::is_directory(entry->status()))
+      {
+        std::string relativePath = entry->path().string().substr(prefixLength);
+        if(relativePath.empty() || relativePath[0] != '/')
+          relativePath.insert(0, "/");
+        filenames.insert(relativePath);
+      }
+    }
   }
   
   bool TryCopyFile(const std::string& sourcePath, const std::string& destPath)
@@ -80,6 +119,47 @@ namespace Utils
     return prevError == lastError;
   }
   
+  bool copyFolder(const std::string& sourceFolder, const std::string& destFolder)
+  {
+    boost::filesystem::path source(sourceFolder);
+    boost::filesystem::recursive_directory_iterator entry(source, lastError);
+    boost::filesystem::create_directories(destFolder, lastError);
+    for(; !lastError && entry != boost::filesystem::recursive_directory_iterator(); entry.increment(lastError))
+    {
+      boost::filesystem::path destination = destFolder / boost::filesystem::relative(entry->path(), source, lastError);
+      if(boost::filesystem::is_directory(entry->status()))
+        boost::filesystem::create_directories(destination, lastError);
+      else
+        boost::filesystem::copy_file(entry->path(), destination, boost::filesystem::copy_option::overwrite_if_exists, lastError);
+    }
+
+    if(lastError)
+      LOG(LogLevel::Error) << "Could not copy " << sourceFolder << " to " << destFolder << ". " << lastError.message();
+    return true;
+  }
+
+  bool renameFolder(const std::string& sourceFolder, const std::string& destFolder)
+  {
+    boost::filesystem::rename(sourceFolder, destFolder, lastError);
+    if(lastError)
+    {
+      LOG(LogLevel::Error) << "Could not rename " << sourceFolder << " to " << destFolder << ". " << lastError.message();
+      return false;
+    }
+    return true;
+  }
+
+  bool deleteFolder(const std::string& folder)
+  {
+    boost::filesystem::remove_all(folder, lastError);
+    if(lastError)
+    {
+      LOG(LogLevel::Error) << "Could not delete " << folder << ". " << lastError.message();
+      return false;
+    }
+    return true;
+  }
+
   bool DoesFileExist(const std::string& path)
   {
     return boost::filesystem::exists(path, lastError) && boost::filesystem::is_regular_file(path, lastError);
@@ -90,6 +170,32 @@ namespace Utils
     return boost::filesystem::exists(path, lastError) && boost::filesystem::is_directory(path, lastError);
   }
   
+  bool GetFileStamp(const std::string& path, FileStamp& stamp)
+  {
+    struct stat fileStats;
+    if(stat(path.c_str(), &fileStats) == -1 || !S_ISREG(fileStats.st_mode))
+      return false;
+
+    char* fullPath = realpath(path.c_str(), nullptr);
+    if(fullPath == nullptr)
+      return false;
+
+    stamp.absolutePath = fullPath;
+    free(fullPath);
+    stamp.size = fileStats.st_size;
+    stamp.modifiedTime = static_cast<int64_t>(fileStats.st_mtim.tv_sec) * 1000000000 + fileStats.st_mtim.tv_nsec;
+    return true;
+  }
+
+  bool TryReplaceFile(const std::string& sourcePath, const std::string& destPath)
+  {
+    if(rename(sourcePath.c_str(), destPath.c_str()) == 0)
+      return true;
+
+    LOG(LogLevel::Warning) << "Could not replace " << destPath << " with " << sourcePath;
+    return false;
+  }
+  
   int FromMultiByte(const char* in, size_t inSize, wchar_t* out, size_t outSize)
   {
     if(outSize == 0)
@@ -123,8 +229,98 @@ namespace Utils
     }
   }
   
-  std::string GetLastError()
+  std::string GetLastErrorString()
   {
     return lastError.message();
   }
-}
\ No newline at end of file
+
+  MappedFile::MappedFile(const std::string& path):
+    opened(false),
+    data(nullptr),
+    size(0),
+    fileHandle(nullptr),
+    mappingHandle(nullptr)
+  {
+    int fd = open(path.c_str(), O_RDONLY);
+    if(fd == -1)
+      return;
+
+    struct stat fileStats;
+    if(fstat(fd, &fileStats) == -1)
+    {
+      close(fd);
+      return;
+    }
+
+    size = fileStats.st_size;
+    if(size == 0)
+    {
+      data = "";
+      opened = true;
+      close(fd);
+      return;
+    }
+
+    void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if(mapping == MAP_FAILED)
+    {
+      LOG(LogLevel::Warning) << "Could not map " << path;
+      size = 0;
+      return;
+    }
+    madvise(mapping, size, MADV_SEQUENTIAL);
+    data = static_cast<const char*>(mapping);
+    opened = true;
+  }
+
+  MappedFile::~MappedFile()
+  {
+    if(data != nullptr && size > 0)
+      munmap(const_cast<char*>(data), size);
+  }
+
+  std::string convertUTF8ToASCII(std::string UTF8)
+  {
+    std::wstring wide = convertUTF8ToUTF16(UTF8);
+    std::string ASCII;
+    for(auto character: wide)
+      ASCII.push_back((character < 0x80) ? static_cast<char>(character) : '0');
+    return ASCII;
+  }
+
+  std::string convertUTF8To8859_15(std::string UTF8)
+  {
+    std::string converted;
+    Encoding::appendUTF8As8859_15(UTF8.data(), UTF8.data() + UTF8.size(), converted, '0');
+    return converted;
+  }
+
+  std::string convertUTF16ToUTF8(std::wstring UTF16)
+  {
+    std::string UTF8;
+    Encoding::appendUTF16AsUTF8(UTF16.data(), UTF16.data() + UTF16.size(), UTF8);
+    return UTF8;
+  }
+
+  std::string convert8859_15ToUTF8(std::string input)
+  {
+    std::string UTF8;
+    Encoding::append8859_15AsUTF8(input.data(), input.data() + input.size(), UTF8);
+    return UTF8;
+  }
+
+  std::wstring convert8859_15ToUTF16(std::string string8859_15)
+  {
+    std::wstring UTF16;
+    Encoding::append8859_15AsUTF16(string8859_15.data(), string8859_15.data() + string8859_15.size(), UTF16);
+    return UTF16;
+  }
+
+  std::wstring convertUTF8ToUTF16(std::string UTF8)
+  {
+    std::wstring UTF16;
+    Encoding::appendUTF8AsUTF16(UTF8.data(), UTF8.data() + UTF8.size(), UTF16);
+    return UTF16;
+  }
+}
@@ -23,9 +23,13 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 #include "Log.h"
 #include "OSCompatibilityLayer.h"
+#include <condition_variable>
 #include <ctime>
 #include <fstream>
 #include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 
 
@@ -33,61 +37,269 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 
 
-Log::Log(LogLevel level)
-: logLevel(level)
+namespace
 {
-	static bool logFileCreated = false;	// whether or not the log file has been created this run of the converter
-	if (!logFileCreated)
-	{
-		std::ofstream logFile("log.txt", std::ofstream::trunc);
-		logFileCreated = true;
-	}
+
+// Passes messages from the threads that log them to a single writer thread. Logging threads claim slots in a
+// fixed ring without taking a lock (a bounded multi-producer queue, with a sequence number per slot), and
+// only wait if the writer has fallen a whole ring behind.
+class LogWriter
+{
+	public:
+		LogWriter():
+			slots(ringSize),
+			enqueuePosition(0),
+			dequeuePosition(0),
+			writtenCount(0),
+			logFile("log.txt", std::ofstream::trunc),
+			lastTimestamp(-1),
+			stopping(false)
+		{
+			for (size_t i = 0; i < ringSize; i++)
+			{
+				slots[i].sequence.store(i, std::memory_order_relaxed);
+			}
+			writer = std::thread(&LogWriter::writeLoop, this);
+		}
+
+		~LogWriter()
+		{
+			{
+				std::lock_guard<std::mutex> lock(waitMutex);
+				stopping = true;
+			}
+			messagesReady.notify_one();
+			writer.join();
+		}
+
+		static LogWriter& get()
+		{
+			static LogWriter writer;
+			return writer;
+		}
+
+		// Queues a message, and returns its position in the order messages are written
+		size_t push(LogLevel level, std::string&& message)
+		{
+			size_t position = enqueuePosition.load(std::memory_order_relaxed);	// the slot being claimed
+			Slot* slot;
+			while (true)
+			{
+				slot = &slots[position & (ringSize - 1)];
+				const size_t sequence = slot->sequence.load(std::memory_order_acquire);
+				if (sequence == position)
+				{
+					if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+					{
+						break;
+					}
+				}
+				else if (sequence < position)
+				{
+					// the ring is full, so give the writer a chance to catch up
+					messagesReady.notify_one();
+					std::this_thread::yield();
+					position = enqueuePosition.load(std::memory_order_relaxed);
+				}
+				else
+				{
+					position = enqueuePosition.load(std::memory_order_relaxed);
+				}
+			}
+
+			slot->level		= level;
+			slot->time		= std::time(nullptr);
+			slot->message	= std::move(message);
+			slot->sequence.store(position + 1, std::memory_order_release);
+
+			// the writer also checks the ring regularly, so it only needs waking once it starts to fill up
+			if ((position & (ringSize / 4 - 1)) == 0)
+			{
+				messagesReady.notify_one();
+			}
+			return position;
+		}
+
+		// Waits until the message at position, and everything before it, has been written
+		void waitUntilWritten(size_t position)
+		{
+			std::unique_lock<std::mutex> lock(waitMutex);
+			messagesReady.notify_one();
+			messagesWritten.wait(lock, [&]{ return (writtenCount.load(std::memory_order_acquire) > position); });
+		}
+
+		void flush()
+		{
+			const size_t position = enqueuePosition.load(std::memory_order_acquire);	// the next message to be logged
+			if (position > 0)
+			{
+				waitUntilWritten(position - 1);
+			}
+		}
+
+	private:
+		static const size_t ringSize = 4096;	// the number of messages that can wait to be written (a power of two)
+
+		struct Slot
+		{
+			std::atomic<size_t>	sequence;	// the position this slot holds next, plus one once the message is in
+			LogLevel					level;		// the message's level
+			time_t					time;			// when the message was logged
+			std::string				message;		// the message, ending in a line break
+		};
+
+		void writeLoop()
+		{
+			std::string message;	// the message being written
+			while (true)
+			{
+				bool wroteAny = false;	// whether or not anything was written this pass
+				while (true)
+				{
+					Slot& slot = slots[dequeuePosition & (ringSize - 1)];
+					if (slot.sequence.load(std::memory_order_acquire) != dequeuePosition + 1)
+					{
+						break;
+					}
+					const LogLevel level	= slot.level;
+					const time_t time		= slot.time;
+					message.swap(slot.message);
+					slot.sequence.store(dequeuePosition + ringSize, std::memory_order_release);
+					dequeuePosition++;
+
+					Utils::WriteToConsole(level, message);
+					writeToFile(level, time, message);
+					writtenCount.store(dequeuePosition, std::memory_order_release);
+					wroteAny = true;
+				}
+
+				std::unique_lock<std::mutex> lock(waitMutex);
+				if (wroteAny)
+				{
+					logFile.flush();
+					messagesWritten.notify_all();
+					continue;
+				}
+				if (stopping)
+				{
+					return;
+				}
+				messagesReady.wait_for(lock, std::chrono::milliseconds(20));
+			}
+		}
+
+		void writeToFile(LogLevel level, time_t time, const std::string& logMessage)
+		{
+			// many messages are logged each second, so the timestamp is only formatted when the second changes
+			if (time != lastTimestamp)
+			{
+				lastTimestamp = time;
+				timestamp.clear();
+				tm* timeInfo = localtime(&time); // the processed time data
+				if (timeInfo) // whether or not there was an error
+				{
+					char timeBuffer[64];	// the formatted time
+					size_t bytesWritten = strftime(timeBuffer, 64, "%Y-%m-%d %H:%M:%S ", timeInfo);	// the number of digits for the time stamp
+					timestamp.assign(timeBuffer, bytesWritten);
+				}
+			}
+			logFile << timestamp;
+
+			switch (level)
+			{
+				case LogLevel::Error:
+					logFile << "  [ERROR] ";
+					break;
+
+				case LogLevel::Warning:
+					logFile << "[WARNING] ";
+					break;
+
+				case LogLevel::Info:
+					logFile << "   [INFO] ";
+					break;
+
+				case LogLevel::Debug:
+					logFile << "  [DEBUG]     ";	// Debug messages are extra indented to further de-emphasize them.
+					break;
+			}
+			logFile << logMessage;
+		}
+
+		std::vector<Slot>		slots;				// the ring of messages waiting to be written
+		std::atomic<size_t>	enqueuePosition;	// the position of the next message to be logged
+		size_t					dequeuePosition;	// the position of the next message to be written
+		std::atomic<size_t>	writtenCount;		// the number of messages written so far
+
+		std::ofstream			logFile;				// log.txt, open for the whole run
+		time_t					lastTimestamp;		// the time last formatted into timestamp
+		std::string				timestamp;			// the formatted time of the last message written
+
+		std::mutex				waitMutex;			// guards stopping, and lets threads wait for the writer
+		std::condition_variable	messagesReady;		// wakes the writer when messages are waiting
+		std::condition_variable	messagesWritten;	// signalled whenever the writer catches up
+		bool						stopping;			// whether or not the writer should finish up and exit
+		std::thread				writer;				// the thread writing out messages
+};
+
 }
 
 
-Log::~Log()
+
+std::atomic<LogLevel> Log::enabledLevel(LogLevel::Debug);
+
+
+
+Log::Log(LogLevel level)
+: logLevel(level)
 {
-	logMessageStream << std::endl;
-	std::string logMessage = logMessageStream.str();
-	Utils::WriteToConsole(logLevel, logMessage);
-	WriteToFile(logLevel, logMessage);
+	LogWriter::get();	// so that log.txt is recreated at the start of the run, even if nothing is logged yet
 }
 
 
-void Log::WriteToFile(LogLevel level, const std::string& logMessage)
+Log::~Log()
 {
-	std::ofstream logFile("log.txt", std::ofstream::app);
-
-	time_t rawtime;	// the raw time data
-	time(&rawtime);
-	tm* timeInfo = localtime(&rawtime); // the processed time data
-	if (timeInfo) // whether or not there was an error
+	if (!isEnabled(logLevel))
 	{
-		char timeBuffer[64];	// the formatted time
-		size_t bytesWritten = strftime(timeBuffer, 64, "%Y-%m-%d %H:%M:%S ", timeInfo);	// the number of digits for the time stamp
-		if (bytesWritten != 0)
-		{
-			logFile << timeBuffer;
-		}
+		return;
 	}
 
-	switch (level)
+	logMessageStream << '\n';
+	const size_t position = LogWriter::get().push(logLevel, logMessageStream.str());	// where the message is in the log
+	if (logLevel == LogLevel::Error)
 	{
-		case LogLevel::Error:
-			logFile << "  [ERROR] ";
-			break;
-
-		case LogLevel::Warning:
-			logFile << "[WARNING] ";
-			break;
+		LogWriter::get().waitUntilWritten(position);
+	}
+}
 
-		case LogLevel::Info:
-			logFile << "   [INFO] ";
-			break;
 
-		case LogLevel::Debug:
-			logFile << "  [DEBUG]     ";	// Debug messages are extra indented to further de-emphasize them.
-			break;
+bool Log::setLevel(const std::string& levelName)
+{
+	if (levelName == "error")
+	{
+		setLevel(LogLevel::Error);
+	}
+	else if (levelName == "warning")
+	{
+		setLevel(LogLevel::Warning);
 	}
-	logFile << logMessage;
+	else if (levelName == "info")
+	{
+		setLevel(LogLevel::Info);
+	}
+	else if (levelName == "debug")
+	{
+		setLevel(LogLevel::Debug);
+	}
+	else
+	{
+		return false;
+	}
+	return true;
 }
+
+
+void Log::flush()
+{
+	LogWriter::get().flush();
+}
\ No newline at end of file
@@ -26,12 +26,20 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 
 
+#include <atomic>
 #include <sstream>
 #include <string>
 
 
 
-#define LOG(LOG_LEVEL) Log(LOG_LEVEL)
+// Messages less important than this are compiled out entirely. Define it as, say, LogLevel::Info to build
+// a converter without any debug logging.
+#ifndef LOG_COMPILED_LEVEL
+#define LOG_COMPILED_LEVEL LogLevel::Debug
+#endif
+
+// Messages at disabled levels are never formatted, so a disabled LOG costs a single comparison
+#define LOG(LOG_LEVEL) if (!Log::isEnabled(LOG_LEVEL)) {} else Log(LOG_LEVEL)
 
 
 
@@ -45,6 +53,9 @@ enum class LogLevel
 
 
 
+// A single message for the log. Messages are handed to a background thread that writes them to the console
+// and log.txt, so logging does not wait on either. Errors are the exception: they are written before the
+// Log is destroyed, so that they are not lost if the converter then exits or crashes.
 class Log
 {
 	public:
@@ -52,17 +63,30 @@ class Log
 		~Log();
 
 		template<class T>
-		Log& operator<<(T t)
+		Log& operator<<(const T& t)
 		{
 			logMessageStream << t;
 			return *this;
 		}
 
-	private:
-		static void WriteToFile(LogLevel, const std::string& logMessage);
+		static bool isEnabled(LogLevel level)
+		{
+			return ((level <= LOG_COMPILED_LEVEL) && (level <= enabledLevel.load(std::memory_order_relaxed)));
+		}
 
+		// Sets the least important level that will be logged. The name form takes "error", "warning", "info"
+		// or "debug", and returns false for anything else.
+		static void setLevel(LogLevel level)	{ enabledLevel.store(level, std::memory_order_relaxed); }
+		static bool setLevel(const std::string& levelName);
+
+		// Waits until every message logged so far has been written
+		static void flush();
+
+	private:
 		LogLevel logLevel;							// the current log level
 		std::ostringstream logMessageStream;	// the output stream to the log file
+
+		static std::atomic<LogLevel> enabledLevel;	// the least important level that is logged
 };
 
 #endif // LOG_H_
\ No newline at end of file
@@ -52,7 +52,7 @@ void strcpy_s_Linux(char *__restrict __dest, const char *__restrict __src);
 
 //Very basic implementation, simply returns 0 if FILE* is not NULL
 #define fopen_s fopen_s_Linux
-int fopen_s_Linux(FILE* file, const char* filename, const char* mode);
+int fopen_s_Linux(FILE** file, const char* filename, const char* mode);
 
 #define fprintf_s fprintf_s_Linux
 void fprintf_s_Linux(FILE* file, const char* format, ...);
@@ -93,6 +93,24 @@ namespace Utils
 	// Returns true if the specified folder exists (and is a folder rather than a file).
 	bool doesFolderExist(const std::string& path);
 
+	// What identifies the current contents of a file without reading it.
+	struct FileStamp
+	{
+		std::string	absolutePath;	// the full path to the file
+		uint64_t		size;				// the size of the file in bytes
+		int64_t		modifiedTime;	// when the file was last written, in the OS's own units
+	};
+	// Fills in stamp for the specified file. Returns false if it is not a file that exists.
+	bool GetFileStamp(const std::string& path, FileStamp& stamp);
+	// Moves sourcePath to destPath, replacing any file already there in a single step so that nobody
+	// reading destPath ever sees a partly written file.
+	// Returns false and logs a warning on failure.
+	bool TryReplaceFile(const std::string& sourcePath, const std::string& destPath);
+	// Writes contents to path through a temporary file that is then moved into place with TryReplaceFile, so
+	// that other threads and processes see either the old file or all of the new one.
+	// Returns false, leaving no temporary file behind, on failure.
+	bool WriteFileAtomically(const std::string& path, const std::string& contents);
+
 	void WriteToConsole(LogLevel level, const std::string& logMessage);
 
 	// Returns a formatted string describing the last error on the WinAPI.
@@ -109,6 +127,30 @@ namespace Utils
 	std::string convert8859_15ToUTF8(std::string input);
 	std::wstring convert8859_15ToUTF16(std::string UTF8);
 	std::wstring convertUTF8ToUTF16(std::string UTF8);
+
+
+	// A read-only view of the entire contents of a file, memory-mapped so that the
+	// file is never copied. The view is unmapped when the MappedFile is destroyed.
+	class MappedFile
+	{
+		public:
+			explicit MappedFile(const std::string& path);
+			~MappedFile();
+
+			bool			isOpen() const	{ return opened; }
+			const char*	getData() const	{ return data; }
+			size_t		getSize() const	{ return size; }
+
+		private:
+			MappedFile(const MappedFile&);
+			MappedFile& operator=(const MappedFile&);
+
+			bool			opened;				// whether or not the file could be opened
+			const char*	data;					// the contents of the file
+			size_t		size;					// the size of the file in bytes
+			void*			fileHandle;			// the OS handle for the open file
+			void*			mappingHandle;		// the OS handle for the mapping, where the OS has one
+	};
 } // namespace Utils
 
 
@@ -45,23 +45,92 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 #include "Object.h"
 #include "Log.h"
-#include "ParadoxParser8859_15.h"
-#include "ParadoxParserUTF8.h"
+#include "ObjectArena.h"
+#include "OSCompatibilityLayer.h"
 #include <sstream> 
 #include <fstream>
 #include <algorithm>
+#include <unordered_set>
 #include <iostream>
 #include <assert.h>
+#include <cstdint>
 
 
 
+static const size_t allocationHeaderSize = 8;	// space before each Object recording where it was allocated, which keeps the Object 8-byte aligned
+static const uintptr_t fromArenaFlag = 1;			// set in an allocation header if the Object is in an arena rather than on the heap
+static const size_t minimumIndexedSize = 16;		// objects with fewer children than this are scanned instead of indexed
+const vector<Object*> ObjectRange::emptyChildren;
+
+
+// Each Object is preceded by a header holding the arena the Object owns, if any, with fromArenaFlag set if the
+// Object itself was allocated from an arena. Arenas are pointer-aligned, so the flag never clashes with them.
+static uintptr_t& allocationHeader(void* object)
+{
+	static_assert(sizeof(uintptr_t) <= allocationHeaderSize, "an allocation header must fit before the Object");
+	return *reinterpret_cast<uintptr_t*>(static_cast<char*>(object) - allocationHeaderSize);
+}
+
+
+static bool keyLess(const Object* object, const string* key)
+{
+	return &object->getKey() < key;
+}
+
+
+static bool keyGreater(const string* key, const Object* object)
+{
+	return key < &object->getKey();
+}
+
+
+ObjectRange::iterator::iterator(vector<Object*>::const_iterator _current, vector<Object*>::const_iterator _end, const string* _key) :
+current(_current),
+end(_end),
+key(_key)
+{
+	skipOtherKeys();
+}
+
+
+ObjectRange::iterator& ObjectRange::iterator::operator++()
+{
+	++current;
+	skipOtherKeys();
+	return *this;
+}
+
+
+void ObjectRange::iterator::skipOtherKeys()
+{
+	while ((current != end) && (&(*current)->getKey() != key))
+	{
+		++current;
+	}
+}
+
+
 Object::Object(string k) :
 objects(),
 strVal(),
 leaf(false),
-isObjList(false)
+isObjList(false),
+isTopLevel(false),
+index(nullptr)
+{
+	key = internKey(k);
+}
+
+
+Object::Object(const string* internedKey) :
+key(internedKey),
+strVal(),
+objects(),
+leaf(false),
+isObjList(false),
+isTopLevel(false),
+index(nullptr)
 {
-	key = k;
 }
 
 
@@ -74,6 +143,7 @@ Object::~Object() {
 	{
 		br = 0;
 	}
+	delete index.load(memory_order_relaxed);
 }
 
 
@@ -81,7 +151,10 @@ Object::Object(Object* other) :
 objects(),
 strVal(other->strVal),
 leaf(other->leaf),
-isObjList(other->isObjList)
+isObjList(other->isObjList),
+isTopLevel(other->isTopLevel),
+tokens(other->tokens),
+index(nullptr)
 {
 	key = other->key;
 	for (vector<Object*>::iterator i = other->objects.begin(); i != other->objects.end(); ++i)
@@ -91,6 +164,49 @@ isObjList(other->isObjList)
 }
 
 
+void* Object::operator new(size_t size)
+{
+	ObjectArena* arena = ObjectArena::getActive();	// the arena to allocate from, if any
+	char* memory;												// the memory for the object and its header
+	if (arena != nullptr)
+	{
+		memory = static_cast<char*>(arena->allocate(size + allocationHeaderSize));
+	}
+	else
+	{
+		memory = static_cast<char*>(::operator new(size + allocationHeaderSize));
+	}
+	void* object = memory + allocationHeaderSize;		// where the object itself goes
+	allocationHeader(object) = (arena != nullptr) ? fromArenaFlag : 0;
+	return object;
+}
+
+
+void Object::adoptArena(ObjectArena* arena)
+{
+	uintptr_t& header = allocationHeader(this);	// where this object's arena is recorded
+	header = reinterpret_cast<uintptr_t>(arena) | (header & fromArenaFlag);
+}
+
+
+void Object::operator delete(void* object)
+{
+	if (object == nullptr)
+	{
+		return;
+	}
+
+	// the destructor has already deleted the children, so an arena they came from can now be released. Objects from
+	// an arena are released along with that arena rather than one at a time.
+	const uintptr_t header = allocationHeader(object);	// where the object came from and the arena it owns
+	delete reinterpret_cast<ObjectArena*>(header & ~fromArenaFlag);
+	if ((header & fromArenaFlag) == 0)
+	{
+		::operator delete(static_cast<char*>(object) - allocationHeaderSize);
+	}
+}
+
+
 void Object::setValue(string val)
 {
 	strVal = val;
@@ -100,6 +216,7 @@ void Object::setValue(string val)
 
 void Object::setValue(Object* val)
 {
+	clearIndex();
 	objects.push_back(val);
 	leaf = false;
 }
@@ -107,6 +224,7 @@ void Object::setValue(Object* val)
 
 void Object::unsetValue(string val)
 {
+	clearIndex();
 	for (unsigned int i = 0; i < objects.size(); ++i)
 	{
 		if (objects[i]->getKey() != val)
@@ -129,6 +247,7 @@ void Object::setLeaf(string key, string val)
 
 void Object::setValue(vector<Object*> val)
 {
+	clearIndex();
 	objects = val;
 }
 
@@ -136,16 +255,6 @@ void Object::setValue(vector<Object*> val)
 void Object::addToList(string val)
 {
 	isObjList = true;
-	if (strVal.size() > 0)
-	{
-		strVal += " \"";
-	}
-	else
-	{
-		strVal += "\"";
-	}
-	strVal += val;
-	strVal += "\"";
 	tokens.push_back(val);
 }
 
@@ -153,35 +262,84 @@ void Object::addToList(string val)
 void Object::addToList(vector<string>::iterator begin, vector<string>::iterator end)
 {
 	isObjList = true;
-	for (vector<string>::iterator itr = begin; itr != end; ++itr)
+	tokens.insert(tokens.end(), begin, end);
+}
+
+
+vector<Object*> Object::getValue(const string& key) const
+{
+	ObjectRange range = getRange(key);	// the objects with this key
+	return vector<Object*>(range.begin(), range.end());
+}
+
+
+ObjectRange Object::getRange(const string& key) const
+{
+	if (objects.size() < minimumIndexedSize)
 	{
-		if (strVal.size() > 0)
-		{
-			strVal += "\" \"";
-		}
-		else
+		// the first match supplies the interned key, so the rest of the range only compares pointers
+		for (auto itr = objects.begin(); itr != objects.end(); ++itr)
 		{
-			strVal += "\"";
+			if ((*itr)->getKey() == key)
+			{
+				return ObjectRange(itr, objects.end(), &(*itr)->getKey());
+			}
 		}
-		strVal += *itr;
+		return ObjectRange();
 	}
-	strVal += "\"";
-	tokens.insert(tokens.end(), begin, end);
+
+	const string* internedKey = findInternedKey(key);	// the shared copy of the key, which all matching children point to
+	if (internedKey == nullptr)
+	{
+		return ObjectRange();
+	}
+
+	const vector<Object*>* sortedObjects = getIndex();	// the children sorted by key
+	auto lowerItr = lower_bound(sortedObjects->begin(), sortedObjects->end(), internedKey, keyLess);
+	auto upperItr = upper_bound(lowerItr, sortedObjects->end(), internedKey, keyGreater);
+	return ObjectRange(lowerItr, upperItr, internedKey);
 }
 
 
-vector<Object*> Object::getValue(string key) const
+Object* Object::getFirst(const string& key) const
 {
-	vector<Object*> ret;	// the objects to return
-	for (vector<Object*>::const_iterator i = objects.begin(); i != objects.end(); ++i)
+	ObjectRange range = getRange(key);	// the objects with this key
+	if (range.empty())
 	{
-		if ((*i)->getKey() != key)
-		{
-			continue;
-		}
-		ret.push_back(*i);
+		return nullptr;
 	}
-	return ret;
+	return range.front();
+}
+
+
+const vector<Object*>* Object::getIndex() const
+{
+	vector<Object*>* existingIndex = index.load(memory_order_acquire);	// the index, if a lookup has already built it
+	if (existingIndex != nullptr)
+	{
+		return existingIndex;
+	}
+
+	// sorting by the address of the interned key groups each key's children together, and a stable sort keeps them in file order
+	vector<Object*>* newIndex = new vector<Object*>(objects);
+	stable_sort(newIndex->begin(), newIndex->end(), [](const Object* a, const Object* b)
+	{
+		return &a->getKey() < &b->getKey();
+	});
+
+	// threads looking up keys in the same object at once may each build an index; the first to finish publishes it
+	if (!index.compare_exchange_strong(existingIndex, newIndex, memory_order_acq_rel, memory_order_acquire))
+	{
+		delete newIndex;
+		return existingIndex;
+	}
+	return newIndex;
+}
+
+
+void Object::clearIndex()
+{
+	delete index.exchange(nullptr, memory_order_acq_rel);
 }
 
 
@@ -215,73 +373,102 @@ int Object::numTokens()
 
 vector<string> Object::getKeys()
 {
-	vector<string> ret;	// the keys to return
-	for (vector<Object*>::iterator i = objects.begin(); i != objects.end(); ++i)
+	vector<string> ret;					// the keys to return
+	unordered_set<const string*> seenKeys;	// the keys already returned
+	for (auto object: objects)
 	{
-		string curr = (*i)->getKey();	// the current key
-		if (find(ret.begin(), ret.end(), curr) != ret.end())
+		if (seenKeys.insert(&object->getKey()).second)
 		{
-			continue;
+			ret.push_back(object->getKey());
 		}
-		ret.push_back(curr);
 	}
 	return ret;
 }
 
 
-string Object::getLeaf(string leaf) const
+string Object::getLeaf() const
+{
+	if (!isObjList || tokens.empty())
+	{
+		return strVal;
+	}
+
+	// lists only store their tokens, so build the quoted form on request
+	string list;	// the quoted tokens
+	for (const auto& token: tokens)
+	{
+		if (!list.empty())
+		{
+			list += ' ';
+		}
+		list += '"';
+		list += token;
+		list += '"';
+	}
+	return list;
+}
+
+
+string Object::getLeaf(const string& leaf) const
 {
-	vector<Object*> leaves = getValue(leaf); // the objects to return
-	if (0 == leaves.size())
+	Object* leafObj = getFirst(leaf); // the object to return
+	if (leafObj == nullptr)
 	{
 		LOG(LogLevel::Error) << "Error: Cannot find leaf " << leaf << " in object\n" << *this;
-		assert(leaves.size());
+		assert(leafObj);
 	}
-	return leaves[0]->getLeaf();
+	return leafObj->getLeaf();
 }
 
 
 ostream& operator<< (ostream& os, const Object& obj)
 {
-	static int indent = 0; // the level of indentation to output to
+	obj.write(os, 0);
+	return os;
+}
+
+
+void Object::write(ostream& os, const int indent) const
+{
 	for (int i = 0; i < indent; i++)
 	{
 		os << "\t";
 	}
-	if (obj.leaf) {
-		os << obj.key << "=" << obj.strVal << "\n";
-		return os;
+	if (leaf) {
+		os << *key << "=" << strVal << "\n";
+		return;
 	}
-	if (obj.isObjList)
+	if (isObjList)
 	{
-		os << obj.key << "={" << obj.strVal << " }\n";
-		return os;
+		os << *key << "={" << getLeaf() << " }\n";
+		return;
 	}
 
-	if ((&obj != parser_UTF8::getTopLevel()) && (&obj != parser_8859_15::getTopLevel()))
+	// the top of a parsed file has no braces of its own
+	if (isTopLevel)
 	{
-		os << obj.key << "=\n";
-		for (int i = 0; i < indent; i++)
+		for (auto i: objects)
 		{
-			os << "\t";
+			i->write(os, indent);
 		}
-		os << "{\n";
-		indent++;
+		return;
+	}
+
+	os << *key << "=\n";
+	for (int i = 0; i < indent; i++)
+	{
+		os << "\t";
 	}
-	for (auto i: obj.objects)
+	os << "{\n";
+	for (auto i: objects)
 	{
-		os << *i;
+		i->write(os, indent + 1);
 	}
-	if ((&obj != parser_UTF8::getTopLevel()) && (&obj != parser_8859_15::getTopLevel()))
+	for (int i = 0; i < indent; i++)
 	{
-		indent--;
-		for (int i = 0; i < indent; i++)
-		{
-			os << "\t";
-		}
-		os << "}\n";
+		os << "\t";
 	}
-	return os;
+	os << "}\n";
 }
 
 
@@ -289,7 +476,7 @@ void Object::keyCount()
 {
 	if (leaf)
 	{
-		cout << key << " : 1\n";
+		cout << *key << " : 1\n";
 		return;
 	}
 
@@ -331,7 +518,7 @@ void Object::keyCount(map<string, int>& counter)
 {
 	for (vector<Object*>::iterator i = objects.begin(); i != objects.end(); ++i)
 	{
-		counter[(*i)->key]++;
+		counter[*(*i)->key]++;
 		if ((*i)->leaf)
 		{
 			continue;
@@ -345,7 +532,7 @@ void Object::printTopLevel()
 {
 	for (vector<Object*>::iterator i = objects.begin(); i != objects.end(); ++i)
 	{
-		cout << (*i)->key << endl;
+		cout << *(*i)->key << endl;
 	}
 }
 
@@ -357,18 +544,21 @@ void Object::removeObject(Object* target)
 	{
 		return;
 	}
+	clearIndex();
 	objects.erase(pos);
 }
 
 
 void Object::addObject(Object* target)
 {
+	clearIndex();
 	objects.push_back(target);
 }
 
 
 void Object::addObjectAfter(Object* target, string key)
 {
+	clearIndex();
 	vector<Object*>::iterator i;
 
 	for (i = objects.begin(); i != objects.end(); ++i)
@@ -428,41 +618,41 @@ void setFlt(string name, const double val, Object* branch)
 	br->setValue(b);
 }
 
-double Object::safeGetFloat(string k, const double def)
+double Object::safeGetFloat(const string& k, const double def)
 {
-	objvec vec = getValue(k);	// the objects with the keys to be returned
-	if (0 == vec.size()) return def;
-	return stof(vec[0]->getLeaf());
+	Object* obj = getFirst(k);	// the object with the float to be returned
+	if (obj == nullptr) return def;
+	return stof(obj->getLeaf());
 }
 
-string Object::safeGetString(string k, string def)
+string Object::safeGetString(const string& k, const string& def)
 {
-	objvec vec = getValue(k);	// the objects with the strings to be returned
-	if (0 == vec.size())
+	Object* obj = getFirst(k);	// the object with the string to be returned
+	if (obj == nullptr)
 	{
 		return def;
 	}
-	return vec[0]->getLeaf();
+	return obj->getLeaf();
 }
 
-int Object::safeGetInt(string k, const int def)
+int Object::safeGetInt(const string& k, const int def)
 {
-	objvec vec = getValue(k);	// the objects with the ints to be returned
-	if (0 == vec.size())
+	Object* obj = getFirst(k);	// the object with the int to be returned
+	if (obj == nullptr)
 	{
 		return def;
 	}
-	return stoi(vec[0]->getLeaf());
+	return stoi(obj->getLeaf());
 }
 
-Object* Object::safeGetObject(string k, Object* def)
+Object* Object::safeGetObject(const string& k, Object* def)
 {
-	objvec vec = getValue(k);	// the objects with the objects to be returned 
-	if (0 == vec.size())
+	Object* obj = getFirst(k);	// the object to be returned 
+	if (obj == nullptr)
 	{
 		return def;
 	}
-	return vec[0];
+	return obj;
 }
 
 
@@ -48,29 +48,86 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 #define OBJECT_H
 
 
+#include <atomic>
+#include <iterator>
 #include <map> 
 #include <vector>
 #include <string> 
 using namespace std;
 
 
+
+class Object;
+class ObjectArena;
+
+
+// The children of an Object that share one key, in file order. A view into the Object, so it does not
+// allocate, but it is only valid until the Object is next modified.
+class ObjectRange {
+public:
+  class iterator {
+  public:
+    typedef forward_iterator_tag iterator_category;
+    typedef Object* value_type;
+    typedef ptrdiff_t difference_type;
+    typedef Object* const* pointer;
+    typedef Object* const& reference;
+
+    iterator (vector<Object*>::const_iterator _current, vector<Object*>::const_iterator _end, const string* _key);
+    reference operator* () const {return *current;}
+    iterator& operator++ ();
+    iterator operator++ (int) {iterator old = *this; ++(*this); return old;}
+    bool operator== (const iterator& other) const {return current == other.current;}
+    bool operator!= (const iterator& other) const {return current != other.current;}
+
+  private:
+    void skipOtherKeys ();
+
+    vector<Object*>::const_iterator current;	// the child this iterator points to
+    vector<Object*>::const_iterator end;			// the end of the children being searched
+    const string* key;								// the interned key being matched
+  };
+
+  ObjectRange () : first(emptyChildren.end(), emptyChildren.end(), nullptr), last(emptyChildren.end(), emptyChildren.end(), nullptr) {}
+  ObjectRange (vector<Object*>::const_iterator begin, vector<Object*>::const_iterator end, const string* key) : first(begin, end, key), last(end, end, key) {}
+  iterator begin () const {return first;}
+  iterator end () const {return last;}
+  bool empty () const {return first == last;}
+  Object* front () const {return *first;}
+
+private:
+  static const vector<Object*> emptyChildren;	// what an empty range points into
+
+  iterator first;	// the first matching child
+  iterator last;		// one past the last matching child
+};
+
+
 class Object {
   friend ostream& operator<< (ostream& o, const Object& i);
 
 public:
   Object (string k);
+  Object (const string* internedKey);
   ~Object (); 
   Object (Object* other);
 
+  static void* operator new (size_t size);
+  static void operator delete (void* memory);
+  void adoptArena (ObjectArena* arena);
+
   void setValue (Object* val);
   void setValue (string val);
   void setValue (vector<Object*> val);
-  string getKey () {return key;} 
+  const string& getKey () const {return *key;} 
   vector<string> getKeys (); 
-  vector<Object*> getValue (string key) const;
-  string getLeaf () const {return strVal;}
-  string getLeaf (string leaf) const;
-  vector<Object*> getLeaves () {return objects;}
+  vector<Object*> getValue (const string& key) const;
+  ObjectRange getRange (const string& key) const;
+  Object* getFirst (const string& key) const;
+  template <typename Function> void forEach (const string& key, Function function) const;
+  string getLeaf () const;
+  string getLeaf (const string& leaf) const;
+  const vector<Object*>& getLeaves () const {return objects;}
   void removeObject (Object* target); 
   void addObject (Object* target); 
   void addObjectAfter(Object* target, string key);
@@ -79,28 +136,45 @@ public:
   void keyCount ();
   void keyCount (map<string, int>& counter);
   void setObjList (const bool l = true) {isObjList = l;}
+  bool isObjectList () const {return isObjList;}
+  void setTopLevel (const bool t = true) {isTopLevel = t;}
   string getToken (int index); 
-  vector<string> getTokens() { return tokens; }
+  const vector<string>& getTokens() const { return tokens; }
   int numTokens (); 
   void addToList (string val); 
   void addToList (vector<string>::iterator begin, vector<string>::iterator end);
   void printTopLevel ();
   inline bool isLeaf () {return leaf;}
-  double safeGetFloat (string k, double def = 0);
-  string safeGetString (string k, string def = ""); 
-  int safeGetInt (string k, int def = 0);
-  Object* safeGetObject (string k, Object* def = 0);
+  double safeGetFloat (const string& k, double def = 0);
+  string safeGetString (const string& k, const string& def = ""); 
+  int safeGetInt (const string& k, int def = 0);
+  Object* safeGetObject (const string& k, Object* def = 0);
   string toString () const; 
   
 private:
-  string key;						// the higher level or LHS key for this object
+  void clearIndex ();
+  const vector<Object*>* getIndex () const;
+  void write (ostream& os, int indent) const;
+
+  const string* key;			// the higher level or LHS key for this object, shared with all other objects with the same key
   string strVal;					// the textual value for this object
   vector<Object*> objects;		// any sub-objects
   bool leaf;						// whether or not this is a leaf object
   bool isObjList;					// whether or not this is an object list object
+  bool isTopLevel;				// whether or not this holds everything in a file, and so is written without a key or braces
   vector<string> tokens;		// The tokens if this is a list object 
+  mutable atomic<vector<Object*>*> index;	// the sub-objects sorted by key, built on the first lookup in a large object and published atomically, so lookups may run on several threads at once
 };
 
+
+template <typename Function> void Object::forEach(const string& key, Function function) const
+{
+  for (auto object: getRange(key))
+  {
+    function(object);
+  }
+}
+
 extern ostream& operator<< (ostream& os, const Object& i);
 extern Object* br; 
 extern void setVal (string name, string val, Object* branch = 0);
@@ -0,0 +1,255 @@
+/*Copyright (c) 2016 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+
+#include "ObjectArena.h"
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+
+
+namespace
+{
+
+// Most parsed files are small, so an arena's first block is small and each one after is twice the last, up to a limit
+const size_t firstBlockSize	= 1024;			// the size of the first block the arena requests from the heap
+const size_t blockDoublings	= 10;				// the number of blocks before they stop growing
+const size_t maxBlockSize		= firstBlockSize << blockDoublings;	// the size blocks stop growing at, 1MB
+const size_t alignment = sizeof(void*);	// the alignment of every allocation from an arena
+
+thread_local ObjectArena* activeArena = nullptr;	// the arena new Objects on this thread come from, if any
+
+
+size_t hashKey(boost::string_ref key)
+{
+	size_t hash = 2166136261u;	// FNV-1a
+	for (auto c: key)
+	{
+		hash = (hash ^ static_cast<unsigned char>(c)) * 16777619u;
+	}
+	return hash;
+}
+
+
+struct StringRefHash
+{
+	size_t operator()(boost::string_ref key) const
+	{
+		return hashKey(key);
+	}
+};
+
+
+// An open-addressed table of the keys one thread has already interned. Parsing looks up a key for
+// nearly every token, so this avoids both the lock on the shared table and chasing its nodes.
+class KeyCache
+{
+	public:
+		KeyCache():
+			slots(1024),
+			count(0)
+		{
+		}
+
+		const string* find(boost::string_ref key, size_t hash) const
+		{
+			const size_t mask = slots.size() - 1;	// slots.size() is always a power of two
+			for (size_t i = hash & mask; slots[i].key != nullptr; i = (i + 1) & mask)
+			{
+				if ((slots[i].hash == hash) && (key == boost::string_ref(*slots[i].key)))
+				{
+					return slots[i].key;
+				}
+			}
+			return nullptr;
+		}
+
+		void insert(const string* key, size_t hash)
+		{
+			if ((count + 1) * 2 > slots.size())
+			{
+				vector<Slot> oldSlots(slots.size() * 2);	// the slots to move into the new table
+				oldSlots.swap(slots);
+				for (const auto& slot: oldSlots)
+				{
+					if (slot.key != nullptr)
+					{
+						place(slot);
+					}
+				}
+			}
+			Slot slot = { hash, key };	// the new entry
+			place(slot);
+			count++;
+		}
+
+	private:
+		struct Slot
+		{
+			size_t			hash;	// the hash of the key
+			const string*	key;	// the interned key, or nullptr for an empty slot
+		};
+
+		void place(const Slot& slot)
+		{
+			const size_t mask = slots.size() - 1;	// slots.size() is always a power of two
+			size_t i = slot.hash & mask;				// the slot to try
+			while (slots[i].key != nullptr)
+			{
+				i = (i + 1) & mask;
+			}
+			slots[i] = slot;
+		}
+
+		vector<Slot>	slots;	// the table itself
+		size_t			count;	// the number of keys in the table
+};
+
+typedef unordered_map<boost::string_ref, const string*, StringRefHash> keyMap;
+
+mutex			keyTableMutex;	// guards keyStorage and sharedKeys
+deque<string>	keyStorage;		// the interned keys. A deque never moves its elements, so pointers to them stay valid.
+keyMap			sharedKeys;		// the interned keys, by their text
+
+thread_local KeyCache localKeys;	// the keys this thread has already looked up
+
+}
+
+
+
+ObjectArena::ObjectArena():
+	blocks(),
+	current(nullptr),
+	remaining(0)
+{
+}
+
+
+ObjectArena::~ObjectArena()
+{
+	for (auto block: blocks)
+	{
+		delete[] block;
+	}
+}
+
+
+void* ObjectArena::allocate(size_t size)
+{
+	size = (size + alignment - 1) & ~(alignment - 1);
+	if (size > remaining)
+	{
+		const size_t blockSize		= (blocks.size() < blockDoublings) ? (firstBlockSize << blocks.size()) : maxBlockSize;	// the usual size of the next block
+		const size_t newBlockSize	= (size > blockSize) ? size : blockSize;	// the size of the block to add
+		current		= new char[newBlockSize];
+		remaining	= newBlockSize;
+		blocks.push_back(current);
+	}
+
+	void* allocation = current;	// the memory to hand out
+	current		+= size;
+	remaining	-= size;
+	return allocation;
+}
+
+
+void ObjectArena::adoptBlocks(ObjectArena& other)
+{
+	blocks.insert(blocks.end(), other.blocks.begin(), other.blocks.end());
+	other.blocks.clear();
+	other.current		= nullptr;
+	other.remaining	= 0;
+}
+
+
+ObjectArena* ObjectArena::getActive()
+{
+	return activeArena;
+}
+
+
+ActiveArenaScope::ActiveArenaScope(ObjectArena* arena):
+	previous(activeArena)
+{
+	activeArena = arena;
+}
+
+
+ActiveArenaScope::~ActiveArenaScope()
+{
+	activeArena = previous;
+}
+
+
+const string* internKey(boost::string_ref key)
+{
+	const size_t hash = hashKey(key);	// the hash of the key
+	const string* internedKey = localKeys.find(key, hash);	// the shared copy of the key
+	if (internedKey != nullptr)
+	{
+		return internedKey;
+	}
+
+	{
+		lock_guard<mutex> lock(keyTableMutex);
+		auto sharedItr = sharedKeys.find(key);
+		if (sharedItr != sharedKeys.end())
+		{
+			internedKey = sharedItr->second;
+		}
+		else
+		{
+			keyStorage.push_back(string(key.data(), key.size()));
+			internedKey = &keyStorage.back();
+			sharedKeys.insert(make_pair(boost::string_ref(*internedKey), internedKey));
+		}
+	}
+
+	localKeys.insert(internedKey, hash);
+	return internedKey;
+}
+
+
+const string* findInternedKey(boost::string_ref key)
+{
+	const size_t hash = hashKey(key);	// the hash of the key
+	const string* internedKey = localKeys.find(key, hash);	// the shared copy of the key
+	if (internedKey != nullptr)
+	{
+		return internedKey;
+	}
+
+	{
+		lock_guard<mutex> lock(keyTableMutex);
+		auto sharedItr = sharedKeys.find(key);
+		if (sharedItr == sharedKeys.end())
+		{
+			return nullptr;
+		}
+		internedKey = sharedItr->second;
+	}
+
+	localKeys.insert(internedKey, hash);
+	return internedKey;
+}
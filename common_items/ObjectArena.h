@@ -0,0 +1,103 @@
+/*Copyright (c) 2016 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+
+#ifndef OBJECT_ARENA_H_
+#define OBJECT_ARENA_H_
+
+
+
+#include <string>
+#include <vector>
+#include <boost/utility/string_ref.hpp>
+using namespace std;
+
+
+
+// A bump allocator for the Objects of a parsed file. While an arena is active on a thread (see
+// ActiveArenaScope), every Object created on that thread is carved out of it. The top-level Object
+// of the parse takes ownership of the arena (see Object::adoptArena), recording it in the allocation
+// header in front of the Object rather than in a member, and the arena's blocks are released together
+// when that Object is deleted.
+//
+// The arena's first block is small and later ones grow to 1MB, so that the many small files a
+// converter keeps parsed don't each hold a large block. An Object deleted from a tree is not freed
+// by itself; its memory stays in use until the whole tree is deleted.
+//
+// Only the Objects themselves live in the arena. Their child vectors, values and list tokens are still
+// separate heap allocations, so deleting a tree still runs every Object's destructor and frees those one
+// by one; the arena saves the per-Object allocations, not the walk over the tree. Converters add, move
+// and delete Objects in parsed trees, and read the children and tokens through getLeaves() and
+// getTokens() as plain vectors, which is why those stay on the heap.
+class ObjectArena
+{
+	public:
+		ObjectArena();
+		~ObjectArena();
+
+		void*	allocate(size_t size);
+
+		// Takes over all of other's memory, so this arena frees it. Other is left empty.
+		void	adoptBlocks(ObjectArena& other);
+
+		static ObjectArena*	getActive();
+
+	private:
+		ObjectArena(const ObjectArena&);
+		ObjectArena& operator=(const ObjectArena&);
+
+		vector<char*>	blocks;		// all blocks of memory owned by this arena
+		char*				current;		// the next free byte in the newest block
+		size_t			remaining;	// the number of free bytes left in the newest block
+};
+
+
+// Makes an arena the active one on this thread for the lifetime of the scope.
+class ActiveArenaScope
+{
+	public:
+		explicit ActiveArenaScope(ObjectArena* arena);
+		~ActiveArenaScope();
+
+	private:
+		ActiveArenaScope(const ActiveArenaScope&);
+		ActiveArenaScope& operator=(const ActiveArenaScope&);
+
+		ObjectArena* previous;	// the arena that was active before this scope
+};
+
+
+// Returns the single shared copy of a key. Parsed files repeat the same few hundred keys millions of
+// times, so Objects hold a pointer to the shared copy rather than their own string. Interned keys are
+// never freed, as Symbols and the trees of every parsed file share them. Keys that are numbers or dates,
+// such as province ids, are interned as well, so the table grows with the number of distinct keys read
+// in a run, not with the number of files. Safe to call from multiple threads.
+const string*	internKey(boost::string_ref key);
+
+// Returns the shared copy of a key if it has been interned, or nullptr if it has not. No Object can
+// have a key that was never interned, so lookups use this to avoid adding every key they ask about.
+const string*	findInternedKey(boost::string_ref key);
+
+
+
+#endif // OBJECT_ARENA_H_
@@ -0,0 +1,350 @@
+/*Copyright (c) 2016 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+
+#include "OutputWriter.h"
+#include <algorithm>
+#include <cstdarg>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include "Log.h"
+#include "OSCompatibilityLayer.h"
+#include "ZipArchive.h"
+
+
+
+namespace
+{
+
+const unsigned int maxWriterThreads		= 4;		// writing is bound by the disk, so more threads than this don't help
+const size_t maxPendingFilesPerThread	= 64;		// how far the converter may get ahead of the writer threads
+const size_t maxFreeBuffers				= 256;	// how many written files' buffers to keep for reuse
+const size_t maxReusedBufferSize			= 1 << 20;	// buffers bigger than this are freed rather than kept
+
+
+// Whether or not path is under folder, setting relativePath to the rest of it if so
+bool isUnderFolder(const string& path, const string& folder, string& relativePath)
+{
+	if ((path.size() <= folder.size() + 1) || (path.compare(0, folder.size(), folder) != 0))
+	{
+		return false;
+	}
+	if ((path[folder.size()] != '/') && (path[folder.size()] != '\\'))
+	{
+		return false;
+	}
+
+	relativePath = path.substr(folder.size() + 1);
+	replace(relativePath.begin(), relativePath.end(), '\\', '/');
+	return true;
+}
+
+}
+
+
+
+OutputWriter::OutputWriter(unsigned int numThreads):
+	stateMutex(),
+	fileWritten(),
+	pendingFiles(0),
+	failed(false),
+	freeBuffers(),
+	createdFolders(),
+	archiveRoot(),
+	archivePath(),
+	archiveFiles(),
+	threads(max(numThreads, 1u))
+{
+}
+
+
+OutputWriter::~OutputWriter()
+{
+	unique_lock<mutex> lock(stateMutex);
+	fileWritten.wait(lock, [this]{ return (pendingFiles == 0); });
+}
+
+
+void OutputWriter::write(const string& path, string&& contents)
+{
+	queueFile(path, move(contents), false);
+}
+
+
+void OutputWriter::writeBinary(const string& path, string&& contents)
+{
+	queueFile(path, move(contents), true);
+}
+
+
+string OutputWriter::takeBuffer()
+{
+	lock_guard<mutex> lock(stateMutex);
+	if (freeBuffers.empty())
+	{
+		return string();
+	}
+
+	string buffer = move(freeBuffers.back());
+	freeBuffers.pop_back();
+	return buffer;
+}
+
+
+void OutputWriter::setArchive(const string& rootFolder, const string& _archivePath)
+{
+	lock_guard<mutex> lock(stateMutex);
+	archiveRoot = rootFolder;
+	while (!archiveRoot.empty() && ((archiveRoot.back() == '/') || (archiveRoot.back() == '\\')))
+	{
+		archiveRoot.pop_back();
+	}
+	archivePath = _archivePath;
+}
+
+
+bool OutputWriter::finish()
+{
+	unique_lock<mutex> lock(stateMutex);
+	fileWritten.wait(lock, [this]{ return (pendingFiles == 0); });
+
+	if (!archiveRoot.empty())
+	{
+		if (!writeArchive())
+		{
+			failed = true;
+		}
+		archiveRoot.clear();
+		archiveFiles.clear();
+	}
+
+	const bool succeeded = !failed;
+	failed = false;
+	return succeeded;
+}
+
+
+OutputWriter& OutputWriter::getShared()
+{
+	static OutputWriter sharedWriter(min(max(thread::hardware_concurrency(), 1u), maxWriterThreads));
+	return sharedWriter;
+}
+
+
+// Archive entries are stored byte for byte either way, so binary only matters to files written on their own
+void OutputWriter::queueFile(const string& path, string&& contents, bool binary)
+{
+	string relativePath;	// the file's path within the archive
+	{
+		unique_lock<mutex> lock(stateMutex);
+		if (!archiveRoot.empty() && isUnderFolder(path, archiveRoot, relativePath))
+		{
+			archiveFiles.push_back(make_pair(relativePath, move(contents)));
+			return;
+		}
+
+		createFolders(path);
+		fileWritten.wait(lock, [this]{ return (pendingFiles < maxPendingFilesPerThread * threads.getNumThreads()); });
+		pendingFiles++;
+	}
+
+	// function<> must be copyable, so the contents are shared with the task rather than moved into it
+	auto file = make_shared<pair<string, string>>(path, move(contents));	// the path and contents to write
+	threads.submit([this, file, binary]{
+		writeFile(file->first, file->second, binary);
+	});
+}
+
+
+// Creates the folders leading to path that aren't already known to exist. Called with stateMutex held, so the
+// folders are made by one thread at a time.
+void OutputWriter::createFolders(const string& path)
+{
+	for (size_t separator = path.find_first_of("/\\", 1); separator != string::npos; separator = path.find_first_of("/\\", separator + 1))
+	{
+		const string folder = path.substr(0, separator);	// the folder to check
+		if (createdFolders.count(folder) > 0)
+		{
+			continue;
+		}
+		if (Utils::doesFolderExist(folder) || Utils::TryCreateFolder(folder))
+		{
+			createdFolders.insert(folder);
+		}
+	}
+}
+
+
+void OutputWriter::writeFile(const string& path, string& contents, bool binary)
+{
+	ofstream file(path, binary ? (ios::out | ios::binary) : ios::out);
+	bool succeeded = file.is_open();	// whether or not the whole file was written
+	if (succeeded)
+	{
+		file.write(contents.data(), contents.size());
+		file.close();
+		succeeded = !file.fail();
+	}
+	if (!succeeded)
+	{
+		LOG(LogLevel::Error) << "Could not write " << path;
+	}
+
+	fileDone(move(contents), succeeded);
+}
+
+
+void OutputWriter::fileDone(string&& buffer, bool succeeded)
+{
+	{
+		lock_guard<mutex> lock(stateMutex);
+		if (!succeeded)
+		{
+			failed = true;
+		}
+		if ((freeBuffers.size() < maxFreeBuffers) && (buffer.capacity() <= maxReusedBufferSize))
+		{
+			buffer.clear();
+			freeBuffers.push_back(move(buffer));
+		}
+		pendingFiles--;
+	}
+	fileWritten.notify_all();
+}
+
+
+// Called with stateMutex held, once every other file has been written
+bool OutputWriter::writeArchive()
+{
+	// sort the entries so the same files always give the same archive, whichever order they were built in
+	sort(archiveFiles.begin(), archiveFiles.end(), [](const pair<string, string>& a, const pair<string, string>& b){
+		return (a.first < b.first);
+	});
+
+	ZipArchiveWriter archive;
+	for (auto& file: archiveFiles)
+	{
+		if (!archive.addEntry(file.first, file.second))
+		{
+			LOG(LogLevel::Error) << "Could not add " << file.first << " to " << archivePath << " as the archive is too big";
+			return false;
+		}
+		string().swap(file.second);
+	}
+
+	createFolders(archivePath);
+	const string& data = archive.finish();	// the whole archive
+	ofstream file(archivePath, ios::binary);
+	bool succeeded = file.is_open();	// whether or not the whole archive was written
+	if (succeeded)
+	{
+		file.write(data.data(), data.size());
+		file.close();
+		succeeded = !file.fail();
+	}
+	if (!succeeded)
+	{
+		LOG(LogLevel::Error) << "Could not write " << archivePath;
+	}
+	return succeeded;
+}
+
+
+
+OutputFile::OutputFile(const string& _path, OutputWriter& _writer):
+	ostream(nullptr),
+	buffer(),
+	path(_path),
+	writer(_writer),
+	closed(false)
+{
+	buffer.contents = writer.takeBuffer();
+	rdbuf(&buffer);
+}
+
+
+OutputFile::~OutputFile()
+{
+	close();
+}
+
+
+void OutputFile::close()
+{
+	if (closed)
+	{
+		return;
+	}
+	closed = true;
+
+	writer.write(path, std::move(buffer.contents));
+	buffer.contents = string();
+}
+
+
+void OutputFile::print(const char* format, ...)
+{
+	string& contents = buffer.contents;	// the file so far
+	const size_t start = contents.size();	// where the new text goes
+	size_t room = 256;							// how much space to leave for the new text
+	for (;;)
+	{
+		contents.resize(start + room);
+
+		va_list arguments;
+		va_start(arguments, format);
+		const int length = vsnprintf(&contents[start], room, format, arguments);	// how long the new text is
+		va_end(arguments);
+
+		if (length < 0)
+		{
+			contents.resize(start);
+			setstate(ios::badbit);
+			return;
+		}
+		if (static_cast<size_t>(length) < room)
+		{
+			contents.resize(start + length);
+			return;
+		}
+		room = length + 1;
+	}
+}
+
+
+OutputFile::StringBuffer::int_type OutputFile::StringBuffer::overflow(int_type character)
+{
+	if (!traits_type::eq_int_type(character, traits_type::eof()))
+	{
+		contents.push_back(traits_type::to_char_type(character));
+	}
+	return traits_type::not_eof(character);
+}
+
+
+streamsize OutputFile::StringBuffer::xsputn(const char* characters, streamsize count)
+{
+	contents.append(characters, static_cast<size_t>(count));
+	return count;
+}
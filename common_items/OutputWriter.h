@@ -0,0 +1,143 @@
+/*Copyright (c) 2016 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+
+#ifndef OUTPUT_WRITER_H_
+#define OUTPUT_WRITER_H_
+
+
+
+#include <condition_variable>
+#include <mutex>
+#include <ostream>
+#include <set>
+#include <streambuf>
+#include <string>
+#include <utility>
+#include <vector>
+#include "ThreadPool.h"
+using namespace std;
+
+
+
+// Writes a converter's output files on background threads. Each file is built up in memory (usually through an
+// OutputFile) and then handed over whole, so a writer thread can write it with one large write while the
+// converter carries on with the next file. The memory of written files is kept and handed out again for new
+// ones, so building thousands of small files doesn't mean thousands of allocations.
+//
+// In archive mode the files under the archive's root folder are collected into one zip archive instead of being
+// written one by one; files anywhere else are still written normally.
+class OutputWriter
+{
+	public:
+		explicit OutputWriter(unsigned int numThreads);
+		~OutputWriter();
+
+		// Queues contents to be written to path, creating any folders it needs. Blocks while too many files are
+		// already waiting to be written, so the queue can't take up unbounded memory. Safe to call from any thread.
+		void		write(const string& path, string&& contents);
+
+		// As write(), but for files that aren't text, such as images: the contents are written byte for byte, without
+		// Windows turning each line feed into a carriage return and line feed
+		void		writeBinary(const string& path, string&& contents);
+
+		// An empty buffer to build a file in, reusing the memory of an already written file where possible
+		string	takeBuffer();
+
+		// Collects the files written under rootFolder from now on into a zip archive at archivePath, with their
+		// paths relative to rootFolder. The archive is written by finish().
+		void		setArchive(const string& rootFolder, const string& archivePath);
+
+		// Waits until every queued file has been written, and writes the archive in archive mode. Returns false if
+		// anything could not be written; the failures will already have been logged.
+		bool		finish();
+
+		// The writer shared by the whole converter
+		static OutputWriter&	getShared();
+
+	private:
+		OutputWriter(const OutputWriter&);
+		OutputWriter& operator=(const OutputWriter&);
+
+		void		queueFile(const string& path, string&& contents, bool binary);
+		void		createFolders(const string& path);
+		void		writeFile(const string& path, string& contents, bool binary);
+		void		fileDone(string&& buffer, bool succeeded);
+		bool		writeArchive();
+
+		mutex									stateMutex;			// guards everything below but threads
+		condition_variable				fileWritten;		// signalled whenever a queued file has been dealt with
+		size_t								pendingFiles;		// how many files are queued but not yet written
+		bool									failed;				// whether or not any write has failed
+		vector<string>						freeBuffers;		// the buffers of written files, ready to be reused
+		set<string>							createdFolders;	// the folders known to exist
+		string								archiveRoot;		// the folder whose files go in the archive, or "" if not in archive mode
+		string								archivePath;		// where to write the archive
+		vector<pair<string, string>>	archiveFiles;		// the paths and contents of the files for the archive
+
+		// the threads doing the writing. Declared last so the threads are joined before anything they use is destroyed,
+		// as a thread may still be returning from fileDone() after the destructor has seen the last file finish.
+		ThreadPool							threads;
+};
+
+
+
+// An output file built in memory. Fill it as an ostream, or with print() in place of fprintf, and on closing (or
+// destruction) the whole file is handed to an OutputWriter to be written in the background.
+class OutputFile: public ostream
+{
+	public:
+		explicit OutputFile(const string& _path, OutputWriter& _writer = OutputWriter::getShared());
+		~OutputFile();
+
+		// Always true until closed, as the file isn't actually opened until it is written
+		bool	is_open() const { return !closed; }
+		void	close();
+
+		// Appends formatted text, as fprintf would
+		void	print(const char* format, ...);
+
+	private:
+		OutputFile(const OutputFile&);
+		OutputFile& operator=(const OutputFile&);
+
+		// Appends everything streamed into it straight onto a string
+		class StringBuffer: public streambuf
+		{
+			public:
+				string contents;	// the file so far
+
+			protected:
+				int_type		overflow(int_type character);
+				streamsize	xsputn(const char* characters, streamsize count);
+		};
+
+		StringBuffer	buffer;	// where the file is built
+		string			path;		// where the file will be written
+		OutputWriter&	writer;	// what will write the file
+		bool				closed;	// whether or not the file has been handed to the writer
+};
+
+
+
+#endif // OUTPUT_WRITER_H_
@@ -0,0 +1,344 @@
+/*Copyright (c) 2016 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+
+#include "ParadoxEventReader.h"
+#include "Encoding.h"
+#include "Log.h"
+#include "OSCompatibilityLayer.h"
+
+
+
+ParadoxEventReader::ParadoxEventReader(const char* begin, const char* end, bool _is8859_15):
+	tokenizer(begin, end),
+	handler(nullptr),
+	is8859_15(_is8859_15),
+	isBinary(false),
+	hadErrors(false),
+	stopped(false),
+	converted(),
+	listItems()
+{
+}
+
+
+bool ParadoxEventReader::read(ParadoxEventHandler& _handler)
+{
+	handler = &_handler;
+	readAssignments(true);
+	converted.clear();
+	return !hadErrors;
+}
+
+
+void ParadoxEventReader::readAssignments(bool isTopLevel)
+{
+	while (!stopped)
+	{
+		Token token = tokenizer.next();	// the token under consideration
+		switch (token.type)
+		{
+			case TokenType::EndOfInput:
+				if (!isTopLevel)
+				{
+					warn("Missing closing brace at end of input");
+				}
+				return;
+
+			case TokenType::CloseBrace:
+				if (isTopLevel)
+				{
+					warn("Unmatched closing brace");
+					continue;
+				}
+				return;
+
+			case TokenType::OpenBrace:
+				// stray braces without a key, as in some EU3 decision mods
+				if (tokenizer.peek().type == TokenType::CloseBrace)
+				{
+					tokenizer.next();
+				}
+				else
+				{
+					warn("Skipping a braced block without a key");
+					skipBlock();
+				}
+				continue;
+
+			case TokenType::Equals:
+				readKey("epsilon");	// an assignment with a missing key
+				continue;
+
+			case TokenType::Scalar:
+			case TokenType::String:
+				if (tokenizer.peek().type == TokenType::Equals)
+				{
+					tokenizer.next();
+					readKey(token.text);
+				}
+				else if (isTopLevel && ParadoxTokenizer::isSaveHeader(token))
+				{
+					continue;
+				}
+				else
+				{
+					warn("Skipping '" + string(decode(token.text)) + "', which is not part of an assignment");
+				}
+				continue;
+		}
+	}
+}
+
+
+void ParadoxEventReader::readKey(boost::string_ref key)
+{
+	const size_t convertedBefore = converted.size();	// the converted text that belongs to enclosing keys
+	key = keep(key);
+	switch (handler->onKey(key))
+	{
+		case KeyAction::Read:
+			readValue(key);
+			break;
+
+		case KeyAction::Skip:
+			skipValue();
+			break;
+
+		case KeyAction::Stop:
+			stopped = true;
+			break;
+	}
+	converted.resize(convertedBefore);
+}
+
+
+void ParadoxEventReader::readValue(boost::string_ref key)
+{
+	const Token& token = tokenizer.peek();	// the start of the value
+	switch (token.type)
+	{
+		case TokenType::Scalar:
+		case TokenType::String:
+			handler->onScalar(decode(tokenizer.next().text));
+			return;
+
+		case TokenType::OpenBrace:
+			tokenizer.next();
+			readBlock(key);
+			return;
+
+		default:
+			warn("Missing value for " + string(key));
+			return;
+	}
+}
+
+
+void ParadoxEventReader::readBlock(boost::string_ref key)
+{
+	switch (tokenizer.peek().type)
+	{
+		case TokenType::CloseBrace:
+			tokenizer.next();
+			handler->onBeginObject();
+			handler->onEndObject();
+			return;
+
+		case TokenType::OpenBrace:
+			readObjectList(key);
+			return;
+
+		case TokenType::Scalar:
+		case TokenType::String:
+			{
+				Token first = tokenizer.next();	// either a key or the first item of a list
+				if (tokenizer.peek().type != TokenType::Equals)
+				{
+					readTagList(key, first);
+					return;
+				}
+				tokenizer.next();
+				handler->onBeginObject();
+				readKey(first.text);
+				readAssignments(false);
+				if (!stopped)
+				{
+					handler->onEndObject();
+				}
+			}
+			return;
+
+		default:
+			handler->onBeginObject();
+			readAssignments(false);
+			if (!stopped)
+			{
+				handler->onEndObject();
+			}
+			return;
+	}
+}
+
+
+void ParadoxEventReader::readTagList(boost::string_ref key, const Token& first)
+{
+	listItems.clear();
+	listItems.push_back(keep(first.text));
+	while (true)
+	{
+		Token token = tokenizer.next();	// the item under consideration
+		if ((token.type == TokenType::Scalar) || (token.type == TokenType::String))
+		{
+			listItems.push_back(keep(token.text));
+		}
+		else if (token.type == TokenType::CloseBrace)
+		{
+			break;
+		}
+		else if (token.type == TokenType::EndOfInput)
+		{
+			warn("Missing closing brace at end of input");
+			break;
+		}
+		else
+		{
+			warn("Skipping the rest of a malformed list in " + string(key));
+			if (token.type == TokenType::OpenBrace)
+			{
+				skipBlock();
+			}
+			skipBlock();
+			break;
+		}
+	}
+	handler->onList(listItems);
+}
+
+
+void ParadoxEventReader::readObjectList(boost::string_ref key)
+{
+	handler->onBeginObject();
+	while (!stopped)
+	{
+		Token token = tokenizer.next();	// the start of the next object in the list
+		if (token.type == TokenType::OpenBrace)
+		{
+			readBlock(key);
+		}
+		else if (token.type == TokenType::CloseBrace)
+		{
+			break;
+		}
+		else if (token.type == TokenType::EndOfInput)
+		{
+			warn("Missing closing brace at end of input");
+			break;
+		}
+		else
+		{
+			warn("Skipping the rest of a malformed object list in " + string(key));
+			skipBlock();
+			break;
+		}
+	}
+	if (!stopped)
+	{
+		handler->onEndObject();
+	}
+}
+
+
+void ParadoxEventReader::skipValue()
+{
+	switch (tokenizer.peek().type)
+	{
+		case TokenType::Scalar:
+		case TokenType::String:
+			tokenizer.next();
+			return;
+
+		case TokenType::OpenBrace:
+			tokenizer.next();
+			skipBlock();
+			return;
+
+		default:
+			return;
+	}
+}
+
+
+void ParadoxEventReader::skipBlock()
+{
+	int depth = 1;	// the number of braces left to close
+	while (depth > 0)
+	{
+		switch (tokenizer.next().type)
+		{
+			case TokenType::OpenBrace:
+				depth++;
+				break;
+			case TokenType::CloseBrace:
+				depth--;
+				break;
+			case TokenType::EndOfInput:
+				return;
+			default:
+				break;
+		}
+	}
+}
+
+
+boost::string_ref ParadoxEventReader::decode(boost::string_ref text)
+{
+	if (is8859_15 && !Encoding::isASCII(text.data(), text.data() + text.size()))
+	{
+		converted.push_back(string());
+		Encoding::append8859_15AsUTF8(text.data(), text.data() + text.size(), converted.back());
+		return converted.back();
+	}
+	return text;
+}
+
+
+boost::string_ref ParadoxEventReader::keep(boost::string_ref text)
+{
+	boost::string_ref decoded = decode(text);	// the text in UTF-8
+	if (isBinary && (decoded.data() == text.data()))
+	{
+		// the tokenizer reuses the space for binary numbers, so a list of them, or a key that has to last while its
+		// value is read, needs its own copy
+		converted.push_back(string(text.data(), text.size()));
+		return converted.back();
+	}
+	return decoded;
+}
+
+
+void ParadoxEventReader::warn(const string& message)
+{
+	hadErrors = true;
+	LOG(LogLevel::Warning) << message << " (line " << tokenizer.getLineNumber() << ")";
+}
@@ -0,0 +1,107 @@
+/*Copyright (c) 2016 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+
+#ifndef PARADOX_EVENT_READER_H_
+#define PARADOX_EVENT_READER_H_
+
+
+
+#include "ParadoxTokenizer.h"
+#include <deque>
+#include <string>
+#include <vector>
+#include <boost/utility/string_ref.hpp>
+using namespace std;
+
+
+
+// What a ParadoxEventReader should do with the value of a key
+enum class KeyAction
+{
+	Read,	// report the value to the handler
+	Skip,	// pass over the value, and everything inside it, without reporting it
+	Stop	// stop reading the file altogether
+};
+
+
+// Receives the contents of a Paradox script file as it is read, without any Object tree being built.
+// The strings passed to the handler are only valid until the callback returns, except that a key stays
+// valid until its whole value has been reported.
+//
+// An assignment is reported as onKey() followed by its value: onScalar() for 'date=1444.11.11',
+// onList() for 'add_core={ ENG FRA }', or onBeginObject(), the assignments inside the braces, and
+// onEndObject() for a block. An object list such as 'history={ { ... } { ... } }' is reported as a block
+// whose items are values with no key in front of them.
+class ParadoxEventHandler
+{
+	public:
+		virtual ~ParadoxEventHandler() {}
+
+		virtual KeyAction	onKey(boost::string_ref key) { return KeyAction::Read; }
+		virtual void		onScalar(boost::string_ref value) {}
+		virtual void		onBeginObject() {}
+		virtual void		onEndObject() {}
+		virtual void		onList(const vector<boost::string_ref>& items) {}
+};
+
+
+// Reads a buffer of Paradox script and reports it to a ParadoxEventHandler. Accepts exactly the input that
+// ParadoxTokenParser does, and logs the same warnings for malformed input.
+class ParadoxEventReader
+{
+	public:
+		ParadoxEventReader(const char* begin, const char* end, bool _is8859_15);
+
+		// Reads the buffer as a binary save, without its header, using these token names
+		void setBinaryTokens(const BinaryTokenTable* tokens) { tokenizer.setBinaryTokens(tokens); isBinary = (tokens != nullptr); }
+
+		// Reports everything in the buffer to handler. Returns false if any malformed input had to be skipped.
+		bool read(ParadoxEventHandler& _handler);
+
+	private:
+		void					readAssignments(bool isTopLevel);
+		void					readKey(boost::string_ref key);
+		void					readValue(boost::string_ref key);
+		void					readBlock(boost::string_ref key);
+		void					readTagList(boost::string_ref key, const Token& first);
+		void					readObjectList(boost::string_ref key);
+		void					skipValue();
+		void					skipBlock();
+		boost::string_ref	decode(boost::string_ref text);
+		boost::string_ref	keep(boost::string_ref text);
+		void					warn(const string& message);
+
+		ParadoxTokenizer				tokenizer;	// the source of tokens
+		ParadoxEventHandler*			handler;		// where events are sent
+		bool								is8859_15;	// whether text must be converted from ISO 8859-15 to UTF-8
+		bool								isBinary;	// whether the buffer is a binary save, whose numbers only last a few tokens
+		bool								hadErrors;	// whether or not any malformed input was skipped
+		bool								stopped;		// whether or not the handler asked to stop reading
+		deque<string>					converted;	// text converted to UTF-8 for the current callback
+		vector<boost::string_ref>	listItems;	// the items of the list being read
+};
+
+
+
+#endif // PARADOX_EVENT_READER_H_
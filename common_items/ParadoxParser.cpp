@@ -0,0 +1,280 @@
+/*Copyright (c) 2016 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+
+#include "ParadoxParser.h"
+#include "BinaryTokenTable.h"
+#include "Log.h"
+#include "ObjectArena.h"
+#include "OSCompatibilityLayer.h"
+#include "ParadoxParser8859_15.h"
+#include "ParadoxParserUTF8.h"
+#include "ParsedFileCache.h"
+#include "ThreadPool.h"
+#include "ZipArchive.h"
+#include <cstring>
+
+
+
+ParadoxParser::ParadoxParser(ParserEncoding _encoding, ParserBackend _backend):
+	encoding(_encoding),
+	backend(_backend),
+	parallelParsing(true),
+	cache(ParsedFileCache::getShared()),
+	binaryTokens(nullptr)
+{
+}
+
+
+Object* ParadoxParser::parseFile(const string& filename) const
+{
+	Utils::FileStamp stamp;	// identifies the file's current contents to the cache
+	// binary files are not cached, as their trees also depend on the token names
+	if ((cache == nullptr) || (binaryTokens != nullptr) || !Utils::GetFileStamp(filename, stamp))
+	{
+		return parseUncached(filename);
+	}
+
+	Object* topLevel = cache->load(stamp, encoding, backend);	// the object holding everything in the file
+	if (topLevel == nullptr)
+	{
+		topLevel = parseUncached(filename);
+		if (topLevel != nullptr)
+		{
+			cache->store(stamp, encoding, backend, topLevel);
+		}
+	}
+	return topLevel;
+}
+
+
+Object* ParadoxParser::parseUncached(const string& filename) const
+{
+	Utils::MappedFile file(filename);	// the contents of the file
+	if (!file.isOpen())
+	{
+		return nullptr;
+	}
+
+	const char* begin	= file.getData();					// the start of the text to parse
+	const char* end	= file.getData() + file.getSize();	// the end of the text to parse
+	vector<char> unzipped;	// the contents of a compressed save
+	if (ZipArchive::isZipArchive(begin, end) && !unzip(filename, begin, end, unzipped))
+	{
+		return nullptr;
+	}
+	begin = skipBOM(begin, end);
+	const size_t binaryHeaderLength = BinaryTokenTable::getBinaryHeaderLength(begin, end);	// the length of the header if the file is binary
+	if ((binaryHeaderLength > 0) && (binaryTokens == nullptr))
+	{
+		LOG(LogLevel::Error) << filename << " is a binary file, and there are no token names to read it with";
+		return nullptr;
+	}
+
+	Object* topLevel = new Object("topLevel");	// the object holding everything in the file
+	ObjectArena* arena = new ObjectArena();		// the storage for everything parsed from the file
+	topLevel->setTopLevel();
+	topLevel->adoptArena(arena);
+	ActiveArenaScope arenaScope(arena);
+
+	const bool is8859_15 = (encoding == ParserEncoding::ISO_8859_15);	// whether or not text must be converted to UTF-8
+	if (binaryHeaderLength > 0)
+	{
+		ParadoxTokenParser parser(begin + binaryHeaderLength, end, is8859_15);
+		parser.setBinaryTokens(binaryTokens);
+		parser.parse(topLevel);
+	}
+	else if (backend == ParserBackend::Tokenizer)
+	{
+		if (parallelParsing)
+		{
+			ParadoxTokenParser::parseInParallel(begin, end, is8859_15, topLevel);
+		}
+		else
+		{
+			ParadoxTokenParser parser(begin, end, is8859_15);
+			parser.parse(topLevel);
+		}
+	}
+	else if (is8859_15)
+	{
+		parser_8859_15::readBuffer(begin, end, topLevel);
+	}
+	else
+	{
+		parser_UTF8::readBuffer(begin, end, topLevel);
+	}
+
+	return topLevel;
+}
+
+
+vector<Object*> ParadoxParser::parseFiles(const vector<string>& filenames) const
+{
+	vector<Object*> results(filenames.size(), nullptr);	// the parsed files
+	ThreadPool::getShared().parallelFor(filenames.size(), [&](size_t i)
+	{
+		results[i] = parseFile(filenames[i]);
+	});
+	return results;
+}
+
+
+bool ParadoxParser::streamFile(const string& filename, ParadoxEventHandler& handler) const
+{
+	Utils::MappedFile file(filename);	// the contents of the file
+	if (!file.isOpen())
+	{
+		return false;
+	}
+
+	const char* begin	= file.getData();					// the start of the text to read
+	const char* end	= file.getData() + file.getSize();	// the end of the text to read
+	vector<char> unzipped;	// the contents of a compressed save
+	if (ZipArchive::isZipArchive(begin, end) && !unzip(filename, begin, end, unzipped))
+	{
+		return false;
+	}
+	begin = skipBOM(begin, end);
+	const size_t binaryHeaderLength = BinaryTokenTable::getBinaryHeaderLength(begin, end);	// the length of the header if the file is binary
+	if ((binaryHeaderLength > 0) && (binaryTokens == nullptr))
+	{
+		LOG(LogLevel::Error) << filename << " is a binary file, and there are no token names to read it with";
+		return false;
+	}
+
+	ParadoxEventReader reader(begin + binaryHeaderLength, end, (encoding == ParserEncoding::ISO_8859_15));
+	reader.setBinaryTokens((binaryHeaderLength > 0) ? binaryTokens : nullptr);
+	reader.read(handler);
+	return true;
+}
+
+
+bool ParadoxParser::unzip(const string& filename, const char*& begin, const char*& end, vector<char>& unzipped) const
+{
+	ZipArchive archive(begin, end - begin);
+	if (!archive.isValid())
+	{
+		LOG(LogLevel::Error) << "Could not read the compressed file " << filename << ": " << archive.getError();
+		return false;
+	}
+
+	// EU4 splits its saves into the header fields (meta) and everything else (gamestate), while CK2 stores
+	// a whole save alongside a copy of its header fields
+	vector<string> entryNames;	// the entries that together make up the save, in order
+	if (archive.hasEntry("gamestate"))
+	{
+		if (archive.hasEntry("meta"))
+		{
+			entryNames.push_back("meta");
+		}
+		entryNames.push_back("gamestate");
+	}
+	else
+	{
+		for (auto& name: archive.getEntryNames())
+		{
+			if (name != "meta")
+			{
+				entryNames.push_back(name);
+			}
+		}
+	}
+	if (entryNames.empty())
+	{
+		LOG(LogLevel::Error) << "The compressed file " << filename << " does not contain a save";
+		return false;
+	}
+
+	size_t size = entryNames.size();	// the size of all the entries, plus a line break between each
+	for (auto& name: entryNames)
+	{
+		size += archive.getEntrySize(name);
+	}
+	unzipped.reserve(size);
+
+	size_t headerLength = 0;	// the length of the first entry's header (EU4txt, EU4bin, ...)
+	for (auto& name: entryNames)
+	{
+		const size_t start = unzipped.size();	// where this entry starts
+		if (!archive.extract(name, unzipped))
+		{
+			LOG(LogLevel::Error) << "Could not decompress " << filename << ": " << archive.getError();
+			return false;
+		}
+
+		// only the first entry keeps its header, so that the rest read as a continuation of it
+		const char* entryBegin = unzipped.data() + start;
+		if (start == 0)
+		{
+			headerLength = getHeaderLength(entryBegin, unzipped.data() + unzipped.size());
+		}
+		else if ((headerLength > 0) && (unzipped.size() - start >= headerLength) && (memcmp(entryBegin, unzipped.data(), headerLength) == 0))
+		{
+			unzipped.erase(unzipped.begin() + start, unzipped.begin() + start + headerLength);
+		}
+
+		if (BinaryTokenTable::getBinaryHeaderLength(unzipped.data(), unzipped.data() + unzipped.size()) == 0)
+		{
+			unzipped.push_back('\n');
+		}
+	}
+
+	begin	= unzipped.data();
+	end	= unzipped.data() + unzipped.size();
+	return true;
+}
+
+
+size_t ParadoxParser::getHeaderLength(const char* begin, const char* end)
+{
+	const size_t binaryHeaderLength = BinaryTokenTable::getBinaryHeaderLength(begin, end);	// the length of the header if the save is binary
+	if (binaryHeaderLength > 0)
+	{
+		return binaryHeaderLength;
+	}
+
+	for (auto header: { "EU4txt", "CK2txt", "HOI4txt" })
+	{
+		const size_t length = strlen(header);
+		if ((static_cast<size_t>(end - begin) >= length) && (memcmp(begin, header, length) == 0))
+		{
+			return length;
+		}
+	}
+	return 0;
+}
+
+
+const char* ParadoxParser::skipBOM(const char* begin, const char* end) const
+{
+	if ((end - begin >= 3) && (begin[0] == (char)0xEF) && (begin[1] == (char)0xBB) && (begin[2] == (char)0xBF))
+	{
+		if (encoding == ParserEncoding::ISO_8859_15)
+		{
+			LOG(LogLevel::Warning) << "Identified a BOM in a file that shouldn't be UTF-8";
+		}
+		begin += 3;
+	}
+	return begin;
+}
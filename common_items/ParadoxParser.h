@@ -0,0 +1,97 @@
+/*Copyright (c) 2016 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+
+#ifndef PARADOX_PARSER_H_
+#define PARADOX_PARSER_H_
+
+
+
+#include "Object.h"
+#include "ParadoxEventReader.h"
+#include "ParadoxTokenizer.h"
+#include <string>
+#include <vector>
+using namespace std;
+
+
+
+enum class ParserEncoding
+{
+	UTF8,
+	ISO_8859_15
+};
+
+
+class ParsedFileCache;
+
+
+// Parses Paradox script files. Unlike the parser_UTF8 and parser_8859_15 namespaces, a ParadoxParser
+// keeps no state between files, so any number of threads can parse with it at once.
+class ParadoxParser
+{
+	public:
+		explicit ParadoxParser(ParserEncoding _encoding, ParserBackend _backend = ParserBackend::Tokenizer);
+
+		// Returns everything in the file under a single top-level object, or nullptr if the file could not
+		// be opened (or is binary and there are no token names). Compressed (zip) saves are decompressed in
+		// memory. The caller owns the result.
+		Object*				parseFile(const string& filename) const;
+
+		// Parses all the files on the shared thread pool. The results are in the same order as filenames,
+		// with nullptr for any file that could not be opened.
+		vector<Object*>	parseFiles(const vector<string>& filenames) const;
+
+		// Reports the contents of the file to handler as it is read, without building a tree, so that subtrees
+		// the handler skips never take up memory. Returns false if the file could not be read.
+		bool					streamFile(const string& filename, ParadoxEventHandler& handler) const;
+
+		// Whether or not a large file may itself be split up and parsed on the shared thread pool
+		void					setParallelParsing(bool enabled) { parallelParsing = enabled; }
+
+		// Where parseFile looks for trees parsed on earlier runs, and saves new ones. Defaults to the shared
+		// cache, if there is one. Set it to nullptr for files that are only read once, such as saves.
+		void					setCache(const ParsedFileCache* _cache) { cache = _cache; }
+
+		// The token names for binary (ironman) files. Without them, binary files cannot be read.
+		void					setBinaryTokens(const BinaryTokenTable* tokens) { binaryTokens = tokens; }
+
+	private:
+		Object*			parseUncached(const string& filename) const;
+		const char*		skipBOM(const char* begin, const char* end) const;
+
+		// Decompresses a zipped save into unzipped and points begin and end at it. Returns false and logs an
+		// error if the archive could not be read.
+		bool				unzip(const string& filename, const char*& begin, const char*& end, vector<char>& unzipped) const;
+		static size_t	getHeaderLength(const char* begin, const char* end);
+
+		ParserEncoding				encoding;			// the encoding of the files to parse
+		ParserBackend				backend;				// which implementation does the parsing
+		bool							parallelParsing;	// whether or not large files are split up and parsed on several threads
+		const ParsedFileCache*	cache;				// where parsed trees are kept between runs, if anywhere
+		const BinaryTokenTable*	binaryTokens;		// the names of the tokens in binary files, if known
+};
+
+
+
+#endif // PARADOX_PARSER_H_
@@ -50,6 +50,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 
 #include "Object.h"
+#include "ParadoxTokenizer.h"
 #include <string>
 using namespace std;
 
@@ -61,6 +62,9 @@ namespace parser_8859_15
 	void	clearStack(); 
 	void	initParser();
 	Object* doParseFile(string filename);
+	bool	readBuffer(const char* begin, const char* end, Object* topLevel);
+	void	setBackend(ParserBackend newBackend);
+	void	setParallelParsing(bool enabled);
 }
 
 
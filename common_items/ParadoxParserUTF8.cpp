@@ -46,12 +46,11 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 #pragma warning(disable : 4348)	// suppress warnings from Spirit, because they aren't being fixed (or the fixes aren't being released)
 #include "ParadoxParserUTF8.h"
-#include <fstream>
-#include <locale>
-#include <codecvt>
-#include <boost/spirit/include/support_istream_iterator.hpp>
+#include <cstring>
 #include <boost/spirit/include/qi.hpp>
 #include "Log.h"
+#include "ParadoxParser.h"
+#include "OSCompatibilityLayer.h"
 
 
 
@@ -73,11 +72,14 @@ static void setRHStaglist				(vector<string> val);
 static void setEpsilon					();
 static void setAssign					();
 
-static Object*		topLevel		= nullptr;  // a top level object
-vector<Object*>	stack;						// a stack of objects
-vector<Object*>	objstack;					// a stack of objects
-bool					epsilon		= false;		// if we've tried an episilon for an assign
-bool					inObjList	= false;		// if we're inside an object list
+// the state of a Spirit parse, kept per thread so that different threads can parse at once
+static thread_local Object*				topLevel		= nullptr;  // a top level object
+static thread_local vector<Object*>	stack;						// a stack of objects
+static thread_local vector<Object*>	objstack;					// a stack of objects
+static thread_local bool				epsilon		= false;		// if we've tried an episilon for an assign
+static thread_local bool				inObjList	= false;		// if we're inside an object list
+static ParserBackend	backend	= ParserBackend::Tokenizer;	// which implementation doParseFile uses
+static bool				parallelParsing	= true;		// whether or not the tokenizer may parse large files on several threads
 
 
 template <typename Iterator>
@@ -196,123 +198,155 @@ Object* getTopLevel()
 
 void initParser()
 {
-	topLevel = new Object("topLevel");
-	epsilon	= false;
+	epsilon		= false;
+	inObjList	= false;
 }
 
 
-string bufferOneObject(ifstream& read)
+// Finds the end of the next top-level object in the buffer, so that Spirit only ever has to hold one object.
+// Sets hasComments if the object contains any comments, as those must be stripped before Spirit sees them.
+const char* findEndOfObject(const char* begin, const char* end, bool& hasComments)
 {
-	int openBraces = 0;				// the number of braces deep we are
-	string currObject, buffer;		// the current object and the tect under consideration
-	bool topLevel = true;			// whether or not we're at the top level
-	while (read.good())
+	int openBraces		= 0;		// the number of braces deep we are
+	bool opened			= false;	// whether or not a brace has been opened in this object
+	bool isInLiteral	= false;	// whether or not we're in a string literal
+	hasComments			= false;
+	for (const char* i = begin; i < end; ++i)
 	{
-		getline(read, buffer);
-		if(buffer.empty())
+		switch (*i)
 		{
-			continue;
-		}
-		if(buffer.back() == '\r')
-		{
-			buffer.pop_back();
+			case '"':
+				isInLiteral = !isInLiteral;
+				break;
+
+			case '#':
+				if (!isInLiteral)
+				{
+					hasComments = true;
+					const char* endOfLine = static_cast<const char*>(memchr(i, '\n', end - i));	// the end of the comment
+					i = (endOfLine == nullptr) ? end - 1 : endOfLine - 1;
+				}
+				break;
+
+			case '{':
+				if (!isInLiteral)
+				{
+					++openBraces;
+					opened = true;
+				}
+				break;
+
+			case '}':
+				if (!isInLiteral)
+				{
+					--openBraces;
+				}
+				break;
+
+			case '\n':
+				isInLiteral = false;
+				if (opened && (openBraces <= 0))
+				{
+					return i + 1;
+				}
+				break;
 		}
+	}
+	return end;
+}
+
 
-		if (buffer == "CK2txt")
+string stripComments(const char* begin, const char* end)
+{
+	string stripped;				// the text without comments
+	bool isInLiteral = false;	// whether or not we're in a string literal
+	stripped.reserve(end - begin);
+	for (const char* i = begin; i < end; ++i)
+	{
+		if (*i == '"')
 		{
-			continue;
+			isInLiteral = !isInLiteral;
 		}
-		else if (buffer == "EU4txt")
+		else if (*i == '\n')
 		{
-			continue;
+			isInLiteral = false;
 		}
-		currObject += "\n";
-
-		bool opened						= false;				// whether or not we just opened a new brace level
-		bool isInLiteral				= false;				// whether or not we're in a string literal
-		const char* str				= buffer.c_str();	// a character string of the text under consideration
-		const unsigned int strSize	= buffer.size();	// the size of the text under consideration
-		for (unsigned int i = 0; i < strSize; ++i)
+		else if ((*i == '#') && !isInLiteral)
 		{
-			if ('"' == str[i])
-			{
-				isInLiteral = !isInLiteral;
-			}
-			if (isInLiteral)
-			{
-				currObject += str[i];
-				continue;
-			}
-			if ('#' == str[i])
+			const char* endOfLine = static_cast<const char*>(memchr(i, '\n', end - i));	// the end of the comment
+			if (endOfLine == nullptr)
 			{
 				break;
 			}
-			if ('{' == str[i])
-			{
-				++openBraces;
-				opened = true;
-			}
-			else if ('}' == str[i])
-			{
-				--openBraces;
-			}
-			currObject += str[i];
-		}
-
-		if (openBraces > 0)
-		{
-			topLevel = false;
+			i = endOfLine;
+			stripped += '\n';
 			continue;
 		}
+		stripped += *i;
+	}
+	return stripped;
+}
 
-		if (currObject == "")
-		{
-			continue;
-		}
 
-		// Don't try to end an object that hasn't started properly;
-		// accounts for such constructions as
-		// object = 
-		// { 
-		// where openBraces is zero after the first line of the object. 
-		// Not a problem for non-top-level objects since these will have
-		// nonzero openBraces anyway.
-		// But don't continue if the object was all on one line.
-		if (topLevel && !opened)
+bool isBlank(const char* begin, const char* end)
+{
+	for (const char* i = begin; i < end; ++i)
+	{
+		if ((*i != ' ') && (*i != '\t') && (*i != '\r') && (*i != '\n'))
 		{
-			continue; 
+			return false;
 		}
-
-		break;
 	}
-	return currObject;
+	return true;
 }
 
 
-bool readFile(ifstream& read)
+const char* skipHeader(const char* begin, const char* end)
 {
-	clearStack();
-	read.unsetf(std::ios::skipws);
-
-	char firstChar = read.peek();
-	if (firstChar == (char)0xEF)
+	if ((end - begin >= 6) && ((strncmp(begin, "EU4txt", 6) == 0) || (strncmp(begin, "CK2txt", 6) == 0)))
 	{
-		char bitBucket[3];
-		read.read(bitBucket, 3);
+		begin += 6;
 	}
+	return begin;
+}
+
 
-	const static Parser<string::iterator> p;
-	const static SkipComment<string::iterator> s;
+bool readBuffer(const char* begin, const char* end, Object* _topLevel)
+{
+	initParser();
+	clearStack();
+	topLevel = _topLevel;
 
-	/* buffer and parse one object at a time */
-	while (read.good())
+	const static Parser<const char*> p;
+	const static SkipComment<const char*> s;
+
+	/* parse one object at a time, directly out of the buffer where possible */
+	begin = skipHeader(begin, end);
+	while (begin < end)
 	{
-		string currObject = bufferOneObject(read);	// the object under consideration
-		if (!qi::phrase_parse(currObject.begin(), currObject.end(), p, s))
+		bool hasComments;	// whether or not the object has comments that need stripping
+		const char* objectEnd = findEndOfObject(begin, end, hasComments);	// the end of the object under consideration
+		if (!isBlank(begin, objectEnd))
 		{
-			clearStack();
-			return false;
+			bool parsed;	// whether or not the object could be parsed
+			if (hasComments)
+			{
+				string currObject = stripComments(begin, objectEnd);	// the object under consideration
+				const char* first = currObject.data();
+				parsed = qi::phrase_parse(first, first + currObject.size(), p, s);
+			}
+			else
+			{
+				const char* first = begin;
+				parsed = qi::phrase_parse(first, objectEnd, p, s);
+			}
+			if (!parsed)
+			{
+				clearStack();
+				return false;
+			}
 		}
+		begin = objectEnd;
 	}
 
 	clearStack();
@@ -459,19 +493,24 @@ Object* doParseFile(string filename)
 		debugme = true;
 	*/
 
-	initParser();
-	Object* obj = getTopLevel();	// the top level object
-	ifstream read(filename); 
-	if (!read.is_open())
-	{
-		return nullptr;
-	}
-	read.imbue(std::locale(std::locale::empty(), new std::codecvt_utf8<wchar_t,0x10ffff, std::consume_header>));
-	readFile(read);  
-	read.close();
-	read.clear();
+	ParadoxParser parser(ParserEncoding::UTF8, backend);	// does the actual parsing
+	parser.setParallelParsing(parallelParsing);
+	topLevel = parser.parseFile(filename);
+	return topLevel;
+}
 
-	return obj;
+
+
+void setBackend(ParserBackend newBackend)
+{
+	backend = newBackend;
+}
+
+
+
+void setParallelParsing(bool enabled)
+{
+	parallelParsing = enabled;
 }
 
 
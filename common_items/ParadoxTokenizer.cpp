@@ -0,0 +1,1003 @@
+/*Copyright (c) 2016 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+
+#include "ParadoxTokenizer.h"
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+#include "BinaryTokenTable.h"
+#include "Encoding.h"
+#include "Log.h"
+#include "ObjectArena.h"
+#include "OSCompatibilityLayer.h"
+#include "ThreadPool.h"
+#include <algorithm>
+
+
+
+namespace
+{
+
+enum CharacterClass
+{
+	WhitespaceCharacter,
+	ScalarCharacter,
+	QuoteCharacter,
+	CommentCharacter,
+	EqualsCharacter,
+	OpenBraceCharacter,
+	CloseBraceCharacter
+};
+
+
+struct CharacterClassTable
+{
+	CharacterClassTable()
+	{
+		for (int i = 0; i < 256; i++)
+		{
+			classes[i] = ScalarCharacter;
+		}
+		classes[static_cast<unsigned char>('\0')]	= WhitespaceCharacter;
+		classes[static_cast<unsigned char>(' ')]	= WhitespaceCharacter;
+		classes[static_cast<unsigned char>('\t')]	= WhitespaceCharacter;
+		classes[static_cast<unsigned char>('\r')]	= WhitespaceCharacter;
+		classes[static_cast<unsigned char>('\n')]	= WhitespaceCharacter;
+		classes[static_cast<unsigned char>('\v')]	= WhitespaceCharacter;
+		classes[static_cast<unsigned char>('\f')]	= WhitespaceCharacter;
+		classes[static_cast<unsigned char>('"')]	= QuoteCharacter;
+		classes[static_cast<unsigned char>('#')]	= CommentCharacter;
+		classes[static_cast<unsigned char>('=')]	= EqualsCharacter;
+		classes[static_cast<unsigned char>('{')]	= OpenBraceCharacter;
+		classes[static_cast<unsigned char>('}')]	= CloseBraceCharacter;
+	}
+
+	unsigned char classes[256];	// the class of each possible byte
+};
+
+const CharacterClassTable characterClasses;	// the lookup table used by the tokenizer
+
+inline unsigned char classOf(const char c)
+{
+	return characterClasses.classes[static_cast<unsigned char>(c)];
+}
+
+
+// The ids binary saves use for punctuation and values. All other ids are names from a BinaryTokenTable.
+enum BinaryTokenId
+{
+	BinaryEquals			= 0x0001,
+	BinaryOpenBrace		= 0x0003,
+	BinaryCloseBrace		= 0x0004,
+	BinaryInt32				= 0x000C,	// followed by a signed 32-bit integer
+	BinaryFixed32			= 0x000D,	// followed by a signed 32-bit count of thousandths
+	BinaryBool				= 0x000E,	// followed by a byte
+	BinaryQuotedString	= 0x000F,	// followed by a 16-bit length and the text
+	BinaryUInt32			= 0x0014,	// followed by an unsigned 32-bit integer
+	BinaryString			= 0x0017,	// followed by a 16-bit length and the text
+	BinaryFixed64			= 0x0167,	// followed by a signed 64-bit count of 1/32768ths
+	BinaryUInt64			= 0x029C,	// followed by an unsigned 64-bit integer
+	BinaryInt64				= 0x0317		// followed by a signed 64-bit integer
+};
+
+
+template <typename Value> bool readBinary(const char*& current, const char* end, Value& value)
+{
+	if (static_cast<size_t>(end - current) < sizeof(value))
+	{
+		return false;
+	}
+	memcpy(&value, current, sizeof(value));
+	current += sizeof(value);
+	return true;
+}
+
+}
+
+
+
+ParadoxTokenizer::ParadoxTokenizer(const char* begin, const char* end, const char* _fileStart):
+	fileStart((_fileStart != nullptr) ? _fileStart : begin),
+	current(begin),
+	bufferEnd(end),
+	countedTo(fileStart),
+	countedLines(1),
+	lookahead(),
+	hasLookahead(false),
+	binaryTokens(nullptr),
+	keyIsDate(false),
+	dateIsNext(false),
+	inDateList(false),
+	nextNumber(0)
+{
+}
+
+
+Token ParadoxTokenizer::next()
+{
+	if (hasLookahead)
+	{
+		hasLookahead = false;
+		return lookahead;
+	}
+	return lex();
+}
+
+
+const Token& ParadoxTokenizer::peek()
+{
+	if (!hasLookahead)
+	{
+		lookahead		= lex();
+		hasLookahead	= true;
+	}
+	return lookahead;
+}
+
+
+int ParadoxTokenizer::getLineNumber() const
+{
+	if (binaryTokens != nullptr)
+	{
+		return static_cast<int>(current - fileStart);
+	}
+
+	// the tokenizer only moves forward, so each call only counts the line breaks since the last one
+	countedLines += static_cast<int>(count(countedTo, current, '\n'));
+	countedTo = current;
+	return countedLines;
+}
+
+
+bool ParadoxTokenizer::isSaveHeader(const Token& token)
+{
+	if ((token.type != TokenType::Scalar) || (token.text.size() <= 3) || !token.text.ends_with("txt"))
+	{
+		return false;
+	}
+	for (auto c: token.text)
+	{
+		if (!isalnum(static_cast<unsigned char>(c)))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+
+Token ParadoxTokenizer::lex()
+{
+	if (binaryTokens != nullptr)
+	{
+		return lexBinary();
+	}
+
+	while (current < bufferEnd)
+	{
+		switch (classOf(*current))
+		{
+			case WhitespaceCharacter:
+				++current;
+				break;
+
+			case CommentCharacter:
+				{
+					const char* endOfLine = static_cast<const char*>(memchr(current, '\n', bufferEnd - current));	// the end of the comment
+					current = (endOfLine == nullptr) ? bufferEnd : endOfLine + 1;
+				}
+				break;
+
+			case EqualsCharacter:
+				return Token(TokenType::Equals, current++, 1);
+
+			case OpenBraceCharacter:
+				return Token(TokenType::OpenBrace, current++, 1);
+
+			case CloseBraceCharacter:
+				return Token(TokenType::CloseBrace, current++, 1);
+
+			case QuoteCharacter:
+				{
+					const char* start = ++current;	// the first character inside the quotes
+					const char* closingQuote = static_cast<const char*>(memchr(current, '"', bufferEnd - current));	// the end of the string
+					if (closingQuote == nullptr)
+					{
+						current = bufferEnd;
+						return Token(TokenType::String, start, bufferEnd - start);
+					}
+					current = closingQuote + 1;
+					return Token(TokenType::String, start, closingQuote - start);
+				}
+
+			case ScalarCharacter:
+			default:
+				{
+					const char* start = current;	// the first character of the scalar
+					while ((++current < bufferEnd) && (classOf(*current) == ScalarCharacter))
+					{
+					}
+					return Token(TokenType::Scalar, start, current - start);
+				}
+		}
+	}
+
+	return Token(TokenType::EndOfInput, bufferEnd, 0);
+}
+
+
+Token ParadoxTokenizer::lexBinary()
+{
+	const bool afterDateKey	= keyIsDate;	// whether or not the previous token was a key for dates
+	const bool isDate			= dateIsNext;	// whether or not this token is the value of a key for dates
+	const bool inList			= inDateList;	// whether or not this token is in the list of a key for dates
+	dateIsNext	= false;
+	keyIsDate	= false;
+	inDateList	= false;
+
+	uint16_t id;	// the token id
+	if (!readBinary(current, bufferEnd, id))
+	{
+		current = bufferEnd;
+		return Token(TokenType::EndOfInput, bufferEnd, 0);
+	}
+
+	switch (id)
+	{
+		case BinaryEquals:
+			dateIsNext = afterDateKey;
+			return Token(TokenType::Equals, "=", 1);
+
+		case BinaryOpenBrace:
+			inDateList = isDate;
+			return Token(TokenType::OpenBrace, "{", 1);
+
+		case BinaryCloseBrace:
+			return Token(TokenType::CloseBrace, "}", 1);
+
+		case BinaryInt32:
+			{
+				int32_t value;
+				if (readBinary(current, bufferEnd, value))
+				{
+					// anything but another date ends a list of dates, including an integer that turns out to be a key
+					uint16_t nextId;
+					const char* next = current;
+					if (inList && !(readBinary(next, bufferEnd, nextId) && (nextId == BinaryEquals)))
+					{
+						inDateList = true;
+						return formatDate(value);
+					}
+					return isDate ? formatDate(value) : formatInteger(value, 1, 0);
+				}
+			}
+			break;
+
+		case BinaryFixed32:
+			{
+				int32_t value;
+				if (readBinary(current, bufferEnd, value))
+				{
+					return formatInteger(value, 1000, 3);
+				}
+			}
+			break;
+
+		case BinaryBool:
+			{
+				uint8_t value;
+				if (readBinary(current, bufferEnd, value))
+				{
+					return (value != 0) ? Token(TokenType::Scalar, "yes", 3) : Token(TokenType::Scalar, "no", 2);
+				}
+			}
+			break;
+
+		case BinaryQuotedString:
+		case BinaryString:
+			{
+				uint16_t length;
+				if (readBinary(current, bufferEnd, length) && (static_cast<size_t>(bufferEnd - current) >= length))
+				{
+					const char* start = current;	// the start of the text
+					current += length;
+					return Token((id == BinaryQuotedString) ? TokenType::String : TokenType::Scalar, start, length);
+				}
+			}
+			break;
+
+		case BinaryUInt32:
+			{
+				uint32_t value;
+				if (readBinary(current, bufferEnd, value))
+				{
+					return formatUnsigned(value);
+				}
+			}
+			break;
+
+		case BinaryFixed64:
+			{
+				int64_t value;
+				if (readBinary(current, bufferEnd, value))
+				{
+					return formatInteger(value, 32768, 5);
+				}
+			}
+			break;
+
+		case BinaryUInt64:
+			{
+				uint64_t value;
+				if (readBinary(current, bufferEnd, value))
+				{
+					return formatUnsigned(value);
+				}
+			}
+			break;
+
+		case BinaryInt64:
+			{
+				int64_t value;
+				if (readBinary(current, bufferEnd, value))
+				{
+					return formatInteger(value, 1, 0);
+				}
+			}
+			break;
+
+		default:
+			{
+				const string* name = binaryTokens->getName(id);	// the key or keyword the id stands for
+				keyIsDate = binaryTokens->isDate(id);
+				if (name != nullptr)
+				{
+					return Token(TokenType::Scalar, name->data(), name->size());
+				}
+				char* text = numbers[nextNumber];	// where to write the unknown id
+				nextNumber = (nextNumber + 1) % numberBuffers;
+				return Token(TokenType::Scalar, text, snprintf(text, numberLength, "0x%04x", id));
+			}
+	}
+
+	// the value was cut off
+	current = bufferEnd;
+	return Token(TokenType::EndOfInput, bufferEnd, 0);
+}
+
+
+Token ParadoxTokenizer::formatUnsigned(uint64_t value)
+{
+	char* text = numbers[nextNumber];	// where to write the number
+	nextNumber = (nextNumber + 1) % numberBuffers;
+
+	char digits[20];	// the digits of the number, last first
+	int count = 0;		// the number of digits
+	do
+	{
+		digits[count++] = static_cast<char>('0' + value % 10);
+		value /= 10;
+	} while (value > 0);
+
+	for (int i = 0; i < count; i++)
+	{
+		text[i] = digits[count - 1 - i];
+	}
+	return Token(TokenType::Scalar, text, count);
+}
+
+
+Token ParadoxTokenizer::formatInteger(int64_t value, int64_t scale, int decimals)
+{
+	// written out digit by digit rather than with printf, which dominates the time to read a binary save otherwise
+	const bool negative = (value < 0);	// whether or not a minus sign is needed
+	const uint64_t magnitude = negative ? (0 - static_cast<uint64_t>(value)) : static_cast<uint64_t>(value);	// the size of the number
+	uint64_t whole = magnitude / scale;		// the part before the decimal point
+	uint64_t fraction = 0;						// the part after the decimal point, rounded to the given decimals
+	uint64_t fractionLimit = 1;				// one more than the largest possible fraction
+	if (decimals > 0)
+	{
+		for (int i = 0; i < decimals; i++)
+		{
+			fractionLimit *= 10;
+		}
+		const uint64_t scaled = (magnitude % scale) * fractionLimit;	// the fraction, in units of 1/scale of its last digit
+		fraction = scaled / scale;
+		const uint64_t remainder = scaled % scale;	// decides the rounding, half to even like printf
+		if ((remainder * 2 > static_cast<uint64_t>(scale)) || ((remainder * 2 == static_cast<uint64_t>(scale)) && (fraction % 2 == 1)))
+		{
+			fraction++;
+		}
+		if (fraction == fractionLimit)
+		{
+			whole++;
+			fraction = 0;
+		}
+	}
+
+	Token token = formatUnsigned(whole);	// the whole part of the number
+	char* text = const_cast<char*>(token.text.data());
+	size_t length = token.text.size();	// the length of the text so far
+	if (negative)
+	{
+		memmove(text + 1, text, length);
+		text[0] = '-';
+		length++;
+	}
+	if (decimals > 0)
+	{
+		text[length++] = '.';
+		for (int i = decimals - 1; i >= 0; i--)
+		{
+			text[length + i] = static_cast<char>('0' + fraction % 10);
+			fraction /= 10;
+		}
+		length += decimals;
+	}
+	return Token(TokenType::Scalar, text, length);
+}
+
+
+Token ParadoxTokenizer::formatDate(int32_t hours)
+{
+	// binary dates count hours from the start of 5000 BC, in years that are always 365 days long. Dates before
+	// then are negative, so the divisions round down rather than towards zero to keep counting back from there.
+	static const int daysInMonth[12] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+	const int64_t days			= (hours >= 0) ? (hours / 24) : -((23 - static_cast<int64_t>(hours)) / 24);	// the days since the start of the calendar
+	const int64_t yearsSince	= (days >= 0) ? (days / 365) : -((364 - days) / 365);								// the whole years since the start of the calendar
+	const int year					= static_cast<int>(yearsSince - 5000);												// the year of the date
+	int dayOfYear					= static_cast<int>(days - yearsSince * 365);										// the days since the start of the year
+	int month		= 0;							// the month of the date, from 0
+	while ((month < 11) && (dayOfYear >= daysInMonth[month]))
+	{
+		dayOfYear -= daysInMonth[month];
+		month++;
+	}
+
+	char* text = numbers[nextNumber];	// where to write the date
+	nextNumber = (nextNumber + 1) % numberBuffers;
+	return Token(TokenType::Scalar, text, snprintf(text, numberLength, "%d.%d.%d", year, month + 1, dayOfYear + 1));
+}
+
+
+
+namespace
+{
+
+// A piece of a buffer that can be parsed independently of the rest
+struct ParsePiece
+{
+	const char*	begin;	// the start of the piece
+	const char*	end;		// one past the end of the piece
+	int			block;	// the index of the large top-level block this piece is inside, or -1 if it is at the top level
+};
+
+
+const size_t minimumParallelSize	= 4 * 1024 * 1024;	// buffers smaller than this are not worth splitting up
+const size_t minimumPieceSize		= 256 * 1024;			// the smallest piece worth handing to another thread
+const size_t piecesPerThread		= 4;						// more pieces than threads, so that uneven pieces still balance out
+
+
+// Checks whether the top-level block opened at blockOpen can be split up. It can if the parser would
+// see it as 'key = { key = ...' and so parse its contents with parseAssignments. Any other statements
+// since the last top-level block ended (statementStart) are followed so the key is found the same way
+// the parser would find it. The block's key is returned in key.
+bool findSplittableBlockKey(const char* statementStart, const char* blockOpen, const char* end, Token& key)
+{
+	ParadoxTokenizer tokenizer(statementStart, end);	// the tokens of the statements before and in the block
+	while (true)
+	{
+		Token token = tokenizer.next();	// the token under consideration
+		if (token.type == TokenType::Equals)
+		{
+			// an assignment without a key, which the parser keeps going past unless it is the block
+			const Token& value = tokenizer.peek();	// the value being assigned
+			if ((value.type == TokenType::OpenBrace) || (value.type == TokenType::EndOfInput))
+			{
+				return false;
+			}
+			if ((value.type == TokenType::Scalar) || (value.type == TokenType::String))
+			{
+				tokenizer.next();
+			}
+			continue;
+		}
+		if ((token.type == TokenType::OpenBrace) || (token.type == TokenType::EndOfInput))
+		{
+			// the block has no key
+			return false;
+		}
+		if (((token.type != TokenType::Scalar) && (token.type != TokenType::String)) || (tokenizer.peek().type != TokenType::Equals))
+		{
+			continue;
+		}
+		tokenizer.next();
+
+		const Token& value = tokenizer.peek();	// the value being assigned
+		if (value.type == TokenType::OpenBrace)
+		{
+			if (value.text.data() != blockOpen)
+			{
+				return false;
+			}
+			key = token;
+			tokenizer.next();
+			break;
+		}
+		if ((value.type == TokenType::Scalar) || (value.type == TokenType::String))
+		{
+			tokenizer.next();
+		}
+	}
+
+	// the parser only parses the block's contents as assignments if they start with one
+	Token first = tokenizer.next();	// the first token in the block
+	return ((first.type == TokenType::Scalar) || (first.type == TokenType::String)) && (tokenizer.peek().type == TokenType::Equals);
+}
+
+
+// Splits a buffer into pieces of roughly targetSize bytes that can be parsed independently. Pieces
+// end where a top-level block closes. Top-level blocks larger than targetSize are also split where the
+// blocks inside them close, and their keys are added to blockKeys. This only needs to follow braces,
+// strings and comments, so it is much faster than parsing, and it treats them exactly as the tokenizer does.
+void splitBuffer(const char* begin, const char* end, size_t targetSize, vector<ParsePiece>& pieces, vector<Token>& blockKeys)
+{
+	const char* pieceStart		= begin;		// the start of the top-level piece being built
+	const char* statementStart	= begin;		// where the last top-level block ended
+	const char* blockOpen		= nullptr;	// the opening brace of the top-level block being scanned
+	vector<const char*> blockSplits;			// where the top-level block being scanned could be split
+	int depth = 0;									// the number of braces currently open
+	for (const char* i = begin; i < end; ++i)
+	{
+		switch (*i)
+		{
+			case '"':
+				{
+					const char* closingQuote = static_cast<const char*>(memchr(i + 1, '"', end - i - 1));	// the end of the string
+					i = (closingQuote == nullptr) ? end - 1 : closingQuote;
+				}
+				break;
+
+			case '#':
+				{
+					const char* endOfLine = static_cast<const char*>(memchr(i, '\n', end - i));	// the end of the comment
+					i = (endOfLine == nullptr) ? end - 1 : endOfLine;
+				}
+				break;
+
+			case '{':
+				if (depth == 0)
+				{
+					blockOpen = i;
+					blockSplits.clear();
+				}
+				depth++;
+				break;
+
+			case '}':
+				if (depth == 0)
+				{
+					// an unmatched brace, which the parser skips
+					break;
+				}
+				depth--;
+				if (depth == 1)
+				{
+					const char* lastSplit = blockSplits.empty() ? blockOpen + 1 : blockSplits.back();	// the start of the block's current piece
+					if (static_cast<size_t>(i + 1 - lastSplit) >= targetSize)
+					{
+						blockSplits.push_back(i + 1);
+					}
+				}
+				else if (depth == 0)
+				{
+					Token key;	// the key of the block that just closed
+					if (!blockSplits.empty() && findSplittableBlockKey(statementStart, blockOpen, end, key))
+					{
+						const char* keyStart = (key.type == TokenType::String) ? key.text.data() - 1 : key.text.data();	// the start of the block's assignment
+						if (keyStart > pieceStart)
+						{
+							pieces.push_back({ pieceStart, keyStart, -1 });
+						}
+						const int blockIndex = static_cast<int>(blockKeys.size());	// the index of this block's key
+						blockKeys.push_back(key);
+						const char* blockPieceStart = blockOpen + 1;	// the start of the block's next piece
+						for (auto split: blockSplits)
+						{
+							pieces.push_back({ blockPieceStart, split, blockIndex });
+							blockPieceStart = split;
+						}
+						pieces.push_back({ blockPieceStart, i, blockIndex });
+						pieceStart = i + 1;
+					}
+					else if (static_cast<size_t>(i + 1 - pieceStart) >= targetSize)
+					{
+						pieces.push_back({ pieceStart, i + 1, -1 });
+						pieceStart = i + 1;
+					}
+					statementStart = i + 1;
+					blockSplits.clear();
+				}
+				break;
+		}
+	}
+	if (pieceStart < end)
+	{
+		pieces.push_back({ pieceStart, end, -1 });
+	}
+}
+
+}
+
+
+
+ParadoxTokenParser::ParadoxTokenParser(const char* begin, const char* end, bool _is8859_15, const char* fileStart):
+	tokenizer(begin, end, fileStart),
+	is8859_15(_is8859_15),
+	hadErrors(false),
+	isPartial(false)
+{
+}
+
+
+bool ParadoxTokenParser::parse(Object* topLevel)
+{
+	parseAssignments(topLevel, true);
+	return !hadErrors;
+}
+
+
+bool ParadoxTokenParser::parseBlockContents(Object* parent)
+{
+	isPartial = true;
+	parseAssignments(parent, false);
+	return !hadErrors;
+}
+
+
+bool ParadoxTokenParser::parseInParallel(const char* begin, const char* end, bool is8859_15, Object* topLevel)
+{
+	ThreadPool& pool = ThreadPool::getShared();	// the threads to parse on
+	vector<ParsePiece> pieces;							// the pieces of the buffer to parse separately
+	vector<Token> blockKeys;							// the keys of the large blocks that were split up
+	if ((static_cast<size_t>(end - begin) >= minimumParallelSize) && (pool.getNumThreads() > 1))
+	{
+		const size_t targetPieceSize = (end - begin) / (pool.getNumThreads() * piecesPerThread);	// how large each piece should be
+		splitBuffer(begin, end, max(targetPieceSize, minimumPieceSize), pieces, blockKeys);
+	}
+	if (pieces.size() < 2)
+	{
+		ParadoxTokenParser parser(begin, end, is8859_15);
+		return parser.parse(topLevel);
+	}
+
+	// each piece gets its own arena, as an arena can only be used by one thread at a time
+	ObjectArena* arena = ObjectArena::getActive();					// the arena the parsed objects belong in, if any
+	vector<Object*> pieceObjects(pieces.size(), nullptr);			// the objects holding what was parsed from each piece
+	vector<ObjectArena*> pieceArenas(pieces.size(), nullptr);	// the arenas the pieces were parsed into
+	vector<char> pieceErrors(pieces.size(), 0);						// whether or not each piece had malformed input
+	pool.parallelFor(pieces.size(), [&](size_t i)
+	{
+		if (arena != nullptr)
+		{
+			pieceArenas[i] = new ObjectArena();
+		}
+		ActiveArenaScope arenaScope(pieceArenas[i]);
+
+		pieceObjects[i] = new Object(internKey("topLevel"));
+		ParadoxTokenParser parser(pieces[i].begin, pieces[i].end, is8859_15, begin);
+		if (pieces[i].block < 0)
+		{
+			pieceErrors[i] = !parser.parse(pieceObjects[i]);
+		}
+		else
+		{
+			pieceErrors[i] = !parser.parseBlockContents(pieceObjects[i]);
+		}
+	});
+
+	ParadoxTokenParser keyParser(begin, end, is8859_15);	// converts the keys of split blocks
+	bool hadErrors = false;			// whether or not any piece had malformed input
+	Object* splitBlock = nullptr;	// the object for the large block being reassembled, if any
+	int splitBlockIndex = -1;		// the index of that block in blockKeys
+	for (size_t i = 0; i < pieces.size(); i++)
+	{
+		Object* parent = topLevel;	// the object this piece's objects belong to
+		if (pieces[i].block >= 0)
+		{
+			if (pieces[i].block != splitBlockIndex)
+			{
+				splitBlockIndex	= pieces[i].block;
+				splitBlock			= new Object(keyParser.makeKey(blockKeys[splitBlockIndex].text));
+				topLevel->setValue(splitBlock);
+			}
+			parent = splitBlock;
+		}
+		for (auto object: pieceObjects[i]->getLeaves())
+		{
+			parent->setValue(object);
+		}
+
+		pieceObjects[i]->setValue(vector<Object*>());
+		delete pieceObjects[i];
+		if (arena != nullptr)
+		{
+			arena->adoptBlocks(*pieceArenas[i]);
+			delete pieceArenas[i];
+		}
+		hadErrors = hadErrors || (pieceErrors[i] != 0);
+	}
+
+	return !hadErrors;
+}
+
+
+void ParadoxTokenParser::parseAssignments(Object* parent, bool isTopLevel)
+{
+	while (true)
+	{
+		Token token = tokenizer.next();	// the token under consideration
+		switch (token.type)
+		{
+			case TokenType::EndOfInput:
+				if (!isTopLevel && !isPartial)
+				{
+					warn("Missing closing brace at end of input");
+				}
+				return;
+
+			case TokenType::CloseBrace:
+				if (isTopLevel)
+				{
+					warn("Unmatched closing brace");
+					continue;
+				}
+				return;
+
+			case TokenType::OpenBrace:
+				// stray braces without a key, as in some EU3 decision mods
+				if (tokenizer.peek().type == TokenType::CloseBrace)
+				{
+					tokenizer.next();
+				}
+				else
+				{
+					warn("Skipping a braced block without a key");
+					skipBlock();
+				}
+				continue;
+
+			case TokenType::Equals:
+				{
+					Object* assignment = new Object(internKey("epsilon"));	// an assignment with a missing key
+					parseValue(assignment);
+					parent->setValue(assignment);
+				}
+				continue;
+
+			case TokenType::Scalar:
+			case TokenType::String:
+				if (tokenizer.peek().type == TokenType::Equals)
+				{
+					tokenizer.next();
+					Object* assignment = new Object(makeKey(token.text));	// the object being assigned to
+					parseValue(assignment);
+					parent->setValue(assignment);
+				}
+				else if (isTopLevel && ParadoxTokenizer::isSaveHeader(token))
+				{
+					continue;
+				}
+				else
+				{
+					warn("Skipping '" + makeString(token.text) + "', which is not part of an assignment");
+				}
+				continue;
+		}
+	}
+}
+
+
+void ParadoxTokenParser::parseValue(Object* obj)
+{
+	const Token& token = tokenizer.peek();	// the start of the value
+	switch (token.type)
+	{
+		case TokenType::Scalar:
+		case TokenType::String:
+			obj->setValue(makeString(tokenizer.next().text));
+			return;
+
+		case TokenType::OpenBrace:
+			tokenizer.next();
+			parseBlock(obj);
+			return;
+
+		default:
+			warn("Missing value for " + obj->getKey());
+			return;
+	}
+}
+
+
+void ParadoxTokenParser::parseBlock(Object* obj)
+{
+	switch (tokenizer.peek().type)
+	{
+		case TokenType::CloseBrace:
+			tokenizer.next();
+			return;
+
+		case TokenType::OpenBrace:
+			parseObjectList(obj);
+			return;
+
+		case TokenType::Scalar:
+		case TokenType::String:
+			{
+				Token first = tokenizer.next();	// either a key or the first item of a list
+				if (tokenizer.peek().type != TokenType::Equals)
+				{
+					parseTagList(obj, first);
+					return;
+				}
+				tokenizer.next();
+				Object* assignment = new Object(makeKey(first.text));	// the first object in this block
+				parseValue(assignment);
+				obj->setValue(assignment);
+				parseAssignments(obj, false);
+			}
+			return;
+
+		default:
+			parseAssignments(obj, false);
+			return;
+	}
+}
+
+
+void ParadoxTokenParser::parseTagList(Object* obj, const Token& first)
+{
+	vector<string> tokens;	// the items in the list
+	tokens.push_back(makeString(first.text));
+	while (true)
+	{
+		Token token = tokenizer.next();	// the item under consideration
+		if ((token.type == TokenType::Scalar) || (token.type == TokenType::String))
+		{
+			tokens.push_back(makeString(token.text));
+		}
+		else if (token.type == TokenType::CloseBrace)
+		{
+			break;
+		}
+		else if (token.type == TokenType::EndOfInput)
+		{
+			warn("Missing closing brace at end of input");
+			break;
+		}
+		else
+		{
+			warn("Skipping the rest of a malformed list in " + obj->getKey());
+			if (token.type == TokenType::OpenBrace)
+			{
+				skipBlock();
+			}
+			skipBlock();
+			break;
+		}
+	}
+	obj->addToList(tokens.begin(), tokens.end());
+}
+
+
+void ParadoxTokenParser::parseObjectList(Object* obj)
+{
+	while (true)
+	{
+		Token token = tokenizer.next();	// the start of the next object in the list
+		if (token.type == TokenType::OpenBrace)
+		{
+			Object* listItem = new Object(internKey("objlist"));	// the object holding this item's contents
+			listItem->setObjList();
+			parseBlock(listItem);
+			obj->setValue(listItem);
+		}
+		else if (token.type == TokenType::CloseBrace)
+		{
+			return;
+		}
+		else if (token.type == TokenType::EndOfInput)
+		{
+			warn("Missing closing brace at end of input");
+			return;
+		}
+		else
+		{
+			warn("Skipping the rest of a malformed object list in " + obj->getKey());
+			skipBlock();
+			return;
+		}
+	}
+}
+
+
+void ParadoxTokenParser::skipBlock()
+{
+	int depth = 1;	// the number of braces left to close
+	while (depth > 0)
+	{
+		switch (tokenizer.next().type)
+		{
+			case TokenType::OpenBrace:
+				depth++;
+				break;
+			case TokenType::CloseBrace:
+				depth--;
+				break;
+			case TokenType::EndOfInput:
+				return;
+			default:
+				break;
+		}
+	}
+}
+
+
+const string* ParadoxTokenParser::makeKey(boost::string_ref text) const
+{
+	if (is8859_15)
+	{
+		for (auto c: text)
+		{
+			if (static_cast<unsigned char>(c) >= 0x80)
+			{
+				return internKey(makeString(text));
+			}
+		}
+	}
+	return internKey(text);
+}
+
+
+string ParadoxTokenParser::makeString(boost::string_ref text) const
+{
+	string result;
+	if (is8859_15 && !Encoding::isASCII(text.data(), text.data() + text.size()))
+	{
+		Encoding::append8859_15AsUTF8(text.data(), text.data() + text.size(), result);
+	}
+	else
+	{
+		result.assign(text.data(), text.size());
+	}
+	return result;
+}
+
+
+void ParadoxTokenParser::warn(const string& message)
+{
+	hadErrors = true;
+	LOG(LogLevel::Warning) << message << " (line " << tokenizer.getLineNumber() << ")";
+}
@@ -0,0 +1,161 @@
+/*Copyright (c) 2016 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+
+#ifndef PARADOX_TOKENIZER_H_
+#define PARADOX_TOKENIZER_H_
+
+
+
+#include "Object.h"
+#include <stdint.h>
+#include <string>
+#include <boost/utility/string_ref.hpp>
+using namespace std;
+
+
+
+class BinaryTokenTable;
+
+
+enum class ParserBackend
+{
+	Tokenizer,	// the hand-written tokenizer in this file
+	Spirit		// the original Boost.Spirit grammars
+};
+
+
+enum class TokenType
+{
+	Scalar,		// an unquoted leaf, such as 'yes' or '1444.11.11'
+	String,		// a quoted string, without its quotes
+	Equals,
+	OpenBrace,
+	CloseBrace,
+	EndOfInput
+};
+
+
+struct Token
+{
+	Token() : type(TokenType::EndOfInput), text() {}
+	Token(TokenType _type, const char* start, size_t length) : type(_type), text(start, length) {}
+
+	TokenType			type;	// what kind of token this is
+	boost::string_ref	text;	// the text of the token, pointing into the tokenized buffer
+};
+
+
+// Splits a buffer of Paradox script into tokens with a single table lookup per character.
+// Tokens point into the buffer, so the buffer must outlive them. If the buffer is only part of a file,
+// fileStart gives the start of the file so that line numbers still match it.
+//
+// Given a BinaryTokenTable, it reads the binary format of ironman saves instead (without the header),
+// and gives the same tokens the text of the save would. Numbers are written out into a small ring of
+// buffers, so their text is only valid until a few more tokens have been read. The integers assigned to a
+// key the table marks as a date are written as dates, whether alone or as a list of them in braces.
+class ParadoxTokenizer
+{
+	public:
+		ParadoxTokenizer(const char* begin, const char* end, const char* fileStart = nullptr);
+
+		void				setBinaryTokens(const BinaryTokenTable* tokens) { binaryTokens = tokens; }
+
+		Token				next();
+		const Token&	peek();
+
+		// The line being read, or the byte offset in a binary buffer
+		int				getLineNumber() const;
+
+		// Whether or not the token is the header of a text save, such as EU4txt, CK2txt or HOI4txt
+		static bool		isSaveHeader(const Token& token);
+
+	private:
+		Token lex();
+		Token lexBinary();
+		Token formatUnsigned(uint64_t value);
+		Token formatInteger(int64_t value, int64_t scale, int decimals);
+		Token formatDate(int32_t hours);
+
+		static const unsigned int numberBuffers	= 4;		// how many binary numbers can be in use at once
+		static const size_t			numberLength	= 32;		// the space for the text of each number
+
+		const char*					fileStart;			// the start of the file, for reporting line numbers
+		const char*					current;				// the next character to examine
+		const char*					bufferEnd;			// one past the last character in the buffer
+		mutable const char*		countedTo;			// how far line breaks have been counted for getLineNumber()
+		mutable int					countedLines;		// the line countedTo is on
+		Token							lookahead;			// the token returned by peek(), if any
+		bool							hasLookahead;		// whether or not lookahead holds a token
+		const BinaryTokenTable*	binaryTokens;		// the names of binary tokens, if the buffer is binary
+		bool							keyIsDate;			// whether or not the last binary token was a key for dates
+		bool							dateIsNext;			// whether or not the next binary value is a date
+		bool							inDateList;			// whether or not the binary values so far are a list of dates
+		char							numbers[numberBuffers][numberLength];	// the text of the last few binary numbers
+		unsigned int				nextNumber;			// the buffer in numbers to use next
+};
+
+
+// Builds the same Object tree as the Spirit grammars in ParadoxParserUTF8 and ParadoxParser8859_15
+// by recursive descent over a ParadoxTokenizer. The one difference is in object lists: each anonymous
+// 'objlist' item holds its own contents, where the Spirit grammars gave each item the contents of the
+// one after it and dropped the first.
+class ParadoxTokenParser
+{
+	public:
+		ParadoxTokenParser(const char* begin, const char* end, bool _is8859_15, const char* fileStart = nullptr);
+
+		// Reads the buffer as a binary save, without its header, using these token names
+		void setBinaryTokens(const BinaryTokenTable* tokens) { tokenizer.setBinaryTokens(tokens); }
+
+		// Adds everything in the buffer to topLevel. Returns false if any malformed input had to be skipped.
+		bool parse(Object* topLevel);
+
+		// Adds the assignments in the buffer, which is part of the inside of a block, to parent.
+		bool parseBlockContents(Object* parent);
+
+		// Like parse(), but large buffers are split where top-level assignments (or the assignments directly
+		// inside a large top-level block) end, and the pieces are parsed on the shared thread pool. The pieces'
+		// objects are then added to topLevel in their original order, so the result is the same as parse().
+		static bool parseInParallel(const char* begin, const char* end, bool is8859_15, Object* topLevel);
+
+	private:
+		void				parseAssignments(Object* parent, bool isTopLevel);
+		void				parseValue(Object* obj);
+		void				parseBlock(Object* obj);
+		void				parseTagList(Object* obj, const Token& first);
+		void				parseObjectList(Object* obj);
+		void				skipBlock();
+		const string*	makeKey(boost::string_ref text) const;
+		string			makeString(boost::string_ref text) const;
+		void				warn(const string& message);
+
+		ParadoxTokenizer	tokenizer;	// the source of tokens
+		bool					is8859_15;	// whether text must be converted from ISO 8859-15 to UTF-8
+		bool					hadErrors;	// whether or not any malformed input was skipped
+		bool					isPartial;	// whether or not the buffer ends inside a block, so running out of input is expected
+};
+
+
+
+#endif // PARADOX_TOKENIZER_H_
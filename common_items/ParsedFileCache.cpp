@@ -0,0 +1,404 @@
+/*Copyright (c) 2016 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+
+#include "ParsedFileCache.h"
+#include "Log.h"
+#include "ObjectArena.h"
+#include <cstring>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+
+
+namespace
+{
+
+const char		entryMagic[8]	= { 'P', 'D', 'X', 'T', 'R', 'E', 'E', '\0' };	// the start of every cache entry
+const uint32_t	entryVersion	= 1;															// changes whenever the entry format does
+
+enum NodeFlags
+{
+	LeafNode			= 1,	// the node has a single value
+	ObjectListNode	= 2	// the node is an object list, or a list of tokens
+};
+
+
+// Encodes a tree into a cache entry
+class EntryWriter
+{
+	public:
+		void writeHeader(const Utils::FileStamp& stamp, ParserEncoding encoding, ParserBackend backend)
+		{
+			header.append(entryMagic, sizeof(entryMagic));
+			append32(header, entryVersion);
+			append32(header, static_cast<uint32_t>(encoding));
+			append32(header, static_cast<uint32_t>(backend));
+			append64(header, stamp.size);
+			append64(header, static_cast<uint64_t>(stamp.modifiedTime));
+			append32(header, static_cast<uint32_t>(stamp.absolutePath.size()));
+			header.append(stamp.absolutePath);
+		}
+
+		void writeNode(Object* obj)
+		{
+			const bool isLeaf = obj->isLeaf();	// whether or not the node has a single value
+			nodes.push_back(static_cast<char>((isLeaf ? LeafNode : 0) | (obj->isObjectList() ? ObjectListNode : 0)));
+			append32(nodes, addString(obj->getKey()));
+			if (isLeaf)
+			{
+				append32(nodes, addString(obj->getLeaf()));
+				return;
+			}
+
+			const vector<string>& tokens = obj->getTokens();	// the node's list items
+			append32(nodes, static_cast<uint32_t>(tokens.size()));
+			for (const auto& token: tokens)
+			{
+				append32(nodes, addString(token));
+			}
+
+			const vector<Object*>& children = obj->getLeaves();	// the node's sub-objects
+			append32(nodes, static_cast<uint32_t>(children.size()));
+			for (auto child: children)
+			{
+				writeNode(child);
+			}
+		}
+
+		string getContents() const
+		{
+			string contents = header;	// the whole entry: the header, the string table, then the nodes
+			append32(contents, static_cast<uint32_t>(strings.size()));
+			for (auto text: strings)
+			{
+				append32(contents, static_cast<uint32_t>(text->size()));
+				contents.append(*text);
+			}
+			contents.append(nodes);
+			return contents;
+		}
+
+	private:
+		uint32_t addString(const string& text)
+		{
+			auto inserted = stringIndices.insert(make_pair(text, static_cast<uint32_t>(strings.size())));	// the string's entry in the table
+			if (inserted.second)
+			{
+				strings.push_back(&inserted.first->first);
+			}
+			return inserted.first->second;
+		}
+
+		static void append32(string& buffer, uint32_t value)
+		{
+			buffer.append(reinterpret_cast<const char*>(&value), sizeof(value));
+		}
+
+		static void append64(string& buffer, uint64_t value)
+		{
+			buffer.append(reinterpret_cast<const char*>(&value), sizeof(value));
+		}
+
+		string									header;			// the encoded header
+		string									nodes;			// the encoded nodes, in file order with each node before its children
+		unordered_map<string, uint32_t>	stringIndices;	// where each distinct string is in the table
+		vector<const string*>				strings;			// the distinct strings, in the order they were found
+};
+
+
+// Decodes a cache entry, checking every read against the end of the entry
+class EntryReader
+{
+	public:
+		EntryReader(const char* begin, const char* end) : current(begin), entryEnd(end) {}
+
+		bool readHeader(const Utils::FileStamp& stamp, ParserEncoding encoding, ParserBackend backend)
+		{
+			boost::string_ref magic;	// the start of the entry
+			uint32_t version, entryEncoding, entryBackend, pathLength;
+			uint64_t size, modifiedTime;
+			boost::string_ref path;	// the file the entry was made from
+			return
+				readBytes(sizeof(entryMagic), magic) && (memcmp(magic.data(), entryMagic, sizeof(entryMagic)) == 0) &&
+				read32(version) && (version == entryVersion) &&
+				read32(entryEncoding) && (entryEncoding == static_cast<uint32_t>(encoding)) &&
+				read32(entryBackend) && (entryBackend == static_cast<uint32_t>(backend)) &&
+				read64(size) && (size == stamp.size) &&
+				read64(modifiedTime) && (modifiedTime == static_cast<uint64_t>(stamp.modifiedTime)) &&
+				read32(pathLength) && readBytes(pathLength, path) && (path == stamp.absolutePath);
+		}
+
+		bool readStrings()
+		{
+			uint32_t count;	// the number of strings in the table
+			if (!read32(count) || (count > static_cast<size_t>(entryEnd - current) / sizeof(uint32_t)))
+			{
+				return false;
+			}
+			strings.resize(count);
+			keys.assign(count, nullptr);
+			for (auto& text: strings)
+			{
+				uint32_t length;	// the length of this string
+				if (!read32(length) || !readBytes(length, text))
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+
+		// Fills in obj from the next node, which must be the last one if isRoot is set
+		bool readNode(Object* obj, bool isRoot)
+		{
+			if (!readContents(obj))
+			{
+				return false;
+			}
+			return !isRoot || (current == entryEnd);
+		}
+
+		bool readChild(Object* parent)
+		{
+			if (current == entryEnd)
+			{
+				return false;
+			}
+			const char flags = *current;	// what kind of node this is
+			uint32_t keyIndex;
+			current++;
+			if (!read32(keyIndex) || (keyIndex >= strings.size()))
+			{
+				return false;
+			}
+			if (keys[keyIndex] == nullptr)
+			{
+				keys[keyIndex] = internKey(strings[keyIndex]);
+			}
+
+			Object* child = new Object(keys[keyIndex]);	// the object being read
+			parent->setValue(child);
+			return readBody(child, flags);
+		}
+
+	private:
+		bool readContents(Object* obj)
+		{
+			if (current == entryEnd)
+			{
+				return false;
+			}
+			const char flags = *current;	// what kind of node this is
+			uint32_t keyIndex;
+			current++;
+			return read32(keyIndex) && readBody(obj, flags);
+		}
+
+		bool readBody(Object* obj, char flags)
+		{
+			if (flags & LeafNode)
+			{
+				boost::string_ref value;	// the node's single value
+				if (!readString(value))
+				{
+					return false;
+				}
+				obj->setValue(string(value.data(), value.size()));
+				return true;
+			}
+
+			uint32_t tokenCount;	// the number of list items
+			if (!read32(tokenCount) || (tokenCount > static_cast<size_t>(entryEnd - current) / sizeof(uint32_t)))
+			{
+				return false;
+			}
+			if (tokenCount > 0)
+			{
+				vector<string> tokens(tokenCount);	// the list items
+				for (auto& token: tokens)
+				{
+					boost::string_ref text;	// this list item
+					if (!readString(text))
+					{
+						return false;
+					}
+					token.assign(text.data(), text.size());
+				}
+				obj->addToList(tokens.begin(), tokens.end());
+			}
+
+			uint32_t childCount;	// the number of sub-objects
+			if (!read32(childCount))
+			{
+				return false;
+			}
+			for (uint32_t i = 0; i < childCount; i++)
+			{
+				if (!readChild(obj))
+				{
+					return false;
+				}
+			}
+
+			obj->setObjList((flags & ObjectListNode) != 0);
+			return true;
+		}
+
+		bool readString(boost::string_ref& text)
+		{
+			uint32_t index;	// the string's entry in the table
+			if (!read32(index) || (index >= strings.size()))
+			{
+				return false;
+			}
+			text = strings[index];
+			return true;
+		}
+
+		bool read32(uint32_t& value)
+		{
+			if (static_cast<size_t>(entryEnd - current) < sizeof(value))
+			{
+				return false;
+			}
+			memcpy(&value, current, sizeof(value));
+			current += sizeof(value);
+			return true;
+		}
+
+		bool read64(uint64_t& value)
+		{
+			if (static_cast<size_t>(entryEnd - current) < sizeof(value))
+			{
+				return false;
+			}
+			memcpy(&value, current, sizeof(value));
+			current += sizeof(value);
+			return true;
+		}
+
+		bool readBytes(size_t length, boost::string_ref& bytes)
+		{
+			if (static_cast<size_t>(entryEnd - current) < length)
+			{
+				return false;
+			}
+			bytes = boost::string_ref(current, length);
+			current += length;
+			return true;
+		}
+
+		const char*						current;		// the next byte to decode
+		const char*						entryEnd;	// one past the last byte of the entry
+		vector<boost::string_ref>	strings;		// the string table, pointing into the entry
+		vector<const string*>		keys;			// the interned copies of the strings used as keys, made as they are needed
+};
+
+
+unique_ptr<ParsedFileCache> sharedCache;	// the cache ParadoxParsers use by default, if any
+
+}
+
+
+
+ParsedFileCache::ParsedFileCache(const string& _directory):
+	directory(_directory)
+{
+	Utils::TryCreateFolder(directory);
+}
+
+
+Object* ParsedFileCache::load(const Utils::FileStamp& stamp, ParserEncoding encoding, ParserBackend backend) const
+{
+	Utils::MappedFile entry(getEntryPath(stamp, encoding, backend));	// the cached tree
+	if (!entry.isOpen())
+	{
+		return nullptr;
+	}
+
+	EntryReader reader(entry.getData(), entry.getData() + entry.getSize());	// decodes the entry
+	if (!reader.readHeader(stamp, encoding, backend) || !reader.readStrings())
+	{
+		return nullptr;
+	}
+
+	Object* topLevel = new Object("topLevel");	// the object holding everything in the file
+	ObjectArena* arena = new ObjectArena();		// the storage for the tree
+	topLevel->setTopLevel();
+	topLevel->adoptArena(arena);
+	{
+		ActiveArenaScope arenaScope(arena);
+		if (reader.readNode(topLevel, true))
+		{
+			return topLevel;
+		}
+	}
+
+	LOG(LogLevel::Warning) << "Ignoring a damaged cache entry for " << stamp.absolutePath;
+	delete topLevel;
+	return nullptr;
+}
+
+
+void ParsedFileCache::store(const Utils::FileStamp& stamp, ParserEncoding encoding, ParserBackend backend, Object* tree) const
+{
+	EntryWriter writer;	// encodes the entry
+	writer.writeHeader(stamp, encoding, backend);
+	writer.writeNode(tree);
+
+	if (!Utils::WriteFileAtomically(getEntryPath(stamp, encoding, backend), writer.getContents()))
+	{
+		LOG(LogLevel::Debug) << "Could not cache the parsed contents of " << stamp.absolutePath;
+	}
+}
+
+
+void ParsedFileCache::setSharedDirectory(const string& directory)
+{
+	sharedCache.reset(new ParsedFileCache(directory));
+}
+
+
+const ParsedFileCache* ParsedFileCache::getShared()
+{
+	return sharedCache.get();
+}
+
+
+string ParsedFileCache::getEntryPath(const Utils::FileStamp& stamp, ParserEncoding encoding, ParserBackend backend) const
+{
+	// FNV-1a over everything that picks out the entry; the entry's header is checked on loading, so a collision only costs a re-parse
+	uint64_t hash = 14695981039346656037ull;	// the hash of the entry's identity
+	for (auto c: stamp.absolutePath)
+	{
+		hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ull;
+	}
+	hash = (hash ^ static_cast<uint64_t>(encoding)) * 1099511628211ull;
+	hash = (hash ^ static_cast<uint64_t>(backend)) * 1099511628211ull;
+
+	char name[17];	// the hash, in hex
+	snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(hash));
+	return directory + "/" + name + ".tree";
+}
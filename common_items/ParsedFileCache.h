@@ -0,0 +1,70 @@
+/*Copyright (c) 2016 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+
+#ifndef PARSED_FILE_CACHE_H_
+#define PARSED_FILE_CACHE_H_
+
+
+
+#include "Object.h"
+#include "OSCompatibilityLayer.h"
+#include "ParadoxParser.h"
+#include <string>
+using namespace std;
+
+
+
+// Keeps the parsed trees of files that do not change between runs, such as the game's own data and the
+// converter's mapping files, in a folder on disk. Each entry is a compact binary copy of a tree with a
+// table of its distinct strings. An entry is only used while the file it came from still has the same
+// absolute path, size and modification time, so editing a file simply makes its entry stale.
+//
+// Entries are replaced in a single step, so several converters can share one cache folder.
+class ParsedFileCache
+{
+	public:
+		explicit ParsedFileCache(const string& _directory);
+
+		// Returns the tree cached for the file's current contents, or nullptr if there is none.
+		Object*	load(const Utils::FileStamp& stamp, ParserEncoding encoding, ParserBackend backend) const;
+
+		// Saves the tree for the file's current contents, replacing any older entry.
+		void		store(const Utils::FileStamp& stamp, ParserEncoding encoding, ParserBackend backend, Object* tree) const;
+
+		// The cache every ParadoxParser uses unless told otherwise. There is none until a folder is set.
+		static void							setSharedDirectory(const string& directory);
+		static const ParsedFileCache*	getShared();
+
+		// The folder holding the entries, for callers that keep caches of their own next to them
+		const string&	getDirectory() const	{ return directory; }
+
+	private:
+		string	getEntryPath(const Utils::FileStamp& stamp, ParserEncoding encoding, ParserBackend backend) const;
+
+		string	directory;	// the folder holding the entries
+};
+
+
+
+#endif // PARSED_FILE_CACHE_H_
@@ -0,0 +1,390 @@
+/*Copyright (c) 2016 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+
+#include "Profiler.h"
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <new>
+#include <sstream>
+
+#ifdef _WIN32
+#include <Windows.h>
+#include <Psapi.h>
+#pragma comment(lib, "psapi.lib")
+#else
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+
+
+#ifdef PROFILE_ALLOCATIONS
+
+namespace
+{
+	atomic<uint64_t> allocationCount(0);	// the number of allocations made through operator new
+	atomic<uint64_t> allocatedBytes(0);		// the bytes requested from operator new
+}
+
+
+void* operator new(size_t size)
+{
+	allocationCount.fetch_add(1, memory_order_relaxed);
+	allocatedBytes.fetch_add(size, memory_order_relaxed);
+	void* memory = malloc((size > 0) ? size : 1);
+	if (memory == nullptr)
+	{
+		throw bad_alloc();
+	}
+	return memory;
+}
+
+
+void* operator new[](size_t size)
+{
+	return operator new(size);
+}
+
+
+void operator delete(void* memory) noexcept
+{
+	free(memory);
+}
+
+
+void operator delete[](void* memory) noexcept
+{
+	free(memory);
+}
+
+#endif
+
+
+
+namespace
+{
+
+string escapeJSON(const string& text)
+{
+	string escaped;
+	for (auto character: text)
+	{
+		switch (character)
+		{
+			case '"':
+				escaped += "\\\"";
+				break;
+			case '\\':
+				escaped += "\\\\";
+				break;
+			case '\n':
+				escaped += "\\n";
+				break;
+			case '\t':
+				escaped += "\\t";
+				break;
+			default:
+				escaped += character;
+		}
+	}
+	return escaped;
+}
+
+
+string quoteCSV(const string& text)
+{
+	string quoted = "\"";
+	for (auto character: text)
+	{
+		if (character == '"')
+		{
+			quoted += '"';
+		}
+		quoted += character;
+	}
+	return quoted + "\"";
+}
+
+}
+
+
+
+Profiler& Profiler::getInstance()
+{
+	static Profiler profiler;
+	return profiler;
+}
+
+
+Profiler::Profiler():
+	startTime(chrono::steady_clock::now()),
+	phases(),
+	openPhases(),
+	phaseMutex()
+{
+}
+
+
+bool Profiler::writeReport(const string& converterName, const string& baseName) const
+{
+	const double seconds	= getSecondsSinceStart();	// how long the run has taken
+	const MemoryUsage memory = getMemoryUsage();		// the memory in use at the end of the run
+
+	lock_guard<mutex> lock(phaseMutex);
+	vector<Phase> finishedPhases = phases;	// the phases, with any still running treated as finishing now
+	vector<string> paths;						// the name of each phase, qualified by the phases it is part of
+	for (auto& phase: finishedPhases)
+	{
+		if (phase.seconds < 0.0)
+		{
+			phase.seconds				= seconds - phase.startSeconds;
+			phase.memoryBytes			= memory.current;
+			phase.peakMemoryBytes	= memory.peak;
+			phase.allocations			= getAllocationCount() - phase.allocations;
+			phase.allocatedBytes		= getAllocatedBytes() - phase.allocatedBytes;
+		}
+		paths.push_back((phase.parent < 0) ? phase.name : (paths[phase.parent] + "/" + phase.name));
+	}
+
+	ofstream json(baseName + ".json");
+	if (!json.is_open())
+	{
+		return false;
+	}
+	json << fixed << setprecision(3);
+	json << "{\n";
+	json << "\t\"converter\": \"" << escapeJSON(converterName) << "\",\n";
+	json << "\t\"seconds\": " << seconds << ",\n";
+	json << "\t\"memoryBytes\": " << memory.current << ",\n";
+	json << "\t\"peakMemoryBytes\": " << memory.peak << ",\n";
+	if (countsAllocations())
+	{
+		json << "\t\"allocations\": " << getAllocationCount() << ",\n";
+		json << "\t\"allocatedBytes\": " << getAllocatedBytes() << ",\n";
+	}
+	json << "\t\"phases\": [";
+	for (size_t i = 0; i < finishedPhases.size(); i++)
+	{
+		const Phase& phase = finishedPhases[i];
+		json << ((i == 0) ? "\n" : ",\n");
+		json << "\t\t{ \"name\": \"" << escapeJSON(phase.name) << "\", \"path\": \"" << escapeJSON(paths[i]) << "\"";
+		json << ", \"parent\": " << phase.parent << ", \"depth\": " << phase.depth;
+		json << ", \"start\": " << phase.startSeconds << ", \"seconds\": " << phase.seconds;
+		json << ", \"memoryBytes\": " << phase.memoryBytes << ", \"peakMemoryBytes\": " << phase.peakMemoryBytes;
+		if (countsAllocations())
+		{
+			json << ", \"allocations\": " << phase.allocations << ", \"allocatedBytes\": " << phase.allocatedBytes;
+		}
+		json << " }";
+	}
+	json << "\n\t]\n";
+	json << "}\n";
+	json.close();
+
+	ofstream csv(baseName + ".csv");
+	if (!csv.is_open())
+	{
+		return false;
+	}
+	csv << fixed << setprecision(3);
+	csv << "phase,depth,start_seconds,seconds,memory_bytes,peak_memory_bytes,allocations,allocated_bytes\n";
+
+	// the first row covers the whole run, at depth -1 so that it is not mistaken for a phase
+	csv << quoteCSV(converterName) << ",-1,0.000," << seconds << ',' << memory.current << ',' << memory.peak << ',';
+	if (countsAllocations())
+	{
+		csv << getAllocationCount() << ',' << getAllocatedBytes();
+	}
+	else
+	{
+		csv << ',';
+	}
+	csv << '\n';
+	for (size_t i = 0; i < finishedPhases.size(); i++)
+	{
+		const Phase& phase = finishedPhases[i];
+		csv << quoteCSV(paths[i]) << ',' << phase.depth << ',' << phase.startSeconds << ',' << phase.seconds << ',';
+		csv << phase.memoryBytes << ',' << phase.peakMemoryBytes << ',';
+		if (countsAllocations())
+		{
+			csv << phase.allocations << ',' << phase.allocatedBytes;
+		}
+		else
+		{
+			csv << ',';
+		}
+		csv << '\n';
+	}
+	csv.close();
+
+	return true;
+}
+
+
+size_t Profiler::beginPhase(const string& name)
+{
+	Phase phase;
+	phase.name					= name;
+	phase.startSeconds		= getSecondsSinceStart();
+	phase.seconds				= -1.0;
+	phase.memoryBytes			= 0;
+	phase.peakMemoryBytes	= 0;
+	phase.allocations			= getAllocationCount();	// the counts at the start, until the phase ends
+	phase.allocatedBytes		= getAllocatedBytes();
+
+	lock_guard<mutex> lock(phaseMutex);
+	phase.parent	= openPhases.empty() ? -1 : static_cast<int>(openPhases.back());
+	phase.depth		= static_cast<int>(openPhases.size());
+	phases.push_back(phase);
+	openPhases.push_back(phases.size() - 1);
+	return phases.size() - 1;
+}
+
+
+void Profiler::endPhase(size_t index)
+{
+	const double now				= getSecondsSinceStart();
+	const MemoryUsage memory	= getMemoryUsage();
+
+	lock_guard<mutex> lock(phaseMutex);
+	Phase& phase = phases[index];
+	phase.seconds				= now - phase.startSeconds;
+	phase.memoryBytes			= memory.current;
+	phase.peakMemoryBytes	= memory.peak;
+	phase.allocations			= getAllocationCount() - phase.allocations;
+	phase.allocatedBytes		= getAllocatedBytes() - phase.allocatedBytes;
+
+	// phases end in the reverse of the order they started, but tolerate one being ended out of turn
+	for (size_t i = openPhases.size(); i-- > 0;)
+	{
+		if (openPhases[i] == index)
+		{
+			openPhases.erase(openPhases.begin() + i);
+			break;
+		}
+	}
+}
+
+
+double Profiler::getSecondsSinceStart() const
+{
+	return chrono::duration<double>(chrono::steady_clock::now() - startTime).count();
+}
+
+
+Profiler::MemoryUsage Profiler::getMemoryUsage()
+{
+	MemoryUsage usage = { 0, 0 };
+#ifdef _WIN32
+	PROCESS_MEMORY_COUNTERS counters;
+	if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+	{
+		usage.current	= counters.WorkingSetSize;
+		usage.peak		= counters.PeakWorkingSetSize;
+	}
+#else
+	ifstream statm("/proc/self/statm");
+	uint64_t totalPages, residentPages;
+	if (statm >> totalPages >> residentPages)
+	{
+		usage.current = residentPages * sysconf(_SC_PAGESIZE);
+	}
+	rusage resourceUsage;
+	if (getrusage(RUSAGE_SELF, &resourceUsage) == 0)
+	{
+		usage.peak = static_cast<uint64_t>(resourceUsage.ru_maxrss) * 1024;	// reported in kilobytes
+	}
+
+	// the kernel only updates the peak now and then, so it can trail the current usage
+	if (usage.peak < usage.current)
+	{
+		usage.peak = usage.current;
+	}
+#endif
+	return usage;
+}
+
+
+bool Profiler::countsAllocations()
+{
+#ifdef PROFILE_ALLOCATIONS
+	return true;
+#else
+	return false;
+#endif
+}
+
+
+uint64_t Profiler::getAllocationCount()
+{
+#ifdef PROFILE_ALLOCATIONS
+	return allocationCount.load(memory_order_relaxed);
+#else
+	return 0;
+#endif
+}
+
+
+uint64_t Profiler::getAllocatedBytes()
+{
+#ifdef PROFILE_ALLOCATIONS
+	return allocatedBytes.load(memory_order_relaxed);
+#else
+	return 0;
+#endif
+}
+
+
+
+ProfilePhase::ProfilePhase(const string& name):
+	phase(Profiler::getInstance().beginPhase(name)),
+	running(true)
+{
+}
+
+
+ProfilePhase::~ProfilePhase()
+{
+	end();
+}
+
+
+void ProfilePhase::end()
+{
+	if (running)
+	{
+		Profiler::getInstance().endPhase(phase);
+		running = false;
+	}
+}
+
+
+void ProfilePhase::next(const string& name)
+{
+	end();
+	phase		= Profiler::getInstance().beginPhase(name);
+	running	= true;
+}
@@ -0,0 +1,121 @@
+/*Copyright (c) 2016 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+
+#ifndef PROFILER_H_
+#define PROFILER_H_
+
+
+
+#include <chrono>
+#include <mutex>
+#include <stdint.h>
+#include <string>
+#include <vector>
+using namespace std;
+
+
+
+// Records how long each phase of a conversion takes and how much memory it uses, and writes the results out
+// as JSON and CSV so that runs can be compared across saves and converter versions. Phases are timed with
+// ProfilePhase. Like ZipArchive, this depends on nothing else in common_items, so every converter can use it.
+//
+// Allocations are only counted in builds that define PROFILE_ALLOCATIONS, which replaces the global operator
+// new with a counting one. Configure the CMake build with -DCONVERTERS_PROFILE_ALLOCATIONS=ON to define it; in
+// Visual Studio, add it to the preprocessor definitions of the converter's project.
+class Profiler
+{
+	public:
+		static Profiler& getInstance();
+
+		// Writes every phase recorded so far to <baseName>.json and <baseName>.csv. Returns false if either
+		// file could not be written.
+		bool writeReport(const string& converterName, const string& baseName = "profile") const;
+
+	private:
+		friend class ProfilePhase;
+
+		struct MemoryUsage
+		{
+			uint64_t current;	// the memory the converter is using now, in bytes
+			uint64_t peak;		// the most memory the converter has used so far, in bytes
+		};
+
+		struct Phase
+		{
+			string	name;						// what the phase does
+			int		parent;					// the index of the phase this one is part of, or -1
+			int		depth;					// how many phases this one is nested within
+			double	startSeconds;			// when the phase started, measured from the start of the run
+			double	seconds;					// how long the phase took
+			uint64_t	memoryBytes;			// the memory in use when the phase finished
+			uint64_t	peakMemoryBytes;		// the most memory used by the end of the phase
+			uint64_t	allocations;			// the allocations made during the phase
+			uint64_t	allocatedBytes;		// the bytes allocated during the phase
+		};
+
+		Profiler();
+		Profiler(const Profiler&);
+		Profiler& operator=(const Profiler&);
+
+		size_t	beginPhase(const string& name);
+		void		endPhase(size_t phase);
+		double	getSecondsSinceStart() const;
+
+		static MemoryUsage	getMemoryUsage();
+		static bool				countsAllocations();
+		static uint64_t		getAllocationCount();
+		static uint64_t		getAllocatedBytes();
+
+		chrono::steady_clock::time_point	startTime;		// when the run started
+		vector<Phase>							phases;			// every phase, in the order they started
+		vector<size_t>							openPhases;		// the phases that have started but not finished, innermost last
+		mutable mutex							phaseMutex;		// guards phases and openPhases
+};
+
+
+// Times a phase of a conversion, from construction until end() is called or it goes out of scope. Phases
+// started while another is running are recorded as part of it. Phases are meant to be used from the main
+// conversion thread; work it spreads over other threads is counted in the phase that waits for it.
+class ProfilePhase
+{
+	public:
+		explicit ProfilePhase(const string& name);
+		~ProfilePhase();
+
+		void end();
+
+		// Ends this phase and starts the one that follows it
+		void next(const string& name);
+
+	private:
+		ProfilePhase(const ProfilePhase&);
+		ProfilePhase& operator=(const ProfilePhase&);
+
+		size_t	phase;		// the phase's index in the profiler
+		bool		running;		// whether or not the phase has yet to end
+};
+
+
+
+#endif // PROFILER_H_
@@ -0,0 +1,94 @@
+/*Copyright (c) 2016 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+
+#ifndef SYMBOL_H_
+#define SYMBOL_H_
+
+
+
+#include <functional>
+#include <ostream>
+#include <string>
+#include <boost/utility/string_ref.hpp>
+#include "ObjectArena.h"
+using namespace std;
+
+
+
+// An interned identifier - a culture, religion, pop type or the like. Every Symbol with the same text points at
+// the single shared copy handed out by internKey, so copying a Symbol never allocates and comparing or hashing two
+// Symbols looks only at the pointers. Converters hold millions of pops and demographics that repeat a few hundred
+// of these names, which is why the pop, province and mapper types keep Symbols rather than strings.
+//
+// Named Symbols a function compares against should be function-local statics, so they are interned once and never
+// before the interning tables themselves are constructed.
+class Symbol
+{
+	public:
+		Symbol(): text(emptyText()) {}
+		explicit Symbol(boost::string_ref _text): text(internKey(_text)) {}
+
+		const string&	str() const		{ return *text; }
+		const char*		c_str() const	{ return text->c_str(); }
+		bool				empty() const	{ return text->empty(); }
+
+		bool operator==(const Symbol& rhs) const	{ return text == rhs.text; }
+		bool operator!=(const Symbol& rhs) const	{ return text != rhs.text; }
+
+		// ordered by text, so maps keyed by Symbol iterate (and write their output) in the same order as maps keyed by string
+		bool operator<(const Symbol& rhs) const	{ return (text != rhs.text) && (*text < *rhs.text); }
+
+		size_t hash() const	{ return std::hash<const string*>()(text); }
+
+	private:
+		static const string* emptyText()
+		{
+			static const string* empty = internKey("");
+			return empty;
+		}
+
+		const string* text;	// the shared copy of this symbol's text
+};
+
+
+inline ostream& operator<<(ostream& out, const Symbol& symbol)
+{
+	return out << symbol.str();
+}
+
+
+namespace std
+{
+	template<> struct hash<Symbol>
+	{
+		size_t operator()(const Symbol& symbol) const
+		{
+			return symbol.hash();
+		}
+	};
+}
+
+
+
+#endif // SYMBOL_H_
@@ -0,0 +1,92 @@
+/*Copyright (c) 2016 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+// Checks the TagRegistry, whose lookups run without a lock while other threads may be registering tags
+
+
+
+#define BOOST_TEST_MODULE IdRegistryTests
+#include <boost/test/included/unit_test.hpp>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+#include "IdRegistry.h"
+using namespace std;
+
+
+
+BOOST_AUTO_TEST_CASE(tagsAndIdsRoundTrip)
+{
+	const TagId id = TagRegistry::getId("ENG");
+	BOOST_CHECK_EQUAL(TagRegistry::getId("ENG"), id);
+	BOOST_CHECK_EQUAL(TagRegistry::findId("ENG"), id);
+	BOOST_CHECK_EQUAL(TagRegistry::getTag(id), "ENG");
+	BOOST_CHECK_EQUAL(TagRegistry::findId("never registered"), TagRegistry::invalidId);
+	BOOST_CHECK_EQUAL(TagRegistry::getTag(TagRegistry::invalidId), "");
+}
+
+
+BOOST_AUTO_TEST_CASE(concurrentRegistrationsAndLookupsAgree)
+{
+	// enough tags to replace the index several times while the threads are using it
+	const int tagsPerThread = 2000;
+	vector<vector<TagId>> ids(4, vector<TagId>(tagsPerThread, TagRegistry::invalidId));
+	vector<int> failedLookups(ids.size(), 0);	// Boost.Test checks can't be made from other threads, so they count here
+	vector<thread> threads;
+	for (unsigned int i = 0; i < ids.size(); i++)
+	{
+		threads.push_back(thread([&ids, &failedLookups, i]()
+		{
+			for (int tag = 0; tag < tagsPerThread; tag++)
+			{
+				// every thread registers the same tags, so they race to register each one
+				ids[i][tag] = TagRegistry::getId("T" + to_string(tag));
+				if (TagRegistry::findId("T" + to_string(tag)) != ids[i][tag])
+				{
+					failedLookups[i]++;
+				}
+			}
+		}));
+	}
+	for (auto& registeringThread: threads)
+	{
+		registeringThread.join();
+	}
+
+	for (auto failures: failedLookups)
+	{
+		BOOST_CHECK_EQUAL(failures, 0);
+	}
+	set<TagId> distinctIds;
+	for (int tag = 0; tag < tagsPerThread; tag++)
+	{
+		for (unsigned int i = 1; i < ids.size(); i++)
+		{
+			BOOST_CHECK_EQUAL(ids[i][tag], ids[0][tag]);
+		}
+		BOOST_CHECK_EQUAL(TagRegistry::getTag(ids[0][tag]), "T" + to_string(tag));
+		distinctIds.insert(ids[0][tag]);
+	}
+	BOOST_CHECK_EQUAL(distinctIds.size(), static_cast<size_t>(tagsPerThread));
+}
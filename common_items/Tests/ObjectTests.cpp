@@ -0,0 +1,149 @@
+/*Copyright (c) 2016 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+
+
+// Checks Object's keyed lookups, which use a sorted index of the children once an object is large enough, how
+// Objects are written back out, and the arena parsed Objects are allocated from
+
+
+
+#define BOOST_TEST_MODULE ObjectTests
+#include <boost/test/included/unit_test.hpp>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Object.h"
+#include "ObjectArena.h"
+using namespace std;
+
+
+
+unique_ptr<Object> makeLargeObject(int keys, int copies)
+{
+	unique_ptr<Object> object(new Object("large"));
+	for (int copy = 0; copy < copies; copy++)
+	{
+		for (int key = 0; key < keys; key++)
+		{
+			object->setLeaf("key" + to_string(key), to_string(copy));
+		}
+	}
+	return object;
+}
+
+
+BOOST_AUTO_TEST_CASE(lookupsKeepFileOrder)
+{
+	unique_ptr<Object> object = makeLargeObject(20, 3);
+	vector<Object*> matches = object->getValue("key7");
+	BOOST_REQUIRE_EQUAL(matches.size(), 3u);
+	for (unsigned int i = 0; i < matches.size(); i++)
+	{
+		BOOST_CHECK_EQUAL(matches[i]->getLeaf(), to_string(i));
+	}
+	BOOST_CHECK(object->getFirst("missing") == nullptr);
+}
+
+
+BOOST_AUTO_TEST_CASE(indexIsRebuiltAfterChanges)
+{
+	unique_ptr<Object> object = makeLargeObject(20, 1);
+	BOOST_CHECK_EQUAL(object->getValue("key3").size(), 1u);
+	object->setLeaf("key3", "1");
+	BOOST_CHECK_EQUAL(object->getValue("key3").size(), 2u);
+	object->removeObject(object->getFirst("key3"));
+	BOOST_REQUIRE_EQUAL(object->getValue("key3").size(), 1u);
+	BOOST_CHECK_EQUAL(object->getLeaf("key3"), "1");
+}
+
+
+BOOST_AUTO_TEST_CASE(concurrentLookupsAgree)
+{
+	// every thread's first lookup may build the index, so they race to publish it
+	for (int round = 0; round < 50; round++)
+	{
+		unique_ptr<Object> object = makeLargeObject(64, 2);
+		vector<int> found(8, 0);
+		vector<thread> threads;
+		for (unsigned int i = 0; i < found.size(); i++)
+		{
+			threads.push_back(thread([&object, &found, i]()
+			{
+				for (int key = 0; key < 64; key++)
+				{
+					found[i] += static_cast<int>(object->getValue("key" + to_string(key)).size());
+				}
+			}));
+		}
+		for (auto& lookupThread: threads)
+		{
+			lookupThread.join();
+		}
+		for (auto count: found)
+		{
+			BOOST_CHECK_EQUAL(count, 128);
+		}
+	}
+}
+
+
+BOOST_AUTO_TEST_CASE(onlyTheTopLevelIsWrittenWithoutBraces)
+{
+	// a tree parsed while another arena is active has its top level in that arena too
+	ObjectArena arena;
+	ActiveArenaScope arenaScope(&arena);
+	Object* topLevel = new Object("topLevel");
+	topLevel->setTopLevel();
+	Object* block = new Object("block");
+	block->setLeaf("value", "1");
+	topLevel->setValue(block);
+	topLevel->setLeaf("leaf", "2");
+
+	BOOST_CHECK_EQUAL(topLevel->toString(), "block=\n{\n\tvalue=1\n}\nleaf=2\n");
+	BOOST_CHECK_EQUAL(block->toString(), "block=\n{\n\tvalue=1\n}\n");
+	delete topLevel;
+}
+
+
+BOOST_AUTO_TEST_CASE(arenaAllocationsStayApartAsBlocksGrow)
+{
+	// small allocations fill blocks of growing sizes, and one bigger than any block gets its own
+	ObjectArena arena;
+	vector<char*> allocations;
+	for (int i = 0; i < 20000; i++)
+	{
+		const size_t size = ((i % 1000) == 999) ? 2 * 1024 * 1024 : 112;
+		char* allocation = static_cast<char*>(arena.allocate(size));
+		BOOST_REQUIRE_EQUAL(reinterpret_cast<uintptr_t>(allocation) % sizeof(void*), 0u);
+		memset(allocation, i & 0xFF, size);
+		allocations.push_back(allocation);
+	}
+	for (size_t i = 0; i < allocations.size(); i++)
+	{
+		BOOST_CHECK_EQUAL(static_cast<unsigned char>(allocations[i][0]), i & 0xFF);
+	}
+}
@@ -0,0 +1,350 @@
+/*Copyright (c) 2016 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+
+
+// Checks that ParadoxTokenParser and ParadoxEventReader read Paradox script the way the converters expect,
+// including the malformed input that turns up in saves and mods.
+
+
+
+#define BOOST_TEST_MODULE ParadoxTokenizerTests
+#include <boost/test/included/unit_test.hpp>
+#include <fstream>
+#include <memory>
+#include <string>
+#include "BinaryTokenTable.h"
+#include "Log.h"
+#include "Object.h"
+#include "ParadoxEventReader.h"
+#include "ParadoxTokenizer.h"
+using namespace std;
+
+
+
+struct QuietLog
+{
+	QuietLog()	{ Log::setLevel(LogLevel::Error); }
+};
+BOOST_GLOBAL_FIXTURE(QuietLog);
+
+
+struct ParseResult
+{
+	unique_ptr<Object>	topLevel;	// everything that was parsed
+	bool						succeeded;	// whether or not the input was well formed
+};
+
+
+ParseResult parse(const string& text)
+{
+	ParseResult result;
+	result.topLevel.reset(new Object("topLevel"));
+	ParadoxTokenParser parser(text.data(), text.data() + text.size(), false);
+	result.succeeded = parser.parse(result.topLevel.get());
+	return result;
+}
+
+
+// Records the events a ParadoxEventReader reports as text, such as 'a:1 b:{ c:[x y] }'
+class RecordingHandler: public ParadoxEventHandler
+{
+	public:
+		KeyAction onKey(boost::string_ref key) override	{ events += string(key) + ":"; return KeyAction::Read; }
+		void onScalar(boost::string_ref value) override	{ events += string(value) + " "; }
+		void onBeginObject() override							{ events += "{ "; }
+		void onEndObject() override							{ events += "} "; }
+		void onList(const vector<boost::string_ref>& items) override
+		{
+			events += "[";
+			for (auto item: items)
+			{
+				events += " " + string(item);
+			}
+			events += " ] ";
+		}
+
+		string events;	// what has been reported so far
+};
+
+
+bool readEvents(const string& text, string& events)
+{
+	RecordingHandler handler;
+	ParadoxEventReader reader(text.data(), text.data() + text.size(), false);
+	bool succeeded = reader.read(handler);
+	events = handler.events;
+	return succeeded;
+}
+
+
+
+BOOST_AUTO_TEST_CASE(quotedStringsKeepTheirContents)
+{
+	ParseResult result = parse("name = \"New York\"\nadjective = \"{A = B}\"\n\"quoted key\" = yes\nempty = \"\"");
+	BOOST_CHECK(result.succeeded);
+	BOOST_CHECK_EQUAL(result.topLevel->getLeaf("name"), "New York");
+	BOOST_CHECK_EQUAL(result.topLevel->getLeaf("adjective"), "{A = B}");
+	BOOST_CHECK_EQUAL(result.topLevel->getLeaf("quoted key"), "yes");
+	BOOST_REQUIRE_EQUAL(result.topLevel->getValue("empty").size(), 1u);
+	BOOST_CHECK_EQUAL(result.topLevel->getLeaf("empty"), "");
+}
+
+
+BOOST_AUTO_TEST_CASE(commentsAreSkipped)
+{
+	ParseResult result = parse("# a comment = { \na = 1 # another }\nb = \"#not a comment\"");
+	BOOST_CHECK(result.succeeded);
+	BOOST_CHECK_EQUAL(result.topLevel->getLeaf("a"), "1");
+	BOOST_CHECK_EQUAL(result.topLevel->getLeaf("b"), "#not a comment");
+}
+
+
+BOOST_AUTO_TEST_CASE(missingValuesAreSkipped)
+{
+	ParseResult result = parse("block = { a = }\nb = 2\nc =");
+	BOOST_CHECK(!result.succeeded);
+	Object* block = result.topLevel->getFirst("block");
+	BOOST_REQUIRE(block != nullptr);
+	BOOST_REQUIRE_EQUAL(block->getValue("a").size(), 1u);
+	BOOST_CHECK_EQUAL(block->getLeaf("a"), "");
+	BOOST_CHECK_EQUAL(result.topLevel->getLeaf("b"), "2");
+	BOOST_CHECK_EQUAL(result.topLevel->getValue("c").size(), 1u);
+
+	// with no value before the next key, that key is taken as the value
+	ParseResult nextKey = parse("a = \nb = 2");
+	BOOST_CHECK_EQUAL(nextKey.topLevel->getLeaf("a"), "b");
+	BOOST_CHECK_EQUAL(nextKey.topLevel->getLeaf("epsilon"), "2");
+}
+
+
+BOOST_AUTO_TEST_CASE(missingKeysBecomeEpsilon)
+{
+	ParseResult result = parse("= 1\na = 2");
+	BOOST_CHECK_EQUAL(result.topLevel->getLeaf("epsilon"), "1");
+	BOOST_CHECK_EQUAL(result.topLevel->getLeaf("a"), "2");
+}
+
+
+BOOST_AUTO_TEST_CASE(strayBracesAreSkipped)
+{
+	ParseResult empty = parse("{ }\na = 1");
+	BOOST_CHECK(empty.succeeded);
+	BOOST_CHECK_EQUAL(empty.topLevel->getLeaf("a"), "1");
+
+	ParseResult block = parse("a = 1\n{ junk = { 2 } }\nb = 3\n}\nc = 4");
+	BOOST_CHECK(!block.succeeded);
+	BOOST_CHECK_EQUAL(block.topLevel->getLeaf("a"), "1");
+	BOOST_CHECK(block.topLevel->getValue("junk").empty());
+	BOOST_CHECK_EQUAL(block.topLevel->getLeaf("b"), "3");
+	BOOST_CHECK_EQUAL(block.topLevel->getLeaf("c"), "4");
+}
+
+
+BOOST_AUTO_TEST_CASE(unclosedBlocksKeepTheirContents)
+{
+	ParseResult result = parse("a = { b = 1");
+	BOOST_CHECK(!result.succeeded);
+	BOOST_REQUIRE(result.topLevel->getFirst("a") != nullptr);
+	BOOST_CHECK_EQUAL(result.topLevel->getFirst("a")->getLeaf("b"), "1");
+}
+
+
+BOOST_AUTO_TEST_CASE(tagListsBecomeTokens)
+{
+	ParseResult result = parse("add_core = { ENG \"FRA\" 3 }\nempty = { }");
+	BOOST_CHECK(result.succeeded);
+	const vector<string> expected = { "ENG", "FRA", "3" };
+	const vector<string>& tokens = result.topLevel->getFirst("add_core")->getTokens();
+	BOOST_CHECK_EQUAL_COLLECTIONS(tokens.begin(), tokens.end(), expected.begin(), expected.end());
+	BOOST_CHECK(result.topLevel->getFirst("empty")->getLeaves().empty());
+}
+
+
+BOOST_AUTO_TEST_CASE(objectListItemsHoldTheirOwnContents)
+{
+	ParseResult result = parse("history = { { a = 1 } { b = 2 c = { 3 4 } } { } }");
+	BOOST_CHECK(result.succeeded);
+	Object* history = result.topLevel->getFirst("history");
+	BOOST_REQUIRE(history != nullptr);
+	const vector<Object*>& items = history->getLeaves();
+	BOOST_REQUIRE_EQUAL(items.size(), 3u);
+	for (auto item: items)
+	{
+		BOOST_CHECK_EQUAL(item->getKey(), "objlist");
+		BOOST_CHECK(item->isObjectList());
+	}
+	BOOST_CHECK_EQUAL(items[0]->getLeaf("a"), "1");
+	BOOST_CHECK(items[0]->getValue("b").empty());
+	BOOST_CHECK_EQUAL(items[1]->getLeaf("b"), "2");
+	BOOST_CHECK_EQUAL(items[1]->getFirst("c")->getTokens().size(), 2u);
+	BOOST_CHECK(items[2]->getLeaves().empty());
+}
+
+
+BOOST_AUTO_TEST_CASE(saveHeadersAreSkipped)
+{
+	for (auto header: { "EU4txt", "CK2txt", "HOI4txt" })
+	{
+		ParseResult result = parse(string(header) + "\ndate = \"1444.11.11\"");
+		BOOST_CHECK_MESSAGE(result.succeeded, header);
+		BOOST_CHECK_EQUAL(result.topLevel->getLeaf("date"), "1444.11.11");
+
+		string events;
+		BOOST_CHECK_MESSAGE(readEvents(string(header) + "\ndate = \"1444.11.11\"", events), header);
+		BOOST_CHECK_EQUAL(events, "date:1444.11.11 ");
+	}
+
+	BOOST_CHECK(!parse("notaheader\na = 1").succeeded);
+	BOOST_CHECK(!parse("\"EU4txt\"\na = 1").succeeded);
+	BOOST_CHECK(!parse("a = { EU4txt = 1 b }").succeeded);
+}
+
+
+BOOST_AUTO_TEST_CASE(eventsMatchTheTree)
+{
+	string events;
+	BOOST_CHECK(readEvents("a = 1 b = { c = { x y } d = { } } e = { { f = 2 } }", events));
+	BOOST_CHECK_EQUAL(events, "a:1 b:{ c:[ x y ] d:{ } } e:{ { f:2 } } ");
+
+	BOOST_CHECK(!readEvents("a = { b = } c = 1", events));
+	BOOST_CHECK_EQUAL(events, "a:{ b:} c:1 ");
+}
+
+
+// Holds on to each key until its value has been read, as a handler building its own structures would
+class KeyKeepingHandler: public ParadoxEventHandler
+{
+	public:
+		KeyAction onKey(boost::string_ref key) override	{ lastKey = key; return KeyAction::Read; }
+		void onList(const vector<boost::string_ref>& items) override
+		{
+			events += string(lastKey) + ":" + to_string(items.size()) + " ";
+		}
+
+		boost::string_ref	lastKey;	// the key of the value being read
+		string				events;	// each list's key and length
+};
+
+
+BOOST_AUTO_TEST_CASE(binaryKeysOutliveTheirValues)
+{
+	// an unknown key is written out as its id in the tokenizer's number buffers, which a list of more numbers
+	// than there are buffers would overwrite
+	string binary;
+	auto addId = [&binary](uint16_t id)
+	{
+		binary.append(reinterpret_cast<const char*>(&id), sizeof(id));
+	};
+	addId(0x2000);
+	addId(0x0001);
+	addId(0x0003);
+	for (int32_t value = 1; value <= 6; value++)
+	{
+		addId(0x000C);
+		binary.append(reinterpret_cast<const char*>(&value), sizeof(value));
+	}
+	addId(0x0004);
+
+	BinaryTokenTable tokens;
+	KeyKeepingHandler handler;
+	ParadoxEventReader reader(binary.data(), binary.data() + binary.size(), false);
+	reader.setBinaryTokens(&tokens);
+	BOOST_CHECK(reader.read(handler));
+	BOOST_CHECK_EQUAL(handler.events, "0x2000:6 ");
+}
+
+
+BOOST_AUTO_TEST_CASE(binaryDatesAreWrittenAsDates)
+{
+	string binary;
+	auto addId = [&binary](uint16_t id)
+	{
+		binary.append(reinterpret_cast<const char*>(&id), sizeof(id));
+	};
+	auto addInteger = [&binary, &addId](int32_t value)
+	{
+		addId(0x000C);
+		binary.append(reinterpret_cast<const char*>(&value), sizeof(value));
+	};
+	auto addAssignment = [&addId](uint16_t key)
+	{
+		addId(key);
+		addId(0x0001);
+	};
+
+	const int32_t startDate = (6444 * 365 + 314) * 24;	// 1444.11.11, in hours since the start of 5000 BC
+	addAssignment(0x2000);
+	addInteger(startDate);
+	addAssignment(0x2000);
+	addInteger(-1);			// the last hour before the calendar starts
+	addAssignment(0x2001);	// a list of dates
+	addId(0x0003);
+	addInteger(startDate);
+	addInteger(5001 * 365 * 24);
+	addId(0x0004);
+	addAssignment(0x2001);	// a date key holding a block rather than a list of dates
+	addId(0x0003);
+	addAssignment(0x2002);
+	addInteger(6);
+	addId(0x0004);
+	addAssignment(0x2001);	// and one whose keys are numbers
+	addId(0x0003);
+	addInteger(5);
+	addId(0x0001);
+	addInteger(6);
+	addId(0x0004);
+	addAssignment(0x2002);
+	addInteger(7);
+
+	ofstream("dateTokens.txt") << "0x2000 date date\n0x2001 dates date\n0x2002 count\n";
+	BinaryTokenTable tokens;
+	BOOST_REQUIRE(tokens.load("dateTokens.txt"));
+
+	RecordingHandler handler;
+	ParadoxEventReader reader(binary.data(), binary.data() + binary.size(), false);
+	reader.setBinaryTokens(&tokens);
+	BOOST_CHECK(reader.read(handler));
+	BOOST_CHECK_EQUAL(handler.events, "date:1444.11.11 date:-5001.12.31 dates:[ 1444.11.11 1.1.1 ] dates:{ count:6 } dates:{ 5:6 } count:7 ");
+}
+
+
+BOOST_AUTO_TEST_CASE(lineNumbersFollowTheTokenizer)
+{
+	const string text = "a\nb\n\n# comment\nc";
+	ParadoxTokenizer tokenizer(text.data(), text.data() + text.size());
+	BOOST_CHECK_EQUAL(tokenizer.getLineNumber(), 1);
+	tokenizer.next();
+	BOOST_CHECK_EQUAL(tokenizer.getLineNumber(), 1);
+	tokenizer.next();
+	BOOST_CHECK_EQUAL(tokenizer.getLineNumber(), 2);
+	BOOST_CHECK_EQUAL(tokenizer.getLineNumber(), 2);
+	tokenizer.next();
+	BOOST_CHECK_EQUAL(tokenizer.getLineNumber(), 5);
+
+	// a piece of a file counts its lines from the start of the file
+	const char* piece = text.data() + text.find('b');
+	ParadoxTokenizer pieceTokenizer(piece, text.data() + text.size(), text.data());
+	pieceTokenizer.next();
+	BOOST_CHECK_EQUAL(pieceTokenizer.getLineNumber(), 2);
+}
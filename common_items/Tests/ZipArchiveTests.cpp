@@ -0,0 +1,261 @@
+/*Copyright (c) 2016 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+// Checks that the zip reader decompresses each kind of deflate block, reads back what the writer builds, and
+// refuses archives that are cut short, don't match their CRC, or point outside themselves
+
+
+
+#define BOOST_TEST_MODULE ZipArchiveTests
+#include <boost/test/included/unit_test.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "ZipArchive.h"
+using namespace std;
+
+
+
+namespace
+{
+
+const uint16_t storedMethod	= 0;
+const uint16_t deflatedMethod	= 8;
+
+// "Hello, Hello, Hello, Hello!", and the same deflated in a stored block and in a fixed Huffman block
+const string hello = "Hello, Hello, Hello, Hello!";
+const uint32_t helloCrc = 0x97da9069;
+const unsigned char helloStoredBlock[] = {
+	0x01, 0x1b, 0x00, 0xe4, 0xff, 0x48, 0x65, 0x6c, 0x6c, 0x6f, 0x2c, 0x20, 0x48, 0x65, 0x6c, 0x6c,
+	0x6f, 0x2c, 0x20, 0x48, 0x65, 0x6c, 0x6c, 0x6f, 0x2c, 0x20, 0x48, 0x65, 0x6c, 0x6c, 0x6f, 0x21,
+};
+const unsigned char helloFixedBlock[] = {
+	0xf3, 0x48, 0xcd, 0xc9, 0xc9, 0xd7, 0x51, 0xf0, 0xc0, 0xa4, 0x14, 0x01,
+};
+
+// makeProvinces() deflated in a dynamic Huffman block
+const uint32_t provincesCrc = 0xd12e87ee;
+const unsigned char provincesDynamicBlock[] = {
+	0x7d, 0xd0, 0xb1, 0x0e, 0x82, 0x30, 0x18, 0x04, 0xe0, 0xdd, 0xa7, 0xe8, 0x23, 0x40, 0x0b, 0xa8,
+	0x43, 0x07, 0xa2, 0xd5, 0x8d, 0x92, 0x02, 0x33, 0xa9, 0xd2, 0x10, 0x17, 0x9a, 0x14, 0x12, 0x4d,
+	0x8c, 0xef, 0xee, 0x5f, 0xaa, 0x65, 0xfb, 0xb7, 0x5b, 0xbe, 0xe4, 0xee, 0x52, 0xfe, 0x26, 0xf6,
+	0x39, 0x19, 0xc7, 0x45, 0x75, 0x25, 0x77, 0xeb, 0xcc, 0x1a, 0x16, 0xa7, 0x07, 0xd3, 0x8f, 0xd6,
+	0x0e, 0x33, 0x1f, 0x9d, 0x7e, 0x4c, 0xe4, 0xa6, 0x67, 0xd3, 0x2f, 0xfa, 0xc5, 0x13, 0xf2, 0xd9,
+	0x1d, 0xa2, 0xba, 0xa8, 0x32, 0x28, 0xd5, 0x35, 0x98, 0x4a, 0x41, 0xa5, 0x79, 0x64, 0xcd, 0x49,
+	0x06, 0x76, 0x16, 0x15, 0xc6, 0x28, 0x30, 0x4a, 0x23, 0xab, 0x55, 0x17, 0x98, 0x0f, 0x08, 0x63,
+	0x9e, 0x1d, 0x23, 0x2b, 0xa1, 0xdb, 0xca, 0x2a, 0xd1, 0x62, 0x2c, 0x03, 0xc6, 0x8a, 0xc8, 0xd4,
+	0x9f, 0xf9, 0x91, 0x08, 0xcb, 0x81, 0x65, 0x6c, 0xdb, 0x56, 0xff, 0x2e, 0xf1, 0x01, 0x61, 0x05,
+	0xb0, 0x3c, 0xd9, 0xb6, 0x49, 0x15, 0x98, 0x6c, 0xd1, 0x92, 0x7b, 0x60, 0x5f,
+};
+
+// Eight lines of province history, varied enough that deflate gives them their own Huffman codes
+string makeProvinces()
+{
+	const char* tags[] = { "ENG", "FRA", "SCO", "PRU", "AUS", "RUS", "SPA", "POR", "NET", "SWE", "DEN", "OTT" };
+	string provinces;
+	for (int i = 0; i < 8; i++)
+	{
+		provinces += to_string(i * 7 + 1) + "={ owner=" + tags[i % 12] + " core=" + tags[(i * 5) % 12] + " trade_goods=grain base_tax=" + to_string(i % 9) + " }\n";
+	}
+	return provinces;
+}
+
+
+void appendUint16(string& bytes, uint16_t value)
+{
+	bytes.push_back(static_cast<char>(value & 0xFF));
+	bytes.push_back(static_cast<char>(value >> 8));
+}
+
+
+void appendUint32(string& bytes, uint32_t value)
+{
+	appendUint16(bytes, static_cast<uint16_t>(value & 0xFFFF));
+	appendUint16(bytes, static_cast<uint16_t>(value >> 16));
+}
+
+
+void setUint32(string& bytes, size_t offset, uint32_t value)
+{
+	string replacement;
+	appendUint32(replacement, value);
+	bytes.replace(offset, replacement.size(), replacement);
+}
+
+
+// An archive holding a single entry with the given data, which ZipArchiveWriter can only write stored
+string makeArchive(const string& name, uint16_t method, const string& compressed, uint32_t size, uint32_t crc)
+{
+	string archive;
+	appendUint32(archive, 0x04034b50);
+	appendUint16(archive, 20);
+	appendUint16(archive, 0);
+	appendUint16(archive, method);
+	appendUint32(archive, 0);	// the time and date
+	appendUint32(archive, crc);
+	appendUint32(archive, static_cast<uint32_t>(compressed.size()));
+	appendUint32(archive, size);
+	appendUint16(archive, static_cast<uint16_t>(name.size()));
+	appendUint16(archive, 0);
+	archive += name + compressed;
+
+	const uint32_t directoryOffset = static_cast<uint32_t>(archive.size());
+	appendUint32(archive, 0x02014b50);
+	appendUint16(archive, 20);
+	appendUint16(archive, 20);
+	appendUint16(archive, 0);
+	appendUint16(archive, method);
+	appendUint32(archive, 0);	// the time and date
+	appendUint32(archive, crc);
+	appendUint32(archive, static_cast<uint32_t>(compressed.size()));
+	appendUint32(archive, size);
+	appendUint16(archive, static_cast<uint16_t>(name.size()));
+	appendUint16(archive, 0);
+	appendUint16(archive, 0);
+	appendUint16(archive, 0);
+	appendUint16(archive, 0);
+	appendUint32(archive, 0);
+	appendUint32(archive, 0);	// the local header's offset
+	archive += name;
+
+	const uint32_t directorySize = static_cast<uint32_t>(archive.size()) - directoryOffset;
+	appendUint32(archive, 0x06054b50);
+	appendUint32(archive, 0);
+	appendUint16(archive, 1);
+	appendUint16(archive, 1);
+	appendUint32(archive, directorySize);
+	appendUint32(archive, directoryOffset);
+	appendUint16(archive, 0);
+	return archive;
+}
+
+
+template<size_t length> string toString(const unsigned char (&bytes)[length])
+{
+	return string(reinterpret_cast<const char*>(bytes), length);
+}
+
+
+// Extracts the only entry of an archive, or gives an empty string if it can't be
+string extractOnly(const string& archive, const string& name)
+{
+	ZipArchive zip(archive.data(), archive.size());
+	vector<char> contents;
+	if (!zip.isValid() || !zip.extract(name, contents))
+	{
+		return "";
+	}
+	return string(contents.begin(), contents.end());
+}
+
+}
+
+
+
+BOOST_AUTO_TEST_CASE(eachKindOfBlockIsInflated)
+{
+	BOOST_CHECK_EQUAL(extractOnly(makeArchive("stored", storedMethod, hello, 27, helloCrc), "stored"), hello);
+	BOOST_CHECK_EQUAL(extractOnly(makeArchive("storedBlock", deflatedMethod, toString(helloStoredBlock), 27, helloCrc), "storedBlock"), hello);
+	BOOST_CHECK_EQUAL(extractOnly(makeArchive("fixed", deflatedMethod, toString(helloFixedBlock), 27, helloCrc), "fixed"), hello);
+
+	const string provinces = makeProvinces();
+	BOOST_REQUIRE_EQUAL(provinces.size(), 438u);
+	BOOST_CHECK_EQUAL(extractOnly(makeArchive("dynamic", deflatedMethod, toString(provincesDynamicBlock), 438, provincesCrc), "dynamic"), provinces);
+}
+
+
+BOOST_AUTO_TEST_CASE(writtenArchivesReadBack)
+{
+	ZipArchiveWriter writer;
+	BOOST_REQUIRE(writer.addEntry("meta", "date=\"1444.11.11\"\n"));
+	BOOST_REQUIRE(writer.addEntry("empty", ""));
+	BOOST_REQUIRE(writer.addEntry("gamestate", makeProvinces()));
+	const string archive = writer.finish();
+
+	BOOST_REQUIRE(ZipArchive::isZipArchive(archive.data(), archive.data() + archive.size()));
+	ZipArchive zip(archive.data(), archive.size());
+	BOOST_REQUIRE(zip.isValid());
+	BOOST_CHECK(zip.getEntryNames() == vector<string>({ "meta", "empty", "gamestate" }));
+	BOOST_CHECK_EQUAL(zip.getEntrySize("gamestate"), 438u);
+	BOOST_CHECK_EQUAL(zip.getEntrySize("missing"), 0u);
+
+	// entries go onto the end of what's already there
+	vector<char> contents;
+	BOOST_REQUIRE(zip.extract("meta", contents));
+	BOOST_REQUIRE(zip.extract("empty", contents));
+	BOOST_REQUIRE(zip.extract("gamestate", contents));
+	BOOST_CHECK_EQUAL(string(contents.begin(), contents.end()), "date=\"1444.11.11\"\n" + makeProvinces());
+	BOOST_CHECK(!zip.extract("missing", contents));
+}
+
+
+BOOST_AUTO_TEST_CASE(truncatedArchivesAreRefused)
+{
+	// without the end of its directory, the archive can't be read at all
+	const string archive = makeArchive("fixed", deflatedMethod, toString(helloFixedBlock), 27, helloCrc);
+	BOOST_CHECK(!ZipArchive(archive.data(), archive.size() - 1).isValid());
+	BOOST_CHECK(!ZipArchive(archive.data(), 10).isValid());
+
+	// a deflate stream that stops before its last block does
+	string cutStream = toString(provincesDynamicBlock);
+	cutStream.resize(cutStream.size() / 2);
+	BOOST_CHECK_EQUAL(extractOnly(makeArchive("dynamic", deflatedMethod, cutStream, 438, provincesCrc), "dynamic"), "");
+}
+
+
+BOOST_AUTO_TEST_CASE(badCrcsAreRefused)
+{
+	const string archive = makeArchive("fixed", deflatedMethod, toString(helloFixedBlock), 27, helloCrc + 1);
+	ZipArchive zip(archive.data(), archive.size());
+	BOOST_REQUIRE(zip.isValid());
+
+	// nothing is left behind from the failed entry
+	vector<char> contents(3, 'x');
+	BOOST_CHECK(!zip.extract("fixed", contents));
+	BOOST_CHECK(contents == vector<char>(3, 'x'));
+}
+
+
+BOOST_AUTO_TEST_CASE(impossibleDirectoriesAreRefused)
+{
+	ZipArchiveWriter writer;
+	BOOST_REQUIRE(writer.addEntry("meta", hello));
+	const string archive = writer.finish();
+	const size_t directoryOffset = archive.size() - 22 - 46 - 4;	// the directory has a single entry, named meta
+
+	// local headers past the end of the archive, or too close to it to fit
+	for (uint32_t headerOffset: { 0xFFFFFFF0u, static_cast<uint32_t>(archive.size()), static_cast<uint32_t>(archive.size()) - 29 })
+	{
+		string badOffset = archive;
+		setUint32(badOffset, directoryOffset + 42, headerOffset);
+		BOOST_CHECK(!ZipArchive(badOffset.data(), badOffset.size()).isValid());
+	}
+
+	// sizes that would need more than the data can hold, or more than deflate can compress
+	const string wrongStored = makeArchive("stored", storedMethod, hello, 28, helloCrc);
+	BOOST_CHECK(!ZipArchive(wrongStored.data(), wrongStored.size()).isValid());
+	const string bomb = makeArchive("fixed", deflatedMethod, toString(helloFixedBlock), 0xFFFFFFF0u, helloCrc);
+	BOOST_CHECK(!ZipArchive(bomb.data(), bomb.size()).isValid());
+	const string mostCompressed = makeArchive("fixed", deflatedMethod, toString(helloFixedBlock), 12 * 1032, helloCrc);
+	BOOST_CHECK(ZipArchive(mostCompressed.data(), mostCompressed.size()).isValid());
+}
@@ -0,0 +1,157 @@
+/*Copyright (c) 2016 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+
+#include "ThreadPool.h"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+
+
+
+ThreadPool::ThreadPool(unsigned int numThreads):
+	workers(),
+	tasks(),
+	taskMutex(),
+	taskReady(),
+	stopping(false)
+{
+	for (unsigned int i = 0; i < numThreads; i++)
+	{
+		workers.push_back(thread(&ThreadPool::workerLoop, this));
+	}
+}
+
+
+ThreadPool::~ThreadPool()
+{
+	{
+		lock_guard<mutex> lock(taskMutex);
+		stopping = true;
+	}
+	taskReady.notify_all();
+	for (auto& worker: workers)
+	{
+		worker.join();
+	}
+}
+
+
+void ThreadPool::submit(function<void()> task)
+{
+	{
+		lock_guard<mutex> lock(taskMutex);
+		tasks.push(move(task));
+	}
+	taskReady.notify_one();
+}
+
+
+void ThreadPool::parallelFor(size_t count, const function<void(size_t)>& body)
+{
+	if (count == 0)
+	{
+		return;
+	}
+
+	// helpers may only get to run after every index is done, so everything they touch is kept alive by them
+	struct Work
+	{
+		Work(size_t _count, const function<void(size_t)>& _body): count(_count), body(_body), nextIndex(0), finished(0), error() {}
+
+		size_t						count;		// the number of indices to run
+		function<void(size_t)>	body;			// what to run for each index
+		atomic<size_t>				nextIndex;	// the next index nobody has claimed
+		atomic<size_t>				finished;	// the number of indices that have finished
+		mutex							doneMutex;	// guards error and is used to wait on done
+		condition_variable		done;			// signalled when the last index finishes
+		exception_ptr				error;		// the first exception thrown by body
+	};
+	auto work = make_shared<Work>(count, body);	// the state shared with the helpers
+
+	auto runIndices = [](const shared_ptr<Work>& work)
+	{
+		for (size_t i = work->nextIndex++; i < work->count; i = work->nextIndex++)
+		{
+			try
+			{
+				work->body(i);
+			}
+			catch (...)
+			{
+				lock_guard<mutex> lock(work->doneMutex);
+				if (!work->error)
+				{
+					work->error = current_exception();
+				}
+			}
+			if (++work->finished == work->count)
+			{
+				lock_guard<mutex> lock(work->doneMutex);
+				work->done.notify_all();
+			}
+		}
+	};
+
+	const size_t numHelpers = min(count - 1, workers.size());	// the number of pool threads to ask for help
+	for (size_t i = 0; i < numHelpers; i++)
+	{
+		submit([work, runIndices]() { runIndices(work); });
+	}
+	runIndices(work);
+
+	unique_lock<mutex> lock(work->doneMutex);
+	work->done.wait(lock, [&work]() { return work->finished == work->count; });
+	if (work->error)
+	{
+		rethrow_exception(work->error);
+	}
+}
+
+
+ThreadPool& ThreadPool::getShared()
+{
+	static ThreadPool sharedPool(max(thread::hardware_concurrency(), 1u));
+	return sharedPool;
+}
+
+
+void ThreadPool::workerLoop()
+{
+	while (true)
+	{
+		function<void()> task;	// the task to run next
+		{
+			unique_lock<mutex> lock(taskMutex);
+			taskReady.wait(lock, [this]() { return stopping || !tasks.empty(); });
+			if (stopping && tasks.empty())
+			{
+				return;
+			}
+			task = move(tasks.front());
+			tasks.pop();
+		}
+		task();
+	}
+}
@@ -0,0 +1,74 @@
+/*Copyright (c) 2016 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+
+#ifndef THREAD_POOL_H_
+#define THREAD_POOL_H_
+
+
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+using namespace std;
+
+
+
+// A fixed set of worker threads that run queued tasks in the order they were submitted.
+class ThreadPool
+{
+	public:
+		explicit ThreadPool(unsigned int numThreads);
+		~ThreadPool();
+
+		void				submit(function<void()> task);
+
+		// Calls body(0) through body(count - 1) across the pool and returns once all of them have finished.
+		// The calling thread works through the indices too, so this is safe to call from inside a task on
+		// the same pool. If any call throws, the first exception is rethrown here.
+		void				parallelFor(size_t count, const function<void(size_t)>& body);
+
+		unsigned int	getNumThreads() const { return static_cast<unsigned int>(workers.size()); }
+
+		// The pool shared by the whole converter, with one thread per hardware thread
+		static ThreadPool&	getShared();
+
+	private:
+		ThreadPool(const ThreadPool&);
+		ThreadPool& operator=(const ThreadPool&);
+
+		void	workerLoop();
+
+		vector<thread>					workers;		// the threads running tasks
+		queue<function<void()>>		tasks;		// the tasks waiting for a thread
+		mutex								taskMutex;	// guards tasks and stopping
+		condition_variable			taskReady;	// signalled when a task is queued or the pool is stopping
+		bool								stopping;	// whether or not the pool is shutting down
+};
+
+
+
+#endif // THREAD_POOL_H_
@@ -0,0 +1,209 @@
+/*Copyright (c) 2016 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+
+#include "VirtualFileSystem.h"
+#include "Log.h"
+#include "OSCompatibilityLayer.h"
+#include <boost/filesystem.hpp>
+
+
+
+void VirtualFileSystem::addLayer(const string& name, const string& root, const string& skippedFolder)
+{
+	if (layers.size() == maxLayers)
+	{
+		LOG(LogLevel::Error) << "Too many folders to index, ignoring " << root;
+		return;
+	}
+	const uint64_t layerBit = uint64_t(1) << layers.size();	// marks the entries in this layer
+	layers.push_back({ name, root });
+
+#ifdef _WIN32
+	const boost::filesystem::path rootPath(Utils::convertUTF8ToUTF16(root));	// the folder to scan
+	const size_t rootLength = rootPath.generic_wstring().size() + 1;				// the length of the root and the slash after it
+#else
+	const boost::filesystem::path rootPath(root);							// the folder to scan
+	const size_t rootLength = rootPath.generic_string().size() + 1;	// the length of the root and the slash after it
+#endif
+	boost::system::error_code error;	// where boost reports failures rather than throwing
+	if (!boost::filesystem::is_directory(rootPath, error))
+	{
+		LOG(LogLevel::Debug) << "Could not index " << root << ", as it is not a folder";
+		return;
+	}
+
+	const string skipped = normalise(skippedFolder);	// the folder to leave out, as it will appear in the index
+	size_t entryCount = 0;									// how many files and folders the layer holds
+	for (boost::filesystem::recursive_directory_iterator entry(rootPath, error), end; !error && (entry != end); entry.increment(error))
+	{
+#ifdef _WIN32
+		const string path = normalise(Utils::convertUTF16ToUTF8(entry->path().generic_wstring().substr(rootLength)));	// the entry's path within the layer
+#else
+		const string path = normalise(entry->path().generic_string().substr(rootLength));	// the entry's path within the layer
+#endif
+		if (boost::filesystem::is_directory(entry->status(error)))
+		{
+			if (path == skipped)
+			{
+				entry.no_push();
+				continue;
+			}
+			folders[path] |= layerBit;
+		}
+		else
+		{
+			files[path] |= layerBit;
+		}
+		entryCount++;
+	}
+	if (error)
+	{
+		LOG(LogLevel::Warning) << "Could not finish indexing " << root << ": " << error.message();
+	}
+	LOG(LogLevel::Debug) << "Indexed " << entryCount << " files and folders in " << root;
+}
+
+
+bool VirtualFileSystem::hasFile(const string& path) const
+{
+	return getMask(files, path) != 0;
+}
+
+
+bool VirtualFileSystem::hasFolder(const string& path) const
+{
+	return getMask(folders, path) != 0;
+}
+
+
+bool VirtualFileSystem::layerHasFile(const string& layer, const string& path) const
+{
+	const int layerIndex = findLayer(layer);	// the position of the layer
+	return (layerIndex >= 0) && ((getMask(files, path) & (uint64_t(1) << layerIndex)) != 0);
+}
+
+
+bool VirtualFileSystem::layerHasFolder(const string& layer, const string& path) const
+{
+	const int layerIndex = findLayer(layer);	// the position of the layer
+	return (layerIndex >= 0) && ((getMask(folders, path) & (uint64_t(1) << layerIndex)) != 0);
+}
+
+
+const string* VirtualFileSystem::getWinningLayer(const string& path) const
+{
+	const int layerIndex = getTopLayer(getMask(files, path));	// the position of the winning layer
+	if (layerIndex < 0)
+	{
+		return nullptr;
+	}
+	return &layers[layerIndex].name;
+}
+
+
+string VirtualFileSystem::resolve(const string& path) const
+{
+	const int layerIndex = getTopLayer(getMask(files, path));	// the position of the winning layer
+	if (layerIndex < 0)
+	{
+		return "";
+	}
+	return layers[layerIndex].root + "/" + path;
+}
+
+
+string VirtualFileSystem::resolveInLayer(const string& layer, const string& path) const
+{
+	if (!layerHasFile(layer, path))
+	{
+		return "";
+	}
+	return layers[findLayer(layer)].root + "/" + path;
+}
+
+
+string VirtualFileSystem::normalise(const string& path)
+{
+	string normalised;	// the path with single forward slashes and no slash at either end
+	normalised.reserve(path.size());
+	for (char character: path)
+	{
+		if ((character == '/') || (character == '\\'))
+		{
+			if (!normalised.empty() && (normalised.back() != '/'))
+			{
+				normalised.push_back('/');
+			}
+			continue;
+		}
+#ifdef _WIN32
+		if ((character >= 'A') && (character <= 'Z'))
+		{
+			character = character - 'A' + 'a';
+		}
+#endif
+		normalised.push_back(character);
+	}
+	if (!normalised.empty() && (normalised.back() == '/'))
+	{
+		normalised.pop_back();
+	}
+	return normalised;
+}
+
+
+int VirtualFileSystem::findLayer(const string& name) const
+{
+	for (unsigned int i = 0; i < layers.size(); i++)
+	{
+		if (layers[i].name == name)
+		{
+			return i;
+		}
+	}
+	return -1;
+}
+
+
+uint64_t VirtualFileSystem::getMask(const unordered_map<string, uint64_t>& entries, const string& path) const
+{
+	auto entry = entries.find(normalise(path));	// the entry for the path, if any layer has one
+	if (entry == entries.end())
+	{
+		return 0;
+	}
+	return entry->second;
+}
+
+
+int VirtualFileSystem::getTopLayer(uint64_t mask) const
+{
+	int layerIndex = -1;	// the position of the highest set bit
+	while (mask != 0)
+	{
+		mask >>= 1;
+		layerIndex++;
+	}
+	return layerIndex;
+}
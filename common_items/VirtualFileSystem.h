@@ -0,0 +1,85 @@
+/*Copyright (c) 2016 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+
+#ifndef VIRTUAL_FILE_SYSTEM_H_
+#define VIRTUAL_FILE_SYSTEM_H_
+
+
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+using namespace std;
+
+
+
+// An index of every file and folder in a game install and the mods layered over it, built by scanning each
+// folder once. Asking whether a file exists, or which layer's copy of it wins, is then a lookup in memory
+// instead of a call to the filesystem per layer. Each layer added takes precedence over those added before it.
+//
+// Paths are relative to a layer's root and use forward slashes. On Windows they are matched without regard to
+// case, as the filesystem would.
+class VirtualFileSystem
+{
+	public:
+		// Scans root and everything under it as a new topmost layer. A root that does not exist adds an empty layer.
+		// A skipped folder, such as an install's mod folder, is left out of the layer along with everything in it.
+		void		addLayer(const string& name, const string& root, const string& skippedFolder = "");
+
+		bool		hasFile(const string& path) const;
+		bool		hasFolder(const string& path) const;
+		bool		layerHasFile(const string& layer, const string& path) const;
+		bool		layerHasFolder(const string& layer, const string& path) const;
+
+		// Returns the name of the topmost layer holding the file, or nullptr if none does.
+		const string*	getWinningLayer(const string& path) const;
+
+		// Returns the full path to the topmost copy of the file, or "" if no layer holds it.
+		string	resolve(const string& path) const;
+		// Returns the full path to the named layer's copy of the file, or "" if it does not hold one.
+		string	resolveInLayer(const string& layer, const string& path) const;
+
+	private:
+		struct Layer
+		{
+			string	name;	// what the layer is looked up by, such as a mod's name
+			string	root;	// the folder the layer's paths are relative to
+		};
+
+		static const unsigned int maxLayers = 64;	// one for each bit of a layer mask
+
+		static string	normalise(const string& path);
+		int				findLayer(const string& name) const;
+		uint64_t			getMask(const unordered_map<string, uint64_t>& entries, const string& path) const;
+		int				getTopLayer(uint64_t mask) const;
+
+		vector<Layer>								layers;	// every layer, lowest first
+		unordered_map<string, uint64_t>		files;	// each file's normalised path, and a bit for each layer holding it
+		unordered_map<string, uint64_t>		folders;	// each folder's normalised path, and a bit for each layer holding it
+};
+
+
+
+#endif // VIRTUAL_FILE_SYSTEM_H_
@@ -27,6 +27,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 #include <io.h>
 #include <Shellapi.h>
 #include <list>
+#include "Encoding.h"
 #include "Log.h"
 
 
@@ -221,6 +222,43 @@ bool doesFolderExist(const std::string& path)
 }
 
 
+bool GetFileStamp(const std::string& path, FileStamp& stamp)
+{
+	std::wstring widePath = convertUTF8ToUTF16(path);	// the path, as Windows wants it
+	WIN32_FILE_ATTRIBUTE_DATA attributes;	// the size, times and attributes of the file
+	if (!GetFileAttributesExW(widePath.c_str(), GetFileExInfoStandard, &attributes) || (attributes.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY))
+	{
+		return false;
+	}
+
+	wchar_t fullPath[MAX_PATH];	// the absolute path to the file
+	DWORD length = GetFullPathNameW(widePath.c_str(), MAX_PATH, fullPath, NULL);	// the length of the absolute path
+	if ((length == 0) || (length >= MAX_PATH))
+	{
+		return false;
+	}
+
+	stamp.absolutePath	= convertUTF16ToUTF8(std::wstring(fullPath, length));
+	stamp.size				= (static_cast<uint64_t>(attributes.nFileSizeHigh) << 32) | attributes.nFileSizeLow;
+	stamp.modifiedTime	= static_cast<int64_t>((static_cast<uint64_t>(attributes.ftLastWriteTime.dwHighDateTime) << 32) | attributes.ftLastWriteTime.dwLowDateTime);
+	return true;
+}
+
+
+bool TryReplaceFile(const std::string& sourcePath, const std::string& destPath)
+{
+	if (MoveFileExW(convertUTF8ToUTF16(sourcePath).c_str(), convertUTF8ToUTF16(destPath).c_str(), MOVEFILE_REPLACE_EXISTING))
+	{
+		return true;
+	}
+	else
+	{
+		LOG(LogLevel::Warning) << "Could not replace " << destPath << " with " << sourcePath << " - " << GetLastErrorString();
+		return false;
+	}
+}
+
+
 std::string GetLastErrorString()
 {
 	DWORD errorCode = ::GetLastError();	// the code for the latest error
@@ -293,6 +331,13 @@ std::string convertUTF8ToASCII(std::string UTF8)
 
 std::string convertUTF8To8859_15(std::string UTF8)
 {
+	std::string converted;
+	if (Encoding::appendUTF8As8859_15(UTF8.data(), UTF8.data() + UTF8.size(), converted, '0'))
+	{
+		return converted;
+	}
+
+	// Windows can find near equivalents for some characters 8859-15 lacks, such as plain letters for accented ones
 	int requiredSize = WideCharToMultiByte(28605 /*8859-15*/, 0, convertUTF8ToUTF16(UTF8).c_str(), -1, NULL, 0, "0", NULL);
 	char* asciiArray = new char[requiredSize];
 
@@ -310,62 +355,33 @@ std::string convertUTF8To8859_15(std::string UTF8)
 
 std::string convertUTF16ToUTF8(std::wstring UTF16)
 {
-	int requiredSize = WideCharToMultiByte(CP_UTF8, 0, UTF16.c_str(), -1, NULL, 0, NULL, NULL);
-	char* utf8array = new char[requiredSize];
-
-	if (0 == WideCharToMultiByte(CP_UTF8, 0, UTF16.c_str(), -1, utf8array, requiredSize, NULL, NULL))
-	{
-		LOG(LogLevel::Error) << "Could not translate string to UTF-8 - " << GetLastErrorString();
-	}
-	std::string returnable(utf8array);
-
-	delete[] utf8array;
-
-	return returnable;
+	std::string UTF8;
+	Encoding::appendUTF16AsUTF8(UTF16.data(), UTF16.data() + UTF16.size(), UTF8);
+	return UTF8;
 }
 
 
 std::string convert8859_15ToUTF8(std::string input)
 {
-	return convertUTF16ToUTF8(convert8859_15ToUTF16(input));
+	std::string UTF8;
+	Encoding::append8859_15AsUTF8(input.data(), input.data() + input.size(), UTF8);
+	return UTF8;
 }
 
 
 std::wstring convert8859_15ToUTF16(std::string string8859_15)
 {
-	int requiredSize = MultiByteToWideChar(28605 /* 8859-15*/, MB_PRECOMPOSED, string8859_15.c_str(), -1, NULL, 0);
-	wchar_t* wideKeyArray = new wchar_t[requiredSize];
-
-	if (0 == MultiByteToWideChar(28605 /* 8859-15*/, MB_PRECOMPOSED, string8859_15.c_str(), -1, wideKeyArray, requiredSize))
-	{
-		LOG(LogLevel::Error) << "Could not translate string to UTF-16 - " << GetLastErrorString();
-	}
-	std::wstring returnable(wideKeyArray);
-
-	delete[] wideKeyArray;
-
-	return returnable;
+	std::wstring UTF16;
+	Encoding::append8859_15AsUTF16(string8859_15.data(), string8859_15.data() + string8859_15.size(), UTF16);
+	return UTF16;
 }
 
 
 std::wstring convertUTF8ToUTF16(std::string UTF8)
 {
-	int requiredSize = MultiByteToWideChar(CP_UTF8, 0, UTF8.c_str(), -1, NULL, 0);
-	if (requiredSize == 0)
-	{
-		LOG(LogLevel::Error) << "Could not translate string to UTF-16 - " << GetLastErrorString();
-	}
-	wchar_t* wideKeyArray = new wchar_t[requiredSize];
-
-	if (0 == MultiByteToWideChar(CP_UTF8, 0, UTF8.c_str(), -1, wideKeyArray, requiredSize))
-	{
-		LOG(LogLevel::Error) << "Could not translate string to UTF-16 - " << GetLastErrorString();
-	}
-	std::wstring returnable(wideKeyArray);
-
-	delete[] wideKeyArray;
-
-	return returnable;
+	std::wstring UTF16;
+	Encoding::appendUTF8AsUTF16(UTF8.data(), UTF8.data() + UTF8.size(), UTF16);
+	return UTF16;
 }
 
 
@@ -419,4 +435,68 @@ void WriteToConsole(LogLevel level, const std::string& logMessage)
 
 
 
+MappedFile::MappedFile(const std::string& path):
+	opened(false),
+	data(nullptr),
+	size(0),
+	fileHandle(INVALID_HANDLE_VALUE),
+	mappingHandle(NULL)
+{
+	fileHandle = CreateFileW(convertUTF8ToUTF16(path).c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+	if (fileHandle == INVALID_HANDLE_VALUE)
+	{
+		return;
+	}
+
+	LARGE_INTEGER fileSize;	// the size of the file
+	if (!GetFileSizeEx(fileHandle, &fileSize))
+	{
+		LOG(LogLevel::Warning) << "Could not get the size of " << path << " - " << GetLastErrorString();
+		return;
+	}
+	size = static_cast<size_t>(fileSize.QuadPart);
+	if (size == 0)
+	{
+		// empty files cannot be mapped
+		data		= "";
+		opened	= true;
+		return;
+	}
+
+	mappingHandle = CreateFileMappingW(fileHandle, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (mappingHandle == NULL)
+	{
+		LOG(LogLevel::Warning) << "Could not map " << path << " - " << GetLastErrorString();
+		size = 0;
+		return;
+	}
+	data = static_cast<const char*>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+	if (data == nullptr)
+	{
+		LOG(LogLevel::Warning) << "Could not map " << path << " - " << GetLastErrorString();
+		size = 0;
+		return;
+	}
+	opened = true;
+}
+
+
+MappedFile::~MappedFile()
+{
+	if ((data != nullptr) && (size > 0))
+	{
+		UnmapViewOfFile(data);
+	}
+	if (mappingHandle != NULL)
+	{
+		CloseHandle(mappingHandle);
+	}
+	if (fileHandle != INVALID_HANDLE_VALUE)
+	{
+		CloseHandle(fileHandle);
+	}
+}
+
+
+
 } // namespace Utils
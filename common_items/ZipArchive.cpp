@@ -0,0 +1,767 @@
+/*Copyright (c) 2016 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+
+#include "ZipArchive.h"
+#include <cstring>
+
+
+
+namespace
+{
+
+uint16_t readUint16(const unsigned char* bytes)
+{
+	return static_cast<uint16_t>(bytes[0] | (bytes[1] << 8));
+}
+
+
+uint32_t readUint32(const unsigned char* bytes)
+{
+	return (bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | (static_cast<uint32_t>(bytes[3]) << 24));
+}
+
+
+void appendUint16(string& bytes, uint16_t value)
+{
+	bytes.push_back(static_cast<char>(value & 0xFF));
+	bytes.push_back(static_cast<char>(value >> 8));
+}
+
+
+void appendUint32(string& bytes, uint32_t value)
+{
+	appendUint16(bytes, static_cast<uint16_t>(value & 0xFFFF));
+	appendUint16(bytes, static_cast<uint16_t>(value >> 16));
+}
+
+
+const uint32_t localHeaderSignature		= 0x04034b50;
+const uint32_t centralHeaderSignature	= 0x02014b50;
+const uint32_t endOfDirectorySignature	= 0x06054b50;
+const size_t localHeaderLength			= 30;
+const size_t centralHeaderLength			= 46;
+const size_t endOfDirectoryLength		= 22;
+
+const uint16_t storedMethod	= 0;
+const uint16_t deflatedMethod	= 8;
+const uint64_t maxDeflateRatio	= 1032;	// the most deflate can compress: a 258 byte match coded in two bits
+
+const uint16_t storedVersion	= 10;		// the zip version needed to extract stored entries
+const uint16_t utf8NamesFlag	= 0x0800;	// marks entry names as UTF-8
+const uint16_t fixedDosTime	= 0;			// midnight
+const uint16_t fixedDosDate	= 0x0021;	// 1980.1.1, the earliest date a zip archive can hold
+
+
+uint32_t crc32(const char* begin, const char* end)
+{
+	struct CrcTable
+	{
+		uint32_t values[256];
+		CrcTable()
+		{
+			for (uint32_t i = 0; i < 256; i++)
+			{
+				uint32_t value = i;
+				for (int bit = 0; bit < 8; bit++)
+				{
+					value = (value & 1) ? (0xEDB88320 ^ (value >> 1)) : (value >> 1);
+				}
+				values[i] = value;
+			}
+		}
+	};
+	static const CrcTable table;
+
+	uint32_t crc = 0xFFFFFFFF;
+	for (const char* i = begin; i < end; ++i)
+	{
+		crc = table.values[(crc ^ static_cast<unsigned char>(*i)) & 0xFF] ^ (crc >> 8);
+	}
+	return crc ^ 0xFFFFFFFF;
+}
+
+
+// A Huffman code from a deflate stream. Codes of up to fastBits bits are decoded with a single table lookup;
+// longer ones (which are rare) are decoded a bit at a time from the count of codes of each length.
+class HuffmanCode
+{
+	public:
+		static const int maxBits	= 15;
+		static const int fastBits	= 10;
+
+		// Builds the canonical code for symbols with the given code lengths (0 for unused symbols).
+		// Returns false if the lengths describe more codes than there is room for.
+		bool build(const unsigned char* lengths, int symbolCount)
+		{
+			memset(counts, 0, sizeof(counts));
+			for (int symbol = 0; symbol < symbolCount; symbol++)
+			{
+				counts[lengths[symbol]]++;
+			}
+			counts[0] = 0;
+
+			int left = 1;	// the number of codes still available at the current length
+			for (int length = 1; length <= maxBits; length++)
+			{
+				left = (left << 1) - counts[length];
+				if (left < 0)
+				{
+					return false;
+				}
+			}
+
+			int offsets[maxBits + 2];	// where the symbols of each length start in symbols
+			offsets[1] = 0;
+			for (int length = 1; length <= maxBits; length++)
+			{
+				offsets[length + 1] = offsets[length] + counts[length];
+			}
+
+			memset(fast, 0, sizeof(fast));
+			int nextCode[maxBits + 1];	// the next canonical code of each length
+			int code = 0;
+			for (int length = 1; length <= maxBits; length++)
+			{
+				code = (code + counts[length - 1]) << 1;
+				nextCode[length] = code;
+			}
+			for (int symbol = 0; symbol < symbolCount; symbol++)
+			{
+				const int length = lengths[symbol];
+				if (length == 0)
+				{
+					continue;
+				}
+				symbols[offsets[length]++] = static_cast<uint16_t>(symbol);
+
+				if (length <= fastBits)
+				{
+					// deflate stores codes starting from their most significant bit, so index by the reversed code
+					int reversed = 0;
+					for (int bit = 0, value = nextCode[length]; bit < length; bit++, value >>= 1)
+					{
+						reversed = (reversed << 1) | (value & 1);
+					}
+					const uint16_t entry = static_cast<uint16_t>((length << 9) | symbol);
+					for (int index = reversed; index < (1 << fastBits); index += (1 << length))
+					{
+						fast[index] = entry;
+					}
+				}
+				nextCode[length]++;
+			}
+			return true;
+		}
+
+		uint16_t	fast[1 << fastBits];	// the length (top 7 bits) and symbol (low 9 bits) for each possible next fastBits bits, or 0
+		uint16_t	counts[maxBits + 1];		// the number of codes of each length
+		uint16_t	symbols[288];				// the symbols, in order of their codes
+};
+
+
+// Decompresses raw deflate data (RFC 1951) into a buffer whose size is known in advance
+class Inflater
+{
+	public:
+		Inflater(const unsigned char* _in, size_t inSize, char* _out, size_t outSize):
+			in(_in),
+			inEnd(_in + inSize),
+			bits(0),
+			bitCount(0),
+			padding(0),
+			outStart(_out),
+			out(_out),
+			outEnd(_out + outSize)
+		{
+		}
+
+		// Returns false if the data is damaged or does not fit the buffer exactly
+		bool inflate()
+		{
+			bool lastBlock = false;
+			while (!lastBlock)
+			{
+				lastBlock = (getBits(1) == 1);
+				bool blockRead;	// whether or not the block could be decompressed
+				switch (getBits(2))
+				{
+					case 0:
+						blockRead = inflateStoredBlock();
+						break;
+					case 1:
+						blockRead = inflateFixedBlock();
+						break;
+					case 2:
+						blockRead = inflateDynamicBlock();
+						break;
+					default:
+						blockRead = false;
+				}
+				if (!blockRead || overran())
+				{
+					return false;
+				}
+			}
+			return (out == outEnd);
+		}
+
+	private:
+		void refill()
+		{
+			while (bitCount <= 56)
+			{
+				if (in < inEnd)
+				{
+					bits |= static_cast<uint64_t>(*in++) << bitCount;
+				}
+				else
+				{
+					// past the end of the input, feed zeros and check afterwards that none were used
+					padding++;
+				}
+				bitCount += 8;
+			}
+		}
+
+		uint32_t getBits(int count)
+		{
+			if (bitCount < count)
+			{
+				refill();
+			}
+			const uint32_t value = static_cast<uint32_t>(bits & ((1ull << count) - 1));
+			bits >>= count;
+			bitCount -= count;
+			return value;
+		}
+
+		bool overran() const
+		{
+			return (padding * 8 > bitCount);
+		}
+
+		// Returns the next symbol, or -1 if the bits are not a code
+		int decode(const HuffmanCode& code)
+		{
+			if (bitCount < HuffmanCode::maxBits)
+			{
+				refill();
+			}
+			const uint16_t entry = code.fast[bits & ((1 << HuffmanCode::fastBits) - 1)];
+			if (entry != 0)
+			{
+				const int length = entry >> 9;
+				bits >>= length;
+				bitCount -= length;
+				return (entry & 0x1FF);
+			}
+
+			int codeValue	= 0;	// the code read so far
+			int first		= 0;	// the first code of the current length
+			int index		= 0;	// where the symbols of the current length start
+			for (int length = 1; length <= HuffmanCode::maxBits; length++)
+			{
+				codeValue |= static_cast<int>(bits & 1);
+				bits >>= 1;
+				bitCount--;
+				const int count = code.counts[length];
+				if (codeValue - count < first)
+				{
+					return code.symbols[index + (codeValue - first)];
+				}
+				index += count;
+				first += count;
+				first <<= 1;
+				codeValue <<= 1;
+			}
+			return -1;
+		}
+
+		bool inflateStoredBlock()
+		{
+			// stored blocks start at a byte boundary, so return the unused whole bytes to the input
+			getBits(bitCount % 8);
+			const size_t bufferedBytes = bitCount / 8;
+			if (bufferedBytes < padding)
+			{
+				return false;
+			}
+			in -= bufferedBytes - padding;
+			bits		= 0;
+			bitCount	= 0;
+			padding	= 0;
+
+			if (inEnd - in < 4)
+			{
+				return false;
+			}
+			const uint16_t length			= readUint16(in);
+			const uint16_t lengthComplement	= readUint16(in + 2);
+			in += 4;
+			if ((length != static_cast<uint16_t>(~lengthComplement)) || (static_cast<size_t>(inEnd - in) < length) || (static_cast<size_t>(outEnd - out) < length))
+			{
+				return false;
+			}
+			memcpy(out, in, length);
+			in		+= length;
+			out	+= length;
+			return true;
+		}
+
+		bool inflateFixedBlock()
+		{
+			struct FixedCodes
+			{
+				HuffmanCode literals;
+				HuffmanCode distances;
+				FixedCodes()
+				{
+					unsigned char lengths[288];
+					memset(lengths, 8, 144);
+					memset(lengths + 144, 9, 112);
+					memset(lengths + 256, 7, 24);
+					memset(lengths + 280, 8, 8);
+					literals.build(lengths, 288);
+					memset(lengths, 5, 30);
+					distances.build(lengths, 30);
+				}
+			};
+			static const FixedCodes codes;
+			return inflateCodes(codes.literals, codes.distances);
+		}
+
+		bool inflateDynamicBlock()
+		{
+			static const unsigned char codeLengthOrder[19] = { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+
+			const int literalCount		= getBits(5) + 257;
+			const int distanceCount		= getBits(5) + 1;
+			const int codeLengthCount	= getBits(4) + 4;
+			if ((literalCount > 286) || (distanceCount > 30))
+			{
+				return false;
+			}
+
+			unsigned char lengths[286 + 30] = { 0 };	// the code lengths of the literal/length code, then the distance code
+			for (int i = 0; i < codeLengthCount; i++)
+			{
+				lengths[codeLengthOrder[i]] = static_cast<unsigned char>(getBits(3));
+			}
+			HuffmanCode lengthCode;
+			if (!lengthCode.build(lengths, 19))
+			{
+				return false;
+			}
+
+			memset(lengths, 0, 19);
+			int index = 0;
+			while (index < literalCount + distanceCount)
+			{
+				const int symbol = decode(lengthCode);
+				if (symbol < 0)
+				{
+					return false;
+				}
+				if (symbol < 16)
+				{
+					lengths[index++] = static_cast<unsigned char>(symbol);
+					continue;
+				}
+
+				unsigned char repeated = 0;	// the length to repeat
+				int repeats;
+				if (symbol == 16)
+				{
+					if (index == 0)
+					{
+						return false;
+					}
+					repeated	= lengths[index - 1];
+					repeats	= 3 + getBits(2);
+				}
+				else if (symbol == 17)
+				{
+					repeats = 3 + getBits(3);
+				}
+				else
+				{
+					repeats = 11 + getBits(7);
+				}
+				if (index + repeats > literalCount + distanceCount)
+				{
+					return false;
+				}
+				memset(lengths + index, repeated, repeats);
+				index += repeats;
+			}
+			if (lengths[256] == 0)
+			{
+				return false;
+			}
+
+			HuffmanCode literals;
+			HuffmanCode distances;
+			if (!literals.build(lengths, literalCount) || !distances.build(lengths + literalCount, distanceCount))
+			{
+				return false;
+			}
+			return inflateCodes(literals, distances);
+		}
+
+		bool inflateCodes(const HuffmanCode& literals, const HuffmanCode& distances)
+		{
+			static const uint16_t lengthBases[29]			= { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+			static const unsigned char lengthExtraBits[29]	= { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+			static const uint16_t distanceBases[30]			= { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+			static const unsigned char distanceExtraBits[30]	= { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+
+			while (true)
+			{
+				int symbol = decode(literals);
+				if (symbol < 256)
+				{
+					if ((symbol < 0) || (out == outEnd))
+					{
+						return false;
+					}
+					*out++ = static_cast<char>(symbol);
+					continue;
+				}
+				if (symbol == 256)
+				{
+					return true;
+				}
+
+				symbol -= 257;
+				if (symbol >= 29)
+				{
+					return false;
+				}
+				const size_t length = lengthBases[symbol] + getBits(lengthExtraBits[symbol]);
+
+				symbol = decode(distances);
+				if ((symbol < 0) || (symbol >= 30))
+				{
+					return false;
+				}
+				const size_t distance = distanceBases[symbol] + getBits(distanceExtraBits[symbol]);
+				if ((distance > static_cast<size_t>(out - outStart)) || (length > static_cast<size_t>(outEnd - out)))
+				{
+					return false;
+				}
+
+				const char* from = out - distance;	// the earlier output to repeat
+				if (distance >= length)
+				{
+					memcpy(out, from, length);
+					out += length;
+				}
+				else
+				{
+					// the copy overlaps the bytes it produces, so it must go a byte at a time
+					for (size_t i = 0; i < length; i++)
+					{
+						*out++ = *from++;
+					}
+				}
+			}
+		}
+
+		const unsigned char*	in;			// the next byte of input to read
+		const unsigned char*	inEnd;		// the end of the input
+		uint64_t					bits;			// input bits that have been read but not used
+		int						bitCount;	// the number of bits in bits
+		size_t					padding;		// the number of bytes fed in past the end of the input
+		char*						outStart;	// the start of the output
+		char*						out;			// where the next output goes
+		char*						outEnd;		// the end of the output
+};
+
+}
+
+
+
+ZipArchive::ZipArchive(const char* _data, size_t size):
+	data(reinterpret_cast<const unsigned char*>(_data)),
+	dataSize(size),
+	entries(),
+	valid(false),
+	error()
+{
+	valid = readDirectory();
+}
+
+
+bool ZipArchive::isZipArchive(const char* begin, const char* end)
+{
+	return ((end - begin >= 4) && (readUint32(reinterpret_cast<const unsigned char*>(begin)) == localHeaderSignature));
+}
+
+
+vector<string> ZipArchive::getEntryNames() const
+{
+	vector<string> names;
+	for (auto& entry: entries)
+	{
+		names.push_back(entry.name);
+	}
+	return names;
+}
+
+
+size_t ZipArchive::getEntrySize(const string& name) const
+{
+	const Entry* entry = findEntry(name);
+	return ((entry == nullptr) ? 0 : entry->size);
+}
+
+
+bool ZipArchive::extract(const string& name, vector<char>& contents) const
+{
+	const Entry* entry = findEntry(name);
+	if (entry == nullptr)
+	{
+		return fail("There is no entry named " + name);
+	}
+
+	if ((entry->headerOffset > dataSize) || (dataSize - entry->headerOffset < localHeaderLength))
+	{
+		return fail("The header of " + name + " is past the end of the archive");
+	}
+	const unsigned char* header = data + entry->headerOffset;	// the entry's local header
+	if (readUint32(header) != localHeaderSignature)
+	{
+		return fail("The header of " + name + " is damaged");
+	}
+	const size_t dataOffset = entry->headerOffset + localHeaderLength + readUint16(header + 26) + readUint16(header + 28);	// where the entry's data starts
+	if ((dataOffset > dataSize) || (dataSize - dataOffset < entry->compressedSize))
+	{
+		return fail("The data of " + name + " is past the end of the archive");
+	}
+
+	const size_t start = contents.size();	// where the entry goes in contents
+	contents.resize(start + entry->size);
+	bool extracted;	// whether or not the data could be decompressed
+	if (entry->method == storedMethod)
+	{
+		extracted = (entry->compressedSize == entry->size);
+		if (extracted)
+		{
+			memcpy(contents.data() + start, data + dataOffset, entry->size);
+		}
+	}
+	else if (entry->method == deflatedMethod)
+	{
+		Inflater inflater(data + dataOffset, entry->compressedSize, contents.data() + start, entry->size);
+		extracted = inflater.inflate();
+	}
+	else
+	{
+		contents.resize(start);
+		return fail(name + " uses an unsupported compression method");
+	}
+
+	if (!extracted || (crc32(contents.data() + start, contents.data() + contents.size()) != entry->crc))
+	{
+		contents.resize(start);
+		return fail(name + " is damaged");
+	}
+	return true;
+}
+
+
+bool ZipArchive::readDirectory()
+{
+	// the end of directory record is at the end of the archive, followed only by a comment of up to 64K
+	if (dataSize < endOfDirectoryLength)
+	{
+		return fail("The file is too short to be a zip archive");
+	}
+	const unsigned char* endRecord = nullptr;	// the end of directory record
+	const size_t searchStart = (dataSize > endOfDirectoryLength + 0xFFFF) ? (dataSize - endOfDirectoryLength - 0xFFFF) : 0;	// the earliest place the record could be
+	for (size_t offset = dataSize - endOfDirectoryLength + 1; offset-- > searchStart;)
+	{
+		if (readUint32(data + offset) == endOfDirectorySignature)
+		{
+			endRecord = data + offset;
+			break;
+		}
+	}
+	if (endRecord == nullptr)
+	{
+		return fail("The zip archive has no directory");
+	}
+
+	const uint16_t entryCount	= readUint16(endRecord + 10);
+	size_t offset					= readUint32(endRecord + 16);	// where the next directory entry starts
+	if (offset == 0xFFFFFFFF)
+	{
+		return fail("Zip64 archives are not supported");
+	}
+
+	for (uint16_t i = 0; i < entryCount; i++)
+	{
+		if ((offset > dataSize) || (dataSize - offset < centralHeaderLength) || (readUint32(data + offset) != centralHeaderSignature))
+		{
+			return fail("The zip archive's directory is damaged");
+		}
+		const unsigned char* header = data + offset;	// the directory entry
+		const uint16_t nameLength		= readUint16(header + 28);
+		const uint16_t extraLength		= readUint16(header + 30);
+		const uint16_t commentLength	= readUint16(header + 32);
+		if (dataSize - offset - centralHeaderLength < static_cast<size_t>(nameLength))
+		{
+			return fail("The zip archive's directory is damaged");
+		}
+
+		Entry entry;
+		entry.name				= string(reinterpret_cast<const char*>(header + centralHeaderLength), nameLength);
+		entry.method			= readUint16(header + 10);
+		entry.crc				= readUint32(header + 16);
+		entry.compressedSize	= readUint32(header + 20);
+		entry.size				= readUint32(header + 24);
+		entry.headerOffset	= readUint32(header + 42);
+		if ((entry.compressedSize == 0xFFFFFFFF) || (entry.size == 0xFFFFFFFF) || (entry.headerOffset == 0xFFFFFFFF))
+		{
+			return fail("Zip64 archives are not supported");
+		}
+		if ((entry.headerOffset > dataSize) || (dataSize - entry.headerOffset < localHeaderLength))
+		{
+			return fail("The zip archive's directory is damaged");
+		}
+
+		// the size is trusted when the entry is extracted, so one that the compressed data couldn't produce is
+		// refused here rather than allocated
+		const bool storedSizeWrong		= (entry.method == storedMethod) && (entry.size != entry.compressedSize);
+		const bool deflatedSizeWrong	= (entry.method == deflatedMethod) && (entry.size > entry.compressedSize * maxDeflateRatio);
+		if (storedSizeWrong || deflatedSizeWrong)
+		{
+			return fail("The size of " + entry.name + " in the zip archive's directory is impossible");
+		}
+		entries.push_back(entry);
+
+		offset += centralHeaderLength + nameLength + extraLength + commentLength;
+	}
+	return true;
+}
+
+
+const ZipArchive::Entry* ZipArchive::findEntry(const string& name) const
+{
+	for (auto& entry: entries)
+	{
+		if (entry.name == name)
+		{
+			return &entry;
+		}
+	}
+	return nullptr;
+}
+
+
+bool ZipArchive::fail(const string& _error) const
+{
+	error = _error;
+	return false;
+}
+
+
+
+ZipArchiveWriter::ZipArchiveWriter():
+	data(),
+	entries()
+{
+}
+
+
+bool ZipArchiveWriter::addEntry(const string& name, const string& contents)
+{
+	if ((name.size() > 0xFFFF) || (contents.size() >= 0xFFFFFFFF) || (data.size() + localHeaderLength + name.size() + contents.size() >= 0xFFFFFFFF) || (entries.size() >= 0xFFFF))
+	{
+		return false;
+	}
+
+	Entry entry;
+	entry.name				= name;
+	entry.crc				= crc32(contents.data(), contents.data() + contents.size());
+	entry.size				= static_cast<uint32_t>(contents.size());
+	entry.headerOffset	= static_cast<uint32_t>(data.size());
+
+	appendUint32(data, localHeaderSignature);
+	appendUint16(data, storedVersion);
+	appendUint16(data, utf8NamesFlag);
+	appendUint16(data, storedMethod);
+	appendUint16(data, fixedDosTime);
+	appendUint16(data, fixedDosDate);
+	appendUint32(data, entry.crc);
+	appendUint32(data, entry.size);	// the compressed size
+	appendUint32(data, entry.size);
+	appendUint16(data, static_cast<uint16_t>(name.size()));
+	appendUint16(data, 0);				// no extra field
+	data += name;
+	data += contents;
+
+	entries.push_back(entry);
+	return true;
+}
+
+
+const string& ZipArchiveWriter::finish()
+{
+	const uint32_t directoryOffset = static_cast<uint32_t>(data.size());	// where the central directory starts
+	for (auto& entry: entries)
+	{
+		appendUint32(data, centralHeaderSignature);
+		appendUint16(data, storedVersion);	// the version made by
+		appendUint16(data, storedVersion);
+		appendUint16(data, utf8NamesFlag);
+		appendUint16(data, storedMethod);
+		appendUint16(data, fixedDosTime);
+		appendUint16(data, fixedDosDate);
+		appendUint32(data, entry.crc);
+		appendUint32(data, entry.size);		// the compressed size
+		appendUint32(data, entry.size);
+		appendUint16(data, static_cast<uint16_t>(entry.name.size()));
+		appendUint16(data, 0);					// no extra field
+		appendUint16(data, 0);					// no comment
+		appendUint16(data, 0);					// the disk the entry starts on
+		appendUint16(data, 0);					// the internal attributes
+		appendUint32(data, 0);					// the external attributes
+		appendUint32(data, entry.headerOffset);
+		data += entry.name;
+	}
+	const uint32_t directorySize = static_cast<uint32_t>(data.size()) - directoryOffset;	// the size of the central directory
+
+	appendUint32(data, endOfDirectorySignature);
+	appendUint16(data, 0);	// this disk
+	appendUint16(data, 0);	// the disk the directory starts on
+	appendUint16(data, static_cast<uint16_t>(entries.size()));
+	appendUint16(data, static_cast<uint16_t>(entries.size()));
+	appendUint32(data, directorySize);
+	appendUint32(data, directoryOffset);
+	appendUint16(data, 0);	// no comment
+
+	entries.clear();
+	return data;
+}
@@ -0,0 +1,116 @@
+/*Copyright (c) 2016 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+
+#ifndef ZIP_ARCHIVE_H_
+#define ZIP_ARCHIVE_H_
+
+
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+using namespace std;
+
+
+
+// Reads the entries of a zip archive held in memory, such as a compressed save mapped with Utils::MappedFile.
+// Entries are decompressed straight into the caller's buffer, with no temporary files. Only stored and
+// deflated entries are supported, which is all the games write.
+//
+// This does not log, so that converters with their own logging can use it; errors are described by getError().
+class ZipArchive
+{
+	public:
+		// Reads the archive's directory. The data must stay in memory for as long as the archive is used.
+		ZipArchive(const char* data, size_t size);
+
+		// Whether or not the buffer starts like a zip archive
+		static bool isZipArchive(const char* begin, const char* end);
+
+		bool						isValid() const			{ return valid; }
+		const string&			getError() const			{ return error; }
+
+		// The names of the entries, in the order they are stored
+		vector<string>			getEntryNames() const;
+		bool						hasEntry(const string& name) const	{ return (findEntry(name) != nullptr); }
+
+		// The decompressed size of an entry, or 0 if there is no such entry
+		size_t					getEntrySize(const string& name) const;
+
+		// Decompresses an entry onto the end of contents. Returns false if the entry is missing or damaged.
+		bool						extract(const string& name, vector<char>& contents) const;
+
+	private:
+		struct Entry
+		{
+			string	name;					// the entry's path within the archive
+			uint16_t	method;				// how the entry is compressed
+			uint32_t	crc;					// the CRC-32 of the decompressed entry
+			uint32_t	compressedSize;	// the size of the entry in the archive
+			uint32_t	size;					// the size of the decompressed entry
+			uint32_t	headerOffset;		// where the entry's local header starts
+		};
+
+		bool				readDirectory();
+		const Entry*	findEntry(const string& name) const;
+		bool				fail(const string& _error) const;
+
+		const unsigned char*	data;		// the archive
+		size_t					dataSize;	// the size of the archive
+		vector<Entry>			entries;	// the entries listed in the archive's central directory
+		bool						valid;		// whether or not the directory could be read
+		mutable string			error;		// what went wrong with the last failed operation
+};
+
+
+// Builds a zip archive in memory, one whole file at a time. Entries are stored uncompressed, which costs no
+// time to write and which anything that reads zip archives can read. Entries get a fixed timestamp, so the
+// same files always give the same archive.
+class ZipArchiveWriter
+{
+	public:
+		ZipArchiveWriter();
+
+		// Adds an entry, returning false (and leaving the archive unchanged) if it is too big for a zip archive
+		bool				addEntry(const string& name, const string& contents);
+
+		// Adds the archive's directory and returns the finished archive. Nothing more may be added afterwards.
+		const string&	finish();
+
+	private:
+		struct Entry
+		{
+			string	name;				// the entry's path within the archive
+			uint32_t	crc;				// the CRC-32 of the entry
+			uint32_t	size;				// the size of the entry
+			uint32_t	headerOffset;	// where the entry's local header starts
+		};
+
+		string			data;			// the archive so far
+		vector<Entry>	entries;		// the entries added so far
+};
+
+
+
+#endif // ZIP_ARCHIVE_H_